@@ -135,6 +135,7 @@ class Struct(common.SourceLocation):
         self.fields = []  # type: List[Field]
         self.allow_global_collection_name = False  # type: bool
         self.non_const_getter = False  # type: bool
+        self.string_views = False  # type: bool
         super(Struct, self).__init__(file_name, line, column)
 
 
@@ -214,6 +215,8 @@ class Field(common.SourceLocation):
         # Internal fields - not generated by parser
         self.serialize_op_msg_request_only = False  # type: bool
         self.constructed = False  # type: bool
+        # Stored as a StringData into the parsed BSON rather than a std::string copy.
+        self.string_view = False  # type: bool
 
         # Validation rules.
         self.validator = None  # type: Optional[Validator]
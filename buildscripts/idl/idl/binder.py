@@ -248,6 +248,20 @@ def _is_duplicate_field(ctxt, field_container, fields, ast_field):
     return False
 
 
+def _is_string_view_field(ast_field):
+    # type: (ast.Field) -> bool
+    """
+    Return True if the field can be stored as a StringData into the parsed BSON.
+
+    Only plain BSON strings qualify. Types with custom deserializers may build a new std::string,
+    and defaults may be arbitrary expressions, so both keep owning storage.
+    """
+    return (ast_field.type is not None and not ast_field.type.is_array
+            and ast_field.type.cpp_type == 'std::string'
+            and ast_field.type.deserializer == 'mongo::BSONElement::str'
+            and not ast_field.default)
+
+
 def _bind_struct_common(ctxt, parsed_spec, struct, ast_struct):
     # type: (errors.ParserContext, syntax.IDLSpec, syntax.Struct, ast.Struct) -> None
     # pylint: disable=too-many-branches
@@ -261,6 +275,7 @@ def _bind_struct_common(ctxt, parsed_spec, struct, ast_struct):
     ast_struct.cpp_name = struct.name
     ast_struct.allow_global_collection_name = struct.allow_global_collection_name
     ast_struct.non_const_getter = struct.non_const_getter
+    ast_struct.string_views = struct.string_views
     if struct.cpp_name:
         ast_struct.cpp_name = struct.cpp_name
 
@@ -296,6 +311,9 @@ def _bind_struct_common(ctxt, parsed_spec, struct, ast_struct):
                 ctxt.add_bad_field_non_const_getter_in_immutable_struct_error(
                     ast_struct, ast_struct.name, ast_field.name)
 
+            if struct.string_views:
+                ast_field.string_view = _is_string_view_field(ast_field)
+
             if not _is_duplicate_field(ctxt, ast_struct.name, ast_struct.fields, ast_field):
                 ast_struct.fields.append(ast_field)
 
@@ -308,6 +308,22 @@ class _CppTypeView(CppTypeBase):
         )
 
 
+class _CppTypeStringDataView(_CppTypeBasic):
+    """C++ Type information for strings stored as StringData views into the parsed BSON."""
+
+    def get_type_name(self):
+        # type: () -> str
+        return 'StringData'
+
+    def return_by_reference(self):
+        # type: () -> bool
+        return False
+
+    def disable_xvalue(self):
+        # type: () -> bool
+        return True
+
+
 class _CppTypeVector(CppTypeBase):
     """Base type for C++ Std::Vector Types information."""
 
@@ -545,7 +561,9 @@ def get_cpp_type_without_optional(field):
 
     cpp_type_info = None  # type: Any
 
-    if field.type.cpp_type == 'std::string':
+    if field.string_view:
+        cpp_type_info = _CppTypeStringDataView(field)
+    elif field.type.cpp_type == 'std::string':
         cpp_type_info = _CppTypeView(field, 'std::string', 'StringData')
     elif field.type.cpp_type == 'std::vector<std::uint8_t>':
         cpp_type_info = _CppTypeVector(field)
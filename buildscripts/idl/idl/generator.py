@@ -1189,6 +1189,8 @@ class _CppSourceFileWriter(_CppFileWriterBase):
                 'IDLParserErrorContext tempContext(%s, &ctxt);' % (_get_field_constant_name(field)))
             self._writer.write_line('const auto localObject = %s.Obj();' % (element_name))
             return '%s::parse(tempContext, localObject)' % (common.title_case(field.struct_type))
+        elif field.string_view:
+            return '%s.valueStringData()' % (element_name)
         elif field.type.deserializer and 'BSONElement::' in field.type.deserializer:
             method_name = writer.get_method_name(field.type.deserializer)
             return '%s.%s()' % (element_name, method_name)
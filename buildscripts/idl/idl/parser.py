@@ -522,6 +522,7 @@ def _parse_struct(ctxt, spec, name, node):
             "immutable": _RuleDesc('bool_scalar'),
             "generate_comparison_operators": _RuleDesc("bool_scalar"),
             "non_const_getter": _RuleDesc('bool_scalar'),
+            "string_views": _RuleDesc('bool_scalar'),
         })
 
     spec.symbols.add_struct(ctxt, struct)
@@ -703,6 +704,7 @@ def _parse_command(ctxt, spec, name, node):
             "generate_comparison_operators": _RuleDesc("bool_scalar"),
             "allow_global_collection_name": _RuleDesc('bool_scalar'),
             "non_const_getter": _RuleDesc('bool_scalar'),
+            "string_views": _RuleDesc('bool_scalar'),
         })
 
     valid_commands = [
@@ -547,6 +547,56 @@ class TestBinder(testcase.IDLTestcase):
                         foo: string
             """))
 
+    def test_struct_string_views(self):
+        # type: () -> None
+        """Test which fields of a struct with string_views are stored as StringData."""
+
+        spec = self.assert_bind(
+            textwrap.dedent("""
+        types:
+            string:
+                description: foo
+                cpp_type: std::string
+                bson_serialization_type: string
+                deserializer: mongo::BSONElement::str
+            custom_string:
+                description: foo
+                cpp_type: std::string
+                bson_serialization_type: string
+                deserializer: foo::parse
+            int:
+                description: foo
+                cpp_type: std::int32_t
+                bson_serialization_type: int
+                deserializer: mongo::BSONElement::_numberInt
+
+        structs:
+            foo:
+                description: foo
+                string_views: true
+                fields:
+                    plain: string
+                    optional_plain:
+                        type: string
+                        optional: true
+                    defaulted:
+                        type: string
+                        default: '"bar"'
+                    custom: custom_string
+                    strings: array<string>
+                    number: int
+            """))
+
+        fields = {field.name: field.string_view for field in spec.structs[0].fields}
+        self.assertEqual({
+            'plain': True,
+            'optional_plain': True,
+            'defaulted': False,
+            'custom': False,
+            'strings': False,
+            'number': False,
+        }, fields)
+
     def test_struct_negative(self):
         # type: () -> None
         """Negative struct tests."""
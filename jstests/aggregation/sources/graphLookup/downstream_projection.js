@@ -0,0 +1,58 @@
+/**
+ * Tests that $graphLookup returns the correct results when the stages following it only read some
+ * fields of the documents it finds, which lets its queries project the other fields away.
+ *
+ * Cannot implicitly shard accessed collections because unsupported use of sharded collection
+ * for target collection of $lookup and $graphLookup.
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+const local = db.graphlookup_downstream_projection_local;
+const foreign = db.graphlookup_downstream_projection_foreign;
+local.drop();
+foreign.drop();
+
+assert.commandWorked(local.insert({_id: 0, start: 0}));
+assert.commandWorked(foreign.insert([
+    {_id: 0, next: 1, name: "a", pad: "x".repeat(4096)},
+    {_id: 1, next: [2, 3], name: "b", pad: "x".repeat(4096)},
+    {_id: 2, name: "c", pad: "x".repeat(4096)},
+    {_id: 3, next: 0, pad: "x".repeat(4096)},
+]));
+assert.commandWorked(foreign.createIndex({_id: 1, next: 1}));
+
+const graphLookup = {
+    $graphLookup: {
+        from: foreign.getName(),
+        startWith: "$start",
+        connectFromField: "next",
+        connectToField: "_id",
+        depthField: "depth",
+        as: "found"
+    }
+};
+
+// Only the names and depths are read downstream.
+let results =
+    local.aggregate([graphLookup, {$project: {names: "$found.name", depths: "$found.depth"}}])
+        .toArray();
+assert.eq(1, results.length, results);
+assert.sameMembers(["a", "b", "c"], results[0].names, results);
+assert.sameMembers([0, 1, 2, 2], results[0].depths, results);
+
+// An absorbed $unwind produces one document per document found.
+results = local.aggregate([graphLookup, {$unwind: "$found"}, {$project: {id: "$found._id"}}])
+              .toArray();
+assert.sameMembers([0, 1, 2, 3], results.map(doc => doc.id), results);
+
+// Reading the 'as' array itself still sees the whole documents.
+results = local.aggregate([graphLookup, {$project: {found: 1}}]).toArray();
+assert.eq(1, results.length, results);
+assert.eq(4, results[0].found.length, results);
+results[0].found.forEach(doc => assert.eq(4096, doc.pad.length, results));
+}());
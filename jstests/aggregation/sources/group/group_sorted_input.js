@@ -0,0 +1,47 @@
+/**
+ * Tests that a $group which follows a $sort on its group key produces the same groups as a $group
+ * over unsorted input, including when group keys are arrays, null or missing. Such a $group may
+ * stream its results out of the sorted input.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+
+const coll = db.group_sorted_input;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 100; ++i) {
+    docs.push({a: i % 7, b: i % 3, c: i});
+}
+docs.push({a: [1, 5], b: 0, c: 100});
+docs.push({a: 1, b: [0, 2], c: 101});
+docs.push({a: null, b: 1, c: 102});
+docs.push({b: 1, c: 103});
+docs.push({a: 2, c: 104});
+docs.push({a: 2, b: null, c: 105});
+assert.commandWorked(coll.insert(docs));
+
+function assertSameGroupsWithAndWithoutSort(groupStage, sortStage) {
+    const unsorted = coll.aggregate([groupStage]).toArray();
+    const sorted = coll.aggregate([sortStage, groupStage]).toArray();
+    assert(arrayEq(unsorted, sorted), {unsorted: unsorted, sorted: sorted});
+}
+
+function runTests() {
+    const single = {$group: {_id: "$a", count: {$sum: 1}, total: {$sum: "$c"}}};
+    assertSameGroupsWithAndWithoutSort(single, {$sort: {a: 1}});
+    assertSameGroupsWithAndWithoutSort(single, {$sort: {a: -1, c: 1}});
+
+    const compound = {$group: {_id: {x: "$a", y: "$b"}, cs: {$push: "$c"}}};
+    assertSameGroupsWithAndWithoutSort(compound, {$sort: {a: 1, b: 1}});
+    assertSameGroupsWithAndWithoutSort(compound, {$sort: {b: -1, a: 1, c: 1}});
+}
+
+runTests();
+
+// The input may also arrive sorted from an index scan.
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+runTests();
+}());
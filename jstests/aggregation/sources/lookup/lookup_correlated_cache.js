@@ -0,0 +1,66 @@
+/**
+ * Tests that a correlated $lookup reuses the results of its sub-pipeline for input documents with
+ * the same 'let' bindings, and reports how often it did so in explain.
+ *
+ * Accessed collections cannot be implicitly sharded because you cannot $lookup into a sharded
+ * collection.
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   do_not_wrap_aggregations_in_facets,
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStage().
+
+const local = db.lookup_correlated_cache_local;
+const foreign = db.lookup_correlated_cache_foreign;
+local.drop();
+foreign.drop();
+
+assert.commandWorked(local.insert([
+    {_id: 0, customer: 1},
+    {_id: 1, customer: 2},
+    {_id: 2, customer: 1},
+    {_id: 3, customer: 1},
+    {_id: 4, customer: NumberLong(1)},
+]));
+assert.commandWorked(foreign.insert([
+    {_id: 1, name: "a"},
+    {_id: 2, name: "b"},
+]));
+
+const pipeline = [
+    {
+        $lookup: {
+            from: foreign.getName(),
+            let: {c: "$customer"},
+            pipeline: [
+                {$match: {$expr: {$eq: ["$_id", "$$c"]}}},
+                {$project: {_id: 0, name: 1, c: "$$c"}}
+            ],
+            as: "customer"
+        }
+    },
+    {$sort: {_id: 1}}
+];
+
+// Cached results are identical to the computed ones, and bindings that only compare equal keep
+// their own types.
+const results = local.aggregate(pipeline).toArray();
+assert.eq(results.map(doc => doc.customer), [
+    [{name: "a", c: 1}],
+    [{name: "b", c: 2}],
+    [{name: "a", c: 1}],
+    [{name: "a", c: 1}],
+    [{name: "a", c: NumberLong(1)}],
+]);
+
+const explain = local.explain("executionStats").aggregate(pipeline);
+const lookupStage = getAggPlanStage(explain, "$lookup");
+assert.neq(null, lookupStage, explain);
+assert.eq(2, lookupStage.correlatedCacheHits, explain);
+assert.eq(3, lookupStage.correlatedCacheMisses, explain);
+}());
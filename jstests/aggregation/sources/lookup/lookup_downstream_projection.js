@@ -0,0 +1,71 @@
+/**
+ * Tests that $lookup returns the correct results when the stages following it only read some
+ * fields of the joined documents, which lets the foreign pipeline project the other fields away.
+ *
+ * Accessed collections cannot be implicitly sharded because you cannot $lookup into a sharded
+ * collection.
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   sbe_incompatible,
+ * ]
+ */
+(function() {
+"use strict";
+
+const testDB = db.getSiblingDB("lookup_downstream_projection");
+testDB.dropDatabase();
+
+const local = testDB.local;
+const foreign = testDB.foreign;
+
+assert.commandWorked(local.insert([{_id: 0, key: 1}, {_id: 1, key: 2}, {_id: 2, key: 3}]));
+assert.commandWorked(foreign.insert([
+    {_id: 0, key: 1, a: 1, b: {c: 1, d: "x".repeat(1024)}, pad: "x".repeat(4096)},
+    {_id: 1, key: 1, a: 2, b: {c: 2, d: "y"}, pad: "x".repeat(4096)},
+    {_id: 2, key: 2, b: {c: 3}, pad: "x".repeat(4096)},
+]));
+
+const lookup = {$lookup: {from: foreign.getName(), localField: "key", foreignField: "key", as: "j"}};
+
+// Only 'j.a' and 'j.b.c' are read downstream.
+assert.sameMembers(
+    [
+        {_id: 0, as: [1, 2], cs: [1, 2]},
+        {_id: 1, as: [], cs: [3]},
+        {_id: 2, as: [], cs: []},
+    ],
+    local
+        .aggregate(
+            [lookup, {$project: {as: "$j.a", cs: "$j.b.c"}}, {$project: {_id: 1, as: 1, cs: 1}}])
+        .toArray());
+
+// A prefix and one of its subpaths are both read.
+assert.sameMembers(
+    [
+        {_id: 0, b: [{c: 1, d: "x".repeat(1024)}, {c: 2, d: "y"}], cs: [1, 2]},
+        {_id: 1, b: [{c: 3}], cs: [3]},
+        {_id: 2, b: [], cs: []},
+    ],
+    local.aggregate([lookup, {$project: {b: "$j.b", cs: "$j.b.c"}}]).toArray());
+
+// Reading the 'as' array itself, for example its size, still sees every joined document.
+assert.sameMembers(
+    [{_id: 0, n: 2}, {_id: 1, n: 1}, {_id: 2, n: 0}],
+    local.aggregate([lookup, {$project: {n: {$size: "$j"}}}]).toArray());
+
+// An absorbed $unwind produces one document per joined document.
+assert.sameMembers(
+    [{_id: 0, a: 1}, {_id: 0, a: 2}, {_id: 1}],
+    local.aggregate([lookup, {$unwind: "$j"}, {$project: {a: "$j.a"}}]).toArray());
+
+// A $group after the $lookup only reads the fields it accumulates.
+assert.sameMembers(
+    [{_id: null, total: 3}],
+    local.aggregate([lookup, {$unwind: "$j"}, {$group: {_id: null, total: {$sum: "$j.a"}}}])
+        .toArray());
+
+// Without a stage that bounds the downstream dependencies, whole documents are returned.
+const results = local.aggregate([lookup, {$match: {_id: 1}}]).toArray();
+assert.eq(1, results.length, results);
+assert.eq(4096, results[0].j[0].pad.length, results);
+}());
@@ -0,0 +1,76 @@
+/**
+ * Tests that $setWindowFields computes window functions over sliding 'documents' and 'range'
+ * windows within each partition.
+ *
+ * @tags: [
+ *   requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+const featureEnabled =
+    assert.commandWorked(db.adminCommand({getParameter: 1, featureFlagWindowFunctions: 1}))
+        .featureFlagWindowFunctions.value;
+if (!featureEnabled) {
+    jsTestLog("Skipping test because the window function feature flag is disabled");
+    return;
+}
+
+const coll = db.set_window_fields_sliding_windows;
+coll.drop();
+
+const kDayMillis = 24 * 60 * 60 * 1000;
+const docs = [];
+for (let i = 0; i < 10; i++) {
+    docs.push({_id: i, sensor: i % 2 === 0 ? "even" : "odd", t: new Date(i * kDayMillis), x: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+const results = coll.aggregate([
+                        {
+                            $setWindowFields: {
+                                partitionBy: "$sensor",
+                                sortBy: {t: 1},
+                                output: {
+                                    neighbours: {$sum: {input: "$x", documents: [-1, 1]}},
+                                    lastWeek: {$sum: {input: "$x", range: [-6, 0], unit: "day"}},
+                                    total: {$sum: {input: "$x"}},
+                                }
+                            }
+                        },
+                        {$sort: {_id: 1}}
+                    ])
+                    .toArray();
+assert.eq(results.length, docs.length, results);
+
+// Compute the expected values from the documents of each partition, in sort order.
+for (const result of results) {
+    const partition = docs.filter(doc => doc.sensor === result.sensor);
+    const pos = partition.findIndex(doc => doc._id === result._id);
+    const sumOf = (matching) => matching.reduce((sum, doc) => sum + doc.x, 0);
+
+    assert.eq(result.neighbours,
+              sumOf(partition.slice(Math.max(0, pos - 1), pos + 2)),
+              result);
+    assert.eq(result.lastWeek,
+              sumOf(partition.filter(doc => doc.t <= result.t &&
+                                         doc.t >= result.t - 6 * kDayMillis)),
+              result);
+    assert.eq(result.total, sumOf(partition), result);
+}
+
+// A partitionBy that is not a field path is computed into a temporary field which does not appear
+// in the output.
+const computed =
+    coll.aggregate([
+            {
+                $setWindowFields:
+                    {partitionBy: {$mod: ["$x", 3]}, output: {count: {$count: {}}}}
+            },
+            {$sort: {_id: 1}}
+        ])
+        .toArray();
+assert.eq(computed.map(doc => doc.count), [4, 3, 3, 4, 3, 3, 4, 3, 3, 4], computed);
+assert.eq(Object.keys(computed[0]).sort(), ["_id", "count", "sensor", "t", "x"], computed);
+})();
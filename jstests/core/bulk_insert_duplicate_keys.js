@@ -0,0 +1,46 @@
+/**
+ * Tests that a large insert in which some documents fail reports an error for exactly those
+ * documents and inserts all the others, however the server groups the documents into batches.
+ *
+ * @tags: [assumes_unsharded_collection, requires_fastcount]
+ */
+(function() {
+"use strict";
+
+const coll = db.bulk_insert_duplicate_keys;
+coll.drop();
+
+const kNumDocs = 500;
+assert.commandWorked(coll.insert([{_id: 0}, {_id: 7}]));
+
+// Every 7th document duplicates an earlier one, including the two inserted above.
+const docs = [];
+const expectedErrors = [];
+for (let i = 0; i < kNumDocs; ++i) {
+    if (i % 7 == 0) {
+        expectedErrors.push(i);
+        docs.push({_id: i > 7 ? i - 1 : i});
+    } else {
+        docs.push({_id: i});
+    }
+}
+
+let res = db.runCommand({insert: coll.getName(), documents: docs, ordered: false});
+assert.commandWorked(res);
+assert.eq(kNumDocs - expectedErrors.length, res.n, res);
+assert.eq(expectedErrors, res.writeErrors.map(err => err.index), res);
+res.writeErrors.forEach(err => assert.eq(ErrorCodes.DuplicateKey, err.code, res));
+assert.eq(kNumDocs - expectedErrors.length + 2, coll.count());
+
+// An ordered insert stops at the first failing document.
+assert(coll.drop());
+res = db.runCommand({
+    insert: coll.getName(),
+    documents: [...Array(100).keys()].map(i => ({_id: i == 50 ? 0 : i})),
+    ordered: true
+});
+assert.commandWorked(res);
+assert.eq(50, res.n, res);
+assert.eq([50], res.writeErrors.map(err => err.index), res);
+assert.eq(50, coll.count());
+})();
@@ -0,0 +1,43 @@
+/**
+ * Test that explain at "executionStats" verbosity reports the CPU time spent in each stage on
+ * platforms that can measure it, and that "queryPlanner" verbosity does not.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   sbe_incompatible,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+if (hostInfo().os.type != "Linux") {
+    jsTestLog("Skipping test since per-thread CPU time is only measured on Linux");
+    return;
+}
+
+const coll = db.explain_execution_cpu_nanos;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({a: 1}));
+for (let i = 0; i < 100; ++i) {
+    assert.commandWorked(coll.insert({a: i, b: i % 10}));
+}
+
+let explain = coll.find({a: {$gte: 10}, b: 3}).sort({b: 1}).explain("executionStats");
+const stages = ["SORT", "FETCH", "IXSCAN"].map(
+    (name) => getPlanStage(explain.executionStats.executionStages, name));
+for (let stage of stages) {
+    assert.neq(null, stage, explain);
+    assert(stage.hasOwnProperty("executionCpuNanos"), stage);
+    assert.gte(stage.executionCpuNanos, 0, stage);
+}
+
+// A stage's CPU time includes the time spent in its children.
+assert.gte(stages[0].executionCpuNanos, stages[1].executionCpuNanos, explain);
+assert.gte(stages[1].executionCpuNanos, stages[2].executionCpuNanos, explain);
+
+explain = coll.find({a: {$gte: 10}}).explain("queryPlanner");
+assert(!tojson(explain).includes("executionCpuNanos"), explain);
+}());
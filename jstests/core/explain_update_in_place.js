@@ -0,0 +1,37 @@
+/**
+ * Tests that explain reports whether an update would be applied in place, as byte-level damages to
+ * the existing record, rather than by writing a whole new document.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   requires_fcv_49,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const coll = db.explain_update_in_place;
+coll.drop();
+
+assert.commandWorked(
+    coll.insert({_id: 0, counter: NumberLong(1), indexed: NumberLong(1), pad: "x".repeat(8000)}));
+assert.commandWorked(coll.createIndex({indexed: 1}));
+
+function getUpdateStage(update) {
+    const explain = coll.explain("executionStats").update({_id: 0}, update);
+    const stage = getPlanStage(explain.executionStats.executionStages, "UPDATE");
+    assert.neq(null, stage, explain);
+    assert.eq(1, stage.nWouldModify, stage);
+    return stage;
+}
+
+// Incrementing a fixed-width field that is not indexed rewrites only the changed bytes.
+assert.eq(1, getUpdateStage({$inc: {counter: NumberLong(1)}}).nWouldModifyInPlace);
+
+// Changing the size of a value, or a value that is indexed, requires writing a new document.
+assert.eq(0, getUpdateStage({$set: {pad: "y"}}).nWouldModifyInPlace);
+assert.eq(0, getUpdateStage({$inc: {indexed: NumberLong(1)}}).nWouldModifyInPlace);
+}());
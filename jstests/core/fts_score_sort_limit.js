@@ -0,0 +1,67 @@
+/**
+ * Tests that a $text query sorted by text score with a limit only fetches the best-scoring
+ * documents, and still returns the same results as sorting every match.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   requires_fcv_49,
+ *   sbe_incompatible,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const coll = db.fts_score_sort_limit;
+coll.drop();
+
+// Document i mentions "apple" i times, so higher _ids score higher.
+const kNumDocs = 20;
+for (let i = 1; i <= kNumDocs; i++) {
+    assert.commandWorked(coll.insert({_id: i, a: "apple ".repeat(i) + "Banana"}));
+}
+assert.commandWorked(coll.createIndex({a: "text"}));
+
+function runQuery(search, limit) {
+    return coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+        .sort({score: {$meta: "textScore"}})
+        .limit(limit);
+}
+
+function textOrDocsExamined(search, limit) {
+    const explain = runQuery(search, limit).explain("executionStats");
+    const textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+    assert.neq(null, textOr, explain);
+    return textOr.docsExamined;
+}
+
+function expectedTopIds(search, limit) {
+    return coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+        .toArray()
+        .sort((x, y) => y.score - x.score)
+        .slice(0, limit)
+        .map(doc => doc._id);
+}
+
+// Only the best-scoring candidates are fetched when every index match is a result.
+assert.eq(runQuery("apple", 3).toArray().map(doc => doc._id), [20, 19, 18]);
+assert.eq(runQuery("apple", 3).toArray().map(doc => doc._id), expectedTopIds("apple", 3));
+assert.eq(textOrDocsExamined("apple", 3), 3);
+
+// Phrases, negations and case sensitive searches can reject documents after they are fetched, so
+// every candidate is still fetched for them.
+assert.eq(runQuery("apple -banana", 3).itcount(), 0);
+assert.eq(textOrDocsExamined("\"apple banana\"", 3), kNumDocs);
+assert.eq(runQuery("\"apple banana\"", 3).toArray().map(doc => doc._id),
+          expectedTopIds("\"apple banana\"", 3));
+const caseSensitiveQuery = {$text: {$search: "banana", $caseSensitive: true}};
+assert.eq(coll.find(caseSensitiveQuery, {score: {$meta: "textScore"}})
+              .sort({score: {$meta: "textScore"}})
+              .limit(3)
+              .itcount(),
+          0);
+
+// A limit larger than the number of matches returns them all.
+assert.eq(runQuery("apple", kNumDocs + 5).itcount(), kNumDocs);
+})();
@@ -105,4 +105,27 @@ assert.eq(0, t.find({_id: 1}).hint({_id: 1}).min({_id: 2}).itcount());
 
 explain = t.find({_id: 2}).hint({_id: 1}).min({_id: 1}).max({_id: 3}).explain();
 assert(!isIdhack(db, explain.queryPlanner.winningPlan));
+
+// An $in over literal _id values looks up each value with the ID hack, in _id order, skipping the
+// values which do not exist and returning each document once.
+const inQuery = {
+    _id: {$in: [{x: 1}, 5, 1, NumberLong(0), 0.0]}
+};
+explain = t.find(inQuery).explain(true);
+assert(isIdhack(db, explain.queryPlanner.winningPlan), explain);
+assert.eq(2, explain.executionStats.nReturned, explain);
+assert.eq(2, explain.executionStats.totalKeysExamined, explain);
+assert.eq([{_id: 0, a: 0}, {_id: 1, a: 1}], t.find(inQuery, {b: 0}).toArray());
+assert.eq([{_id: 0}, {_id: 1}], t.find({_id: {$in: [1, 0]}}, {a: 0, b: 0}).toArray());
+assert.eq(0, t.find({_id: {$in: []}}).itcount());
+
+// An $in which needs sorting, limiting, or may be covered by the _id index is planned as usual.
+explain = t.find({_id: {$in: [0, 1]}}).sort({_id: -1}).explain();
+assert(!isIdhack(db, explain.queryPlanner.winningPlan));
+explain = t.find({_id: {$in: [0, 1]}}).limit(1).explain();
+assert(!isIdhack(db, explain.queryPlanner.winningPlan));
+explain = t.find({_id: {$in: [0, 1]}}, {_id: 1}).explain();
+assert(!isIdhack(db, explain.queryPlanner.winningPlan));
+explain = t.find({_id: {$in: [0, /abc/]}}).explain();
+assert(!isIdhack(db, explain.queryPlanner.winningPlan));
 })();
@@ -0,0 +1,74 @@
+/**
+ * Tests that indexes created on the metaField and timeField of a time-series collection are built
+ * on the buckets collection and used by queries on the measurements.
+ *
+ * @tags: [
+ *     assumes_no_implicit_collection_creation_after_drop,
+ *     assumes_unsharded_collection,
+ *     does_not_support_stepdowns,
+ *     requires_fcv_49,
+ *     requires_find_command,
+ *     sbe_incompatible,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/timeseries/libs/timeseries.js");
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(db.getMongo())) {
+    jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+    return;
+}
+
+const testDB = db.getSiblingDB(jsTestName());
+assert.commandWorked(testDB.dropDatabase());
+
+const coll = testDB.getCollection('t');
+const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+assert.commandWorked(testDB.createCollection(
+    coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+
+const start = ISODate("2021-01-01T00:00:00Z");
+for (let i = 0; i < 20; ++i) {
+    assert.commandWorked(coll.insert({
+        _id: i,
+        [timeFieldName]: new Date(start.getTime() + i * 60 * 1000),
+        [metaFieldName]: {sensor: i % 4},
+        a: i,
+    }));
+}
+
+// The index is created on the buckets collection with the bucket-level key pattern.
+assert.commandWorked(coll.createIndex({[metaFieldName + '.sensor']: 1, [timeFieldName]: 1},
+                                      {name: 'sensor_time'}));
+const index = bucketsColl.getIndexes().find(index => index.name === 'sensor_time');
+assert.neq(undefined, index, bucketsColl.getIndexes());
+assert.docEq({
+    'meta.sensor': 1,
+    ['control.min.' + timeFieldName]: 1,
+    ['control.max.' + timeFieldName]: 1
+},
+             index.key);
+
+// Measurement fields and options which would apply to whole buckets cannot be indexed.
+assert.commandFailedWithCode(coll.createIndex({a: 1}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(coll.createIndex({[metaFieldName]: 1}, {unique: true}),
+                             ErrorCodes.InvalidOptions);
+
+// Queries on the sensor and a time range return the same results and are answered from the index.
+const pred = {
+    [metaFieldName + '.sensor']: 2,
+    [timeFieldName]: {$gte: new Date(start.getTime() + 5 * 60 * 1000)}
+};
+const results = coll.find(pred).sort({_id: 1}).toArray();
+assert.eq([6, 10, 14, 18], results.map(doc => doc._id), results);
+
+const explain = coll.explain().aggregate([{$match: pred}]);
+assert(tojson(explain).includes("IXSCAN"), explain);
+assert(tojson(explain).includes("sensor_time"), explain);
+})();
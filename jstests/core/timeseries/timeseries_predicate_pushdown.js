@@ -0,0 +1,96 @@
+/**
+ * Tests that $match predicates on measurement fields of a time-series collection are mapped to
+ * predicates on the buckets' control.min and control.max fields without changing query results.
+ *
+ * @tags: [
+ *     assumes_unsharded_collection,
+ *     does_not_support_causal_consistency,
+ *     does_not_support_stepdowns,
+ *     requires_fcv_49,
+ *     requires_find_command,
+ *     requires_getmore,
+ *     sbe_incompatible,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/timeseries/libs/timeseries.js");
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(db.getMongo())) {
+    jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+    return;
+}
+
+const testDB = db.getSiblingDB(jsTestName());
+assert.commandWorked(testDB.dropDatabase());
+
+const coll = testDB.getCollection('t');
+const controlColl = testDB.getCollection('control');
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+assert.commandWorked(testDB.createCollection(
+    coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+
+// Each metadata value gets its own bucket, so every bucket below holds a different mix of values.
+const start = ISODate("2021-01-01T00:00:00Z");
+const values = {
+    numbers: [1, 2.5, NumberLong(7), NumberDecimal("9.5")],
+    mixed: [3, "str", null, true],
+    arrays: [[1, 10], 4, [20]],
+    strings: ["a", "m", "z"],
+    dates: [ISODate("2020-01-01"), [ISODate("2022-01-01")]],
+    objects: [{b: 1}, 6],
+};
+let i = 0;
+for (let meta in values) {
+    for (let a of values[meta]) {
+        const doc = {
+            _id: i,
+            [timeFieldName]: new Date(start.getTime() + i * 60 * 1000),
+            [metaFieldName]: meta,
+            a: a,
+        };
+        assert.commandWorked(coll.insert(doc));
+        assert.commandWorked(controlColl.insert(doc));
+        ++i;
+    }
+}
+
+const predicates = [
+    {a: {$gt: 5}},
+    {a: {$gte: 7}},
+    {a: {$lt: 4}},
+    {a: {$lte: 1}},
+    {a: 4},
+    {a: 20},
+    {a: {$gt: "b"}},
+    {a: {$lt: "b"}},
+    {a: true},
+    {a: {$gt: ISODate("2021-01-01")}},
+    {a: {$lt: ISODate("2021-01-01")}},
+    {a: {$gt: 0, $lt: 3}},
+    {$or: [{a: {$lt: 2}}, {a: {$gt: 15}}]},
+    {[timeFieldName]: {$gte: new Date(start.getTime() + 5 * 60 * 1000)}},
+    {
+        [timeFieldName]: {
+            $gte: new Date(start.getTime() + 3 * 60 * 1000),
+            $lt: new Date(start.getTime() + 8 * 60 * 1000)
+        },
+        a: {$gte: 2}
+    },
+];
+for (let pred of predicates) {
+    const expected = controlColl.find(pred).sort({_id: 1}).toArray();
+
+    assert.eq(expected, coll.find(pred).sort({_id: 1}).toArray(), pred);
+    assert.eq(expected, coll.aggregate([{$match: pred}, {$sort: {_id: 1}}]).toArray(), pred);
+}
+
+// The bucket-level predicate reaches the query against the buckets collection.
+const explain = coll.explain().aggregate(
+    [{$match: {[timeFieldName]: {$gte: new Date(start.getTime() + 5 * 60 * 1000)}}}]);
+assert(tojson(explain).includes("control.max." + timeFieldName), explain);
+})();
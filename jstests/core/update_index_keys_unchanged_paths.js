@@ -0,0 +1,52 @@
+/**
+ * Tests that updates keep index keys correct when an index is affected by the update but some of
+ * its indexed values are left untouched, in which case key generation for that index is skipped.
+ *
+ * @tags: [requires_non_retryable_writes]
+ */
+(function() {
+"use strict";
+
+const coll = db.update_index_keys_unchanged_paths;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({a: 1, "b.c": 1}));
+assert.commandWorked(coll.createIndex({"b.d": 1}));
+assert.commandWorked(coll.createIndex({a: "hashed"}));
+assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+assert.commandWorked(coll.insert({
+    _id: 0,
+    a: 1,
+    b: {c: 1, d: 1},
+    arr: [{c: 1}],
+    loc: {type: "Point", coordinates: [0, 0]},
+}));
+assert.commandWorked(coll.insert({_id: 1, a: 1, b: [{c: 1}, {c: 2}]}));
+
+function assertFound(query, hint, expectedIds) {
+    const ids = coll.find(query, {_id: 1}).hint(hint).sort({_id: 1}).toArray().map(d => d._id);
+    assert.eq(expectedIds, ids, {query: query, hint: hint});
+}
+
+// Changing 'b.d' affects the {"b.d": 1} index but leaves the values of 'a' and 'b.c' untouched.
+assert.commandWorked(coll.update({_id: 0}, {$set: {"b.d": 2}}));
+assertFound({"b.d": 2}, {"b.d": 1}, [0]);
+assertFound({a: 1, "b.c": 1}, {a: 1, "b.c": 1}, [0, 1]);
+assertFound({a: 1}, {a: "hashed"}, [0, 1]);
+
+// A change beneath an array on an indexed path must still regenerate that index's keys.
+assert.commandWorked(coll.update({_id: 1}, {$set: {"b.1.c": 3}}));
+assertFound({a: 1, "b.c": 3}, {a: 1, "b.c": 1}, [1]);
+assertFound({a: 1, "b.c": 2}, {a: 1, "b.c": 1}, []);
+
+// Replacing an embedded object with a scalar changes the indexed value.
+assert.commandWorked(coll.update({_id: 0}, {$set: {b: 5, "loc.coordinates": [1, 1]}}));
+assertFound({a: 1, "b.c": 1}, {a: 1, "b.c": 1}, [1]);
+assertFound({"b.d": 2}, {"b.d": 1}, []);
+assertFound({loc: {$geoIntersects: {$geometry: {type: "Point", coordinates: [1, 1]}}}},
+            {loc: "2dsphere"},
+            [0]);
+
+assert.commandWorked(coll.validate({full: true}));
+}());
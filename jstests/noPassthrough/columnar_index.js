@@ -0,0 +1,61 @@
+/**
+ * Tests creating and maintaining a 'columnar' index, which stores each indexed path as a column
+ * keyed by RecordId.
+ */
+(function() {
+'use strict';
+
+load("jstests/libs/analyze_plan.js");  // For isCollscan.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, 'mongod was unable to start up');
+
+const db = conn.getDB('test');
+const coll = db.getCollection(jsTestName());
+
+// Invalid specifications are rejected.
+assert.commandFailedWithCode(coll.createIndex({a: 'columnar', b: 1}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: 'columnar'}, {unique: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: 'columnar'}, {sparse: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: 'columnar'}, {v: 1}),
+                             ErrorCodes.CannotCreateIndex);
+
+const numDocs = 100;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert({_id: i, a: i, b: {c: i % 3}, padding: 'x'.repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+
+assert.commandWorked(coll.createIndex({a: 'columnar', 'b.c': 'columnar', d: 'columnar'}));
+
+// Documents written after the build are indexed too, including arrays, which are stored as a
+// single value, and documents missing some of the indexed paths.
+bulk = coll.initializeUnorderedBulkOp();
+bulk.insert({_id: numDocs, a: [1, 2, 3]});
+bulk.insert({_id: numDocs + 1, d: 'only d'});
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.update({_id: 0}, {$set: {a: 'updated'}}));
+assert.commandWorked(coll.remove({_id: 1}));
+
+const indexName = 'a_columnar_b.c_columnar_d_columnar';
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+// Each document contributes one key per indexed path that it has: 'a' and 'b.c' for the original
+// documents, except the removed one, plus one key for each of the two documents inserted later.
+assert.eq(2 * (numDocs - 1) + 2, validateRes.keysPerIndex[indexName], tojson(validateRes));
+
+const indexSpec = coll.getIndexes().find((index) => index.name === indexName);
+assert(indexSpec, tojson(coll.getIndexes()));
+
+// The planner never chooses a columnar index for a query.
+const explain = coll.find({a: 5}).explain();
+assert(isCollscan(db, explain.queryPlanner.winningPlan), tojson(explain));
+assert.eq(1, coll.find({a: 5}).itcount());
+
+assert.commandWorked(coll.dropIndex(indexName));
+MongoRunner.stopMongod(conn);
+})();
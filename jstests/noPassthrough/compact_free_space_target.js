@@ -0,0 +1,37 @@
+/**
+ * Tests that compact with 'freeSpaceTargetMB' only compacts the collection when its storage and
+ * indexes report at least that much space available for reuse.
+ *
+ * @tags: [requires_fcv_49, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.compact_free_space_target;
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 10000; i++) {
+    bulk.insert({_id: i, pad: "x".repeat(1024)});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.remove({_id: {$gte: 1000}}));
+assert.commandWorked(db.adminCommand({fsync: 1}));
+
+// Far more space than the collection ever used cannot be reclaimed, so compact is skipped.
+let res = assert.commandWorked(coll.runCommand("compact", {freeSpaceTargetMB: 1024 * 1024}));
+assert.eq(0, res.bytesFreed, res);
+
+assert.commandFailedWithCode(coll.runCommand("compact", {freeSpaceTargetMB: -1}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(coll.runCommand("compact", {freeSpaceTargetMB: "1"}),
+                             ErrorCodes.TypeMismatch);
+
+// A target of zero always compacts.
+res = assert.commandWorked(coll.runCommand("compact", {freeSpaceTargetMB: 0}));
+assert.eq(1000, coll.find().itcount());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,49 @@
+/**
+ * Tests that concurrent {j: true} writers share journal flushes when a coalescing window is set,
+ * and that serverStatus reports how many writers each flush was for.
+ * @tags: [requires_journaling, requires_persistence]
+ */
+(function() {
+'use strict';
+
+load('jstests/libs/parallelTester.js');  // For Thread.
+
+const conn = MongoRunner.runMongod({
+    setParameter: {journalCommitCoalescingWindowMicros: 20 * 1000, journalCommitMaxBatchSize: 4}
+});
+assert.neq(null, conn, 'mongod was unable to start up');
+const db = conn.getDB('test');
+
+const before = assert.commandWorked(db.serverStatus()).journalFlusher;
+assert(before, 'serverStatus is missing journalFlusher');
+
+const numThreads = 8;
+const numInsertsPerThread = 50;
+const threads = [];
+for (let t = 0; t < numThreads; ++t) {
+    threads.push(new Thread(function(host, t, numInserts) {
+        const coll = new Mongo(host).getDB('test').getCollection('group_commit');
+        for (let i = 0; i < numInserts; ++i) {
+            assert.commandWorked(coll.insert({t: t, i: i}, {writeConcern: {w: 1, j: true}}));
+        }
+    }, conn.host, t, numInsertsPerThread));
+    threads[t].start();
+}
+threads.forEach((thread) => thread.join());
+assert.eq(numThreads * numInsertsPerThread, db.group_commit.find().itcount());
+
+const after = assert.commandWorked(db.serverStatus()).journalFlusher;
+const waiters = after.waiters - before.waiters;
+const rounds = after.rounds - before.rounds;
+jsTestLog('Flushed for ' + waiters + ' waiters in ' + rounds + ' rounds: ' + tojson(after));
+assert.gte(waiters, numThreads * numInsertsPerThread, tojson(after));
+// With the writers held together by the coalescing window, a round flushes for several of them.
+assert.lt(rounds, waiters, tojson(after));
+assert(after.waitersPerRound.some((bucket) => bucket.waiters >= 2), tojson(after));
+
+// Turning the window off still flushes for every j:true writer.
+assert.commandWorked(db.adminCommand({setParameter: 1, journalCommitCoalescingWindowMicros: 0}));
+assert.commandWorked(db.group_commit.insert({last: true}, {writeConcern: {j: true}}));
+
+MongoRunner.stopMongod(conn);
+})();
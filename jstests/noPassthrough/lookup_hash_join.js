@@ -0,0 +1,67 @@
+/**
+ * Tests that a $lookup answered from a hash table over the foreign collection returns the same
+ * results as a $lookup querying the foreign collection for every input document.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const local = db.lookup_hash_join_local;
+const foreign = db.lookup_hash_join_foreign;
+local.drop();
+foreign.drop();
+
+assert.commandWorked(local.insert([
+    {_id: 0, a: 1},
+    {_id: 1, a: [1, 2]},
+    {_id: 2, a: null},
+    {_id: 3},
+    {_id: 4, a: "X"},
+    {_id: 5, a: {b: 1}},
+]));
+assert.commandWorked(foreign.insert([
+    {_id: 0, b: 1},
+    {_id: 1, b: [2, 3]},
+    {_id: 2, b: null},
+    {_id: 3},
+    {_id: 4, b: "x"},
+    {_id: 5, b: {b: 1}},
+    {_id: 6, b: 1.0},
+]));
+
+function runLookup(collation) {
+    const options = collation ? {collation: collation} : {};
+    return local
+        .aggregate(
+            [
+                {$lookup: {from: foreign.getName(), localField: "a", foreignField: "b", as: "j"}},
+                {$addFields: {j: {$map: {input: "$j", in: "$$this._id"}}}},
+                {$sort: {_id: 1}}
+            ],
+            options)
+        .toArray()
+        .map(doc => Object.assign(doc, {j: doc.j.sort()}));
+}
+
+function setHashJoinMemory(bytes) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalDocumentSourceLookupHashJoinMaxMemoryBytes: bytes}));
+}
+
+const collation = {locale: "en", strength: 2};
+setHashJoinMemory(0);
+const expected = runLookup();
+const expectedWithCollation = runLookup(collation);
+
+setHashJoinMemory(100 * 1024 * 1024);
+assert.eq(expected, runLookup());
+assert.eq(expectedWithCollation, runLookup(collation));
+
+// A foreign collection which does not fit into the hash table falls back to per-document queries.
+setHashJoinMemory(64);
+assert.eq(expected, runLookup());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -47,6 +47,7 @@ function assertExistenceOfRequiredCacheEntryFields(entry) {
     assert(entry.hasOwnProperty("timeOfCreation"), entry);
     assert(entry.hasOwnProperty("indexFilterSet"), entry);
     assert(entry.hasOwnProperty("estimatedSizeBytes"), entry);
+    assert(entry.hasOwnProperty("numCandidatePlans"), entry);
 }
 
 const debugInfoFields =
@@ -0,0 +1,59 @@
+/**
+ * Tests that find and getMore operations are aggregated by query shape and reported by the
+ * $queryShapeStats aggregation stage.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryShapeStatsSampleRate: 1}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.query_shape_stats;
+coll.drop();
+
+assert.commandWorked(coll.insert(Array.from({length: 20}, (_, i) => ({_id: i, a: i % 4, b: i}))));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function getShapeStats() {
+    return coll.aggregate([{$queryShapeStats: {}}]).toArray();
+}
+
+function findShape(filter) {
+    return getShapeStats().find(entry => bsonWoCompare(entry.query.query, filter) === 0);
+}
+
+// Queries which only differ in their constants share one entry.
+assert.eq(5, coll.find({a: 1}).itcount());
+assert.eq(5, coll.find({a: 2}).itcount());
+let entry = findShape({a: 1});
+assert.neq(undefined, entry, getShapeStats());
+assert.eq(2, entry.finds, entry);
+assert.eq(0, entry.getMores, entry);
+assert.eq(10, entry.nReturned, entry);
+assert.gte(entry.keysExamined, 10, entry);
+assert.eq(10, entry.docsExamined, entry);
+assert.eq(2, entry.latencyHistogram.reduce((sum, bucket) => sum + bucket.count, 0), entry);
+assert(entry.hasOwnProperty("queryHash"), entry);
+assert(entry.hasOwnProperty("host"), entry);
+
+// The getMores of a query are counted with its shape.
+assert.eq(20, coll.find({b: {$gte: 0}}).batchSize(5).itcount());
+entry = findShape({b: {$gte: 0}});
+assert.neq(undefined, entry, getShapeStats());
+assert.eq(1, entry.finds, entry);
+assert.gte(entry.getMores, 3, entry);
+assert.eq(20, entry.nReturned, entry);
+assert.eq(20, entry.docsExamined, entry);
+
+// Nothing is recorded with a sample rate of zero.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryShapeStatsSampleRate: 0}));
+assert.eq(5, coll.find({a: 3}).itcount());
+assert.eq(2, findShape({a: 1}).finds);
+
+// The stage takes no parameters.
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [{$queryShapeStats: {x: 1}}], cursor: {}}),
+    ErrorCodes.FailedToParse);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,89 @@
+/**
+ * Tests that a $group which the slot-based execution engine can compute is executed as part of the
+ * query, and returns the same results as the $group stage of the aggregation framework.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStage().
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryEnableSlotBasedExecutionEngine: true,
+        internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes: 1024
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_group_pushdown;
+coll.drop();
+
+const values = [null, undefined, 3, NumberLong(1), 1.0, "a", "b", {x: 1}, [2, 1], MinKey];
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 500; ++i) {
+    const doc = {_id: i, k: i % 7, v: values[i % values.length], w: i};
+    if (i % 11 == 0) {
+        delete doc.k;
+    }
+    if (i % 13 == 0) {
+        delete doc.v;
+    }
+    bulk.insert(doc);
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({k: 1}));
+assert.commandWorked(coll.createIndex({w: 1}));
+
+function runPipeline(pipeline, allowDiskUse) {
+    return coll.aggregate(pipeline, {allowDiskUse: allowDiskUse})
+        .toArray()
+        .sort((a, b) => bsonWoCompare({x: a._id}, {x: b._id}));
+}
+
+function isPushedDown(pipeline) {
+    const explain = coll.explain().aggregate(pipeline, {allowDiskUse: true});
+    return getAggPlanStage(explain, "$group") === null;
+}
+
+// Without 'allowDiskUse' the $group is executed by the aggregation framework, which provides the
+// expected results.
+const eligible = [
+    [{$group: {_id: "$k", min: {$min: "$v"}, max: {$max: "$v"}}}],
+    [{$match: {w: {$gte: 100}, k: {$in: [1, 2, 3]}}}, {$group: {_id: "$k", m: {$max: "$w"}}}],
+    [{$sort: {w: -1}}, {$limit: 50}, {$group: {_id: null, lo: {$min: "$w"}, c: {$max: 5}}}],
+    [{$group: {_id: "$v"}}],
+    [{$group: {_id: "$k", m: {$min: "$v.x"}}}, {$sort: {m: 1}}],
+];
+for (let pipeline of eligible) {
+    assert(isPushedDown(pipeline), pipeline);
+    assert.eq(runPipeline(pipeline, false), runPipeline(pipeline, true), pipeline);
+}
+
+// The input is spread over more groups than fit into the memory budget, so the hash aggregation
+// spills to disk and still returns each group once.
+const spilling = [{$group: {_id: "$w", m: {$max: "$v"}}}];
+assert(isPushedDown(spilling));
+assert.eq(runPipeline(spilling, false), runPipeline(spilling, true));
+
+// Accumulators and keys which the slot-based engine does not compute exactly like the aggregation
+// framework keep the $group in the pipeline.
+const ineligible = [
+    [{$group: {_id: "$k", s: {$sum: "$w"}}}],
+    [{$group: {_id: "$k", f: {$first: "$w"}}}],
+    [{$group: {_id: {k: "$k"}, m: {$min: "$w"}}}],
+    [{$group: {_id: {$add: ["$k", 1]}, m: {$min: "$w"}}}],
+    [{$group: {_id: "$$ROOT", m: {$min: "$w"}}}],
+];
+for (let pipeline of ineligible) {
+    assert(!isPushedDown(pipeline), pipeline);
+}
+
+// A non-simple collation also keeps the $group in the pipeline.
+const collatedExplain = coll.explain().aggregate(eligible[0], {
+    allowDiskUse: true,
+    collation: {locale: "en_US", strength: 2}
+});
+assert.neq(null, getAggPlanStage(collatedExplain, "$group"), collatedExplain);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,49 @@
+/**
+ * Tests that SBE collection scans split across several threads return the same results as serial
+ * scans.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryEnableSlotBasedExecutionEngine: true,
+        internalQuerySlotBasedExecutionCollScanDegreeOfParallelism: 4
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_parallel_collscan;
+coll.drop();
+
+// Insert enough documents for the collection to be split into multiple RecordId ranges.
+const nDocs = 50000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; ++i) {
+    bulk.insert({_id: i, a: i % 10});
+}
+assert.commandWorked(bulk.execute());
+
+function checkResults(filter, expectedIds) {
+    const ids = coll.find(filter, {_id: 1}).toArray().map(doc => doc._id);
+    ids.sort((a, b) => a - b);
+    assert.eq(expectedIds.length, ids.length, filter);
+    assert.eq(expectedIds, ids, filter);
+}
+
+const allIds = Array.from({length: nDocs}, (_, i) => i);
+checkResults({}, allIds);
+checkResults({a: 3}, allIds.filter(i => i % 10 === 3));
+checkResults({a: {$gt: 7}, _id: {$lt: 1000}}, allIds.filter(i => i % 10 > 7 && i < 1000));
+
+// Queries which ask for the natural order are still answered by a serial scan.
+const natural = coll.find({a: 1}).sort({$natural: 1}).toArray().map(doc => doc._id);
+assert.eq(allIds.filter(i => i % 10 === 1), natural);
+
+// The results do not change when the parallel scan is disabled.
+assert.commandWorked(db.adminCommand(
+    {setParameter: 1, internalQuerySlotBasedExecutionCollScanDegreeOfParallelism: 1}));
+checkResults({a: 3}, allIds.filter(i => i % 10 === 3));
+
+MongoRunner.stopMongod(conn);
+})();
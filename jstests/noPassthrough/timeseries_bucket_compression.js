@@ -0,0 +1,114 @@
+/**
+ * Tests that with 'timeseriesBucketCompression' enabled, time-series buckets are rewritten with
+ * compressed data columns once they are closed, and that queries return the same measurements from
+ * compressed and uncompressed buckets.
+ * @tags: [
+ *     requires_fcv_49,
+ *     requires_find_command,
+ *     requires_getmore,
+ * ]
+ */
+(function() {
+"use strict";
+
+load('jstests/core/timeseries/libs/timeseries.js');
+
+const conn = MongoRunner.runMongod({setParameter: {timeseriesBucketCompression: true}});
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const testDB = conn.getDB(jsTestName());
+
+// Assumes each bucket has a limit of 1000 measurements.
+const bucketMaxCount = 1000;
+const numDocs = bucketMaxCount + 100;
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+const runTest = function(numDocsPerInsert) {
+    const coll = testDB.getCollection('t_' + numDocsPerInsert);
+    const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+    coll.drop();
+
+    assert.commandWorked(testDB.createCollection(
+        coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+
+    const start = ISODate("2021-01-01T00:00:00Z");
+    const expected = [];
+    let docs = [];
+    for (let i = 0; i < numDocs; i++) {
+        const doc = {
+            _id: i,
+            [timeFieldName]: new Date(start.getTime() + i * 1000),
+            [metaFieldName]: "sensor",
+            counter: NumberLong(1000 + 3 * i),
+            reading: 20 + (i % 8) / 4,
+            state: i < 500 ? "ok" : "degraded",
+        };
+        if (i % 10 === 0) {
+            // Exercise columns with missing values.
+            doc.sparse = i;
+        }
+        expected.push(doc);
+        docs.push(doc);
+        if ((i + 1) % numDocsPerInsert === 0) {
+            assert.commandWorked(coll.insert(docs), 'failed to insert docs: ' + tojson(docs));
+            docs = [];
+        }
+    }
+
+    // The full bucket is compressed. The bucket still receiving measurements is not.
+    const bucketDocs = bucketsColl.find().sort({_id: 1}).toArray();
+    assert.eq(2, bucketDocs.length, bucketDocs);
+    assert.eq(2, bucketDocs[0].control.version, bucketDocs[0].control);
+    for (let field of [timeFieldName, '_id', 'counter', 'reading', 'state', 'sparse']) {
+        assert(bucketDocs[0].data[field] instanceof BinData, tojson(bucketDocs[0].data[field]));
+    }
+    assert.eq(0, bucketDocs[0].control.min._id, bucketDocs[0].control);
+    assert.eq(bucketMaxCount - 1, bucketDocs[0].control.max._id, bucketDocs[0].control);
+    assert.eq(1, bucketDocs[1].control.version, bucketDocs[1].control);
+
+    // Every measurement unpacks to what was inserted, types included.
+    const viewDocs = coll.find().sort({_id: 1}).toArray();
+    assert.eq(numDocs, viewDocs.length);
+    for (let i = 0; i < numDocs; i++) {
+        // The unpacked field order is not guaranteed to match the inserted order.
+        assert.eq(Object.keys(expected[i]).sort(), Object.keys(viewDocs[i]).sort(), viewDocs[i]);
+        for (let field in expected[i]) {
+            assert.eq(expected[i][field], viewDocs[i][field], viewDocs[i]);
+        }
+        assert(viewDocs[i].counter instanceof NumberLong, tojson(viewDocs[i]));
+    }
+
+    // Projections only decode the columns they need.
+    const projected = coll.find({state: "degraded"}, {_id: 0, reading: 1}).toArray();
+    assert.eq(numDocs - 500, projected.length);
+    assert.eq(numDocs / 10,
+              coll.aggregate([{$match: {sparse: {$exists: true}}}, {$count: "n"}]).toArray()[0].n);
+};
+
+runTest(1);
+runTest(numDocs);
+
+// Buckets closed while compression is disabled stay uncompressed and remain readable.
+assert.commandWorked(testDB.adminCommand({setParameter: 1, timeseriesBucketCompression: false}));
+const coll = testDB.getCollection('uncompressed');
+assert.commandWorked(
+    testDB.createCollection(coll.getName(), {timeseries: {timeField: timeFieldName}}));
+const docs = [];
+for (let i = 0; i < numDocs; i++) {
+    docs.push({_id: i, [timeFieldName]: ISODate(), x: i});
+}
+assert.commandWorked(coll.insert(docs));
+const bucketDocs = testDB.getCollection('system.buckets.' + coll.getName()).find().toArray();
+assert.eq(2, bucketDocs.length, bucketDocs);
+bucketDocs.forEach(bucket => assert.eq(1, bucket.control.version, bucket.control));
+assert.eq(numDocs, coll.find().itcount());
+
+MongoRunner.stopMongod(conn);
+})();
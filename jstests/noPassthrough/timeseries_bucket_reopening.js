@@ -0,0 +1,105 @@
+/**
+ * Tests that time-series buckets honor the bucket limits given at collection creation, and that
+ * buckets in the buckets collection are reopened for new or late measurements after a restart
+ * instead of starting new buckets.
+ * @tags: [
+ *     requires_fcv_49,
+ *     requires_find_command,
+ *     requires_persistence,
+ * ]
+ */
+(function() {
+"use strict";
+
+load('jstests/core/timeseries/libs/timeseries.js');
+
+let conn = MongoRunner.runMongod();
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const dbName = jsTestName();
+let testDB = conn.getDB(dbName);
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+
+// Invalid limits are rejected.
+for (let limits of [{bucketMaxCount: 0},
+                    {bucketMaxCount: 65536},
+                    {bucketMaxSizeBytes: 0},
+                    {bucketMaxSpanSeconds: 0}]) {
+    assert.commandFailed(testDB.createCollection(
+        'invalid', {timeseries: Object.assign({timeField: timeFieldName}, limits)}));
+}
+
+// The limits given at creation replace the defaults.
+const limitsColl = testDB.getCollection('limits');
+assert.commandWorked(testDB.createCollection(limitsColl.getName(), {
+    timeseries: {
+        timeField: timeFieldName,
+        metaField: metaFieldName,
+        bucketMaxCount: 10,
+        bucketMaxSpanSeconds: 60,
+    }
+}));
+const start = ISODate("2021-01-01T00:00:00Z");
+let docs = [];
+for (let i = 0; i < 25; i++) {
+    docs.push({[timeFieldName]: start, [metaFieldName]: 'count', x: i});
+}
+docs.push({[timeFieldName]: start, [metaFieldName]: 'span'});
+docs.push({[timeFieldName]: new Date(start.getTime() + 61 * 1000), [metaFieldName]: 'span'});
+assert.commandWorked(limitsColl.insert(docs));
+const limitsBuckets = testDB.getCollection('system.buckets.' + limitsColl.getName());
+assert.eq(3, limitsBuckets.find({meta: 'count'}).itcount());
+assert.eq(2, limitsBuckets.find({meta: 'span'}).itcount());
+
+// Write one bucket per series and restart, which empties the bucket catalog.
+const coll = testDB.getCollection('t');
+const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+assert.commandWorked(testDB.createCollection(
+    coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+const now = new Date();
+assert.commandWorked(coll.insert([
+    {_id: 0, [timeFieldName]: new Date(now.getTime() - 20 * 60 * 1000), [metaFieldName]: 'a'},
+    {_id: 1, [timeFieldName]: new Date(now.getTime() - 3 * 60 * 60 * 1000), [metaFieldName]: 'b'},
+]));
+assert.eq(2, bucketsColl.find().itcount());
+
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod({dbpath: conn.dbpath, noCleanData: true});
+testDB = conn.getDB(dbName);
+
+// A measurement in the time range of an existing bucket goes into that bucket.
+assert.commandWorked(testDB.t.insert(
+    {_id: 2, [timeFieldName]: new Date(now.getTime() - 10 * 60 * 1000), [metaFieldName]: 'a'}));
+assert.eq(2, testDB.system.buckets.t.find().itcount());
+assert.eq([0, 2], Object.values(testDB.system.buckets.t.findOne({meta: 'a'}).data._id));
+
+// A late measurement goes into an older bucket while newer measurements keep going into the
+// current bucket.
+assert.commandWorked(testDB.t.insert({_id: 3, [timeFieldName]: now, [metaFieldName]: 'b'}));
+assert.eq(3, testDB.system.buckets.t.find().itcount());
+assert.commandWorked(testDB.t.insert({
+    _id: 4,
+    [timeFieldName]: new Date(now.getTime() - 3 * 60 * 60 * 1000 + 1000),
+    [metaFieldName]: 'b'
+}));
+assert.commandWorked(testDB.t.insert(
+    {_id: 5, [timeFieldName]: new Date(now.getTime() + 1000), [metaFieldName]: 'b'}));
+assert.eq(3, testDB.system.buckets.t.find().itcount());
+assert.eq([[1, 4], [3, 5]],
+          testDB.system.buckets.t.find({meta: 'b'}).sort({_id: 1}).toArray().map(
+              bucket => Object.values(bucket.data._id)));
+
+assert.eq([0, 1, 2, 3, 4, 5], testDB.t.find().sort({_id: 1}).toArray().map(doc => doc._id));
+
+const stats = assert.commandWorked(testDB.t.stats());
+assert.eq(2, stats.numBucketsReopened, stats);
+
+MongoRunner.stopMongod(conn);
+})();
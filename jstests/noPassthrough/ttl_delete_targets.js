@@ -0,0 +1,41 @@
+/**
+ * Tests that the TTL monitor stops deleting from an index once it reaches its per-index target and
+ * revisits the index in a later sub-pass of the same pass until every expired document is removed.
+ *
+ * @tags: [requires_fcv_49]
+ */
+(function() {
+"use strict";
+
+const runner = MongoRunner.runMongod(
+    {setParameter: {ttlMonitorSleepSecs: 1, ttlIndexDeleteTargetDocs: 1}});
+const db = runner.getDB("test");
+const collA = db.ttl_delete_targets_a;
+const collB = db.ttl_delete_targets_b;
+
+const kNumDocs = 5;
+const expired = new Date(0);
+for (let coll of [collA, collB]) {
+    assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+    for (let i = 0; i < kNumDocs; i++) {
+        assert.commandWorked(coll.insert({x: expired}));
+    }
+}
+
+const ttlMetrics = () => db.serverStatus().metrics.ttl;
+const initialSubPasses = ttlMetrics().subPasses;
+const initialPasses = ttlMetrics().passes;
+
+// Wait for the TTL monitor to run at least twice (in case we weren't finished setting up our
+// collections when it ran the first time).
+assert.soon(() => ttlMetrics().passes >= initialPasses + 2,
+            "TTL monitor didn't run before timing out.");
+
+assert.eq(0, collA.find().itcount());
+assert.eq(0, collB.find().itcount());
+
+// Deleting one document per index at a time takes a sub-pass per document.
+assert.gte(ttlMetrics().subPasses, initialSubPasses + kNumDocs, ttlMetrics());
+
+MongoRunner.stopMongod(runner);
+})();
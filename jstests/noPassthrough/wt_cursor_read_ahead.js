@@ -0,0 +1,71 @@
+/**
+ * Tests that forward collection and index scans read ahead of themselves when
+ * wiredTigerCursorReadAheadEntries is set, and that the read-ahead counters are reported in
+ * serverStatus.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const readAheadEntries = 100;
+const conn = MongoRunner.runMongod(
+    {setParameter: {wiredTigerCursorReadAheadEntries: readAheadEntries}});
+assert.neq(null, conn, 'mongod was unable to start up');
+
+const db = conn.getDB('test');
+const coll = db.getCollection(jsTestName());
+
+const numDocs = 10 * readAheadEntries;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert({_id: i, a: i, padding: 'x'.repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function getReadAheadStats() {
+    const stats = db.serverStatus().wiredTiger.readAhead;
+    assert(stats, 'serverStatus is missing wiredTiger.readAhead');
+    return stats;
+}
+
+function windowsScheduledBy(scan) {
+    const before = getReadAheadStats();
+    scan();
+    const after = getReadAheadStats();
+    return after['windows scheduled'] + after['windows dropped'] -
+        (before['windows scheduled'] + before['windows dropped']);
+}
+
+// A forward collection scan over many windows' worth of records reads ahead.
+assert.gt(windowsScheduledBy(() => {
+              assert.eq(numDocs, coll.find().hint({$natural: 1}).itcount());
+          }),
+          0);
+
+// So does a forward index scan.
+assert.gt(windowsScheduledBy(() => {
+              assert.eq(numDocs, coll.find({a: {$gte: 0}}).hint({a: 1}).itcount());
+          }),
+          0);
+
+// Reverse scans and point lookups do not.
+assert.eq(0, windowsScheduledBy(() => {
+              assert.eq(numDocs, coll.find().hint({$natural: -1}).itcount());
+              assert.eq(numDocs, coll.find({a: {$gte: 0}}).sort({a: -1}).hint({a: 1}).itcount());
+              assert.eq(1, coll.find({a: 5}).hint({a: 1}).itcount());
+          }));
+
+const stats = getReadAheadStats();
+assert.gt(stats['entries read'], 0, stats);
+// Every window after a scan's first is scored by whether it had finished by the time it was needed.
+assert.gt(stats['hits'] + stats['misses'], 0, stats);
+
+// Read-ahead is turned off by setting the parameter back to 0.
+assert.commandWorked(db.adminCommand({setParameter: 1, wiredTigerCursorReadAheadEntries: 0}));
+assert.eq(0, windowsScheduledBy(() => {
+              assert.eq(numDocs, coll.find().hint({$natural: 1}).itcount());
+          }));
+
+MongoRunner.stopMongod(conn);
+})();
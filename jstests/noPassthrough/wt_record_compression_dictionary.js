@@ -0,0 +1,94 @@
+/**
+ * Tests that a collection created with a trained compression dictionary stores and returns its
+ * documents intact, including across a restart, and that invalid uses of the option are rejected.
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+let conn = MongoRunner.runMongod();
+assert.neq(null, conn, 'mongod was unable to start up');
+
+function makeEvent(i) {
+    return {
+        _id: i,
+        eventType: 'pageView',
+        userId: i % 97,
+        sessionId: i * 7919,
+        url: 'https://example.com/catalog/item/' + (i % 13),
+        userAgent: 'Mozilla/5.0 (X11; Linux x86_64)',
+    };
+}
+
+let db = conn.getDB('test');
+const source = db.getCollection('source');
+const numDocs = 2000;
+let bulk = source.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert(makeEvent(i));
+}
+assert.commandWorked(bulk.execute());
+
+assert.commandFailedWithCode(db.runCommand({trainCompressionDictionary: 'missing'}),
+                             ErrorCodes.NamespaceNotFound);
+assert.commandFailedWithCode(
+    db.runCommand({trainCompressionDictionary: source.getName(), maxDictionaryBytes: 0}),
+    ErrorCodes.BadValue);
+
+const trained = assert.commandWorked(
+    db.runCommand({trainCompressionDictionary: source.getName(), maxDictionaryBytes: 4096}));
+assert.eq(1000, trained.samples, tojson(trained));
+assert.neq(0, trained.dictionaryId, tojson(trained));
+const storageEngine = {wiredTiger: {compressionDictionary: trained.dictionary}};
+
+// The dictionary is not supported on capped collections, and must be a trained dictionary.
+assert.commandFailedWithCode(
+    db.createCollection('capped', {capped: true, size: 4096, storageEngine: storageEngine}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    db.createCollection('invalid',
+                        {storageEngine: {wiredTiger: {compressionDictionary: BinData(0, 'AAAA')}}}),
+    ErrorCodes.InvalidOptions);
+
+assert.commandWorked(db.createCollection('compressed', {storageEngine: storageEngine}));
+let coll = db.compressed;
+bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert(makeEvent(i));
+}
+// Documents which do not compress are stored as is.
+bulk.insert({_id: 'tiny'});
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({userId: 1}));
+
+assert.commandWorked(coll.update({_id: 5}, {$set: {eventType: 'click'}}));
+assert.commandWorked(coll.remove({_id: 6}));
+
+function checkContents() {
+    assert.eq(numDocs, coll.find().itcount());
+    assert.eq(Object.assign(makeEvent(5), {eventType: 'click'}), coll.findOne({_id: 5}));
+    assert.eq(null, coll.findOne({_id: 6}));
+    assert.eq(makeEvent(42), coll.findOne({_id: 42}));
+    assert.eq({_id: 'tiny'}, coll.findOne({_id: 'tiny'}));
+    assert.eq(coll.find({userId: 3}).itcount(), source.find({userId: 3}).itcount());
+
+    // The data size accounts for the documents as inserted, not as stored.
+    assert.eq(coll.stats().size,
+              source.stats().size + Object.bsonsize({_id: 'tiny'}) -
+                  Object.bsonsize(makeEvent(6)) + Object.bsonsize({eventType: 'click'}) -
+                  Object.bsonsize({eventType: 'pageView'}));
+
+    const res = assert.commandWorked(coll.validate({full: true}));
+    assert(res.valid, tojson(res));
+}
+checkContents();
+
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod({dbpath: conn.dbpath, noCleanData: true});
+assert.neq(null, conn, 'mongod was unable to restart');
+db = conn.getDB('test');
+coll = db.compressed;
+checkContents();
+
+MongoRunner.stopMongod(conn);
+})();
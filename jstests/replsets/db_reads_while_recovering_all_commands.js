@@ -300,6 +300,11 @@ const allCommands = {
     testVersions1And2: {skip: isNotAUserDataRead},
     testVersion2: {skip: isNotAUserDataRead},
     top: {skip: isNotAUserDataRead},
+    trainCompressionDictionary: {
+        command: {trainCompressionDictionary: collName},
+        expectFailure: true,
+        expectedErrorCode: ErrorCodes.NotPrimaryOrSecondary,
+    },
     update: {skip: isPrimaryOnly},
     updateRole: {skip: isPrimaryOnly},
     updateUser: {skip: isPrimaryOnly},
@@ -263,6 +263,17 @@ function testDbCheckParameters() {
         {dbCheck: multiBatchSimpleCollName, minKey: start, maxKey: end, maxSize: maxSize}));
     awaitDbCheckCompletion(db);
     checkEntryBounds(start, start + maxCount);
+
+    // Waiting for every node to replicate each batch checks the same documents.
+    clearLog();
+    assert.commandWorked(db.runCommand({
+        dbCheck: multiBatchSimpleCollName,
+        minKey: start,
+        maxKey: end,
+        batchWriteConcern: {w: nodeCount}
+    }));
+    awaitDbCheckCompletion(db);
+    checkEntryBounds(start, end);
 }
 
 testDbCheckParameters();
@@ -0,0 +1,28 @@
+/**
+ * Tests that the replOplogBufferMaxSizeBytes server parameter sizes the oplog buffer on a
+ * secondary, and that serverStatus reports the configured limit.
+ */
+(function() {
+"use strict";
+
+const kBufferSizeBytes = 64 * 1024 * 1024;
+
+const rst = new ReplSetTest({
+    nodes: [{}, {rsConfig: {priority: 0}}],
+    nodeOptions: {setParameter: {replOplogBufferMaxSizeBytes: kBufferSizeBytes}},
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+assert.commandWorked(primary.getDB("test").coll.insert({a: 1}, {writeConcern: {w: 2}}));
+
+const secondary = rst.getSecondary();
+const buffer = assert.commandWorked(secondary.adminCommand({serverStatus: 1})).metrics.repl.buffer;
+assert.eq(kBufferSizeBytes, buffer.maxSizeBytes, tojson(buffer));
+
+// The parameter is startup-only.
+assert.commandFailed(secondary.adminCommand({setParameter: 1, replOplogBufferMaxSizeBytes: 1}));
+
+rst.stopSet();
+}());
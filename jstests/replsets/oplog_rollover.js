@@ -135,6 +135,10 @@ function doTest(storageEngine) {
         assert.commandWorked(res);
         assert.eq(res.oplogTruncation.truncateCount, 1, tojson(res.oplogTruncation));
         assert.gt(res.oplogTruncation.totalTimeTruncatingMicros, 0, tojson(res.oplogTruncation));
+        // The single truncation is recorded in exactly one latency bucket.
+        const latencies = res.oplogTruncation.truncateLatencyMillis;
+        assert.eq(1, latencies.length, tojson(res.oplogTruncation));
+        assert.eq(1, latencies[0].count, tojson(res.oplogTruncation));
     } else {
         // Let the oplog cap maintainer thread start truncating the oplog.
         assert.commandWorked(primary.adminCommand(
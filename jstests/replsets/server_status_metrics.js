@@ -56,6 +56,10 @@ function _testSecondaryMetricsHelper(secondary, opCount, baseOpsApplied, baseOps
     assert(ss.metrics.repl.apply.batches.num > 0, "no batches");
     assert(ss.metrics.repl.apply.batches.totalMillis >= 0, "missing batch time");
     assert.eq(ss.metrics.repl.apply.ops, opCount + baseOpsApplied, "wrong number of applied ops");
+    assert.gt(ss.metrics.repl.apply.busiestWriterOps, 0, "no ops on busiest writer");
+    assert.gte(ss.metrics.repl.apply.writerOps,
+               ss.metrics.repl.apply.busiestWriterOps,
+               "busiest writer ops exceed total writer ops");
 }
 
 // Metrics are racy, e.g. repl.buffer.count could over- or under-reported briefly. Retry on error.
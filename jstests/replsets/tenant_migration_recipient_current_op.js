@@ -93,6 +93,7 @@ assert(!currOp.startApplyingDonorOpTime, tojson(res));
 assert(!currOp.dataConsistentStopDonorOpTime, tojson(res));
 assert(!currOp.cloneFinishedRecipientOpTime, tojson(res));
 assert(!currOp.expireAt, tojson(res));
+assert(!currOp.databases, tojson(res));
 fpAfterPersistingStateDoc.off();
 
 // Allow the migration to move to the point where the startFetchingDonorOpTime has been obtained.
@@ -130,6 +131,9 @@ assert(currOp.startFetchingDonorOpTime, tojson(res));
 assert(currOp.startApplyingDonorOpTime, tojson(res));
 assert(currOp.dataConsistentStopDonorOpTime, tojson(res));
 assert(currOp.cloneFinishedRecipientOpTime, tojson(res));
+// The cloner progress is reported once cloning has started.
+assert(currOp.databases, tojson(res));
+assert.eq(typeof currOp.databases.databasesCloned, "number", tojson(res));
 fpAfterCollectionCloner.off();
 
 // Wait for the "kConsistent" state to be reached.
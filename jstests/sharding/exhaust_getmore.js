@@ -0,0 +1,47 @@
+/**
+ * Tests that mongos streams getMore batches to a client which asked for an exhaust cursor, and that
+ * the client receives every document of a query targeting several shards.
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest(
+    {shards: 2, mongos: 1, other: {mongosOptions: {networkMessageCompressors: "snappy"}}});
+const dbName = "test";
+const collName = "exhaust_getmore";
+const ns = dbName + "." + collName;
+
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+assert.commandWorked(st.s.adminCommand({shardCollection: ns, key: {_id: 1}}));
+assert.commandWorked(st.s.adminCommand({split: ns, middle: {_id: 50}}));
+assert.commandWorked(
+    st.s.adminCommand({moveChunk: ns, find: {_id: 50}, to: st.shard1.shardName}));
+
+const kDocumentCount = 100;
+const bulk = st.s.getCollection(ns).initializeUnorderedBulkOp();
+for (let i = 0; i < kDocumentCount; ++i) {
+    bulk.insert({_id: i});
+}
+assert.commandWorked(bulk.execute());
+
+// Compressed exhaust replies pass through a fail point, which lets the test count them.
+const awaitShell = startParallelShell(function() {
+    const fp = "beforeCompressingExhaustResponse";
+    const preRes =
+        assert.commandWorked(db.adminCommand({configureFailPoint: fp, mode: "alwaysOn"}));
+
+    const docs = db.exhaust_getmore.find({})
+                     .sort({_id: 1})
+                     .batchSize(10)
+                     .addOption(DBQuery.Option.exhaust)
+                     .toArray();
+    assert.eq([...Array(100).keys()], docs.map(doc => doc._id));
+
+    const postRes = assert.commandWorked(db.adminCommand({configureFailPoint: fp, mode: "off"}));
+    assert.gt(postRes.count, preRes.count, "getMore batches were not streamed by mongos");
+}, st.s.port, false, "--networkMessageCompressors", "snappy");
+awaitShell();
+
+st.stop();
+})();
@@ -0,0 +1,44 @@
+// Check that a client reconnecting to a server resumes its previous TLS session, and that the
+// server counts it.
+
+(function() {
+"use strict";
+
+load("jstests/ssl/libs/ssl_helpers.js");
+
+requireSSLProvider('openssl', function() {
+    const conn = MongoRunner.runMongod({
+        tlsMode: "preferTLS",
+        tlsCertificateKeyFile: SERVER_CERT,
+        tlsCAFile: CA_CERT,
+        tlsAllowInvalidHostnames: "",
+    });
+
+    // Each new Mongo() inside the shell is a fresh egress connection to the same host, so all but
+    // the first should resume the session negotiated by an earlier one.
+    const kConnections = 5;
+    const exitStatus = runMongoProgram(
+        'mongo',
+        '--tls',
+        '--tlsAllowInvalidHostnames',
+        '--tlsCertificateKeyFile',
+        CLIENT_CERT,
+        '--tlsCAFile',
+        CA_CERT,
+        '--port',
+        conn.port,
+        '--eval',
+        `for (let i = 0; i < ${kConnections}; ++i) {
+             const c = new Mongo(db.getMongo().host);
+             assert.commandWorked(c.adminCommand({ping: 1}));
+         }`);
+    assert.eq(0, exitStatus, "Client failed to connect over TLS");
+
+    const stats = assert.commandWorked(conn.adminCommand({serverStatus: 1})).tlsSessionResumption;
+    jsTestLog("Server TLS session resumption: " + tojson(stats));
+    assert.gt(stats.ingress.resumed, 0, tojson(stats));
+    assert.gt(stats.ingress.full, 0, tojson(stats));
+
+    MongoRunner.stopMongod(conn);
+});
+}());
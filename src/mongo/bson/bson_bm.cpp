@@ -112,8 +112,29 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+// Validates flat objects made of fixed-width numeric fields with long names, which stresses the
+// field name scan rather than the per-type dispatch.
+void BM_validateNumericFields(benchmark::State& state) {
+    BSONObjBuilder builder;
+    for (auto j = 0; j < state.range(0); j++) {
+        builder.append(fmt::format("numericFieldWithAFairlyLongName{}", j), j);
+        builder.append(fmt::format("anotherNumericField{}", j), static_cast<double>(j));
+    }
+    BSONObj obj = builder.obj();
+    invariant(validateBSON(obj.objdata(), obj.objsize()).isOK());
+
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize()));
+        totalSize += obj.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateNumericFields)->Ranges({{{1}, {1'000}}});
 
 }  // namespace mongo
@@ -419,6 +419,22 @@ TEST(BSONValidateFast, ValidCodeWScope) {
     ASSERT_OK(validateBSON(obj.objdata(), obj.objsize()));
 }
 
+TEST(BSONValidateFast, FieldNameLengths) {
+    // Field names are scanned in blocks, so exercise names ending at every offset within a block,
+    // both followed by more data and ending right before the final EOO byte.
+    for (int nameLen = 1; nameLen <= 48; ++nameLen) {
+        std::string name(nameLen, 'a');
+        BSONObj obj = BSON(name << 1 << "b" << name << name + "c" << BSONObj());
+        ASSERT_OK(validateBSON(obj.objdata(), obj.objsize()));
+
+        // Replace the NUL terminating the field name, so the name runs into the int value.
+        BSONObj single = BSON(name << 1);
+        std::string corrupted(single.objdata(), single.objsize());
+        corrupted[4 + 1 + nameLen] = 'x';
+        ASSERT_NOT_OK(validateBSON(corrupted.data(), corrupted.size()));
+    }
+}
+
 BSONObj nest(int nesting) {
     return nesting < 1 ? BSON("i" << nesting) : BSON("i" << nesting << "o" << nest(nesting - 1));
 }
@@ -465,6 +465,11 @@ protected:
         while (a < minSize)
             a = a * 2;
 
+        // Don't double past the largest internal object for a buffer that still fits in one; a
+        // full 16MB command reply would otherwise end up in a 32MB allocation.
+        if (minSize <= BSONObjMaxInternalSize && a > BSONObjMaxInternalSize)
+            a = BSONObjMaxInternalSize;
+
         _buf.realloc(a);
     }
 
@@ -84,6 +84,16 @@ TEST(Builder, StackAllocatorShouldNotLeak) {
     // Let the builder go out of scope. If this leaks, it will trip the ASAN leak detector.
 }
 
+TEST(Builder, GrowthStopsAtMaxInternalObjectSize) {
+    BufBuilder builder;
+    builder.skip(BSONObjMaxUserSize + 1);
+    ASSERT_EQ(builder.getSize(), BSONObjMaxInternalSize);
+
+    // Growing past the limit resumes doubling.
+    builder.skip(BSONObjMaxInternalSize - builder.len() + 1);
+    ASSERT_EQ(builder.getSize(), 2 * BSONObjMaxUserSize);
+}
+
 template <typename T>
 void testStringBuilderIntegral() {
     auto check = [](T num) { ASSERT_EQ(std::string(str::stream() << num), std::to_string(num)); };
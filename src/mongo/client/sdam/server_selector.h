@@ -36,8 +36,12 @@
 #include "mongo/client/sdam/server_description.h"
 #include "mongo/client/sdam/topology_description.h"
 #include "mongo/platform/random.h"
+#include "mongo/util/fail_point.h"
 
 namespace mongo::sdam {
+// Makes server selection return every suitable server, regardless of the latency window.
+extern FailPoint sdamServerSelectorIgnoreLatencyWindow;
+
 /**
  * This is the interface that allows one to select a server to satisfy a DB operation given a
  * TopologyDescription and a ReadPreferenceSetting.
@@ -100,25 +100,27 @@ bool TopologyManager::onServerDescription(const HelloOutcome& helloOutcome) {
         _clockSource, helloOutcome, lastRTT, newTopologyVersion);
 
     auto oldTopologyDescription = _topologyDescription;
-    _topologyDescription = TopologyDescription::clone(oldTopologyDescription);
+    auto newTopologyDescription = TopologyDescription::clone(oldTopologyDescription);
 
     // if we are equal to the old description, just install the new description without
     // performing any actions on the state machine.
     auto isEqualToOldServerDescription =
         (lastServerDescription && (*lastServerDescription->get()) == *newServerDescription);
     if (isEqualToOldServerDescription) {
-        _topologyDescription->installServerDescription(newServerDescription);
+        newTopologyDescription->installServerDescription(newServerDescription);
     } else {
-        _topologyStateMachine->onServerDescription(*_topologyDescription, newServerDescription);
+        _topologyStateMachine->onServerDescription(*newTopologyDescription, newServerDescription);
     }
 
-    _publishTopologyDescriptionChanged(oldTopologyDescription, _topologyDescription);
+    // Only publish the clone once it is complete, since readers do not take the mutex.
+    atomic_store(&_topologyDescription, newTopologyDescription);
+
+    _publishTopologyDescriptionChanged(oldTopologyDescription, newTopologyDescription);
     return true;
 }
 
 const std::shared_ptr<TopologyDescription> TopologyManager::getTopologyDescription() const {
-    stdx::lock_guard<mongo::Mutex> lock(_mutex);
-    return _topologyDescription;
+    return atomic_load(&_topologyDescription);
 }
 
 void TopologyManager::onServerRTTUpdated(HostAndPort hostAndPort, HelloRTT rtt) {
@@ -130,10 +132,11 @@ void TopologyManager::onServerRTTUpdated(HostAndPort hostAndPort, HelloRTT rtt)
             auto newServerDescription = (*oldServerDescription)->cloneWithRTT(rtt);
 
             auto oldTopologyDescription = _topologyDescription;
-            _topologyDescription = TopologyDescription::clone(oldTopologyDescription);
-            _topologyDescription->installServerDescription(newServerDescription);
+            auto newTopologyDescription = TopologyDescription::clone(oldTopologyDescription);
+            newTopologyDescription->installServerDescription(newServerDescription);
+            atomic_store(&_topologyDescription, newTopologyDescription);
 
-            _publishTopologyDescriptionChanged(oldTopologyDescription, _topologyDescription);
+            _publishTopologyDescriptionChanged(oldTopologyDescription, newTopologyDescription);
 
             return;
         }
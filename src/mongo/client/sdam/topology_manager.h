@@ -75,7 +75,8 @@ public:
     void onServerRTTUpdated(HostAndPort hostAndPort, HelloRTT rtt);
 
     /**
-     * Get the current TopologyDescription. This is safe to call from multiple threads.
+     * Get the current TopologyDescription. This is safe to call from multiple threads and does not
+     * take the mutex: a TopologyDescription is never modified once it has been installed.
      */
     const TopologyDescriptionPtr getTopologyDescription() const;
 
@@ -93,6 +94,7 @@ private:
     mutable mongo::Mutex _mutex = MONGO_MAKE_LATCH("TopologyManager");
     const SdamConfiguration _config;
     ClockSource* _clockSource;
+    // Written under _mutex, read without it. Accessed with atomic_load and atomic_store.
     TopologyDescriptionPtr _topologyDescription;
     TopologyStateMachinePtr _topologyStateMachine;
     TopologyEventsPublisherPtr _topologyEventsPublisher;
@@ -420,10 +420,62 @@ boost::optional<std::vector<HostAndPort>> StreamableReplicaSetMonitor::_getHosts
     const TopologyDescriptionPtr& topology,
     const ReadPreferenceSetting& criteria,
     const std::vector<HostAndPort>& excludedHosts) {
+    // Selections which exclude hosts are rare and not worth caching. When the latency window is
+    // ignored the selection must be recomputed as well, so that toggling the fail point applies
+    // immediately.
+    const bool useCache = excludedHosts.empty() &&
+        !MONGO_unlikely(sdamServerSelectorIgnoreLatencyWindow.shouldFail());
+    if (useCache) {
+        if (auto cachedHosts = _getCachedHosts(topology, criteria)) {
+            return cachedHosts;
+        }
+    }
+
     auto result = _serverSelector->selectServers(topology, criteria, excludedHosts);
     if (!result)
         return boost::none;
-    return _extractHosts(*result);
+
+    auto hosts = _extractHosts(*result);
+    if (useCache && !hosts.empty()) {
+        _cacheHosts(topology, criteria, hosts);
+    }
+    return hosts;
+}
+
+boost::optional<std::vector<HostAndPort>> StreamableReplicaSetMonitor::_getCachedHosts(
+    const TopologyDescriptionPtr& topology, const ReadPreferenceSetting& criteria) {
+    auto cache = atomic_load(&_selectionCache);
+    if (!cache || cache->topology != topology)
+        return boost::none;
+
+    auto it = std::find_if(cache->entries.begin(), cache->entries.end(), [&](const auto& entry) {
+        return entry.first.equals(criteria);
+    });
+    if (it == cache->entries.end())
+        return boost::none;
+
+    auto hosts = it->second;
+    auto rotation = _selectionCacheRotation.fetchAndAdd(1) % hosts.size();
+    std::rotate(hosts.begin(), hosts.begin() + rotation, hosts.end());
+    return hosts;
+}
+
+void StreamableReplicaSetMonitor::_cacheHosts(const TopologyDescriptionPtr& topology,
+                                              const ReadPreferenceSetting& criteria,
+                                              const std::vector<HostAndPort>& hosts) {
+    auto oldCache = atomic_load(&_selectionCache);
+    auto newCache = std::make_shared<SelectionCache>();
+    newCache->topology = topology;
+    if (oldCache && oldCache->topology == topology) {
+        newCache->entries = oldCache->entries;
+        if (newCache->entries.size() >= kMaxSelectionCacheEntries) {
+            newCache->entries.erase(newCache->entries.begin());
+        }
+    }
+    newCache->entries.emplace_back(criteria, hosts);
+
+    // A concurrent selection may overwrite this one; that only costs a later cache miss.
+    atomic_store(&_selectionCache, std::shared_ptr<const SelectionCache>(std::move(newCache)));
 }
 
 boost::optional<std::vector<HostAndPort>> StreamableReplicaSetMonitor::_getHosts(
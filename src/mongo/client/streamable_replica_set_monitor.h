@@ -45,6 +45,7 @@
 #include "mongo/executor/egress_tag_closer.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/logv2/log_component.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/duration.h"
 #include "mongo/util/net/hostandport.h"
@@ -219,6 +220,14 @@ private:
         const ReadPreferenceSetting& criteria,
         const std::vector<HostAndPort>& excludedHosts = std::vector<HostAndPort>());
 
+    // Returns the hosts previously selected for 'criteria' against 'topology', rotated so that
+    // consecutive callers do not all see the same host first, or boost::none if there are none.
+    boost::optional<std::vector<HostAndPort>> _getCachedHosts(
+        const TopologyDescriptionPtr& topology, const ReadPreferenceSetting& criteria);
+    void _cacheHosts(const TopologyDescriptionPtr& topology,
+                     const ReadPreferenceSetting& criteria,
+                     const std::vector<HostAndPort>& hosts);
+
     // Incoming Events
     void onTopologyDescriptionChangedEvent(sdam::TopologyDescriptionPtr previousDescription,
                                            sdam::TopologyDescriptionPtr newDescription) override;
@@ -297,6 +306,18 @@ private:
     boost::optional<ChangeNotifierState> _confirmedNotifierState;
     mutable PseudoRandom _random;
 
+    // The hosts selected for the most recently used read preferences against a single
+    // TopologyDescription. TopologyDescriptions are immutable once installed, so the selections
+    // stay valid until the topology changes, at which point the cache is replaced wholesale. It
+    // is copy-on-write and accessed with atomic_load and atomic_store.
+    struct SelectionCache {
+        TopologyDescriptionPtr topology;
+        std::vector<std::pair<ReadPreferenceSetting, std::vector<HostAndPort>>> entries;
+    };
+    static constexpr size_t kMaxSelectionCacheEntries = 16;
+    std::shared_ptr<const SelectionCache> _selectionCache;
+    AtomicWord<unsigned> _selectionCacheRotation{0};
+
     static constexpr auto kDefaultLogLevel = 0;
     static constexpr auto kLowerLogLevel = 1;
     static constexpr auto kLogPrefix = "[ReplicaSetMonitor]";
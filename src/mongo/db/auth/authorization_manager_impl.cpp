@@ -603,6 +603,25 @@ void AuthorizationManagerImpl::invalidateUsersFromDB(OperationContext* opCtx, St
         [&](const UserRequest& userRequest) { return userRequest.name.getDB() == dbname; });
 }
 
+void AuthorizationManagerImpl::invalidateUsersByRole(OperationContext* opCtx,
+                                                     const RoleName& roleName) {
+    LOGV2_DEBUG(5512400, 2, "Invalidating users holding role", "role"_attr = roleName);
+    _updateCacheGeneration();
+    _authSchemaVersionCache.invalidateAll();
+    _userCache.invalidateLookupsAndCachedValueIf([&](const User& user) {
+        if (user.hasRole(roleName)) {
+            return true;
+        }
+        auto indirectRoles = user.getIndirectRoles();
+        while (indirectRoles.more()) {
+            if (indirectRoles.next() == roleName) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
 void AuthorizationManagerImpl::invalidateUserCache(OperationContext* opCtx) {
     LOGV2_DEBUG(20237, 2, "Invalidating user cache");
     _updateCacheGeneration();
@@ -109,6 +109,12 @@ public:
 
     void invalidateUsersFromDB(OperationContext* opCtx, StringData dbname) override;
 
+    /**
+     * Invalidate the users whose privileges were resolved through the given role, either directly
+     * or through role inheritance.
+     */
+    void invalidateUsersByRole(OperationContext* opCtx, const RoleName& roleName);
+
     Status initialize(OperationContext* opCtx) override;
 
     /**
@@ -300,5 +300,51 @@ TEST_F(AuthorizationManagerTest, testAcquireV2UserWithUnrecognizedActions) {
     ASSERT(actions.empty());
 }
 
+TEST_F(AuthorizationManagerTest, testRoleUpdateInvalidatesOnlyUsersHoldingTheRole) {
+    for (auto&& [user, role] : {std::make_pair("reader", "read"),
+                                std::make_pair("writer", "readWrite")}) {
+        ASSERT_OK(externalState->insertPrivilegeDocument(
+            opCtx.get(),
+            BSON("_id"
+                 << (std::string("test.") + user) << "user" << user << "db"
+                 << "test"
+                 << "credentials" << credentials << "roles"
+                 << BSON_ARRAY(BSON("role" << role << "db"
+                                           << "test"))),
+            BSONObj()));
+    }
+
+    auto reader =
+        uassertStatusOK(authzManager->acquireUser(opCtx.get(), UserName("reader", "test")));
+    auto writer =
+        uassertStatusOK(authzManager->acquireUser(opCtx.get(), UserName("writer", "test")));
+    ASSERT(reader.isValid());
+    ASSERT(writer.isValid());
+
+    // Updating a role only invalidates the users which hold it.
+    const auto roleQuery = BSON("_id"
+                                << "test.read");
+    authzManager->logOp(opCtx.get(),
+                        "u",
+                        AuthorizationManager::rolesCollectionNamespace,
+                        BSON("$set" << BSON("privileges" << BSONArray())),
+                        &roleQuery);
+    ASSERT_FALSE(reader.isValid());
+    ASSERT(writer.isValid());
+
+    // Inserting a role invalidates every user.
+    authzManager->logOp(opCtx.get(),
+                        "i",
+                        AuthorizationManager::rolesCollectionNamespace,
+                        BSON("_id"
+                             << "test.newRole"
+                             << "role"
+                             << "newRole"
+                             << "db"
+                             << "test"),
+                        nullptr);
+    ASSERT_FALSE(writer.isValid());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -665,9 +665,10 @@ Status AuthzManagerExternalStateLocal::getRoleDescriptionsForDB(
  * Below this point is the implementation of our OpObserver handler.
  *
  * Ops which mutate user documents will invalidate those specific users
- * from the UserCache.
+ * from the UserCache. Ops which update or delete role documents will
+ * invalidate the users holding those roles.
  *
- * Any other privilege related op (mutation to roles or version collection,
+ * Any other privilege related op (role insertion, mutation to version collection,
  * or command issued on the admin namespace) will invalidate the entire
  * user cache.
  */
@@ -724,6 +725,19 @@ void _invalidateUserCache(OperationContext* opCtx,
         }
         UserName userName(id.substr(splitPoint + 1), id.substr(0, splitPoint));
         authzManager->invalidateUserByName(opCtx, userName);
+    } else if ((coll == AuthzCollection::kRoles) && ((op == kOpUpdate) || (op == kOpDelete))) {
+        // An existing role can only affect the users which resolved their privileges through it.
+        // An inserted role is not known to have been resolved by anyone, so it falls through to
+        // invalidating the entire cache below.
+        const BSONObj* src = (op == kOpUpdate) ? o2 : &o;
+        auto id = src ? (*src)["_id"].str() : std::string();
+        auto splitPoint = id.find('.');
+        if (splitPoint == std::string::npos) {
+            authzManager->invalidateUserCache(opCtx);
+            return;
+        }
+        RoleName roleName(id.substr(splitPoint + 1), id.substr(0, splitPoint));
+        authzManager->invalidateUsersByRole(opCtx, roleName);
     } else {
         authzManager->invalidateUserCache(opCtx);
     }
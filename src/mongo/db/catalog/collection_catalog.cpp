@@ -45,12 +45,31 @@
 
 namespace mongo {
 namespace {
+// Source of the versions identifying published catalog instances. Shared by all ServiceContexts so
+// that a version never identifies more than one instance.
+AtomicWord<unsigned long long> catalogVersionCounter{0};
+
 struct LatestCollectionCatalog {
     std::shared_ptr<CollectionCatalog> catalog = std::make_shared<CollectionCatalog>();
+    // Identifies 'catalog'. A new version is published after every store to 'catalog'.
+    AtomicWord<unsigned long long> version{catalogVersionCounter.addAndFetch(1)};
 };
 const ServiceContext::Decoration<LatestCollectionCatalog> getCatalog =
     ServiceContext::declareDecoration<LatestCollectionCatalog>();
 
+/**
+ * Per-thread cache of the most recently read catalog instance. atomic_load of a shared_ptr
+ * serializes every reader on a lock keyed by the pointer's address, which all operations share. As
+ * long as the published version is unchanged, readers instead promote their cached weak_ptr, which
+ * is lock-free. Holding only a weak reference means an idle thread does not keep a replaced
+ * catalog, and the collections it references, alive.
+ */
+struct CachedCollectionCatalog {
+    unsigned long long version = 0;
+    std::weak_ptr<const CollectionCatalog> catalog;
+};
+thread_local CachedCollectionCatalog cachedCatalog;
+
 /**
  * Decoration on OperationContext to store cloned Collections until they are committed or rolled
  * back TODO SERVER-51236: This should be merged with UncommittedCollections
@@ -394,7 +413,20 @@ bool CollectionCatalog::iterator::_exhausted() {
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(ServiceContext* svcCtx) {
-    return atomic_load(&getCatalog(svcCtx).catalog);
+    auto& storage = getCatalog(svcCtx);
+    const auto version = storage.version.load();
+    if (cachedCatalog.version == version) {
+        if (auto catalog = cachedCatalog.catalog.lock()) {
+            return catalog;
+        }
+    }
+
+    // The catalog is stored before its version is published, so this is at least as recent as
+    // 'version'.
+    std::shared_ptr<const CollectionCatalog> catalog = atomic_load(&storage.catalog);
+    cachedCatalog.version = version;
+    cachedCatalog.catalog = catalog;
+    return catalog;
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(OperationContext* opCtx) {
@@ -507,6 +539,7 @@ void CollectionCatalog::write(ServiceContext* svcCtx, CatalogWriteFn job) {
         if (queue.empty()) {
             // Queue is empty, store catalog and relinquish responsibility of being worker thread
             atomic_store(&storage.catalog, std::move(clone));
+            storage.version.store(catalogVersionCounter.addAndFetch(1));
             workerExists = false;
             break;
         }
@@ -396,6 +396,24 @@ TEST_F(CollectionCatalogIterationTest, GetUUIDWontRepositionEvenIfEntryIsDropped
     ASSERT_EQUALS(uuid, it.uuid());
 }
 
+TEST_F(CollectionCatalogTest, GetReturnsCatalogPublishedByWrite) {
+    auto svcCtx = getServiceContext();
+    auto before = CollectionCatalog::get(svcCtx);
+    ASSERT_EQ(before, CollectionCatalog::get(svcCtx));
+
+    auto uuid = CollectionUUID::gen();
+    CollectionCatalog::write(svcCtx, [&](CollectionCatalog& writable) {
+        writable.registerCollection(
+            &opCtx, uuid, std::make_shared<CollectionMock>(NamespaceString("testdb.published")));
+    });
+
+    auto after = CollectionCatalog::get(svcCtx);
+    ASSERT_NE(before, after);
+    ASSERT(after->lookupCollectionByUUID(&opCtx, uuid));
+    ASSERT_FALSE(before->lookupCollectionByUUID(&opCtx, uuid));
+    ASSERT_EQ(after, CollectionCatalog::get(svcCtx));
+}
+
 TEST_F(CollectionCatalogTest, OnCreateCollection) {
     ASSERT(catalog.lookupCollectionByUUID(&opCtx, colUUID) == col);
 }
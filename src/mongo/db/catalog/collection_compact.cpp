@@ -71,7 +71,8 @@ CollectionPtr getCollectionForCompact(OperationContext* opCtx,
 }  // namespace
 
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
-                                      const NamespaceString& collectionNss) {
+                                      const NamespaceString& collectionNss,
+                                      boost::optional<long long> freeSpaceTargetMB) {
     AutoGetDb autoDb(opCtx, collectionNss.db(), MODE_IX);
     Database* database = autoDb.getDb();
     uassert(ErrorCodes::NamespaceNotFound, "database does not exist", database);
@@ -103,6 +104,21 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
         recordStore = collection->getRecordStore();
     }
 
+    if (freeSpaceTargetMB) {
+        auto reclaimableBytes =
+            recordStore->freeStorageSize(opCtx) +
+            static_cast<int64_t>(collection->getIndexFreeStorageBytes(opCtx));
+        if (reclaimableBytes < *freeSpaceTargetMB * 1024 * 1024) {
+            LOGV2_OPTIONS(5512300,
+                          {LogComponent::kCommand},
+                          "Skipping compact, not enough space is available for reuse",
+                          "namespace"_attr = collectionNss,
+                          "reclaimableBytes"_attr = reclaimableBytes,
+                          "freeSpaceTargetMB"_attr = *freeSpaceTargetMB);
+            return 0;
+        }
+    }
+
     LOGV2_OPTIONS(20284,
                   {LogComponent::kCommand},
                   "compact {namespace} begin",
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/base/status.h"
 #include "mongo/db/storage/record_store.h"
 
@@ -37,10 +39,15 @@ namespace mongo {
 /**
  * Compacts collection.
  *
+ * If 'freeSpaceTargetMB' is set, the collection is only compacted when its storage and indexes
+ * report at least that many megabytes available for reuse; otherwise it is left alone and zero
+ * is returned.
+ *
  * Returns the number of bytes of stable storage and index size that were freed. If the total
  * size decreased, the return value is positive. Otherwise, the return value is negative.
  */
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
-                                      const NamespaceString& collectionNss);
+                                      const NamespaceString& collectionNss,
+                                      boost::optional<long long> freeSpaceTargetMB = boost::none);
 
 }  // namespace mongo
@@ -219,7 +219,7 @@ CollectionImpl::SharedState::SharedState(CollectionImpl* collection,
                           ? std::make_shared<CappedInsertNotifier>()
                           : nullptr),
       _needCappedLock(_recordStore && _recordStore->isCapped() &&
-                      collection->ns().db() != "local") {
+                      collection->ns().isReplicated()) {
     if (_cappedNotifier) {
         _recordStore->setCappedCallback(this);
     }
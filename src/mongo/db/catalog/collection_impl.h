@@ -444,6 +444,9 @@ private:
         // This is non-null if and only if the collection is a capped collection.
         const std::shared_ptr<CappedInsertNotifier> _cappedNotifier;
 
+        // Writes to a replicated capped collection are serialized so that secondaries apply them,
+        // and therefore delete documents, in the same order as the primary. Capped collections
+        // which are not replicated, such as those in 'local' and 'system.profile', skip this.
         const bool _needCappedLock;
 
         AtomicWord<bool> _committed{true};
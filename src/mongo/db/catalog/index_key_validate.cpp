@@ -137,7 +137,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMNAR) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -176,6 +176,11 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code,
                           str::stream() << "The key pattern value for an '" << IndexNames::WILDCARD
                                         << "' index must be a non-zero number, not a string.");
+        } else if (pluginName == IndexNames::COLUMNAR && keyElement.type() != String) {
+            return Status(code,
+                          str::stream() << "Every field of a '" << IndexNames::COLUMNAR
+                                        << "' index must have the value '" << IndexNames::COLUMNAR
+                                        << "'.");
         }
 
         // Check if the wildcard index is compounded. If it is the key is invalid because
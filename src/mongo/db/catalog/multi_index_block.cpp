@@ -58,6 +58,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/progress_meter.h"
@@ -572,6 +573,41 @@ Status MultiIndexBlock::insertSingleDocumentForInitialSyncOrRecovery(OperationCo
     return _insert(opCtx, doc, loc);
 }
 
+Status MultiIndexBlock::insertDocumentsForInitialSyncOrRecovery(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs, const std::vector<RecordId>& locs) {
+    invariant(!_buildIsCleanedUp);
+    invariant(docs.size() == locs.size());
+    if (docs.empty()) {
+        return Status::OK();
+    }
+
+    for (size_t i = 0; i < _indexes.size(); i++) {
+        for (size_t j = 0; j < docs.size(); j++) {
+            if (_indexes[i].filterExpression &&
+                !_indexes[i].filterExpression->matchesBSON(docs[j])) {
+                continue;
+            }
+
+            Status idxStatus = Status::OK();
+
+            // When calling insert, BulkBuilderImpl's Sorter performs file I/O that may result in an
+            // exception.
+            try {
+                idxStatus = _indexes[i].bulk->insert(opCtx, docs[j], locs[j], _indexes[i].options);
+            } catch (...) {
+                return exceptionToStatus();
+            }
+
+            if (!idxStatus.isOK())
+                return idxStatus;
+        }
+    }
+
+    _lastRecordIdInserted = locs.back();
+
+    return Status::OK();
+}
+
 Status MultiIndexBlock::_insert(OperationContext* opCtx, const BSONObj& doc, const RecordId& loc) {
     invariant(!_buildIsCleanedUp);
     for (size_t i = 0; i < _indexes.size(); i++) {
@@ -622,6 +658,38 @@ Status MultiIndexBlock::dumpInsertsFromBulk(
               IndexBuildPhase_serializer(_phase).toString());
     _phase = IndexBuildPhaseEnum::kBulkLoad;
 
+    // Loading keys into the indexes must happen one index at a time on this thread, but sorting
+    // what each index's sorter still holds in memory needs neither the OperationContext nor any
+    // shared state. Sort those runs for all indexes concurrently, so that commitBulk() finds them
+    // sorted instead of sorting each in turn. No additional memory is used: the keys are already
+    // resident and are only reordered.
+    if (_indexes.size() > 1) {
+        std::vector<Status> statuses(_indexes.size(), Status::OK());
+        auto sortPendingKeys = [&](size_t i) {
+            try {
+                _indexes[i].bulk->sortPendingKeys();
+            } catch (...) {
+                statuses[i] = exceptionToStatus();
+            }
+        };
+
+        std::vector<stdx::thread> threads;
+        threads.reserve(_indexes.size() - 1);
+        for (size_t i = 1; i < _indexes.size(); i++) {
+            threads.emplace_back(sortPendingKeys, i);
+        }
+        sortPendingKeys(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (const auto& status : statuses) {
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+    }
+
     for (size_t i = 0; i < _indexes.size(); i++) {
         // When onDuplicateRecord is passed, 'dupsAllowed' should be passed to reflect whether or
         // not the index is unique.
@@ -168,6 +168,18 @@ public:
                                                         const BSONObj& wholeDocument,
                                                         const RecordId& loc);
 
+    /**
+     * Same as calling insertSingleDocumentForInitialSyncOrRecovery() for each of 'docs' and the
+     * matching element of 'locs', but generates the keys of one index for the whole batch before
+     * moving on to the next index. This keeps each index's key generator and sorter hot in the
+     * cache when many indexes are built at once.
+     *
+     * Should be called inside of a WriteUnitOfWork.
+     */
+    Status insertDocumentsForInitialSyncOrRecovery(OperationContext* opCtx,
+                                                   const std::vector<BSONObj>& docs,
+                                                   const std::vector<RecordId>& locs);
+
     /**
      * Call this after the last insertSingleDocumentForInitialSyncOrRecovery(). This gives the index
      * builder a chance to do any long-running operations in separate units of work from commit().
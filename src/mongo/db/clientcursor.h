@@ -233,6 +233,18 @@ public:
         ++_nBatchesReturned;
     }
 
+    /**
+     * Returns the size in bytes of the last batch returned by getMore on this cursor, or 0 if
+     * there has been none.
+     */
+    std::size_t getLastBatchBytes() const {
+        return _lastBatchBytes;
+    }
+
+    void setLastBatchBytes(std::size_t bytes) {
+        _lastBatchBytes = bytes;
+    }
+
     Date_t getLastUseDate() const {
         return _lastUseDate;
     }
@@ -379,6 +391,9 @@ private:
     // Tracks the number of batches returned by this cursor so far.
     std::uint64_t _nBatchesReturned = 0;
 
+    // The size of the last getMore batch, used to size the buffer for the next one up front.
+    std::size_t _lastBatchBytes = 0;
+
     // Holds an owned copy of the command specification received from the client.
     const BSONObj _originatingCommand;
 
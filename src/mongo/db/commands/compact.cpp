@@ -73,8 +73,10 @@ public:
         return "compact collection\n"
                "warning: this operation locks the database and is slow. you can cancel with "
                "killOp()\n"
-               "{ compact : <collection_name>, [force:<bool>] }\n"
-               "  force - allows to run on a replica set primary\n";
+               "{ compact : <collection_name>, [force:<bool>], [freeSpaceTargetMB:<int>] }\n"
+               "  force - allows to run on a replica set primary\n"
+               "  freeSpaceTargetMB - only compact if at least this many megabytes are available "
+               "for reuse\n";
     }
     CompactCmd() : ErrmsgCommandDeprecated("compact") {}
 
@@ -99,7 +101,18 @@ public:
             return false;
         }
 
-        StatusWith<int64_t> status = compactCollection(opCtx, nss);
+        boost::optional<long long> freeSpaceTargetMB;
+        if (auto elem = cmdObj["freeSpaceTargetMB"]) {
+            uassert(ErrorCodes::TypeMismatch,
+                    "freeSpaceTargetMB must be a number",
+                    elem.isNumber());
+            freeSpaceTargetMB = elem.safeNumberLong();
+            uassert(ErrorCodes::BadValue,
+                    "freeSpaceTargetMB must be greater than or equal to 0",
+                    *freeSpaceTargetMB >= 0);
+        }
+
+        StatusWith<int64_t> status = compactCollection(opCtx, nss, freeSpaceTargetMB);
         uassertStatusOK(status.getStatus());
         result.appendNumber("bytesFreed", static_cast<long long>(status.getValue()));
 
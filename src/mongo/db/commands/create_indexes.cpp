@@ -59,6 +59,7 @@
 #include "mongo/db/s/database_sharding_state.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
+#include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/idl/command_generic_argument.h"
 #include "mongo/logv2/log.h"
@@ -432,6 +433,25 @@ BSONObj runCreateIndexesOnNewCollection(OperationContext* opCtx,
     return createResult.obj();
 }
 
+/**
+ * Returns the options of the time-series collection 'ns', or boost::none if 'ns' is not a
+ * time-series collection.
+ */
+boost::optional<TimeseriesOptions> getTimeseriesOptions(OperationContext* opCtx,
+                                                        const NamespaceString& ns) {
+    auto viewCatalog = DatabaseHolder::get(opCtx)->getViewCatalog(opCtx, ns.db());
+    if (!viewCatalog) {
+        return boost::none;
+    }
+
+    auto view = viewCatalog->lookupWithoutValidatingDurableViews(opCtx, ns.ns());
+    if (!view) {
+        return boost::none;
+    }
+
+    return view->timeseries();
+}
+
 bool runCreateIndexesWithCoordinator(OperationContext* opCtx,
                                      const std::string& dbname,
                                      const BSONObj& cmdObj,
@@ -727,10 +747,18 @@ public:
         // specs, then we will wait for the build(s) to finish before trying again unless we are in
         // a multi-document transaction.
         const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+
+        // A time-series collection is a view on its buckets collection, so its indexes are built
+        // on the buckets collection with key patterns translated to the bucket schema.
+        auto cmd = cmdObj;
+        if (auto options = getTimeseriesOptions(opCtx, nss)) {
+            cmd = timeseries::makeTimeseriesCreateIndexesCommand(nss, *options, cmdObj);
+        }
+
         bool shouldLogMessageOnAlreadyBuildingError = true;
         while (true) {
             try {
-                return runCreateIndexesWithCoordinator(opCtx, dbname, cmdObj, result);
+                return runCreateIndexesWithCoordinator(opCtx, dbname, cmd, result);
             } catch (const DBException& ex) {
                 hangAfterIndexBuildAbort.pauseWhileSet();
                 // We can only wait for an existing index build to finish if we are able to release
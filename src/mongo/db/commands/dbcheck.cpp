@@ -44,6 +44,7 @@
 #include "mongo/db/repl/dbcheck.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/db/write_concern.h"
 #include "mongo/idl/command_generic_argument.h"
 #include "mongo/util/background.h"
 
@@ -66,6 +67,7 @@ struct DbCheckCollectionInfo {
     int64_t maxCount;
     int64_t maxSize;
     int64_t maxRate;
+    boost::optional<WriteConcernOptions> batchWriteConcern;
 };
 
 /**
@@ -116,7 +118,8 @@ std::unique_ptr<DbCheckRun> singleCollectionRun(OperationContext* opCtx,
     auto maxCount = invocation.getMaxCount();
     auto maxSize = invocation.getMaxSize();
     auto maxRate = invocation.getMaxCountPerSecond();
-    auto info = DbCheckCollectionInfo{nss, start, end, maxCount, maxSize, maxRate};
+    auto info = DbCheckCollectionInfo{
+        nss, start, end, maxCount, maxSize, maxRate, invocation.getBatchWriteConcern()};
     auto result = std::make_unique<DbCheckRun>();
     result->push_back(info);
     return result;
@@ -145,7 +148,13 @@ std::unique_ptr<DbCheckRun> fullDatabaseRun(OperationContext* opCtx,
             break;
         }
 
-        DbCheckCollectionInfo info{coll->ns(), BSONKey::min(), BSONKey::max(), max, max, rate};
+        DbCheckCollectionInfo info{coll->ns(),
+                                   BSONKey::min(),
+                                   BSONKey::max(),
+                                   max,
+                                   max,
+                                   rate,
+                                   invocation.getBatchWriteConcern()};
         result->push_back(info);
     }
 
@@ -277,6 +286,22 @@ private:
 
             auto stats = result.getValue();
 
+            // Hold the next batch back until the secondaries have caught up with this one.
+            if (info.batchWriteConcern) {
+                auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
+                WriteConcernResult unused;
+                auto status = waitForWriteConcern(
+                    uniqueOpCtx.get(), stats.time, *info.batchWriteConcern, &unused);
+                if (!status.isOK()) {
+                    entry = dbCheckErrorHealthLogEntry(info.nss,
+                                                       "dbCheck failed waiting for writeConcern",
+                                                       OplogEntriesEnum::Batch,
+                                                       status);
+                    HealthLog::get(Client::getCurrent()->getServiceContext()).log(*entry);
+                    return;
+                }
+            }
+
             start = stats.lastKey;
 
             // Update our running totals.
@@ -510,7 +535,8 @@ public:
                "              maxKey: <last key, inclusive>,\n"
                "              maxCount: <max number of docs>,\n"
                "              maxSize: <max size of docs>,\n"
-               "              maxCountPerSecond: <max rate in docs/sec> } "
+               "              maxCountPerSecond: <max rate in docs/sec>,\n"
+               "              batchWriteConcern: <write concern to wait for after each batch> } "
                "to check a collection.\n"
                "Invoke with {dbCheck: 1} to check all collections in the database.";
     }
@@ -787,6 +787,10 @@ public:
             CurOp::get(opCtx)->setNS_inlock(dbname);
         }
 
+        // The statistics are approximate and not read at a timestamp, so they need not wait for
+        // secondary batch application to finish.
+        ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
+            opCtx->lockState());
         AutoGetDb autoDb(opCtx, ns, MODE_IS);
 
         result.append("db", ns);
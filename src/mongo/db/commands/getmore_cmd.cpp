@@ -44,6 +44,7 @@
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
@@ -74,6 +75,9 @@ MONGO_FAIL_POINT_DEFINE(GetMoreHangBeforeReadLock);
 // The timeout when waiting for linearizable read concern on a getMore command.
 static constexpr int kLinearizableReadConcernTimeout = 15000;
 
+// Room for the fields of a getMore reply other than its batch of documents.
+static constexpr std::size_t kReplyOverheadBytes = 1024;
+
 // getMore can run with any readConcern, because cursor-creating commands like find can run with any
 // readConcern.  However, since getMore automatically uses the readConcern of the command that
 // created the cursor, it is not appropriate to apply the default readConcern (just as
@@ -561,6 +565,12 @@ public:
             if (!opCtx->inMultiDocumentTransaction()) {
                 options.atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
             }
+            // Successive batches of a cursor tend to be about the same size, so build this one in a
+            // buffer that already fits the last one rather than repeatedly growing it. This matters
+            // most for full 16MB batches, where every regrowth copies the whole batch.
+            if (auto lastBatchBytes = cursorPin->getLastBatchBytes()) {
+                reply->reserveBytes(lastBatchBytes + kReplyOverheadBytes);
+            }
             CursorResponseBuilder nextBatch(reply, options);
             BSONObj obj;
             std::uint64_t numResults = 0;
@@ -654,6 +664,7 @@ public:
                 curOp->debug().cursorExhausted = true;
             }
 
+            cursorPin->setLastBatchBytes(nextBatch.bytesUsed());
             nextBatch.done(respondWithId, _request.nss.ns());
 
             // Increment this metric once we have generated a response and we know it will return
@@ -667,6 +678,13 @@ public:
             // response batch.
             curOp->debug().nreturned = numResults;
 
+            if (readLock && readLock->getCollection()) {
+                if (auto cq = exec->getCanonicalQuery()) {
+                    CollectionQueryInfo::get(readLock->getCollection())
+                        .notifyOfQueryShape(opCtx, *cq);
+                }
+            }
+
             if (respondWithId) {
                 cursorFreer.dismiss();
 
@@ -51,6 +51,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/query_settings_decoration.h"
+#include "mongo/db/query/sbe_plan_cache.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/unordered_set.h"
 
@@ -236,6 +237,9 @@ Status ClearFilters::runIndexFilterCommand(OperationContext* opCtx,
         // No collection - do nothing.
         return Status::OK();
     }
+
+    // Cached SBE execution trees have the index filters baked in.
+    CollectionQueryInfo::get(ctx.getCollection()).getSbePlanCache()->clear();
     return clear(opCtx, querySettings, planCache, ns, cmdObj);
 }
 
@@ -349,6 +353,9 @@ Status SetFilter::runIndexFilterCommand(OperationContext* opCtx,
     if (!status.isOK()) {
         return status;
     }
+
+    // Cached SBE execution trees have the index filters baked in.
+    CollectionQueryInfo::get(ctx.getCollection()).getSbePlanCache()->clear();
     return set(opCtx, querySettings, planCache, ns, cmdObj);
 }
 
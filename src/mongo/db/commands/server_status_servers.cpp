@@ -165,6 +165,37 @@ public:
         return builder.obj();
     }
 } tlsVersionStatus;
+
+/**
+ * Status section counting how many completed TLS handshakes resumed a previous session, in each
+ * direction.
+ */
+class TLSSessionResumptionStatus : public ServerStatusSection {
+public:
+    TLSSessionResumptionStatus() : ServerStatusSection("tlsSessionResumption") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto& counts = TLSSessionResumptionCounts::get(opCtx->getServiceContext());
+
+        BSONObjBuilder builder;
+        {
+            BSONObjBuilder ingress(builder.subobjStart("ingress"));
+            ingress.append("full", counts.ingressFull.load());
+            ingress.append("resumed", counts.ingressResumed.load());
+        }
+        {
+            BSONObjBuilder egress(builder.subobjStart("egress"));
+            egress.append("full", counts.egressFull.load());
+            egress.append("resumed", counts.egressResumed.load());
+        }
+        return builder.obj();
+    }
+} tlsSessionResumptionStatus;
 #endif
 
 class AdvisoryHostFQDNs final : public ServerStatusSection {
@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/bson/bsonobjbuilder.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/commands/write_commands/write_commands_common.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/json.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/matcher/doc_validation_error.h"
@@ -62,8 +65,11 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/db/write_concern.h"
+#include "mongo/logv2/log.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/string_map.h"
@@ -251,6 +257,50 @@ BSONArray makeTimeseriesInsertDocument(const OID& bucketId,
     return builder.arr();
 }
 
+/**
+ * Rewrites the closed bucket 'bucketId' with its data columns compressed. A closed bucket no longer
+ * receives measurements, so it can be read back and replaced as a whole. Compression is
+ * best-effort: a bucket that could not be compressed is left as it is and remains readable.
+ */
+void compressClosedBucket(OperationContext* opCtx,
+                          const NamespaceString& bucketsNs,
+                          const OID& bucketId) {
+    try {
+        DBDirectClient client(opCtx);
+        auto bucket = client.findOne(bucketsNs.ns(), BSON("_id" << bucketId));
+        if (bucket.isEmpty()) {
+            return;
+        }
+
+        auto compressed = timeseries::compressBucket(bucket);
+        if (!compressed) {
+            return;
+        }
+
+        write_ops::UpdateOpEntry replacement(
+            BSON("_id" << bucketId),
+            write_ops::UpdateModification::parseFromClassicUpdate(*compressed));
+        write_ops::Update compressionUpdate(bucketsNs, {replacement});
+        {
+            write_ops::WriteCommandBase writeCommandBase;
+            // The schema validation configured in the bucket collection is intended for direct
+            // operations by end users and is not applicable here.
+            writeCommandBase.setBypassDocumentValidation(true);
+            compressionUpdate.setWriteCommandBase(std::move(writeCommandBase));
+        }
+
+        auto reply = write_ops_exec::performUpdates(opCtx, compressionUpdate);
+        invariant(reply.results.size() == 1);
+        uassertStatusOK(reply.results[0].getStatus());
+    } catch (const DBException& ex) {
+        LOGV2_WARNING(5697016,
+                      "Failed to compress time-series bucket",
+                      "namespace"_attr = bucketsNs,
+                      "bucketId"_attr = bucketId,
+                      "error"_attr = ex.toStatus());
+    }
+}
+
 void appendOpTime(const repl::OpTime& opTime, BSONObjBuilder* out) {
     if (opTime.getTerm() == repl::OpTime::kUninitializedTerm) {
         out->append("opTime", opTime.getTimestamp());
@@ -529,15 +579,19 @@ private:
             auto bucketsNs = ns.makeTimeseriesBucketsNamespace();
 
             auto& bucketCatalog = BucketCatalog::get(opCtx);
-            std::vector<std::pair<OID, size_t>> bucketsToCommit;
+            std::vector<std::pair<BucketCatalog::BucketHandle, size_t>> bucketsToCommit;
             std::vector<std::pair<Future<BucketCatalog::CommitInfo>, size_t>> bucketsToWaitOn;
+            std::vector<OID> closedBuckets;
             for (size_t i = 0; i < _batch.getDocuments().size(); i++) {
-                auto [bucketId, commitInfo] =
+                auto [bucket, commitInfo, closedBucketId] =
                     bucketCatalog.insert(opCtx, ns, _batch.getDocuments()[i]);
                 if (commitInfo) {
                     bucketsToWaitOn.push_back({std::move(*commitInfo), i});
                 } else {
-                    bucketsToCommit.push_back({std::move(bucketId), i});
+                    bucketsToCommit.push_back({std::move(bucket), i});
+                }
+                if (closedBucketId) {
+                    closedBuckets.push_back(std::move(*closedBucketId));
                 }
             }
 
@@ -545,9 +599,9 @@ private:
             boost::optional<repl::OpTime> opTime;
             boost::optional<OID> electionId;
 
-            for (const auto& [bucketId, index] : bucketsToCommit) {
-                auto metadata = bucketCatalog.getMetadata(bucketId);
-                auto data = bucketCatalog.commit(bucketId);
+            for (const auto& [bucket, index] : bucketsToCommit) {
+                auto metadata = bucketCatalog.getMetadata(bucket);
+                auto data = bucketCatalog.commit(bucket);
                 while (!data.docs.empty()) {
                     write_ops_exec::WriteResult reply;
                     if (data.numCommittedMeasurements == 0) {
@@ -563,13 +617,13 @@ private:
                             builder.append(write_ops::Insert::kStmtIdsFieldName, *stmtIds);
                         }
                         builder.append(write_ops::Insert::kDocumentsFieldName,
-                                       makeTimeseriesInsertDocument(bucketId, data, metadata));
+                                       makeTimeseriesInsertDocument(bucket.id, data, metadata));
 
                         auto request = OpMsgRequest::fromDBAndBody(bucketsNs.db(), builder.obj());
                         auto timeseriesInsertBatch = InsertOp::parse(request);
                         reply = write_ops_exec::performInserts(opCtx, timeseriesInsertBatch);
                     } else {
-                        auto update = makeTimeseriesUpdateOpEntry(bucketId, data, metadata);
+                        auto update = makeTimeseriesUpdateOpEntry(bucket.id, data, metadata);
                         write_ops::Update timeseriesUpdateBatch(bucketsNs, {update});
                         {
                             write_ops::WriteCommandBase writeCommandBase;
@@ -609,9 +663,12 @@ private:
                         : boost::none;
 
                     data = bucketCatalog.commit(
-                        bucketId,
+                        bucket,
                         BucketCatalog::CommitInfo{std::move(reply.results[0]), opTime, electionId});
                 }
+                if (data.closed) {
+                    closedBuckets.push_back(bucket.id);
+                }
             }
 
             for (const auto& [future, index] : bucketsToWaitOn) {
@@ -627,6 +684,14 @@ private:
                 }
             }
 
+            // Rewriting a bucket as part of a retryable write or a transaction would need a
+            // statement id of its own, so buckets closed by those stay uncompressed.
+            if (gTimeseriesBucketCompression.load() && !opCtx->getTxnNumber()) {
+                for (const auto& bucketId : closedBuckets) {
+                    compressClosedBucket(opCtx, bucketsNs, bucketId);
+                }
+            }
+
             result->appendNumber("n", _batch.getDocuments().size() - errors.size());
             if (!errors.empty()) {
                 result->append("writeErrors", errors);
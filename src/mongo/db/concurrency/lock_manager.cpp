@@ -414,8 +414,11 @@ void LockHead::migratePartitionedLockHeads() {
 const unsigned LockManager::_numLockBuckets(128);
 
 // Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+// Lockers are assigned partitions round-robin by id, so this bounds how many concurrent intent
+// lockers can go without sharing a partition mutex. Migrating a resource out of partitioned mode
+// only visits the partitions actually holding it, so a large value is cheap for conflicting locks.
+// Should be a power of two.
+const unsigned LockManager::_numPartitions = 128;
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
@@ -282,6 +282,11 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+/* static */
+TicketHolder* Locker::getGlobalThrottling(LockMode mode) {
+    return ticketHolders[mode];
+}
+
 LockerImpl::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
 
@@ -378,7 +383,10 @@ void LockerImpl::lockGlobal(OperationContext* opCtx, LockMode mode, Date_t deadl
             // Ignore deadline and _maxLockTimeout.
             invariant(_acquireTicket(opCtx, mode, Date_t::max()));
         } else {
-            auto beforeAcquire = Date_t::now();
+            // Most callers wait without a deadline, so only read the clock when the ticket wait
+            // can actually time out.
+            const bool canTimeOut = _maxLockTimeout || deadline != Date_t::max();
+            const auto beforeAcquire = canTimeOut ? Date_t::now() : Date_t();
             deadline = std::min(deadline,
                                 _maxLockTimeout ? beforeAcquire + *_maxLockTimeout : Date_t::max());
             uassert(ErrorCodes::LockTimeout,
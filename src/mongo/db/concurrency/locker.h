@@ -76,6 +76,12 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Returns the ticket holder that global lock attempts in 'mode' obtain tickets from, or nullptr
+     * if they are not throttled.
+     */
+    static class TicketHolder* getGlobalThrottling(LockMode mode);
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
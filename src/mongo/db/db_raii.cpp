@@ -34,12 +34,14 @@
 #include "mongo/db/db_raii.h"
 
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/storage/snapshot_helper.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -51,6 +53,16 @@ const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 const auto allowSecondaryReadsDuringBatchApplication_DONT_USE =
     OperationContext::declareDecoration<boost::optional<bool>>();
 
+// Counts the reads at a point in time which released their locks and retried because the
+// collection had catalog changes newer than the read timestamp, and the time spent retrying. On a
+// secondary these wait for the batch applying the catalog change to finish.
+Counter64 pendingCatalogChangeRetries;
+Counter64 pendingCatalogChangeRetryMicros;
+ServerStatusMetricField<Counter64> displayPendingCatalogChangeRetries(
+    "query.pendingCatalogChangeRetries", &pendingCatalogChangeRetries);
+ServerStatusMetricField<Counter64> displayPendingCatalogChangeRetryMicros(
+    "query.pendingCatalogChangeRetryMicros", &pendingCatalogChangeRetryMicros);
+
 /**
  * Performs some checks to determine whether the operation is compatible with a lock-free read.
  * Multi-doc transactions are not supported, nor are operations holding an exclusive lock.
@@ -301,6 +313,8 @@ AutoGetCollectionForReadBase<AutoGetCollectionType, EmplaceAutoCollFunc>::
 
         // Yield locks in order to do the blocking call below.
         _autoColl = boost::none;
+        pendingCatalogChangeRetries.increment();
+        Timer retryTimer;
 
         // If there are pending catalog changes when using a no-overlap or lastApplied read source,
         // we yield to get a new read timestamp ahead of the minimum visible snapshot.
@@ -342,6 +356,7 @@ AutoGetCollectionForReadBase<AutoGetCollectionType, EmplaceAutoCollFunc>::
         }
 
         emplaceAutoColl.emplace(_autoColl);
+        pendingCatalogChangeRetryMicros.increment(retryTimer.micros());
     }
 }
 
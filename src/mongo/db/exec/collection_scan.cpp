@@ -41,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/logv2/log.h"
@@ -64,7 +65,11 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _workingSet(workingSet),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _params(params) {
+      _compiledFilter(internalQueryEnableCompiledMatchExpressions.load()
+                          ? CompiledMatchExpression::compile(_filter)
+                          : nullptr),
+      _params(params),
+      _maxBatchSize(params.tailable ? 1 : internalQueryCollectionScanMaxBatchSize.load()) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
     _specificStats.minTs = params.minTs;
@@ -131,6 +136,11 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
 
             _cursor = collection()->getCursor(opCtx(), forward);
+            if (forward && !_params.tailable) {
+                // A forward scan will very likely read on through the following records, so let
+                // the storage engine start fetching them before we ask for them.
+                _cursor->setReadAhead(true);
+            }
 
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
@@ -185,7 +195,7 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         }
 
         if (!record) {
-            record = _cursor->next();
+            record = nextRecord();
         }
     } catch (const WriteConflictException&) {
         // Leave us in a state to try again next time.
@@ -223,6 +233,24 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     return returnIfMatches(member, id, out);
 }
 
+boost::optional<Record> CollectionScan::nextRecord() {
+    if (_maxBatchSize <= 1) {
+        return _cursor->next();
+    }
+
+    if (_batchPos == _batch.size()) {
+        // If nextBatch() throws a WriteConflictException, whatever it managed to read is left in
+        // '_batch' and is returned after the yield, since the cursor has already moved past it.
+        _batchPos = 0;
+        _cursor->nextBatch(&_batch, _batchSize);
+        _batchSize = std::min(_batchSize * 2, _maxBatchSize);
+        if (_batch.empty()) {
+            return boost::none;
+        }
+    }
+    return _batch[_batchPos++];
+}
+
 void CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     uassert(ErrorCodes::Error(4382100),
@@ -254,9 +282,10 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID memberID,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _compiledFilter.get())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _compiledFilter.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
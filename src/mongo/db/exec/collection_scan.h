@@ -33,14 +33,14 @@
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/s/resharding/resume_token_gen.h"
 
 namespace mongo {
 
-struct Record;
-class SeekableRecordCursor;
 class WorkingSet;
 class OperationContext;
 
@@ -103,6 +103,12 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Returns the next record from '_cursor', serving it from '_batch' when batching is enabled.
+     * The returned record is unowned and remains valid until the next call.
+     */
+    boost::optional<Record> nextRecord();
+
     /**
      * Extracts the timestamp from the 'ts' field of 'record', and sets '_latestOplogEntryTimestamp'
      * to that time if it isn't already greater. Throws an exception if the 'ts' field cannot be
@@ -121,6 +127,9 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // The compiled form of '_filter', if it has one.
+    std::unique_ptr<CompiledMatchExpression> _compiledFilter;
+
     // If a document does not pass '_filter' but passes '_endCondition', stop scanning and return
     // IS_EOF.
     BSONObj _endConditionBSON;
@@ -132,6 +141,14 @@ private:
 
     RecordId _lastSeenId;  // Null if nothing has been returned from _cursor yet.
 
+    // Records fetched from '_cursor' ahead of being returned. '_batchPos' is the index of the next
+    // record to return. The batch size starts at one so that short scans don't read ahead, and
+    // doubles on every refill up to '_maxBatchSize'. Tailable scans do not batch.
+    RecordBatch _batch;
+    size_t _batchPos = 0;
+    size_t _batchSize = 1;
+    const size_t _maxBatchSize;
+
     // If _params.shouldTrackLatestOplogTimestamp is set and the collection is the oplog, the latest
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
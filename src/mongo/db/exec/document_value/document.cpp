@@ -347,10 +347,18 @@ void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
         it->val.~Value();  // explicit destructor call
     }
 
-    _cacheEnd = _cache;
+    // A storage that is reset for each document of a stream, like a reused WorkingSetMember's,
+    // keeps its buffer so that caching fields of the next document does not allocate again. The
+    // hash table at the end of the buffer stays in place and is rebuilt from scratch once enough
+    // fields have been added.
+    if (allocatedBytes() > kMaxRetainedBufferBytes) {
+        delete[] _cache;
+        _cache = nullptr;
+        _cacheEnd = nullptr;
+        _hashTabMask = 0;
+    }
     _usedBytes = 0;
     _numFields = 0;
-    _hashTabMask = 0;
 
     // Clean metadata.
     _metadataFields = DocumentMetadataFields{};
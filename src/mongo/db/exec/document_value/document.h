@@ -494,6 +494,11 @@ public:
      * underlying bson when converting the document object back to bson.
      */
     void reset(const BSONObj& bson, bool stripMetadata) {
+        if (MONGO_unlikely(!_storage || _storage->isShared())) {
+            // Don't clone a shared storage only to discard its contents.
+            newStorageWithBson(bson, stripMetadata);
+            return;
+        }
         storage().reset(bson, stripMetadata);
     }
 
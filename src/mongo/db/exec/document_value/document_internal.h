@@ -297,6 +297,10 @@ public:
 
     ~DocumentStorage();
 
+    /**
+     * Replaces the contents with 'bson', discarding all cached fields and metadata. The field
+     * buffer is kept for reuse unless it is larger than kMaxRetainedBufferBytes.
+     */
     void reset(const BSONObj& bson, bool stripMetadata);
 
     static const DocumentStorage& emptyDoc() {
@@ -539,6 +543,9 @@ private:
                                  // set to 1 to always hash
     };
 
+    // reset() frees field buffers larger than this rather than keeping them for the next document.
+    static constexpr size_t kMaxRetainedBufferBytes = 16 * 1024;
+
     // _cache layout:
     // -------------------------------------------------------------------------------
     // | ValueElement1 Name1 | ValueElement2 Name2 | ... FREE SPACE ... | Hash Table |
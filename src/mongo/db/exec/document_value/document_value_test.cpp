@@ -137,6 +137,38 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+TEST(DocumentConstruction, ResetReusesStorage) {
+    // Cache enough fields to hash them, then reset the storage for a new document and cache fields
+    // again, some with the same names. Lookups must only see the fields of the new document.
+    MutableDocument md;
+    for (int i = 0; i < 20; ++i) {
+        md.addField("f" + std::to_string(i), Value(i));
+    }
+
+    auto bson = BSON("a" << 1 << "f3"
+                         << "x");
+    md.reset(bson, false);
+    ASSERT_BSONOBJ_EQ(bson, md.peek().toBson());
+
+    for (int i = 10; i < 16; ++i) {
+        md.setField("f" + std::to_string(i), Value(-i));
+    }
+    auto newDocument = md.freeze();
+    ASSERT_VALUE_EQ(Value(1), newDocument["a"]);
+    ASSERT_VALUE_EQ(Value("x"_sd), newDocument["f3"]);
+    ASSERT_VALUE_EQ(Value(-12), newDocument["f12"]);
+    ASSERT(newDocument["f0"].missing());
+    ASSERT_EQ(8U, newDocument.computeSize());
+
+    // A shared storage is not modified by a reset.
+    Document shared = Document{{"a", 1}};
+    MutableDocument other(shared);
+    other.reset(bson, false);
+    ASSERT_VALUE_EQ(Value(1), shared["a"]);
+    ASSERT(shared["f3"].missing());
+    ASSERT_BSONOBJ_EQ(bson, other.freeze().toBson());
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
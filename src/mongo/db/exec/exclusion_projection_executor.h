@@ -41,7 +41,7 @@ namespace mongo::projection_executor {
  * represents one 'level' of the parsed specification. The root ExclusionNode represents all top
  * level exclusions, with any child ExclusionNodes representing dotted or nested exclusions.
  */
-class ExclusionNode final : public ProjectionNode {
+class ExclusionNode : public ProjectionNode {
 public:
     ExclusionNode(ProjectionPolicies policies, std::string pathToNode = "")
         : ProjectionNode(policies, std::move(pathToNode)) {}
@@ -64,7 +64,7 @@ public:
     }
 
 protected:
-    std::unique_ptr<ProjectionNode> makeChild(const std::string& fieldName) const final {
+    std::unique_ptr<ProjectionNode> makeChild(const std::string& fieldName) const override {
         return std::make_unique<ExclusionNode>(
             _policies, FieldPath::getFullyQualifiedPath(_pathToNode, fieldName));
     }
@@ -79,6 +79,30 @@ protected:
     }
 };
 
+/**
+ * A fast-path exclusion projection implementation which applies a BSON-to-BSON transformation
+ * rather than constructing an output document using the Document/Value API. For exclusion-only
+ * projections (without $meta expressions) the output is a copy of the input BSON with the
+ * excluded fields skipped, so we can stream it into a BSONObjBuilder.
+ */
+class FastPathEligibleExclusionNode final : public ExclusionNode {
+public:
+    FastPathEligibleExclusionNode(ProjectionPolicies policies, std::string pathToNode = "")
+        : ExclusionNode(policies, std::move(pathToNode)) {}
+
+    Document applyToDocument(const Document& inputDoc) const final;
+
+protected:
+    std::unique_ptr<ProjectionNode> makeChild(const std::string& fieldName) const final {
+        return std::make_unique<FastPathEligibleExclusionNode>(
+            _policies, FieldPath::getFullyQualifiedPath(_pathToNode, fieldName));
+    }
+
+private:
+    void _applyProjections(BSONObj bson, BSONObjBuilder* bob) const;
+    void _applyProjectionsToArray(BSONObj array, BSONArrayBuilder* bab) const;
+};
+
 /**
  * A ExclusionProjectionExecutor represents an execution tree for an exclusion projection.
  *
@@ -90,7 +114,9 @@ public:
     ExclusionProjectionExecutor(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                 ProjectionPolicies policies,
                                 bool allowFastPath = false)
-        : ProjectionExecutor(expCtx, policies), _root(new ExclusionNode(_policies)) {}
+        : ProjectionExecutor(expCtx, policies),
+          _root(allowFastPath ? std::make_unique<FastPathEligibleExclusionNode>(_policies)
+                              : std::make_unique<ExclusionNode>(_policies)) {}
 
     TransformerType getType() const final {
         return TransformerType::kExclusionProjection;
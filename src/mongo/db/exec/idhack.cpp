@@ -40,6 +40,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/btree_access_method.h"
+#include "mongo/db/matcher/expression_leaf.h"
 
 namespace mongo {
 
@@ -54,11 +55,20 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
                          WorkingSet* ws,
                          const CollectionPtr& collection,
                          const IndexDescriptor* descriptor)
-    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
-      _workingSet(ws),
-      _key(query->getQueryObj()["_id"].wrap()) {
+    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws), _workingSet(ws) {
     _specificStats.indexName = descriptor->indexName();
     _addKeyMetadata = query->getQueryRequest().returnKey();
+
+    if (query->root()->matchType() == MatchExpression::MATCH_IN) {
+        // The equalities are kept sorted and de-duplicated according to the query's collation,
+        // which matches the collation of the _id index.
+        auto in = static_cast<const InMatchExpression*>(query->root());
+        for (auto&& elt : in->getEqualities()) {
+            _keys.push_back(BSON("_id" << elt));
+        }
+    } else {
+        _keys.push_back(query->getQueryObj()["_id"].wrap());
+    }
 }
 
 IDHackStage::IDHackStage(ExpressionContext* expCtx,
@@ -68,7 +78,7 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
                          const IndexDescriptor* descriptor)
     : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
       _workingSet(ws),
-      _key(key) {
+      _keys{key} {
     _specificStats.indexName = descriptor->indexName();
 }
 
@@ -85,10 +95,16 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
 
     WorkingSetID id = WorkingSet::INVALID_ID;
     try {
-        // Look up the key by going directly to the index.
-        RecordId recordId = indexAccessMethod()->findSingle(opCtx(), _key);
+        // Look up the keys by going directly to the index, skipping those that are not found.
+        RecordId recordId;
+        while (recordId.isNull() && _nextKey < _keys.size()) {
+            recordId = indexAccessMethod()->findSingle(opCtx(), _keys[_nextKey]);
+            if (recordId.isNull()) {
+                ++_nextKey;
+            }
+        }
 
-        // Key not found.
+        // No more keys found.
         if (recordId.isNull()) {
             _done = true;
             return PlanStage::IS_EOF;
@@ -110,6 +126,9 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
         if (!WorkingSetCommon::fetch(opCtx(), _workingSet, id, _recordCursor, collection()->ns())) {
             // We didn't find a document with RecordId 'id'.
             _workingSet->free(id);
+            if (++_nextKey < _keys.size()) {
+                return NEED_TIME;
+            }
             _commonStats.isEOF = true;
             _done = true;
             return IS_EOF;
@@ -134,10 +153,11 @@ PlanStage::StageState IDHackStage::advance(WorkingSetID id,
 
     if (_addKeyMetadata) {
         BSONObj ownedKeyObj = member->doc.value().toBson()["_id"].wrap().getOwned();
-        member->metadata().setIndexKey(IndexKeyEntry::rehydrateKey(_key, ownedKeyObj));
+        member->metadata().setIndexKey(
+            IndexKeyEntry::rehydrateKey(_keys[_nextKey], ownedKeyObj));
     }
 
-    _done = true;
+    _done = ++_nextKey == _keys.size();
     *out = id;
     return PlanStage::ADVANCED;
 }
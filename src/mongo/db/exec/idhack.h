@@ -30,6 +30,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/query/canonical_query.h"
@@ -44,6 +45,9 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * A query of the form {_id: {$in: [...]}} over literal values looks up each value in turn, in the
+ * order of the _id index.
  */
 class IDHackStage final : public RequiresIndexStage {
 public:
@@ -96,10 +100,13 @@ private:
     // The WorkingSet we annotate with results.  Not owned by us.
     WorkingSet* _workingSet;
 
-    // The value to match against the _id field.
-    BSONObj _key;
+    // The values to match against the _id field, in index order.
+    std::vector<BSONObj> _keys;
+
+    // The position in '_keys' of the next value to look up.
+    size_t _nextKey = 0;
 
-    // Have we returned our one document?
+    // Have we returned our last document?
     bool _done = false;
 
     // Do we need to add index key metadata for returnKey?
@@ -91,6 +91,9 @@ IndexScan::IndexScan(ExpressionContext* expCtx,
 boost::optional<IndexKeyEntry> IndexScan::initIndexScan() {
     // Perform the possibly heavy-duty initialization of the underlying index cursor.
     _indexCursor = indexAccessMethod()->newCursor(opCtx(), _forward);
+    if (_forward) {
+        _indexCursor->setReadAhead(true);
+    }
 
     // We always seek once to establish the cursor position.
     ++_specificStats.seeks;
@@ -213,7 +216,7 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
 
     if (_shouldDedup) {
         ++_specificStats.dupsTested;
-        if (!_returned.insert(kv->loc).second) {
+        if (!_returned.insert(kv->loc)) {
             // We've seen this RecordId before. Skip it this time.
             ++_specificStats.dupsDropped;
             return PlanStage::NEED_TIME;
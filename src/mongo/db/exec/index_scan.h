@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/record_id_bitmap.h"
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
@@ -168,7 +169,7 @@ private:
     ScanState _scanState = ScanState::INITIALIZING;
 
     // Could our index have duplicates?  If so, we use _returned to dedup.
-    stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
+    RecordIdBitmap _returned;
 
     //
     // This class employs one of two different algorithms for determining when the index scan
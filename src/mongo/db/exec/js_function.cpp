@@ -68,6 +68,10 @@ JsFunction::JsFunction(OperationContext* opCtx,
 
     _func = _scope->createFunction(code.c_str());
     uassert(ErrorCodes::BadValue, "$where compile error", _func);
+
+    // This is a hack b/c fullObject used to be relevant. The value does not depend on the
+    // document, so it is set once rather than for every document the predicate runs on.
+    _scope->setBoolean("fullObject", true);
 }
 
 bool JsFunction::runAsPredicate(const BSONObj& obj) const {
@@ -76,7 +80,6 @@ bool JsFunction::runAsPredicate(const BSONObj& obj) const {
 
     _scope->advanceGeneration();
     _scope->setObject("obj", obj);
-    _scope->setBoolean("fullObject", true);  // this is a hack b/c fullObject used to be relevant
 
     auto err =
         _scope->invoke(_func, nullptr, &obj, internalQueryJavaScriptFnTimeoutMillis.load(), false);
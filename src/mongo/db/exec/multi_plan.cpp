@@ -50,6 +50,7 @@
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/plan_ranker_util.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
@@ -166,6 +167,9 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
 
     size_t numWorks = trial_period::getTrialPeriodMaxWorks(opCtx(), collection());
     size_t numResults = trial_period::getTrialPeriodNumToReturn(*_query);
+    const double pruningRatio = internalQueryPlanEvaluationPruningRatio.load();
+    const size_t pruningMinWorks = internalQueryPlanEvaluationPruningMinWorks.load();
+    _pruned.assign(_candidates.size(), false);
 
     try {
         // Work the plans, stopping when a plan hits EOF or returns some fixed number of results.
@@ -174,6 +178,9 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             if (!moreToDo) {
                 break;
             }
+            if (pruningRatio > 1 && ix + 1 >= pruningMinWorks) {
+                pruneCandidates(pruningRatio);
+            }
         }
     } catch (DBException& e) {
         return e.toStatus().withContext("error while multiplanner was selecting best plan");
@@ -228,7 +235,7 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
 
     for (size_t ix = 0; ix < _candidates.size(); ++ix) {
         auto& candidate = _candidates[ix];
-        if (candidate.failed) {
+        if (candidate.failed || _pruned[ix]) {
             continue;
         }
 
@@ -289,6 +296,36 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
     return !doneWorking;
 }
 
+void MultiPlanStage::pruneCandidates(double pruningRatio) {
+    size_t bestResults = 0;
+    for (size_t ix = 0; ix < _candidates.size(); ++ix) {
+        if (!_candidates[ix].failed && !_pruned[ix]) {
+            bestResults = std::max(bestResults, _candidates[ix].results.size());
+        }
+    }
+
+    for (size_t ix = 0; ix < _candidates.size(); ++ix) {
+        auto& candidate = _candidates[ix];
+        if (candidate.failed || _pruned[ix] || candidate.solution->hasBlockingStage ||
+            _failureCount + _prunedCount + 1 == _candidates.size()) {
+            continue;
+        }
+
+        // Smooth both counts so that a candidate is never stopped before the best one has
+        // returned anything.
+        if ((candidate.results.size() + 1) * pruningRatio < bestResults + 1) {
+            LOGV2_DEBUG(5698007,
+                        5,
+                        "Stopping candidate plan during the trial period",
+                        "planIndex"_attr = ix,
+                        "results"_attr = candidate.results.size(),
+                        "bestResults"_attr = bestResults);
+            _pruned[ix] = true;
+            ++_prunedCount;
+        }
+    }
+}
+
 bool MultiPlanStage::hasBackupPlan() const {
     return kNoSuchPlan != _backupPlanIdx;
 }
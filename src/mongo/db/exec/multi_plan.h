@@ -153,6 +153,13 @@ private:
      */
     bool workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Stops working the candidates which have returned fewer results than the best candidate by
+     * at least a factor of 'pruningRatio'. Candidates with a blocking stage are never stopped,
+     * since they return nothing until their input is exhausted, and neither is the last one left.
+     */
+    void pruneCandidates(double pruningRatio);
+
     /**
      * Checks whether we need to perform either a timing-based yield or a yield for a document
      * fetch. If so, then uses 'yieldPolicy' to actually perform the yield.
@@ -193,6 +200,11 @@ private:
     // is safe for the query to continue executing.
     size_t _failureCount = 0u;
 
+    // Flags the candidate plans which were stopped by pruneCandidates(), indexed like _candidates.
+    // Such plans are no longer worked during the trial period but are still ranked.
+    std::vector<bool> _pruned;
+    size_t _prunedCount = 0u;
+
     // Stats
     MultiPlanStats _specificStats;
 };
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bitmap.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
@@ -78,7 +79,7 @@ private:
     const bool _dedup;
 
     // Which RecordIds have we returned?
-    stdx::unordered_set<RecordId, RecordId::Hasher> _seen;
+    RecordIdBitmap _seen;
 
     // Stats
     OrStats _specificStats;
@@ -118,6 +118,10 @@ public:
             // call to work().
             _commonStats.executionTimeMillis.emplace(0);
         }
+        if (expCtx->explain && *expCtx->explain >= ExplainOptions::Verbosity::kExecStats &&
+            ScopedThreadCpuTimer::isSupported()) {
+            _commonStats.executionCpuNanos.emplace(0);
+        }
     }
 
 protected:
@@ -199,6 +203,10 @@ public:
      */
     StageState work(WorkingSetID* out) {
         auto optTimer(getOptTimer());
+        boost::optional<ScopedThreadCpuTimer> optCpuTimer;
+        if (_commonStats.executionCpuNanos) {
+            optCpuTimer.emplace(_commonStats.executionCpuNanos.get_ptr());
+        }
 
         ++_commonStats.works;
 
@@ -102,6 +102,11 @@ struct CommonStats {
     // cache.
     boost::optional<long long> executionTimeMillis;
 
+    // CPU time consumed by the executing thread while working inside this stage, including its
+    // children. Only collected for explain at "executionStats" verbosity or above, as reading the
+    // thread's CPU clock on every call to work(...) is too costly for ordinary execution.
+    boost::optional<long long> executionCpuNanos;
+
     // TODO: have some way of tracking WSM sizes (or really any series of #s).  We can measure
     // the size of our inputs and the size of our outputs.  We can do a lot with the WS here.
 
@@ -742,7 +747,8 @@ struct NearStats : public SpecificStats {
 };
 
 struct UpdateStats : public SpecificStats {
-    UpdateStats() : nMatched(0), nModified(0), isModUpdate(false), nUpserted(0) {}
+    UpdateStats()
+        : nMatched(0), nModified(0), nModifiedInPlace(0), isModUpdate(false), nUpserted(0) {}
 
     SpecificStats* clone() const final {
         return new UpdateStats(*this);
@@ -758,6 +764,10 @@ struct UpdateStats : public SpecificStats {
     // The number of documents modified by this update.
     size_t nModified;
 
+    // The number of modified documents that were written as byte-level damages to the existing
+    // record rather than as a whole new document.
+    size_t nModifiedInPlace;
+
     // True iff this is a $mod update.
     bool isModUpdate;
 
@@ -891,6 +901,11 @@ struct DocumentSourceLookupStats : public SpecificStats {
 
     // Tracks the summary stats in aggregate across all executions of the subpipeline.
     PlanSummaryStats planSummaryStats;
+
+    // The number of input documents whose joined documents were found in, and were not found in,
+    // the cache of a correlated foreign pipeline's results.
+    long long correlatedCacheHits = 0;
+    long long correlatedCacheMisses = 0;
 };
 
 }  // namespace mongo
@@ -32,6 +32,7 @@
 
 #include "mongo/base/exact_cast.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/exec/exclusion_projection_executor.h"
 #include "mongo/db/exec/inclusion_projection_executor.h"
 #include "mongo/db/exec/projection_executor.h"
 #include "mongo/db/exec/projection_executor_builder.h"
@@ -112,20 +113,30 @@ protected:
         if (executor->getType() == TransformerInterface::TransformerType::kInclusionProjection) {
             auto inclusionExecutor =
                 static_cast<projection_executor::InclusionProjectionExecutor*>(executor.get());
-            auto fastPathRootNode =
+            assertFastPathRootNode(
                 exact_pointer_cast<projection_executor::FastPathEligibleInclusionNode*>(
-                    inclusionExecutor->getRoot());
-            if (_allowFastPath) {
-                ASSERT_TRUE(fastPathRootNode || AllowFallBackToDefault);
-            } else {
-                ASSERT_FALSE(fastPathRootNode);
-            }
+                    inclusionExecutor->getRoot()));
+        } else if (executor->getType() ==
+                   TransformerInterface::TransformerType::kExclusionProjection) {
+            auto exclusionExecutor =
+                static_cast<projection_executor::ExclusionProjectionExecutor*>(executor.get());
+            assertFastPathRootNode(
+                exact_pointer_cast<projection_executor::FastPathEligibleExclusionNode*>(
+                    exclusionExecutor->getRoot()));
         }
         return executor;
     }
 
-    // True, if the projection executor is allowed to use the fast-path inclusion projection
-    // implementation.
+    void assertFastPathRootNode(const void* fastPathRootNode) const {
+        if (_allowFastPath) {
+            ASSERT_TRUE(fastPathRootNode || AllowFallBackToDefault);
+        } else {
+            ASSERT_FALSE(fastPathRootNode);
+        }
+    }
+
+    // True, if the projection executor is allowed to use the fast-path inclusion or exclusion
+    // projection implementation.
     bool _allowFastPath{true};
 };
 
@@ -177,7 +188,7 @@ TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExpressionWithComm
                        executor->applyTransformation(Document{fromjson("{a: {b: {e: 4}, p: 2}}")}));
 }
 
-TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionWithIdPath) {
+TEST_F(ProjectionExecutorTestWithoutFallBackToDefault, CanProjectExclusionWithIdPath) {
     auto projWithoutId = parseWithDefaultPolicies(fromjson("{a: 0, _id: 0}"));
     auto executor = createProjectionExecutor(projWithoutId);
     ASSERT_DOCUMENT_EQ(Document{fromjson("{b: 'def', c: 'ghi'}")},
@@ -185,7 +196,7 @@ TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionWithIdPat
                            Document{fromjson("{_id: 123, a: 'abc', b: 'def', c: 'ghi'}")}));
 }
 
-TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionUndottedPath) {
+TEST_F(ProjectionExecutorTestWithoutFallBackToDefault, CanProjectExclusionUndottedPath) {
     auto proj = parseWithDefaultPolicies(fromjson("{a: 0, b: 0}"));
     auto executor = createProjectionExecutor(proj);
     ASSERT_DOCUMENT_EQ(
@@ -193,7 +204,7 @@ TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionUndottedP
         executor->applyTransformation(Document{fromjson("{a: 'abc', b: 'def', c: 'ghi'}")}));
 }
 
-TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionDottedPath) {
+TEST_F(ProjectionExecutorTestWithoutFallBackToDefault, CanProjectExclusionDottedPath) {
     auto proj = parseWithDefaultPolicies(fromjson("{'a.b': 0, 'a.d': 0}"));
     auto executor = createProjectionExecutor(proj);
     ASSERT_DOCUMENT_EQ(
@@ -201,6 +212,15 @@ TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionDottedPat
         executor->applyTransformation(Document{fromjson("{a: {b: 'abc', c: 'def', d: 'ghi'}}")}));
 }
 
+TEST_F(ProjectionExecutorTestWithoutFallBackToDefault, CanProjectExclusionThroughArrays) {
+    auto proj = parseWithDefaultPolicies(fromjson("{'a.b': 0, c: 0}"));
+    auto executor = createProjectionExecutor(proj);
+    ASSERT_DOCUMENT_EQ(
+        Document{fromjson("{a: [{d: 2}, 3, [{d: 5}], {}], e: 6}")},
+        executor->applyTransformation(Document{
+            fromjson("{a: [{b: 1, d: 2}, 3, [{b: 4, d: 5}], {b: 7}], c: 'abc', e: 6}")}));
+}
+
 TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectFindPositional) {
     auto proj =
         parseWithFindFeaturesEnabled(fromjson("{'a.b.$': 1}"), fromjson("{'a.b': {$gte: 3}}"));
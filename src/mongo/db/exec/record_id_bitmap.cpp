@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+bool RecordIdBitmap::insert(const RecordId& rid) {
+    if (!_containers[_highBits(rid)].insert(_lowBits(rid))) {
+        return false;
+    }
+    ++_size;
+    return true;
+}
+
+bool RecordIdBitmap::contains(const RecordId& rid) const {
+    auto it = _containers.find(_highBits(rid));
+    return it != _containers.end() && it->second.contains(_lowBits(rid));
+}
+
+void RecordIdBitmap::clear() {
+    _containers.clear();
+    _size = 0;
+}
+
+uint64_t RecordIdBitmap::memUsageBytes() const {
+    uint64_t memUsage = sizeof(*this);
+    for (auto&& [highBits, container] : _containers) {
+        memUsage += sizeof(highBits) + container.memUsageBytes();
+    }
+    return memUsage;
+}
+
+bool RecordIdBitmap::Container::insert(uint16_t value) {
+    if (_bitset) {
+        uint64_t& word = _bitset[value / 64];
+        const uint64_t bit = uint64_t{1} << (value % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        return true;
+    }
+
+    auto it = std::lower_bound(_array.begin(), _array.end(), value);
+    if (it != _array.end() && *it == value) {
+        return false;
+    }
+    if (_array.size() < kMaxArraySize) {
+        _array.insert(it, value);
+        return true;
+    }
+
+    // The array is full, so switch to a bitset.
+    _bitset = std::make_unique<uint64_t[]>(kBitsetWords);
+    for (auto arrayValue : _array) {
+        _bitset[arrayValue / 64] |= uint64_t{1} << (arrayValue % 64);
+    }
+    _bitset[value / 64] |= uint64_t{1} << (value % 64);
+    std::vector<uint16_t>().swap(_array);
+    return true;
+}
+
+bool RecordIdBitmap::Container::contains(uint16_t value) const {
+    if (_bitset) {
+        return _bitset[value / 64] & (uint64_t{1} << (value % 64));
+    }
+    return std::binary_search(_array.begin(), _array.end(), value);
+}
+
+uint64_t RecordIdBitmap::Container::memUsageBytes() const {
+    return sizeof(*this) + (_bitset ? kBitsetWords * sizeof(uint64_t)
+                                    : _array.capacity() * sizeof(uint16_t));
+}
+
+}  // namespace mongo
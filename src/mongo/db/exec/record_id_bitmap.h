@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A set of RecordIds stored as a compressed bitmap, in the manner of roaring bitmaps.
+ *
+ * RecordIds are split into their high 48 bits, which select a container, and their low 16 bits,
+ * which are stored in it. A container holds its values as a sorted array while it has few of
+ * them, and as a bitset of 2^16 bits once it has more than kMaxArraySize. Since the RecordIds of
+ * a collection are allocated densely, a set of many of them costs a few bits per RecordId, rather
+ * than the tens of bytes per entry of a hash set, and looking one up touches a single container.
+ */
+class RecordIdBitmap {
+public:
+    // The number of values past which a container switches from a sorted array to a bitset. At
+    // this size both take 8KB.
+    static constexpr size_t kMaxArraySize = 4096;
+
+    /**
+     * Adds 'rid' to the set. Returns true if it was not in the set already.
+     */
+    bool insert(const RecordId& rid);
+
+    bool contains(const RecordId& rid) const;
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void clear();
+
+    /**
+     * Returns an estimate of the memory used by the set, in bytes.
+     */
+    uint64_t memUsageBytes() const;
+
+private:
+    class Container {
+    public:
+        bool insert(uint16_t value);
+        bool contains(uint16_t value) const;
+        uint64_t memUsageBytes() const;
+
+    private:
+        static constexpr size_t kBitsetWords = (1 << 16) / 64;
+
+        // Sorted values, while the container is not a bitset.
+        std::vector<uint16_t> _array;
+        std::unique_ptr<uint64_t[]> _bitset;
+    };
+
+    static uint64_t _highBits(const RecordId& rid) {
+        return static_cast<uint64_t>(rid.repr()) >> 16;
+    }
+
+    static uint16_t _lowBits(const RecordId& rid) {
+        return static_cast<uint16_t>(static_cast<uint64_t>(rid.repr()));
+    }
+
+    stdx::unordered_map<uint64_t, Container> _containers;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
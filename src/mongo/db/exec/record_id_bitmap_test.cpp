@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <set>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBitmapTest, InsertReportsNewRecordIds) {
+    RecordIdBitmap bitmap;
+    ASSERT_TRUE(bitmap.empty());
+    ASSERT_TRUE(bitmap.insert(RecordId(1)));
+    ASSERT_TRUE(bitmap.insert(RecordId(3)));
+    ASSERT_FALSE(bitmap.insert(RecordId(1)));
+    ASSERT_EQ(bitmap.size(), 2U);
+
+    ASSERT_TRUE(bitmap.contains(RecordId(1)));
+    ASSERT_FALSE(bitmap.contains(RecordId(2)));
+    ASSERT_TRUE(bitmap.contains(RecordId(3)));
+
+    bitmap.clear();
+    ASSERT_TRUE(bitmap.empty());
+    ASSERT_FALSE(bitmap.contains(RecordId(1)));
+}
+
+TEST(RecordIdBitmapTest, DistinguishesRecordIdsSharingLowBits) {
+    RecordIdBitmap bitmap;
+    ASSERT_TRUE(bitmap.insert(RecordId(5)));
+    ASSERT_TRUE(bitmap.insert(RecordId((int64_t{1} << 16) + 5)));
+    ASSERT_TRUE(bitmap.insert(RecordId((int64_t{1} << 40) + 5)));
+    ASSERT_TRUE(bitmap.insert(RecordId(RecordId::kMaxRepr)));
+    ASSERT_TRUE(bitmap.insert(RecordId(RecordId::kMinRepr)));
+    ASSERT_EQ(bitmap.size(), 5U);
+    ASSERT_FALSE(bitmap.contains(RecordId((int64_t{1} << 17) + 5)));
+    ASSERT_TRUE(bitmap.contains(RecordId((int64_t{1} << 40) + 5)));
+    ASSERT_TRUE(bitmap.contains(RecordId(RecordId::kMinRepr)));
+}
+
+TEST(RecordIdBitmapTest, SwitchesToBitsetWhenDense) {
+    RecordIdBitmap bitmap;
+    const int64_t n = 3 * RecordIdBitmap::kMaxArraySize;
+    for (int64_t i = 0; i < n; ++i) {
+        ASSERT_TRUE(bitmap.insert(RecordId(2 * i)));
+    }
+    for (int64_t i = 0; i < n; ++i) {
+        ASSERT_FALSE(bitmap.insert(RecordId(2 * i)));
+        ASSERT_TRUE(bitmap.contains(RecordId(2 * i)));
+        ASSERT_FALSE(bitmap.contains(RecordId(2 * i + 1)));
+    }
+    ASSERT_EQ(bitmap.size(), static_cast<size_t>(n));
+
+    // The values fit in one container, which is now a bitset of 2^16 bits.
+    ASSERT_LT(bitmap.memUsageBytes(), 16U * 1024);
+}
+
+TEST(RecordIdBitmapTest, AgreesWithSetOnRandomRecordIds) {
+    PseudoRandom random(12345);
+    RecordIdBitmap bitmap;
+    std::set<int64_t> expected;
+    for (int i = 0; i < 100000; ++i) {
+        const int64_t repr = random.nextInt64(1 << 20);
+        ASSERT_EQ(bitmap.insert(RecordId(repr)), expected.insert(repr).second);
+    }
+    ASSERT_EQ(bitmap.size(), expected.size());
+    for (int64_t repr = 0; repr < (1 << 20); ++repr) {
+        ASSERT_EQ(bitmap.contains(RecordId(repr)), expected.count(repr) == 1);
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -508,6 +508,19 @@ std::unique_ptr<vm::CodeFragment> EFunction::compile(CompileCtx& ctx) const {
         return code;
     }
 
+    // A field name known at compile time is stored in the instruction stream itself instead of
+    // being pushed onto (and popped off) the stack on every evaluation.
+    if (_name == "getField" && _nodes.size() == 2) {
+        if (auto field = dynamic_cast<const EConstant*>(_nodes[1].get()); field) {
+            auto [fieldTag, fieldVal] = field->getConstant();
+            if (value::isString(fieldTag)) {
+                auto code = _nodes[0]->compile(ctx);
+                code->appendGetField(value::getStringView(fieldTag, fieldVal));
+                return code;
+            }
+        }
+    }
+
     if (auto it = kInstrFunctions.find(_name); it != kInstrFunctions.end()) {
         if (!it->second.arityTest(_nodes.size())) {
             uasserted(4822845,
@@ -844,6 +857,23 @@ std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeCopy(bool isSmp) {
     return std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
 }
 
+std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeDeepCopy() const {
+    auto env = std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
+
+    // The accessors of the new environment refer to the state through the environment pointer, so
+    // the shared state can be swapped for a private copy after construction.
+    env->_state = std::make_shared<State>(*_state);
+    for (size_t idx = 0; idx < _state->vals.size(); ++idx) {
+        if (_state->owned[idx]) {
+            auto [tag, val] = value::copyValue(_state->typeTags[idx], _state->vals[idx]);
+            env->_state->typeTags[idx] = tag;
+            env->_state->vals[idx] = val;
+        }
+    }
+
+    return env;
+}
+
 void RuntimeEnvironment::debugString(StringBuilder* builder) {
     *builder << "env: { ";
     for (auto&& [type, slot] : _state->slots) {
@@ -118,6 +118,14 @@ public:
      */
     std::unique_ptr<RuntimeEnvironment> makeCopy(bool isSmp);
 
+    /**
+     * Make a copy of this environment which does not share any slot values with the original.
+     * Owned values are copied into the new environment. This is used when an execution tree is
+     * kept in a cache, so that the plans instantiated from the cached copy do not observe each
+     * other's slot values.
+     */
+    std::unique_ptr<RuntimeEnvironment> makeDeepCopy() const;
+
     /**
      * Dumps all the slots currently defined in this environment into the given string builder.
      */
@@ -326,6 +334,10 @@ public:
 
     std::vector<DebugPrinter::Block> debugPrint() const override;
 
+    std::pair<value::TypeTags, value::Value> getConstant() const {
+        return {_tag, _val};
+    }
+
 private:
     value::TypeTags _tag;
     value::Value _val;
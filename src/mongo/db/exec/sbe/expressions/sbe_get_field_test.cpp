@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+
+namespace mongo::sbe {
+
+class SBEGetFieldTest : public EExpressionTestFixture {
+protected:
+    using TypedValue = std::pair<value::TypeTags, value::Value>;
+
+    /**
+     * Compile and run expression 'getField(obj, field)' where 'field' is either a constant or read
+     * from a slot, and return its result. The caller owns the returned value.
+     */
+    TypedValue runGetField(const BSONObj& obj, TypedValue field, bool constantField) {
+        value::ViewOfValueAccessor objAccessor;
+        auto objSlot = bindAccessor(&objAccessor);
+        objAccessor.reset(value::TypeTags::bsonObject,
+                          value::bitcastFrom<const char*>(obj.objdata()));
+
+        value::ViewOfValueAccessor fieldAccessor;
+        auto fieldSlot = bindAccessor(&fieldAccessor);
+        fieldAccessor.reset(field.first, field.second);
+
+        std::unique_ptr<EExpression> fieldExpr;
+        if (constantField) {
+            auto fieldCopy = value::copyValue(field.first, field.second);
+            fieldExpr = makeE<EConstant>(fieldCopy.first, fieldCopy.second);
+        } else {
+            fieldExpr = makeE<EVariable>(fieldSlot);
+        }
+
+        auto expr = makeE<EFunction>("getField",
+                                     makeEs(makeE<EVariable>(objSlot), std::move(fieldExpr)));
+        auto compiledExpr = compileExpression(*expr);
+        return runCompiledExpression(compiledExpr.get());
+    }
+
+    /**
+     * Assert that 'getField(obj, field)' returns 'expected' for both a constant and a variable
+     * field name.
+     */
+    void assertGetField(const BSONObj& obj, TypedValue field, TypedValue expected) {
+        for (bool constantField : {true, false}) {
+            auto actual = runGetField(obj, field, constantField);
+            value::ValueGuard guard{actual};
+
+            auto [compareTag, compareValue] =
+                value::compareValue(actual.first, actual.second, expected.first, expected.second);
+            ASSERT_EQ(compareTag, value::TypeTags::NumberInt32);
+            ASSERT_EQ(compareValue, 0);
+        }
+    }
+};
+
+TEST_F(SBEGetFieldTest, ReturnsFieldWithConstantOrVariableName) {
+    auto obj = BSON("a" << 1 << "bb" << 2.5 << "longFieldName" << 3LL);
+
+    for (auto&& [name, expected] : std::vector<std::pair<std::string, TypedValue>>{
+             {"a", makeInt32(1)},
+             {"bb", makeDouble(2.5)},
+             {"longFieldName", makeInt64(3)},
+             {"missing", makeNothing()},
+             {"", makeNothing()}}) {
+        auto field = value::makeNewString(name);
+        value::ValueGuard guard{field};
+        assertGetField(obj, field, expected);
+    }
+}
+
+TEST_F(SBEGetFieldTest, FieldNameLongerThanImmediateLimit) {
+    std::string name(300, 'x');
+    auto obj = BSON(name << 7);
+
+    auto field = value::makeNewString(name);
+    value::ValueGuard guard{field};
+    assertGetField(obj, field, makeInt32(7));
+}
+
+TEST_F(SBEGetFieldTest, NonStringFieldNameReturnsNothing) {
+    assertGetField(BSON("1" << 1), makeInt32(1), makeNothing());
+}
+
+}  // namespace mongo::sbe
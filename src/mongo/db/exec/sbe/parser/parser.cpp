@@ -969,6 +969,7 @@ void Parser::walkGroup(AstQuery& ast) {
     ast.stage = makeS<HashAggStage>(std::move(ast.nodes[2]->stage),
                                     lookupSlots(std::move(ast.nodes[0]->identifiers)),
                                     lookupSlots(std::move(ast.nodes[1]->projects)),
+                                    false /* allowDiskUse */,
                                     getCurrentPlanNodeId());
 }
 
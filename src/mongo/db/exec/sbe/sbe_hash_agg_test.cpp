@@ -0,0 +1,194 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo::sbe {
+
+class HashAggStageTest : public PlanStageTestFixture {
+public:
+    void setUp() override {
+        PlanStageTestFixture::setUp();
+        _originalDbPath = storageGlobalParams.dbpath;
+        _originalMemoryLimit = internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes.load();
+        storageGlobalParams.dbpath = _tempDir.path();
+    }
+
+    void tearDown() override {
+        internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes.store(_originalMemoryLimit);
+        storageGlobalParams.dbpath = _originalDbPath;
+        PlanStageTestFixture::tearDown();
+    }
+
+    /**
+     * Builds a hash aggregation which groups the [key, value] pairs in 'input' by key and sums up
+     * the values, runs it to completion and returns the sum for every key.
+     */
+    std::map<int, int> runSumByKey(const BSONArray& input, bool allowDiskUse) {
+        auto [scanSlots, scanStage] = generateVirtualScanMulti(2, input);
+
+        auto sumSlot = generateSlotId();
+        auto stage = makeS<HashAggStage>(
+            std::move(scanStage),
+            makeSV(scanSlots[0]),
+            makeEM(sumSlot,
+                   stage_builder::makeFunction("sum", makeE<EVariable>(scanSlots[1]))),
+            allowDiskUse,
+            kEmptyPlanNodeId);
+
+        auto ctx = makeCompileCtx();
+        auto accessors = prepareTree(ctx.get(), stage.get(), makeSV(scanSlots[0], sumSlot));
+
+        std::map<int, int> results;
+        while (stage->getNext() == PlanState::ADVANCED) {
+            auto [keyTag, keyVal] = accessors[0]->getViewOfValue();
+            auto [sumTag, sumVal] = accessors[1]->getViewOfValue();
+            ASSERT_EQ(keyTag, value::TypeTags::NumberInt32);
+            ASSERT_EQ(sumTag, value::TypeTags::NumberInt32);
+
+            auto [it, inserted] = results.emplace(value::bitcastTo<int32_t>(keyVal),
+                                                  value::bitcastTo<int32_t>(sumVal));
+            ASSERT_TRUE(inserted) << "group " << it->first << " was returned more than once";
+        }
+
+        _lastStats = *static_cast<const HashAggStats*>(stage->getSpecificStats());
+        stage->close();
+        return results;
+    }
+
+    /**
+     * Returns an array of [key, value] pairs with 'numKeys' distinct keys, each of which appears
+     * 'rowsPerKey' times with the values 1, 2, ..., rowsPerKey. The keys are interleaved so that
+     * every key keeps receiving rows until the end of the input.
+     */
+    BSONArray makeInput(int numKeys, int rowsPerKey) {
+        BSONArrayBuilder builder;
+        for (int row = 1; row <= rowsPerKey; ++row) {
+            for (int key = 0; key < numKeys; ++key) {
+                builder.append(BSON_ARRAY(key << row));
+            }
+        }
+        return builder.arr();
+    }
+
+protected:
+    HashAggStats _lastStats;
+
+private:
+    unittest::TempDir _tempDir{"sbe_hash_agg_test"};
+    std::string _originalDbPath;
+    long long _originalMemoryLimit;
+};
+
+TEST_F(HashAggStageTest, SumByKeyWithoutSpilling) {
+    auto results = runSumByKey(makeInput(10, 4), true /* allowDiskUse */);
+
+    ASSERT_EQ(results.size(), 10u);
+    for (auto&& [key, sum] : results) {
+        ASSERT_EQ(sum, 1 + 2 + 3 + 4) << "key " << key;
+    }
+    ASSERT_FALSE(_lastStats.usedDisk);
+    ASSERT_EQ(_lastStats.spilledRecords, 0u);
+}
+
+TEST_F(HashAggStageTest, SumByKeySpillsWhenOverMemoryLimit) {
+    // A budget of a single byte only admits the first group into the hash table.
+    internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes.store(1);
+
+    const int numKeys = 50;
+    const int rowsPerKey = 6;
+    auto results = runSumByKey(makeInput(numKeys, rowsPerKey), true /* allowDiskUse */);
+
+    ASSERT_EQ(results.size(), static_cast<size_t>(numKeys));
+    for (auto&& [key, sum] : results) {
+        ASSERT_EQ(sum, rowsPerKey * (rowsPerKey + 1) / 2) << "key " << key;
+    }
+    ASSERT_EQ(_lastStats.spilledRecords, static_cast<size_t>((numKeys - 1) * rowsPerKey));
+    ASSERT_TRUE(_lastStats.usedDisk);
+    ASSERT_GT(_lastStats.spills, 0u);
+}
+
+TEST_F(HashAggStageTest, MemoryLimitIsIgnoredWithoutAllowDiskUse) {
+    internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes.store(1);
+
+    auto results = runSumByKey(makeInput(20, 3), false /* allowDiskUse */);
+
+    ASSERT_EQ(results.size(), 20u);
+    for (auto&& [key, sum] : results) {
+        ASSERT_EQ(sum, 1 + 2 + 3) << "key " << key;
+    }
+    ASSERT_FALSE(_lastStats.usedDisk);
+    ASSERT_EQ(_lastStats.spilledRecords, 0u);
+}
+
+TEST_F(HashAggStageTest, MinAndMaxCompareAcrossTypesAndKeepFirstOfEqualValues) {
+    auto [scanSlots, scanStage] = generateVirtualScanMulti(
+        2,
+        BSON_ARRAY(BSON_ARRAY(0 << "a") << BSON_ARRAY(0 << 2) << BSON_ARRAY(0 << 1LL)
+                                        << BSON_ARRAY(0 << 1.0) << BSON_ARRAY(0 << "b")));
+
+    auto minSlot = generateSlotId();
+    auto maxSlot = generateSlotId();
+    auto stage = makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlots[0]),
+        makeEM(minSlot,
+               stage_builder::makeFunction("min", makeE<EVariable>(scanSlots[1])),
+               maxSlot,
+               stage_builder::makeFunction("max", makeE<EVariable>(scanSlots[1]))),
+        false /* allowDiskUse */,
+        kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    auto accessors = prepareTree(ctx.get(), stage.get(), makeSV(minSlot, maxSlot));
+    ASSERT_TRUE(stage->getNext() == PlanState::ADVANCED);
+
+    // Numbers sort before strings, and of the equal numbers 1 and 1.0 the first one is kept.
+    auto [minTag, minVal] = accessors[0]->getViewOfValue();
+    ASSERT_EQ(minTag, value::TypeTags::NumberInt64);
+    ASSERT_EQ(value::bitcastTo<int64_t>(minVal), 1);
+
+    auto [maxTag, maxVal] = accessors[1]->getViewOfValue();
+    ASSERT_TRUE(value::isString(maxTag));
+    ASSERT_EQ(value::getStringView(maxTag, maxVal), "b");
+
+    ASSERT_TRUE(stage->getNext() == PlanState::IS_EOF);
+    stage->close();
+}
+
+}  // namespace mongo::sbe
@@ -69,4 +69,36 @@ TEST_F(SortStageTest, SortNumbersTest) {
     runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
 }
 
+TEST_F(SortStageTest, SortNumbersWithLimitTest) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(BSON_ARRAY(
+        BSON_ARRAY(12LL << "A") << BSON_ARRAY(2.5 << "B") << BSON_ARRAY(7 << "C")
+                                << BSON_ARRAY(Decimal128(4) << "D") << BSON_ARRAY(1 << "E")
+                                << BSON_ARRAY(9 << "F") << BSON_ARRAY(3 << "G")));
+    value::ValueGuard inputGuard{inputTag, inputVal};
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY(
+        BSON_ARRAY(12LL << "A") << BSON_ARRAY(9 << "F") << BSON_ARRAY(7 << "C")));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    auto makeStageFn = [](value::SlotVector scanSlots, std::unique_ptr<PlanStage> scanStage) {
+        // Create a SortStage that keeps the top 3 of slot0 in descending order. Once it holds 3
+        // rows, later rows which sort after the worst kept one are skipped without being copied.
+        auto sortStage =
+            makeS<SortStage>(std::move(scanStage),
+                             makeSV(scanSlots[0]),
+                             std::vector<value::SortDirection>{value::SortDirection::Descending},
+                             makeSV(scanSlots[1]),
+                             3,
+                             204857600,
+                             false,
+                             kEmptyPlanNodeId);
+
+        return std::make_pair(scanSlots, std::move(sortStage));
+    };
+
+    inputGuard.reset();
+    expectedGuard.reset();
+    runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
+}
+
 }  // namespace mongo::sbe
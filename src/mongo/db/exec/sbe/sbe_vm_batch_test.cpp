@@ -0,0 +1,185 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include <limits>
+
+#include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::sbe {
+namespace {
+
+template <typename T>
+void appendNumbers(vm::ValueColumn* column, value::TypeTags tag, std::vector<T> numbers) {
+    for (auto number : numbers) {
+        column->push_back(false, tag, value::bitcastFrom<T>(number));
+    }
+}
+
+void assertBooleans(const vm::ValueColumn& column, std::vector<bool> expected) {
+    ASSERT_EQ(column.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT(column.tag(i) == value::TypeTags::Boolean) << i;
+        ASSERT_EQ(value::bitcastTo<bool>(column.val(i)), expected[i]) << i;
+    }
+}
+
+TEST(SBEVMBatch, DoubleArithmetic) {
+    vm::ValueColumn lhs, rhs, out;
+    // An odd number of values, so that both the vector loop and its remainder run.
+    appendNumbers<double>(&lhs, value::TypeTags::NumberDouble, {1.5, -2, 8, 0.25, 10});
+    appendNumbers<double>(&rhs, value::TypeTags::NumberDouble, {2.5, 4, -0.5, 4, 3});
+
+    vm::ByteCode vm;
+    vm.addBatch(lhs, rhs, &out);
+    std::vector<double> expectedSum{4, 2, 7.5, 4.25, 13};
+    for (size_t i = 0; i < expectedSum.size(); ++i) {
+        ASSERT(out.tag(i) == value::TypeTags::NumberDouble);
+        ASSERT_EQ(value::bitcastTo<double>(out.val(i)), expectedSum[i]);
+    }
+
+    vm.subBatch(lhs, rhs, &out);
+    ASSERT_EQ(value::bitcastTo<double>(out.val(1)), -6);
+    ASSERT_EQ(value::bitcastTo<double>(out.val(4)), 7);
+
+    vm.mulBatch(lhs, rhs, &out);
+    ASSERT_EQ(value::bitcastTo<double>(out.val(2)), -4);
+    ASSERT_EQ(value::bitcastTo<double>(out.val(4)), 30);
+}
+
+TEST(SBEVMBatch, Int64ArithmeticWidensOnOverflow) {
+    const auto max = std::numeric_limits<int64_t>::max();
+    const auto min = std::numeric_limits<int64_t>::min();
+
+    vm::ValueColumn lhs, rhs, out;
+    appendNumbers<int64_t>(&lhs, value::TypeTags::NumberInt64, {1, max, -7, min, 3});
+    appendNumbers<int64_t>(&rhs, value::TypeTags::NumberInt64, {2, 1, 7, 1, max});
+
+    vm::ByteCode vm;
+    vm.addBatch(lhs, rhs, &out);
+    ASSERT(out.tag(0) == value::TypeTags::NumberInt64);
+    ASSERT_EQ(value::bitcastTo<int64_t>(out.val(0)), 3);
+    ASSERT(out.tag(1) == value::TypeTags::NumberDecimal);
+    ASSERT(value::bitcastTo<Decimal128>(out.val(1)).isEqual(Decimal128(max).add(Decimal128(1))));
+    ASSERT_EQ(value::bitcastTo<int64_t>(out.val(2)), 0);
+    ASSERT_EQ(value::bitcastTo<int64_t>(out.val(3)), min + 1);
+    ASSERT(out.tag(4) == value::TypeTags::NumberDecimal);
+
+    vm.subBatch(lhs, rhs, &out);
+    ASSERT(out.tag(1) == value::TypeTags::NumberInt64);
+    ASSERT_EQ(value::bitcastTo<int64_t>(out.val(1)), max - 1);
+    ASSERT(out.tag(3) == value::TypeTags::NumberDecimal);
+    ASSERT_EQ(value::bitcastTo<int64_t>(out.val(4)), 3 - max);
+
+    vm.mulBatch(lhs, rhs, &out);
+    ASSERT_EQ(value::bitcastTo<int64_t>(out.val(2)), -49);
+    ASSERT(out.tag(4) == value::TypeTags::NumberDecimal);
+}
+
+TEST(SBEVMBatch, MixedTypesUseGenericArithmetic) {
+    vm::ValueColumn lhs, rhs, out;
+    lhs.push_back(false, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(2));
+    lhs.push_back(false, value::TypeTags::NumberDouble, value::bitcastFrom<double>(0.5));
+    auto [strTag, strVal] = value::makeNewString("not a number");
+    lhs.push_back(true, strTag, strVal);
+    appendNumbers<int64_t>(&rhs, value::TypeTags::NumberInt64, {3, 1, 1});
+
+    vm::ByteCode vm;
+    vm.addBatch(lhs, rhs, &out);
+    ASSERT(out.tag(0) == value::TypeTags::NumberInt64);
+    ASSERT_EQ(value::bitcastTo<int64_t>(out.val(0)), 5);
+    ASSERT(out.tag(1) == value::TypeTags::NumberDouble);
+    ASSERT_EQ(value::bitcastTo<double>(out.val(1)), 1.5);
+    ASSERT(out.tag(2) == value::TypeTags::Nothing);
+}
+
+TEST(SBEVMBatch, DoubleComparisons) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    vm::ValueColumn lhs, rhs, out;
+    appendNumbers<double>(&lhs, value::TypeTags::NumberDouble, {1, 2, 3, nan, 5});
+    appendNumbers<double>(&rhs, value::TypeTags::NumberDouble, {2, 2, 1, 1, nan});
+
+    vm::ByteCode vm;
+    vm.lessBatch(lhs, rhs, &out);
+    assertBooleans(out, {true, false, false, false, false});
+    vm.lessEqBatch(lhs, rhs, &out);
+    assertBooleans(out, {true, true, false, false, false});
+    vm.greaterBatch(lhs, rhs, &out);
+    assertBooleans(out, {false, false, true, false, false});
+    vm.greaterEqBatch(lhs, rhs, &out);
+    assertBooleans(out, {false, true, true, false, false});
+    vm.eqBatch(lhs, rhs, &out);
+    assertBooleans(out, {false, true, false, false, false});
+    vm.neqBatch(lhs, rhs, &out);
+    assertBooleans(out, {true, false, true, true, true});
+}
+
+TEST(SBEVMBatch, Int64AndMixedComparisons) {
+    vm::ValueColumn lhs, rhs, out;
+    appendNumbers<int64_t>(&lhs, value::TypeTags::NumberInt64, {-1, 5, 7});
+    appendNumbers<int64_t>(&rhs, value::TypeTags::NumberInt64, {0, 5, 6});
+
+    vm::ByteCode vm;
+    vm.lessBatch(lhs, rhs, &out);
+    assertBooleans(out, {true, false, false});
+    vm.eqBatch(lhs, rhs, &out);
+    assertBooleans(out, {false, true, false});
+
+    vm::ValueColumn mixed;
+    appendNumbers<double>(&mixed, value::TypeTags::NumberDouble, {-0.5, 5, 7.5});
+    vm.greaterEqBatch(lhs, mixed, &out);
+    assertBooleans(out, {false, true, false});
+}
+
+TEST(SBEVMBatch, FillEmpty) {
+    vm::ValueColumn lhs, rhs, out;
+    lhs.push_back(false, value::TypeTags::Nothing, 0);
+    lhs.push_back(false, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(1));
+    lhs.push_back(false, value::TypeTags::Nothing, 0);
+    rhs.push_back(false, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(2));
+    rhs.push_back(false, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(3));
+    auto [strTag, strVal] = value::makeNewString("a string that needs an allocation");
+    rhs.push_back(true, strTag, strVal);
+
+    vm::ByteCode vm;
+    vm.fillEmptyBatch(lhs, rhs, &out);
+    ASSERT_EQ(value::bitcastTo<int32_t>(out.val(0)), 2);
+    ASSERT_EQ(value::bitcastTo<int32_t>(out.val(1)), 1);
+
+    // The result owns a copy of the string, which outlives the input.
+    ASSERT(out.owned(2));
+    ASSERT_NE(out.val(2), rhs.val(2));
+    rhs.clear();
+    ASSERT_EQ(value::getStringView(out.tag(2), out.val(2)), "a string that needs an allocation");
+}
+}  // namespace
+}  // namespace mongo::sbe
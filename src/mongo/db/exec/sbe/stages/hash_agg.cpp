@@ -31,25 +31,41 @@
 
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashAggFileCounter;
+    return "extsort-hash-agg-sbe." + std::to_string(hashAggFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
                            value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                           bool allowDiskUse,
                            PlanNodeId planNodeId)
-    : PlanStage("group"_sd, planNodeId), _gbs(std::move(gbs)), _aggs(std::move(aggs)) {
+    : PlanStage("group"_sd, planNodeId),
+      _gbs(std::move(gbs)),
+      _aggs(std::move(aggs)),
+      _allowDiskUse(allowDiskUse) {
     _children.emplace_back(std::move(input));
 }
 
+HashAggStage::~HashAggStage() {}
+
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
     value::SlotMap<std::unique_ptr<EExpression>> aggs;
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
     return std::make_unique<HashAggStage>(
-        _children[0]->clone(), _gbs, std::move(aggs), _commonStats.nodeId);
+        _children[0]->clone(), _gbs, std::move(aggs), _allowDiskUse, _commonStats.nodeId);
 }
 
 void HashAggStage::prepare(CompileCtx& ctx) {
@@ -94,6 +110,19 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
         if (auto it = _outAccessors.find(slot); it != _outAccessors.end()) {
             return it->second;
         }
+    } else if (_allowDiskUse && ctx.aggExpression) {
+        // The aggregate expressions must be able to read their inputs back from spilled rows, so
+        // hand out an accessor which can be switched over to the spilled data.
+        if (auto it = _spillableInAccessors.find(slot); it != _spillableInAccessors.end()) {
+            return it->second.get();
+        }
+        auto accessor =
+            std::make_unique<SpillableInputAccessor>(_children[0]->getAccessor(ctx, slot),
+                                                     _readFromSpill,
+                                                     _spilledRow,
+                                                     _spillableInAccessorsList.size());
+        _spillableInAccessorsList.push_back(accessor.get());
+        return _spillableInAccessors.emplace(slot, std::move(accessor)).first->second.get();
     } else {
         return _children[0]->getAccessor(ctx, slot);
     }
@@ -101,6 +130,95 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
     return ctx.getAccessor(slot);
 }
 
+void HashAggStage::accumulate() {
+    for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+        auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
+        _outAggAccessors[idx]->reset(owned, tag, val);
+    }
+}
+
+void HashAggStage::spillRow(value::MaterializedRow key) {
+    if (!_spillSorter) {
+        SortOptions opts;
+        opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+        opts.maxMemoryUsageBytes = _memoryLimit;
+        opts.extSortAllowed = true;
+
+        // Spilled rows only need to be ordered such that the rows of a group are adjacent.
+        auto comp = [](const SpilledRow& lhs, const SpilledRow& rhs) {
+            auto size = lhs.first.size();
+            for (size_t idx = 0; idx < size; ++idx) {
+                auto [lhsTag, lhsVal] = lhs.first.getViewOfValue(idx);
+                auto [rhsTag, rhsVal] = rhs.first.getViewOfValue(idx);
+                auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+                auto result = value::bitcastTo<int32_t>(val);
+                if (result) {
+                    return result;
+                }
+            }
+
+            return 0;
+        };
+
+        _spillSorter.reset(SpillSorter::make(opts, comp, {}));
+    }
+
+    // The key was built from views of the input values, so it must be made owned before any of the
+    // inputs are moved out of the child's accessors.
+    key.makeOwned();
+
+    value::MaterializedRow vals{_spillableInAccessorsList.size()};
+    size_t idx = 0;
+    for (auto accessor : _spillableInAccessorsList) {
+        auto [tag, val] = accessor->inAccessor()->copyOrMoveValue();
+        vals.reset(idx++, true, tag, val);
+    }
+
+    _spillSorter->emplace(std::move(key), std::move(vals));
+    ++_specificStats.spilledRecords;
+}
+
+bool HashAggStage::aggregateNextSpilledGroup() {
+    _ht.clear();
+    _htIt = _ht.end();
+
+    if (!_hasSpilledRow) {
+        if (!_spillIt->more()) {
+            return false;
+        }
+        _spilledRow = _spillIt->next();
+        _hasSpilledRow = true;
+    }
+
+    auto [it, inserted] =
+        _ht.try_emplace(_spilledRow.first, value::MaterializedRow{_outAggAccessors.size()});
+    invariant(inserted);
+    _htIt = it;
+
+    // The spilled rows are ordered by key, so keep accumulating until the key changes. The first
+    // row of the next group stays in '_spilledRow' for the following call.
+    do {
+        accumulate();
+
+        if (!_spillIt->more()) {
+            _hasSpilledRow = false;
+            break;
+        }
+        _spilledRow = _spillIt->next();
+    } while (_spilledRow.first == _htIt->first);
+
+    return true;
+}
+
+void HashAggStage::doDetachFromTrialRunTracker() {
+    _tracker = nullptr;
+}
+
+void HashAggStage::doAttachToTrialRunTracker(TrialRunTracker* tracker) {
+    _tracker = tracker;
+}
+
 void HashAggStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
@@ -109,7 +227,24 @@ void HashAggStage::open(bool reOpen) {
         _ht.clear();
     }
 
+    _htMemoryUsage = 0;
+    _htFull = false;
+    _memoryLimit = internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes.load();
+    _spillSorter.reset();
+    _spillIt.reset();
+    _readFromSpill = false;
+    _hasSpilledRow = false;
+
     while (_children[0]->getNext() == PlanState::ADVANCED) {
+        if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumResults>(1)) {
+            // Like the sort stage, this stage does not return control to the runtime planner until
+            // it has consumed all of its input, so the trial run is stopped by raising a special
+            // exception once enough input has been aggregated, see SortStage::open().
+            _tracker = nullptr;
+            _children[0]->close();
+            uasserted(ErrorCodes::QueryTrialRunCompleted, "Trial run early exit");
+        }
+
         value::MaterializedRow key{_inKeyAccessors.size()};
         // Copy keys in order to do the lookup.
         size_t idx = 0;
@@ -118,6 +253,20 @@ void HashAggStage::open(bool reOpen) {
             key.reset(idx++, false, tag, val);
         }
 
+        if (_htFull) {
+            // The hash table is over its memory budget, rows for the groups which are not in the
+            // table yet go to disk.
+            auto it = _ht.find(key);
+            if (it == _ht.end()) {
+                spillRow(std::move(key));
+                continue;
+            }
+
+            _htIt = it;
+            accumulate();
+            continue;
+        }
+
         auto [it, inserted] = _ht.try_emplace(std::move(key), value::MaterializedRow{0});
         if (inserted) {
             // Copy keys.
@@ -128,25 +277,48 @@ void HashAggStage::open(bool reOpen) {
 
         // Accumulate.
         _htIt = it;
-        for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
-            auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
-            _outAggAccessors[idx]->reset(owned, tag, val);
+        accumulate();
+
+        if (inserted && _allowDiskUse) {
+            // The size of a group is estimated once, when it is created.
+            _htMemoryUsage += it->first.memUsageForSorter() + it->second.memUsageForSorter();
+            _htFull = _htMemoryUsage > _memoryLimit;
         }
     }
 
     _children[0]->close();
 
+    if (_spillSorter) {
+        _spillIt.reset(_spillSorter->done());
+        _specificStats.spills += _spillSorter->numSpills();
+        _specificStats.usedDisk = _specificStats.usedDisk || _spillSorter->numSpills() > 0;
+        _spillSorter.reset();
+    }
+
     _htIt = _ht.end();
 }
 
 PlanState HashAggStage::getNext() {
-    if (_htIt == _ht.end()) {
-        _htIt = _ht.begin();
-    } else {
-        ++_htIt;
+    if (!_readFromSpill) {
+        if (_htIt == _ht.end()) {
+            _htIt = _ht.begin();
+        } else {
+            ++_htIt;
+        }
+
+        if (_htIt != _ht.end()) {
+            return trackPlanState(PlanState::ADVANCED);
+        }
+
+        if (!_spillIt) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        // All of the in-memory groups have been returned, continue with the spilled ones.
+        _readFromSpill = true;
     }
 
-    if (_htIt == _ht.end()) {
+    if (!aggregateNextSpilledGroup()) {
         return trackPlanState(PlanState::IS_EOF);
     }
 
@@ -155,11 +327,14 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
 
     if (includeDebugInfo) {
         DebugPrinter printer;
         BSONObjBuilder bob;
         bob.append("groupBySlots", _gbs);
+        bob.appendBool("usedDisk", _specificStats.usedDisk);
+        bob.appendNumber("spilledRecords", static_cast<long long>(_specificStats.spilledRecords));
         if (!_aggs.empty()) {
             BSONObjBuilder childrenBob(bob.subobjStart("expressions"));
             for (auto&& [slot, expr] : _aggs) {
@@ -174,12 +349,14 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
     _commonStats.closes++;
     _ht.clear();
+    _spillIt.reset();
+    _spillSorter.reset();
 }
 
 std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
@@ -29,22 +29,40 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <absl/container/flat_hash_map.h>
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
-#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class Sorter;
+
 namespace sbe {
+/**
+ * Groups the rows produced by its child by the values in the 'gbs' slots and computes the 'aggs'
+ * expressions for every group.
+ *
+ * If 'allowDiskUse' is true, the memory used by the hash table is bounded by the
+ * 'internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes' knob. Once the table exceeds the
+ * budget no new groups are added to it; input rows which belong to a group that is not in the table
+ * are written to disk through the Sorter instead, ordered by their group-by key. After all of the
+ * groups held in memory have been returned, the spilled rows are read back one group at a time and
+ * aggregated using the same expressions. Without 'allowDiskUse' the hash table is unbounded.
+ */
 class HashAggStage final : public PlanStage {
 public:
     HashAggStage(std::unique_ptr<PlanStage> input,
                  value::SlotVector gbs,
                  value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                 bool allowDiskUse,
                  PlanNodeId planNodeId);
 
+    ~HashAggStage();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -57,15 +75,80 @@ public:
     const SpecificStats* getSpecificStats() const final;
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
+protected:
+    void doDetachFromTrialRunTracker() override;
+    void doAttachToTrialRunTracker(TrialRunTracker* tracker) override;
+
 private:
-    using TableType = stdx::
-        unordered_map<value::MaterializedRow, value::MaterializedRow, value::MaterializedRowHasher>;
+    // The accessors re-read the row through '_htIt' on every access and '_htIt' is reassigned
+    // after each insertion, so the table does not need pointer stability.
+    using TableType = absl::
+        flat_hash_map<value::MaterializedRow, value::MaterializedRow, value::MaterializedRowHasher>;
 
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    // Spilled rows are (group-by key, aggregate expression inputs) pairs.
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpillSorter = Sorter<value::MaterializedRow, value::MaterializedRow>;
+    using SpillIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
+    /**
+     * Accessor for a slot which is read by the aggregate expressions. While the stage consumes its
+     * child it forwards to the child's accessor, and while it aggregates spilled rows it reads the
+     * corresponding column of the current spilled row.
+     */
+    class SpillableInputAccessor final : public value::SlotAccessor {
+    public:
+        SpillableInputAccessor(value::SlotAccessor* inAccessor,
+                               const bool& readFromSpill,
+                               SpilledRow& spilledRow,
+                               size_t idx)
+            : _inAccessor(inAccessor),
+              _readFromSpill(readFromSpill),
+              _spilledRow(spilledRow),
+              _idx(idx) {}
+
+        std::pair<value::TypeTags, value::Value> getViewOfValue() const final {
+            return _readFromSpill ? _spilledRow.second.getViewOfValue(_idx)
+                                  : _inAccessor->getViewOfValue();
+        }
+        std::pair<value::TypeTags, value::Value> copyOrMoveValue() final {
+            return _readFromSpill ? _spilledRow.second.copyOrMoveValue(_idx)
+                                  : _inAccessor->copyOrMoveValue();
+        }
+
+        value::SlotAccessor* inAccessor() const {
+            return _inAccessor;
+        }
+
+    private:
+        value::SlotAccessor* const _inAccessor;
+        const bool& _readFromSpill;
+        SpilledRow& _spilledRow;
+        const size_t _idx;
+    };
+
+    /**
+     * Runs the aggregate expressions against the current input row for the group '_htIt' points
+     * to.
+     */
+    void accumulate();
+
+    /**
+     * Writes the current input row into the spill sorter, creating the sorter on first use.
+     */
+    void spillRow(value::MaterializedRow key);
+
+    /**
+     * Replaces the contents of the hash table with the next group read back from disk, aggregating
+     * all of the spilled rows with the same key. Returns false once the spilled rows are exhausted.
+     */
+    bool aggregateNextSpilledGroup();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
+    const bool _allowDiskUse;
 
     value::SlotAccessorMap _outAccessors;
     std::vector<value::SlotAccessor*> _inKeyAccessors;
@@ -74,12 +157,36 @@ private:
     std::vector<std::unique_ptr<HashAggAccessor>> _outAggAccessors;
     std::vector<std::unique_ptr<vm::CodeFragment>> _aggCodes;
 
+    // Accessors for the slots read by the aggregate expressions. Only populated when disk use is
+    // allowed.
+    value::SlotMap<std::unique_ptr<SpillableInputAccessor>> _spillableInAccessors;
+    std::vector<SpillableInputAccessor*> _spillableInAccessorsList;
+
     TableType _ht;
     TableType::iterator _htIt;
 
+    // Approximate memory used by the keys and accumulators in '_ht'.
+    size_t _htMemoryUsage{0};
+    size_t _memoryLimit{0};
+    // Set once '_htMemoryUsage' exceeds '_memoryLimit'. From then on no new groups are added to
+    // the hash table.
+    bool _htFull{false};
+
+    std::unique_ptr<SpillSorter> _spillSorter;
+    std::unique_ptr<SpillIterator> _spillIt;
+    SpilledRow _spilledRow;
+    bool _readFromSpill{false};
+    bool _hasSpilledRow{false};
+
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
+
+    HashAggStats _specificStats;
+
+    // If provided, used during a trial run to accumulate certain execution stats. Once the trial
+    // run is complete, this pointer is reset to nullptr.
+    TrialRunTracker* _tracker{nullptr};
 };
 }  // namespace sbe
 }  // namespace mongo
@@ -195,6 +195,29 @@ struct TraverseStats : public SpecificStats {
     size_t innerCloses{0};
 };
 
+struct HashAggStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new HashAggStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& summary) const final {
+        if (usedDisk) {
+            summary.usedDisk = true;
+        }
+    }
+
+    // True if the hash table exceeded its memory budget and input rows were written to disk.
+    bool usedDisk{false};
+    // The number of sorted runs written to disk while spilling.
+    size_t spills{0};
+    // The number of input rows which were spilled rather than aggregated in memory.
+    size_t spilledRecords{0};
+};
+
 /**
  * Calculates the total number of physical reads in the given plan stats tree. If a stage can do
  * a physical read (e.g. COLLSCAN or IXSCAN), then its 'numReads' stats is added to the total.
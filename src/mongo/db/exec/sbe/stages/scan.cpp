@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/trial_run_tracker.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -204,10 +205,31 @@ void ScanStage::open(bool reOpen) {
         _cursor.reset();
     }
 
+    _batch.clear();
+    _batchPos = 0;
+    _batchSize = 1;
+    _maxBatchSize = _seekKeyAccessor ? 1 : internalQueryCollectionScanMaxBatchSize.load();
+
     _open = true;
     _firstGetNext = true;
 }
 
+boost::optional<Record> ScanStage::advanceCursor() {
+    if (_maxBatchSize <= 1) {
+        return _cursor->next();
+    }
+
+    if (_batchPos == _batch.size()) {
+        _batchPos = 0;
+        _cursor->nextBatch(&_batch, _batchSize);
+        _batchSize = std::min(_batchSize * 2, _maxBatchSize);
+        if (_batch.empty()) {
+            return boost::none;
+        }
+    }
+    return _batch[_batchPos++];
+}
+
 PlanState ScanStage::getNext() {
     if (!_cursor) {
         return trackPlanState(PlanState::IS_EOF);
@@ -216,7 +238,7 @@ PlanState ScanStage::getNext() {
     checkForInterrupt(_opCtx);
 
     auto nextRecord =
-        (_firstGetNext && _seekKeyAccessor) ? _cursor->seekExact(_key) : _cursor->next();
+        (_firstGetNext && _seekKeyAccessor) ? _cursor->seekExact(_key) : advanceCursor();
     _firstGetNext = false;
 
     if (!nextRecord) {
@@ -272,6 +294,7 @@ PlanState ScanStage::getNext() {
 
 void ScanStage::close() {
     _commonStats.closes++;
+    _batch.clear();
     _cursor.reset();
     _coll.reset();
     _open = false;
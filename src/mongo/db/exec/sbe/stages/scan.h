@@ -73,6 +73,11 @@ protected:
     void doAttachToTrialRunTracker(TrialRunTracker* tracker) override;
 
 private:
+    /**
+     * Returns the next record from '_cursor', serving it from '_batch' when batching is enabled.
+     */
+    boost::optional<Record> advanceCursor();
+
     const NamespaceStringOrUUID _name;
     const boost::optional<value::SlotId> _recordSlot;
     const boost::optional<value::SlotId> _recordIdSlot;
@@ -102,6 +107,14 @@ private:
     RecordId _key;
     bool _firstGetNext{false};
 
+    // Records fetched from '_cursor' ahead of being returned, used by scans without a seek key.
+    // '_batchPos' is the index of the next record to return. The batch size starts at one on every
+    // open and doubles on every refill up to '_maxBatchSize'.
+    RecordBatch _batch;
+    size_t _batchPos{0};
+    size_t _batchSize{1};
+    size_t _maxBatchSize{1};
+
     ScanStats _specificStats;
 };
 
@@ -147,6 +147,21 @@ void SortStage::makeSorter() {
     _mergeIt.reset();
 }
 
+bool SortStage::sortsBefore(const value::MaterializedRow& cutoff) const {
+    for (size_t idx = 0; idx < _inKeyAccessors.size(); ++idx) {
+        auto [lhsTag, lhsVal] = _inKeyAccessors[idx]->getViewOfValue();
+        auto [rhsTag, rhsVal] = cutoff.getViewOfValue(idx);
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+        auto result = value::bitcastTo<int32_t>(val);
+        if (result) {
+            return (_dirs[idx] == value::SortDirection::Descending ? -result : result) < 0;
+        }
+    }
+
+    return false;
+}
+
 void SortStage::doDetachFromTrialRunTracker() {
     _tracker = nullptr;
 }
@@ -162,24 +177,30 @@ void SortStage::open(bool reOpen) {
     makeSorter();
 
     while (_children[0]->getNext() == PlanState::ADVANCED) {
-        value::MaterializedRow keys{_inKeyAccessors.size()};
-        value::MaterializedRow vals{_inValueAccessors.size()};
+        // For a top-k sort, compare the input keys in place against the worst key the sorter is
+        // keeping, and skip copying out rows which the sorter would discard anyway.
+        if (auto cutoff = _sorter->getCutoffKey(); cutoff && !sortsBefore(*cutoff)) {
+            _sorter->noteDiscarded();
+        } else {
+            value::MaterializedRow keys{_inKeyAccessors.size()};
+            value::MaterializedRow vals{_inValueAccessors.size()};
+
+            size_t idx = 0;
+            for (auto accesor : _inKeyAccessors) {
+                auto [tag, val] = accesor->copyOrMoveValue();
+                keys.reset(idx++, true, tag, val);
+            }
 
-        size_t idx = 0;
-        for (auto accesor : _inKeyAccessors) {
-            auto [tag, val] = accesor->copyOrMoveValue();
-            keys.reset(idx++, true, tag, val);
-        }
+            idx = 0;
+            for (auto accesor : _inValueAccessors) {
+                auto [tag, val] = accesor->copyOrMoveValue();
+                vals.reset(idx++, true, tag, val);
+            }
 
-        idx = 0;
-        for (auto accesor : _inValueAccessors) {
-            auto [tag, val] = accesor->copyOrMoveValue();
-            vals.reset(idx++, true, tag, val);
+            // TODO SERVER-51815: count total mem usage for specificStats.
+            _sorter->emplace(std::move(keys), std::move(vals));
         }
 
-        // TODO SERVER-51815: count total mem usage for specificStats.
-        _sorter->emplace(std::move(keys), std::move(vals));
-
         if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumResults>(1)) {
             // If we either hit the maximum number of document to return during the trial run, or
             // if we've performed enough physical reads, stop populating the sort heap and bail out
@@ -71,6 +71,11 @@ protected:
 private:
     void makeSorter();
 
+    /**
+     * Returns true if the current input row's sort key orders strictly before 'cutoff'.
+     */
+    bool sortsBefore(const value::MaterializedRow& cutoff) const;
+
     using SorterIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
     using SorterData = std::pair<value::MaterializedRow, value::MaterializedRow>;
 
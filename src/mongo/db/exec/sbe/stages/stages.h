@@ -278,7 +278,7 @@ public:
     }
 
 protected:
-    PlanYieldPolicy* const _yieldPolicy{nullptr};
+    PlanYieldPolicy* _yieldPolicy{nullptr};
 
 private:
     static const int kInterruptCheckPeriod = 128;
@@ -340,6 +340,21 @@ public:
      */
     virtual void close() = 0;
 
+    /**
+     * Replaces the yield policy of every stage in this tree which was constructed with one. This
+     * is used when the tree is a copy of an execution tree which was built for another operation,
+     * e.g. when it is instantiated from the SBE plan cache. Must be called before prepare().
+     */
+    void attachNewYieldPolicy(PlanYieldPolicy* yieldPolicy) {
+        for (auto&& child : _children) {
+            child->attachNewYieldPolicy(yieldPolicy);
+        }
+
+        if (_yieldPolicy) {
+            _yieldPolicy = yieldPolicy;
+        }
+    }
+
     virtual std::vector<DebugPrinter::Block> debugPrint() const {
         auto stats = getCommonStats();
         std::string str = str::stream() << '[' << stats->nodeId << "] " << stats->stageType;
@@ -70,12 +70,29 @@ void PcreRegex::_compile() {
     int eoffset;
     _pcrePtr = pcre_compile(_pattern.c_str(), pcreOptions, &compile_error, &eoffset, nullptr);
     _isValid = (_pcrePtr != nullptr);
+    if (_isValid) {
+        // A failed study only means that no extra data is available; the expression can still be
+        // executed without it.
+        const char* studyError;
+        _pcreExtraPtr = pcre_study(_pcrePtr, 0, &studyError);
+    }
+}
+
+void PcreRegex::_release() {
+    if (_pcreExtraPtr != nullptr) {
+        pcre_free_study(_pcreExtraPtr);
+        _pcreExtraPtr = nullptr;
+    }
+    if (_pcrePtr != nullptr) {
+        (*pcre_free)(_pcrePtr);
+        _pcrePtr = nullptr;
+    }
 }
 
 int PcreRegex::execute(std::string_view stringView, int startPos, std::vector<int>& buf) {
     invariant(_isValid);
     return pcre_exec(_pcrePtr,
-                     nullptr,
+                     _pcreExtraPtr,
                      stringView.data(),
                      stringView.length(),
                      startPos,
@@ -87,7 +104,7 @@ int PcreRegex::execute(std::string_view stringView, int startPos, std::vector<in
 size_t PcreRegex::getNumberCaptures() const {
     int numCaptures;
     invariant(_isValid);
-    pcre_fullinfo(_pcrePtr, nullptr, PCRE_INFO_CAPTURECOUNT, &numCaptures);
+    pcre_fullinfo(_pcrePtr, _pcreExtraPtr, PCRE_INFO_CAPTURECOUNT, &numCaptures);
     invariant(numCaptures >= 0);
     return static_cast<size_t>(numCaptures);
 }
@@ -542,14 +542,16 @@ private:
  * Implements a wrapper of PCRE regular expression.
  * Storing the pattern and the options allows for copying of the sbe::value::PcreRegex expression,
  * which includes recompilation.
- * The compiled expression pcre* allows for direct usage of the pcre C library functionality.
+ * The compiled expression pcre* allows for direct usage of the pcre C library functionality. The
+ * expression is studied once after compilation, so that every subsequent execution can use the
+ * start-of-match optimizations computed by pcre_study().
  */
 class PcreRegex {
 public:
     PcreRegex() = default;
 
     PcreRegex(std::string_view pattern, std::string_view options)
-        : _pattern(pattern), _options(options), _pcrePtr(nullptr) {
+        : _pattern(pattern), _options(options) {
         _compile();
     }
 
@@ -559,9 +561,7 @@ public:
 
     PcreRegex& operator=(const PcreRegex& other) {
         if (this != &other) {
-            if (_pcrePtr != nullptr) {
-                (*pcre_free)(_pcrePtr);
-            }
+            _release();
             _pattern = other._pattern;
             _options = other._options;
             _isValid = false;
@@ -571,9 +571,7 @@ public:
     }
 
     ~PcreRegex() {
-        if (_pcrePtr != nullptr) {
-            (*pcre_free)(_pcrePtr);
-        }
+        _release();
     }
 
     bool isValid() const {
@@ -605,11 +603,13 @@ public:
 
 private:
     void _compile();
+    void _release();
 
     std::string _pattern;
     std::string _options;
 
-    pcre* _pcrePtr;
+    pcre* _pcrePtr = nullptr;
+    pcre_extra* _pcreExtraPtr = nullptr;
     bool _isValid = false;
 };
 
@@ -0,0 +1,405 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+#include <algorithm>
+
+// SSE2 is part of the baseline x86_64 instruction set, so no runtime detection is needed.
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#define MONGO_SBE_VM_HAVE_SSE2
+#endif
+
+#include "mongo/platform/overflow_arithmetic.h"
+
+namespace mongo {
+namespace sbe {
+namespace vm {
+
+using namespace value;
+
+namespace {
+
+#ifdef MONGO_SBE_VM_HAVE_SSE2
+__m128i load(const Value* vals) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(vals));
+}
+
+void store(Value* vals, __m128i vec) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(vals), vec);
+}
+#endif
+
+/**
+ * The kernels of the batch arithmetic operations. The vector versions of the int64 operations, if
+ * any, also need to return which lanes overflowed: those with the sign bit set.
+ */
+struct BatchAddition {
+    static constexpr bool kHasInt64Vector = true;
+
+#ifdef MONGO_SBE_VM_HAVE_SSE2
+    static __m128d apply(__m128d lhs, __m128d rhs) {
+        return _mm_add_pd(lhs, rhs);
+    }
+    static __m128i apply(__m128i lhs, __m128i rhs) {
+        return _mm_add_epi64(lhs, rhs);
+    }
+    static __m128i overflowed(__m128i lhs, __m128i rhs, __m128i result) {
+        // The result has a different sign than both operands.
+        return _mm_and_si128(_mm_xor_si128(lhs, result), _mm_xor_si128(rhs, result));
+    }
+#endif
+
+    static double apply(double lhs, double rhs) {
+        return lhs + rhs;
+    }
+    static bool apply(int64_t lhs, int64_t rhs, int64_t* result) {
+        return overflow::add(lhs, rhs, result);
+    }
+};
+
+struct BatchSubtraction {
+    static constexpr bool kHasInt64Vector = true;
+
+#ifdef MONGO_SBE_VM_HAVE_SSE2
+    static __m128d apply(__m128d lhs, __m128d rhs) {
+        return _mm_sub_pd(lhs, rhs);
+    }
+    static __m128i apply(__m128i lhs, __m128i rhs) {
+        return _mm_sub_epi64(lhs, rhs);
+    }
+    static __m128i overflowed(__m128i lhs, __m128i rhs, __m128i result) {
+        // The operands have different signs, and the result has a different sign than 'lhs'.
+        return _mm_and_si128(_mm_xor_si128(lhs, rhs), _mm_xor_si128(lhs, result));
+    }
+#endif
+
+    static double apply(double lhs, double rhs) {
+        return lhs - rhs;
+    }
+    static bool apply(int64_t lhs, int64_t rhs, int64_t* result) {
+        return overflow::sub(lhs, rhs, result);
+    }
+};
+
+struct BatchMultiplication {
+    // SSE2 has no 64-bit integer multiplication.
+    static constexpr bool kHasInt64Vector = false;
+
+#ifdef MONGO_SBE_VM_HAVE_SSE2
+    static __m128d apply(__m128d lhs, __m128d rhs) {
+        return _mm_mul_pd(lhs, rhs);
+    }
+#endif
+
+    static double apply(double lhs, double rhs) {
+        return lhs * rhs;
+    }
+    static bool apply(int64_t lhs, int64_t rhs, int64_t* result) {
+        return overflow::mul(lhs, rhs, result);
+    }
+};
+
+/**
+ * The kernels of the batch comparisons. The vector versions return all ones in the lanes for
+ * which the comparison holds. Like their scalar counterparts, they are false for NaN, except for
+ * 'neq'.
+ */
+#ifdef MONGO_SBE_VM_HAVE_SSE2
+#define MONGO_SBE_VM_BATCH_COMPARISON(name, scalarOp, vectorOp) \
+    struct name {                                               \
+        using Scalar = scalarOp;                                \
+        static __m128d apply(__m128d lhs, __m128d rhs) {        \
+            return vectorOp(lhs, rhs);                          \
+        }                                                       \
+    };
+#else
+#define MONGO_SBE_VM_BATCH_COMPARISON(name, scalarOp, vectorOp) \
+    struct name {                                               \
+        using Scalar = scalarOp;                                \
+    };
+#endif
+
+MONGO_SBE_VM_BATCH_COMPARISON(BatchLess, std::less<>, _mm_cmplt_pd)
+MONGO_SBE_VM_BATCH_COMPARISON(BatchLessEq, std::less_equal<>, _mm_cmple_pd)
+MONGO_SBE_VM_BATCH_COMPARISON(BatchGreater, std::greater<>, _mm_cmpgt_pd)
+MONGO_SBE_VM_BATCH_COMPARISON(BatchGreaterEq, std::greater_equal<>, _mm_cmpge_pd)
+MONGO_SBE_VM_BATCH_COMPARISON(BatchEq, std::equal_to<>, _mm_cmpeq_pd)
+MONGO_SBE_VM_BATCH_COMPARISON(BatchNeq, std::not_equal_to<>, _mm_cmpneq_pd)
+
+#undef MONGO_SBE_VM_BATCH_COMPARISON
+
+bool bothOfType(const ValueColumn& lhs, const ValueColumn& rhs, TypeTags tag) {
+    return lhs.allOfType(tag) && rhs.allOfType(tag);
+}
+
+/**
+ * Applies 'op', which returns an (owned, tag, value) tuple, to each pair of values.
+ */
+template <typename Op>
+void genericBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out, Op op) {
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        auto [owned, tag, val] = op(lhs.tag(i), lhs.val(i), rhs.tag(i), rhs.val(i));
+        out->set(i, owned, tag, val);
+    }
+}
+
+template <typename Op>
+void doubleArithmeticBatch(const Value* lhs, const Value* rhs, Value* out, size_t size) {
+    size_t i = 0;
+#ifdef MONGO_SBE_VM_HAVE_SSE2
+    for (; i + 2 <= size; i += 2) {
+        auto result = Op::apply(_mm_castsi128_pd(load(lhs + i)), _mm_castsi128_pd(load(rhs + i)));
+        store(out + i, _mm_castpd_si128(result));
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] =
+            bitcastFrom<double>(Op::apply(bitcastTo<double>(lhs[i]), bitcastTo<double>(rhs[i])));
+    }
+}
+
+/**
+ * Returns the positions of the results that overflowed, which are left unset in 'out'.
+ */
+template <typename Op>
+std::vector<size_t> int64ArithmeticBatch(const Value* lhs,
+                                         const Value* rhs,
+                                         Value* out,
+                                         size_t size) {
+    std::vector<size_t> overflowed;
+    size_t i = 0;
+#ifdef MONGO_SBE_VM_HAVE_SSE2
+    if constexpr (Op::kHasInt64Vector) {
+        for (; i + 2 <= size; i += 2) {
+            auto lhsVec = load(lhs + i);
+            auto rhsVec = load(rhs + i);
+            auto result = Op::apply(lhsVec, rhsVec);
+            store(out + i, result);
+            if (auto mask = _mm_movemask_pd(
+                    _mm_castsi128_pd(Op::overflowed(lhsVec, rhsVec, result)))) {
+                if (mask & 1) {
+                    overflowed.push_back(i);
+                }
+                if (mask & 2) {
+                    overflowed.push_back(i + 1);
+                }
+            }
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        int64_t result;
+        if (Op::apply(bitcastTo<int64_t>(lhs[i]), bitcastTo<int64_t>(rhs[i]), &result)) {
+            overflowed.push_back(i);
+        } else {
+            out[i] = bitcastFrom<int64_t>(result);
+        }
+    }
+    return overflowed;
+}
+
+/**
+ * Runs the batch arithmetic operation 'Op', falling back to 'genericOp', the implementation of the
+ * matching instruction, for anything the kernels cannot handle.
+ */
+template <typename Op, typename GenericOp>
+void arithmeticBatch(const ValueColumn& lhs,
+                     const ValueColumn& rhs,
+                     ValueColumn* out,
+                     GenericOp genericOp) {
+    invariant(lhs.size() == rhs.size());
+    const auto size = lhs.size();
+    out->resize(size);
+
+    if (bothOfType(lhs, rhs, TypeTags::NumberDouble)) {
+        doubleArithmeticBatch<Op>(lhs.vals(), rhs.vals(), out->vals(), size);
+        std::fill_n(out->tags(), size, TypeTags::NumberDouble);
+    } else if (bothOfType(lhs, rhs, TypeTags::NumberInt64)) {
+        auto overflowed = int64ArithmeticBatch<Op>(lhs.vals(), rhs.vals(), out->vals(), size);
+        std::fill_n(out->tags(), size, TypeTags::NumberInt64);
+        // The generic operation widens the results that do not fit into an int64.
+        for (auto i : overflowed) {
+            auto [owned, tag, val] = genericOp(lhs.tag(i), lhs.val(i), rhs.tag(i), rhs.val(i));
+            out->set(i, owned, tag, val);
+        }
+    } else {
+        genericBatch(lhs, rhs, out, genericOp);
+    }
+}
+
+template <typename Op>
+void doubleCompareBatch(const Value* lhs, const Value* rhs, Value* out, size_t size) {
+    size_t i = 0;
+#ifdef MONGO_SBE_VM_HAVE_SSE2
+    for (; i + 2 <= size; i += 2) {
+        auto mask = Op::apply(_mm_castsi128_pd(load(lhs + i)), _mm_castsi128_pd(load(rhs + i)));
+        // Turn the all ones lanes into true.
+        store(out + i, _mm_srli_epi64(_mm_castpd_si128(mask), 63));
+    }
+#endif
+    for (; i < size; ++i) {
+        out[i] = bitcastFrom<bool>(
+            typename Op::Scalar{}(bitcastTo<double>(lhs[i]), bitcastTo<double>(rhs[i])));
+    }
+}
+
+template <typename Op>
+void int64CompareBatch(const Value* lhs, const Value* rhs, Value* out, size_t size) {
+    // SSE2 has no 64-bit integer comparisons, but this loop is simple enough for the compiler to
+    // vectorize when it targets an instruction set that does.
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = bitcastFrom<bool>(
+            typename Op::Scalar{}(bitcastTo<int64_t>(lhs[i]), bitcastTo<int64_t>(rhs[i])));
+    }
+}
+
+template <typename Op, typename GenericOp>
+void compareBatch(const ValueColumn& lhs,
+                  const ValueColumn& rhs,
+                  ValueColumn* out,
+                  GenericOp genericOp) {
+    invariant(lhs.size() == rhs.size());
+    const auto size = lhs.size();
+    out->resize(size);
+
+    if (bothOfType(lhs, rhs, TypeTags::NumberDouble)) {
+        doubleCompareBatch<Op>(lhs.vals(), rhs.vals(), out->vals(), size);
+        std::fill_n(out->tags(), size, TypeTags::Boolean);
+    } else if (bothOfType(lhs, rhs, TypeTags::NumberInt64)) {
+        int64CompareBatch<Op>(lhs.vals(), rhs.vals(), out->vals(), size);
+        std::fill_n(out->tags(), size, TypeTags::Boolean);
+    } else {
+        genericBatch(lhs, rhs, out, [&](auto... args) {
+            auto [tag, val] = genericOp(args...);
+            return std::make_tuple(false, tag, val);
+        });
+    }
+}
+}  // namespace
+
+void ValueColumn::set(size_t idx, bool owned, value::TypeTags tag, value::Value val) {
+    if (_owned[idx]) {
+        value::releaseValue(_tags[idx], _vals[idx]);
+    }
+    _owned[idx] = owned;
+    _tags[idx] = tag;
+    _vals[idx] = val;
+}
+
+void ValueColumn::resize(size_t size) {
+    for (size_t i = 0; i < _owned.size(); ++i) {
+        if (_owned[i]) {
+            value::releaseValue(_tags[i], _vals[i]);
+        }
+    }
+    _owned.assign(size, false);
+    _tags.assign(size, value::TypeTags::Nothing);
+    _vals.assign(size, 0);
+}
+
+bool ValueColumn::allOfType(value::TypeTags tag) const {
+    return std::all_of(_tags.begin(), _tags.end(), [tag](auto t) { return t == tag; });
+}
+
+void ByteCode::addBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    arithmeticBatch<BatchAddition>(lhs, rhs, out, [this](auto... args) {
+        return genericAdd(args...);
+    });
+}
+
+void ByteCode::subBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    arithmeticBatch<BatchSubtraction>(lhs, rhs, out, [this](auto... args) {
+        return genericSub(args...);
+    });
+}
+
+void ByteCode::mulBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    arithmeticBatch<BatchMultiplication>(lhs, rhs, out, [this](auto... args) {
+        return genericMul(args...);
+    });
+}
+
+void ByteCode::lessBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    compareBatch<BatchLess>(lhs, rhs, out, [this](auto... args) {
+        return genericCompare<std::less<>>(args...);
+    });
+}
+
+void ByteCode::lessEqBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    compareBatch<BatchLessEq>(lhs, rhs, out, [this](auto... args) {
+        return genericCompare<std::less_equal<>>(args...);
+    });
+}
+
+void ByteCode::greaterBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    compareBatch<BatchGreater>(lhs, rhs, out, [this](auto... args) {
+        return genericCompare<std::greater<>>(args...);
+    });
+}
+
+void ByteCode::greaterEqBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    compareBatch<BatchGreaterEq>(lhs, rhs, out, [this](auto... args) {
+        return genericCompare<std::greater_equal<>>(args...);
+    });
+}
+
+void ByteCode::eqBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    compareBatch<BatchEq>(lhs, rhs, out, [this](auto... args) {
+        return genericCompareEq(args...);
+    });
+}
+
+void ByteCode::neqBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    compareBatch<BatchNeq>(lhs, rhs, out, [this](auto... args) {
+        return genericCompareNeq(args...);
+    });
+}
+
+void ByteCode::fillEmptyBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out) {
+    invariant(lhs.size() == rhs.size());
+    const auto size = lhs.size();
+    out->resize(size);
+
+    for (size_t i = 0; i < size; ++i) {
+        const auto& column = lhs.tag(i) == TypeTags::Nothing ? rhs : lhs;
+        if (column.owned(i)) {
+            // The input keeps its value, so the result needs its own copy.
+            auto [tag, val] = copyValue(column.tag(i), column.val(i));
+            out->set(i, true, tag, val);
+        } else {
+            out->set(i, false, column.tag(i), column.val(i));
+        }
+    }
+}
+}  // namespace vm
+}  // namespace sbe
+}  // namespace mongo
@@ -90,6 +90,7 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
     -1,  // fillEmpty
 
     -1,  // getField
+    0,   // getFieldImm
     -1,  // getElement
 
     -1,  // sum
@@ -277,6 +278,27 @@ void CodeFragment::appendGetField() {
     appendSimpleInstruction(Instruction::getField);
 }
 
+void CodeFragment::appendGetField(std::string_view fieldName) {
+    // Longer names are rare enough that they keep pushing the name as a constant.
+    if (fieldName.size() > std::numeric_limits<uint8_t>::max()) {
+        auto [tag, val] = value::makeNewString(fieldName);
+        appendConstVal(tag, val);
+        appendGetField();
+        return;
+    }
+
+    Instruction i;
+    i.tag = Instruction::getFieldImm;
+    adjustStackSimple(i);
+
+    auto size = static_cast<uint8_t>(fieldName.size());
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(size) + size);
+
+    offset += value::writeToMemory(offset, i);
+    offset += value::writeToMemory(offset, size);
+    std::copy(fieldName.begin(), fieldName.end(), offset);
+}
+
 void CodeFragment::appendGetElement() {
     appendSimpleInstruction(Instruction::getElement);
 }
@@ -424,7 +446,12 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTa
     }
 
     auto fieldStr = value::getStringView(fieldTag, fieldValue);
+    return getField(objTag, objValue, fieldStr);
+}
 
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTags objTag,
+                                                                   value::Value objValue,
+                                                                   std::string_view fieldStr) {
     if (MONGO_unlikely(failOnPoisonedFieldLookup.shouldFail())) {
         uassert(4623399, "Lookup of $POISON", fieldStr != "POISON");
     }
@@ -580,12 +607,14 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::aggMin(value::TypeTags
         return {true, tag, val};
     }
 
-    auto [tag, val] = genericCompare<std::less<>>(accTag, accValue, fieldTag, fieldValue);
-    if (tag == value::TypeTags::Boolean && value::bitcastTo<bool>(val)) {
-        auto [tag, val] = value::copyValue(accTag, accValue);
+    // Values of different types are compared in the canonical BSON type order. Like the $min
+    // accumulator of the aggregation framework, keep the first of several equal values.
+    auto [tag, val] = value::compareValue(fieldTag, fieldValue, accTag, accValue);
+    if (tag == value::TypeTags::NumberInt32 && value::bitcastTo<int32_t>(val) < 0) {
+        auto [tag, val] = value::copyValue(fieldTag, fieldValue);
         return {true, tag, val};
     } else {
-        auto [tag, val] = value::copyValue(fieldTag, fieldValue);
+        auto [tag, val] = value::copyValue(accTag, accValue);
         return {true, tag, val};
     }
 }
@@ -606,12 +635,14 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::aggMax(value::TypeTags
         return {true, tag, val};
     }
 
-    auto [tag, val] = genericCompare<std::greater<>>(accTag, accValue, fieldTag, fieldValue);
-    if (tag == value::TypeTags::Boolean && value::bitcastTo<bool>(val)) {
-        auto [tag, val] = value::copyValue(accTag, accValue);
+    // Values of different types are compared in the canonical BSON type order. Like the $max
+    // accumulator of the aggregation framework, keep the first of several equal values.
+    auto [tag, val] = value::compareValue(fieldTag, fieldValue, accTag, accValue);
+    if (tag == value::TypeTags::NumberInt32 && value::bitcastTo<int32_t>(val) > 0) {
+        auto [tag, val] = value::copyValue(fieldTag, fieldValue);
         return {true, tag, val};
     } else {
-        auto [tag, val] = value::copyValue(fieldTag, fieldValue);
+        auto [tag, val] = value::copyValue(accTag, accValue);
         return {true, tag, val};
     }
 }
@@ -2979,6 +3010,23 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     }
                     break;
                 }
+                case Instruction::getFieldImm: {
+                    auto size = value::readFromMemory<uint8_t>(pcPointer);
+                    pcPointer += sizeof(size);
+                    std::string_view fieldName{reinterpret_cast<const char*>(pcPointer), size};
+                    pcPointer += size;
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(lhsTag, lhsVal, fieldName);
+
+                    topStack(owned, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    break;
+                }
                 case Instruction::getElement: {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
@@ -146,6 +146,7 @@ struct Instruction {
         fillEmpty,
 
         getField,
+        getFieldImm,  // field name is stored inline, right after the instruction
         getElement,
 
         aggSum,
@@ -315,6 +316,7 @@ public:
         appendSimpleInstruction(Instruction::fillEmpty);
     }
     void appendGetField();
+    void appendGetField(std::string_view fieldName);
     void appendGetElement();
     void appendSum();
     void appendMin();
@@ -377,6 +379,86 @@ private:
     size_t _stackSize{0};
 };
 
+/**
+ * A column of values, such as the values of one slot over a batch of rows, for the batch versions
+ * of the VM instructions to operate on. The column releases the values it owns when it is resized,
+ * cleared, or destroyed.
+ */
+class ValueColumn {
+public:
+    ValueColumn() = default;
+    ValueColumn(const ValueColumn&) = delete;
+    ValueColumn& operator=(const ValueColumn&) = delete;
+
+    ~ValueColumn() {
+        clear();
+    }
+
+    size_t size() const {
+        return _tags.size();
+    }
+
+    value::TypeTags tag(size_t idx) const {
+        return _tags[idx];
+    }
+    value::Value val(size_t idx) const {
+        return _vals[idx];
+    }
+    bool owned(size_t idx) const {
+        return _owned[idx];
+    }
+
+    /**
+     * The type tags and values of the column. Writing through these does not change which values
+     * the column owns, so they must only be used to store values that need no releasing.
+     */
+    value::TypeTags* tags() {
+        return _tags.data();
+    }
+    const value::TypeTags* tags() const {
+        return _tags.data();
+    }
+    value::Value* vals() {
+        return _vals.data();
+    }
+    const value::Value* vals() const {
+        return _vals.data();
+    }
+
+    /**
+     * Appends a value to the column, which takes ownership of it if 'owned' is true.
+     */
+    void push_back(bool owned, value::TypeTags tag, value::Value val) {
+        _owned.push_back(owned);
+        _tags.push_back(tag);
+        _vals.push_back(val);
+    }
+
+    /**
+     * Replaces the value at position 'idx', which the column takes ownership of if 'owned' is true.
+     */
+    void set(size_t idx, bool owned, value::TypeTags tag, value::Value val);
+
+    /**
+     * Releases all values and resets the column to 'size' Nothing values.
+     */
+    void resize(size_t size);
+
+    void clear() {
+        resize(0);
+    }
+
+    /**
+     * Returns whether every value in the column has the type 'tag'.
+     */
+    bool allOfType(value::TypeTags tag) const;
+
+private:
+    std::vector<uint8_t> _owned;
+    std::vector<value::TypeTags> _tags;
+    std::vector<value::Value> _vals;
+};
+
 class ByteCode {
 public:
     ~ByteCode();
@@ -384,6 +466,24 @@ public:
     std::tuple<uint8_t, value::TypeTags, value::Value> run(const CodeFragment* code);
     bool runPredicate(const CodeFragment* code);
 
+    /**
+     * Batch versions of the add, sub, mul, comparison and fillEmpty instructions. Each one applies
+     * the instruction to the values at the same position in 'lhs' and 'rhs', which must have the
+     * same size, and stores the results in 'out'. When both columns hold only NumberDouble or only
+     * NumberInt64 values, several results are computed at a time using vector instructions where
+     * the platform has them. Any other column is processed one value at a time.
+     */
+    void addBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void subBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void mulBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void lessBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void lessEqBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void greaterBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void greaterEqBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void eqBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void neqBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+    void fillEmptyBatch(const ValueColumn& lhs, const ValueColumn& rhs, ValueColumn* out);
+
 private:
     std::vector<uint8_t> _argStackOwned;
     std::vector<value::TypeTags> _argStackTags;
@@ -469,6 +569,10 @@ private:
                                                              value::TypeTags fieldTag,
                                                              value::Value fieldValue);
 
+    std::tuple<bool, value::TypeTags, value::Value> getField(value::TypeTags objTag,
+                                                             value::Value objValue,
+                                                             std::string_view fieldStr);
+
     std::tuple<bool, value::TypeTags, value::Value> getElement(value::TypeTags objTag,
                                                                value::Value objValue,
                                                                value::TypeTags fieldTag,
@@ -30,9 +30,28 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/scoped_timer.h"
+
+#if defined(__linux__)
+#include <time.h>
+#endif  // defined(__linux__)
+
 #include "mongo/util/clock_source.h"
 
 namespace mongo {
+namespace {
+
+// Returns the CPU time consumed by the current thread in nanoseconds, or -1 if it is unavailable.
+long long threadCpuNanos() {
+#if defined(__linux__)
+    struct timespec t;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0) {
+        return durationCount<Nanoseconds>(Seconds(t.tv_sec) + Nanoseconds(t.tv_nsec));
+    }
+#endif  // defined(__linux__)
+    return -1;
+}
+
+}  // namespace
 
 ScopedTimer::ScopedTimer(ClockSource* cs, long long* counter)
     : _clock(cs), _counter(counter), _start(cs->now()) {}
@@ -42,4 +61,25 @@ ScopedTimer::~ScopedTimer() {
     *_counter += elapsed;
 }
 
+bool ScopedThreadCpuTimer::isSupported() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif  // defined(__linux__)
+}
+
+ScopedThreadCpuTimer::ScopedThreadCpuTimer(long long* counterNanos)
+    : _counterNanos(counterNanos), _startNanos(threadCpuNanos()) {}
+
+ScopedThreadCpuTimer::~ScopedThreadCpuTimer() {
+    if (_startNanos < 0) {
+        return;
+    }
+    const long long endNanos = threadCpuNanos();
+    if (endNanos >= _startNanos) {
+        *_counterNanos += endNanos - _startNanos;
+    }
+}
+
 }  // namespace mongo
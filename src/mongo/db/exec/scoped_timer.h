@@ -59,4 +59,31 @@ private:
     const Date_t _start;
 };
 
+/**
+ * This class increments a counter by the CPU time, in nanoseconds, consumed by the current thread
+ * since its construction when it goes out of scope. The counter is left unchanged on platforms
+ * without a per-thread CPU clock.
+ */
+class ScopedThreadCpuTimer {
+    ScopedThreadCpuTimer(const ScopedThreadCpuTimer&) = delete;
+    ScopedThreadCpuTimer& operator=(const ScopedThreadCpuTimer&) = delete;
+
+public:
+    /**
+     * Returns true if this platform can measure the CPU time consumed by a thread.
+     */
+    static bool isSupported();
+
+    explicit ScopedThreadCpuTimer(long long* counterNanos);
+
+    ~ScopedThreadCpuTimer();
+
+private:
+    // Reference to the counter that we are incrementing with the consumed CPU time.
+    long long* _counterNanos;
+
+    // CPU time consumed by the thread when the timer was constructed, or -1 if it is unknown.
+    const long long _startNanos;
+};
+
 }  // namespace mongo
@@ -116,8 +116,13 @@ SortStageDefault::SortStageDefault(boost::intrusive_ptr<ExpressionContext> expCt
                     expCtx->allowDiskUse) {}
 
 void SortStageDefault::spool(WorkingSetID wsid) {
+    auto sortKey = _sortKeyGen.computeSortKey(*_ws->get(wsid));
+    if (_sortExecutor.tryDiscard(sortKey)) {
+        _ws->free(wsid);
+        return;
+    }
+
     SortableWorkingSetMember extractedMember{_ws->extract(wsid)};
-    auto sortKey = _sortKeyGen.computeSortKey(*extractedMember);
     _sortExecutor.add(sortKey, extractedMember);
 }
 
@@ -159,7 +164,10 @@ void SortStageSimple::spool(WorkingSetID wsid) {
 
     auto sortKey = _sortKeyGen.computeSortKeyFromDocument(member->doc.value());
 
-    _sortExecutor.add(std::move(sortKey), member->doc.value().toBson());
+    // Avoid serializing documents which cannot make it into the top-k results.
+    if (!_sortExecutor.tryDiscard(sortKey)) {
+        _sortExecutor.add(std::move(sortKey), member->doc.value().toBson());
+    }
     _ws->free(wsid);
 }
 
@@ -73,6 +73,7 @@ public:
                  std::string tempDir,
                  bool allowDiskUse)
         : _sortPattern(std::move(sortPattern)),
+          _sortKeyComparator(_sortPattern),
           _tempDir(std::move(tempDir)),
           _diskUseAllowed(allowDiskUse) {
         _stats.sortPattern =
@@ -131,6 +132,25 @@ public:
         _stats.totalDataSizeBytes += data.memUsageForSorter();
     }
 
+    /**
+     * For a top-k sort, returns true if a data item with 'sortKey' would be discarded by add()
+     * because enough items which sort before it have been added already. The item is then
+     * counted as sorted, and the caller should drop it without materializing it for add().
+     */
+    bool tryDiscard(const Value& sortKey) {
+        if (!_sorter) {
+            return false;
+        }
+
+        auto cutoff = _sorter->getCutoffKey();
+        if (!cutoff || _sortKeyComparator(sortKey, *cutoff) < 0) {
+            return false;
+        }
+
+        _sorter->noteDiscarded();
+        return true;
+    }
+
     /**
      * Signals to the sort executor that there will be no more input documents.
      */
@@ -189,6 +209,7 @@ private:
     }
 
     const SortPattern _sortPattern;
+    const SortKeyComparator _sortKeyComparator;
     const std::string _tempDir;
     const bool _diskUseAllowed;
 
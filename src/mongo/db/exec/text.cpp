@@ -123,8 +123,20 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
     if (wantTextScore) {
         // We use a TEXT_OR stage to get the union of the results from the index scans and then
         // compute their text scores. This is a blocking operation.
-        auto textScorer =
-            std::make_unique<TextOrStage>(expCtx(), _params.spec, ws, filter, collection);
+        // The TEXT_OR stage can stop after the best-scoring results only if the TEXT_MATCH stage
+        // will not reject any of them, which is the case when every document found through the
+        // index for a positive term is a match.
+        const auto& query = _params.query;
+        const bool everyCandidateMatches = query.getPositivePhr().empty() &&
+            query.getNegatedTerms().empty() && query.getNegatedPhr().empty() &&
+            !query.getCaseSensitive() && !query.getDiacriticSensitive();
+        auto textScorer = std::make_unique<TextOrStage>(expCtx(),
+                                                        _params.spec,
+                                                        ws,
+                                                        filter,
+                                                        collection,
+                                                        everyCandidateMatches ? _params.scoreLimit
+                                                                              : 0);
 
         textScorer->addChildren(std::move(indexScanList));
 
@@ -64,6 +64,10 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // If non-zero, only this many results with the best text scores are needed, as when the
+    // results are sorted by text score alone and then limited.
+    size_t scoreLimit = 0;
 };
 
 /**
@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -56,11 +57,13 @@ TextOrStage::TextOrStage(ExpressionContext* expCtx,
                          const FTSSpec& ftsSpec,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         const CollectionPtr& collection)
+                         const CollectionPtr& collection,
+                         size_t scoreLimit)
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ftsSpec(ftsSpec),
       _ws(ws),
       _scoreIterator(_scores.end()),
+      _scoreLimit(scoreLimit),
       _filter(filter),
       _idRetrying(WorkingSet::INVALID_ID) {}
 
@@ -138,7 +141,7 @@ PlanStage::StageState TextOrStage::doWork(WorkingSetID* out) {
             stageState = readFromChildren(out);
             break;
         case State::kReturningResults:
-            stageState = returnResults(out);
+            stageState = _scoreLimit ? returnTopResults(out) : returnResults(out);
             break;
         case State::kDone:
             // Should have been handled above.
@@ -196,6 +199,15 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
         _scoreIterator = _scores.begin();
         _internalState = State::kReturningResults;
 
+        if (_scoreLimit) {
+            for (const auto& [recordId, textRecordData] : _scores) {
+                if (textRecordData.score >= 0) {
+                    _topCandidates.emplace_back(textRecordData.score, recordId);
+                }
+            }
+            std::make_heap(_topCandidates.begin(), _topCandidates.end());
+        }
+
         return PlanStage::NEED_TIME;
     } else {
         // Propagate WSID from below.
@@ -228,6 +240,49 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState TextOrStage::returnTopResults(WorkingSetID* out) {
+    WorkingSetID wsid = _idRetrying;
+    _idRetrying = WorkingSet::INVALID_ID;
+
+    if (wsid == WorkingSet::INVALID_ID) {
+        if (_numReturned == _scoreLimit || _topCandidates.empty()) {
+            _internalState = State::kDone;
+            return PlanStage::IS_EOF;
+        }
+
+        std::pop_heap(_topCandidates.begin(), _topCandidates.end());
+        const RecordId recordId = _topCandidates.back().second;
+        _topCandidates.pop_back();
+
+        // Rebuild the member as the index scan produced it, so that fetching checks the key it
+        // was scored from against the current document.
+        wsid = _ws->allocate();
+        WorkingSetMember* wsm = _ws->get(wsid);
+        wsm->recordId = recordId;
+        wsm->keyData.push_back(std::move(*_scores[recordId].keyDatum));
+        _ws->transitionToRecordIdAndIdx(wsid);
+    }
+
+    WorkingSetMember* wsm = _ws->get(wsid);
+    try {
+        if (!WorkingSetCommon::fetch(opCtx(), _ws, wsid, _recordCursor, collection()->ns())) {
+            _ws->free(wsid);
+            return PlanStage::NEED_TIME;
+        }
+        ++_specificStats.fetches;
+    } catch (const WriteConflictException&) {
+        _idRetrying = wsid;
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    wsm->makeObjOwnedIfNeeded();
+    wsm->metadata().setTextScore(_scores[wsm->recordId].score);
+    ++_numReturned;
+    *out = wsid;
+    return PlanStage::ADVANCED;
+}
+
 PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out) {
     WorkingSetMember* wsm = _ws->get(wsid);
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
@@ -242,7 +297,7 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         return NEED_TIME;
     }
 
-    if (WorkingSet::INVALID_ID == textRecordData->wsid) {
+    if (WorkingSet::INVALID_ID == textRecordData->wsid && !textRecordData->keyDatum) {
         // We haven't seen this RecordId before.
         invariant(textRecordData->score == 0);
 
@@ -252,34 +307,41 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
             return NEED_TIME;
         }
 
-        // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
-        // already.
-        try {
-            if (!WorkingSetCommon::fetch(opCtx(), _ws, wsid, _recordCursor, collection()->ns())) {
-                _ws->free(wsid);
-                textRecordData->score = -1;
-                return NEED_TIME;
+        if (_scoreLimit) {
+            // Only the best-scoring candidates will be fetched, once all scores are known.
+            textRecordData->keyDatum.emplace(newKeyData);
+            textRecordData->keyDatum->keyData = newKeyData.keyData.getOwned();
+            _ws->free(wsid);
+        } else {
+            // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
+            // already.
+            try {
+                if (!WorkingSetCommon::fetch(
+                        opCtx(), _ws, wsid, _recordCursor, collection()->ns())) {
+                    _ws->free(wsid);
+                    textRecordData->score = -1;
+                    return NEED_TIME;
+                }
+                ++_specificStats.fetches;
+            } catch (const WriteConflictException&) {
+                wsm->makeObjOwnedIfNeeded();
+                _idRetrying = wsid;
+                *out = WorkingSet::INVALID_ID;
+                return NEED_YIELD;
             }
-            ++_specificStats.fetches;
-        } catch (const WriteConflictException&) {
-            wsm->makeObjOwnedIfNeeded();
-            _idRetrying = wsid;
-            *out = WorkingSet::INVALID_ID;
-            return NEED_YIELD;
-        }
 
-        textRecordData->wsid = wsid;
+            textRecordData->wsid = wsid;
 
-        // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
-        wsm->makeObjOwnedIfNeeded();
+            // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
+            wsm->makeObjOwnedIfNeeded();
+        }
     } else {
-        // We already have a working set member for this RecordId. Free the new WSM and retrieve the
-        // old one. Note that since we don't keep all index keys, we could get a score that doesn't
-        // match the document, but this has always been a problem.
+        // We have already seen this RecordId, so free the new WSM. Note that since we don't keep
+        // all index keys, we could get a score that doesn't match the document, but this has
+        // always been a problem.
         // TODO something to improve the situation.
         invariant(wsid != textRecordData->wsid);
         _ws->free(wsid);
-        wsm = _ws->get(textRecordData->wsid);
     }
 
     // Locate score within possibly compound key: {prefix,term,score,suffix}.
@@ -29,9 +29,13 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/exec/working_set.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
@@ -67,11 +71,18 @@ public:
         kDone,
     };
 
+    /**
+     * A non-zero 'scoreLimit' promises that our parent only keeps the 'scoreLimit' best-scoring
+     * results, and that every document containing a query term is a match. Documents are then not
+     * fetched while the terms are read; only the best-scoring candidates are fetched, in descending
+     * score order, until 'scoreLimit' of them have been returned.
+     */
     TextOrStage(ExpressionContext* expCtx,
                 const FTSSpec& ftsSpec,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                const CollectionPtr& collection);
+                const CollectionPtr& collection,
+                size_t scoreLimit = 0);
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -123,6 +134,12 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Worker for kReturningResults when '_scoreLimit' is set. Fetches the best remaining candidate
+     * and returns it, until '_scoreLimit' results have been returned.
+     */
+    StageState returnTopResults(WorkingSetID* out);
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -144,12 +161,24 @@ private:
         TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0) {}
         WorkingSetID wsid;
         double score;
+
+        // When '_scoreLimit' is set, the document is not fetched and 'wsid' stays invalid. The
+        // first index key seen for it is kept instead, so that it can be checked against the
+        // document once that is fetched.
+        boost::optional<IndexKeyDatum> keyDatum;
     };
 
     typedef stdx::unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    // See the constructor. Zero if every match must be returned.
+    const size_t _scoreLimit;
+    size_t _numReturned = 0;
+
+    // When '_scoreLimit' is set, a max-heap by score of the candidates not yet returned.
+    std::vector<std::pair<double, RecordId>> _topCandidates;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
@@ -174,8 +174,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // Documents coming directly from users should be validated for storage. It is safe to
         // access the CollectionShardingState in this write context and to throw SSV if the sharding
         // metadata has not been initialized.
-        const auto collDesc = CollectionShardingState::get(opCtx(), collection()->ns())
-                                  ->getCollectionDescription(opCtx());
+        const auto& collDesc = _getCollectionDescription();
         if (collDesc.isSharded() && !OperationShardingState::isOperationVersioned(opCtx())) {
             immutablePaths.fillFrom(collDesc.getKeyPatternFields());
         }
@@ -249,9 +248,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
             args.stmtId = request->getStmtId();
             args.update = logObj;
             if (_isUserInitiatedWrite) {
-                args.criteria = CollectionShardingState::get(opCtx(), collection()->ns())
-                                    ->getCollectionDescription(opCtx())
-                                    .extractDocumentKey(newObj);
+                args.criteria = _getCollectionDescription().extractDocumentKey(newObj);
             } else {
                 const auto docId = newObj[idFieldName];
                 args.criteria = docId ? docId.wrap() : newObj;
@@ -267,6 +264,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         }
 
         if (inPlace) {
+            _specificStats.nModifiedInPlace++;
             if (!request->explain()) {
                 newObj = oldObj.value();
                 const RecordData oldRec(oldObj.value().objdata(), oldObj.value().objsize());
@@ -550,6 +548,17 @@ void UpdateStage::doRestoreStateRequiresCollection() {
     // date index information.
     const auto& updateIndexData = CollectionQueryInfo::get(collection()).getIndexKeys(opCtx());
     _params.driver->refreshIndexKeys(&updateIndexData);
+
+    // The filtering metadata may have been refreshed while the collection lock was released.
+    _collDesc.reset();
+}
+
+const ScopedCollectionDescription& UpdateStage::_getCollectionDescription() {
+    if (!_collDesc) {
+        _collDesc.emplace(CollectionShardingState::get(opCtx(), collection()->ns())
+                              ->getCollectionDescription(opCtx()));
+    }
+    return *_collDesc;
 }
 
 unique_ptr<PlanStageStats> UpdateStage::getStats() {
@@ -603,8 +612,7 @@ bool UpdateStage::wasReshardingKeyUpdated(const ScopedCollectionDescription& col
 
 bool UpdateStage::checkUpdateChangesShardKeyFields(const boost::optional<BSONObj>& newObjCopy,
                                                    const Snapshotted<BSONObj>& oldObj) {
-    auto* const css = CollectionShardingState::get(opCtx(), collection()->ns());
-    const auto collDesc = css->getCollectionDescription(opCtx());
+    const auto& collDesc = _getCollectionDescription();
 
     // Calling mutablebson::Document::getObject() renders a full copy of the updated document. This
     // can be expensive for larger documents, so we skip calling it when the collection isn't even
@@ -614,6 +622,7 @@ bool UpdateStage::checkUpdateChangesShardKeyFields(const boost::optional<BSONObj
     }
 
     const auto& newObj = newObjCopy ? *newObjCopy : _doc.getObject();
+    auto* const css = CollectionShardingState::get(opCtx(), collection()->ns());
     return wasExistingShardKeyUpdated(css, collDesc, newObj, oldObj) ||
         wasReshardingKeyUpdated(collDesc, newObj, oldObj);
 }
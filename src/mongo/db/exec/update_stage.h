@@ -110,6 +110,13 @@ protected:
 
     void doRestoreStateRequiresCollection() final;
 
+    /**
+     * Returns the sharding description of the collection being updated. It is looked up on first
+     * use and then shared by every document updated before the next yield, since the filtering
+     * metadata cannot change while the collection lock is held.
+     */
+    const ScopedCollectionDescription& _getCollectionDescription();
+
     void _ensureIdFieldIsFirst(mutablebson::Document* doc, bool generateOIDIfMissing);
 
     void _assertPathsNotArray(const mutablebson::Document& document, const FieldRefSet& paths);
@@ -195,6 +202,9 @@ private:
     // So, no matter what, we keep track of where the doc wound up.
     typedef stdx::unordered_set<RecordId, RecordId::Hasher> RecordIdSet;
     const std::unique_ptr<RecordIdSet> _updatedRecordIds;
+
+    // Cached by _getCollectionDescription() and reset whenever the stage is restored after a yield.
+    boost::optional<ScopedCollectionDescription> _collDesc;
 };
 
 }  // namespace mongo
@@ -151,11 +151,30 @@ bool WorkingSetMember::hasOwnedObj() const {
 }
 
 void WorkingSetMember::makeObjOwnedIfNeeded() {
-    if (_state == RID_AND_OBJ && !doc.value().isOwned()) {
+    if (_state != RID_AND_OBJ || doc.value().isOwned()) {
+        return;
+    }
+
+    // Copy plain BSON into the buffer kept by this WSM, which saves allocating a new buffer and
+    // DocumentStorage for each document passing through it.
+    auto bson = doc.value().toBsonIfTriviallyConvertible();
+    if (bson && !doc.value().metadata()) {
+        resetDocument(doc.snapshotId(), _copyToOwnedBuffer(*bson));
+    } else {
         doc.value() = doc.value().getOwned();
     }
 }
 
+BSONObj WorkingSetMember::_copyToOwnedBuffer(const BSONObj& obj) {
+    const size_t size = obj.objsize();
+    // The buffer cannot be overwritten while the BSON last copied into it is still referenced.
+    if (_ownedBuffer.isShared() || _ownedBuffer.capacity() < size) {
+        _ownedBuffer = SharedBuffer::allocate(size);
+    }
+    memcpy(_ownedBuffer.get(), obj.objdata(), size);
+    return BSONObj(_ownedBuffer);
+}
+
 bool WorkingSetMember::getFieldDotted(const string& field, BSONElement* out) const {
     // If our state is such that we have an object, use it.
     if (hasObj()) {
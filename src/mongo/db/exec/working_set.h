@@ -38,6 +38,7 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/util/shared_buffer.h"
 
 namespace mongo {
 
@@ -227,9 +228,20 @@ public:
 private:
     friend class WorkingSet;
 
+    /**
+     * Returns an owned copy of 'obj' backed by '_ownedBuffer', replacing the buffer by a new one
+     * first if it is too small or still in use.
+     */
+    BSONObj _copyToOwnedBuffer(const BSONObj& obj);
+
     MemberState _state = WorkingSetMember::INVALID;
 
     DocumentMetadataFields _metadata;
+
+    // Backs the BSON made owned by makeObjOwnedIfNeeded(). Kept when the WSM is cleared so that
+    // it can be reused for the next document, as long as the last one copied into it is no
+    // longer referenced.
+    SharedBuffer _ownedBuffer;
 };
 
 /**
@@ -313,4 +313,65 @@ TEST_F(WorkingSetFixture, WsmCanBeExtractedAndReinserted) {
     ASSERT_FALSE(emplacedWsm->metadata());
 }
 
+TEST_F(WorkingSetFixture, MakeObjOwnedReusesBufferOfFreedMember) {
+    BSONObj first = BSON("x" << 1);
+    member->resetDocument(SnapshotId{1u}, BSONObj(first.objdata()));
+    ws->transitionToRecordIdAndObj(id);
+    member->makeObjOwnedIfNeeded();
+    ASSERT_TRUE(member->doc.value().isOwned());
+    ASSERT_EQ(member->doc.snapshotId().toNumber(), 1u);
+    ASSERT_BSONOBJ_EQ(member->doc.value().toBson(), first);
+    const char* ownedData = member->doc.value().toBson().objdata();
+    ASSERT_NE(ownedData, first.objdata());
+
+    // The freed member is handed out again, and its buffer is reused for the next document.
+    ws->free(id);
+    ASSERT_EQ(ws->allocate(), id);
+    member = ws->get(id);
+    BSONObj second = BSON("x" << 2);
+    member->resetDocument(SnapshotId{2u}, BSONObj(second.objdata()));
+    ws->transitionToRecordIdAndObj(id);
+    member->makeObjOwnedIfNeeded();
+    ASSERT_TRUE(member->doc.value().isOwned());
+    ASSERT_BSONOBJ_EQ(member->doc.value().toBson(), second);
+    ASSERT_EQ(member->doc.value().toBson().objdata(), ownedData);
+}
+
+TEST_F(WorkingSetFixture, MakeObjOwnedDoesNotOverwriteReferencedBuffer) {
+    BSONObj first = BSON("x" << 1);
+    member->resetDocument(SnapshotId(), BSONObj(first.objdata()));
+    ws->transitionToRecordIdAndObj(id);
+    member->makeObjOwnedIfNeeded();
+    BSONObj kept = member->doc.value().toBson();
+    ASSERT_TRUE(kept.isOwned());
+
+    ws->free(id);
+    ASSERT_EQ(ws->allocate(), id);
+    member = ws->get(id);
+    BSONObj second = BSON("x" << 2);
+    member->resetDocument(SnapshotId(), BSONObj(second.objdata()));
+    ws->transitionToRecordIdAndObj(id);
+    member->makeObjOwnedIfNeeded();
+    ASSERT_BSONOBJ_EQ(member->doc.value().toBson(), second);
+    ASSERT_NE(member->doc.value().toBson().objdata(), kept.objdata());
+    ASSERT_BSONOBJ_EQ(kept, first);
+}
+
+TEST_F(WorkingSetFixture, MakeObjOwnedGrowsBufferForLargerDocument) {
+    BSONObj small = BSON("x" << 1);
+    member->resetDocument(SnapshotId(), BSONObj(small.objdata()));
+    ws->transitionToRecordIdAndObj(id);
+    member->makeObjOwnedIfNeeded();
+
+    ws->free(id);
+    ASSERT_EQ(ws->allocate(), id);
+    member = ws->get(id);
+    BSONObj large = BSON("x" << std::string(1024, 'a'));
+    member->resetDocument(SnapshotId(), BSONObj(large.objdata()));
+    ws->transitionToRecordIdAndObj(id);
+    member->makeObjOwnedIfNeeded();
+    ASSERT_TRUE(member->doc.value().isOwned());
+    ASSERT_BSONOBJ_EQ(member->doc.value().toBson(), large);
+}
+
 }  // namespace mongo
@@ -33,16 +33,41 @@
 
 #include <boost/filesystem.hpp>
 
+#include "mongo/db/concurrency/locker.h"
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_server.h"
+#include "mongo/db/ftdc/ftdc_server_gen.h"
+#include "mongo/db/ftdc/peak_sampling_collector.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/util/concurrency/ticketholder.h"
 
 namespace mongo {
 
 namespace {
+std::unique_ptr<FTDCCollectorInterface> makePeakSamplingCollector() {
+    auto collector = std::make_unique<FTDCPeakSamplingCollector>(
+        [] { return Milliseconds(gDiagnosticDataCollectionPeakSamplePeriodMillis.load()); });
+
+    // Ticket exhaustion is the usual signature of a short stall, so track how many tickets are in
+    // use and how many operations are waiting for one.
+    for (auto [name, mode] : {std::make_pair("read", MODE_IS), std::make_pair("write", MODE_IX)}) {
+        auto tickets = Locker::getGlobalThrottling(mode);
+        if (!tickets) {
+            continue;
+        }
+        collector->addGauge(str::stream() << name << "TicketsOut",
+                            [tickets] { return static_cast<long long>(tickets->used()); });
+        collector->addGauge(str::stream() << name << "TicketsQueued",
+                            [tickets] { return static_cast<long long>(tickets->queued()); });
+    }
+    return collector;
+}
+
 void registerMongoDCollectors(FTDCController* controller) {
+    controller->addPeriodicCollector(makePeakSamplingCollector());
+
     // These metrics are only collected if replication is enabled
     if (repl::ReplicationCoordinator::get(getGlobalServiceContext())->getReplicationMode() !=
         repl::ReplicationCoordinator::modeNone) {
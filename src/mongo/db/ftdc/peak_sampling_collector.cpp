@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/peak_sampling_collector.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_name.h"
+
+namespace mongo {
+namespace {
+
+// How long the sampling thread waits before checking again whether background sampling has been
+// enabled.
+constexpr Milliseconds kDisabledRecheckPeriod{1000};
+
+}  // namespace
+
+FTDCPeakSamplingCollector::FTDCPeakSamplingCollector(std::function<Milliseconds()> samplePeriod)
+    : _samplePeriod(std::move(samplePeriod)) {
+    _thread = stdx::thread([this] { _sampleLoop(); });
+}
+
+FTDCPeakSamplingCollector::~FTDCPeakSamplingCollector() {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _shuttingDown = true;
+    }
+    _condvar.notify_all();
+    _thread.join();
+}
+
+void FTDCPeakSamplingCollector::addGauge(std::string name, Gauge gauge) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _gauges.emplace_back(std::move(name), std::move(gauge));
+    _ranges.emplace_back();
+}
+
+void FTDCPeakSamplingCollector::collect(OperationContext* opCtx, BSONObjBuilder& builder) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    const auto samples = _samples;
+    if (samples == 0) {
+        _sample(lk);
+    }
+
+    builder.append("samples", samples);
+    for (size_t i = 0; i < _gauges.size(); ++i) {
+        BSONObjBuilder gaugeBuilder(builder.subobjStart(_gauges[i].first));
+        gaugeBuilder.append("min", _ranges[i].min);
+        gaugeBuilder.append("max", _ranges[i].max);
+    }
+
+    // Start a new range for every gauge.
+    _samples = 0;
+}
+
+void FTDCPeakSamplingCollector::_sampleLoop() {
+    setThreadName("ftdcPeakSampler");
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    while (!_shuttingDown) {
+        const auto period = _samplePeriod();
+        if (period > Milliseconds(0)) {
+            _sample(lk);
+        }
+
+        MONGO_IDLE_THREAD_BLOCK;
+        _condvar.wait_for(lk,
+                          (period > Milliseconds(0) ? period : kDisabledRecheckPeriod)
+                              .toSystemDuration(),
+                          [&] { return _shuttingDown; });
+    }
+}
+
+void FTDCPeakSamplingCollector::_sample(WithLock) {
+    const bool first = _samples == 0;
+    for (size_t i = 0; i < _gauges.size(); ++i) {
+        const long long value = _gauges[i].second();
+        auto& range = _ranges[i];
+        range.min = first ? value : std::min(range.min, value);
+        range.max = first ? value : std::max(range.max, value);
+    }
+    ++_samples;
+}
+
+}  // namespace mongo
@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "mongo/db/ftdc/collector.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+/**
+ * Samples a set of cheap gauges, such as ticket usage or queue depths, many times per FTDC period
+ * on a background thread, and reports the lowest and highest value each gauge took since the
+ * previous collection.
+ *
+ * The regular collectors read every metric once per period, so a stall that starts and ends between
+ * two samples leaves no trace. Recording the range seen by the faster sampling keeps such stalls
+ * visible while every FTDC sample keeps the same schema, so the compressor's delta encoding is
+ * unaffected.
+ *
+ * Sample schema:
+ * {
+ *    "samples" : NumberLong,   <- number of background samples taken since the last collection
+ *    "gaugeName" : {
+ *       "min" : NumberLong,
+ *       "max" : NumberLong,
+ *    },
+ *    ...
+ * }
+ *
+ * If the background sampling is disabled, or did not run since the last collection, each gauge is
+ * read once when collecting.
+ */
+class FTDCPeakSamplingCollector final : public FTDCCollectorInterface {
+public:
+    using Gauge = std::function<long long()>;
+
+    /**
+     * 'samplePeriod' is called before every background sample and returns the delay until the
+     * next one. A zero period disables background sampling until it is changed.
+     */
+    explicit FTDCPeakSamplingCollector(std::function<Milliseconds()> samplePeriod);
+    ~FTDCPeakSamplingCollector();
+
+    /**
+     * Adds a gauge to sample.
+     */
+    void addGauge(std::string name, Gauge gauge);
+
+    std::string name() const override {
+        return "peaks";
+    }
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override;
+
+private:
+    struct Range {
+        long long min = 0;
+        long long max = 0;
+    };
+
+    void _sampleLoop();
+
+    // Reads every gauge and widens its range. Must be called with '_mutex' held.
+    void _sample(WithLock);
+
+    const std::function<Milliseconds()> _samplePeriod;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("FTDCPeakSamplingCollector::_mutex");
+    stdx::condition_variable _condvar;
+
+    std::vector<std::pair<std::string, Gauge>> _gauges;
+    std::vector<Range> _ranges;
+    long long _samples = 0;
+    bool _shuttingDown = false;
+
+    stdx::thread _thread;
+};
+
+}  // namespace mongo
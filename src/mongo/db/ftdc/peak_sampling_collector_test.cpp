@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/peak_sampling_collector.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+BSONObj collect(FTDCPeakSamplingCollector* collector) {
+    BSONObjBuilder builder;
+    collector->collect(nullptr, builder);
+    return builder.obj();
+}
+
+TEST(FTDCPeakSamplingCollectorTest, ReadsGaugesWhenSamplingIsDisabled) {
+    FTDCPeakSamplingCollector collector([] { return Milliseconds(0); });
+    long long value = 7;
+    collector.addGauge("gauge", [&] { return value; });
+
+    auto sample = collect(&collector);
+    ASSERT_EQ(sample["samples"].numberLong(), 0);
+    ASSERT_EQ(sample["gauge"]["min"].numberLong(), 7);
+    ASSERT_EQ(sample["gauge"]["max"].numberLong(), 7);
+
+    value = 3;
+    sample = collect(&collector);
+    ASSERT_EQ(sample["gauge"]["min"].numberLong(), 3);
+    ASSERT_EQ(sample["gauge"]["max"].numberLong(), 3);
+}
+
+TEST(FTDCPeakSamplingCollectorTest, ReportsRangeCoveredBetweenCollections) {
+    AtomicWord<long long> value{5};
+    AtomicWord<long long> reads{0};
+    FTDCPeakSamplingCollector collector([] { return Milliseconds(1); });
+    collector.addGauge("gauge", [&] {
+        reads.fetchAndAdd(1);
+        return value.load();
+    });
+
+    // Let the background sampler observe a short-lived spike that a single read at collection
+    // time would miss.
+    auto waitForSamples = [&] {
+        const auto target = reads.load() + 5;
+        while (reads.load() < target) {
+            sleepmillis(1);
+        }
+    };
+    collect(&collector);
+    waitForSamples();
+    value.store(50);
+    waitForSamples();
+    value.store(5);
+    waitForSamples();
+
+    auto sample = collect(&collector);
+    ASSERT_GT(sample["samples"].numberLong(), 0);
+    ASSERT_EQ(sample["gauge"]["min"].numberLong(), 5);
+    ASSERT_EQ(sample["gauge"]["max"].numberLong(), 50);
+}
+
+}  // namespace
+}  // namespace mongo
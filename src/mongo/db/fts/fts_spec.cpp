@@ -177,9 +177,17 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
 
     FTSElementIterator it(*this, obj);
 
+    // Creating a tokenizer loads a stemmer, so reuse it for every field in the same language
+    // rather than creating one per string.
+    const FTSLanguage* tokenizerLanguage = nullptr;
+    std::unique_ptr<FTSTokenizer> tokenizer;
+
     while (it.more()) {
         FTSIteratorValue val = it.next();
-        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
+        if (val._language != tokenizerLanguage) {
+            tokenizer = val._language->createTokenizer();
+            tokenizerLanguage = val._language;
+        }
         _scoreStringV2(tokenizer.get(), val._text, term_freqs, val._weight);
     }
 }
@@ -83,17 +83,43 @@ void String::setData(const StringData utf8_src) {
     // plus a null character if there isn't one.
     _data.resize(utf8_src.size() + 1);
 
+    const auto* src = reinterpret_cast<const unsigned char*>(utf8_src.rawData());
+    const size_t srcSize = utf8_src.size();
+
+    // Most indexed text is ASCII, where each byte is its own codepoint. Widen the leading run of
+    // ASCII bytes directly, stopping at the first non-ASCII or null byte, and only hand the rest to
+    // the UTF-8 decoder.
+    size_t asciiSize = 0;
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    while (srcSize - asciiSize >= ByteVector::size) {
+        auto word = ByteVector::load(src + asciiSize);
+        ByteVector::Mask stopMask = word.maskHigh() | word.compareEQ(0).maskAny();
+        if (stopMask) {
+            asciiSize += ByteVector::countInitialZeros(stopMask);
+            break;
+        }
+        asciiSize += ByteVector::size;
+    }
+#endif
+    while (asciiSize < srcSize && src[asciiSize] && src[asciiSize] < 0x80) {
+        ++asciiSize;
+    }
+    std::copy(src, src + asciiSize, _data.begin());
+
     int result = 0;
     size_t resultSize = 0;
 
     // Although utf8_src.rawData() is not guaranteed to be null-terminated, copyString8to32 won't
     // access bad memory because it is limited by the size of its output buffer, which is set to the
-    // size of utf8_src.
-    copyString8to32(&_data[0],
-                    reinterpret_cast<const unsigned char*>(&utf8_src.rawData()[0]),
-                    _data.size(),
-                    resultSize,
-                    result);
+    // size of the remaining input.
+    if (asciiSize < srcSize && src[asciiSize]) {
+        copyString8to32(&_data[asciiSize],
+                        src + asciiSize,
+                        _data.size() - asciiSize,
+                        resultSize,
+                        result);
+    }
+    resultSize += asciiSize;
 
     uassert(28755, "text contains invalid UTF-8", result == 0);
 
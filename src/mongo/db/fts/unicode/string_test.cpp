@@ -237,6 +237,28 @@ TEST(UnicodeString, BadUTF8) {
                   AssertionException);
 }
 
+TEST(UnicodeString, ASCIIPrefixDecoding) {
+    // Exercise inputs whose ASCII prefixes are shorter than, equal to and longer than a vector.
+    for (size_t prefixLen : {0, 5, 16, 31, 40}) {
+        const std::string prefix(prefixLen, 'a');
+
+        String ascii(prefix + "bcd");
+        ASSERT_EQ(prefixLen + 3, ascii.size());
+        ASSERT_EQ(prefix + "bcd", ascii.toString());
+
+        String mixed(prefix + UTF8("café ") + filler);
+        ASSERT_EQ(prefixLen + 5 + filler.size(), mixed.size());
+        ASSERT_EQ(prefix + UTF8("café ") + filler, mixed.toString());
+
+        // Decoding stops at the first null byte.
+        String embeddedNull(StringData(prefix + std::string("xy\0z", 4) + filler));
+        ASSERT_EQ(prefixLen + 2, embeddedNull.size());
+
+        const char invalid[] = {C(0xC0), C(0xAF), 0};
+        ASSERT_THROWS(String(prefix + invalid + filler), AssertionException);
+    }
+}
+
 TEST(UnicodeString, UTF32ToUTF8) {
     std::u32string original;
     original.push_back(0x004D);
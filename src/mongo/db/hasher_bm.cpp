@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/oid.h"
+#include "mongo/db/hasher.h"
+
+namespace mongo {
+namespace {
+
+void runHash64(benchmark::State& state, const BSONObj& obj) {
+    const BSONElement elem = obj.firstElement();
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(
+            BSONElementHasher::hash64(elem, BSONElementHasher::DEFAULT_HASH_SEED));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Hash64Long(benchmark::State& state) {
+    runHash64(state, BSON("a" << 123456789LL));
+}
+
+void BM_Hash64ObjectId(benchmark::State& state) {
+    runHash64(state, BSON("a" << OID::gen()));
+}
+
+void BM_Hash64String(benchmark::State& state) {
+    runHash64(state, BSON("a" << std::string(state.range(0), 'x')));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Hash64Object(benchmark::State& state) {
+    runHash64(state, BSON("a" << BSON("b" << 1 << "c" << "abc" << "d" << BSON_ARRAY(1 << 2))));
+}
+
+BENCHMARK(BM_Hash64Long);
+BENCHMARK(BM_Hash64ObjectId);
+BENCHMARK(BM_Hash64String)->Arg(8)->Arg(64)->Arg(1024);
+BENCHMARK(BM_Hash64Object);
+
+}  // namespace
+}  // namespace mongo
@@ -29,6 +29,7 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <memory>
 
@@ -63,15 +64,15 @@ const BSONElement undefinedElt = undefinedObj.firstElement();
  * This function must only be used when there is no an array element along the 'path'. The caller is
  * responsible to ensure this invariant holds.
  */
-BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
+BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path);
+
+/**
+ * Returns the non-array element at 'tail' below 'elt', which is the element found for the first
+ * component of a path. An empty 'tail' refers to 'elt' itself.
+ */
+BSONElement extractNonArrayElementBelow(const BSONElement& elt, StringData tail) {
     static const auto kEmptyElt = BSONElement{};
 
-    auto&& [elt, tail] = [&]() -> std::pair<BSONElement, StringData> {
-        if (auto dotOffset = path.find("."); dotOffset != std::string::npos) {
-            return {obj.getField(path.substr(0, dotOffset)), path.substr(dotOffset + 1)};
-        }
-        return {obj.getField(path), ""_sd};
-    }();
     invariant(elt.type() != BSONType::Array);
 
     if (elt.eoo()) {
@@ -85,6 +86,20 @@ BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
     // "a.b".
     return kEmptyElt;
 }
+
+/**
+ * Returns the remainder of 'path' after its first component, or an empty string if 'path' has a
+ * single component.
+ */
+StringData pathTail(StringData path) {
+    auto dotOffset = path.find(".");
+    return dotOffset == std::string::npos ? ""_sd : path.substr(dotOffset + 1);
+}
+
+BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
+    auto dotOffset = path.find(".");
+    return extractNonArrayElementBelow(obj.getField(path.substr(0, dotOffset)), pathTail(path));
+}
 }  // namespace
 
 BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
@@ -110,6 +125,9 @@ BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
         _pathLengths.push_back(pathLength);
         _pathsContainPositionalComponent =
             _pathsContainPositionalComponent || fieldRef.hasNumericPathComponents();
+        // Refer to the key pattern's storage for the field name, which outlives 'fieldRef'.
+        StringData path{fieldName};
+        _topLevelFieldNames.push_back(path.substr(0, path.find(".")));
     }
 }
 
@@ -285,8 +303,26 @@ void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooled
     KeyString::PooledBuilder keyString{pooledBufferBuilder, _keyStringVersion, _ordering};
     size_t numNotFound{0};
 
-    for (auto&& fieldName : _fieldNames) {
-        auto elem = extractNonArrayElementAtPath(obj, fieldName);
+    // Locate the top-level element of every indexed field in one pass over 'obj', instead of
+    // scanning a wide document once per indexed field. Like getField(), the first element with a
+    // matching name wins.
+    boost::container::small_vector<BSONElement, 8> topLevelElems(_fieldNames.size());
+    size_t numTopLevelUnresolved = _fieldNames.size();
+    for (auto&& elem : obj) {
+        auto fieldName = elem.fieldNameStringData();
+        for (size_t i = 0; i < _topLevelFieldNames.size(); ++i) {
+            if (topLevelElems[i].eoo() && _topLevelFieldNames[i] == fieldName) {
+                topLevelElems[i] = elem;
+                --numTopLevelUnresolved;
+            }
+        }
+        if (numTopLevelUnresolved == 0) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < _fieldNames.size(); ++i) {
+        auto elem = extractNonArrayElementBelow(topLevelElems[i], pathTail(_fieldNames[i]));
         if (elem.eoo()) {
             ++numNotFound;
         }
@@ -239,6 +239,11 @@ private:
     // the vector is the number of path components in the indexed field.
     std::vector<size_t> _pathLengths;
 
+    // A vector with size equal to the number of elements in the index key pattern. Each element in
+    // the vector is the first path component of the indexed field, used to locate the top-level
+    // elements of all indexed fields in a single pass over the document.
+    std::vector<StringData> _topLevelFieldNames;
+
     // Null if this key generator orders strings according to the simple binary compare. If
     // non-null, represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* _collator;
@@ -211,6 +211,25 @@ TEST(BtreeKeyGeneratorTest, GetKeysFromObjectDotted) {
     ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
 }
 
+TEST(BtreeKeyGeneratorTest, GetCompoundKeysFromWideObject) {
+    // Indexed fields appear in a different order than in the key pattern, share their top-level
+    // field, or are missing, among many unindexed fields.
+    BSONObj keyPattern = fromjson("{'a.b': 1, z: 1, 'a.c': 1, missing: 1, f0: 1}");
+    BSONObjBuilder bob;
+    bob.append("z", "last");
+    for (int i = 0; i < 300; ++i) {
+        bob.append("f" + std::to_string(i), i);
+    }
+    bob.append("a", BSON("c" << 2 << "b" << 1));
+    BSONObj genKeysFrom = bob.obj();
+    KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion,
+                                     fromjson("{'': 1, '': 'last', '': 2, '': null, '': 0}"),
+                                     Ordering::make(BSONObj()));
+    KeyStringSet expectedKeys{keyString.release()};
+    MultikeyPaths expectedMultikeyPaths(keyPattern.nFields());
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
 TEST(BtreeKeyGeneratorTest, GetKeysFromArraySimple) {
     BSONObj keyPattern = fromjson("{a: 1}");
     BSONObj genKeysFrom = fromjson("{a: [1, 2, 3]}");
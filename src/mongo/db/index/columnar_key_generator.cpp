@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/columnar_key_generator.h"
+
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/index_names.h"
+
+namespace mongo {
+
+ColumnarKeyGenerator::ColumnarKeyGenerator(const BSONObj& keyPattern,
+                                           KeyString::Version keyStringVersion,
+                                           Ordering ordering)
+    : _keyStringVersion(keyStringVersion), _ordering(ordering) {
+    for (auto&& elem : keyPattern) {
+        invariant(elem.type() == String && elem.valueStringData() == IndexNames::COLUMNAR);
+        _paths.emplace_back(elem.fieldName());
+    }
+}
+
+void ColumnarKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                        const BSONObj& obj,
+                                        KeyStringSet* keys,
+                                        const RecordId& id) const {
+    auto keysSequence = keys->extract_sequence();
+    for (size_t i = 0; i < _paths.size(); ++i) {
+        BSONElement value = dotted_path_support::extractElementAtPath(obj, _paths[i]);
+        if (value.eoo()) {
+            // Columns are sparse: documents which do not have the path contribute no entry.
+            continue;
+        }
+
+        KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
+        keyString.appendNumberLong(static_cast<long long>(i));
+        keyString.appendNumberLong(id.repr());
+        keyString.appendBSONElement(value);
+        keyString.appendRecordId(id);
+        keysSequence.push_back(keyString.release());
+    }
+    // Each path produces at most one key, and the path index leads the key, so the sequence is
+    // already sorted and free of duplicates.
+    keys->adopt_sequence(std::move(keysSequence));
+}
+
+BSONObj ColumnarKeyGenerator::makeColumnStartKey(int pathIndex) {
+    return BSON("" << static_cast<long long>(pathIndex));
+}
+
+ColumnarKeyGenerator::Cell ColumnarKeyGenerator::decodeKey(const KeyString::Value& key,
+                                                           Ordering ordering) {
+    Cell cell;
+    cell.key = KeyString::toBson(key, ordering);
+
+    BSONObjIterator it(cell.key);
+    cell.pathIndex = it.next().numberInt();
+    cell.recordId = RecordId(it.next().numberLong());
+    cell.value = it.next();
+    return cell;
+}
+
+}  // namespace mongo
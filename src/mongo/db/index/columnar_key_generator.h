@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/ordering.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+/**
+ * Generates the keys for a "columnar" index, created with a key pattern such as
+ * { a: "columnar", "b.c": "columnar" }.
+ *
+ * Each indexed path is stored as its own column. For every document, one key is generated per
+ * indexed path that is present in the document:
+ *      { '': <position of the path in the key pattern>, '': <RecordId>, '': <value> }
+ * followed by the RecordId, as required by the SortedDataInterface. The keys for a single path are
+ * therefore contiguous and ordered by RecordId, so a path can be read as a column by scanning the
+ * range for its position, and several columns can be stitched back together by RecordId.
+ *
+ * Paths are resolved without traversing arrays. An array found at an indexed path is stored as a
+ * single value, which means that columnar indexes are never multikey.
+ */
+class ColumnarKeyGenerator {
+public:
+    /**
+     * A single decoded entry of a columnar index.
+     */
+    struct Cell {
+        int pathIndex;
+        RecordId recordId;
+
+        // The indexed value. Points into 'key'.
+        BSONElement value;
+
+        // Owns the decoded key, of the form { '': <path index>, '': <RecordId>, '': <value> }.
+        BSONObj key;
+    };
+
+    ColumnarKeyGenerator(const BSONObj& keyPattern,
+                         KeyString::Version keyStringVersion,
+                         Ordering ordering);
+
+    /**
+     * Adds one key to 'keys' for each indexed path present in 'obj'.
+     */
+    void generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                      const BSONObj& obj,
+                      KeyStringSet* keys,
+                      const RecordId& id) const;
+
+    /**
+     * Returns the key prefix shared by every entry of the column at 'pathIndex', for use when
+     * positioning a cursor at the start of a column.
+     */
+    static BSONObj makeColumnStartKey(int pathIndex);
+
+    /**
+     * Decodes a key produced by generateKeys().
+     */
+    static Cell decodeKey(const KeyString::Value& key, Ordering ordering);
+
+    const std::vector<std::string>& paths() const {
+        return _paths;
+    }
+
+private:
+    std::vector<std::string> _paths;
+    const KeyString::Version _keyStringVersion;
+    const Ordering _ordering;
+};
+
+}  // namespace mongo
@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/columnar_key_generator.h"
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const Ordering kOrdering = Ordering::make(BSONObj());
+
+struct ColumnarKeyGeneratorTest : public unittest::Test {
+    std::vector<ColumnarKeyGenerator::Cell> generateCells(const BSONObj& keyPattern,
+                                                          const BSONObj& obj,
+                                                          const RecordId& id) {
+        ColumnarKeyGenerator keyGen(keyPattern, KeyString::Version::kLatestVersion, kOrdering);
+        KeyStringSet keys;
+        keyGen.generateKeys(allocator, obj, &keys, id);
+
+        std::vector<ColumnarKeyGenerator::Cell> cells;
+        for (auto&& key : keys) {
+            ASSERT_EQ(id, KeyString::decodeRecordIdAtEnd(key.getBuffer(), key.getSize()));
+            cells.push_back(ColumnarKeyGenerator::decodeKey(key, kOrdering));
+        }
+        return cells;
+    }
+
+    SharedBufferFragmentBuilder allocator{KeyString::HeapBuilder::kHeapAllocatorDefaultBytes};
+};
+
+TEST_F(ColumnarKeyGeneratorTest, GeneratesOneKeyPerPresentPath) {
+    auto cells = generateCells(fromjson("{a: 'columnar', 'b.c': 'columnar', d: 'columnar'}"),
+                               fromjson("{a: 1, b: {c: 'x'}, e: 3}"),
+                               RecordId(7));
+
+    ASSERT_EQ(2U, cells.size());
+    ASSERT_EQ(0, cells[0].pathIndex);
+    ASSERT_EQ(RecordId(7), cells[0].recordId);
+    ASSERT_BSONELT_EQ(BSON("" << 1).firstElement(), cells[0].value);
+    ASSERT_EQ(1, cells[1].pathIndex);
+    ASSERT_EQ(RecordId(7), cells[1].recordId);
+    ASSERT_BSONELT_EQ(BSON("" << "x").firstElement(), cells[1].value);
+}
+
+TEST_F(ColumnarKeyGeneratorTest, PreservesValueTypes) {
+    auto cells = generateCells(fromjson("{a: 'columnar', b: 'columnar', c: 'columnar'}"),
+                               BSON("a" << 2.5 << "b" << 3LL << "c" << BSONNULL),
+                               RecordId(1));
+
+    ASSERT_EQ(3U, cells.size());
+    ASSERT_EQ(NumberDouble, cells[0].value.type());
+    ASSERT_EQ(2.5, cells[0].value.numberDouble());
+    ASSERT_EQ(NumberLong, cells[1].value.type());
+    ASSERT_EQ(3LL, cells[1].value.numberLong());
+    ASSERT_EQ(jstNULL, cells[2].value.type());
+}
+
+TEST_F(ColumnarKeyGeneratorTest, ArraysAreStoredAsSingleValue) {
+    auto cells =
+        generateCells(fromjson("{a: 'columnar'}"), fromjson("{a: [3, 1, [2]]}"), RecordId(4));
+
+    ASSERT_EQ(1U, cells.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{'': [3, 1, [2]]}"), cells[0].value.wrap(""));
+}
+
+TEST_F(ColumnarKeyGeneratorTest, KeysOfAColumnAreOrderedByRecordId) {
+    BSONObj keyPattern = fromjson("{a: 'columnar', b: 'columnar'}");
+    ColumnarKeyGenerator keyGen(keyPattern, KeyString::Version::kLatestVersion, kOrdering);
+
+    // Insert the documents so that the values of 'a' sort in the opposite order of the RecordIds.
+    KeyStringSet keys;
+    for (int i = 1; i <= 3; ++i) {
+        KeyStringSet docKeys;
+        keyGen.generateKeys(allocator, BSON("a" << -i << "b" << i), &docKeys, RecordId(i));
+        keys.insert(docKeys.begin(), docKeys.end());
+    }
+
+    ASSERT_EQ(6U, keys.size());
+    int position = 0;
+    for (auto&& key : keys) {
+        auto cell = ColumnarKeyGenerator::decodeKey(key, kOrdering);
+        ASSERT_EQ(position / 3, cell.pathIndex);
+        ASSERT_EQ(RecordId(position % 3 + 1), cell.recordId);
+        ++position;
+    }
+}
+
+TEST_F(ColumnarKeyGeneratorTest, ColumnStartKeySortsBeforeColumnEntries) {
+    BSONObj keyPattern = fromjson("{a: 'columnar', b: 'columnar'}");
+    ColumnarKeyGenerator keyGen(keyPattern, KeyString::Version::kLatestVersion, kOrdering);
+    KeyStringSet keys;
+    keyGen.generateKeys(allocator, fromjson("{a: 1, b: 2}"), &keys, RecordId(1));
+    ASSERT_EQ(2U, keys.size());
+
+    KeyString::HeapBuilder startOfB(KeyString::Version::kLatestVersion,
+                                    ColumnarKeyGenerator::makeColumnStartKey(1),
+                                    kOrdering,
+                                    KeyString::Discriminator::kExclusiveBefore);
+    ASSERT_LT(keys.begin()->compare(startOfB.getValueCopy()), 0);
+    ASSERT_GT(std::next(keys.begin())->compare(startOfB.getValueCopy()), 0);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -43,8 +44,10 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/index/index_access_method_gen.h"
 #include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/operation_context.h"
@@ -88,7 +91,8 @@ SortOptions makeSortOptions(size_t maxMemoryUsageBytes) {
     return SortOptions()
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
-        .MaxMemoryUsageBytes(maxMemoryUsageBytes);
+        .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+        .SortThreads(maxIndexBuildSortThreads.load());
 }
 
 MultikeyPaths createMultikeyPaths(const std::vector<MultikeyPath>& multikeyPathsVec) {
@@ -102,6 +106,27 @@ MultikeyPaths createMultikeyPaths(const std::vector<MultikeyPath>& multikeyPaths
     return multikeyPaths;
 }
 
+/**
+ * Returns true if 'from' and 'to' hold the same value at 'path'. Only embedded objects are
+ * descended into; as soon as either side holds an array or a scalar along the path, that whole
+ * subtree is compared, so any change beneath an array on the path counts as a change.
+ */
+bool valueAtPathUnchanged(const BSONObj& from, const BSONObj& to, const FieldRef& path) {
+    BSONObj fromObj = from;
+    BSONObj toObj = to;
+    for (FieldIndex i = 0; i < path.numParts(); ++i) {
+        const auto fromElem = fromObj[path.getPart(i)];
+        const auto toElem = toObj[path.getPart(i)];
+        if (i + 1 == path.numParts() || fromElem.type() != BSONType::Object ||
+            toElem.type() != BSONType::Object) {
+            return fromElem.binaryEqualValues(toElem);
+        }
+        fromObj = fromElem.embeddedObject();
+        toObj = toElem.embeddedObject();
+    }
+    return true;
+}
+
 }  // namespace
 
 struct BtreeExternalSortComparison {
@@ -111,12 +136,26 @@ struct BtreeExternalSortComparison {
     }
 };
 
+// KeyString::Value::compare() is a bytewise comparison of the encoded keys.
+template <>
+struct SorterKeysAreBinaryComparable<BtreeExternalSortComparison> : std::true_type {};
+
 AbstractIndexAccessMethod::AbstractIndexAccessMethod(IndexCatalogEntry* btreeState,
                                                      std::unique_ptr<SortedDataInterface> btree)
     : _indexCatalogEntry(btreeState),
       _descriptor(btreeState->descriptor()),
       _newInterface(std::move(btree)) {
     verify(IndexDescriptor::isIndexVersionSupported(_descriptor->version()));
+
+    // Text, wildcard and columnar keys depend on paths other than the key pattern's field names.
+    const auto& accessMethodName = _descriptor->getAccessMethodName();
+    if (accessMethodName == IndexNames::BTREE || accessMethodName == IndexNames::HASHED ||
+        accessMethodName == IndexNames::GEO_2D || accessMethodName == IndexNames::GEO_2DSPHERE ||
+        accessMethodName == IndexNames::GEO_HAYSTACK) {
+        for (auto&& elem : _descriptor->keyPattern()) {
+            _indexedPaths.emplace_back(elem.fieldNameStringData());
+        }
+    }
 }
 
 // Find the keys for obj, put them in the tree pointing to loc.
@@ -388,7 +427,24 @@ void AbstractIndexAccessMethod::prepareUpdate(OperationContext* opCtx,
                                               UpdateTicket* ticket) const {
     auto& executionCtx = StorageExecutionContext::get(opCtx);
     const MatchExpression* indexFilter = index->getFilterExpression();
-    if (!indexFilter || indexFilter->matchesBSON(from)) {
+    const bool fromMatchesFilter = !indexFilter || indexFilter->matchesBSON(from);
+    const bool toMatchesFilter = !indexFilter || indexFilter->matchesBSON(to);
+
+    ticket->loc = record;
+    ticket->dupsAllowed = options.dupsAllowed;
+
+    // If the update left every indexed value alone, the old and new keys are identical and there
+    // is nothing to diff. This avoids generating every key twice when, for instance, an element is
+    // appended to a large array that this index does not cover.
+    if (fromMatchesFilter == toMatchesFilter && !_indexedPaths.empty() &&
+        std::all_of(_indexedPaths.begin(), _indexedPaths.end(), [&](const FieldRef& path) {
+            return valueAtPathUnchanged(from, to, path);
+        })) {
+        ticket->_isValid = true;
+        return;
+    }
+
+    if (fromMatchesFilter) {
         // Override key constraints when generating keys for removal. This only applies to keys
         // that do not apply to a partial filter expression.
         const auto getKeysMode = index->isHybridBuilding()
@@ -409,7 +465,7 @@ void AbstractIndexAccessMethod::prepareUpdate(OperationContext* opCtx,
                 kNoopOnSuppressedErrorFn);
     }
 
-    if (!indexFilter || indexFilter->matchesBSON(to)) {
+    if (toMatchesFilter) {
         getKeys(executionCtx.pooledBufferBuilder(),
                 to,
                 options.getKeysMode,
@@ -421,9 +477,6 @@ void AbstractIndexAccessMethod::prepareUpdate(OperationContext* opCtx,
                 kNoopOnSuppressedErrorFn);
     }
 
-    ticket->loc = record;
-    ticket->dupsAllowed = options.dupsAllowed;
-
     std::tie(ticket->removed, ticket->added) = setDifference(ticket->oldKeys, ticket->newKeys);
 
     ticket->_isValid = true;
@@ -502,6 +555,8 @@ public:
      * Inserts all multikey metadata keys cached during the BulkBuilder's lifetime into the
      * underlying Sorter, finalizes it, and returns an iterator over the sorted dataset.
      */
+    void sortPendingKeys() final;
+
     Sorter::Iterator* done() final;
 
     int64_t getKeysInserted() const final;
@@ -626,6 +681,11 @@ bool AbstractIndexAccessMethod::BulkBuilderImpl::isMultikey() const {
     return _isMultiKey;
 }
 
+void AbstractIndexAccessMethod::BulkBuilderImpl::sortPendingKeys() {
+    _insertMultikeyMetadataKeysIntoSorter();
+    _sorter->sortInMemoryData();
+}
+
 IndexAccessMethod::BulkBuilder::Sorter::Iterator*
 AbstractIndexAccessMethod::BulkBuilderImpl::done() {
     _insertMultikeyMetadataKeysIntoSorter();
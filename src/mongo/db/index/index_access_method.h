@@ -258,6 +258,14 @@ public:
 
         virtual bool isMultikey() const = 0;
 
+        /**
+         * Inserts all multikey metadata keys cached during the BulkBuilder's lifetime into the
+         * underlying Sorter and sorts the keys it still holds in memory, so that done() only has
+         * to spill or iterate them. Needs no OperationContext and touches only this BulkBuilder,
+         * so the BulkBuilders of different indexes may do this concurrently.
+         */
+        virtual void sortPendingKeys() = 0;
+
         /**
          * Inserts all multikey metadata keys cached during the BulkBuilder's lifetime into the
          * underlying Sorter, finalizes it, and returns an iterator over the sorted dataset.
@@ -614,6 +622,11 @@ private:
                                const RecordIdHandlerFn& onDuplicateRecord);
 
     const std::unique_ptr<SortedDataInterface> _newInterface;
+
+    // The document paths that fully determine this index's keys, or empty if the keys may depend
+    // on other parts of the document, as they do for text and wildcard indexes. Lets
+    // prepareUpdate() skip key generation when an update leaves every indexed value untouched.
+    std::vector<FieldRef> _indexedPaths;
 };
 
 }  // namespace mongo
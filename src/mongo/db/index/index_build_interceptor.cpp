@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/index_build_interceptor.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -137,7 +138,12 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
 
     // Set up the progress meter. This will never be completely accurate, because more writes can be
     // read from the side writes table than are observed before draining.
-    static const char* curopMessage = "Index Build: draining writes received during build";
+    // The final drain blocks all other operations on the collection, so say so in currentOp.
+    const char* curopMessage =
+        opCtx->lockState()->isCollectionLockedForMode(coll->ns(), MODE_X)
+        ? "Index Build: draining writes received during build while holding an exclusive "
+          "collection lock"
+        : "Index Build: draining writes received during build";
     ProgressMeterHolder progress;
     {
         stdx::unique_lock<Client> lk(*opCtx->getClient());
@@ -179,6 +185,10 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
         // table matters.
         std::vector<RecordId> recordsAddedToIndex;
 
+        // Read the whole batch before applying any of it, so that the writes can be applied in
+        // key order rather than in the order they were made.
+        std::vector<SideWrite> batch;
+
         auto record = cursor->next();
         while (record) {
             opCtx->checkForInterrupt();
@@ -200,16 +210,7 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             batchSize += 1;
             batchSizeBytes += objSize;
 
-            if (auto status = _applyWrite(opCtx,
-                                          coll,
-                                          unownedDoc,
-                                          options,
-                                          trackDuplicates,
-                                          &totalInserted,
-                                          &totalDeleted);
-                !status.isOK()) {
-                return status;
-            }
+            batch.push_back(_parseSideWrite(unownedDoc));
 
             // Save the record ids of the documents inserted into the index for deletion later.
             // We can't delete records while holding a positioned cursor.
@@ -223,6 +224,27 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             record = cursor->next();
         }
 
+        // Applying the batch in key order walks the index from one end to the other instead of
+        // jumping around it. Only writes to the same key, ignoring the RecordId, can depend on
+        // one another, and the stable sort keeps those in the order they were made. This matters
+        // for unique indexes, where a key may move from one RecordId to another.
+        std::stable_sort(batch.begin(), batch.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.key.compareWithoutRecordId(rhs.key) < 0;
+        });
+
+        for (const auto& sideWrite : batch) {
+            if (auto status = _applyWrite(opCtx,
+                                          coll,
+                                          sideWrite,
+                                          options,
+                                          trackDuplicates,
+                                          &totalInserted,
+                                          &totalDeleted);
+                !status.isOK()) {
+                return status;
+            }
+        }
+
         // Delete documents from the side table as soon as they have been inserted into the index.
         // This ensures that no key is ever inserted twice and no keys are skipped.
         for (const auto& recordId : recordsAddedToIndex) {
@@ -280,23 +302,33 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     return Status::OK();
 }
 
-Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
-                                          const CollectionPtr& coll,
-                                          const BSONObj& operation,
-                                          const InsertDeleteOptions& options,
-                                          TrackDuplicates trackDups,
-                                          int64_t* const keysInserted,
-                                          int64_t* const keysDeleted) {
+IndexBuildInterceptor::SideWrite IndexBuildInterceptor::_parseSideWrite(
+    const BSONObj& operation) const {
     // Deserialize the encoded KeyString::Value.
     int keyLen;
     const char* binKey = operation["key"].binData(keyLen);
     BufReader reader(binKey, keyLen);
-    const KeyString::Value keyString = KeyString::Value::deserialize(
+    auto keyString = KeyString::Value::deserialize(
         reader,
         _indexCatalogEntry->accessMethod()->getSortedDataInterface()->getKeyStringVersion());
 
     const Op opType =
         (strcmp(operation.getStringField("op"), "i") == 0) ? Op::kInsert : Op::kDelete;
+    if (kDebugBuild && opType == Op::kDelete)
+        invariant(strcmp(operation.getStringField("op"), "d") == 0);
+
+    return {std::move(keyString), opType};
+}
+
+Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
+                                          const CollectionPtr& coll,
+                                          const SideWrite& sideWrite,
+                                          const InsertDeleteOptions& options,
+                                          TrackDuplicates trackDups,
+                                          int64_t* const keysInserted,
+                                          int64_t* const keysDeleted) {
+    const KeyString::Value& keyString = sideWrite.key;
+    const Op opType = sideWrite.op;
 
     const KeyStringSet keySet{keyString};
     const RecordId opRecordId =
@@ -328,8 +360,6 @@ Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
             [keysInserted, numInserted] { *keysInserted -= numInserted; });
     } else {
         invariant(opType == Op::kDelete);
-        if (kDebugBuild)
-            invariant(strcmp(operation.getStringField("op"), "d") == 0);
 
         int64_t numDeleted;
         Status s = accessMethod->removeKeys(
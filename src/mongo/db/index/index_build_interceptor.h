@@ -175,10 +175,19 @@ public:
 private:
     using SideWriteRecord = std::pair<RecordId, BSONObj>;
 
+    /**
+     * A decoded side-writes table record: the key to insert into or remove from the index.
+     */
+    struct SideWrite {
+        KeyString::Value key;
+        Op op;
+    };
+
+    SideWrite _parseSideWrite(const BSONObj& operation) const;
 
     Status _applyWrite(OperationContext* opCtx,
                        const CollectionPtr& coll,
-                       const BSONObj& doc,
+                       const SideWrite& sideWrite,
                        const InsertDeleteOptions& options,
                        TrackDuplicates trackDups,
                        int64_t* const keysInserted,
@@ -44,21 +44,21 @@ namespace {
 // to prevent the _id field from being indexed, since it already has its own dedicated index.
 static const BSONObj kDefaultProjection = BSON("_id"_sd << 0);
 
+// Wildcard paths are accumulated in a single string in which every path component, including the
+// first, is preceded by a '.'. Appending and removing a component then only moves the end of the
+// string, rather than reassembling the full dotted path for every key as a FieldRef would.
+StringData dottedPath(const std::string& path) {
+    return StringData(path).substr(1);
+}
+
 // If the enclosing object is an array, then the current element's fieldname is the array index, so
 // we omit this when computing the full path. Otherwise, the full path is the pathPrefix plus the
 // element's fieldname.
-void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathPrefix) {
-    if (!enclosingObjIsArray) {
-        pathPrefix->appendPart(elem.fieldNameStringData());
-    }
-}
-
-// If the enclosing object is not an array, then the final path component should be its field name.
-// Verify that this is the case and then pop it off the FieldRef.
-void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathToElem) {
+void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, std::string* pathPrefix) {
     if (!enclosingObjIsArray) {
-        invariant(pathToElem->getPart(pathToElem->numParts() - 1) == elem.fieldNameStringData());
-        pathToElem->removeLastPart();
+        auto fieldName = elem.fieldNameStringData();
+        pathPrefix->push_back('.');
+        pathPrefix->append(fieldName.rawData(), fieldName.size());
     }
 }
 }  // namespace
@@ -112,7 +112,7 @@ void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBuffe
                                         KeyStringSet* keys,
                                         KeyStringSet* multikeyPaths,
                                         boost::optional<RecordId> id) const {
-    FieldRef rootPath;
+    std::string rootPath;
     auto keysSequence = keys->extract_sequence();
     // multikeyPaths is allowed to be nullptr
     KeyStringSet::sequence_type multikeyPathsSequence;
@@ -133,7 +133,7 @@ void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBuffe
 void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                              BSONObj obj,
                                              bool objIsArray,
-                                             FieldRef* path,
+                                             std::string* path,
                                              KeyStringSet::sequence_type* keys,
                                              KeyStringSet::sequence_type* multikeyPaths,
                                              boost::optional<RecordId> id) const {
@@ -143,19 +143,22 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
             continue;
 
         // Append the element's fieldname to the path, if the enclosing object is not an array.
+        const auto pathPrefixSize = path->size();
         pushPathComponent(elem, objIsArray, path);
+        const auto fullPath = dottedPath(*path);
 
         switch (elem.type()) {
             case BSONType::Array:
                 // If this is a nested array, we don't descend it but instead index it as a value.
-                if (_addKeyForNestedArray(pooledBufferBuilder, elem, *path, objIsArray, keys, id))
+                if (_addKeyForNestedArray(
+                        pooledBufferBuilder, elem, fullPath, objIsArray, keys, id))
                     break;
 
                 // Add an entry for the multi-key path, and then fall through to BSONType::Object.
-                _addMultiKey(pooledBufferBuilder, *path, multikeyPaths);
+                _addMultiKey(pooledBufferBuilder, fullPath, multikeyPaths);
 
             case BSONType::Object:
-                if (_addKeyForEmptyLeaf(pooledBufferBuilder, elem, *path, keys, id))
+                if (_addKeyForEmptyLeaf(pooledBufferBuilder, elem, fullPath, keys, id))
                     break;
 
                 _traverseWildcard(pooledBufferBuilder,
@@ -168,17 +171,17 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
                 break;
 
             default:
-                _addKey(pooledBufferBuilder, elem, *path, keys, id);
+                _addKey(pooledBufferBuilder, elem, fullPath, keys, id);
         }
 
         // Remove the element's fieldname from the path, if it was pushed onto it earlier.
-        popPathComponent(elem, objIsArray, path);
+        path->resize(pathPrefixSize);
     }
 }
 
 bool WildcardKeyGenerator::_addKeyForNestedArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                                  BSONElement elem,
-                                                 const FieldRef& fullPath,
+                                                 StringData fullPath,
                                                  bool enclosingObjIsArray,
                                                  KeyStringSet::sequence_type* keys,
                                                  boost::optional<RecordId> id) const {
@@ -192,7 +195,7 @@ bool WildcardKeyGenerator::_addKeyForNestedArray(SharedBufferFragmentBuilder& po
 
 bool WildcardKeyGenerator::_addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                                BSONElement elem,
-                                               const FieldRef& fullPath,
+                                               StringData fullPath,
                                                KeyStringSet::sequence_type* keys,
                                                boost::optional<RecordId> id) const {
     invariant(elem.isABSONObj());
@@ -211,12 +214,12 @@ bool WildcardKeyGenerator::_addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pool
 
 void WildcardKeyGenerator::_addKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                    BSONElement elem,
-                                   const FieldRef& fullPath,
+                                   StringData fullPath,
                                    KeyStringSet::sequence_type* keys,
                                    boost::optional<RecordId> id) const {
     // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
     KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
-    keyString.appendString(fullPath.dottedField());
+    keyString.appendString(fullPath);
     if (_collator && elem) {
         keyString.appendBSONElement(elem, [&](StringData stringData) {
             return _collator->getComparisonString(stringData);
@@ -234,13 +237,13 @@ void WildcardKeyGenerator::_addKey(SharedBufferFragmentBuilder& pooledBufferBuil
 }
 
 void WildcardKeyGenerator::_addMultiKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                                        const FieldRef& fullPath,
+                                        StringData fullPath,
                                         KeyStringSet::sequence_type* multikeyPaths) const {
     // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
     // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
     // not require multikey path generation.
     if (multikeyPaths) {
-        auto key = BSON("" << 1 << "" << fullPath.dottedField());
+        auto key = BSON("" << 1 << "" << fullPath);
         KeyString::PooledBuilder keyString(
             pooledBufferBuilder,
             _keyStringVersion,
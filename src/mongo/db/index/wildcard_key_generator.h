@@ -85,31 +85,31 @@ private:
     void _traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                            BSONObj obj,
                            bool objIsArray,
-                           FieldRef* path,
+                           std::string* path,
                            KeyStringSet::sequence_type* keys,
                            KeyStringSet::sequence_type* multikeyPaths,
                            boost::optional<RecordId> id) const;
 
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
     void _addMultiKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                      const FieldRef& fullPath,
+                      StringData fullPath,
                       KeyStringSet::sequence_type* multikeyPaths) const;
     void _addKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
                  BSONElement elem,
-                 const FieldRef& fullPath,
+                 StringData fullPath,
                  KeyStringSet::sequence_type* keys,
                  boost::optional<RecordId> id) const;
 
     // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
     bool _addKeyForNestedArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                BSONElement elem,
-                               const FieldRef& fullPath,
+                               StringData fullPath,
                                bool enclosingObjIsArray,
                                KeyStringSet::sequence_type* keys,
                                boost::optional<RecordId> id) const;
     bool _addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pooledBufferBuilder,
                              BSONElement elem,
-                             const FieldRef& fullPath,
+                             StringData fullPath,
                              KeyStringSet::sequence_type* keys,
                              boost::optional<RecordId> id) const;
 
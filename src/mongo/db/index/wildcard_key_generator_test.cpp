@@ -132,6 +132,34 @@ TEST_F(WildcardKeyGeneratorFullDocumentTest, ExtractKeysFromNestedObject) {
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+TEST_F(WildcardKeyGeneratorFullDocumentTest, ExtractKeysFromSiblingsAtDifferentDepths) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                {},
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+    auto inputDoc = fromjson(
+        "{a: {b: {c: 1}, longerName: 2}, d: [{e: 3}, {f: {g: 4}}], h: {i: {j: {k: 5}}}, l: 6}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a.b.c', '': 1}"),
+                                    fromjson("{'': 'a.longerName', '': 2}"),
+                                    fromjson("{'': 'd.e', '': 3}"),
+                                    fromjson("{'': 'd.f.g', '': 4}"),
+                                    fromjson("{'': 'h.i.j.k', '': 5}"),
+                                    fromjson("{'': 'l', '': 6}")});
+
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'd'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(allocator, inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
 TEST_F(WildcardKeyGeneratorFullDocumentTest, ShouldIndexEmptyObject) {
     WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
                                 {},
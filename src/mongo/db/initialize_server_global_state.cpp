@@ -351,6 +351,7 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
         lv2Config.consoleEnabled = false;
         lv2Config.fileEnabled = true;
         lv2Config.filePath = absoluteLogpath;
+        lv2Config.fileAsyncBufferBytes = static_cast<size_t>(gLogAsyncBufferSizeKB) * 1024;
         lv2Config.fileRotationMode = serverGlobalParams.logRenameOnRotate
             ? logv2::LogDomainGlobal::ConfigurationOptions::RotationMode::kRename
             : logv2::LogDomainGlobal::ConfigurationOptions::RotationMode::kReopen;
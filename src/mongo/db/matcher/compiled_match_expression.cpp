@@ -0,0 +1,176 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include <map>
+
+#include "mongo/db/field_ref.h"
+
+namespace mongo {
+namespace {
+
+bool isCompilableLeaf(const MatchExpression* expr) {
+    if (expr->getCategory() != MatchExpression::MatchCategory::kLeaf || expr->path().empty()) {
+        return false;
+    }
+    FieldRef path(expr->path());
+    for (size_t i = 0; i < path.numParts(); ++i) {
+        if (path.getPart(i).empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The path components of the predicates, as a tree whose children are ordered by field name.
+struct PathTree {
+    std::map<std::string, PathTree> children;
+    std::vector<size_t> predicates;
+};
+
+}  // namespace
+
+std::unique_ptr<CompiledMatchExpression> CompiledMatchExpression::compile(
+    const MatchExpression* expr) {
+    if (!expr || expr->matchType() != MatchExpression::AND) {
+        return nullptr;
+    }
+
+    std::unique_ptr<CompiledMatchExpression> compiled(new CompiledMatchExpression());
+    PathTree root;
+    size_t numLeaves = 0;
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        const MatchExpression* child = expr->getChild(i);
+        compiled->_predicates.push_back({child, kNoNode});
+        if (!isCompilableLeaf(child)) {
+            continue;
+        }
+        ++numLeaves;
+        FieldRef path(child->path());
+        PathTree* tree = &root;
+        for (size_t part = 0; part < path.numParts(); ++part) {
+            tree = &tree->children[path.getPart(part).toString()];
+        }
+        tree->predicates.push_back(i);
+    }
+    if (numLeaves < 2) {
+        return nullptr;
+    }
+
+    // Flatten the tree breadth-first, pointing each predicate at the node ending its path.
+    std::vector<std::pair<const PathTree*, size_t>> queue{{&root, kNoNode}};
+    for (size_t next = 0; next < queue.size(); ++next) {
+        const PathTree* tree = queue[next].first;
+        const size_t node = queue[next].second;
+        if (node != kNoNode) {
+            compiled->_nodes[node].childrenBegin = compiled->_nodes.size();
+        }
+        for (auto&& [fieldName, child] : tree->children) {
+            const size_t childNode = compiled->_nodes.size();
+            compiled->_nodes.push_back({fieldName, node});
+            for (auto predicate : child.predicates) {
+                compiled->_predicates[predicate].node = childNode;
+            }
+            queue.push_back({&child, childNode});
+        }
+        if (node == kNoNode) {
+            compiled->_topLevelEnd = compiled->_nodes.size();
+        } else {
+            compiled->_nodes[node].childrenEnd = compiled->_nodes.size();
+        }
+    }
+
+    compiled->_elements.resize(compiled->_nodes.size());
+    compiled->_throughArray.resize(compiled->_nodes.size());
+    return compiled;
+}
+
+bool CompiledMatchExpression::matches(const BSONObj& doc) const {
+    std::fill(_elements.begin(), _elements.end(), BSONElement());
+    std::fill(_throughArray.begin(), _throughArray.end(), false);
+    _resolveRange(0, _topLevelEnd, doc);
+
+    for (auto&& predicate : _predicates) {
+        const bool matched = predicate.node == kNoNode || _throughArray[predicate.node]
+            ? predicate.expr->matchesBSON(doc)
+            : predicate.expr->matchesSingleElement(_elements[predicate.node]);
+        if (!matched) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CompiledMatchExpression::_resolveRange(size_t childrenBegin,
+                                            size_t childrenEnd,
+                                            const BSONObj& obj) const {
+    // Find the first field of 'obj' named after each child, as BSONObj::getField() would, in a
+    // single pass over 'obj'.
+    size_t numUnresolved = childrenEnd - childrenBegin;
+    for (auto&& elem : obj) {
+        const StringData fieldName = elem.fieldNameStringData();
+        for (size_t child = childrenBegin; child < childrenEnd; ++child) {
+            if (_elements[child].eoo() && _nodes[child].fieldName == fieldName) {
+                _elements[child] = elem;
+                --numUnresolved;
+                break;
+            }
+        }
+        if (numUnresolved == 0) {
+            break;
+        }
+    }
+
+    for (size_t child = childrenBegin; child < childrenEnd; ++child) {
+        const PathNode& pathNode = _nodes[child];
+        if (_elements[child].type() == Array) {
+            // Leave this path and those below it to the implicit array traversal of the
+            // expression.
+            _markThroughArray(child);
+        } else if (_elements[child].type() == Object &&
+                   pathNode.childrenBegin < pathNode.childrenEnd) {
+            _resolveRange(pathNode.childrenBegin, pathNode.childrenEnd, _elements[child].Obj());
+        }
+        // A missing or scalar element has nothing below it, so the paths through it resolve to
+        // EOO.
+    }
+}
+
+void CompiledMatchExpression::_markThroughArray(size_t node) const {
+    _throughArray[node] = true;
+    for (size_t child = _nodes[node].childrenBegin; child < _nodes[node].childrenEnd; ++child) {
+        _markThroughArray(child);
+    }
+}
+
+}  // namespace mongo
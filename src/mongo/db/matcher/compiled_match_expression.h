@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+/**
+ * A flattened form of a conjunction whose children include several leaf predicates, which
+ * evaluates it against a document resolving the paths of all those predicates together.
+ *
+ * The paths are arranged into a tree of path components. Matching a document walks each object
+ * along these paths once, however many predicates share a prefix, and hands every leaf predicate
+ * the element at the end of its path. Predicates whose path runs through an array are evaluated
+ * by the original MatchExpression, which implements the implicit array traversal rules, as are
+ * the children of the conjunction which are not leaves.
+ *
+ * The CompiledMatchExpression points into the MatchExpression it is compiled from, which must
+ * outlive it and not be modified meanwhile. It keeps state between calls to matches(), so it must
+ * not be used by more than one thread at a time.
+ */
+class CompiledMatchExpression {
+    CompiledMatchExpression(const CompiledMatchExpression&) = delete;
+    CompiledMatchExpression& operator=(const CompiledMatchExpression&) = delete;
+
+public:
+    /**
+     * Returns the compiled form of 'expr', or nullptr if 'expr' is not a conjunction of at least
+     * two leaf predicates with non-empty paths, possibly alongside other children.
+     */
+    static std::unique_ptr<CompiledMatchExpression> compile(const MatchExpression* expr);
+
+    /**
+     * Returns the same result as 'matchesBSON(doc)' on the expression this was compiled from.
+     */
+    bool matches(const BSONObj& doc) const;
+
+private:
+    static constexpr size_t kNoNode = static_cast<size_t>(-1);
+
+    // A component of the path of at least one predicate. The nodes are stored in breadth-first
+    // order, so that the children of each node are contiguous and follow their parent.
+    struct PathNode {
+        std::string fieldName;
+        size_t parent;
+        size_t childrenBegin = 0;
+        size_t childrenEnd = 0;
+    };
+
+    // A child of the conjunction. 'node' is the last component of its path if it is a leaf, and
+    // kNoNode otherwise.
+    struct Predicate {
+        const MatchExpression* expr;
+        size_t node;
+    };
+
+    CompiledMatchExpression() = default;
+
+    /**
+     * Sets the elements of the nodes in ['childrenBegin', 'childrenEnd'), which are the children
+     * of the same node, from the fields of 'obj', and then those of the nodes below them.
+     */
+    void _resolveRange(size_t childrenBegin, size_t childrenEnd, const BSONObj& obj) const;
+
+    void _markThroughArray(size_t node) const;
+
+    std::vector<PathNode> _nodes;
+    size_t _topLevelEnd = 0;
+
+    std::vector<Predicate> _predicates;
+
+    // The element each node resolves to in the document being matched, EOO if it is missing.
+    // Nodes whose path runs through an array are flagged in '_throughArray' instead.
+    mutable std::vector<BSONElement> _elements;
+    mutable std::vector<char> _throughArray;
+};
+
+}  // namespace mongo
@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& filter,
+                                       const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto expr = MatchExpressionParser::parse(filter, expCtx);
+    ASSERT_OK(expr.getStatus());
+    return std::move(expr.getValue());
+}
+
+/**
+ * Asserts that 'filter' compiles, and that its compiled form agrees with the filter on each of
+ * 'docs'.
+ */
+void assertCompiledMatchesLikeExpression(const char* filter, const std::vector<BSONObj>& docs) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto expr = parse(fromjson(filter), expCtx);
+    auto compiled = CompiledMatchExpression::compile(expr.get());
+    ASSERT(compiled) << filter;
+    for (auto&& doc : docs) {
+        ASSERT_EQ(compiled->matches(doc), expr->matchesBSON(doc))
+            << "filter: " << filter << ", document: " << doc;
+    }
+}
+
+const std::vector<BSONObj> kDocs = {
+    fromjson("{}"),
+    fromjson("{a: 1, b: 2}"),
+    fromjson("{a: 1, b: 3}"),
+    fromjson("{a: 2, b: 2}"),
+    fromjson("{a: null, b: 2}"),
+    fromjson("{b: 2}"),
+    fromjson("{a: 'x', b: 2}"),
+    fromjson("{a: [1, 2], b: 2}"),
+    fromjson("{a: [[1]], b: [2, 3]}"),
+    fromjson("{a: {b: 1, c: 2}, d: 4}"),
+    fromjson("{a: {b: 1, c: 3}, d: 4}"),
+    fromjson("{a: {b: null}, d: 4}"),
+    fromjson("{a: {c: 2}, d: 5}"),
+    fromjson("{a: {b: [1, 5], c: 2}, d: 4}"),
+    fromjson("{a: [{b: 1, c: 2}], d: 4}"),
+    fromjson("{a: [{b: 5}, {b: 1, c: 2}], d: 4}"),
+    fromjson("{a: 5, d: 4}"),
+    fromjson("{a: {b: {c: 2}}, d: 4}"),
+    fromjson("{a: {'0': 1, b: 1, c: 2}, d: 4}"),
+    fromjson("{a: 1, a: 2, b: 2}"),
+    fromjson("{a: {b: 1}, a: {c: 2}, d: 4}"),
+};
+
+TEST(CompiledMatchExpressionTest, ConjunctionOfTopLevelComparisons) {
+    assertCompiledMatchesLikeExpression("{a: 1, b: 2}", kDocs);
+    assertCompiledMatchesLikeExpression("{a: {$gte: 1}, b: {$lt: 3}}", kDocs);
+    assertCompiledMatchesLikeExpression("{a: null, b: 2}", kDocs);
+    assertCompiledMatchesLikeExpression("{a: [1, 2], b: 2}", kDocs);
+}
+
+TEST(CompiledMatchExpressionTest, ConjunctionOfNestedComparisons) {
+    assertCompiledMatchesLikeExpression("{'a.b': 1, 'a.c': 2}", kDocs);
+    assertCompiledMatchesLikeExpression("{'a.b': 1, 'a.c': 2, d: 4}", kDocs);
+    assertCompiledMatchesLikeExpression("{'a.b': null, d: 4}", kDocs);
+    assertCompiledMatchesLikeExpression("{'a.b.c': 2, 'a.b': {$exists: true}}", kDocs);
+    assertCompiledMatchesLikeExpression("{'a.0': 1, 'a.b': 1}", kDocs);
+    assertCompiledMatchesLikeExpression("{a: {$exists: true}, 'a.b': {$exists: true}}", kDocs);
+}
+
+TEST(CompiledMatchExpressionTest, ConjunctionOfOtherLeaves) {
+    assertCompiledMatchesLikeExpression(
+        "{a: {$in: [1, 'x']}, b: {$type: 'number'}, d: {$mod: [2, 0]}}", kDocs);
+    assertCompiledMatchesLikeExpression("{a: {$regex: '^x'}, b: {$ne: 3}, d: {$gt: 1}}", kDocs);
+    assertCompiledMatchesLikeExpression("{a: {$size: 2}, b: 2}", kDocs);
+}
+
+TEST(CompiledMatchExpressionTest, ConjunctionWithNonLeafChildren) {
+    assertCompiledMatchesLikeExpression("{a: 1, b: 2, $or: [{d: 4}, {b: 3}]}", kDocs);
+    assertCompiledMatchesLikeExpression("{'a.b': 1, d: 4, a: {$elemMatch: {b: 5}}}", kDocs);
+    assertCompiledMatchesLikeExpression("{'a.b': 1, d: 4, 'a.c': {$not: {$gt: 2}}}", kDocs);
+}
+
+TEST(CompiledMatchExpressionTest, DoesNotCompileExpressionsWithFewLeaves) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    ASSERT_FALSE(CompiledMatchExpression::compile(parse(fromjson("{a: 1}"), expCtx).get()));
+    ASSERT_FALSE(CompiledMatchExpression::compile(
+        parse(fromjson("{$or: [{a: 1}, {b: 2}]}"), expCtx).get()));
+    ASSERT_FALSE(CompiledMatchExpression::compile(
+        parse(fromjson("{a: 1, $or: [{a: 1}, {b: 2}]}"), expCtx).get()));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -221,7 +221,8 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
     : LeafMatchExpression(REGEX, path, std::move(annotation)),
       _regex(regex.toString()),
       _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags, true))) {
+      _re(std::make_shared<const pcrecpp::RE>(_regex.c_str(),
+                                              regex_util::flagsToPcreOptions(_flags, true))) {
 
     uassert(ErrorCodes::BadValue,
             "Regular expression cannot contain an embedded null byte",
@@ -398,7 +399,8 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
 }
 
 bool InMatchExpression::contains(const BSONElement& e) const {
-    return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
+    return std::binary_search(
+        _equalitySet->begin(), _equalitySet->end(), e, _eltCmp.makeLessThan());
 }
 
 bool InMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
@@ -420,7 +422,7 @@ void InMatchExpression::debugString(StringBuilder& debug, int indentationLevel)
     _debugAddSpace(debug, indentationLevel);
     debug << path() << " $in ";
     debug << "[ ";
-    for (auto&& equality : _equalitySet) {
+    for (auto&& equality : *_equalitySet) {
         debug << equality.toString(false) << " ";
     }
     for (auto&& regex : _regexes) {
@@ -439,7 +441,7 @@ void InMatchExpression::debugString(StringBuilder& debug, int indentationLevel)
 BSONObj InMatchExpression::getSerializedRightHandSide() const {
     BSONObjBuilder inBob;
     BSONArrayBuilder arrBob(inBob.subarrayStart("$in"));
-    for (auto&& _equality : _equalitySet) {
+    for (auto&& _equality : *_equalitySet) {
         arrBob.append(_equality);
     }
     for (auto&& _regex : _regexes) {
@@ -476,18 +478,22 @@ bool InMatchExpression::equivalent(const MatchExpression* other) const {
     // We use an element-wise comparison to check equivalence of '_equalitySet'.  Unfortunately, we
     // can't use BSONElementSet::operator==(), as it does not use the comparator object the set is
     // initialized with (and as such, it is not collation-aware).
-    if (_equalitySet.size() != realOther->_equalitySet.size()) {
+    if (_equalitySet->size() != realOther->_equalitySet->size()) {
         return false;
     }
-    auto thisEqIt = _equalitySet.begin();
-    auto otherEqIt = realOther->_equalitySet.begin();
-    for (; thisEqIt != _equalitySet.end(); ++thisEqIt, ++otherEqIt) {
+    if (_equalitySet == realOther->_equalitySet) {
+        // Clones share their equalities.
+        return true;
+    }
+    auto thisEqIt = _equalitySet->begin();
+    auto otherEqIt = realOther->_equalitySet->begin();
+    for (; thisEqIt != _equalitySet->end(); ++thisEqIt, ++otherEqIt) {
         const bool considerFieldName = false;
         if (thisEqIt->woCompare(*otherEqIt, considerFieldName, _collator)) {
             return false;
         }
     }
-    invariant(otherEqIt == realOther->_equalitySet.end());
+    invariant(otherEqIt == realOther->_equalitySet->end());
     return true;
 }
 
@@ -495,20 +501,10 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
     _collator = collator;
     _eltCmp = BSONElementComparator(BSONElementComparator::FieldNamesMode::kIgnore, _collator);
 
-    if (!std::is_sorted(_originalEqualityVector.begin(),
-                        _originalEqualityVector.end(),
-                        _eltCmp.makeLessThan())) {
-        std::sort(
-            _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
-    }
-
     // We need to re-compute '_equalitySet', since our set comparator has changed.
-    _equalitySet.clear();
-    _equalitySet.reserve(_originalEqualityVector.size());
-    std::unique_copy(_originalEqualityVector.begin(),
-                     _originalEqualityVector.end(),
-                     std::back_inserter(_equalitySet),
-                     _eltCmp.makeEqualTo());
+    if (!_originalEqualityVector->empty()) {
+        _sortAndDedupEqualities(*_originalEqualityVector);
+    }
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -527,23 +523,31 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
         }
     }
 
-    _originalEqualityVector = std::move(equalities);
+    _sortAndDedupEqualities(std::move(equalities));
+    return Status::OK();
+}
 
-    if (!std::is_sorted(_originalEqualityVector.begin(),
-                        _originalEqualityVector.end(),
-                        _eltCmp.makeLessThan())) {
-        std::sort(
-            _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
+void InMatchExpression::_sortAndDedupEqualities(std::vector<BSONElement> equalities) {
+    if (!std::is_sorted(equalities.begin(), equalities.end(), _eltCmp.makeLessThan())) {
+        std::sort(equalities.begin(), equalities.end(), _eltCmp.makeLessThan());
     }
 
-    _equalitySet.clear();
-    _equalitySet.reserve(_originalEqualityVector.size());
-    std::unique_copy(_originalEqualityVector.begin(),
-                     _originalEqualityVector.end(),
-                     std::back_inserter(_equalitySet),
-                     _eltCmp.makeEqualTo());
+    auto original = std::make_shared<const std::vector<BSONElement>>(std::move(equalities));
+    if (std::adjacent_find(original->begin(), original->end(), _eltCmp.makeEqualTo()) ==
+        original->end()) {
+        _originalEqualityVector = original;
+        _equalitySet = std::move(original);
+        return;
+    }
 
-    return Status::OK();
+    std::vector<BSONElement> equalitySet;
+    equalitySet.reserve(original->size());
+    std::unique_copy(original->begin(),
+                     original->end(),
+                     std::back_inserter(equalitySet),
+                     _eltCmp.makeEqualTo());
+    _originalEqualityVector = std::move(original);
+    _equalitySet = std::make_shared<const std::vector<BSONElement>>(std::move(equalitySet));
 }
 
 Status InMatchExpression::addRegex(std::unique_ptr<RegexMatchExpression> expr) {
@@ -557,7 +561,7 @@ MatchExpression::ExpressionOptimizerFunc InMatchExpression::getOptimizer() const
         // _regexes list. We assume that optimize() on a RegexMatchExpression is a no-op.
 
         auto& regexList = static_cast<InMatchExpression&>(*expression)._regexes;
-        auto& equalitySet = static_cast<InMatchExpression&>(*expression)._equalitySet;
+        auto& equalitySet = static_cast<InMatchExpression&>(*expression).getEqualities();
         auto collator = static_cast<InMatchExpression&>(*expression).getCollator();
         if (regexList.size() == 1 && equalitySet.empty()) {
             // Simplify IN of exactly one regex to be a regex match.
@@ -409,8 +409,9 @@ public:
     ~RegexMatchExpression();
 
     virtual std::unique_ptr<MatchExpression> shallowClone() const {
-        std::unique_ptr<RegexMatchExpression> e =
-            std::make_unique<RegexMatchExpression>(path(), _regex, _flags, _errorAnnotation);
+        // The clone shares the already compiled regular expression rather than compiling it again.
+        std::unique_ptr<RegexMatchExpression> e(
+            new RegexMatchExpression(path(), _regex, _flags, _re, _errorAnnotation));
         if (getTag()) {
             e->setTag(getTag()->clone());
         }
@@ -445,6 +446,16 @@ public:
     }
 
 private:
+    RegexMatchExpression(StringData path,
+                         std::string regex,
+                         std::string flags,
+                         std::shared_ptr<const pcrecpp::RE> re,
+                         clonable_ptr<ErrorAnnotation> annotation)
+        : LeafMatchExpression(REGEX, path, std::move(annotation)),
+          _regex(std::move(regex)),
+          _flags(std::move(flags)),
+          _re(std::move(re)) {}
+
     ExpressionOptimizerFunc getOptimizer() const final {
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
     }
@@ -453,7 +464,9 @@ private:
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+    // Matching through a pcrecpp::RE does not modify it, so clones of this expression can share
+    // the compiled regular expression.
+    std::shared_ptr<const pcrecpp::RE> _re;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -574,7 +587,7 @@ public:
     Status addRegex(std::unique_ptr<RegexMatchExpression> expr);
 
     const std::vector<BSONElement>& getEqualities() const {
-        return _equalitySet;
+        return *_equalitySet;
     }
 
     bool contains(const BSONElement& e) const;
@@ -606,6 +619,10 @@ public:
 private:
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    // Sorts 'equalities' according to '_eltCmp', installs them as '_originalEqualityVector' and
+    // recomputes '_equalitySet' from them.
+    void _sortAndDedupEqualities(std::vector<BSONElement> equalities);
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -623,7 +640,13 @@ private:
     //
     // We keep the equalities in sorted order according to the current BSON element comparator. This
     // enables a fast-path to avoid re-sorting if the expression is serialized and re-parsed.
-    std::vector<BSONElement> _originalEqualityVector;
+    //
+    // Both containers are immutable and shared with clones of this expression, since the planner
+    // clones the query many times and an $in may have tens of thousands of elements. They are
+    // replaced rather than modified when the collator changes. When there are no duplicates, both
+    // members point to the same vector.
+    std::shared_ptr<const std::vector<BSONElement>> _originalEqualityVector =
+        std::make_shared<const std::vector<BSONElement>>();
 
     // Deduped set of equality elements associated with this expression. Kept in sorted order to
     // support std::binary_search. Because we need to sort the elements anyway for things like index
@@ -631,7 +654,7 @@ private:
     // doesn't pay for itself in the common case where lookups are done a few times if ever.
     // TODO It may be worth dynamically creating a hashset after matchesSingleElement() has been
     // called "many" times.
-    std::vector<BSONElement> _equalitySet;
+    std::shared_ptr<const std::vector<BSONElement>> _equalitySet = _originalEqualityVector;
 
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
@@ -915,6 +915,22 @@ TEST(RegexMatchExpression, Equality1) {
     ASSERT(!r1.equivalent(&r4));
 }
 
+TEST(RegexMatchExpression, ShallowCloneMatchesLikeOriginal) {
+    RegexMatchExpression regex("a", "^ab.c", "is");
+    auto clone = regex.shallowClone();
+
+    ASSERT(regex.equivalent(clone.get()));
+    for (auto&& doc : {BSON("a"
+                            << "AB\nC"),
+                       BSON("a"
+                            << "xabc"),
+                       BSON("a" << 1)}) {
+        ASSERT_EQ(regex.matchesBSON(doc), clone->matchesBSON(doc));
+    }
+    ASSERT(clone->matchesBSON(BSON("a"
+                                   << "AB\nC")));
+}
+
 TEST(RegexMatchExpression, RegexCannotContainEmbeddedNullByte) {
     {
         const auto embeddedNull = "a\0b"_sd;
@@ -1370,6 +1386,28 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, ChangingCollationOfCloneDoesNotAffectOriginal) {
+    BSONObj obj1 = BSON(""
+                        << "string1");
+    BSONObj obj2 = BSON(""
+                        << "string2");
+    CollatorInterfaceMock collatorAlwaysEqual(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    CollatorInterfaceMock collatorReverseString(CollatorInterfaceMock::MockType::kReverseString);
+    InMatchExpression in("");
+    in.setCollator(&collatorAlwaysEqual);
+    std::vector<BSONElement> equalities{obj1.firstElement(), obj2.firstElement()};
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    auto clone = in.shallowClone();
+    auto inClone = static_cast<InMatchExpression*>(clone.get());
+    ASSERT(&inClone->getEqualities() == &in.getEqualities());
+    ASSERT(inClone->equivalent(&in));
+
+    inClone->setCollator(&collatorReverseString);
+    ASSERT(inClone->getEqualities().size() == 2);
+    ASSERT(in.getEqualities().size() == 1);
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -353,6 +353,34 @@ Status checkIfTransactionOnCappedColl(OperationContext* opCtx, const CollectionP
     return Status::OK();
 }
 
+/**
+ * Limits how many documents performInserts groups into one storage transaction. A multi-document
+ * batch that fails is rolled back and retried one document at a time, so after such a failure the
+ * limit is halved. Each batch inserted in one piece doubles it again, up to
+ * 'internalInsertMaxBatchSize'. Inserts that keep hitting write conflicts or duplicate keys thus
+ * stop paying for large transactions that are thrown away.
+ */
+class InsertBatchSizeLimit {
+public:
+    InsertBatchSizeLimit() : _max(internalInsertMaxBatchSize.load()), _current(_max) {}
+
+    size_t get() const {
+        return _current;
+    }
+
+    void onBatchInserted() {
+        _current = std::min(_current * 2, _max);
+    }
+
+    void onBatchFailed() {
+        _current = std::max<size_t>(_current / 2, 1);
+    }
+
+private:
+    const size_t _max;
+    size_t _current;
+};
+
 /**
  * Returns true if caller should try to insert more documents. Does nothing else if batch is empty.
  */
@@ -361,7 +389,8 @@ bool insertBatchAndHandleErrors(OperationContext* opCtx,
                                 std::vector<InsertStatement>& batch,
                                 LastOpFixer* lastOpFixer,
                                 WriteResult* out,
-                                bool fromMigrate) {
+                                bool fromMigrate,
+                                InsertBatchSizeLimit* batchSizeLimit) {
     if (batch.empty())
         return true;
 
@@ -446,12 +475,14 @@ bool insertBatchAndHandleErrors(OperationContext* opCtx,
 
                 std::fill_n(std::back_inserter(out->results), batch.size(), std::move(result));
                 curOp.debug().additiveMetrics.incrementNinserted(batch.size());
+                batchSizeLimit->onBatchInserted();
                 return true;
             }
         } catch (const DBException&) {
             // Ignore this failure and behave as if we never tried to do the combined batch
             // insert. The loop below will handle reporting any non-transient errors.
             collection.reset();
+            batchSizeLimit->onBatchFailed();
         }
     }
 
@@ -561,9 +592,9 @@ WriteResult performInserts(OperationContext* opCtx,
     size_t stmtIdIndex = 0;
     size_t bytesInBatch = 0;
     std::vector<InsertStatement> batch;
-    const size_t maxBatchSize = internalInsertMaxBatchSize.load();
+    InsertBatchSizeLimit batchSizeLimit;
     const size_t maxBatchBytes = write_ops::insertVectorMaxBytes;
-    batch.reserve(std::min(wholeOp.getDocuments().size(), maxBatchSize));
+    batch.reserve(std::min(wholeOp.getDocuments().size(), batchSizeLimit.get()));
 
     for (auto&& doc : wholeOp.getDocuments()) {
         const bool isLastDoc = (&doc == &wholeOp.getDocuments().back());
@@ -585,12 +616,12 @@ WriteResult performInserts(OperationContext* opCtx,
             batch.emplace_back(stmtId, toInsert);
             bytesInBatch += batch.back().doc.objsize();
 
-            if (!isLastDoc && batch.size() < maxBatchSize && bytesInBatch < maxBatchBytes)
+            if (!isLastDoc && batch.size() < batchSizeLimit.get() && bytesInBatch < maxBatchBytes)
                 continue;  // Add more to batch before inserting.
         }
 
-        bool canContinue =
-            insertBatchAndHandleErrors(opCtx, wholeOp, batch, &lastOpFixer, &out, fromMigrate);
+        bool canContinue = insertBatchAndHandleErrors(
+            opCtx, wholeOp, batch, &lastOpFixer, &out, fromMigrate, &batchSizeLimit);
         batch.clear();  // We won't need the current batch any more.
         bytesInBatch = 0;
 
@@ -246,7 +246,7 @@ public:
 private:
     BSONType totalType = NumberInt;
     DoubleDoubleSummation nonDecimalTotal;
-    Decimal128 decimalTotal;
+    DecimalSummation decimalTotal;
 };
 
 class AccumulatorMinMax : public AccumulatorState {
@@ -329,7 +329,7 @@ private:
 
     bool _isDecimal;
     DoubleDoubleSummation _nonDecimalTotal;
-    Decimal128 _decimalTotal;
+    DecimalSummation _decimalTotal;
     long long _count;
 };
 
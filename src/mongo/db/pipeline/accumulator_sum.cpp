@@ -78,7 +78,7 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
             nonDecimalTotal.addDouble(input.getDouble());
             break;
         case NumberDecimal:
-            decimalTotal = decimalTotal.add(input.coerceToDecimal());
+            decimalTotal.add(input.coerceToDecimal());
             break;
         default:
             MONGO_UNREACHABLE;
@@ -119,7 +119,7 @@ Value AccumulatorSum::getValue(bool toBeMerged) {
         case NumberDouble:
             return Value(nonDecimalTotal.getDouble());
         case NumberDecimal: {
-            return Value(decimalTotal.add(nonDecimalTotal.getDecimal()));
+            return Value(decimalTotal.getDecimal().add(nonDecimalTotal.getDecimal()));
         }
         default:
             MONGO_UNREACHABLE;
@@ -122,13 +122,22 @@ class Document;
  * REGISTER_MULTI_STAGE_ALIAS(foo,
  *                            LiteParsedDocumentSourceDefault::parse,
  *                            DocumentSourceFoo::createFromBson);
+ *
+ * REGISTER_MULTI_STAGE_ALIAS_CONDITIONALLY only registers the alias if the trailing condition
+ * holds, in the same way as REGISTER_DOCUMENT_SOURCE_CONDITIONALLY.
  */
-#define REGISTER_MULTI_STAGE_ALIAS(key, liteParser, fullParser)                  \
-    MONGO_INITIALIZER(addAliasToDocSourceParserMap_##key)(InitializerContext*) { \
-        LiteParsedDocumentSource::registerParser("$" #key, (liteParser));        \
-        DocumentSource::registerParser("$" #key, (fullParser), boost::none);     \
+#define REGISTER_MULTI_STAGE_ALIAS_CONDITIONALLY(key, liteParser, fullParser, ...) \
+    MONGO_INITIALIZER(addAliasToDocSourceParserMap_##key)(InitializerContext*) {    \
+        if (!__VA_ARGS__) {                                                         \
+            return;                                                                 \
+        }                                                                           \
+        LiteParsedDocumentSource::registerParser("$" #key, (liteParser));           \
+        DocumentSource::registerParser("$" #key, (fullParser), boost::none);        \
     }
 
+#define REGISTER_MULTI_STAGE_ALIAS(key, liteParser, fullParser) \
+    REGISTER_MULTI_STAGE_ALIAS_CONDITIONALLY(key, liteParser, fullParser, true)
+
 class DocumentSource : public RefCountable {
 public:
     using Parser = std::function<std::list<boost::intrusive_ptr<DocumentSource>>(
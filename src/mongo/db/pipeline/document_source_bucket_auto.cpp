@@ -145,18 +145,18 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
             opts.tempDir = pExpCtx->tempDir;
         }
         const auto& valueCmp = pExpCtx->getValueComparator();
-        auto comparator = [valueCmp](const Sorter<Value, Document>::Data& lhs,
-                                     const Sorter<Value, Document>::Data& rhs) {
+        auto comparator = [valueCmp](const Sorter<Value, Value>::Data& lhs,
+                                     const Sorter<Value, Value>::Data& rhs) {
             return valueCmp.compare(lhs.first, rhs.first);
         };
 
-        _sorter.reset(Sorter<Value, Document>::make(opts, comparator));
+        _sorter.reset(Sorter<Value, Value>::make(opts, comparator));
     }
 
     auto next = pSource->getNext();
     for (; next.isAdvanced(); next = pSource->getNext()) {
         auto nextDoc = next.releaseDocument();
-        _sorter->add(extractKey(nextDoc), nextDoc);
+        _sorter->emplace(extractKey(nextDoc), extractAccumulatorArguments(nextDoc));
         ++_nDocuments;
     }
     return next;
@@ -193,16 +193,42 @@ Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     return key.missing() ? Value(BSONNULL) : std::move(key);
 }
 
-void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>& entry,
+Value DocumentSourceBucketAuto::extractAccumulatorArguments(const Document& doc) {
+    switch (_accumulatedFields.size()) {
+        case 0:
+            return Value();
+        case 1:
+            return _accumulatedFields[0].expr.argument->evaluate(doc, &pExpCtx->variables);
+        default: {
+            std::vector<Value> arguments;
+            arguments.reserve(_accumulatedFields.size());
+            for (auto&& accumulatedField : _accumulatedFields) {
+                arguments.push_back(
+                    accumulatedField.expr.argument->evaluate(doc, &pExpCtx->variables));
+            }
+            return Value(std::move(arguments));
+        }
+    }
+}
+
+void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Value>& entry,
                                                    Bucket& bucket) {
     invariant(pExpCtx->getValueComparator().evaluate(entry.first >= bucket._max));
     bucket._max = entry.first;
 
     const size_t numAccumulators = _accumulatedFields.size();
-    for (size_t k = 0; k < numAccumulators; k++) {
-        bucket._accums[k]->process(
-            _accumulatedFields[k].expr.argument->evaluate(entry.second, &pExpCtx->variables),
-            false);
+    switch (numAccumulators) {  // mirrors switch in extractAccumulatorArguments()
+        case 0:
+            break;
+        case 1:
+            bucket._accums[0]->process(entry.second, false);
+            break;
+        default: {
+            const auto& arguments = entry.second.getArray();
+            for (size_t k = 0; k < numAccumulators; k++) {
+                bucket._accums[k]->process(arguments[k], false);
+            }
+        }
     }
 }
 
@@ -233,10 +259,10 @@ void DocumentSourceBucketAuto::initalizeBucketIteration() {
     }
 }
 
-boost::optional<pair<Value, Document>>
+boost::optional<pair<Value, Value>>
 DocumentSourceBucketAuto::adjustBoundariesAndGetMinForNextBucket(Bucket* currentBucket) {
     auto getNextValIfPresent = [this]() {
-        return _sortedInput->more() ? boost::optional<pair<Value, Document>>(_sortedInput->next())
+        return _sortedInput->more() ? boost::optional<pair<Value, Value>>(_sortedInput->next())
                                     : boost::none;
     };
 
@@ -290,7 +316,7 @@ boost::optional<DocumentSourceBucketAuto::Bucket> DocumentSourceBucketAuto::popu
         return {};
     }
 
-    std::pair<Value, Document> currentValue =
+    std::pair<Value, Value> currentValue =
         _currentBucketDetails.currentMin ? *_currentBucketDetails.currentMin : _sortedInput->next();
 
     Bucket currentBucket(pExpCtx, currentValue.first, currentValue.first, _accumulatedFields);
@@ -122,14 +122,17 @@ private:
         int currentBucketNum;
         long long approxBucketSize = 0;
         boost::optional<Value> previousMax;
-        boost::optional<std::pair<Value, Document>> currentMin;
+        boost::optional<std::pair<Value, Value>> currentMin;
     };
 
     /**
      * Consumes all of the documents from the source in the pipeline and sorts them by their
-     * 'groupBy' value. This method might not be able to finish populating the sorter in a single
-     * call if 'pSource' returns a DocumentSource::GetNextResult::kPauseExecution, so this returns
-     * the last GetNextResult encountered, which may be either kEOF or kPauseExecution.
+     * 'groupBy' value. Rather than whole documents, the sorter holds only what the accumulators
+     * need from each document: the values of their arguments, as built by
+     * extractAccumulatorArguments(). This method might not be able to finish populating the sorter
+     * in a single call if 'pSource' returns a DocumentSource::GetNextResult::kPauseExecution, so
+     * this returns the last GetNextResult encountered, which may be either kEOF or
+     * kPauseExecution.
      */
     GetNextResult populateSorter();
 
@@ -140,17 +143,24 @@ private:
      */
     Value extractKey(const Document& doc);
 
+    /**
+     * Evaluates the argument of each accumulator against 'doc'. Like a spilled $group, this returns
+     * the lone argument if there is a single accumulator, or an array of the arguments otherwise.
+     */
+    Value extractAccumulatorArguments(const Document& doc);
+
     /**
      * Returns the next bucket if exists. boost::none if none exist.
      */
     boost::optional<Bucket> populateNextBucket();
 
-    boost::optional<std::pair<Value, Document>> adjustBoundariesAndGetMinForNextBucket(
+    boost::optional<std::pair<Value, Value>> adjustBoundariesAndGetMinForNextBucket(
         Bucket* currentBucket);
     /**
-     * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'.
+     * Adds the document in 'entry', made up of its 'groupBy' value and its accumulator arguments,
+     * to 'bucket' by updating the accumulators in 'bucket'.
      */
-    void addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
+    void addDocumentToBucket(const std::pair<Value, Value>& entry, Bucket& bucket);
 
     /**
      * Makes a document using the information from bucket. This is what is returned when getNext()
@@ -158,8 +168,8 @@ private:
      */
     Document makeDocument(const Bucket& bucket);
 
-    std::unique_ptr<Sorter<Value, Document>> _sorter;
-    std::unique_ptr<Sorter<Value, Document>::Iterator> _sortedInput;
+    std::unique_ptr<Sorter<Value, Value>> _sorter;
+    std::unique_ptr<Sorter<Value, Value>::Iterator> _sortedInput;
 
     std::vector<AccumulationStatement> _accumulatedFields;
 
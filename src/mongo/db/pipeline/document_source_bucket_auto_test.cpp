@@ -41,6 +41,7 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source_bucket_auto.h"
@@ -56,6 +57,24 @@ using std::deque;
 using std::string;
 using std::vector;
 
+/**
+ * Returns a count accumulator along with one that keeps the value of the 'largeStr' field. The
+ * stage only buffers what its accumulators need from each document, so tests which exercise the
+ * memory limit must accumulate the large field for it to count against that limit.
+ */
+vector<AccumulationStatement> makeCountAndLargeStrAccumulators(
+    const intrusive_ptr<ExpressionContext>& expCtx) {
+    auto countArg = BSON("" << 1);
+    auto countExpr = AccumulationStatement::getParser("$sum", boost::none)(
+        expCtx.get(), countArg.firstElement(), expCtx->variablesParseState);
+    auto largeStrArg = BSON(""
+                            << "$largeStr");
+    auto largeStrExpr = AccumulationStatement::getParser("$max", boost::none)(
+        expCtx.get(), largeStrArg.firstElement(), expCtx->variablesParseState);
+    return {AccumulationStatement{"count", countExpr},
+            AccumulationStatement{"largeStr", largeStrExpr}};
+}
+
 class BucketAutoTests : public AggregationContextFixture {
 public:
     intrusive_ptr<DocumentSource> createBucketAuto(BSONObj bucketAutoSpec) {
@@ -378,8 +397,13 @@ TEST_F(BucketAutoTests, ShouldBeAbleToCorrectlySpillToDisk) {
     auto groupByExpression = ExpressionFieldPath::parse(expCtx.get(), "$a", vps);
 
     const int numBuckets = 2;
-    auto bucketAutoStage = DocumentSourceBucketAuto::create(
-        expCtx, groupByExpression, numBuckets, {}, nullptr, maxMemoryUsageBytes);
+    auto bucketAutoStage =
+        DocumentSourceBucketAuto::create(expCtx,
+                                         groupByExpression,
+                                         numBuckets,
+                                         makeCountAndLargeStrAccumulators(expCtx),
+                                         nullptr,
+                                         maxMemoryUsageBytes);
 
     string largeStr(maxMemoryUsageBytes, 'x');
     auto mock = DocumentSourceMock::createForTest({Document{{"a", 0}, {"largeStr", largeStr}},
@@ -392,12 +416,16 @@ TEST_F(BucketAutoTests, ShouldBeAbleToCorrectlySpillToDisk) {
     auto next = bucketAutoStage->getNext();
     ASSERT_TRUE(next.isAdvanced());
     ASSERT_DOCUMENT_EQ(next.releaseDocument(),
-                       (Document{{"_id", Document{{"min", 0}, {"max", 2}}}, {"count", 2}}));
+                       (Document{{"_id", Document{{"min", 0}, {"max", 2}}},
+                                 {"count", 2},
+                                 {"largeStr", largeStr}}));
 
     next = bucketAutoStage->getNext();
     ASSERT_TRUE(next.isAdvanced());
     ASSERT_DOCUMENT_EQ(next.releaseDocument(),
-                       (Document{{"_id", Document{{"min", 2}, {"max", 3}}}, {"count", 2}}));
+                       (Document{{"_id", Document{{"min", 2}, {"max", 3}}},
+                                 {"count", 2},
+                                 {"largeStr", largeStr}}));
 
     ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
 }
@@ -415,8 +443,13 @@ TEST_F(BucketAutoTests, ShouldBeAbleToPauseLoadingWhileSpilled) {
     auto groupByExpression = ExpressionFieldPath::parse(expCtx.get(), "$a", vps);
 
     const int numBuckets = 2;
-    auto bucketAutoStage = DocumentSourceBucketAuto::create(
-        expCtx, groupByExpression, numBuckets, {}, nullptr, maxMemoryUsageBytes);
+    auto bucketAutoStage =
+        DocumentSourceBucketAuto::create(expCtx,
+                                         groupByExpression,
+                                         numBuckets,
+                                         makeCountAndLargeStrAccumulators(expCtx),
+                                         nullptr,
+                                         maxMemoryUsageBytes);
     auto sort = DocumentSourceSort::create(expCtx, BSON("_id" << -1), 0, maxMemoryUsageBytes);
 
     string largeStr(maxMemoryUsageBytes, 'x');
@@ -439,12 +472,16 @@ TEST_F(BucketAutoTests, ShouldBeAbleToPauseLoadingWhileSpilled) {
     auto next = bucketAutoStage->getNext();
     ASSERT_TRUE(next.isAdvanced());
     ASSERT_DOCUMENT_EQ(next.releaseDocument(),
-                       (Document{{"_id", Document{{"min", 0}, {"max", 2}}}, {"count", 2}}));
+                       (Document{{"_id", Document{{"min", 0}, {"max", 2}}},
+                                 {"count", 2},
+                                 {"largeStr", largeStr}}));
 
     next = bucketAutoStage->getNext();
     ASSERT_TRUE(next.isAdvanced());
     ASSERT_DOCUMENT_EQ(next.releaseDocument(),
-                       (Document{{"_id", Document{{"min", 2}, {"max", 3}}}, {"count", 2}}));
+                       (Document{{"_id", Document{{"min", 2}, {"max", 3}}},
+                                 {"count", 2},
+                                 {"largeStr", largeStr}}));
 
     ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
 }
@@ -657,8 +694,13 @@ void assertCannotSpillToDisk(const boost::intrusive_ptr<ExpressionContext>& expC
     auto groupByExpression = ExpressionFieldPath::parse(expCtx.get(), "$a", vps);
 
     const int numBuckets = 2;
-    auto bucketAutoStage = DocumentSourceBucketAuto::create(
-        expCtx, groupByExpression, numBuckets, {}, nullptr, maxMemoryUsageBytes);
+    auto bucketAutoStage =
+        DocumentSourceBucketAuto::create(expCtx,
+                                         groupByExpression,
+                                         numBuckets,
+                                         makeCountAndLargeStrAccumulators(expCtx),
+                                         nullptr,
+                                         maxMemoryUsageBytes);
 
     string largeStr(maxMemoryUsageBytes, 'x');
     auto mock = DocumentSourceMock::createForTest(
@@ -696,8 +738,13 @@ TEST_F(BucketAutoTests, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     auto groupByExpression = ExpressionFieldPath::parse(expCtx.get(), "$a", vps);
 
     const int numBuckets = 2;
-    auto bucketAutoStage = DocumentSourceBucketAuto::create(
-        expCtx, groupByExpression, numBuckets, {}, nullptr, maxMemoryUsageBytes);
+    auto bucketAutoStage =
+        DocumentSourceBucketAuto::create(expCtx,
+                                         groupByExpression,
+                                         numBuckets,
+                                         makeCountAndLargeStrAccumulators(expCtx),
+                                         nullptr,
+                                         maxMemoryUsageBytes);
 
     string largeStr(maxMemoryUsageBytes / 2, 'x');
     auto mock =
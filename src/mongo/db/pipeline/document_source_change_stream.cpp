@@ -277,7 +277,9 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
         BSON("$and" << BSON_ARRAY(cmdNsFilter << BSON("$or" << relevantCommands.arr())));
 
     // 1.2) Supported commands that have arbitrary db namespaces in "ns" field.
-    auto renameDropTarget = BSON("o.to" << BSONRegEx(getNsRegexForChangeStream(nss)));
+    auto renameDropTarget = (sourceType == ChangeStreamType::kSingleCollection
+                                 ? BSON("o.to" << nss.ns())
+                                 : BSON("o.to" << BSONRegEx(getNsRegexForChangeStream(nss))));
 
     // 1.3) Transaction commit commands.
     auto transactionCommit = BSON("o.commitTransaction" << 1);
@@ -288,8 +290,11 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
                                 << OR(commandsOnTargetDb, renameDropTarget, transactionCommit));
 
     // 2) Supported operations on the operation namespace, optionally including those from
-    // migrations.
-    BSONObj opNsMatch = BSON("ns" << BSONRegEx(getNsRegexForChangeStream(nss)));
+    // migrations. Every oplog entry scanned by the stream is tested against this predicate, so a
+    // single-collection stream matches its namespace by equality rather than by regex.
+    BSONObj opNsMatch = (sourceType == ChangeStreamType::kSingleCollection
+                             ? BSON("ns" << nss.ns())
+                             : BSON("ns" << BSONRegEx(getNsRegexForChangeStream(nss))));
 
     // 2.1) Normal CRUD ops.
     auto normalOpTypeMatch = BSON("op" << NE << "n");
@@ -1958,6 +1958,21 @@ TEST_F(ChangeStreamStageTest, MatchFiltersNoOp) {
     checkTransformation(noOp, boost::none);
 }
 
+TEST_F(ChangeStreamStageTest, MatchFiltersChangesOnOtherCollections) {
+    std::set<NamespaceString> unmatchedNamespaces = {
+        // Namespace starts with the collection's namespace, but is longer.
+        NamespaceString("unittests.change_stream2"),
+        NamespaceString("unittests.change_stream.child"),
+        // Namespace ends with the collection's namespace.
+        NamespaceString("other.unittests.change_stream"),
+    };
+
+    for (auto& ns : unmatchedNamespaces) {
+        auto insert = makeOplogEntry(OpTypeEnum::kInsert, ns, BSON("_id" << 1));
+        checkTransformation(insert, boost::none);
+    }
+}
+
 TEST_F(ChangeStreamStageTest, TransformationShouldBeAbleToReParseSerializedStage) {
     auto expCtx = getExpCtx();
 
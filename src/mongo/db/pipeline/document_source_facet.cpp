@@ -32,6 +32,7 @@
 #include "mongo/db/pipeline/document_source_facet.h"
 
 #include <memory>
+#include <numeric>
 #include <vector>
 
 #include "mongo/base/string_data.h"
@@ -160,18 +161,24 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     };
 
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
-    while (!allPipelinesEOF) {
-        allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
-        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
-            const auto& pipeline = _facets[facetId].pipeline;
-            auto next = pipeline->getSources().back()->getNext();
-            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+    // The facets that have yet to reach EOF. Each one drains the current batch of the TeeBuffer in
+    // turn, and a facet that is done, such as one that has reached its $limit, is not polled again.
+    vector<size_t> activeFacetIds(_facets.size());
+    std::iota(activeFacetIds.begin(), activeFacetIds.end(), 0);
+    while (!activeFacetIds.empty()) {
+        vector<size_t> stillActiveFacetIds;
+        for (size_t facetId : activeFacetIds) {
+            const auto& lastStage = _facets[facetId].pipeline->getSources().back();
+            auto next = lastStage->getNext();
+            for (; next.isAdvanced(); next = lastStage->getNext()) {
                 ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
                 results[facetId].emplace_back(next.releaseDocument());
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
+            if (!next.isEOF()) {
+                stillActiveFacetIds.push_back(facetId);
+            }
         }
+        activeFacetIds = std::move(stillActiveFacetIds);
     }
 
     MutableDocument resultDoc;
@@ -39,6 +39,8 @@
 #include "mongo/db/exec/document_value/document_comparator.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_merge_gen.h"
 #include "mongo/db/pipeline/expression.h"
@@ -216,7 +218,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        auto matchStages = makeMatchStagesFromFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier.swap(queried);
@@ -231,12 +233,11 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
-
-            // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+        // Query for all keys that were in the frontier and not in the cache, populating
+        // '_frontier' for the next iteration of search.
+        for (auto&& matchStage : matchStages) {
+            // We've already allocated space for the $match stage in '_fromPipeline'.
+            _fromPipeline[_matchStageIndex] = std::move(matchStage);
             MakePipelineOptions pipelineOpts;
             pipelineOpts.optimize = true;
             pipelineOpts.attachCursorSource = true;
@@ -319,7 +320,7 @@ void DocumentSourceGraphLookUp::addToCache(const Document& result,
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
+std::vector<BSONObj> DocumentSourceGraphLookUp::makeMatchStagesFromFrontier(
     DocumentUnorderedSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier.begin(); it != _frontier.end();) {
@@ -337,35 +338,43 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
+    // Create queries of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]},
+    // starting a new query whenever the $in list of the current one reaches the batch size.
     //
-    // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
+    // We wrap each query in a $match so that it can be parsed into a DocumentSourceMatch when
     // constructing a pipeline to execute.
-    BSONObjBuilder match;
-    {
-        BSONObjBuilder query(match.subobjStart("$match"));
+    const int maxBatchBytes = internalDocumentSourceGraphLookupFrontierBatchBytes.load();
+    std::vector<BSONObj> matchStages;
+    auto it = _frontier.begin();
+    while (it != _frontier.end()) {
+        BSONObjBuilder match;
         {
-            BSONArrayBuilder andObj(query.subarrayStart("$and"));
-            if (_additionalFilter) {
-                andObj << *_additionalFilter;
-            }
-
+            BSONObjBuilder query(match.subobjStart("$match"));
             {
-                BSONObjBuilder connectToObj(andObj.subobjStart());
+                BSONArrayBuilder andObj(query.subarrayStart("$and"));
+                if (_additionalFilter) {
+                    andObj << *_additionalFilter;
+                }
+
                 {
-                    BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                    BSONObjBuilder connectToObj(andObj.subobjStart());
                     {
-                        BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
-                            in << value;
+                        BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                        {
+                            BSONArrayBuilder in(subObj.subarrayStart("$in"));
+                            // Always add at least one value, so that every batch makes progress.
+                            do {
+                                in << *it;
+                            } while (++it != _frontier.end() && in.len() < maxBatchBytes);
                         }
                     }
                 }
             }
         }
+        matchStages.push_back(match.obj());
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return matchStages;
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
@@ -415,6 +424,13 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
 
+    // Recomputed on every call, since absorbing a following $unwind changes what the rest of the
+    // pipeline reads.
+    _fromPipeline.resize(_matchStageIndex + 1);
+    if (auto projection = computeFromProjection(itr, container)) {
+        _fromPipeline.push_back(BSON("$project" << *projection));
+    }
+
     if (std::next(itr) == container->end()) {
         return container->end();
     }
@@ -430,6 +446,43 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
     return std::next(itr);
 }
 
+boost::optional<BSONObj> DocumentSourceGraphLookUp::computeFromProjection(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) const {
+    // Collect what the rest of the pipeline reads, stopping at the first stage that determines
+    // all of its downstream field dependencies.
+    DepsTracker downstreamDeps;
+    bool knowAllFields = false;
+    for (auto it = std::next(itr); it != container->end() && !knowAllFields; ++it) {
+        auto state = (*it)->getDependencies(&downstreamDeps);
+        if (state == DepsTracker::State::NOT_SUPPORTED) {
+            return boost::none;
+        }
+        knowAllFields = state & DepsTracker::State::EXHAUSTIVE_FIELDS;
+    }
+    if (!knowAllFields || downstreamDeps.needWholeDocument) {
+        return boost::none;
+    }
+
+    const auto asPath = _as.fullPath();
+    DepsTracker fromDeps;
+    for (auto&& field : downstreamDeps.fields) {
+        if (field == asPath || expression::isPathPrefixOf(field, asPath)) {
+            // The whole of 'as' is read, for example by {$size: "$as"}.
+            return boost::none;
+        }
+        if (expression::isPathPrefixOf(asPath, field)) {
+            fromDeps.fields.insert(field.substr(asPath.size() + 1));
+        }
+    }
+
+    // The search itself reads the de-duplication key and both connect fields of every document it
+    // retrieves. When these are indexed together, the projection lets the queries be covered.
+    fromDeps.fields.insert(_from == NamespaceString::kRsOplogNamespace ? "ts" : "_id");
+    fromDeps.fields.insert(_connectFromField.fullPath());
+    fromDeps.fields.insert(_connectToField.fullPath());
+    return fromDeps.toProjectionWithoutMetadata();
+}
+
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
     // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
     uassert(40099,
@@ -521,7 +574,8 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     // We append an additional BSONObj to '_fromPipeline' as a placeholder for the $match stage
     // we'll eventually construct from the input document.
     _fromPipeline = resolvedNamespace.pipeline;
-    _fromPipeline.reserve(_fromPipeline.size() + 1);
+    _fromPipeline.reserve(_fromPipeline.size() + 2);
+    _matchStageIndex = _fromPipeline.size();
     _fromPipeline.push_back(BSON("$match" << BSONObj()));
 }
 
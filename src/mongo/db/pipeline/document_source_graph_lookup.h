@@ -142,6 +142,8 @@ protected:
 
     /**
      * Attempts to combine with a subsequent $unwind stage, setting the internal '_unwind' field.
+     * Also projects the documents retrieved from the 'from' collection down to the fields that the
+     * rest of the pipeline reads, when those are known.
      */
     Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
                                                      Pipeline::SourceContainer* container) final;
@@ -165,15 +167,24 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * Prepares the queries to execute on the 'from' collection wrapped in $match stages by using
+     * the contents of '_frontier'. A large frontier is split across several queries, each of whose
+     * $in lists is bounded by 'internalDocumentSourceGraphLookupFrontierBatchBytes'.
      *
      * Fills 'cached' with any values that were retrieved from the cache.
      *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Returns an empty vector if no query is necessary, i.e., all values were retrieved from the
+     * cache.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    std::vector<BSONObj> makeMatchStagesFromFrontier(DocumentUnorderedSet* cached);
+
+    /**
+     * Returns an inclusion projection over the documents of the 'from' collection if the stages
+     * following 'itr' in 'container' are known to read only some subfields of the 'as' path, or
+     * boost::none if they may need the whole documents.
+     */
+    boost::optional<BSONObj> computeFromProjection(Pipeline::SourceContainer::iterator itr,
+                                                   Pipeline::SourceContainer* container) const;
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -227,8 +238,11 @@ private:
     // namespace.
     boost::intrusive_ptr<ExpressionContext> _fromExpCtx;
 
-    // The aggregation pipeline to perform against the '_from' namespace.
+    // The aggregation pipeline to perform against the '_from' namespace. It ends with a $match
+    // stage at '_matchStageIndex' that is replaced for every query, optionally followed by a
+    // $project of the fields that the rest of the pipeline reads.
     std::vector<BSONObj> _fromPipeline;
+    size_t _matchStageIndex;
 
     size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
 
@@ -38,9 +38,12 @@
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_project.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -710,5 +713,147 @@ TEST_F(DocumentSourceGraphLookUpTest, ShouldNotExpandArraysWithinArraysAtEndOfCo
     ASSERT(graphLookupStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceGraphLookUpTest, ShouldProjectFromDocumentsToFieldsReadDownstream) {
+    auto expCtx = getExpCtx();
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    std::deque<DocumentSource::GetNextResult> fromContents{
+        Document{{"_id", 0}, {"to", 1}, {"name", "a"_sd}, {"pad", "x"_sd}},
+        Document{{"_id", 1}, {"name", "b"_sd}, {"pad", "x"_sd}}};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    auto graphLookupStage = DocumentSourceGraphLookUp::create(
+        expCtx,
+        fromNs,
+        "results",
+        "to",
+        "_id",
+        ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+        boost::none,
+        boost::none,
+        boost::none,
+        boost::none);
+    auto projectStage = DocumentSourceProject::createFromBson(
+        BSON("$project" << BSON("names"
+                                << "$results.name"))
+            .firstElement(),
+        expCtx);
+
+    Pipeline::SourceContainer container{graphLookupStage, projectStage};
+    graphLookupStage->optimizeAt(container.begin(), &container);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+
+    // Only the fields read by the $project and those the search needs are kept.
+    auto resultsArray = next.getDocument().getField("results").getArray();
+    ASSERT_EQ(2U, resultsArray.size());
+    Document projected0{{"_id", 0}, {"to", 1}, {"name", "a"_sd}};
+    Document projected1{{"_id", 1}, {"name", "b"_sd}};
+    ASSERT(arrayContains(expCtx, resultsArray, Value(projected0)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(projected1)));
+    ASSERT(graphLookupStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldNotProjectFromDocumentsIfAsFieldIsReadWhole) {
+    auto expCtx = getExpCtx();
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    Document fromDoc{{"_id", 0}, {"name", "a"_sd}, {"pad", "x"_sd}};
+    std::deque<DocumentSource::GetNextResult> fromContents{Document(fromDoc)};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    auto graphLookupStage = DocumentSourceGraphLookUp::create(
+        expCtx,
+        fromNs,
+        "results",
+        "to",
+        "_id",
+        ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+        boost::none,
+        boost::none,
+        boost::none,
+        boost::none);
+    auto projectStage = DocumentSourceProject::createFromBson(
+        BSON("$project" << BSON("n" << BSON("$size"
+                                            << "$results")))
+            .firstElement(),
+        expCtx);
+
+    Pipeline::SourceContainer container{graphLookupStage, projectStage};
+    graphLookupStage->optimizeAt(container.begin(), &container);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto resultsArray = next.getDocument().getField("results").getArray();
+    ASSERT_EQ(1U, resultsArray.size());
+    ASSERT_VALUE_EQ(Value(fromDoc), resultsArray[0]);
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldQueryLargeFrontierInBatches) {
+    auto expCtx = getExpCtx();
+
+    // With a batch size of a single byte, every frontier value is queried on its own.
+    const auto originalBatchBytes = internalDocumentSourceGraphLookupFrontierBatchBytes.load();
+    internalDocumentSourceGraphLookupFrontierBatchBytes.store(1);
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceGraphLookupFrontierBatchBytes.store(originalBatchBytes); });
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    Document startDoc{{"_id", 0}, {"to", std::vector{1, 2, 3}}};
+    Document middle1{{"_id", 1}, {"to", 4}};
+    Document middle2{{"_id", 2}, {"to", 4}};
+    Document middle3{{"_id", 3}, {"to", 4}};
+    Document sinkDoc{{"_id", 4}};
+    std::deque<DocumentSource::GetNextResult> fromContents{Document(startDoc),
+                                                           Document(middle1),
+                                                           Document(middle2),
+                                                           Document(middle3),
+                                                           Document(sinkDoc)};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    auto graphLookupStage = DocumentSourceGraphLookUp::create(
+        expCtx,
+        fromNs,
+        "results",
+        "to",
+        "_id",
+        ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+        boost::none,
+        boost::none,
+        boost::none,
+        boost::none);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+
+    auto resultsArray = next.getDocument().getField("results").getArray();
+    ASSERT_EQ(5U, resultsArray.size());
+    ASSERT(arrayContains(expCtx, resultsArray, Value(startDoc)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle1)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle2)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle3)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(sinkDoc)));
+    ASSERT(graphLookupStage->getNext().isEOF());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/util/destructor_guard.h"
 
@@ -168,6 +169,10 @@ int DocumentSourceGroup::freeMemory() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
+    if (_streaming) {
+        return getNextStreaming();
+    }
+
     if (!_initialized) {
         const auto initializationResult = initialize();
         if (initializationResult.isPaused()) {
@@ -245,6 +250,151 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     return out;
 }
 
+namespace {
+/**
+ * Returns true if a sort on the paths making up a group key component places every document with
+ * the value 'val' for that component next to each other. This does not hold for arrays, which
+ * sort by their smallest or largest element, nor for missing and undefined values, which sort
+ * together with null.
+ */
+bool sortsConsistentlyWithGrouping(const Value& val) {
+    return !val.missing() && val.getType() != BSONType::Undefined && !val.isArray();
+}
+}  // namespace
+
+DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
+    while (!_streamingInputExhausted) {
+        // Fall back to hash-based grouping, which knows how to spill, once a single group grows
+        // beyond the memory limit.
+        if (_haveStreamingGroup &&
+            _memoryTracker.memoryUsageBytes > _memoryTracker.maxMemoryUsageBytes) {
+            stopStreaming(boost::none);
+            return doGetNext();
+        }
+
+        auto input = pSource->getNext();
+        if (input.isPaused()) {
+            return input;
+        }
+        if (input.isEOF()) {
+            _streamingInputExhausted = true;
+            break;
+        }
+
+        auto rootDocument = input.releaseDocument();
+        Value id = computeId(rootDocument);
+
+        const bool streamable = _idExpressions.size() == 1
+            ? sortsConsistentlyWithGrouping(id)
+            : std::all_of(id.getArray().begin(), id.getArray().end(), [](const Value& val) {
+                  return sortsConsistentlyWithGrouping(val);
+              });
+        if (!streamable) {
+            // The documents sharing this key may be scattered through the remaining input. The
+            // groups returned so far are still complete, since every key compared strictly before
+            // this one in the input order.
+            stopStreaming(std::move(rootDocument));
+            return doGetNext();
+        }
+
+        if (!_haveStreamingGroup) {
+            startStreamingGroup(id);
+        } else if (!pExpCtx->getValueComparator().evaluate(_currentId == id)) {
+            Document out = makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+            startStreamingGroup(id);
+            accumulateStreaming(rootDocument);
+            return out;
+        }
+
+        accumulateStreaming(rootDocument);
+    }
+
+    if (!_haveStreamingGroup) {
+        return GetNextResult::makeEOF();
+    }
+
+    _haveStreamingGroup = false;
+    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+}
+
+void DocumentSourceGroup::startStreamingGroup(const Value& id) {
+    _currentId = id;
+    _currentAccumulators.clear();
+    _memoryTracker.memoryUsageBytes = id.getApproximateSize();
+
+    Value expandedId = expandId(id);
+    Document idDoc =
+        expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+    _currentAccumulators.reserve(_accumulatedFields.size());
+    for (size_t i = 0; i < _accumulatedFields.size(); ++i) {
+        auto accum = _accumulatedFields[i].makeAccumulator();
+        Value initializerValue =
+            _accumulatedFields[i].expr.initializer->evaluate(idDoc, &pExpCtx->variables);
+        accum->startNewGroup(initializerValue);
+        _currentAccumulators.push_back(accum);
+        _memoryTracker.accumStatementMemoryBytes[i].currentMemoryBytes = 0;
+    }
+    _haveStreamingGroup = true;
+}
+
+void DocumentSourceGroup::accumulateStreaming(const Document& root) {
+    for (size_t i = 0; i < _currentAccumulators.size(); ++i) {
+        auto& accum = _currentAccumulators[i];
+        const auto oldMemUsage = accum->memUsageForSorter();
+        accum->process(_accumulatedFields[i].expr.argument->evaluate(root, &pExpCtx->variables),
+                       _doingMerge);
+
+        auto& statementMemory = _memoryTracker.accumStatementMemoryBytes[i];
+        _memoryTracker.memoryUsageBytes += accum->memUsageForSorter() - oldMemUsage;
+        statementMemory.currentMemoryBytes += accum->memUsageForSorter() - oldMemUsage;
+        statementMemory.maxMemoryBytes =
+            std::max(statementMemory.maxMemoryBytes, statementMemory.currentMemoryBytes);
+    }
+}
+
+void DocumentSourceGroup::stopStreaming(boost::optional<Document> pending) {
+    _streaming = false;
+    if (_haveStreamingGroup) {
+        // The memory tracker already accounts for the group in progress.
+        (*_groups)[_currentId] = std::move(_currentAccumulators);
+        _haveStreamingGroup = false;
+    }
+    _currentAccumulators.clear();
+    _pendingDocument = std::move(pending);
+}
+
+bool DocumentSourceGroup::enableStreamingIfInputSortedBy(const SortPattern& inputSortPattern) {
+    invariant(!_initialized);
+    if (!internalDocumentSourceGroupEnableStreaming.load() ||
+        _idExpressions.size() > inputSortPattern.size()) {
+        return false;
+    }
+
+    // The leading fields of the sort must be exactly the group key's field paths, in any order.
+    std::vector<bool> matched(_idExpressions.size(), false);
+    for (size_t i = 0; i < _idExpressions.size(); ++i) {
+        const auto& part = inputSortPattern[i];
+        if (!part.fieldPath) {
+            return false;
+        }
+
+        bool found = false;
+        for (size_t j = 0; j < _idExpressions.size() && !found; ++j) {
+            auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(_idExpressions[j].get());
+            if (!matched[j] && fieldPathExpr &&
+                fieldPathExpr->representsPath(part.fieldPath->fullPath())) {
+                matched[j] = found = true;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+
+    _streaming = true;
+    return true;
+}
+
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
@@ -252,6 +402,8 @@ void DocumentSourceGroup::doDispose() {
 
     // Make us look done.
     groupsIterator = _groups->end();
+    _haveStreamingGroup = false;
+    _streamingInputExhausted = true;
 }
 
 intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
@@ -541,8 +693,11 @@ private:
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     const size_t numAccumulators = _accumulatedFields.size();
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
+    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'. If streaming
+    // stopped partway through the input, the document which stopped it is grouped first.
+    GetNextResult input = _pendingDocument ? GetNextResult(std::move(*_pendingDocument))
+                                           : pSource->getNext();
+    _pendingDocument = boost::none;
 
     for (; input.isAdvanced(); input = pSource->getNext()) {
         if (shouldSpillWithAttemptToSaveMemory([this]() { return freeMemory(); })) {
@@ -561,7 +716,6 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
         const bool inserted = _groups->size() != oldSize;
 
-        vector<uint64_t> oldAccumMemUsage(numAccumulators, 0);
         if (inserted) {
             _memoryTracker.memoryUsageBytes += id.getApproximateSize();
 
@@ -577,25 +731,22 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                 accum->startNewGroup(initializerValue);
                 group.push_back(accum);
             }
-        } else {
-            for (size_t i = 0; i < group.size(); i++) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryTracker.memoryUsageBytes -= group[i]->memUsageForSorter();
-                oldAccumMemUsage[i] = group[i]->memUsageForSorter();
-            }
         }
 
         /* tickle all the accumulators for the group we found */
         dassert(numAccumulators == group.size());
 
         for (size_t i = 0; i < numAccumulators; i++) {
+            // Only the change in each accumulator's memory usage is tracked. A new group's
+            // accumulators have not been counted yet, so they start from zero.
+            const uint64_t oldMemUsage = inserted ? 0 : group[i]->memUsageForSorter();
             group[i]->process(
                 _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
                 _doingMerge);
+            const uint64_t memUsageDelta = group[i]->memUsageForSorter() - oldMemUsage;
 
-            _memoryTracker.memoryUsageBytes += group[i]->memUsageForSorter();
-            _memoryTracker.accumStatementMemoryBytes[i].currentMemoryBytes +=
-                group[i]->memUsageForSorter() - oldAccumMemUsage[i];
+            _memoryTracker.memoryUsageBytes += memUsageDelta;
+            _memoryTracker.accumStatementMemoryBytes[i].currentMemoryBytes += memUsageDelta;
         }
 
         if (kDebugBuild && !storageGlobalParams.readOnly) {
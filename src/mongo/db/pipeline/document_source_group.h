@@ -40,6 +40,8 @@
 
 namespace mongo {
 
+class SortPattern;
+
 /**
  * GroupFromFirstTransformation consists of a list of (field name, expression pairs). It returns a
  * document synthesized by assigning each field name in the output document to the result of
@@ -156,6 +158,24 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * Informs this $group that its input arrives ordered by 'inputSortPattern'. If each component
+     * of the group key is a field path, and together they make up the leading fields of
+     * 'inputSortPattern', then the documents of each group are adjacent in the input. The stage
+     * then streams, returning each group as soon as a document with a different key arrives
+     * rather than loading every group into a hash table first.
+     *
+     * Returns true if streaming was enabled. Must be called before execution begins.
+     */
+    bool enableStreamingIfInputSortedBy(const SortPattern& inputSortPattern);
+
+    /**
+     * Returns true if this $group stage will stream its groups out of sorted input.
+     */
+    bool isStreaming() const {
+        return _streaming;
+    }
+
     /**
      * Returns true if this $group stage used disk during execution and false otherwise.
      */
@@ -218,6 +238,22 @@ private:
      */
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
+    GetNextResult getNextStreaming();
+
+    /**
+     * Helpers for a streaming $group. startStreamingGroup() resets '_currentAccumulators' for the
+     * group with key 'id', and accumulateStreaming() adds 'root' to that group.
+     */
+    void startStreamingGroup(const Value& id);
+    void accumulateStreaming(const Document& root);
+
+    /**
+     * Abandons streaming for the rest of the input, moving the group in progress into '_groups'
+     * so that hash-based grouping can pick up where streaming left off. If provided, 'pending'
+     * is the input document which could not be streamed; it is the first document grouped by
+     * the next call to initialize().
+     */
+    void stopStreaming(boost::optional<Document> pending);
 
     /**
      * Before returning anything, this source must prepare itself. In a streaming $group,
@@ -306,6 +342,15 @@ private:
     std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
+
+    // A streaming $group accumulates a single group at a time into '_currentAccumulators', keyed
+    // by '_currentId', and never calls initialize() unless it has to give up on streaming.
+    bool _streaming = false;
+    bool _haveStreamingGroup = false;
+    bool _streamingInputExhausted = false;
+
+    // An input document which has not been grouped yet, left over when streaming stopped.
+    boost::optional<Document> _pendingDocument;
 };
 
 }  // namespace mongo
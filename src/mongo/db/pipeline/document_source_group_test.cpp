@@ -51,6 +51,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/query_test_service_context.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
@@ -245,6 +246,115 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+intrusive_ptr<DocumentSourceGroup> makeCountGroup(const intrusive_ptr<ExpressionContext>& expCtx,
+                                                  const intrusive_ptr<Expression>& groupBy) {
+    auto&& parser = AccumulationStatement::getParser("$sum", boost::none);
+    auto accumulatorArg = BSON("" << 1);
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    return DocumentSourceGroup::create(expCtx, groupBy, {AccumulationStatement{"count", accExpr}});
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldStreamOnlyWhenGroupKeyIsPrefixOfInputSort) {
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto a = ExpressionFieldPath::parse(expCtx.get(), "$a", vps);
+    auto b = ExpressionFieldPath::parse(expCtx.get(), "$b", vps);
+
+    auto groupByB = makeCountGroup(expCtx, b);
+    ASSERT_FALSE(groupByB->enableStreamingIfInputSortedBy(SortPattern(fromjson("{a: 1}"), expCtx)));
+    ASSERT_FALSE(
+        groupByB->enableStreamingIfInputSortedBy(SortPattern(fromjson("{a: 1, b: 1}"), expCtx)));
+    ASSERT_FALSE(groupByB->isStreaming());
+    ASSERT_TRUE(
+        groupByB->enableStreamingIfInputSortedBy(SortPattern(fromjson("{b: -1, a: 1}"), expCtx)));
+    ASSERT_TRUE(groupByB->isStreaming());
+
+    auto groupByBA =
+        makeCountGroup(expCtx, ExpressionObject::create(expCtx.get(), {{"x", b}, {"y", a}}));
+    ASSERT_FALSE(
+        groupByBA->enableStreamingIfInputSortedBy(SortPattern(fromjson("{a: 1}"), expCtx)));
+    ASSERT_TRUE(
+        groupByBA->enableStreamingIfInputSortedBy(SortPattern(fromjson("{a: 1, b: -1}"), expCtx)));
+
+    auto groupByExpression =
+        makeCountGroup(expCtx, ExpressionFieldPath::parse(expCtx.get(), "$a.b", vps));
+    ASSERT_FALSE(
+        groupByExpression->enableStreamingIfInputSortedBy(SortPattern(fromjson("{a: 1}"), expCtx)));
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupReturnsEachGroupOnceItsKeyChanges) {
+    auto expCtx = getExpCtx();
+    auto groupBy = ExpressionFieldPath::parse(expCtx.get(), "$a", expCtx->variablesParseState);
+    auto group = makeCountGroup(expCtx, groupBy);
+    ASSERT_TRUE(group->enableStreamingIfInputSortedBy(SortPattern(fromjson("{a: 1}"), expCtx)));
+
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 1}},
+                                           Document{{"a", 1}},
+                                           Document{{"a", 2}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 3}}},
+                                          expCtx);
+    group->setSource(mock.get());
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+
+    // The group for 'a: 2' cannot be returned until we know no more documents belong to it.
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 2}, {"count", 1}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 3}, {"count", 1}}));
+
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupFallsBackToHashingOnArrayKey) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+    auto groupBy = ExpressionFieldPath::parse(expCtx.get(), "$a", expCtx->variablesParseState);
+    auto group = makeCountGroup(expCtx, groupBy);
+    ASSERT_TRUE(group->enableStreamingIfInputSortedBy(SortPattern(fromjson("{a: 1}"), expCtx)));
+
+    // An array sorts by its smallest element, so it can land in the middle of another group.
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 0}},
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", BSON_ARRAY(1 << 5)}},
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", 2}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    // The first group is complete before the array is seen.
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 0}, {"count", 1}}));
+
+    std::vector<Document> rest;
+    for (result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        rest.push_back(result.releaseDocument());
+    }
+    ASSERT_TRUE(result.isEOF());
+    ASSERT_FALSE(group->isStreaming());
+    ASSERT_EQ(rest.size(), 3UL);
+
+    std::map<std::string, int> counts;
+    for (auto&& doc : rest) {
+        counts[doc["_id"].toString()] = doc["count"].getInt();
+    }
+    ASSERT_EQ(counts[Value(1).toString()], 2);
+    ASSERT_EQ(counts[Value(BSON_ARRAY(1 << 5)).toString()], 1);
+    ASSERT_EQ(counts[Value(2).toString()], 1);
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
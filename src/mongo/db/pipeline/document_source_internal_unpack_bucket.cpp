@@ -32,8 +32,13 @@
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_tree.h"
+#include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 
 namespace mongo {
 
@@ -41,6 +46,99 @@ REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
                          LiteParsedDocumentSourceDefault::parse,
                          DocumentSourceInternalUnpackBucket::createFromBson);
 
+namespace {
+/**
+ * Returns an iterator over the positions and values of the data column 'column'. The columns of a
+ * compressed bucket are decoded here, so only the columns that are unpacked pay for decoding.
+ */
+FieldIterator makeColumnIterator(StringData colName, const Value& column, bool compressed) {
+    if (!compressed) {
+        return column.getDocument().fieldIterator();
+    }
+    uassert(5697015,
+            str::stream() << "Column " << colName << " of a compressed bucket is not BinData",
+            column.getType() == BSONType::BinData);
+    return Document{timeseries::decompressColumn(column.getBinData())}.fieldIterator();
+}
+
+// Every BSON type a value in the 'control.min' or 'control.max' field of a bucket can have.
+constexpr BSONType kAllBSONTypes[] = {MinKey,
+                                      NumberDouble,
+                                      String,
+                                      Object,
+                                      Array,
+                                      BinData,
+                                      Undefined,
+                                      jstOID,
+                                      Bool,
+                                      Date,
+                                      jstNULL,
+                                      RegEx,
+                                      DBRef,
+                                      Code,
+                                      Symbol,
+                                      CodeWScope,
+                                      NumberInt,
+                                      bsonTimestamp,
+                                      NumberLong,
+                                      NumberDecimal,
+                                      MaxKey};
+
+/**
+ * Returns a $type predicate on 'path' matching every type whose canonical type satisfies
+ * 'canonicalTypePred'. The predicate is never empty for the callers below, since MinKey and MaxKey
+ * sort below and above every other type.
+ */
+BSONObj makeTypePredicate(StringData path, const std::function<bool(int)>& canonicalTypePred) {
+    BSONArrayBuilder types;
+    for (auto type : kAllBSONTypes) {
+        if (canonicalTypePred(canonicalizeBSONType(type))) {
+            types.append(static_cast<int>(type));
+        }
+    }
+    return BSON(path << BSON("$type" << types.arr()));
+}
+
+/**
+ * The bucket catalog tracks the minimum and maximum of each field under the total BSON order, so
+ * the type of 'control.min.<f>' is the smallest type of any value of <f> in the bucket, and the
+ * type of 'control.max.<f>' the largest. Arrays and objects are tracked element-wise. A query
+ * comparison to a value of canonical type T only inspects values of type T, so a bucket-level
+ * bound is only a faithful summary when the bucket's minimum (or maximum) has type T itself.
+ *
+ * Returns a predicate matching the buckets for which the bound on 'minPath' or 'maxPath' cannot be
+ * trusted: those whose bound has a type on the far side of T and those which may hold arrays,
+ * since an array matches if any of its elements does.
+ */
+BSONObj makeMixedTypeEscape(StringData minPath,
+                            StringData maxPath,
+                            bool boundIsMin,
+                            int canonicalType) {
+    const int arrayType = canonicalizeBSONType(Array);
+    auto farSide = boundIsMin
+        ? makeTypePredicate(minPath, [&](int type) { return type < canonicalType; })
+        : makeTypePredicate(maxPath, [&](int type) { return type > canonicalType; });
+
+    BSONObjBuilder mayHoldArrays;
+    mayHoldArrays.appendElements(
+        makeTypePredicate(minPath, [&](int type) { return type <= arrayType; }));
+    mayHoldArrays.appendElements(
+        makeTypePredicate(maxPath, [&](int type) { return type >= arrayType; }));
+
+    return BSON("$or" << BSON_ARRAY(farSide << mayHoldArrays.obj()));
+}
+
+bool includesTimeField(const BucketSpec& spec, BucketUnpacker::Behavior behavior) {
+    return (behavior == BucketUnpacker::Behavior::kInclude) ==
+        (spec.fieldSet.find(spec.timeField) != spec.fieldSet.end());
+}
+
+bool isNaN(const BSONElement& elem) {
+    return (elem.type() == NumberDouble && std::isnan(elem.numberDouble())) ||
+        (elem.type() == NumberDecimal && elem.numberDecimal().isNaN());
+}
+}  // namespace
+
 void BucketUnpacker::reset(Document&& bucket) {
     _fieldIters.clear();
     _timeFieldIter = boost::none;
@@ -60,7 +158,12 @@ void BucketUnpacker::reset(Document&& bucket) {
             !_spec.metaField ||
                 (_metaValue.getType() != BSONType::Undefined && !_metaValue.missing()));
 
-    _timeFieldIter = _bucket[kBucketDataFieldName][_spec.timeField].getDocument().fieldIterator();
+    auto version = _bucket[kBucketControlFieldName][kBucketControlVersionFieldName];
+    const bool compressed = version.numeric() &&
+        version.coerceToInt() == timeseries::kTimeseriesControlCompressedVersion;
+
+    _timeFieldIter = makeColumnIterator(
+        _spec.timeField, _bucket[kBucketDataFieldName][_spec.timeField], compressed);
 
     // Walk the data region of the bucket, and decide if an iterator should be set up based on the
     // include or exclude case.
@@ -74,11 +177,19 @@ void BucketUnpacker::reset(Document&& bucket) {
         }
         auto found = _spec.fieldSet.find(colName.toString()) != _spec.fieldSet.end();
         if ((_unpackerBehavior == Behavior::kInclude) == found) {
-            _fieldIters.push_back({colName.toString(), colVal.getDocument().fieldIterator()});
+            _fieldIters.push_back(
+                {colName.toString(), makeColumnIterator(colName, colVal, compressed)});
         }
     }
 }
 
+void BucketUnpacker::setBucketSpecAndBehavior(BucketSpec&& spec, Behavior behavior) {
+    invariant(_bucket.empty());
+    _includeTimeField = includesTimeField(spec, behavior);
+    _spec = std::move(spec);
+    _unpackerBehavior = behavior;
+}
+
 Document BucketUnpacker::getNext() {
     invariant(hasNext());
 
@@ -162,13 +273,202 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
             specElem[kTimeFieldName].ok());
 
     // Determine if timestamp values should be included in the materialized measurements.
-    auto includeTimeField = (unpackerBehavior == BucketUnpacker::Behavior::kInclude) ==
-        (bucketSpec.fieldSet.find(bucketSpec.timeField) != bucketSpec.fieldSet.end());
+    auto includeTimeField = includesTimeField(bucketSpec, unpackerBehavior);
 
     return make_intrusive<DocumentSourceInternalUnpackBucket>(
         expCtx, BucketUnpacker{std::move(bucketSpec), unpackerBehavior, includeTimeField});
 }
 
+BSONObj DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(
+    const MatchExpression* matchExpr) const {
+    switch (matchExpr->matchType()) {
+        case MatchExpression::AND: {
+            // A bucket holding a match satisfies the bucket-level predicates of every child that
+            // has one, so children without one can simply be dropped.
+            BSONArrayBuilder children;
+            for (size_t i = 0; i < matchExpr->numChildren(); ++i) {
+                auto child = createPredicatesOnBucketLevelField(matchExpr->getChild(i));
+                if (!child.isEmpty()) {
+                    children.append(child);
+                }
+            }
+            auto arr = children.arr();
+            if (arr.isEmpty()) {
+                return BSONObj();
+            }
+            return arr.nFields() == 1 ? arr.firstElement().Obj().getOwned() : BSON("$and" << arr);
+        }
+        case MatchExpression::OR: {
+            // A disjunction can only be mapped if every one of its children can.
+            BSONArrayBuilder children;
+            for (size_t i = 0; i < matchExpr->numChildren(); ++i) {
+                auto child = createPredicatesOnBucketLevelField(matchExpr->getChild(i));
+                if (child.isEmpty()) {
+                    return BSONObj();
+                }
+                children.append(child);
+            }
+            return BSON("$or" << children.arr());
+        }
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            break;
+        default:
+            return BSONObj();
+    }
+
+    auto&& spec = _bucketUnpacker.bucketSpec();
+    auto path = matchExpr->path();
+    const auto comparison = static_cast<const ComparisonMatchExpression*>(matchExpr);
+    const auto& rhs = comparison->getData();
+
+    // Every measurement of a bucket carries the bucket's metadata value, so a comparison on the
+    // metaField or one of its subfields maps exactly to the same comparison on the bucket. This
+    // lets an index on the 'meta' field of the buckets collection bound the scan.
+    if (spec.metaField &&
+        (path == *spec.metaField || expression::isPathPrefixOf(*spec.metaField, path))) {
+        const std::string metaPath = str::stream()
+            << BucketUnpacker::kBucketMetaFieldName << path.substr(spec.metaField->size());
+        return BSON(metaPath << BSON(comparison->name() << rhs));
+    }
+
+    // The bounds of dotted paths do not describe values reached through arrays along the path.
+    if (path.empty() || path.find('.') != std::string::npos) {
+        return BSONObj();
+    }
+
+    // Comparisons to these values either match missing fields, which have no bounds, or have
+    // semantics which the bounds cannot summarize.
+    switch (rhs.type()) {
+        case MinKey:
+        case MaxKey:
+        case jstNULL:
+        case Undefined:
+        case Object:
+        case Array:
+        case RegEx:
+            return BSONObj();
+        default:
+            break;
+    }
+    if (isNaN(rhs)) {
+        return BSONObj();
+    }
+
+    // The bounds are computed under the simple collation.
+    if (rhs.canonicalType() == canonicalizeBSONType(String) && pExpCtx->getCollator()) {
+        return BSONObj();
+    }
+
+    const std::string minPath = str::stream()
+        << BucketUnpacker::kBucketControlFieldName << "."
+        << BucketUnpacker::kBucketControlMinFieldName << "." << path;
+    const std::string maxPath = str::stream()
+        << BucketUnpacker::kBucketControlFieldName << "."
+        << BucketUnpacker::kBucketControlMaxFieldName << "." << path;
+
+    // Every value of the time field is a date, so its bounds need no type escape. Comparisons of
+    // the time field to anything else are left to the $match after this stage.
+    const bool isTimeField = path == spec.timeField;
+    if (isTimeField && rhs.type() != Date) {
+        return BSONObj();
+    }
+
+    auto makeBound = [&](bool boundIsMin, StringData op) {
+        const auto& boundPath = boundIsMin ? minPath : maxPath;
+        auto bound = BSON(boundPath << BSON(op << rhs));
+        if (isTimeField) {
+            return bound;
+        }
+        return BSON("$or" << BSON_ARRAY(
+                        bound << makeMixedTypeEscape(
+                            minPath, maxPath, boundIsMin, rhs.canonicalType())));
+    };
+
+    switch (matchExpr->matchType()) {
+        case MatchExpression::EQ:
+            return BSON("$and" << BSON_ARRAY(makeBound(true, "$lte") << makeBound(false, "$gte")));
+        case MatchExpression::LT:
+            return makeBound(true, "$lt");
+        case MatchExpression::LTE:
+            return makeBound(true, "$lte");
+        case MatchExpression::GT:
+            return makeBound(false, "$gt");
+        case MatchExpression::GTE:
+            return makeBound(false, "$gte");
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+void DocumentSourceInternalUnpackBucket::internalizeDownstreamDependencies(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    // Collect what the rest of the pipeline reads, stopping at the first stage that determines
+    // all of its downstream field dependencies.
+    DepsTracker downstreamDeps;
+    bool knowAllFields = false;
+    for (auto it = std::next(itr); it != container->end() && !knowAllFields; ++it) {
+        auto state = (*it)->getDependencies(&downstreamDeps);
+        if (state == DepsTracker::State::NOT_SUPPORTED) {
+            return;
+        }
+        knowAllFields = state & DepsTracker::State::EXHAUSTIVE_FIELDS;
+    }
+    if (!knowAllFields || downstreamDeps.needWholeDocument) {
+        return;
+    }
+
+    // Measurements are unpacked column by column, so only the top-level field of each path read
+    // downstream can be pruned on.
+    std::set<std::string> neededFields;
+    for (auto&& field : downstreamDeps.fields) {
+        neededFields.insert(FieldPath(field).front().toString());
+    }
+
+    // Only ever narrow down the fields unpacked today.
+    auto spec = _bucketUnpacker.bucketSpec();
+    const bool isInclude = _bucketUnpacker.behavior() == BucketUnpacker::Behavior::kInclude;
+    std::set<std::string> fieldSet;
+    for (auto&& field : neededFields) {
+        if ((spec.fieldSet.find(field) != spec.fieldSet.end()) == isInclude) {
+            fieldSet.insert(field);
+        }
+    }
+    spec.fieldSet = std::move(fieldSet);
+    _bucketUnpacker.setBucketSpecAndBehavior(std::move(spec), BucketUnpacker::Behavior::kInclude);
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    if (std::next(itr) == container->end()) {
+        return container->end();
+    }
+
+    internalizeDownstreamDependencies(itr, container);
+
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+    if (!nextMatch || _triedBucketLevelFieldsPredicatesPushdown) {
+        return std::next(itr);
+    }
+    _triedBucketLevelFieldsPredicatesPushdown = true;
+
+    auto bucketPredicate = createPredicatesOnBucketLevelField(nextMatch->getMatchExpression());
+    if (bucketPredicate.isEmpty()) {
+        return std::next(itr);
+    }
+
+    container->insert(itr, DocumentSourceMatch::create(bucketPredicate, pExpCtx));
+
+    // Give the new $match a chance to optimize with the stage in front of it.
+    auto newMatch = std::prev(itr);
+    return newMatch == container->begin() ? newMatch : std::prev(newMatch);
+}
+
 Value DocumentSourceInternalUnpackBucket::serialize(
     boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument out;
@@ -31,6 +31,7 @@
 
 #include <set>
 
+#include "mongo/db/matcher/expression.h"
 #include "mongo/db/pipeline/document_source.h"
 
 namespace mongo {
@@ -59,6 +60,10 @@ class BucketUnpacker {
 public:
     // These are hard-coded constants in the bucket schema.
     static constexpr StringData kBucketIdFieldName = "_id"_sd;
+    static constexpr StringData kBucketControlFieldName = "control"_sd;
+    static constexpr StringData kBucketControlVersionFieldName = "version"_sd;
+    static constexpr StringData kBucketControlMinFieldName = "min"_sd;
+    static constexpr StringData kBucketControlMaxFieldName = "max"_sd;
     static constexpr StringData kBucketDataFieldName = "data"_sd;
     static constexpr StringData kBucketMetaFieldName = "meta"_sd;
 
@@ -94,15 +99,21 @@ public:
         return _bucket;
     }
 
+    /**
+     * Replaces the set of fields unpacked into measurements. Must be called before the first
+     * bucket is unpacked.
+     */
+    void setBucketSpecAndBehavior(BucketSpec&& spec, Behavior behavior);
+
 private:
-    const BucketSpec _spec;
-    const Behavior _unpackerBehavior;
+    BucketSpec _spec;
+    Behavior _unpackerBehavior;
 
     // Iterates the timestamp section of the bucket to drive the unpacking iteration.
     boost::optional<FieldIterator> _timeFieldIter;
 
     // A flag used to mark that the timestamp value should be materialized in measurements.
-    const bool _includeTimeField;
+    bool _includeTimeField;
 
     // Since the metadata value is the same across all materialized measurements we can cache the
     // metadata value in the reset phase and use it to materialize the metadata in each measurement.
@@ -152,9 +163,38 @@ public:
         return boost::none;
     };
 
+    /**
+     * Maps 'matchExpr', a predicate over unpacked measurements, to a predicate over the
+     * 'control.min' and 'control.max' fields of a bucket. Every bucket holding a measurement that
+     * matches 'matchExpr' also matches the returned predicate, so it can be applied to buckets
+     * before they are unpacked. Returns an empty object if no bucket-level predicate can be built.
+     */
+    BSONObj createPredicatesOnBucketLevelField(const MatchExpression* matchExpr) const;
+
 private:
     GetNextResult doGetNext() final;
 
+    /**
+     * Narrows the unpacked fields to those the rest of the pipeline reads. If followed by a
+     * $match, also inserts a $match on the bucket-level fields in front of this stage
+     * so that buckets which cannot contain a matching measurement are never unpacked. The original
+     * $match is kept, since the bucket-level predicate only narrows down the candidate buckets.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
+    /**
+     * If the rest of the pipeline reads a finite set of fields, narrows the unpacker down to the
+     * top-level fields among them, so that the other columns of a bucket are neither decoded nor
+     * materialized in the measurements.
+     */
+    void internalizeDownstreamDependencies(Pipeline::SourceContainer::iterator itr,
+                                           Pipeline::SourceContainer* container);
+
     BucketUnpacker _bucketUnpacker;
+
+    // Set once a bucket-level $match has been built for the $match following this stage, so that
+    // repeated optimization passes do not insert it again.
+    bool _triedBucketLevelFieldsPredicatesPushdown = false;
 };
 }  // namespace mongo
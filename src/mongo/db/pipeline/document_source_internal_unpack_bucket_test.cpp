@@ -30,9 +30,13 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 
 namespace mongo {
 namespace {
@@ -42,6 +46,33 @@ constexpr auto kUserDefinedMetaName = "myMeta"_sd;
 
 using InternalUnpackBucketStageTest = AggregationContextFixture;
 
+class InternalUnpackBucketPredicatePushdownTest : public AggregationContextFixture {
+protected:
+    /**
+     * Returns the bucket-level predicate built for the measurement predicate 'predicate'.
+     */
+    BSONObj bucketPredicate(const BSONObj& predicate) {
+        auto unpack = DocumentSourceInternalUnpackBucket::createFromBson(
+            fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'm'}}")
+                .firstElement(),
+            getExpCtx());
+        auto expr = uassertStatusOK(MatchExpressionParser::parse(predicate, getExpCtx()));
+        return static_cast<DocumentSourceInternalUnpackBucket*>(unpack.get())
+            ->createPredicatesOnBucketLevelField(expr.get());
+    }
+
+    /**
+     * Returns whether 'bucket' passes the bucket-level predicate built for 'predicate', which must
+     * exist.
+     */
+    bool bucketMatches(const BSONObj& predicate, const BSONObj& bucket) {
+        auto bucketPred = bucketPredicate(predicate);
+        ASSERT_FALSE(bucketPred.isEmpty()) << predicate;
+        auto expr = uassertStatusOK(MatchExpressionParser::parse(bucketPred, getExpCtx()));
+        return expr->matchesBSON(bucket);
+    }
+};
+
 TEST_F(InternalUnpackBucketStageTest, UnpackBasicIncludeAllMeasurementFields) {
     auto expCtx = getExpCtx();
 
@@ -249,6 +280,45 @@ TEST_F(InternalUnpackBucketStageTest, SparseColumnsWhereOneColumnIsExhaustedBefo
     ASSERT_TRUE(next.isEOF());
 }
 
+TEST_F(InternalUnpackBucketStageTest, UnpackCompressedBucket) {
+    auto expCtx = getExpCtx();
+    auto spec = BSON("$_internalUnpackBucket"
+                     << BSON("include" << BSON_ARRAY("time"
+                                                     << "a"
+                                                     << "b")
+                                       << DocumentSourceInternalUnpackBucket::kTimeFieldName
+                                       << kUserDefinedTimeName
+                                       << DocumentSourceInternalUnpackBucket::kMetaFieldName
+                                       << kUserDefinedMetaName));
+    auto unpack = DocumentSourceInternalUnpackBucket::createFromBson(spec.firstElement(), expCtx);
+
+    auto bucket = fromjson(
+        "{control: {version: 1}, meta: {m1: 999}, data: {_id: {'0': 1, '1': 2, '2': 3}, time: "
+        "{'0': 1, '1': 2, '2': 3}, a: {'0': 1.5, '1': 1.5, '2': 2.5}, b: {'1': 'x'}}}");
+    auto compressed = timeseries::compressBucket(bucket);
+    ASSERT(compressed);
+    auto source = DocumentSourceMock::createForTest(Document(*compressed), expCtx);
+    unpack->setSource(source.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 1, myMeta: {m1: 999}, a: 1.5}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 2, myMeta: {m1: 999}, a: 1.5, b: 'x'}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 3, myMeta: {m1: 999}, a: 2.5}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
 TEST_F(InternalUnpackBucketStageTest, UnpackBasicIncludeWithDollarPrefix) {
     auto expCtx = getExpCtx();
 
@@ -661,5 +731,172 @@ TEST_F(InternalUnpackBucketStageTest, ParserRejectsMissingTimeField) {
             getExpCtx()),
         AssertionException);
 }
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, OptimizeInsertsBucketLevelMatchOnce) {
+    auto pipeline = Pipeline::parse(
+        {fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'm'}}"),
+         fromjson("{$match: {a: {$gte: 5}}}")},
+        getExpCtx());
+    pipeline->optimizePipeline();
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(3u, serialized.size());
+    ASSERT_EQ("$match"_sd, serialized[0].firstElementFieldNameStringData());
+    ASSERT_EQ(DocumentSourceInternalUnpackBucket::kStageName,
+              serialized[1].firstElementFieldNameStringData());
+    ASSERT_BSONOBJ_EQ(fromjson("{$match: {a: {$gte: 5}}}"), serialized[2]);
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, OptimizeLeavesUnmappablePredicates) {
+    auto pipeline = Pipeline::parse(
+        {fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'm'}}"),
+         fromjson("{$match: {$or: [{a: {$gte: 5}}, {b: {$exists: true}}]}}")},
+        getExpCtx());
+    pipeline->optimizePipeline();
+    ASSERT_EQ(2u, pipeline->serializeToBson().size());
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, OptimizeUnpacksOnlyDownstreamDependencies) {
+    auto pipeline = Pipeline::parse(
+        {fromjson("{$_internalUnpackBucket: {exclude: ['b'], timeField: 'time', metaField: 'm'}}"),
+         fromjson("{$match: {a: {$gte: 5}}}"),
+         fromjson("{$group: {_id: '$m.x', max: {$max: '$b.c'}, last: {$max: '$time'}}}")},
+        getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(4u, serialized.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{$_internalUnpackBucket: {include: ['a', 'm', 'time'], timeField: "
+                               "'time', metaField: 'm'}}"),
+                      serialized[1]);
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest,
+       OptimizeNarrowsUnpackedFieldsOnlyForKnownDependencies) {
+    auto pipeline = Pipeline::parse(
+        {fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'm'}}"),
+         fromjson("{$project: {a: 1}}")},
+        getExpCtx());
+    pipeline->optimizePipeline();
+
+    ASSERT_BSONOBJ_EQ(fromjson("{$_internalUnpackBucket: {include: ['_id', 'a'], timeField: "
+                               "'time', metaField: 'm'}}"),
+                      pipeline->serializeToBson()[0]);
+
+    pipeline = Pipeline::parse(
+        {fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'm'}}"),
+         fromjson("{$addFields: {z: '$a'}}")},
+        getExpCtx());
+    pipeline->optimizePipeline();
+
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'm'}}"),
+        pipeline->serializeToBson()[0]);
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, TimeFieldBoundsHaveNoTypeEscape) {
+    ASSERT_BSONOBJ_EQ(
+        BSON("control.max.time" << BSON("$gt" << Date_t::fromMillisSinceEpoch(1000))),
+        bucketPredicate(BSON("time" << BSON("$gt" << Date_t::fromMillisSinceEpoch(1000)))));
+    ASSERT_BSONOBJ_EQ(
+        BSON("control.min.time" << BSON("$lte" << Date_t::fromMillisSinceEpoch(1000))),
+        bucketPredicate(BSON("time" << BSON("$lte" << Date_t::fromMillisSinceEpoch(1000)))));
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{time: {$gt: 5}}")));
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, PrunesBucketsOutsideTimeRange) {
+    auto bucket =
+        BSON("control" << BSON("min" << BSON("time" << Date_t::fromMillisSinceEpoch(100)) << "max"
+                                     << BSON("time" << Date_t::fromMillisSinceEpoch(200))));
+    auto inRange = [&](long long lo, long long hi) {
+        return bucketMatches(BSON("time" << BSON("$gte" << Date_t::fromMillisSinceEpoch(lo) << "$lt"
+                                                        << Date_t::fromMillisSinceEpoch(hi))),
+                             bucket);
+    };
+    ASSERT_TRUE(inRange(0, 150));
+    ASSERT_TRUE(inRange(150, 300));
+    ASSERT_TRUE(inRange(200, 300));
+    ASSERT_FALSE(inRange(0, 100));
+    ASSERT_FALSE(inRange(201, 300));
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, PrunesBucketsOnMeasurementBounds) {
+    auto bucket = fromjson("{control: {min: {a: 10}, max: {a: 20.5}}}");
+    ASSERT_TRUE(bucketMatches(fromjson("{a: {$gt: 15}}"), bucket));
+    ASSERT_FALSE(bucketMatches(fromjson("{a: {$gt: 20.5}}"), bucket));
+    ASSERT_TRUE(bucketMatches(fromjson("{a: {$lte: 10}}"), bucket));
+    ASSERT_FALSE(bucketMatches(fromjson("{a: {$lt: 10}}"), bucket));
+    ASSERT_TRUE(bucketMatches(fromjson("{a: 12}"), bucket));
+    ASSERT_FALSE(bucketMatches(fromjson("{a: 21}"), bucket));
+    ASSERT_FALSE(bucketMatches(fromjson("{a: {$gt: 'x'}}"), bucket));
+    ASSERT_FALSE(bucketMatches(fromjson("{b: {$gt: 0}}"), bucket));
+    ASSERT_TRUE(bucketMatches(fromjson("{$or: [{a: 30}, {a: 15}]}"), bucket));
+    ASSERT_FALSE(bucketMatches(fromjson("{$or: [{a: 30}, {a: 5}]}"), bucket));
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, KeepsBucketsWithMixedTypes) {
+    // The minimum is a number but the maximum is a string, so the bucket may hold numbers above
+    // any bound.
+    ASSERT_TRUE(bucketMatches(fromjson("{a: {$gt: 100}}"),
+                              fromjson("{control: {min: {a: 1}, max: {a: 'z'}}}")));
+    // The minimum is null, so the bucket may hold numbers below any bound.
+    ASSERT_TRUE(bucketMatches(fromjson("{a: {$lt: 0}}"),
+                              fromjson("{control: {min: {a: null}, max: {a: 5}}}")));
+    // Both bounds are non-numeric, so the bucket cannot hold a number.
+    ASSERT_FALSE(bucketMatches(fromjson("{a: {$lt: 0}}"),
+                               fromjson("{control: {min: {a: 'a'}, max: {a: 'z'}}}")));
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, KeepsBucketsWhichMayHoldArrays) {
+    // Arrays are tracked element-wise, and an array matches if any of its elements does.
+    ASSERT_TRUE(bucketMatches(fromjson("{a: {$lt: 5}}"),
+                              fromjson("{control: {min: {a: [1]}, max: {a: [1]}}}")));
+    // A measurement [1] with the minimum overwritten by a string still matches {$lt: 5}.
+    ASSERT_TRUE(bucketMatches(fromjson("{a: {$lt: 5}}"),
+                              fromjson("{control: {min: {a: 'str'}, max: {a: [1]}}}")));
+    ASSERT_TRUE(bucketMatches(
+        BSON("a" << BSON("$gt" << Date_t::fromMillisSinceEpoch(3))),
+        BSON("control" << BSON("min" << BSON("a" << BSON_ARRAY(Date_t::fromMillisSinceEpoch(9)))
+                                     << "max"
+                                     << BSON("a" << Date_t::fromMillisSinceEpoch(1))))));
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, DoesNotMapUnsupportedPredicates) {
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{'a.b': 1}")));
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{a: null}")));
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{a: {b: 1}}")));
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{a: [1, 2]}")));
+    ASSERT_BSONOBJ_EQ(
+        BSONObj(),
+        bucketPredicate(BSON("a" << BSON("$lt" << std::numeric_limits<double>::quiet_NaN()))));
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{a: {$ne: 1}}")));
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{$or: [{a: 1}, {b: null}]}")));
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{mm: 1}")));
+
+    // Only the mappable children of a conjunction are kept.
+    ASSERT_BSONOBJ_EQ(bucketPredicate(fromjson("{a: {$gt: 1}}")),
+                      bucketPredicate(fromjson("{a: {$gt: 1}, b: null}")));
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, MapsMetaFieldPredicatesExactly) {
+    ASSERT_BSONOBJ_EQ(fromjson("{meta: {$eq: 1}}"), bucketPredicate(fromjson("{m: 1}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{meta: {$eq: null}}"), bucketPredicate(fromjson("{m: null}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{'meta.a.b': {$gte: 'x'}}"),
+                      bucketPredicate(fromjson("{'m.a.b': {$gte: 'x'}}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{$and: [{meta: {$eq: 'sensor'}}, {'control.max.time': {$gt: "
+                               "{$date: 1000}}}]}"),
+                      bucketPredicate(fromjson("{m: 'sensor', time: {$gt: {$date: 1000}}}")));
+    ASSERT_FALSE(bucketMatches(fromjson("{m: 'a'}"), fromjson("{meta: 'b'}")));
+    ASSERT_TRUE(bucketMatches(fromjson("{m: {a: 1}}"), fromjson("{meta: {a: 1}}")));
+}
+
+TEST_F(InternalUnpackBucketPredicatePushdownTest, DoesNotMapStringsUnderNonSimpleCollation) {
+    ASSERT_FALSE(bucketPredicate(fromjson("{a: {$gt: 'b'}}")).isEmpty());
+    getExpCtx()->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kReverseString));
+    ASSERT_BSONOBJ_EQ(BSONObj(), bucketPredicate(fromjson("{a: {$gt: 'b'}}")));
+    ASSERT_FALSE(bucketPredicate(fromjson("{a: {$gt: 1}}")).isEmpty());
+}
 }  // namespace
 }  // namespace mongo
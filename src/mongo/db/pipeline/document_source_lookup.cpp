@@ -39,6 +39,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/aggregation_request_helper.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_merge_gen.h"
@@ -48,6 +49,7 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -317,6 +319,47 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
     }
 
+    std::vector<Value> results;
+    long long objsize = 0;
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    auto addResult = [&](Value result) {
+        long long safeSum = 0;
+        bool hasOverflowed = overflow::add(objsize, result.getApproximateSize(), &safeSum);
+        uassert(4568,
+                str::stream() << "Total size of documents in " << _fromNs.coll()
+                              << " matching pipeline's $lookup stage exceeds " << maxBytes
+                              << " bytes",
+
+                !hasOverflowed && objsize <= maxBytes);
+        objsize = safeSum;
+        results.emplace_back(std::move(result));
+    };
+
+    if (auto hashJoinResults = lookUpInHashTable(inputDoc)) {
+        for (auto&& result : *hashJoinResults) {
+            addResult(std::move(result));
+        }
+
+        MutableDocument output(std::move(inputDoc));
+        output.setNestedField(_as, Value(std::move(results)));
+        return output.freeze();
+    }
+
+    auto cacheKey = makeCorrelatedCacheKey(inputDoc);
+    if (cacheKey) {
+        if (auto cached = (*_correlatedCache)[*cacheKey]) {
+            ++_stats.correlatedCacheHits;
+            for (auto&& result : *cached) {
+                addResult(Value(result));
+            }
+
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(std::move(results)));
+            return output.freeze();
+        }
+        ++_stats.correlatedCacheMisses;
+    }
+
     std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
     try {
         pipeline = buildPipeline(inputDoc);
@@ -332,24 +375,25 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         throw;
     }
 
-    std::vector<Value> results;
-    long long objsize = 0;
-    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
-
     while (auto result = pipeline->getNext()) {
-        long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline's $lookup stage exceeds " << maxBytes
-                              << " bytes",
-
-                !hasOverflowed && objsize <= maxBytes);
-        objsize = safeSum;
-        results.emplace_back(std::move(*result));
+        addResult(Value(std::move(*result)));
     }
 
     recordPlanSummaryStats(*pipeline);
+    if (cacheKey) {
+        const auto maxCacheBytes =
+            static_cast<size_t>(internalDocumentSourceLookupCorrelatedCacheSizeBytes.load());
+        if (static_cast<size_t>(objsize) <= maxCacheBytes) {
+            std::vector<Document> toCache;
+            toCache.reserve(results.size());
+            for (auto&& result : results) {
+                toCache.push_back(result.getDocument());
+            }
+            _correlatedCache->insert(std::move(*cacheKey), std::move(toCache));
+            _correlatedCache->evictDownTo(maxCacheBytes);
+        }
+    }
+
     MutableDocument output(std::move(inputDoc));
     output.setNestedField(_as, Value(std::move(results)));
     return output.freeze();
@@ -369,6 +413,16 @@ std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
             _fromExpCtx->opCtx, _fromExpCtx->ns, ChunkVersion::UNSHARDED());
     }
 
+    // Only copy the resolved pipeline when there is a projection to append to it.
+    std::vector<BSONObj> projectedPipeline;
+    if (_foreignProjection) {
+        projectedPipeline.reserve(_resolvedPipeline.size() + 1);
+        projectedPipeline.insert(
+            projectedPipeline.end(), _resolvedPipeline.begin(), _resolvedPipeline.end());
+        projectedPipeline.push_back(BSON("$project" << *_foreignProjection));
+    }
+    const auto& resolvedPipeline = _foreignProjection ? projectedPipeline : _resolvedPipeline;
+
     // If we don't have a cache, build and return the pipeline immediately.
     if (!_cache || _cache->isAbandoned()) {
         MakePipelineOptions pipelineOpts;
@@ -377,7 +431,7 @@ std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
         pipelineOpts.validator = lookupPipeValidator;
         // By default, $lookup doesnt support sharded 'from' collections.
         pipelineOpts.allowTargetingShards = internalQueryAllowShardedLookup.load();
-        return Pipeline::makePipeline(_resolvedPipeline, _fromExpCtx, pipelineOpts);
+        return Pipeline::makePipeline(resolvedPipeline, _fromExpCtx, pipelineOpts);
     }
 
     // Construct the basic pipeline without a cache stage. Avoid optimizing here since we need to
@@ -386,7 +440,7 @@ std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     pipelineOpts.optimize = false;
     pipelineOpts.attachCursorSource = false;
     pipelineOpts.validator = lookupPipeValidator;
-    auto pipeline = Pipeline::makePipeline(_resolvedPipeline, _fromExpCtx, pipelineOpts);
+    auto pipeline = Pipeline::makePipeline(resolvedPipeline, _fromExpCtx, pipelineOpts);
 
     // Add the cache stage at the end and optimize. During the optimization process, the cache will
     // either move itself to the correct position in the pipeline, or will abandon itself if no
@@ -433,6 +487,10 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
 
+    // Recomputed on every call, since absorbing a following $unwind or $match changes what the
+    // rest of the pipeline reads.
+    _foreignProjection = computeForeignProjection(itr, container);
+
     if (std::next(itr) == container->end()) {
         return container->end();
     }
@@ -551,6 +609,133 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
     return itr;
 }
 
+boost::optional<BSONObj> DocumentSourceLookUp::computeForeignProjection(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) const {
+    // Collect what the rest of the pipeline reads, stopping at the first stage that determines
+    // all of its downstream field dependencies.
+    DepsTracker downstreamDeps;
+    bool knowAllFields = false;
+    for (auto it = std::next(itr); it != container->end() && !knowAllFields; ++it) {
+        auto state = (*it)->getDependencies(&downstreamDeps);
+        if (state == DepsTracker::State::NOT_SUPPORTED) {
+            return boost::none;
+        }
+        knowAllFields = state & DepsTracker::State::EXHAUSTIVE_FIELDS;
+    }
+    if (!knowAllFields || downstreamDeps.needWholeDocument) {
+        return boost::none;
+    }
+
+    const auto asPath = _as.fullPath();
+    DepsTracker foreignDeps;
+    for (auto&& field : downstreamDeps.fields) {
+        if (field == asPath || expression::isPathPrefixOf(field, asPath)) {
+            // The whole of 'as' is read, for example by {$size: "$as"}.
+            return boost::none;
+        }
+        if (expression::isPathPrefixOf(asPath, field)) {
+            foreignDeps.fields.insert(field.substr(asPath.size() + 1));
+        }
+    }
+    if (foreignDeps.fields.empty()) {
+        return boost::none;
+    }
+
+    // The hash join keys the foreign documents on 'foreignField' after the projection is applied.
+    if (_foreignField) {
+        foreignDeps.fields.insert(_foreignField->fullPath());
+    }
+    return foreignDeps.toProjectionWithoutMetadata();
+}
+
+boost::optional<Value> DocumentSourceLookUp::makeCorrelatedCacheKey(const Document& inputDoc) {
+    if (!_correlatedCache) {
+        if (_correlatedCacheDisabled) {
+            return boost::none;
+        }
+
+        // The non-correlated case is handled by '_cache', and a foreign pipeline with a random
+        // component may legitimately return different results for the same binding.
+        DepsTracker subDeps(DepsTracker::kNoMetadata);
+        if (_resolvedIntrospectionPipeline) {
+            for (auto&& source : _resolvedIntrospectionPipeline->getSources()) {
+                source->getDependencies(&subDeps);
+            }
+        }
+        _correlatedCacheDisabled = (!hasLocalFieldForeignFieldJoin() && _letVariables.empty()) ||
+            subDeps.needRandomGenerator ||
+            internalDocumentSourceLookupCorrelatedCacheSizeBytes.load() == 0;
+        if (_correlatedCacheDisabled) {
+            return boost::none;
+        }
+        _correlatedCache.emplace(ValueComparator::kInstance);
+    }
+
+    // The key holds the exact BSON of the local/foreignField predicate and of each 'let' value, so
+    // that bindings which only compare equal, such as 1 and 1.0, are cached separately.
+    BSONObjBuilder keyBuilder;
+    if (hasLocalFieldForeignFieldJoin()) {
+        keyBuilder.append("", _resolvedPipeline[*_fieldMatchPipelineIdx]);
+    }
+    for (auto&& letVar : _letVariables) {
+        keyBuilder << letVar.name << letVar.expression->evaluate(inputDoc, &pExpCtx->variables);
+    }
+    auto key = keyBuilder.done();
+    return Value(StringData(key.objdata(), key.objsize()));
+}
+
+bool DocumentSourceLookUp::canUseHashJoin() const {
+    // The hash join only applies to a plain equality join on the foreign collection itself, not to
+    // pipelines, views or stages absorbed into this $lookup.
+    return hasLocalFieldForeignFieldJoin() && !hasPipeline() && !_unwindSrc && !_matchSrc &&
+        !_additionalFilter && _resolvedPipeline.size() == 1 &&
+        LookupHashTable::canBuildOn(*_foreignField) &&
+        internalDocumentSourceLookupHashJoinMaxMemoryBytes.load() > 0;
+}
+
+boost::optional<std::vector<Value>> DocumentSourceLookUp::lookUpInHashTable(
+    const Document& inputDoc) {
+    if (_hashJoinAbandoned || (!_hashTable && !canUseHashJoin())) {
+        return boost::none;
+    }
+
+    if (!_hashTable) {
+        // Scan the whole foreign collection once with an empty join predicate, restoring the
+        // predicate for 'inputDoc' in case the table is abandoned.
+        auto fieldMatch = std::exchange(_resolvedPipeline[*_fieldMatchPipelineIdx],
+                                        BSON("$match" << BSONObj()));
+        ON_BLOCK_EXIT([&] { _resolvedPipeline[*_fieldMatchPipelineIdx] = std::move(fieldMatch); });
+        auto pipeline = buildPipeline(inputDoc);
+
+        _hashTable.emplace(
+            _fromExpCtx, *_foreignField, internalDocumentSourceLookupHashJoinMaxMemoryBytes.load());
+        while (auto foreignDoc = pipeline->getNext()) {
+            if (!_hashTable->add(foreignDoc->toBson())) {
+                _hashTable.reset();
+                _hashJoinAbandoned = true;
+                break;
+            }
+        }
+
+        recordPlanSummaryStats(*pipeline);
+        if (_hashJoinAbandoned) {
+            return boost::none;
+        }
+    }
+
+    std::vector<Value> localValues;
+    document_path_support::visitAllValuesAtPath(
+        inputDoc, *_localField, [&](const Value& value) { localValues.push_back(value); });
+
+    // Check the candidates against the predicate the foreign query would have used.
+    auto matchStage =
+        makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
+    auto joinPredicate = uassertStatusOK(
+        MatchExpressionParser::parse(matchStage.firstElement().embeddedObject(), _fromExpCtx));
+
+    return _hashTable->probe(localValues, *joinPredicate);
+}
+
 bool DocumentSourceLookUp::usedDisk() {
     if (_pipeline)
         _stats.planSummaryStats.usedDisk =
@@ -560,6 +745,7 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    _hashTable.reset();
     if (_pipeline) {
         recordPlanSummaryStats(*_pipeline);
         _pipeline->dispose(pExpCtx->opCtx);
@@ -785,6 +971,10 @@ void DocumentSourceLookUp::serializeToArrayWithBothSyntaxes(
                           << _unwindSrc->preserveNullAndEmptyArrays() << "includeArrayIndex"
                           << (indexPath ? Value(indexPath->fullPath()) : Value())));
         }
+        if (*explain >= ExplainOptions::Verbosity::kExecStats && _correlatedCache) {
+            output["correlatedCacheHits"] = Value(_stats.correlatedCacheHits);
+            output["correlatedCacheMisses"] = Value(_stats.correlatedCacheMisses);
+        }
         array.push_back(output.freezeToValue());
     } else {
         array.push_back(output.freezeToValue());
@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/pipeline/lookup_hash_table.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 
 namespace mongo {
@@ -286,6 +287,36 @@ private:
      */
     void recordPlanSummaryStats(const Pipeline& pipeline);
 
+    /**
+     * Returns true if this $lookup may answer its lookups from a hash table over the foreign
+     * collection, see LookupHashTable.
+     */
+    bool canUseHashJoin() const;
+
+    /**
+     * Returns the foreign documents joining with 'inputDoc' from '_hashTable', building the table
+     * by scanning the foreign collection on the first call. Returns boost::none if the hash join
+     * cannot be used or the foreign collection did not fit into memory, in which case the caller
+     * must query the foreign collection.
+     */
+    boost::optional<std::vector<Value>> lookUpInHashTable(const Document& inputDoc);
+
+    /**
+     * Returns an inclusion projection over the foreign documents if the stages following 'itr' in
+     * 'container' are known to read only some subfields of the 'as' path, or boost::none if they
+     * may need the whole joined documents.
+     */
+    boost::optional<BSONObj> computeForeignProjection(
+        Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) const;
+
+    /**
+     * Returns the key under which the foreign pipeline's results for 'inputDoc' are kept in
+     * '_correlatedCache', creating the cache on first use. Returns boost::none if those results
+     * may not be cached. Must be called after the local/foreignField $match for 'inputDoc' has
+     * been placed into '_resolvedPipeline'.
+     */
+    boost::optional<Value> makeCorrelatedCacheKey(const Document& inputDoc);
+
     DocumentSourceLookupStats _stats;
 
     NamespaceString _fromNs;
@@ -293,6 +324,10 @@ private:
     FieldPath _as;
     boost::optional<BSONObj> _additionalFilter;
 
+    // Appended as a $project to the foreign pipeline when the rest of the pipeline only reads some
+    // fields of the joined documents. Computed in doOptimizeAt().
+    boost::optional<BSONObj> _foreignProjection;
+
     // For use when $lookup is specified with localField/foreignField syntax.
     boost::optional<FieldPath> _localField;
     boost::optional<FieldPath> _foreignField;
@@ -311,6 +346,17 @@ private:
     // from a cursor source.
     boost::optional<SequentialDocumentCache> _cache;
 
+    // Caches the results of a correlated foreign pipeline for each distinct binding of the 'let'
+    // variables and local field, evicting the least recently used results beyond
+    // 'internalDocumentSourceLookupCorrelatedCacheSizeBytes'.
+    boost::optional<LookupSetCache> _correlatedCache;
+    bool _correlatedCacheDisabled = false;
+
+    // The hash table over the foreign collection used for a hash join, once it has been built.
+    // '_hashJoinAbandoned' is set if the foreign collection did not fit into the table.
+    boost::optional<LookupHashTable> _hashTable;
+    bool _hashJoinAbandoned = false;
+
     // The ExpressionContext used when performing aggregation pipelines against the '_resolvedNs'
     // namespace.
     boost::intrusive_ptr<ExpressionContext> _fromExpCtx;
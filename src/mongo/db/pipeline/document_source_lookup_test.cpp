@@ -783,12 +783,18 @@ public:
 
         pipeline->addInitialSource(
             DocumentSourceMock::createForTest(_mockResults, pipeline->getContext()));
+        ++_numPipelinesAttached;
         return pipeline;
     }
 
+    int numPipelinesAttached() const {
+        return _numPipelinesAttached;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
     bool _removeLeadingQueryStages = false;
+    int _numPipelinesAttached = 0;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -1369,5 +1375,87 @@ TEST_F(DocumentSourceLookUpTest, ShouldNotCacheIfCorrelatedStageIsAbsorbedIntoPl
     ASSERT_VALUE_EQ(Value(subPipeline->writeExplainOps(kExplain)), Value(BSONArray(expectedPipe)));
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldReuseResultsOfCorrelatedPipelineForSameBinding) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "coll");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{{"x", 1}}, Document{{"x", 2}}, Document{{"x", 2}}};
+    auto mongoProcessInterface = std::make_shared<MockMongoInterface>(mockForeignContents);
+    expCtx->mongoProcessInterface = mongoProcessInterface;
+
+    auto docSource = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {let: {k: '$k'}, pipeline: [{$match: {$expr: {$eq: ['$x', '$$k']}}}, "
+                 "{$addFields: {k: '$$k'}}], from: 'coll', as: 'as'}}")
+            .firstElement(),
+        expCtx);
+    auto lookupStage = static_cast<DocumentSourceLookUp*>(docSource.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({Document{{"_id", 0}, {"k", 2}},
+                                                              Document{{"_id", 1}, {"k", 1}},
+                                                              Document{{"_id", 2}, {"k", 2}},
+                                                              Document{{"_id", 3}, {"k", 2.0}}},
+                                                             expCtx);
+    lookupStage->setSource(mockLocalSource.get());
+
+    auto expectedTwos = Value(std::vector<Value>{Value(Document{{"x", 2}, {"k", 2}}),
+                                                 Value(Document{{"x", 2}, {"k", 2}})});
+    auto next = lookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["as"], expectedTwos);
+
+    next = lookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["as"],
+                    Value(std::vector<Value>{Value(Document{{"x", 1}, {"k", 1}})}));
+
+    // The results for k: 2 are served from the cache.
+    next = lookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["as"], expectedTwos);
+    ASSERT_EQ(mongoProcessInterface->numPipelinesAttached(), 2);
+
+    // A binding which only compares equal to a cached one runs the pipeline again, since the
+    // pipeline may observe its type.
+    next = lookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_EQ(next.getDocument()["as"][0]["k"].getType(), BSONType::NumberDouble);
+    ASSERT_EQ(mongoProcessInterface->numPipelinesAttached(), 3);
+    ASSERT_TRUE(lookupStage->getNext().isEOF());
+
+    auto stats = static_cast<const DocumentSourceLookupStats*>(lookupStage->getSpecificStats());
+    ASSERT_EQ(stats->correlatedCacheHits, 1);
+    ASSERT_EQ(stats->correlatedCacheMisses, 3);
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldNotCacheResultsOfCorrelatedPipelineWithRandomness) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "coll");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"x", 1}}};
+    auto mongoProcessInterface = std::make_shared<MockMongoInterface>(mockForeignContents);
+    expCtx->mongoProcessInterface = mongoProcessInterface;
+
+    auto docSource = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {let: {k: '$k'}, pipeline: [{$addFields: {r: {$rand: {}}, k: '$$k'}}],"
+                 " from: 'coll', as: 'as'}}")
+            .firstElement(),
+        expCtx);
+    auto lookupStage = static_cast<DocumentSourceLookUp*>(docSource.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document{{"_id", 0}, {"k", 1}}, Document{{"_id", 1}, {"k", 1}}}, expCtx);
+    lookupStage->setSource(mockLocalSource.get());
+
+    ASSERT_TRUE(lookupStage->getNext().isAdvanced());
+    ASSERT_TRUE(lookupStage->getNext().isAdvanced());
+    ASSERT_TRUE(lookupStage->getNext().isEOF());
+    ASSERT_EQ(mongoProcessInterface->numPipelinesAttached(), 2);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -44,6 +44,7 @@
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/ctype.h"
 #include "mongo/util/str.h"
 
@@ -78,6 +79,7 @@ intrusive_ptr<DocumentSource> DocumentSourceMatch::optimize() {
     }
 
     _expression = MatchExpression::optimize(std::move(_expression));
+    _resetCompiledExpression();
 
     return this;
 }
@@ -86,6 +88,13 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
     // The user facing error should have been generated earlier.
     massert(17309, "Should never call getNext on a $match stage with $text clause", !_isTextQuery);
 
+    if (!_compiledExpressionMade) {
+        if (internalQueryEnableCompiledMatchExpressions.load()) {
+            _compiledExpression = CompiledMatchExpression::compile(_expression.get());
+        }
+        _compiledExpressionMade = true;
+    }
+
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
         // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
@@ -95,7 +104,8 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
             : document_path_support::documentToBsonWithPaths(nextInput.getDocument(),
                                                              _dependencies.fields);
 
-        if (_expression->matchesBSON(toMatch)) {
+        if (_compiledExpression ? _compiledExpression->matches(toMatch)
+                                : _expression->matchesBSON(toMatch)) {
             return nextInput;
         }
 
@@ -387,6 +397,7 @@ DocumentSourceMatch::splitSourceBy(const std::set<std::string>& fields,
         // The entire $match depends on 'fields'. It cannot be split or moved, so we return this
         // stage without modification as the second stage in the pair.
         _expression = std::move(newExpr.second);
+        _resetCompiledExpression();
         return {nullptr, this};
     }
 
@@ -395,6 +406,7 @@ DocumentSourceMatch::splitSourceBy(const std::set<std::string>& fields,
         // this case, the current stage can swap with its predecessor without modification. We
         // simply return this as the first stage in the pair.
         _expression = std::move(newExpr.first);
+        _resetCompiledExpression();
         return {this, nullptr};
     }
 
@@ -499,6 +511,7 @@ void DocumentSourceMatch::rebuild(BSONObj filter) {
     _predicate = filter.getOwned();
     _expression = uassertStatusOK(MatchExpressionParser::parse(
         _predicate, pExpCtx, ExtensionsCallbackNoop(), Pipeline::kAllowedMatcherFeatures));
+    _resetCompiledExpression();
     _isTextQuery = isTextQuery(_predicate);
     _dependencies =
         DepsTracker(_isTextQuery ? DepsTracker::kAllMetadata & ~DepsTracker::kOnlyTextScore
@@ -34,6 +34,7 @@
 #include <utility>
 
 #include "mongo/client/connpool.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/matcher.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/util/intrusive_counter.h"
@@ -207,8 +208,22 @@ protected:
     BSONObj _predicate;
 
 private:
+    /**
+     * Drops the compiled form of '_expression', which must be called whenever '_expression' is
+     * replaced.
+     */
+    void _resetCompiledExpression() {
+        _compiledExpression.reset();
+        _compiledExpressionMade = false;
+    }
+
     std::unique_ptr<MatchExpression> _expression;
 
+    // The compiled form of '_expression', if it has one. Made on the first call to getNext(),
+    // once the pipeline has been optimized.
+    std::unique_ptr<CompiledMatchExpression> _compiledExpression;
+    bool _compiledExpressionMade = false;
+
     bool _isTextQuery;
 
     // Cache the dependencies so that we know what fields we need to serialize to BSON for matching.
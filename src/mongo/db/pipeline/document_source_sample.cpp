@@ -31,12 +31,16 @@
 
 #include "mongo/db/pipeline/document_source_sample.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 using boost::intrusive_ptr;
@@ -54,6 +58,22 @@ DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
     if (_size == 0)
         return GetNextResult::makeEOF();
 
+    // A merger expects each shard's sample sorted by its random values, and only the sort can
+    // spill to disk.
+    if (!pExpCtx->needsMerge && !pExpCtx->allowDiskUse) {
+        if (!_reservoirPopulated) {
+            auto status = loadReservoir();
+            if (!status.isEOF()) {
+                return status;  // Propagate the pause.
+            }
+        }
+        if (_nextOutput == _reservoir.size()) {
+            _reservoir.clear();
+            return GetNextResult::makeEOF();
+        }
+        return std::move(_reservoir[_nextOutput++]);
+    }
+
     if (!_sortStage->isPopulated()) {
         // Exhaust source stage, add random metadata, and push all into sorter.
         PseudoRandom& prng = pExpCtx->opCtx->getClient()->getPrng();
@@ -80,6 +100,67 @@ DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
     return _sortStage->getNext();
 }
 
+DocumentSource::GetNextResult DocumentSourceSample::loadReservoir() {
+    PseudoRandom& prng = pExpCtx->opCtx->getClient()->getPrng();
+    // Uniform in (0, 1], so that its logarithm is finite.
+    auto nextUniform = [&] { return 1.0 - prng.nextCanonicalDouble(); };
+    auto sampleSize = static_cast<size_t>(_size);
+
+    // Until the reservoir is full every document is kept. After that, the gap to the next
+    // document that replaces a random member of the reservoir follows a geometric distribution
+    // whose parameter '_skipWeight' shrinks as more documents are seen (Li's algorithm L).
+    auto computeNextSampled = [&] {
+        _skipWeight *= std::exp(std::log(nextUniform()) / _size);
+        auto skip = std::floor(std::log(nextUniform()) / std::log1p(-_skipWeight));
+        const auto maxSkip = std::numeric_limits<long long>::max() - _nSeen - 1;
+        _nextSampled = skip < static_cast<double>(maxSkip)
+            ? _nSeen + static_cast<long long>(skip) + 1
+            : std::numeric_limits<long long>::max();
+    };
+
+    auto nextInput = pSource->getNext();
+    for (; nextInput.isAdvanced(); nextInput = pSource->getNext(), ++_nSeen) {
+        if (_reservoir.size() < sampleSize) {
+            _reservoir.push_back(nextInput.releaseDocument());
+            _reservoirMemoryUsageBytes += _reservoir.back().getApproximateSize();
+            if (_reservoir.size() == sampleSize) {
+                _skipWeight = 1.0;
+                computeNextSampled();
+            }
+        } else if (_nSeen == _nextSampled) {
+            auto& replaced = _reservoir[prng.nextInt64(_size)];
+            _reservoirMemoryUsageBytes -= replaced.getApproximateSize();
+            replaced = nextInput.releaseDocument();
+            _reservoirMemoryUsageBytes += replaced.getApproximateSize();
+            computeNextSampled();
+        } else {
+            continue;
+        }
+        uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                str::stream() << "$sample exceeded memory limit of " << _maxMemoryUsageBytes
+                              << " bytes, but did not opt in to external sorting.",
+                _reservoirMemoryUsageBytes <= _maxMemoryUsageBytes);
+    }
+    if (nextInput.isPaused()) {
+        return nextInput;
+    }
+
+    // The reservoir holds a uniform sample of the input, but not in a uniformly random order.
+    std::shuffle(_reservoir.begin(), _reservoir.end(), prng.urbg());
+
+    // Give the sample the 'randVal' metadata that the random sort would have left on it: the
+    // largest values, in descending order, of one uniform draw per input document.
+    double randVal = 1.0;
+    for (size_t i = 0; i < _reservoir.size(); ++i) {
+        randVal *= std::pow(nextUniform(), 1.0 / static_cast<double>(_nSeen - i));
+        MutableDocument doc(std::move(_reservoir[i]));
+        doc.metadata().setRandVal(randVal);
+        _reservoir[i] = doc.freeze();
+    }
+    _reservoirPopulated = true;
+    return nextInput;
+}
+
 Value DocumentSourceSample::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     return Value(DOC(kStageName << DOC("size" << _size)));
 }
@@ -118,6 +199,7 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceSample::create(
     intrusive_ptr<DocumentSourceSample> sample(new DocumentSourceSample(expCtx));
     sample->_size = size;
     sample->_sortStage = DocumentSourceSort::create(expCtx, randSortSpec, sample->_size);
+    sample->_maxMemoryUsageBytes = internalQueryMaxBlockingSortMemoryUsageBytes.load();
     return sample;
 }
 
@@ -76,10 +76,33 @@ private:
 
     GetNextResult doGetNext() final;
 
+    /**
+     * Consumes the input into '_reservoir', keeping a uniform sample of '_size' of the documents
+     * seen so far, and then shuffles the sample and gives it the same distribution of 'randVal'
+     * metadata as the random sort would have. Returns EOF once the sample is ready to be returned,
+     * or propagates a pause.
+     */
+    GetNextResult loadReservoir();
+
     long long _size;
 
     // Uses a $sort stage to randomly sort the documents.
     boost::intrusive_ptr<DocumentSourceSort> _sortStage;
+
+    // When the results need not be merged and the sample may not spill to disk, the input is
+    // instead sampled in a single pass, skipping the documents that will not be picked without
+    // generating a random sort key for each of them.
+    bool _reservoirPopulated = false;
+    std::vector<Document> _reservoir;
+    size_t _reservoirMemoryUsageBytes = 0;
+    size_t _maxMemoryUsageBytes;
+    size_t _nextOutput = 0;
+
+    // The number of input documents seen, and the position of the next one to replace a random
+    // member of a full reservoir. '_skipWeight' is the running weight of Li's algorithm L.
+    long long _nSeen = 0;
+    long long _nextSampled = 0;
+    double _skipWeight = 0;
 };
 
 }  // namespace mongo
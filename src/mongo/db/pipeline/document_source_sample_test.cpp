@@ -31,6 +31,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <memory>
+#include <set>
 
 #include "mongo/bson/bsonelement.h"
 #include "mongo/bson/bsonobj.h"
@@ -41,9 +42,11 @@
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/tick_source_mock.h"
 
 namespace mongo {
@@ -188,6 +191,60 @@ TEST_F(SampleBasics, ShouldPropagatePauses) {
     assertEOF();
 }
 
+TEST_F(SampleBasics, SampleIsDistinctSubsetOfInput) {
+    loadDocuments(1000);
+    createSample(10);
+
+    std::set<int> ids;
+    for (int i = 0; i < 10; ++i) {
+        auto next = sample()->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        auto id = next.getDocument()["_id"].getInt();
+        ASSERT_GTE(id, 0);
+        ASSERT_LT(id, 1000);
+        ASSERT_TRUE(ids.insert(id).second);
+    }
+    assertEOF();
+}
+
+TEST_F(SampleBasics, SampleIsUniform) {
+    // Each of 20 documents should be picked in about a quarter of the samples of size 5.
+    const int kTrials = 2000;
+    std::vector<int> counts(20, 0);
+    for (int trial = 0; trial < kTrials; ++trial) {
+        _mock = DocumentSourceMock::createForTest(getExpCtx());
+        loadDocuments(20);
+        createSample(5);
+        for (auto next = sample()->getNext(); next.isAdvanced(); next = sample()->getNext()) {
+            ++counts[next.getDocument()["_id"].getInt()];
+        }
+    }
+    for (auto count : counts) {
+        ASSERT_GT(count, kTrials / 4 - 150);
+        ASSERT_LT(count, kTrials / 4 + 150);
+    }
+}
+
+TEST_F(SampleBasics, ShouldFailWhenSampleExceedsMemoryLimit) {
+    const auto originalMaxBytes = internalQueryMaxBlockingSortMemoryUsageBytes.load();
+    internalQueryMaxBlockingSortMemoryUsageBytes.store(1000);
+    ON_BLOCK_EXIT([&] { internalQueryMaxBlockingSortMemoryUsageBytes.store(originalMaxBytes); });
+
+    std::string largeStr(1000, 'x');
+    source()->push_back(DOC("_id" << 0 << "str" << largeStr));
+    source()->push_back(DOC("_id" << 1 << "str" << largeStr));
+    createSample(2);
+    ASSERT_THROWS_CODE(sample()->getNext(),
+                       AssertionException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(SampleBasics, ShouldSortRandomlyWhenDiskUseIsAllowed) {
+    getExpCtx()->allowDiskUse = true;
+    loadDocuments(10);
+    checkResults(5, 5);
+}
+
 /**
  * Fixture to test error cases of the $sample stage.
  */
@@ -30,20 +30,173 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/pipeline/document_source_set_window_fields.h"
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/document_source_add_fields.h"
+#include "mongo/db/pipeline/document_source_project.h"
 #include "mongo/db/pipeline/document_source_set_window_fields_gen.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/query/query_feature_flags_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/overflow_arithmetic.h"
 
 namespace mongo {
 
-REGISTER_DOCUMENT_SOURCE_CONDITIONALLY(
+using boost::intrusive_ptr;
+using std::list;
+
+REGISTER_MULTI_STAGE_ALIAS_CONDITIONALLY(
     setWindowFields,
     LiteParsedDocumentSourceDefault::parse,
     DocumentSourceSetWindowFields::createFromBson,
+    ::mongo::feature_flags::gFeatureFlagWindowFunctions.isEnabledAndIgnoreFCV());
+
+REGISTER_DOCUMENT_SOURCE_CONDITIONALLY(
+    _internalSetWindowFields,
+    LiteParsedDocumentSourceDefault::parse,
+    DocumentSourceInternalSetWindowFields::createFromBson,
     boost::none,
     ::mongo::feature_flags::gFeatureFlagWindowFunctions.isEnabledAndIgnoreFCV());
 
-Value DocumentSourceSetWindowFields::serialize(
+namespace {
+
+// Holds the value of a partitionBy expression that is not a plain field path, so that it can be
+// sorted on.
+constexpr StringData kTempPartitionByField = "__internal_setWindowFields_partition_key"_sd;
+
+/**
+ * Parses the specification shared by $setWindowFields and $_internalSetWindowFields.
+ */
+SetWindowFieldsSpec parseSpec(BSONElement elem, StringData stageName) {
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << "the " << stageName
+                          << " stage specification must be an object, found "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+    return SetWindowFieldsSpec::parse(IDLParserErrorContext(stageName), elem.embeddedObject());
+}
+
+boost::optional<intrusive_ptr<Expression>> parsePartitionBy(
+    const SetWindowFieldsSpec& spec, const intrusive_ptr<ExpressionContext>& expCtx) {
+    if (auto partitionBy = spec.getPartitionBy()) {
+        return Expression::parseOperand(
+            expCtx.get(), partitionBy->getElement(), expCtx->variablesParseState);
+    }
+    return boost::none;
+}
+
+/**
+ * Adds 'offset' to the number 'value', widening the result as $add would.
+ */
+Value addOffset(const Value& value, const Value& offset) {
+    if (value.getType() == NumberDecimal || offset.getType() == NumberDecimal) {
+        return Value(value.coerceToDecimal().add(offset.coerceToDecimal()));
+    }
+    if (value.getType() == NumberDouble || offset.getType() == NumberDouble) {
+        return Value(value.coerceToDouble() + offset.coerceToDouble());
+    }
+    long long result;
+    if (overflow::add(value.coerceToLong(), offset.coerceToLong(), &result)) {
+        return Value(value.coerceToDouble() + offset.coerceToDouble());
+    }
+    return Value(result);
+}
+
+}  // namespace
+
+list<intrusive_ptr<DocumentSource>> DocumentSourceSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& expCtx) {
+    auto spec = parseSpec(elem, kStageName);
+    return create(expCtx, parsePartitionBy(spec, expCtx), spec.getSortBy(), spec.getOutput());
+}
+
+list<intrusive_ptr<DocumentSource>> DocumentSourceSetWindowFields::create(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    boost::optional<intrusive_ptr<Expression>> partitionBy,
+    boost::optional<BSONObj> sortBy,
+    BSONObj fields) {
+    list<intrusive_ptr<DocumentSource>> stages;
+
+    // Sort by partition first, so that the documents of each partition are next to each other, and
+    // then by sortBy within each partition.
+    BSONObjBuilder sortSpec;
+    boost::optional<std::string> partitionPath;
+    bool usesTempPartitionByField = false;
+    if (partitionBy) {
+        auto fieldPath = dynamic_cast<ExpressionFieldPath*>(partitionBy->get());
+        if (fieldPath && fieldPath->isRootFieldPath() &&
+            fieldPath->getFieldPath().getPathLength() > 1) {
+            partitionPath = fieldPath->getFieldPathWithoutCurrentPrefix().fullPath();
+        } else {
+            stages.push_back(DocumentSourceAddFields::create(
+                BSON(kTempPartitionByField << (*partitionBy)->serialize(false)), expCtx));
+            partitionPath = kTempPartitionByField.toString();
+            partitionBy = intrusive_ptr<Expression>(ExpressionFieldPath::createPathFromString(
+                expCtx.get(), *partitionPath, expCtx->variablesParseState));
+            usesTempPartitionByField = true;
+        }
+        sortSpec << *partitionPath << 1;
+    }
+    if (sortBy) {
+        for (auto&& elem : *sortBy) {
+            if (!partitionPath || elem.fieldNameStringData() != *partitionPath) {
+                sortSpec.append(elem);
+            }
+        }
+    }
+    BSONObj sortPattern = sortSpec.obj();
+    if (!sortPattern.isEmpty()) {
+        stages.push_back(DocumentSourceSort::create(expCtx, sortPattern));
+    }
+
+    stages.push_back(make_intrusive<DocumentSourceInternalSetWindowFields>(
+        expCtx, std::move(partitionBy), std::move(sortBy), std::move(fields)));
+
+    if (usesTempPartitionByField) {
+        stages.push_back(DocumentSourceProject::create(
+            BSON(kTempPartitionByField << 0), expCtx, DocumentSourceProject::kAliasNameUnset));
+    }
+    return stages;
+}
+
+DocumentSourceInternalSetWindowFields::DocumentSourceInternalSetWindowFields(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    boost::optional<intrusive_ptr<Expression>> partitionBy,
+    boost::optional<BSONObj> sortBy,
+    BSONObj fields)
+    : DocumentSource(kStageName, expCtx),
+      _partitionBy(std::move(partitionBy)),
+      _sortBy(std::move(sortBy)),
+      _fields(std::move(fields)) {
+    for (auto&& elem : _fields) {
+        _statements.push_back(WindowFunctionStatement::parse(elem, _sortBy, expCtx.get()));
+        _outputPaths.emplace_back(_statements.back().fieldName);
+
+        Window window;
+        window.function = WindowFunctionState::create(_statements.back().opName, expCtx.get());
+        _windows.push_back(std::move(window));
+
+        if (_statements.back().bounds.kind == WindowBounds::Kind::kRange && !_sortPath) {
+            // Parsing the statement checked that sortBy has exactly one field.
+            BSONElement sortElem = _sortBy->firstElement();
+            uassert(5698216,
+                    "A 'range' window requires sortBy to be in ascending or descending order",
+                    sortElem.isNumber());
+            _sortPath.emplace(sortElem.fieldName());
+            _sortAscending = sortElem.number() > 0;
+        }
+    }
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& expCtx) {
+    auto spec = parseSpec(elem, kStageName);
+    return make_intrusive<DocumentSourceInternalSetWindowFields>(
+        expCtx, parsePartitionBy(spec, expCtx), spec.getSortBy(), spec.getOutput());
+}
+
+Value DocumentSourceInternalSetWindowFields::serialize(
     boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument spec;
     spec[SetWindowFieldsSpec::kPartitionByFieldName] =
@@ -53,29 +206,281 @@ Value DocumentSourceSetWindowFields::serialize(
     return Value(DOC(kStageName << spec.freeze()));
 }
 
-boost::intrusive_ptr<DocumentSource> DocumentSourceSetWindowFields::createFromBson(
-    BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
-    uassert(ErrorCodes::FailedToParse,
-            str::stream() << "the " << kStageName
-                          << " stage specification must be an object, found "
-                          << typeName(elem.type()),
-            elem.type() == BSONType::Object);
+DepsTracker::State DocumentSourceInternalSetWindowFields::getDependencies(
+    DepsTracker* deps) const {
+    if (_partitionBy) {
+        (*_partitionBy)->addDependencies(deps);
+    }
+    if (_sortBy) {
+        for (auto&& elem : *_sortBy) {
+            deps->fields.insert(elem.fieldName());
+        }
+    }
+    for (auto&& statement : _statements) {
+        statement.input->addDependencies(deps);
+    }
+    // The documents are passed on with the window function results added.
+    return DepsTracker::State::SEE_NEXT;
+}
+
+Value DocumentSourceInternalSetWindowFields::partitionKey(const Document& doc) const {
+    if (!_partitionBy) {
+        return Value(BSONNULL);
+    }
+    Value key = (*_partitionBy)->evaluate(doc, &pExpCtx->variables);
+    uassert(5698217,
+            str::stream() << "partitionBy must not evaluate to an array, found " << key.toString(),
+            !key.isArray());
+    // A missing partition key sorts together with null, so both belong to the same partition.
+    return key.missing() ? Value(BSONNULL) : key;
+}
+
+DocumentSourceInternalSetWindowFields::Entry DocumentSourceInternalSetWindowFields::makeEntry(
+    Document doc) const {
+    Entry entry;
+    entry.inputs.reserve(_statements.size());
+    entry.memUsageBytes = doc.getApproximateSize();
+    for (auto&& statement : _statements) {
+        entry.inputs.push_back(statement.input->evaluate(doc, &pExpCtx->variables));
+        entry.memUsageBytes += entry.inputs.back().getApproximateSize();
+    }
+    if (_sortPath) {
+        entry.sortValue = doc.getNestedField(*_sortPath);
+        for (auto&& statement : _statements) {
+            if (statement.bounds.kind != WindowBounds::Kind::kRange) {
+                continue;
+            }
+            if (statement.bounds.unit) {
+                uassert(5698218,
+                        str::stream() << "A 'range' window with a 'unit' requires the sortBy "
+                                         "field to be a date, found "
+                                      << entry.sortValue.toString(),
+                        entry.sortValue.getType() == BSONType::Date);
+            } else {
+                uassert(5698219,
+                        str::stream() << "A 'range' window requires the sortBy field to be a "
+                                         "number, found "
+                                      << entry.sortValue.toString(),
+                        entry.sortValue.numeric());
+            }
+        }
+    }
+    entry.doc = std::move(doc);
+    return entry;
+}
+
+DocumentSource::GetNextResult::ReturnStatus
+DocumentSourceInternalSetWindowFields::loadNextDocument() {
+    auto next = pSource->getNext();
+    switch (next.getStatus()) {
+        case GetNextResult::ReturnStatus::kAdvanced: {
+            auto doc = next.releaseDocument();
+            auto key = partitionKey(doc);
+            if (!_partitionKey) {
+                _partitionKey = std::move(key);
+            } else if (pExpCtx->getValueComparator().evaluate(*_partitionKey != key)) {
+                _nextPartition = std::move(doc);
+                _partitionEnded = true;
+                break;
+            }
+            _buffer.push_back(makeEntry(std::move(doc)));
+            _memUsageBytes += _buffer.back().memUsageBytes;
+            checkMemoryUsage();
+            break;
+        }
+        case GetNextResult::ReturnStatus::kEOF:
+            _partitionEnded = true;
+            break;
+        case GetNextResult::ReturnStatus::kPauseExecution:
+            break;
+    }
+    return next.getStatus();
+}
+
+void DocumentSourceInternalSetWindowFields::startNextPartition() {
+    invariant(_nextPartition);
+    _buffer.clear();
+    _bufferStart = 0;
+    _current = 0;
+    _memUsageBytes = 0;
+    for (auto&& window : _windows) {
+        window.function->reset();
+        window.lower = 0;
+        window.upper = 0;
+    }
+
+    _partitionKey = partitionKey(*_nextPartition);
+    _buffer.push_back(makeEntry(std::move(*_nextPartition)));
+    _memUsageBytes += _buffer.back().memUsageBytes;
+    _nextPartition = boost::none;
+    _partitionEnded = false;
+}
+
+DocumentSourceInternalSetWindowFields::SortValueRange
+DocumentSourceInternalSetWindowFields::rangeFor(const WindowFunctionStatement& statement) const {
+    const Value& current = entryAt(_current).sortValue;
+    auto boundValue = [&](const WindowBounds::Bound& bound) -> boost::optional<Value> {
+        switch (bound.type) {
+            case WindowBounds::BoundType::kUnbounded:
+                return boost::none;
+            case WindowBounds::BoundType::kCurrent:
+                return current;
+            case WindowBounds::BoundType::kOffset:
+                if (statement.bounds.unit) {
+                    return Value(dateAdd(current.getDate(),
+                                         *statement.bounds.unit,
+                                         bound.offset.getLong(),
+                                         TimeZoneDatabase::utcZone()));
+                }
+                return addOffset(current, bound.offset);
+        }
+        MONGO_UNREACHABLE;
+    };
+    return {boundValue(statement.bounds.lower), boundValue(statement.bounds.upper)};
+}
+
+int DocumentSourceInternalSetWindowFields::compareToRange(const Entry& entry,
+                                                          const SortValueRange& range) const {
+    const auto& [lowest, highest] = range;
+    if (lowest && Value::compare(entry.sortValue, *lowest, nullptr) < 0) {
+        return _sortAscending ? -1 : 1;
+    }
+    if (highest && Value::compare(entry.sortValue, *highest, nullptr) > 0) {
+        return _sortAscending ? 1 : -1;
+    }
+    return 0;
+}
+
+bool DocumentSourceInternalSetWindowFields::windowsAreComplete() const {
+    if (_partitionEnded) {
+        return true;
+    }
+    for (auto&& statement : _statements) {
+        const auto& upper = statement.bounds.upper;
+        if (upper.type == WindowBounds::BoundType::kUnbounded) {
+            return false;
+        }
+        if (statement.bounds.kind == WindowBounds::Kind::kDocuments) {
+            long long offset = upper.type == WindowBounds::BoundType::kCurrent
+                ? 0
+                : upper.offset.getLong();
+            if (bufferEnd() <= _current + offset) {
+                return false;
+            }
+        } else if (compareToRange(_buffer.back(), rangeFor(statement)) <= 0) {
+            // The last document loaded may still be followed by more documents in the window.
+            return false;
+        }
+    }
+    return true;
+}
+
+std::pair<long long, long long> DocumentSourceInternalSetWindowFields::windowFor(
+    const WindowFunctionStatement& statement, const Window& window) const {
+    const auto& bounds = statement.bounds;
+    const bool unboundedBelow = bounds.lower.type == WindowBounds::BoundType::kUnbounded;
+    const bool unboundedAbove = bounds.upper.type == WindowBounds::BoundType::kUnbounded;
+
+    long long lower = 0;
+    long long upper = bufferEnd();
+    if (bounds.kind == WindowBounds::Kind::kDocuments) {
+        auto offsetOf = [](const WindowBounds::Bound& bound) {
+            return bound.type == WindowBounds::BoundType::kCurrent ? 0LL : bound.offset.getLong();
+        };
+        if (!unboundedBelow) {
+            lower = std::max(0LL, _current + offsetOf(bounds.lower));
+        }
+        if (!unboundedAbove) {
+            upper = std::max(lower, std::min(_current + offsetOf(bounds.upper) + 1, bufferEnd()));
+        }
+        return {lower, upper};
+    }
+
+    // Both edges of a 'range' window only move forward, so they are found by scanning on from
+    // where they were for the previous document.
+    auto range = rangeFor(statement);
+    if (!unboundedBelow) {
+        lower = window.lower;
+        while (lower < bufferEnd() && compareToRange(entryAt(lower), range) < 0) {
+            ++lower;
+        }
+    }
+    if (!unboundedAbove) {
+        upper = std::max(lower, window.upper);
+        while (upper < bufferEnd() && compareToRange(entryAt(upper), range) <= 0) {
+            ++upper;
+        }
+    }
+    return {lower, upper};
+}
+
+void DocumentSourceInternalSetWindowFields::releaseDocuments() {
+    long long firstNeeded = _current;
+    for (size_t i = 0; i < _statements.size(); ++i) {
+        const bool unboundedBelow =
+            _statements[i].bounds.lower.type == WindowBounds::BoundType::kUnbounded;
+        // A window that never shrinks only needs the documents it has yet to add.
+        firstNeeded = std::min(firstNeeded, unboundedBelow ? _windows[i].upper : _windows[i].lower);
+    }
+    while (_bufferStart < firstNeeded) {
+        _memUsageBytes -= _buffer.front().memUsageBytes;
+        _buffer.pop_front();
+        ++_bufferStart;
+    }
+}
+
+void DocumentSourceInternalSetWindowFields::checkMemoryUsage() const {
+    size_t memUsageBytes = _memUsageBytes;
+    for (auto&& window : _windows) {
+        memUsageBytes += window.function->getApproximateSize();
+    }
+    const auto maxMemoryUsageBytes = internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load();
+    uassert(ErrorCodes::ExceededMemoryLimit,
+            str::stream() << "Exceeded memory limit in $setWindowFields, used " << memUsageBytes
+                          << " bytes of the " << maxMemoryUsageBytes
+                          << " allowed. Narrow the window bounds or the partitions, or raise "
+                             "internalDocumentSourceSetWindowFieldsMaxMemoryBytes",
+            memUsageBytes <= static_cast<size_t>(maxMemoryUsageBytes));
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext() {
+    // Load documents until the next document to return, and every window around it, is in the
+    // buffer.
+    while (_current == bufferEnd() || !windowsAreComplete()) {
+        if (_current == bufferEnd() && _partitionEnded) {
+            if (!_nextPartition) {
+                return GetNextResult::makeEOF();
+            }
+            startNextPartition();
+            continue;
+        }
+        if (loadNextDocument() == GetNextResult::ReturnStatus::kPauseExecution) {
+            return GetNextResult::makePauseExecution();
+        }
+    }
+
+    MutableDocument output(entryAt(_current).doc);
+    for (size_t i = 0; i < _statements.size(); ++i) {
+        auto& window = _windows[i];
+        auto [lower, upper] = windowFor(_statements[i], window);
+        if (lower >= window.upper) {
+            // The window has moved past every document in it.
+            window.function->reset();
+            window.lower = window.upper = lower;
+        }
+        for (; window.upper < upper; ++window.upper) {
+            window.function->add(entryAt(window.upper).inputs[i]);
+        }
+        for (; window.lower < lower; ++window.lower) {
+            window.function->remove(entryAt(window.lower).inputs[i]);
+        }
+        output.setNestedField(_outputPaths[i], window.function->getValue());
+    }
+    checkMemoryUsage();
 
-    auto spec =
-        SetWindowFieldsSpec::parse(IDLParserErrorContext(kStageName), elem.embeddedObject());
-    auto partitionBy = [&]() -> boost::optional<boost::intrusive_ptr<Expression>> {
-        if (auto partitionBy = spec.getPartitionBy())
-            return Expression::parseOperand(
-                expCtx.get(), partitionBy->getElement(), expCtx->variablesParseState);
-        else
-            return boost::none;
-    }();
-    return make_intrusive<DocumentSourceSetWindowFields>(
-        expCtx, partitionBy, spec.getSortBy(), spec.getOutput());
-}
-
-DocumentSource::GetNextResult DocumentSourceSetWindowFields::doGetNext() {
-    return GetNextResult::makeEOF();
+    ++_current;
+    releaseDocuments();
+    return output.freeze();
 }
 
 }  // namespace mongo
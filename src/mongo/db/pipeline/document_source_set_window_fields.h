@@ -29,37 +29,67 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_set_window_fields_gen.h"
+#include "mongo/db/pipeline/window_function.h"
 
 namespace mongo {
 
-class DocumentSourceSetWindowFields final : public DocumentSource {
+/**
+ * The $setWindowFields stage is an alias for a $sort stage on the partitionBy and sortBy fields,
+ * followed by a $_internalSetWindowFields stage that computes the window functions over the sorted
+ * documents. A partitionBy that is not a field path is first stored in a temporary field by a $set
+ * stage, which a final $unset stage removes again.
+ */
+class DocumentSourceSetWindowFields final {
 public:
     static constexpr StringData kStageName = "$setWindowFields"_sd;
 
     /**
-     * Parses 'elem' into a $setWindowFields stage, or throws a AssertionException if 'elem' was an
-     * invalid specification.
+     * Parses 'elem' into the stages that make up a $setWindowFields stage, or throws a
+     * AssertionException if 'elem' was an invalid specification.
      */
-    static boost::intrusive_ptr<DocumentSource> createFromBson(
-        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+    static std::list<boost::intrusive_ptr<DocumentSource>> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
+    static std::list<boost::intrusive_ptr<DocumentSource>> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        boost::optional<boost::intrusive_ptr<Expression>> partitionBy,
+        boost::optional<BSONObj> sortBy,
+        BSONObj fields);
+
+private:
+    // It is illegal to construct a DocumentSourceSetWindowFields directly, use createFromBson()
+    // instead.
+    DocumentSourceSetWindowFields() = default;
+};
+
+/**
+ * Computes the window functions of a $setWindowFields stage over input that is already sorted by
+ * partition and then by sortBy. Documents are streamed through a buffer that holds only the
+ * documents some window still needs, and each window function slides its window forward by adding
+ * the documents that enter it and removing the ones that leave it.
+ */
+class DocumentSourceInternalSetWindowFields final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalSetWindowFields"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
-    DocumentSourceSetWindowFields(const boost::intrusive_ptr<ExpressionContext>& expCtx,
-                                  boost::optional<boost::intrusive_ptr<Expression>> partitionBy,
-                                  boost::optional<BSONObj> sortBy,
-                                  BSONObj fields)
-        : DocumentSource(kStageName, expCtx),
-          _partitionBy(partitionBy),
-          _sortBy(std::move(sortBy)),
-          _fields(std::move(fields)) {}
+    DocumentSourceInternalSetWindowFields(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        boost::optional<boost::intrusive_ptr<Expression>> partitionBy,
+        boost::optional<BSONObj> sortBy,
+        BSONObj fields);
 
     StageConstraints constraints(Pipeline::SplitState pipeState) const final {
-        return StageConstraints(StreamType::kBlocking,
+        return StageConstraints(StreamType::kStreaming,
                                 PositionRequirement::kNone,
                                 HostTypeRequirement::kNone,
-                                DiskUseRequirement::kWritesTmpData,
+                                DiskUseRequirement::kNoDiskUse,
                                 FacetRequirement::kAllowed,
                                 TransactionRequirement::kAllowed,
                                 LookupRequirement::kAllowed,
@@ -71,18 +101,121 @@ public:
     };
 
     boost::optional<DistributedPlanLogic> distributedPlanLogic() {
-        // Force to run on the merging half for now.
+        // Every document of a partition has to be seen by the same stage, so this runs on the
+        // merging half, after the preceding $sort has merged the sorted streams from the shards.
         return DistributedPlanLogic{nullptr, this, boost::none};
     }
 
+    DepsTracker::State getDependencies(DepsTracker* deps) const final;
+
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const;
 
     DocumentSource::GetNextResult doGetNext();
 
 private:
+    // A buffered document, along with what the window functions need from it.
+    struct Entry {
+        Document doc;
+        // The value of the 'input' of each window function for this document.
+        std::vector<Value> inputs;
+        // The sortBy value, only set when a window function has 'range' bounds.
+        Value sortValue;
+        size_t memUsageBytes;
+    };
+
+    // The state of a single window function, which covers the documents of the partition in
+    // [lower, upper).
+    struct Window {
+        std::unique_ptr<WindowFunctionState> function;
+        long long lower = 0;
+        long long upper = 0;
+    };
+
+    /**
+     * Pulls the next document from 'pSource' into the buffer, or ends the current partition if the
+     * document belongs to the next one or the input is exhausted. Returns the status of the result
+     * of 'pSource->getNext()', so that a kPauseExecution can be passed on.
+     */
+    GetNextResult::ReturnStatus loadNextDocument();
+
+    /**
+     * Returns the partition that 'doc' belongs to.
+     */
+    Value partitionKey(const Document& doc) const;
+
+    Entry makeEntry(Document doc) const;
+
+    /**
+     * Resets the buffer and every window to begin the partition of '_nextPartition'.
+     */
+    void startNextPartition();
+
+    /**
+     * Returns true if every window for the current document is known, which is when the buffer
+     * holds each document of those windows or the partition has ended.
+     */
+    bool windowsAreComplete() const;
+
+    /**
+     * Computes the [lower, upper) positions in the partition of the window of 'statement' for the
+     * current document.
+     */
+    std::pair<long long, long long> windowFor(const WindowFunctionStatement& statement,
+                                              const Window& window) const;
+
+    // The smallest and largest sortBy values in a 'range' window, where boost::none is unbounded.
+    using SortValueRange = std::pair<boost::optional<Value>, boost::optional<Value>>;
+
+    /**
+     * Returns the range of sortBy values in the 'range' window of 'statement' for the current
+     * document.
+     */
+    SortValueRange rangeFor(const WindowFunctionStatement& statement) const;
+
+    /**
+     * Returns whether 'entry' comes before (negative), within (zero) or after (positive) the
+     * documents in 'range', in sort order.
+     */
+    int compareToRange(const Entry& entry, const SortValueRange& range) const;
+
+    const Entry& entryAt(long long position) const {
+        return _buffer[position - _bufferStart];
+    }
+
+    long long bufferEnd() const {
+        return _bufferStart + static_cast<long long>(_buffer.size());
+    }
+
+    /**
+     * Drops the documents at the front of the buffer that no window needs anymore.
+     */
+    void releaseDocuments();
+
+    void checkMemoryUsage() const;
+
     boost::optional<boost::intrusive_ptr<Expression>> _partitionBy;
     boost::optional<BSONObj> _sortBy;
     BSONObj _fields;
+
+    std::vector<WindowFunctionStatement> _statements;
+    std::vector<FieldPath> _outputPaths;
+    std::vector<Window> _windows;
+    // The sortBy field and its direction, set only when a window function has 'range' bounds.
+    boost::optional<FieldPath> _sortPath;
+    bool _sortAscending = true;
+
+    // The documents of the current partition that a window may still need. The front of the buffer
+    // is the document at position '_bufferStart' in the partition.
+    std::deque<Entry> _buffer;
+    long long _bufferStart = 0;
+    // The position in the partition of the next document to return.
+    long long _current = 0;
+    size_t _memUsageBytes = 0;
+
+    boost::optional<Value> _partitionKey;
+    bool _partitionEnded = false;
+    // The first document of the next partition, which ended the current one.
+    boost::optional<Document> _nextPartition;
 };
 
 }  // namespace mongo
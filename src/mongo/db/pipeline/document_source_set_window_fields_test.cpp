@@ -36,8 +36,11 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_set_window_fields.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -85,11 +88,196 @@ TEST_F(DocumentSourceSetWindowFieldsTest, SuccessfullyParsesAndReserializes) {
     auto spec = fromjson(R"(
         {$setWindowFields: {partitionBy: '$state', sortBy: {city: 1}, output: {mySum: {$sum: 
         {input: '$pop', documents: [-10, 0]}}}}})");
-    auto parsedStage =
-        DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    auto stages = DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
     std::vector<Value> serializedArray;
-    parsedStage->serializeToArray(serializedArray);
-    ASSERT_BSONOBJ_EQ(serializedArray[0].getDocument().toBson(), spec);
+    for (auto&& stage : stages) {
+        stage->serializeToArray(serializedArray);
+    }
+    ASSERT_EQ(serializedArray.size(), 2U);
+    ASSERT_BSONOBJ_EQ(serializedArray[0].getDocument().toBson(),
+                      fromjson("{$sort: {state: 1, city: 1}}"));
+    ASSERT_BSONOBJ_EQ(serializedArray[1].getDocument().toBson(),
+                      BSON(DocumentSourceInternalSetWindowFields::kStageName
+                           << spec.firstElement().Obj()));
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, SortsOnTemporaryFieldForComputedPartitionBy) {
+    auto spec = fromjson(R"(
+        {$setWindowFields: {partitionBy: {$toLower: '$state'}, output: {mySum: {$sum: 
+        {input: '$pop'}}}}})");
+    auto stages = DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    std::vector<std::string> stageNames;
+    for (auto&& stage : stages) {
+        stageNames.push_back(stage->getSourceName());
+    }
+    ASSERT_EQ(stageNames,
+              std::vector<std::string>(
+                  {"$addFields", "$sort", "$_internalSetWindowFields", "$project"}));
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, FailsToParseInvalidWindowFunctions) {
+    auto parse = [&](std::string output) {
+        auto spec = fromjson("{$setWindowFields: {sortBy: {a: 1}, output: " + output + "}}");
+        DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    };
+    ASSERT_THROWS_CODE(parse("{f: {$notAFunction: {input: '$a'}}}"), AssertionException, 5698208);
+    ASSERT_THROWS_CODE(parse("{f: {$sum: {documents: [0, 0]}}}"), AssertionException, 5698213);
+    ASSERT_THROWS_CODE(
+        parse("{f: {$sum: {input: '$a', documents: [0, 0], range: [0, 0]}}}"),
+        AssertionException,
+        5698203);
+    ASSERT_THROWS_CODE(
+        parse("{f: {$sum: {input: '$a', documents: [1, -1]}}}"), AssertionException, 5698207);
+    ASSERT_THROWS_CODE(
+        parse("{f: {$sum: {input: '$a', documents: [0.5, 1]}}}"), AssertionException, 5698202);
+
+    auto spec = fromjson("{$setWindowFields: {output: {f: {$sum: {input: '$a', documents: [-1, "
+                         "0]}}}}}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx()),
+        AssertionException,
+        5698214);
+}
+
+/**
+ * Runs the $_internalSetWindowFields stage given by 'spec' over 'inputs', which must already be
+ * sorted by partition and sortBy, and returns its results.
+ */
+std::vector<Document> runWindowFunctions(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                         const BSONObj& spec,
+                                         std::deque<DocumentSource::GetNextResult> inputs) {
+    auto stage = DocumentSourceInternalSetWindowFields::createFromBson(
+        BSON(DocumentSourceInternalSetWindowFields::kStageName << spec).firstElement(), expCtx);
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    stage->setSource(mock.get());
+
+    std::vector<Document> results;
+    for (auto next = stage->getNext(); !next.isEOF(); next = stage->getNext()) {
+        if (next.isAdvanced()) {
+            results.push_back(next.releaseDocument());
+        }
+    }
+    return results;
+}
+
+std::vector<Value> fieldValues(const std::vector<Document>& docs, StringData field) {
+    std::vector<Value> values;
+    for (auto&& doc : docs) {
+        values.push_back(doc[field]);
+    }
+    return values;
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, SlidingDocumentsWindow) {
+    auto results = runWindowFunctions(
+        getExpCtx(),
+        fromjson("{sortBy: {x: 1}, output: {"
+                 "sum: {$sum: {input: '$x', documents: [-1, 1]}},"
+                 "max: {$max: {input: '$x', documents: [-2, -1]}},"
+                 "running: {$sum: {input: '$x', documents: ['unbounded', 'current']}}}}"),
+        {Document{{"x", 1}},
+         Document{{"x", 2}},
+         Document{{"x", 3}},
+         Document{{"x", 4}},
+         Document{{"x", 5}}});
+
+    ASSERT_EQ(results.size(), 5U);
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "sum")),
+                    Value(std::vector<Value>{Value(3), Value(6), Value(9), Value(12), Value(9)}));
+    ASSERT_VALUE_EQ(
+        Value(fieldValues(results, "max")),
+        Value(std::vector<Value>{Value(BSONNULL), Value(1), Value(2), Value(3), Value(4)}));
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "running")),
+                    Value(std::vector<Value>{Value(1), Value(3), Value(6), Value(10), Value(15)}));
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, ComputesEachPartitionSeparately) {
+    auto results = runWindowFunctions(
+        getExpCtx(),
+        fromjson("{partitionBy: '$p', sortBy: {x: 1}, output: {"
+                 "total: {$sum: {input: '$x'}},"
+                 "previous: {$push: {input: '$x', documents: [-1, -1]}}}}"),
+        {Document{{"p", 1}, {"x", 1}},
+         Document{{"p", 1}, {"x", 2}},
+         DocumentSource::GetNextResult::makePauseExecution(),
+         Document{{"p", 2}, {"x", 10}},
+         Document{{"x", 20}},
+         Document{{"p", BSONNULL}, {"x", 30}}});
+
+    ASSERT_EQ(results.size(), 5U);
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "total")),
+                    Value(std::vector<Value>{Value(3), Value(3), Value(10), Value(50), Value(50)}));
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "previous")),
+                    Value(fromjson("{a: [[], [1], [], [], [20]]}")["a"]));
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, RangeWindowOverDates) {
+    auto day = [](int n) { return Value(Date_t::fromMillisSinceEpoch(n * 24LL * 60 * 60 * 1000)); };
+    auto results = runWindowFunctions(
+        getExpCtx(),
+        fromjson("{sortBy: {t: 1}, output: {"
+                 "lastTwoDays: {$count: {range: [-1, 'current'], unit: 'day'}},"
+                 "peers: {$count: {range: ['current', 'current'], unit: 'day'}}}}"),
+        {Document{{"t", day(0)}},
+         Document{{"t", day(1)}},
+         Document{{"t", day(1)}},
+         Document{{"t", day(2)}},
+         Document{{"t", day(5)}}});
+
+    ASSERT_EQ(results.size(), 5U);
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "lastTwoDays")),
+                    Value(std::vector<Value>{Value(1), Value(3), Value(3), Value(3), Value(1)}));
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "peers")),
+                    Value(std::vector<Value>{Value(1), Value(2), Value(2), Value(1), Value(1)}));
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, RangeWindowOverDescendingNumbers) {
+    auto results = runWindowFunctions(
+        getExpCtx(),
+        fromjson("{sortBy: {x: -1}, output: {near: {$push: {input: '$x', range: [-2, 2]}}}}"),
+        {Document{{"x", 9}}, Document{{"x", 8}}, Document{{"x", 5}}, Document{{"x", 1}}});
+
+    ASSERT_EQ(results.size(), 4U);
+    ASSERT_VALUE_EQ(Value(fieldValues(results, "near")),
+                    Value(fromjson("{a: [[9, 8], [9, 8], [5], [1]]}")["a"]));
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, RangeWindowRequiresNumericSortValues) {
+    ASSERT_THROWS_CODE(
+        runWindowFunctions(
+            getExpCtx(),
+            fromjson("{sortBy: {x: 1}, output: {s: {$sum: {input: '$x', range: [-1, 0]}}}}"),
+            {Document{{"x", "a"_sd}}}),
+        AssertionException,
+        5698219);
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, FailsWhenWindowExceedsMemoryLimit) {
+    const auto originalLimit = internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load();
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(originalLimit); });
+    internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(5000);
+
+    const std::string str(1000, 'x');
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 10; ++i) {
+        inputs.push_back(Document{{"x", i}, {"str", str}});
+    }
+
+    // A window of a few documents fits in memory...
+    auto results = runWindowFunctions(
+        getExpCtx(),
+        fromjson("{sortBy: {x: 1}, output: {s: {$sum: {input: '$x', documents: [-1, 0]}}}}"),
+        inputs);
+    ASSERT_EQ(results.size(), 10U);
+
+    // ...but one holding every document does not.
+    ASSERT_THROWS_CODE(
+        runWindowFunctions(getExpCtx(),
+                           fromjson("{sortBy: {x: 1}, output: {s: {$push: {input: '$str'}}}}"),
+                           inputs),
+        AssertionException,
+        ErrorCodes::ExceededMemoryLimit);
 }
 
 TEST_F(DocumentSourceSetWindowFieldsTest, FailsToParseIfFeatureFlagDisabled) {
@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#pragma once
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/lookup_hash_table.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "mongo/bson/bsonelement_comparator_interface.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+namespace dps = ::mongo::dotted_path_support;
+
+LookupHashTable::LookupHashTable(const boost::intrusive_ptr<ExpressionContext>& foreignExpCtx,
+                                 FieldPath foreignField,
+                                 size_t maxMemoryUsageBytes)
+    : _foreignField(std::move(foreignField)),
+      _maxMemoryUsageBytes(maxMemoryUsageBytes),
+      _table(foreignExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>()) {
+    invariant(canBuildOn(_foreignField));
+}
+
+bool LookupHashTable::canBuildOn(const FieldPath& foreignField) {
+    for (size_t i = 0; i < foreignField.getPathLength(); ++i) {
+        if (str::parseUnsignedBase10Integer(foreignField.getFieldName(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LookupHashTable::addKey(const Value& key, size_t docIdx) {
+    auto& positions = _table[key];
+    // The same value may be found more than once along the path of a single document.
+    if (!positions.empty() && positions.back() == docIdx) {
+        return;
+    }
+    if (positions.empty()) {
+        _memoryUsageBytes += key.getApproximateSize();
+    }
+    positions.push_back(docIdx);
+    _memoryUsageBytes += sizeof(size_t);
+}
+
+bool LookupHashTable::add(const BSONObj& foreignDoc) {
+    const auto docIdx = _documents.size();
+    _documents.push_back(foreignDoc.getOwned());
+    _memoryUsageBytes += foreignDoc.objsize();
+
+    // A trailing array is hashed both as a whole and on each of its elements, since an equality
+    // predicate on the array field matches either of them.
+    BSONElementSet elements;
+    dps::extractAllElementsAlongPath(
+        _documents.back(), _foreignField.fullPath(), elements, false /* expandArrayOnTrailingField */);
+    for (auto&& elem : elements) {
+        addKey(Value(elem), docIdx);
+        if (elem.type() == BSONType::Array) {
+            for (auto&& subElem : elem.Obj()) {
+                addKey(Value(subElem), docIdx);
+            }
+        }
+    }
+
+    if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+        _documents.clear();
+        _table.clear();
+        _memoryUsageBytes = 0;
+        return false;
+    }
+    return true;
+}
+
+std::vector<Value> LookupHashTable::probe(const std::vector<Value>& localValues,
+                                          const MatchExpression& joinPredicate) const {
+    std::vector<size_t> candidates;
+
+    // An equality to null also matches documents which are missing the foreign field, and those
+    // are not hashed at all, so every document must be checked against the predicate.
+    const bool matchesMissing = localValues.empty() ||
+        std::any_of(localValues.begin(), localValues.end(), [](auto&& value) {
+                                    return value.nullish();
+                                });
+    if (matchesMissing) {
+        candidates.resize(_documents.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    } else {
+        for (auto&& value : localValues) {
+            if (auto it = _table.find(value); it != _table.end()) {
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        // Return the documents in the order they were added, with no duplicates.
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    std::vector<Value> results;
+    for (auto docIdx : candidates) {
+        if (joinPredicate.matchesBSON(_documents[docIdx])) {
+            results.emplace_back(_documents[docIdx]);
+        }
+    }
+    return results;
+}
+
+}  // namespace mongo
@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#pragma once
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/field_path.h"
+
+namespace mongo {
+
+/**
+ * An in-memory hash table over the documents of the foreign collection of a $lookup specified with
+ * the localField/foreignField syntax. It is built once from a single scan of the foreign collection
+ * and then probed with the 'localField' values of each input document, saving a query against the
+ * foreign collection per input document.
+ *
+ * The documents are hashed on every value found along the 'foreignField' path, using the collation
+ * of the foreign expression context. The hash table only narrows down the candidates: every
+ * candidate is checked against the same join predicate the foreign query would use, so the results
+ * are the same as those of the per-document strategy, up to their order.
+ */
+class LookupHashTable {
+public:
+    LookupHashTable(const boost::intrusive_ptr<ExpressionContext>& foreignExpCtx,
+                    FieldPath foreignField,
+                    size_t maxMemoryUsageBytes);
+
+    /**
+     * Returns true if a hash table can be built on the given 'foreignField' path. Paths with
+     * numeric components are rejected, since they may refer either to a field or to an array
+     * position.
+     */
+    static bool canBuildOn(const FieldPath& foreignField);
+
+    /**
+     * Adds a document of the foreign collection to the table. Returns false if this would make the
+     * table exceed its memory budget, in which case the table is cleared and must not be used.
+     */
+    bool add(const BSONObj& foreignDoc);
+
+    /**
+     * Returns the foreign documents matching 'joinPredicate', in the order they were added to the
+     * table. The 'localValues' are the values of the 'localField' path of the input document which
+     * 'joinPredicate' was built from, as in DocumentSourceLookUp::makeMatchStageFromInput().
+     */
+    std::vector<Value> probe(const std::vector<Value>& localValues,
+                             const MatchExpression& joinPredicate) const;
+
+    size_t memoryUsageBytes() const {
+        return _memoryUsageBytes;
+    }
+
+    size_t size() const {
+        return _documents.size();
+    }
+
+private:
+    void addKey(const Value& key, size_t docIdx);
+
+    const FieldPath _foreignField;
+    const size_t _maxMemoryUsageBytes;
+
+    std::vector<BSONObj> _documents;
+
+    // Maps each value found along '_foreignField' to the positions in '_documents' of the
+    // documents it was found in.
+    ValueUnorderedMap<std::vector<size_t>> _table;
+
+    size_t _memoryUsageBytes{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,168 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#pragma once
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/document_path_support.h"
+#include "mongo/db/pipeline/document_source_lookup.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/lookup_hash_table.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class LookupHashTableTest : public unittest::Test {
+protected:
+    /**
+     * Builds a table over 'foreignDocs' joining on 'foreignField'.
+     */
+    LookupHashTable makeTable(const std::vector<BSONObj>& foreignDocs,
+                              const std::string& foreignField,
+                              size_t maxMemoryUsageBytes = 1024 * 1024) {
+        LookupHashTable table{_expCtx, FieldPath(foreignField), maxMemoryUsageBytes};
+        for (auto&& doc : foreignDocs) {
+            ASSERT_TRUE(table.add(doc));
+        }
+        return table;
+    }
+
+    /**
+     * Probes 'table' with the 'localField' values of 'localDoc', the same way as $lookup does.
+     */
+    std::vector<Value> probe(const LookupHashTable& table,
+                             const BSONObj& localDoc,
+                             const std::string& localField,
+                             const std::string& foreignField) {
+        Document inputDoc{localDoc};
+        std::vector<Value> localValues;
+        document_path_support::visitAllValuesAtPath(
+            inputDoc, FieldPath(localField), [&](const Value& value) {
+                localValues.push_back(value);
+            });
+
+        auto matchStage = DocumentSourceLookUp::makeMatchStageFromInput(
+            inputDoc, FieldPath(localField), foreignField, BSONObj());
+        auto joinPredicate = uassertStatusOK(
+            MatchExpressionParser::parse(matchStage.firstElement().embeddedObject(), _expCtx));
+        return table.probe(localValues, *joinPredicate);
+    }
+
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx{new ExpressionContextForTest()};
+};
+
+void assertResults(const std::vector<Value>& results, const std::vector<BSONObj>& expected) {
+    ASSERT_EQ(results.size(), expected.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_VALUE_EQ(results[i], Value(expected[i]));
+    }
+}
+
+TEST_F(LookupHashTableTest, ReturnsMatchingDocumentsInInsertionOrder) {
+    auto table = makeTable({fromjson("{_id: 0, b: 1}"),
+                            fromjson("{_id: 1, b: 2}"),
+                            fromjson("{_id: 2, b: 1.0}"),
+                            fromjson("{_id: 3, b: [3, 1]}")},
+                           "b");
+
+    assertResults(probe(table, fromjson("{a: 1}"), "a", "b"),
+                  {fromjson("{_id: 0, b: 1}"),
+                   fromjson("{_id: 2, b: 1.0}"),
+                   fromjson("{_id: 3, b: [3, 1]}")});
+    assertResults(probe(table, fromjson("{a: [2, 3]}"), "a", "b"),
+                  {fromjson("{_id: 1, b: 2}"), fromjson("{_id: 3, b: [3, 1]}")});
+    assertResults(probe(table, fromjson("{a: 4}"), "a", "b"), {});
+}
+
+TEST_F(LookupHashTableTest, MatchesNestedAndWholeArrayValues) {
+    auto table = makeTable({fromjson("{_id: 0, b: [{c: 1}, {c: [2]}]}"),
+                            fromjson("{_id: 1, b: {c: [1, 2]}}"),
+                            fromjson("{_id: 2, b: [[{c: 1}]]}")},
+                           "b.c");
+
+    assertResults(probe(table, fromjson("{a: 1}"), "a", "b.c"),
+                  {fromjson("{_id: 0, b: [{c: 1}, {c: [2]}]}"),
+                   fromjson("{_id: 1, b: {c: [1, 2]}}")});
+    assertResults(probe(table, fromjson("{a: [[1, 2]]}"), "a", "b.c"),
+                  {fromjson("{_id: 1, b: {c: [1, 2]}}")});
+}
+
+TEST_F(LookupHashTableTest, NullAndMissingLocalValuesMatchMissingForeignField) {
+    auto table = makeTable({fromjson("{_id: 0, b: null}"),
+                            fromjson("{_id: 1}"),
+                            fromjson("{_id: 2, b: 1}"),
+                            fromjson("{_id: 3, b: [{c: 1}, {}]}")},
+                           "b");
+
+    const std::vector<BSONObj> expected{fromjson("{_id: 0, b: null}"), fromjson("{_id: 1}")};
+    assertResults(probe(table, fromjson("{a: null}"), "a", "b"), expected);
+    assertResults(probe(table, fromjson("{}"), "a", "b"), expected);
+}
+
+TEST_F(LookupHashTableTest, UsesCollation) {
+    _expCtx->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+    auto table =
+        makeTable({fromjson("{_id: 0, b: 'FOO'}"), fromjson("{_id: 1, b: 'bar'}")}, "b");
+
+    assertResults(probe(table, fromjson("{a: 'foo'}"), "a", "b"),
+                  {fromjson("{_id: 0, b: 'FOO'}")});
+}
+
+TEST_F(LookupHashTableTest, AddFailsOnceMemoryBudgetIsExceeded) {
+    const auto doc = fromjson("{_id: 0, b: 1}");
+    LookupHashTable table{_expCtx, FieldPath("b"), 1024};
+    ASSERT_TRUE(table.add(doc));
+
+    size_t numAdded = 1;
+    while (table.add(doc)) {
+        ++numAdded;
+        ASSERT_LTE(table.memoryUsageBytes(), 1024U);
+    }
+    ASSERT_GT(numAdded, 1U);
+    ASSERT_LT(numAdded, 1024U / doc.objsize());
+    ASSERT_EQ(table.size(), 0U);
+    ASSERT_EQ(table.memoryUsageBytes(), 0U);
+}
+
+TEST_F(LookupHashTableTest, RejectsPathsWithNumericComponents) {
+    ASSERT_TRUE(LookupHashTable::canBuildOn(FieldPath("a.b")));
+    ASSERT_FALSE(LookupHashTable::canBuildOn(FieldPath("a.0")));
+    ASSERT_FALSE(LookupHashTable::canBuildOn(FieldPath("a.1.b")));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -122,6 +122,24 @@ public:
         _memoryUsage += docSize;
     }
 
+    /**
+     * Inserts 'docs' as the whole set with key 'key', which must not be present in the cache yet.
+     * Unlike inserting documents one at a time, this also caches an empty set. The new entry is
+     * placed in the middle of the cache.
+     */
+    void insert(Value key, std::vector<Document> docs) {
+        size_t middle = size() / 2;
+        auto it = _container.begin();
+        std::advance(it, middle);
+
+        _memoryUsage += key.getApproximateSize();
+        for (auto&& doc : docs) {
+            _memoryUsage += doc.getApproximateSize();
+        }
+        auto insertionResult = _container.insert(it, {std::move(key), std::move(docs)});
+        invariant(insertionResult.second);
+    }
+
     /**
      * Evict the least-recently-used item.
      */
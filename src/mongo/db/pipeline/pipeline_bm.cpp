@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <random>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/query_test_service_context.h"
+
+namespace mongo {
+namespace {
+
+const int kNumDocuments = 10 * 1000;
+
+/**
+ * Generates the input documents shared by all benchmarks: a unique '_id', a low-cardinality
+ * 'category', a random 'amount', a short 'tags' array and some filler.
+ */
+std::deque<DocumentSource::GetNextResult> generateDocuments() {
+    std::mt19937_64 gen(1234);
+    const auto tags = BSON_ARRAY("a"
+                                 << "b"
+                                 << "c");
+    const std::string filler(64, 'x');
+    std::deque<DocumentSource::GetNextResult> docs;
+    for (int i = 0; i < kNumDocuments; i++) {
+        const int category = gen() % 16;
+        const long long amount = gen() % 10000;
+        docs.emplace_back(Document(BSON("_id" << i << "category" << category << "amount" << amount
+                                              << "tags" << tags << "filler" << filler)));
+    }
+    return docs;
+}
+
+/**
+ * Runs 'pipelineJson', a JSON array of stages, over the generated documents until it is exhausted,
+ * and reports the number of input documents processed per second. Parsing and optimizing the
+ * pipeline are not timed.
+ */
+void runPipeline(benchmark::State& state, const char* pipelineJson) {
+    QueryTestServiceContext testServiceContext;
+    auto opCtx = testServiceContext.makeOperationContext();
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx =
+        new ExpressionContextForTest(opCtx.get(), NamespaceString("test.bm"));
+
+    const auto pipelineObj = fromjson(std::string("{pipeline: ") + pipelineJson + "}");
+    std::vector<BSONObj> rawPipeline;
+    for (auto&& stage : pipelineObj["pipeline"].Obj()) {
+        rawPipeline.push_back(stage.Obj().getOwned());
+    }
+
+    const auto docs = generateDocuments();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto pipeline = Pipeline::parse(rawPipeline, expCtx);
+        pipeline->optimizePipeline();
+        pipeline->addInitialSource(DocumentSourceMock::createForTest(docs, expCtx));
+        state.ResumeTiming();
+
+        while (auto next = pipeline->getNext()) {
+            benchmark::DoNotOptimize(next);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumDocuments);
+}
+
+void BM_PipelineMatchPoint(benchmark::State& state) {
+    runPipeline(state, "[{$match: {_id: 5000}}]");
+}
+
+void BM_PipelineMatchRange(benchmark::State& state) {
+    runPipeline(state, "[{$match: {amount: {$gte: 1000, $lt: 2000}}}]");
+}
+
+void BM_PipelineProject(benchmark::State& state) {
+    runPipeline(state, "[{$project: {category: 1, double: {$multiply: ['$amount', 2]}}}]");
+}
+
+void BM_PipelineGroup(benchmark::State& state) {
+    runPipeline(state,
+                "[{$group: {_id: '$category', total: {$sum: '$amount'}, "
+                "maxAmount: {$max: '$amount'}, count: {$sum: 1}}}]");
+}
+
+void BM_PipelineSortLimit(benchmark::State& state) {
+    runPipeline(state, "[{$sort: {amount: -1}}, {$limit: 10}]");
+}
+
+void BM_PipelineSort(benchmark::State& state) {
+    runPipeline(state, "[{$sort: {amount: 1, _id: 1}}]");
+}
+
+void BM_PipelineUnwindGroup(benchmark::State& state) {
+    runPipeline(state, "[{$unwind: '$tags'}, {$group: {_id: '$tags', count: {$sum: 1}}}]");
+}
+
+BENCHMARK(BM_PipelineMatchPoint);
+BENCHMARK(BM_PipelineMatchRange);
+BENCHMARK(BM_PipelineProject);
+BENCHMARK(BM_PipelineGroup);
+BENCHMARK(BM_PipelineSortLimit);
+BENCHMARK(BM_PipelineSort);
+BENCHMARK(BM_PipelineUnwindGroup);
+
+}  // namespace
+}  // namespace mongo
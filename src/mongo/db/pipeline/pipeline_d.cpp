@@ -70,6 +70,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -200,6 +201,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     BSONObj sortObj,
     SkipThenLimit skipThenLimit,
     boost::optional<std::string> groupIdForDistinctScan,
+    boost::optional<PushedDownGroup> pushedDownGroup,
     const AggregateCommand* aggRequest,
     const size_t plannerOpts,
     const MatchExpressionParser::AllowedFeatureSet& matcherFeatures) {
@@ -246,6 +248,10 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     // Mark the metadata that's requested by the pipeline on the CQ.
     cq.getValue()->requestAdditionalMetadata(metadataRequested);
 
+    if (pushedDownGroup) {
+        cq.getValue()->setPushedDownGroup(std::move(*pushedDownGroup));
+    }
+
     if (groupIdForDistinctScan) {
         // When the pipeline includes a $group that groups by a single field
         // (groupIdForDistinctScan), we use getExecutorDistinct() to attempt to get an executor that
@@ -278,6 +284,62 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
         expCtx->opCtx, &collection, std::move(cq.getValue()), permitYield, plannerOpts);
 }
 
+/**
+ * Returns true if the slot-based execution engine evaluates 'expr' exactly like the aggregation
+ * framework when it is the group-by key or the argument of an accumulator of a pushed down $group.
+ */
+bool isSupportedForGroupPushdown(const intrusive_ptr<Expression>& expr) {
+    if (dynamic_cast<ExpressionConstant*>(expr.get())) {
+        return true;
+    }
+    auto fieldPath = dynamic_cast<ExpressionFieldPath*>(expr.get());
+    return fieldPath && fieldPath->isRootFieldPath() &&
+        fieldPath->getFieldPath().getPathLength() > 1;
+}
+
+/**
+ * If 'stage' is a $group which the slot-based execution engine can compute on top of the query
+ * with the same results as DocumentSourceGroup, returns its description for the query layer.
+ *
+ * This is limited to a $group by a field path or a constant whose accumulators are all $min or
+ * $max of a field path or a constant. The other accumulators either compute different types in SBE
+ * ($sum, $avg) or depend on the input order, which the SBE hash aggregation does not preserve once
+ * it spills to disk ($first, $last, $push). The $group is only pushed down under the simple
+ * collation, and only when it may use the disk: without 'allowDiskUse' the SBE hash aggregation
+ * does not bound its memory use, whereas DocumentSourceGroup fails the query.
+ */
+boost::optional<PushedDownGroup> getGroupForPushdown(const intrusive_ptr<ExpressionContext>& expCtx,
+                                                     DocumentSource* stage,
+                                                     size_t plannerOpts) {
+    auto group = dynamic_cast<DocumentSourceGroup*>(stage);
+    if (!group || group->doingMerge() || !internalQueryEnableSlotBasedExecutionEngine.load() ||
+        !expCtx->allowDiskUse || expCtx->getCollator() ||
+        expCtx->tailableMode != TailableModeEnum::kNormal ||
+        (plannerOpts & QueryPlannerParams::TRACK_LATEST_OPLOG_TS)) {
+        return boost::none;
+    }
+
+    auto idFields = group->getIdFields();
+    if (idFields.size() != 1 || idFields.begin()->first != "_id" ||
+        !isSupportedForGroupPushdown(idFields.begin()->second)) {
+        return boost::none;
+    }
+
+    PushedDownGroup pushedDownGroup;
+    pushedDownGroup.spec = group->serialize().getDocument().toBson();
+    pushedDownGroup.idExpression = idFields.begin()->second;
+    for (auto&& accumulatedField : group->getAccumulatedFields()) {
+        std::string op = accumulatedField.makeAccumulator()->getOpName();
+        if ((op != "$min" && op != "$max") ||
+            !isSupportedForGroupPushdown(accumulatedField.expr.argument)) {
+            return boost::none;
+        }
+        pushedDownGroup.accumulators.push_back(
+            {accumulatedField.fieldName, std::move(op), accumulatedField.expr.argument});
+    }
+    return pushedDownGroup;
+}
+
 /**
  * Examines the indexes in 'collection' and returns the field name of a geo-indexed field suitable
  * for use in $geoNear. 2d indexes are given priority over 2dsphere indexes.
@@ -583,6 +645,12 @@ PipelineD::buildInnerQueryExecutorGeneric(const CollectionPtr& collection,
                                                 Pipeline::kAllowedMatcherFeatures,
                                                 &shouldProduceEmptyDocs));
 
+    // If the $sort was pushed down into the executor and the $group which followed it is still in
+    // the pipeline, the $group receives its input in sorted order and may be able to stream.
+    if (sortStage && groupStage && !sources.empty() && sources.front() == groupStage) {
+        groupStage->enableStreamingIfInputSortedBy(sortStage->getSortKeyPattern());
+    }
+
     const auto cursorType = shouldProduceEmptyDocs
         ? DocumentSourceCursor::CursorType::kEmptyDocuments
         : DocumentSourceCursor::CursorType::kRegular;
@@ -750,6 +818,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                                       sortObj,
                                                       SkipThenLimit{boost::none, boost::none},
                                                       rewrittenGroupStage->groupId(),
+                                                      boost::none, /* pushedDownGroup */
                                                       aggRequest,
                                                       plannerOpts,
                                                       matcherFeatures);
@@ -781,18 +850,31 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
-    return attemptToGetExecutor(expCtx,
-                                collection,
-                                nss,
-                                queryObj,
-                                projObj,
-                                deps.metadataDeps(),
-                                sortObj,
-                                skipThenLimit,
-                                boost::none, /* groupIdForDistinctScan */
-                                aggRequest,
-                                plannerOpts,
-                                matcherFeatures);
+    // A $group which now begins the pipeline may be computed by the query executor, in which case
+    // it is removed from the pipeline.
+    boost::optional<PushedDownGroup> pushedDownGroup;
+    if (!*hasNoRequirements) {
+        pushedDownGroup = getGroupForPushdown(expCtx, pipeline->peekFront(), plannerOpts);
+    }
+    const bool groupPushedDown = static_cast<bool>(pushedDownGroup);
+
+    auto swExecutor = attemptToGetExecutor(expCtx,
+                                           collection,
+                                           nss,
+                                           queryObj,
+                                           projObj,
+                                           deps.metadataDeps(),
+                                           sortObj,
+                                           skipThenLimit,
+                                           boost::none, /* groupIdForDistinctScan */
+                                           std::move(pushedDownGroup),
+                                           aggRequest,
+                                           plannerOpts,
+                                           matcherFeatures);
+    if (swExecutor.isOK() && groupPushedDown) {
+        pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
+    }
+    return swExecutor;
 }
 
 Timestamp PipelineD::getLatestOplogTimestamp(const Pipeline* pipeline) {
@@ -427,6 +427,20 @@ std::vector<BSONObj> CommonMongodProcessInterface::getMatchingPlanCacheEntryStat
     return planCache->getMatchingStats(serializer, predicate);
 }
 
+std::vector<BSONObj> CommonMongodProcessInterface::getQueryShapeStats(
+    OperationContext* opCtx, const NamespaceString& nss) const {
+    AutoGetCollection collection(opCtx, nss, MODE_IS);
+    uassert(5597802,
+            str::stream() << "collection '" << nss.toString() << "' does not exist",
+            collection);
+
+    const auto queryShapeStats =
+        CollectionQueryInfo::get(collection.getCollection()).getQueryShapeStats();
+    invariant(queryShapeStats);
+
+    return queryShapeStats->getStats();
+}
+
 bool CommonMongodProcessInterface::fieldsHaveSupportingUniqueIndex(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
@@ -386,6 +386,13 @@ public:
                                                                 const NamespaceString&,
                                                                 const MatchExpression*) const = 0;
 
+    /**
+     * Returns a vector of BSON objects, where each entry in the vector describes the execution
+     * statistics recorded for one query shape on the given namespace.
+     */
+    virtual std::vector<BSONObj> getQueryShapeStats(OperationContext*,
+                                                    const NamespaceString&) const = 0;
+
     /**
      * Returns true if there is an index on 'nss' with properties that will guarantee that a
      * document with non-array values for each of 'fieldPaths' will have at most one matching
@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/aggregation_request_helper.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -759,6 +760,69 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, cm);
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    const Pipeline* mergePipeline, const std::set<ShardId>& shardIds) {
+    const auto minShards = internalQueryMinShardsForGroupExchange.load();
+    if (internalQueryDisableExchange.load() || minShards == 0 ||
+        shardIds.size() < static_cast<size_t>(minShards)) {
+        return boost::none;
+    }
+
+    const auto& stages = mergePipeline->getSources();
+    if (stages.empty()) {
+        return boost::none;
+    }
+
+    const auto leadingGroup = dynamic_cast<DocumentSourceGroup*>(stages.front().get());
+    if (!leadingGroup || !leadingGroup->doingMerge()) {
+        return boost::none;
+    }
+
+    // The group keys are hashed to pick a consumer, which is only correct if equal keys always
+    // produce equal hashes. That does not hold for strings compared under a non-simple collation.
+    if (mergePipeline->getContext()->getCollator()) {
+        return boost::none;
+    }
+
+    // Each consumer finalizes a disjoint subset of the groups and mongos simply concatenates the
+    // consumers' output, so every stage after the $group must be able to run independently on each
+    // partition, on any shard.
+    for (auto it = std::next(stages.begin()); it != stages.end(); ++it) {
+        const auto& stage = *it;
+        const auto constraints = stage->constraints(Pipeline::SplitState::kSplitForMerge);
+        if (stage->distributedPlanLogic() ||
+            constraints.streamType != StageConstraints::StreamType::kStreaming ||
+            constraints.hostRequirement != StageConstraints::HostTypeRequirement::kNone) {
+            return boost::none;
+        }
+    }
+
+    // Partition the hashed group keys evenly across the targeted shards. The partial groups emitted
+    // by the shards part of the pipeline carry the group key in '_id'.
+    const size_t numConsumers = std::min(shardIds.size(), Exchange::kMaxNumberConsumers);
+    std::vector<ShardId> consumerShards(shardIds.begin(),
+                                        std::next(shardIds.begin(), numConsumers));
+
+    const uint64_t hashRangeStep = std::numeric_limits<uint64_t>::max() / numConsumers;
+    std::vector<BSONObj> boundaries;
+    boundaries.emplace_back(BSON("_id" << MINKEY));
+    for (size_t idx = 1; idx < numConsumers; ++idx) {
+        const auto bound = static_cast<long long>(
+            static_cast<uint64_t>(std::numeric_limits<long long>::min()) + idx * hashRangeStep);
+        boundaries.emplace_back(BSON("_id" << bound));
+    }
+    boundaries.emplace_back(BSON("_id" << MAXKEY));
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(std::move(boundaries));
+    exchangeSpec.setConsumers(numConsumers);
+
+    return ShardedExchangePolicy{std::move(exchangeSpec), std::move(consumerShards)};
+}
+
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
     auto& expCtx = pipeline->getContext();
     // Re-brand 'pipeline' as the merging pipeline. We will move stages one by one from the merging
@@ -905,6 +969,10 @@ DispatchShardPipelineResults dispatchShardPipeline(
         splitPipelines = splitPipeline(std::move(pipeline));
 
         exchangeSpec = checkIfEligibleForExchange(opCtx, splitPipelines->mergePipeline.get());
+        if (!exchangeSpec && !hasChangeStream && !splitPipelines->shardCursorsSortSpec) {
+            exchangeSpec =
+                checkIfEligibleForGroupExchange(splitPipelines->mergePipeline.get(), shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
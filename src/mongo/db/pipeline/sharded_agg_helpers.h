@@ -105,6 +105,14 @@ struct DispatchShardPipelineResults {
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
 
+/**
+ * If the merging pipeline starts with a merging $group whose output can be finalized independently
+ * on each partition of the group keys, and enough shards are targeted, returns an exchange which
+ * hash-partitions the partial groups from the shards across the targeted shards 'shardIds'.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    const Pipeline* mergePipeline, const std::set<ShardId>& shardIds);
+
 /**
  * Split the current Pipeline into a Pipeline for each shard, and a Pipeline that combines the
  * results within a merging process. This call also performs optimizations with the aim of reducing
@@ -170,5 +170,44 @@ TEST_F(TeeBufferTest, ShouldAllowOtherConsumersToAdvanceOnceTrailingConsumerIsDi
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
 }
+
+TEST_F(TeeBufferTest, ShouldNotSkipAheadWhenConsumerThatFinishedBatchIsDisposed) {
+    std::deque<DocumentSource::GetNextResult> inputs{
+        Document{{"a", 1}}, Document{{"a", 2}}, Document{{"a", 3}}};
+    auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+
+    const size_t nConsumers = 3;
+    const size_t bufferBytes = 1;  // Each doc will be in its own batch.
+    auto teeBuffer = TeeBuffer::create(nConsumers, bufferBytes);
+    teeBuffer->setSource(mock.get());
+
+    // Consumer #0 finishes the first batch and is then disposed.
+    ASSERT_TRUE(teeBuffer->getNext(0).isAdvanced());
+    ASSERT_TRUE(teeBuffer->getNext(0).isPaused());
+    teeBuffer->dispose(0);
+
+    // Consumer #1 finishing the batch must not load the next one while consumer #2 still hasn't
+    // seen the first doc.
+    ASSERT_TRUE(teeBuffer->getNext(1).isAdvanced());
+    ASSERT_TRUE(teeBuffer->getNext(1).isPaused());
+
+    auto next2 = teeBuffer->getNext(2);
+    ASSERT_TRUE(next2.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next2.getDocument(), inputs[0].getDocument());
+
+    // Now both remaining consumers see the rest of the input.
+    for (size_t consumerId : {1, 2}) {
+        auto next = teeBuffer->getNext(consumerId);
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.getDocument(), inputs[1].getDocument());
+    }
+    for (size_t consumerId : {1, 2}) {
+        auto next = teeBuffer->getNext(consumerId);
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.getDocument(), inputs[2].getDocument());
+    }
+    ASSERT_TRUE(teeBuffer->getNext(1).isEOF());
+    ASSERT_TRUE(teeBuffer->getNext(2).isEOF());
+}
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,470 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/window_function.h"
+
+#include <cmath>
+#include <deque>
+#include <set>
+
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/util/str.h"
+#include "mongo/util/summation.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr StringData kInputFieldName = "input"_sd;
+constexpr StringData kDocumentsFieldName = "documents"_sd;
+constexpr StringData kRangeFieldName = "range"_sd;
+constexpr StringData kUnitFieldName = "unit"_sd;
+
+bool isNaN(const Value& value) {
+    return (value.getType() == NumberDouble && std::isnan(value.getDouble())) ||
+        (value.getType() == NumberDecimal && value.getDecimal().isNaN());
+}
+
+WindowBounds::Bound parseBound(BSONElement elem, bool integral) {
+    if (elem.type() == BSONType::String) {
+        if (elem.valueStringData() == "unbounded"_sd) {
+            return {WindowBounds::BoundType::kUnbounded, Value()};
+        }
+        if (elem.valueStringData() == "current"_sd) {
+            return {WindowBounds::BoundType::kCurrent, Value()};
+        }
+    }
+
+    Value offset(elem);
+    uassert(5698201,
+            str::stream() << "Window bounds must be 'unbounded', 'current' or a number, found "
+                          << elem,
+            offset.numeric() && !isNaN(offset));
+    if (integral) {
+        uassert(5698202,
+                str::stream() << "Window bounds must be integers for a 'documents' window or a "
+                                 "'range' window with a 'unit', found "
+                              << elem,
+                offset.integral64Bit());
+        offset = Value(offset.coerceToLong());
+    }
+    return {WindowBounds::BoundType::kOffset, offset};
+}
+
+Value offsetOf(const WindowBounds::Bound& bound) {
+    return bound.type == WindowBounds::BoundType::kCurrent ? Value(0) : bound.offset;
+}
+
+/**
+ * $sum over a sliding window. Integers and doubles are summed with a DoubleDoubleSummation as in
+ * AccumulatorSum, which keeps removal exact for integers and close to exact for doubles. Values of
+ * each type, as well as NaNs and infinities, are counted so that removing the last of them narrows
+ * the result type again and no longer leaves it NaN.
+ */
+class WindowFunctionSum : public WindowFunctionState {
+public:
+    void add(const Value& value) override {
+        update(value, 1);
+    }
+
+    void remove(const Value& value) override {
+        update(value, -1);
+    }
+
+    Value getValue() const override {
+        const bool isDecimal = _decimalCount > 0;
+        if (_nanCount > 0 || (_posInfCount > 0 && _negInfCount > 0)) {
+            return isDecimal ? Value(Decimal128::kPositiveNaN)
+                             : Value(std::numeric_limits<double>::quiet_NaN());
+        }
+        if (_posInfCount > 0 || _negInfCount > 0) {
+            if (isDecimal) {
+                return Value(_posInfCount > 0 ? Decimal128::kPositiveInfinity
+                                              : Decimal128::kNegativeInfinity);
+            }
+            return Value(_posInfCount > 0 ? std::numeric_limits<double>::infinity()
+                                          : -std::numeric_limits<double>::infinity());
+        }
+
+        if (isDecimal) {
+            return Value(_decimalTotal.add(_nonDecimalTotal.getDecimal()));
+        }
+        if (_doubleCount == 0 && _nonDecimalTotal.fitsLong()) {
+            return _longCount > 0 ? Value(_nonDecimalTotal.getLong())
+                                  : Value::createIntOrLong(_nonDecimalTotal.getLong());
+        }
+        return Value(_nonDecimalTotal.getDouble());
+    }
+
+    void reset() override {
+        _count = 0;
+        _longCount = 0;
+        _doubleCount = 0;
+        _decimalCount = 0;
+        _nanCount = 0;
+        _posInfCount = 0;
+        _negInfCount = 0;
+        _nonDecimalTotal = {};
+        _decimalTotal = {};
+    }
+
+    size_t getApproximateSize() const override {
+        return sizeof(*this);
+    }
+
+    /**
+     * The number of numeric values in the window.
+     */
+    long long count() const {
+        return _count;
+    }
+
+    bool isDecimal() const {
+        return _decimalCount > 0;
+    }
+
+private:
+    void update(const Value& value, int sign) {
+        if (!value.numeric()) {
+            return;
+        }
+
+        _count += sign;
+        switch (value.getType()) {
+            case NumberLong:
+                _longCount += sign;
+                // Fallthrough.
+            case NumberInt: {
+                long long x = value.coerceToLong();
+                if (sign > 0) {
+                    _nonDecimalTotal.addLong(x);
+                } else {
+                    // Negate in two steps so that removing the smallest long doesn't overflow.
+                    _nonDecimalTotal.addLong(-(x + 1));
+                    _nonDecimalTotal.addLong(1);
+                }
+                break;
+            }
+            case NumberDouble: {
+                _doubleCount += sign;
+                double x = value.getDouble();
+                if (std::isnan(x)) {
+                    _nanCount += sign;
+                } else if (std::isinf(x)) {
+                    (x > 0 ? _posInfCount : _negInfCount) += sign;
+                } else {
+                    _nonDecimalTotal.addDouble(sign * x);
+                }
+                break;
+            }
+            case NumberDecimal: {
+                _decimalCount += sign;
+                Decimal128 x = value.getDecimal();
+                if (x.isNaN()) {
+                    _nanCount += sign;
+                } else if (x.isInfinite()) {
+                    (x.isNegative() ? _negInfCount : _posInfCount) += sign;
+                } else {
+                    _decimalTotal = sign > 0 ? _decimalTotal.add(x) : _decimalTotal.subtract(x);
+                }
+                break;
+            }
+            default:
+                MONGO_UNREACHABLE;
+        }
+
+        // Start over from exact zeros whenever the window empties, so that rounding errors from
+        // removing doubles don't carry over to later windows.
+        if (_count == 0) {
+            reset();
+        }
+    }
+
+    long long _count = 0;
+    long long _longCount = 0;
+    long long _doubleCount = 0;
+    long long _decimalCount = 0;
+    long long _nanCount = 0;
+    long long _posInfCount = 0;
+    long long _negInfCount = 0;
+    DoubleDoubleSummation _nonDecimalTotal;
+    Decimal128 _decimalTotal;
+};
+
+class WindowFunctionAvg final : public WindowFunctionSum {
+public:
+    Value getValue() const override {
+        if (count() == 0) {
+            return Value(BSONNULL);
+        }
+        Value sum = WindowFunctionSum::getValue();
+        if (isDecimal()) {
+            return Value(sum.getDecimal().divide(Decimal128(static_cast<int64_t>(count()))));
+        }
+        return Value(sum.coerceToDouble() / static_cast<double>(count()));
+    }
+};
+
+/**
+ * $min and $max over a sliding window, which keep every value in the window ordered so that the
+ * extreme one is still known after it leaves. Like the $min and $max accumulators, they ignore
+ * missing and null values.
+ */
+class WindowFunctionMinMax final : public WindowFunctionState {
+public:
+    WindowFunctionMinMax(ExpressionContext* expCtx, bool isMin)
+        : _values(ValueComparator::LessThan(&expCtx->getValueComparator())), _isMin(isMin) {}
+
+    void add(const Value& value) override {
+        if (value.nullish()) {
+            return;
+        }
+        _memUsageBytes += value.getApproximateSize();
+        _values.insert(value);
+    }
+
+    void remove(const Value& value) override {
+        if (value.nullish()) {
+            return;
+        }
+        auto it = _values.find(value);
+        invariant(it != _values.end());
+        _memUsageBytes -= it->getApproximateSize();
+        _values.erase(it);
+    }
+
+    Value getValue() const override {
+        if (_values.empty()) {
+            return Value(BSONNULL);
+        }
+        return _isMin ? *_values.begin() : *_values.rbegin();
+    }
+
+    void reset() override {
+        _values.clear();
+        _memUsageBytes = 0;
+    }
+
+    size_t getApproximateSize() const override {
+        return sizeof(*this) + _memUsageBytes;
+    }
+
+private:
+    std::multiset<Value, ValueComparator::LessThan> _values;
+    bool _isMin;
+    size_t _memUsageBytes = 0;
+};
+
+/**
+ * Window functions that need the values in the window in order: $push, $first and $last. $push
+ * skips missing values, while $first and $last report them as null.
+ */
+class WindowFunctionOrdered final : public WindowFunctionState {
+public:
+    enum class Kind { kPush, kFirst, kLast };
+
+    explicit WindowFunctionOrdered(Kind kind) : _kind(kind) {}
+
+    void add(const Value& value) override {
+        if (_kind == Kind::kPush && value.missing()) {
+            return;
+        }
+        _memUsageBytes += value.getApproximateSize();
+        _values.push_back(value);
+    }
+
+    void remove(const Value& value) override {
+        if (_kind == Kind::kPush && value.missing()) {
+            return;
+        }
+        invariant(!_values.empty());
+        _memUsageBytes -= _values.front().getApproximateSize();
+        _values.pop_front();
+    }
+
+    Value getValue() const override {
+        switch (_kind) {
+            case Kind::kPush:
+                return Value(std::vector<Value>(_values.begin(), _values.end()));
+            case Kind::kFirst:
+            case Kind::kLast: {
+                if (_values.empty()) {
+                    return Value(BSONNULL);
+                }
+                const Value& value = _kind == Kind::kFirst ? _values.front() : _values.back();
+                return value.missing() ? Value(BSONNULL) : value;
+            }
+        }
+        MONGO_UNREACHABLE;
+    }
+
+    void reset() override {
+        _values.clear();
+        _memUsageBytes = 0;
+    }
+
+    size_t getApproximateSize() const override {
+        return sizeof(*this) + _memUsageBytes;
+    }
+
+private:
+    Kind _kind;
+    std::deque<Value> _values;
+    size_t _memUsageBytes = 0;
+};
+
+}  // namespace
+
+WindowBounds WindowBounds::parse(const BSONObj& args) {
+    BSONElement documents = args[kDocumentsFieldName];
+    BSONElement range = args[kRangeFieldName];
+    BSONElement unit = args[kUnitFieldName];
+
+    uassert(5698203,
+            "A window function can't specify both 'documents' and 'range' bounds",
+            !(documents && range));
+    uassert(5698204, "'unit' can only be given with 'range' bounds", !unit || range);
+
+    WindowBounds bounds;
+    if (!documents && !range) {
+        return bounds;
+    }
+
+    if (range) {
+        bounds.kind = Kind::kRange;
+        if (unit) {
+            uassert(5698205,
+                    str::stream() << "'unit' must be a string, found " << typeName(unit.type()),
+                    unit.type() == BSONType::String);
+            bounds.unit = parseTimeUnit(unit.str());
+        }
+    }
+
+    BSONElement boundsElem = documents ? documents : range;
+    uassert(5698206,
+            str::stream() << "Window bounds must be an array of two elements, found "
+                          << boundsElem,
+            boundsElem.type() == BSONType::Array && boundsElem.Obj().nFields() == 2);
+
+    const bool integral = bounds.kind == Kind::kDocuments || bounds.unit;
+    BSONObjIterator it(boundsElem.Obj());
+    bounds.lower = parseBound(it.next(), integral);
+    bounds.upper = parseBound(it.next(), integral);
+
+    if (bounds.lower.type != BoundType::kUnbounded && bounds.upper.type != BoundType::kUnbounded) {
+        uassert(5698207,
+                str::stream() << "Lower window bound must not be greater than the upper bound, "
+                                 "found "
+                              << boundsElem,
+                Value::compare(offsetOf(bounds.lower), offsetOf(bounds.upper), nullptr) <= 0);
+    }
+    return bounds;
+}
+
+bool WindowFunctionState::isWindowFunction(StringData opName) {
+    return opName == "$sum"_sd || opName == "$count"_sd || opName == "$avg"_sd ||
+        opName == "$min"_sd || opName == "$max"_sd || opName == "$push"_sd ||
+        opName == "$first"_sd || opName == "$last"_sd;
+}
+
+std::unique_ptr<WindowFunctionState> WindowFunctionState::create(StringData opName,
+                                                                 ExpressionContext* expCtx) {
+    if (opName == "$sum"_sd || opName == "$count"_sd) {
+        return std::make_unique<WindowFunctionSum>();
+    } else if (opName == "$avg"_sd) {
+        return std::make_unique<WindowFunctionAvg>();
+    } else if (opName == "$min"_sd || opName == "$max"_sd) {
+        return std::make_unique<WindowFunctionMinMax>(expCtx, opName == "$min"_sd);
+    } else if (opName == "$push"_sd) {
+        return std::make_unique<WindowFunctionOrdered>(WindowFunctionOrdered::Kind::kPush);
+    } else if (opName == "$first"_sd) {
+        return std::make_unique<WindowFunctionOrdered>(WindowFunctionOrdered::Kind::kFirst);
+    } else if (opName == "$last"_sd) {
+        return std::make_unique<WindowFunctionOrdered>(WindowFunctionOrdered::Kind::kLast);
+    }
+    uasserted(5698208, str::stream() << "Unrecognized window function, " << opName);
+}
+
+WindowFunctionStatement WindowFunctionStatement::parse(BSONElement elem,
+                                                       const boost::optional<BSONObj>& sortBy,
+                                                       ExpressionContext* expCtx) {
+    WindowFunctionStatement statement;
+    statement.fieldName = elem.fieldName();
+    // Validates the output field name.
+    FieldPath fieldPath(statement.fieldName);
+
+    uassert(5698209,
+            str::stream() << "The field '" << statement.fieldName
+                          << "' must be an object with a single window function, found " << elem,
+            elem.type() == BSONType::Object && elem.Obj().nFields() == 1);
+    BSONElement functionElem = elem.Obj().firstElement();
+    statement.opName = functionElem.fieldName();
+    uassert(5698208,
+            str::stream() << "Unrecognized window function, " << statement.opName,
+            WindowFunctionState::isWindowFunction(statement.opName));
+    uassert(5698210,
+            str::stream() << "The arguments of " << statement.opName
+                          << " must be an object, found " << typeName(functionElem.type()),
+            functionElem.type() == BSONType::Object);
+
+    BSONObj args = functionElem.Obj();
+    for (auto&& arg : args) {
+        auto argName = arg.fieldNameStringData();
+        uassert(5698211,
+                str::stream() << "Unknown argument to " << statement.opName << ": " << argName,
+                argName == kInputFieldName || argName == kDocumentsFieldName ||
+                    argName == kRangeFieldName || argName == kUnitFieldName);
+    }
+
+    if (statement.opName == "$count"_sd) {
+        uassert(5698212, "$count does not accept an 'input'", !args[kInputFieldName]);
+        statement.input = ExpressionConstant::create(expCtx, Value(1));
+    } else {
+        uassert(5698213,
+                str::stream() << statement.opName << " requires an 'input'",
+                args[kInputFieldName]);
+        statement.input = Expression::parseOperand(
+            expCtx, args[kInputFieldName], expCtx->variablesParseState);
+    }
+
+    statement.bounds = WindowBounds::parse(args);
+    uassert(5698214,
+            str::stream() << "A bounded window for " << statement.opName << " requires a sortBy",
+            statement.bounds.isUnbounded() || sortBy);
+    uassert(5698215,
+            "A 'range' window requires a sortBy on exactly one field",
+            statement.bounds.kind == WindowBounds::Kind::kDocuments ||
+                (sortBy && sortBy->nFields() == 1));
+    return statement;
+}
+
+}  // namespace mongo
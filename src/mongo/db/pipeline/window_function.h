@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/query/datetime/date_time_support.h"
+
+namespace mongo {
+
+/**
+ * The bounds of the window over which a window function is computed, relative to the document the
+ * result is computed for. A 'documents' window counts documents before (negative) and after
+ * (positive) the current one in sort order, while a 'range' window includes every document whose
+ * sortBy value lies within the given offsets from the current document's sortBy value. Offsets in
+ * a 'range' window are in 'unit' when the sortBy value is a date.
+ */
+struct WindowBounds {
+    enum class Kind { kDocuments, kRange };
+    enum class BoundType { kUnbounded, kCurrent, kOffset };
+
+    struct Bound {
+        BoundType type = BoundType::kUnbounded;
+        // The offset from the current document, only meaningful for a kOffset bound. It is an
+        // integer for a 'documents' window or when 'unit' is set, and any number otherwise.
+        Value offset;
+    };
+
+    /**
+     * Parses the window bounds out of the arguments of a window function, the object holding its
+     * 'documents' or 'range' and 'unit' fields. Returns an unbounded 'documents' window if neither
+     * is present.
+     */
+    static WindowBounds parse(const BSONObj& args);
+
+    bool isUnbounded() const {
+        return lower.type == BoundType::kUnbounded && upper.type == BoundType::kUnbounded;
+    }
+
+    Kind kind = Kind::kDocuments;
+    Bound lower;
+    Bound upper;
+    boost::optional<TimeUnit> unit;
+};
+
+/**
+ * The running state of a window function over a window that slides forward through a partition.
+ * Unlike an AccumulatorState, values can also be removed from it, which lets a window move one
+ * document at a time without recomputing the function over every document it holds. Values are
+ * always removed in the order they were added.
+ */
+class WindowFunctionState {
+public:
+    /**
+     * Creates the state for the window function named 'opName', for example "$sum". Throws if
+     * there is no window function by that name.
+     */
+    static std::unique_ptr<WindowFunctionState> create(StringData opName,
+                                                       ExpressionContext* expCtx);
+
+    static bool isWindowFunction(StringData opName);
+
+    virtual ~WindowFunctionState() = default;
+
+    virtual void add(const Value& value) = 0;
+
+    /**
+     * Removes 'value' from the window. It must be the oldest value added that has not yet been
+     * removed.
+     */
+    virtual void remove(const Value& value) = 0;
+
+    /**
+     * Returns the result of the window function over the values currently in the window.
+     */
+    virtual Value getValue() const = 0;
+
+    /**
+     * Empties the window.
+     */
+    virtual void reset() = 0;
+
+    virtual size_t getApproximateSize() const = 0;
+};
+
+/**
+ * A single window function from the 'output' of a $setWindowFields stage, such as
+ * {total: {$sum: {input: "$x", documents: [-2, 0]}}}.
+ */
+struct WindowFunctionStatement {
+    /**
+     * Parses 'elem', an element of the 'output' object. The window bounds are checked against
+     * 'sortBy', since a bounded window is only meaningful over sorted documents.
+     */
+    static WindowFunctionStatement parse(BSONElement elem,
+                                         const boost::optional<BSONObj>& sortBy,
+                                         ExpressionContext* expCtx);
+
+    std::string fieldName;
+    std::string opName;
+    // Evaluated against each document that enters the window.
+    boost::intrusive_ptr<Expression> input;
+    WindowBounds bounds;
+};
+
+}  // namespace mongo
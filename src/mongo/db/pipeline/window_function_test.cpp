@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/window_function.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using WindowFunctionTest = AggregationContextFixture;
+
+TEST_F(WindowFunctionTest, SumNarrowsTypeWhenValuesLeaveTheWindow) {
+    auto sum = WindowFunctionState::create("$sum", getExpCtx().get());
+    sum->add(Value(1));
+    sum->add(Value(2.5));
+    sum->add(Value(2));
+    ASSERT_VALUE_EQ(sum->getValue(), Value(5.5));
+    ASSERT_EQ(sum->getValue().getType(), NumberDouble);
+
+    sum->remove(Value(1));
+    sum->remove(Value(2.5));
+    ASSERT_VALUE_EQ(sum->getValue(), Value(2));
+    ASSERT_EQ(sum->getValue().getType(), NumberInt);
+}
+
+TEST_F(WindowFunctionTest, SumRecoversFromNaNAndInfinity) {
+    auto sum = WindowFunctionState::create("$sum", getExpCtx().get());
+    sum->add(Value(std::numeric_limits<double>::infinity()));
+    sum->add(Value(-std::numeric_limits<double>::infinity()));
+    sum->add(Value(3));
+    ASSERT_TRUE(std::isnan(sum->getValue().getDouble()));
+
+    sum->remove(Value(std::numeric_limits<double>::infinity()));
+    ASSERT_VALUE_EQ(sum->getValue(), Value(-std::numeric_limits<double>::infinity()));
+
+    sum->remove(Value(-std::numeric_limits<double>::infinity()));
+    ASSERT_VALUE_EQ(sum->getValue(), Value(3));
+}
+
+TEST_F(WindowFunctionTest, SumRemovesSmallestLong) {
+    auto sum = WindowFunctionState::create("$sum", getExpCtx().get());
+    sum->add(Value(std::numeric_limits<long long>::min()));
+    sum->add(Value(5LL));
+    sum->remove(Value(std::numeric_limits<long long>::min()));
+    ASSERT_VALUE_EQ(sum->getValue(), Value(5LL));
+    ASSERT_EQ(sum->getValue().getType(), NumberLong);
+}
+
+TEST_F(WindowFunctionTest, SumAddsDecimals) {
+    auto sum = WindowFunctionState::create("$sum", getExpCtx().get());
+    sum->add(Value(Decimal128("0.1")));
+    sum->add(Value(1));
+    sum->add(Value(Decimal128("0.2")));
+    sum->remove(Value(Decimal128("0.1")));
+    ASSERT_VALUE_EQ(sum->getValue(), Value(Decimal128("1.2")));
+}
+
+TEST_F(WindowFunctionTest, AvgIgnoresNonNumericValues) {
+    auto avg = WindowFunctionState::create("$avg", getExpCtx().get());
+    ASSERT_VALUE_EQ(avg->getValue(), Value(BSONNULL));
+
+    avg->add(Value(1));
+    avg->add(Value("str"_sd));
+    avg->add(Value(4));
+    ASSERT_VALUE_EQ(avg->getValue(), Value(2.5));
+
+    avg->remove(Value(1));
+    ASSERT_VALUE_EQ(avg->getValue(), Value(4.0));
+}
+
+TEST_F(WindowFunctionTest, MinAndMaxTrackValuesLeavingTheWindow) {
+    auto min = WindowFunctionState::create("$min", getExpCtx().get());
+    auto max = WindowFunctionState::create("$max", getExpCtx().get());
+    for (auto&& value : {Value(3), Value(BSONNULL), Value(1), Value(7), Value(1)}) {
+        min->add(value);
+        max->add(value);
+    }
+    ASSERT_VALUE_EQ(min->getValue(), Value(1));
+    ASSERT_VALUE_EQ(max->getValue(), Value(7));
+
+    for (auto&& value : {Value(3), Value(BSONNULL), Value(1), Value(7)}) {
+        min->remove(value);
+        max->remove(value);
+    }
+    ASSERT_VALUE_EQ(min->getValue(), Value(1));
+    ASSERT_VALUE_EQ(max->getValue(), Value(1));
+
+    min->remove(Value(1));
+    ASSERT_VALUE_EQ(min->getValue(), Value(BSONNULL));
+}
+
+TEST_F(WindowFunctionTest, PushFirstAndLastKeepWindowOrder) {
+    auto push = WindowFunctionState::create("$push", getExpCtx().get());
+    auto first = WindowFunctionState::create("$first", getExpCtx().get());
+    auto last = WindowFunctionState::create("$last", getExpCtx().get());
+    for (auto&& value : {Value(1), Value(), Value(2)}) {
+        push->add(value);
+        first->add(value);
+        last->add(value);
+    }
+    ASSERT_VALUE_EQ(push->getValue(), Value(std::vector<Value>{Value(1), Value(2)}));
+    ASSERT_VALUE_EQ(first->getValue(), Value(1));
+    ASSERT_VALUE_EQ(last->getValue(), Value(2));
+
+    push->remove(Value(1));
+    first->remove(Value(1));
+    ASSERT_VALUE_EQ(push->getValue(), Value(std::vector<Value>{Value(2)}));
+    // A missing value is reported as null.
+    ASSERT_VALUE_EQ(first->getValue(), Value(BSONNULL));
+}
+
+TEST_F(WindowFunctionTest, ParsesWindowBounds) {
+    auto bounds = WindowBounds::parse(fromjson("{documents: ['unbounded', -1]}"));
+    ASSERT(bounds.kind == WindowBounds::Kind::kDocuments);
+    ASSERT(bounds.lower.type == WindowBounds::BoundType::kUnbounded);
+    ASSERT(bounds.upper.type == WindowBounds::BoundType::kOffset);
+    ASSERT_VALUE_EQ(bounds.upper.offset, Value(-1LL));
+
+    bounds = WindowBounds::parse(fromjson("{range: [-7, 'current'], unit: 'day'}"));
+    ASSERT(bounds.kind == WindowBounds::Kind::kRange);
+    ASSERT(bounds.unit == TimeUnit::day);
+    ASSERT(bounds.upper.type == WindowBounds::BoundType::kCurrent);
+
+    ASSERT_TRUE(WindowBounds::parse(BSONObj()).isUnbounded());
+    ASSERT_THROWS_CODE(WindowBounds::parse(fromjson("{documents: [0, 'now']}")),
+                       AssertionException,
+                       5698201);
+    ASSERT_THROWS_CODE(
+        WindowBounds::parse(fromjson("{documents: [0]}")), AssertionException, 5698206);
+    ASSERT_THROWS_CODE(
+        WindowBounds::parse(fromjson("{documents: [0, 1], unit: 'day'}")),
+        AssertionException,
+        5698204);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,242 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/cached_solution_template.h"
+
+#include <algorithm>
+
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/query/index_bounds_builder.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Collects the equalities of 'root' into 'out' if 'root' is an equality, or a conjunction of
+ * equalities on distinct paths. Returns false otherwise.
+ */
+bool getEqualities(const MatchExpression* root,
+                   std::vector<const EqualityMatchExpression*>* out) {
+    if (root->matchType() == MatchExpression::EQ) {
+        out->push_back(static_cast<const EqualityMatchExpression*>(root));
+        return true;
+    }
+    if (root->matchType() != MatchExpression::AND || root->numChildren() == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < root->numChildren(); ++i) {
+        const MatchExpression* child = root->getChild(i);
+        if (child->matchType() != MatchExpression::EQ) {
+            return false;
+        }
+        for (auto&& other : *out) {
+            if (other->path() == child->path()) {
+                return false;
+            }
+        }
+        out->push_back(static_cast<const EqualityMatchExpression*>(child));
+    }
+    return true;
+}
+
+/**
+ * Returns true if an equality to 'value' is indexed as a single point interval holding 'value'
+ * itself. Equalities to null, arrays and objects, among others, are indexed differently.
+ */
+bool isBindableValue(const BSONElement& value) {
+    switch (value.type()) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case String:
+        case jstOID:
+        case Date:
+        case Bool:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Returns true if the solution built for 'query' depends only on its plan cache key and the
+ * values of its equalities.
+ */
+bool isBindableQuery(const CanonicalQuery& query,
+                     std::vector<const EqualityMatchExpression*>* equalities) {
+    const QueryRequest& qr = query.getQueryRequest();
+    if (query.getCollator() || qr.getSkip() || qr.getLimit() || qr.getNToReturn() ||
+        qr.returnKey() || qr.showRecordId()) {
+        return false;
+    }
+    if (!getEqualities(query.root(), equalities)) {
+        return false;
+    }
+    for (auto&& equality : *equalities) {
+        if (!isBindableValue(equality->getData())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+IndexScanNode* getIndexScan(QuerySolutionNode* node) {
+    while (node->getType() != STAGE_IXSCAN) {
+        invariant(node->children.size() == 1);
+        node = node->children[0];
+    }
+    return static_cast<IndexScanNode*>(node);
+}
+
+bool isProjection(StageType type) {
+    return type == STAGE_PROJECTION_DEFAULT || type == STAGE_PROJECTION_COVERED ||
+        type == STAGE_PROJECTION_SIMPLE;
+}
+
+}  // namespace
+
+std::unique_ptr<CachedSolutionTemplate> CachedSolutionTemplate::make(const CanonicalQuery& query,
+                                                                     const QuerySolution& soln) {
+    std::vector<const EqualityMatchExpression*> equalities;
+    if (!soln.root() || !isBindableQuery(query, &equalities)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<CachedSolutionTemplate> solutionTemplate(new CachedSolutionTemplate());
+
+    const QuerySolutionNode* accessRoot = soln.root();
+    if (isProjection(accessRoot->getType())) {
+        solutionTemplate->_projectionType = accessRoot->getType();
+        if (accessRoot->getType() == STAGE_PROJECTION_COVERED) {
+            solutionTemplate->_coveredKeyObj =
+                static_cast<const ProjectionNodeCovered*>(accessRoot)->coveredKeyObj;
+        }
+        accessRoot = accessRoot->children[0];
+    }
+
+    // Only allow stages which do not depend on the constants of the query, above an index scan
+    // without a residual filter.
+    const QuerySolutionNode* node = accessRoot;
+    while (node->getType() != STAGE_IXSCAN) {
+        if (node->children.size() != 1) {
+            return nullptr;
+        }
+        if (node->getType() == STAGE_FETCH) {
+            if (node->filter) {
+                return nullptr;
+            }
+        } else if (node->getType() != STAGE_SHARDING_FILTER) {
+            return nullptr;
+        }
+        node = node->children[0];
+    }
+    const auto* ixscan = static_cast<const IndexScanNode*>(node);
+    if (ixscan->filter || ixscan->index.type != INDEX_BTREE || ixscan->index.collator ||
+        ixscan->bounds.isSimpleRange) {
+        return nullptr;
+    }
+
+    // Each equality must have produced the single point interval of one index field.
+    const auto& fields = ixscan->bounds.fields;
+    for (size_t i = 0; i < equalities.size(); ++i) {
+        const BSONElement value = equalities[i]->getData();
+        auto field = std::find_if(fields.begin(), fields.end(), [&](const auto& oil) {
+            return oil.name == equalities[i]->path();
+        });
+        if (field == fields.end() || field->intervals.size() != 1) {
+            return nullptr;
+        }
+        const Interval& interval = field->intervals[0];
+        if (!interval.isPoint() || interval.start.type() != value.type() ||
+            interval.start.woCompare(value, false) != 0) {
+            return nullptr;
+        }
+        solutionTemplate->_parameters.push_back({i, static_cast<size_t>(field - fields.begin())});
+    }
+
+    solutionTemplate->_accessRoot.reset(accessRoot->clone());
+    solutionTemplate->_shouldDedup = ixscan->shouldDedup;
+    solutionTemplate->_plannerOptions = soln.plannerOptions;
+    solutionTemplate->_indexFilterApplied = soln.indexFilterApplied;
+    return solutionTemplate;
+}
+
+std::unique_ptr<QuerySolution> CachedSolutionTemplate::instantiate(
+    const CanonicalQuery& query, const QueryPlannerParams& params) const {
+    if (params.options != _plannerOptions || params.indexFiltersApplied != _indexFilterApplied) {
+        return nullptr;
+    }
+    std::vector<const EqualityMatchExpression*> equalities;
+    if (!isBindableQuery(query, &equalities) || equalities.size() != _parameters.size() ||
+        (_projectionType != STAGE_UNKNOWN && !query.getProj())) {
+        return nullptr;
+    }
+
+    std::unique_ptr<QuerySolutionNode> root(_accessRoot->clone());
+    IndexScanNode* ixscan = getIndexScan(root.get());
+    ixscan->shouldDedup = _shouldDedup;
+    for (auto&& parameter : _parameters) {
+        BSONObjBuilder pointBuilder;
+        pointBuilder.appendAs(equalities[parameter.equalityIndex]->getData(), "");
+        auto& intervals = ixscan->bounds.fields[parameter.boundsField].intervals;
+        intervals.clear();
+        intervals.push_back(IndexBoundsBuilder::makePointInterval(pointBuilder.obj()));
+    }
+
+    switch (_projectionType) {
+        case STAGE_UNKNOWN:
+            break;
+        case STAGE_PROJECTION_DEFAULT:
+            root = std::make_unique<ProjectionNodeDefault>(
+                std::move(root), *query.root(), *query.getProj());
+            break;
+        case STAGE_PROJECTION_SIMPLE:
+            root = std::make_unique<ProjectionNodeSimple>(
+                std::move(root), *query.root(), *query.getProj());
+            break;
+        case STAGE_PROJECTION_COVERED:
+            root = std::make_unique<ProjectionNodeCovered>(
+                std::move(root), *query.root(), *query.getProj(), _coveredKeyObj);
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+    root->computeProperties();
+
+    auto soln = std::make_unique<QuerySolution>(params.options);
+    soln->indexFilterApplied = params.indexFiltersApplied;
+    soln->setRoot(std::move(root));
+    return soln;
+}
+
+}  // namespace mongo
@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * A QuerySolution built from the plan cache for a point lookup, that is a query whose filter is an
+ * equality or a conjunction of equalities answered by a single index scan, with the constants
+ * of the query it was built for left as parameters.
+ *
+ * Every query with the same plan cache key has the same filter shape, and so the same solution
+ * apart from the point intervals its index scan looks up. Instantiating the template for another
+ * query binds its constants into those intervals, which saves replaying the cached index
+ * assignments through the planner and rebuilding the index bounds from the filter.
+ *
+ * Queries and solutions for which binding the constants may not produce the same solution as
+ * QueryPlanner::planFromCache() are not eligible, for example those using a collation, a skip or
+ * a limit, or whose index scan has a residual filter.
+ */
+class CachedSolutionTemplate {
+public:
+    /**
+     * Returns a template for the solutions of the queries of the same shape as 'query', given
+     * 'soln' which was built from the plan cache for 'query', or nullptr if they are not eligible.
+     */
+    static std::unique_ptr<CachedSolutionTemplate> make(const CanonicalQuery& query,
+                                                        const QuerySolution& soln);
+
+    /**
+     * Returns the solution for 'query', which must have the same plan cache key as the query the
+     * template was made from. Returns nullptr if the constants of 'query' cannot be bound to the
+     * template, in which case the solution must be built by the planner.
+     */
+    std::unique_ptr<QuerySolution> instantiate(const CanonicalQuery& query,
+                                               const QueryPlannerParams& params) const;
+
+private:
+    // Binds the value of the 'equalityIndex'th equality of the filter to the 'boundsField'th field
+    // of the index bounds.
+    struct Parameter {
+        size_t equalityIndex;
+        size_t boundsField;
+    };
+
+    CachedSolutionTemplate() = default;
+
+    // The solution below its projection, if any. Contains exactly one index scan.
+    std::unique_ptr<QuerySolutionNode> _accessRoot;
+
+    // The type of the projection at the root of the solution, or STAGE_UNKNOWN if there is none.
+    // The projection itself is rebuilt from the query, since projection nodes point into it.
+    StageType _projectionType = STAGE_UNKNOWN;
+    BSONObj _coveredKeyObj;
+
+    std::vector<Parameter> _parameters;
+
+    // Not copied by IndexScanNode::clone().
+    bool _shouldDedup = false;
+
+    size_t _plannerOptions = 0;
+    bool _indexFilterApplied = false;
+};
+
+/**
+ * Holds the template of a plan cache entry, if one was made. Shared by the entry and the
+ * CachedSolutions returned for it, so that the template made on the first cache hit of an entry
+ * serves all the later ones, and goes away with the entry.
+ */
+class CachedSolutionTemplateHolder {
+public:
+    std::shared_ptr<const CachedSolutionTemplate> get() const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _template;
+    }
+
+    void set(std::shared_ptr<const CachedSolutionTemplate> solutionTemplate) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _template = std::move(solutionTemplate);
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CachedSolutionTemplateHolder::_mutex");
+    std::shared_ptr<const CachedSolutionTemplate> _template;
+};
+
+}  // namespace mongo
@@ -475,6 +475,9 @@ std::string CanonicalQuery::toString() const {
     if (!_qr->getCollation().isEmpty()) {
         ss << "Collation: " << _qr->getCollation().toString() << '\n';
     }
+    if (_pushedDownGroup) {
+        ss << "Group: " << _pushedDownGroup->spec.toString() << '\n';
+    }
     return ss;
 }
 
@@ -45,6 +45,29 @@ namespace mongo {
 
 class OperationContext;
 
+/**
+ * A $group stage which the aggregation layer has handed to the query layer, to be executed by the
+ * slot-based execution engine on top of the plan for the rest of the query. Only a $group whose
+ * results the engine computes exactly like DocumentSourceGroup is pushed down, see PipelineD.
+ */
+struct PushedDownGroup {
+    struct Accumulator {
+        // The name of the output field.
+        std::string fieldName;
+
+        // Either "$min" or "$max".
+        std::string op;
+
+        boost::intrusive_ptr<Expression> argument;
+    };
+
+    // The serialized $group specification. Identifies the pushed down stage in the SBE plan cache.
+    BSONObj spec;
+
+    boost::intrusive_ptr<Expression> idExpression;
+    std::vector<Accumulator> accumulators;
+};
+
 class CanonicalQuery {
 public:
     // A type that encodes the notion of query shape. Essentialy a query's match, projection and
@@ -172,6 +195,18 @@ public:
         _metadataDeps |= additionalDeps;
     }
 
+    /**
+     * Returns the $group which must be applied to the results of this query, if the aggregation
+     * layer pushed one down.
+     */
+    const boost::optional<PushedDownGroup>& getPushedDownGroup() const {
+        return _pushedDownGroup;
+    }
+
+    void setPushedDownGroup(PushedDownGroup group) {
+        _pushedDownGroup = std::move(group);
+    }
+
     /**
      * Compute the "shape" of this query by encoding the match, projection and sort, and stripping
      * out the appropriate values.
@@ -246,6 +281,8 @@ private:
     // Keeps track of what metadata has been explicitly requested.
     QueryMetadataBitSet _metadataDeps;
 
+    boost::optional<PushedDownGroup> _pushedDownGroup;
+
     bool _canHaveNoopMatchNodes = false;
 };
 
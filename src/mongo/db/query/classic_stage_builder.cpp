@@ -34,6 +34,7 @@
 #include "mongo/db/query/classic_stage_builder.h"
 
 #include <memory>
+#include <utility>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
@@ -67,6 +68,19 @@
 #include "mongo/logv2/log.h"
 
 namespace mongo::stage_builder {
+namespace {
+/**
+ * Returns true if 'pattern' sorts by the text score and nothing else.
+ */
+bool isTextScoreSortPattern(const BSONObj& pattern) {
+    if (pattern.nFields() != 1 || pattern.firstElement().type() != BSONType::Object) {
+        return false;
+    }
+    const auto metaElem = pattern.firstElement().embeddedObject()["$meta"];
+    return metaElem.type() == BSONType::String && metaElem.valueStringData() == "textScore"_sd;
+}
+}  // namespace
+
 // Returns a non-null pointer to the root of a plan tree, or a non-OK status if the PlanStage tree
 // could not be constructed.
 std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* root) {
@@ -123,6 +137,10 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         }
         case STAGE_SORT_DEFAULT: {
             auto snDefault = static_cast<const SortNodeDefault*>(root);
+            if (snDefault->limit > 0 && snDefault->children[0]->getType() == STAGE_TEXT &&
+                isTextScoreSortPattern(snDefault->pattern)) {
+                _textScoreLimit = snDefault->limit;
+            }
             auto childStage = build(snDefault->children[0]);
             return std::make_unique<SortStageDefault>(
                 _cq.getExpCtx(),
@@ -288,6 +306,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             // created by planning a query that contains "no-op" expressions.
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = _cq.metadataDeps()[DocumentMetadataFields::kTextScore];
+            params.scoreLimit = std::exchange(_textScoreLimit, 0);
             return std::make_unique<TextStage>(
                 expCtx, _collection, params, _ws, node->filter.get());
         }
@@ -49,5 +49,9 @@ public:
 
 private:
     WorkingSet* _ws;
+
+    // Set while building the TEXT child of a sort on the text score alone with a limit, so that
+    // the text stage can stop after that many best-scoring results.
+    size_t _textScoreLimit = 0;
 };
 }  // namespace mongo::stage_builder
@@ -31,10 +31,10 @@
 
 #include "mongo/db/query/collation/collator_interface_icu.h"
 
+#include <cstring>
 #include <memory>
 
 #include <unicode/coll.h>
-#include <unicode/sortkey.h>
 
 #include "mongo/util/assert_util.h"
 
@@ -51,6 +51,13 @@ std::unique_ptr<CollatorInterface> CollatorInterfaceICU::clone() const {
 }
 
 int CollatorInterfaceICU::compare(StringData left, StringData right) const {
+    // Byte-for-byte identical strings compare equal under every collation, so there is no need to
+    // ask ICU about them. Repeated values are common in sorts and group keys.
+    if (left.size() == right.size() &&
+        (left.empty() || std::memcmp(left.rawData(), right.rawData(), left.size()) == 0)) {
+        return 0;
+    }
+
     UErrorCode status = U_ZERO_ERROR;
     auto compareResult = _collator->compareUTF8(icu::StringPiece(left.rawData(), left.size()),
                                                 icu::StringPiece(right.rawData(), right.size()),
@@ -77,20 +84,26 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     StringData stringData) const {
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
-
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
-
-    // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
-    // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    const auto unicodeString = icu::UnicodeString::fromUTF8(stringPiece);
+
+    // Most sort keys fit into a small stack buffer, which avoids the heap allocations made by an
+    // icu::CollationKey. Any sequence of bytes, even invalid UTF-8, has a defined sort key in ICU
+    // (invalid subsequences are weighted as the replacement character, U+FFFD), so a key length of
+    // zero is only expected when a memory allocation fails inside ICU, which we consider fatal to
+    // the process.
+    uint8_t stackBuffer[256];
+    std::unique_ptr<uint8_t[]> heapBuffer;
+    uint8_t* keyBuffer = stackBuffer;
+    int32_t keyLength = _collator->getSortKey(unicodeString, keyBuffer, sizeof(stackBuffer));
+    fassert(34439, keyLength > 0);
+
+    if (keyLength > static_cast<int32_t>(sizeof(stackBuffer))) {
+        heapBuffer = std::make_unique<uint8_t[]>(keyLength);
+        keyBuffer = heapBuffer.get();
+        const int32_t capacity = keyLength;
+        keyLength = _collator->getSortKey(unicodeString, keyBuffer, capacity);
+        invariant(keyLength == capacity);
+    }
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
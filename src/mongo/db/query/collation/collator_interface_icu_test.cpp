@@ -175,6 +175,28 @@ TEST(CollatorInterfaceICUTest, ASCIIComparisonWorksUsingComparisonKeys) {
     ASSERT_LT(comparisonKeyABB.getKeyData().compare(comparisonKeyBA.getKeyData()), 0);
 }
 
+TEST(CollatorInterfaceICUTest, LongStringComparisonKeysAgreeWithCompare) {
+    CollationSpec collationSpec;
+    collationSpec.localeID = "en_US";
+
+    UErrorCode status = U_ZERO_ERROR;
+    std::unique_ptr<icu::Collator> coll(
+        icu::Collator::createInstance(icu::Locale("en", "US"), status));
+    ASSERT(U_SUCCESS(status));
+
+    // The sort keys of these strings do not fit into the collator's stack buffer.
+    CollatorInterfaceICU icuCollator(collationSpec, std::move(coll));
+    const std::string longA = std::string(1000, 'x') + "a";
+    const std::string longB = std::string(1000, 'x') + "B";
+    ASSERT_LT(icuCollator.compare(longA, longB), 0);
+    ASSERT_EQ(icuCollator.compare(longA, longA), 0);
+
+    const auto comparisonKeyA = icuCollator.getComparisonKey(longA);
+    const auto comparisonKeyB = icuCollator.getComparisonKey(longB);
+    ASSERT_LT(comparisonKeyA.getKeyData().compare(comparisonKeyB.getKeyData()), 0);
+    ASSERT_EQ(comparisonKeyA.getKeyData(), icuCollator.getComparisonKey(longA).getKeyData());
+}
+
 TEST(CollatorInterfaceICUTest, ZeroLengthStringsCompareCorrectly) {
     CollationSpec collationSpec;
     collationSpec.localeID = "en_US";
@@ -39,6 +39,7 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/curop_metrics.h"
 #include "mongo/db/exec/projection_executor.h"
 #include "mongo/db/exec/projection_executor_utils.h"
@@ -49,6 +50,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/sbe_plan_cache.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/clock_source.h"
@@ -80,7 +82,10 @@ CoreIndexInfo indexInfoFromIndexCatalogEntry(const IndexCatalogEntry& ice) {
 }  // namespace
 
 CollectionQueryInfo::CollectionQueryInfo()
-    : _keysComputed(false), _planCache(std::make_shared<PlanCache>()) {}
+    : _keysComputed(false),
+      _planCache(std::make_shared<PlanCache>()),
+      _sbePlanCache(std::make_shared<SbePlanCache>()),
+      _queryShapeStats(std::make_shared<QueryShapeStats>()) {}
 
 const UpdateIndexData& CollectionQueryInfo::getIndexKeys(OperationContext* opCtx) const {
     invariant(_keysComputed);
@@ -201,6 +206,12 @@ void CollectionQueryInfo::clearQueryCache(OperationContext* opCtx, const Collect
         _planCache = std::make_shared<PlanCache>();
         updatePlanCacheIndexEntries(opCtx, coll);
     }
+
+    if (_sbePlanCache.use_count() == 1) {
+        _sbePlanCache->clear();
+    } else {
+        _sbePlanCache = std::make_shared<SbePlanCache>();
+    }
 }
 
 void CollectionQueryInfo::clearQueryCacheForSetMultikey(const CollectionPtr& coll) const {
@@ -209,12 +220,41 @@ void CollectionQueryInfo::clearQueryCacheForSetMultikey(const CollectionPtr& col
                 "Clearing plan cache for multikey - collection info cache cleared",
                 "namespace"_attr = coll->ns());
     _planCache->clear();
+    _sbePlanCache->clear();
 }
 
 PlanCache* CollectionQueryInfo::getPlanCache() const {
     return _planCache.get();
 }
 
+SbePlanCache* CollectionQueryInfo::getSbePlanCache() const {
+    return _sbePlanCache.get();
+}
+
+QueryShapeStats* CollectionQueryInfo::getQueryShapeStats() const {
+    return _queryShapeStats.get();
+}
+
+void CollectionQueryInfo::notifyOfQueryShape(OperationContext* opCtx,
+                                             const CanonicalQuery& cq) const {
+    // The latency of a tailable cursor's getMore is dominated by waiting for new data.
+    if (cq.getQueryRequest().isTailable() || !QueryShapeStats::shouldSample(opCtx)) {
+        return;
+    }
+
+    auto curOp = CurOp::get(opCtx);
+    const auto& opDebug = curOp->debug();
+
+    QueryShapeStatsSample sample;
+    sample.latency = curOp->elapsedTimeExcludingPauses();
+    sample.keysExamined = opDebug.additiveMetrics.keysExamined.value_or(0);
+    sample.docsExamined = opDebug.additiveMetrics.docsExamined.value_or(0);
+    sample.nReturned = std::max(opDebug.nreturned, 0LL);
+    sample.isGetMore = curOp->getLogicalOp() == LogicalOp::opGetMore;
+
+    _queryShapeStats->record(cq, sample, opCtx->getServiceContext()->getFastClockSource()->now());
+}
+
 void CollectionQueryInfo::updatePlanCacheIndexEntries(OperationContext* opCtx,
                                                       const CollectionPtr& coll) {
     std::vector<CoreIndexInfo> indexCores;
@@ -247,6 +287,7 @@ void CollectionQueryInfo::init(OperationContext* opCtx, const CollectionPtr& col
 
 void CollectionQueryInfo::rebuildIndexData(OperationContext* opCtx, const CollectionPtr& coll) {
     _planCache = std::make_shared<PlanCache>();
+    _sbePlanCache = std::make_shared<SbePlanCache>();
 
     _keysComputed = false;
     computeIndexKeys(opCtx, coll);
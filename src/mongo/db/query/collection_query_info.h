@@ -32,12 +32,14 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_shape_stats.h"
 #include "mongo/db/update_index_data.h"
 
 namespace mongo {
 
 class IndexDescriptor;
 class OperationContext;
+class SbePlanCache;
 
 /**
  * Query information for a particular point-in-time view of a collection.
@@ -62,6 +64,16 @@ public:
      */
     PlanCache* getPlanCache() const;
 
+    /**
+     * Get the cache of SBE execution trees for this collection.
+     */
+    SbePlanCache* getSbePlanCache() const;
+
+    /**
+     * Get the execution statistics aggregated by query shape for this collection.
+     */
+    QueryShapeStats* getQueryShapeStats() const;
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
@@ -83,7 +95,7 @@ public:
     /**
      * Removes all cached query plans after ensuring that the PlanCache is uniquely owned. The
      * PlanCache is made uniquely owned by creating a new instance and thus detaching from the
-     * shared instance.
+     * shared instance. The same applies to the SbePlanCache.
      */
     void clearQueryCache(OperationContext* opCtx, const CollectionPtr& coll);
 
@@ -98,6 +110,13 @@ public:
                        const CollectionPtr& coll,
                        const PlanSummaryStats& summaryStats) const;
 
+    /**
+     * Records the execution statistics of the current find or getMore operation, which runs the
+     * query 'cq', in the query shape statistics of this collection. Must be called once the
+     * operation's OpDebug has been filled out. Only a sample of the operations is recorded.
+     */
+    void notifyOfQueryShape(OperationContext* opCtx, const CanonicalQuery& cq) const;
+
 private:
     void computeIndexKeys(OperationContext* opCtx, const CollectionPtr& coll);
     void updatePlanCacheIndexEntries(OperationContext* opCtx, const CollectionPtr& coll);
@@ -108,6 +127,13 @@ private:
 
     // A cache for query plans. Shared across cloned Collection instances.
     std::shared_ptr<PlanCache> _planCache;
+
+    // A cache for SBE execution trees. Cleared and shared together with '_planCache'.
+    std::shared_ptr<SbePlanCache> _sbePlanCache;
+
+    // Execution statistics by query shape. Shared across cloned Collection instances and kept when
+    // the plan caches are cleared.
+    std::shared_ptr<QueryShapeStats> _queryShapeStats;
 };
 
 }  // namespace mongo
@@ -494,8 +494,19 @@ std::unique_ptr<timelib_time, TimeZone::TimelibTimeDeleter> TimeZone::getTimelib
     Date_t date) const {
     auto time = createTimelibTime();
 
-    timelib_unixtime2gmt(time.get(), seconds(date));
-    adjustTimeZone(time.get());
+    // The broken-down local time only depends on the zone attached to 'time', so attach it and let
+    // timelib_unixtime2local() compute all fields with a single lookup in the zone's transitions.
+    // Going through adjustTimeZone() would recompute the fields several times, each time looking
+    // up the zone's UTC offset again.
+    if (isTimeZoneIDZone()) {
+        time->tz_info = _tzInfo.get();
+        time->zone_type = TIMELIB_ZONETYPE_ID;
+    } else if (isUtcOffsetZone()) {
+        timelib_set_timezone_from_offset(time.get(), durationCount<Seconds>(_utcOffset));
+    } else {
+        timelib_unixtime2gmt(time.get(), seconds(date));
+        return time;
+    }
     timelib_unixtime2local(time.get(), seconds(date));
 
     return time;
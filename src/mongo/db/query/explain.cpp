@@ -419,5 +419,6 @@ void Explain::planCacheEntryToBSON(const PlanCacheEntry& entry, BSONObjBuilder*
     out->append("indexFilterSet", entry.plannerData->indexFilterApplied);
 
     out->append("estimatedSizeBytes", static_cast<long long>(entry.estimatedEntrySizeBytes));
+    out->append("numCandidatePlans", static_cast<long long>(entry.numCandidatePlans));
 }
 }  // namespace mongo
@@ -29,14 +29,18 @@
 
 #include "mongo/db/query/expression_index.h"
 
+#include <boost/functional/hash.hpp>
 #include <iostream>
 #include <unordered_set>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/r2_region_coverer.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -107,28 +111,122 @@ void ExpressionMapping::cover2d(const R2Region& region,
     GeoHashsToIntervalsWithParents(unorderedCovering, oilOut);
 }
 
+namespace {
+
+/**
+ * Identifies a covering by the specification of the covered region and the coverer settings in
+ * effect when it was computed, so that changing the geo knobs at runtime never returns a stale
+ * covering.
+ */
+struct S2CoveringCacheKey {
+    BSONObj regionSpec;
+    int minLevel;
+    int maxLevel;
+    int maxCells;
+
+    bool operator==(const S2CoveringCacheKey& other) const {
+        return minLevel == other.minLevel && maxLevel == other.maxLevel &&
+            maxCells == other.maxCells &&
+            SimpleBSONObjComparator::kInstance.evaluate(regionSpec == other.regionSpec);
+    }
+};
+
+struct S2CoveringCacheKeyHasher {
+    size_t operator()(const S2CoveringCacheKey& key) const {
+        size_t seed = SimpleBSONObjComparator::kInstance.hash(key.regionSpec);
+        boost::hash_combine(seed, key.minLevel);
+        boost::hash_combine(seed, key.maxLevel);
+        boost::hash_combine(seed, key.maxCells);
+        return seed;
+    }
+};
+
+/**
+ * Process-wide LRU cache of 2dsphere query coverings. Applications tend to repeat the same
+ * $geoWithin and $geoIntersects regions, and covering a polygon with many edges is far more
+ * expensive than hashing its specification.
+ */
+class S2CoveringCache {
+public:
+    explicit S2CoveringCache(size_t maxSize) : _cache(maxSize) {}
+
+    boost::optional<std::vector<S2CellId>> find(const S2CoveringCacheKey& key) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _cache.promote(key);
+        if (it == _cache.end()) {
+            return boost::none;
+        }
+        return it->second;
+    }
+
+    void add(S2CoveringCacheKey key, std::vector<S2CellId> cover) {
+        key.regionSpec = key.regionSpec.getOwned();
+        stdx::lock_guard<Latch> lk(_mutex);
+        _cache.add(std::move(key), std::move(cover));
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("S2CoveringCache::_mutex");
+    LRUCache<S2CoveringCacheKey, std::vector<S2CellId>, S2CoveringCacheKeyHasher> _cache;
+};
+
+S2CoveringCache* getS2CoveringCache() {
+    if (gInternalQueryS2CoveringCacheSize <= 0) {
+        return nullptr;
+    }
+    static S2CoveringCache cache(gInternalQueryS2CoveringCacheSize);
+    return &cache;
+}
+
+}  // namespace
+
 std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region) {
+    return get2dsphereCovering(region, BSONObj());
+}
+
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region,
+                                                             const BSONObj& regionSpec) {
     auto minLevel = gInternalQueryS2GeoCoarsestLevel.load();
     auto maxLevel = gInternalQueryS2GeoFinestLevel.load();
+    auto maxCells = gInternalQueryS2GeoMaxCells.load();
 
     uassert(28739, "Geo coarsest level must be in range [0,30]", 0 <= minLevel && minLevel <= 30);
     uassert(28740, "Geo finest level must be in range [0,30]", 0 <= maxLevel && maxLevel <= 30);
     uassert(28741, "Geo coarsest level must be less than or equal to finest", minLevel <= maxLevel);
 
+    auto cache = regionSpec.isEmpty() ? nullptr : getS2CoveringCache();
+    S2CoveringCacheKey key{regionSpec, minLevel, maxLevel, maxCells};
+    if (cache) {
+        if (auto cached = cache->find(key)) {
+            return std::move(*cached);
+        }
+    }
+
     S2RegionCoverer coverer;
     coverer.set_min_level(minLevel);
     coverer.set_max_level(maxLevel);
-    coverer.set_max_cells(gInternalQueryS2GeoMaxCells.load());
+    coverer.set_max_cells(maxCells);
 
     std::vector<S2CellId> cover;
     coverer.GetCovering(region, &cover);
+
+    if (cache) {
+        cache->add(std::move(key), cover);
+    }
     return cover;
 }
 
 void ExpressionMapping::cover2dsphere(const S2Region& region,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
-    std::vector<S2CellId> cover = get2dsphereCovering(region);
+    cover2dsphere(region, BSONObj(), indexingParams, oilOut);
+}
+
+void ExpressionMapping::cover2dsphere(const S2Region& region,
+                                      const BSONObj& regionSpec,
+                                      const S2IndexingParams& indexingParams,
+                                      OrderedIntervalList* oilOut) {
+    std::vector<S2CellId> cover = get2dsphereCovering(region, regionSpec);
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
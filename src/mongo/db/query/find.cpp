@@ -140,6 +140,9 @@ void endQueryOp(OperationContext* opCtx,
 
     if (collection) {
         CollectionQueryInfo::get(collection).notifyOfQuery(opCtx, collection, summaryStats);
+        if (auto cq = exec.getCanonicalQuery()) {
+            CollectionQueryInfo::get(collection).notifyOfQueryShape(opCtx, *cq);
+        }
     }
 
     if (curOp->shouldDBProfile(opCtx)) {
@@ -61,6 +61,7 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/index_names.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/query/canonical_query.h"
@@ -69,6 +70,7 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/indexability.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_executor_factory.h"
@@ -84,6 +86,7 @@
 #include "mongo/db/query/query_settings_decoration.h"
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
+#include "mongo/db/query/sbe_plan_cache.h"
 #include "mongo/db/query/sbe_sub_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
 #include "mongo/db/query/util/make_data_structure.h"
@@ -153,6 +156,37 @@ bool isIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery
         !query.getQueryRequest().isTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Returns 'true' if 'query' is an $in over literal _id values which an IDHACK plan can answer by
+ * looking up each value in turn. Unlike a single _id lookup, this can return several documents, so
+ * the query must not sort or limit them and must not be covered by the _id index.
+ */
+bool isIdHackInEligibleQuery(const CollectionPtr& collection, const CanonicalQuery& query) {
+    const auto& qr = query.getQueryRequest();
+    if (qr.showRecordId() || !qr.getHint().isEmpty() || !qr.getMin().isEmpty() ||
+        !qr.getMax().isEmpty() || qr.getSkip() || qr.getLimit() || qr.getNToReturn() ||
+        !qr.getSort().isEmpty() || qr.isTailable() || qr.returnKey() ||
+        query.metadataDeps()[DocumentMetadataFields::kSortKey] ||
+        (query.getProj() && !query.getProj()->requiresDocument()) ||
+        !CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator())) {
+        return false;
+    }
+
+    auto root = query.root();
+    if (root->matchType() != MatchExpression::MATCH_IN || root->path() != "_id") {
+        return false;
+    }
+    auto in = static_cast<const InMatchExpression*>(root);
+    if (!in->getRegexes().empty()) {
+        return false;
+    }
+    const auto& equalities = in->getEqualities();
+    return std::all_of(equalities.begin(), equalities.end(), [](const BSONElement& elt) {
+        return Indexability::isExactBoundsGenerating(elt) &&
+            !(elt.type() == Object && elt.Obj().firstElementFieldName()[0] == '$');
+    });
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -277,8 +311,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
     while (ii->more()) {
         const IndexCatalogEntry* ice = ii->next();
 
-        // Skip the addition of hidden indexes to prevent use in query planning.
-        if (ice->descriptor()->hidden())
+        // Skip the addition of hidden indexes to prevent use in query planning. Columnar indexes
+        // are not read through index scans, so they are never offered to the planner either.
+        if (ice->descriptor()->hidden() ||
+            ice->descriptor()->getIndexType() == IndexType::INDEX_COLUMNAR)
             continue;
         plannerParams->indices.push_back(
             indexEntryFromIndexCatalogEntry(opCtx, *ice, canonicalQuery));
@@ -575,7 +611,9 @@ public:
         const IndexDescriptor* idIndexDesc = _collection->getIndexCatalog()->findIdIndex(_opCtx);
 
         // If we have an _id index we can use an idhack plan.
-        if (idIndexDesc && isIdHackEligibleQuery(_collection, *_cq)) {
+        if (idIndexDesc &&
+            (isIdHackEligibleQuery(_collection, *_cq) ||
+             isIdHackInEligibleQuery(_collection, *_cq))) {
             LOGV2_DEBUG(
                 20922, 2, "Using idhack", "canonicalQuery"_attr = redact(_cq->toStringShort()));
             // If an IDHACK plan is not supported, we will use the normal plan generation process
@@ -603,6 +641,11 @@ public:
             CurOp::get(_opCtx)->debug().planCacheKey =
                 canonical_query_encoder::computeHash(planCacheKey.toString());
 
+            // Try to reuse a complete execution tree which was built for the same query before.
+            if (auto result = buildFromExecutionTreeCache(planCacheKey)) {
+                return std::move(result);
+            }
+
             // Try to look up a cached solution for the query.
             if (auto cs = CollectionQueryInfo::get(_collection)
                               .getPlanCache()
@@ -704,6 +747,14 @@ protected:
     virtual std::unique_ptr<ResultType> buildIdHackPlan(const IndexDescriptor* descriptor,
                                                         QueryPlannerParams* plannerParams) = 0;
 
+    /**
+     * If supported, looks up an execution tree which was previously built for a query with the
+     * same shape and parameters and returns it. Otherwise, or if there is no such tree, nullptr
+     * should be returned and this helper will fall back to the regular plan cache lookup.
+     */
+    virtual std::unique_ptr<ResultType> buildFromExecutionTreeCache(
+        const PlanCacheKey& planCacheKey) = 0;
+
     /**
      * Constructs a PlanStage tree from a cached plan and also:
      *     * Either modifies the constructed tree to run a trial period in order to evaluate the
@@ -827,6 +878,12 @@ protected:
         return result;
     }
 
+    std::unique_ptr<ClassicPrepareExecutionResult> buildFromExecutionTreeCache(
+        const PlanCacheKey& planCacheKey) final {
+        // Classic execution trees are not cached.
+        return nullptr;
+    }
+
     std::unique_ptr<ClassicPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
@@ -896,6 +953,15 @@ class SlotBasedPrepareExecutionHelper final
 public:
     using PrepareExecutionHelper::PrepareExecutionHelper;
 
+    /**
+     * Returns the key under which the execution tree built by prepare() can be stored in the SBE
+     * plan cache, or boost::none if the tree must not be cached, or was itself taken from the
+     * cache.
+     */
+    const boost::optional<SbePlanCacheKey>& sbePlanCacheKey() const {
+        return _sbePlanCacheKey;
+    }
+
 protected:
     std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData> buildExecutableTree(
         const QuerySolution& solution) const final {
@@ -905,6 +971,11 @@ protected:
 
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildIdHackPlan(
         const IndexDescriptor* descriptor, QueryPlannerParams* plannerParams) final {
+        if (!CanonicalQuery::isSimpleIdQuery(_cq->getQueryRequest().getFilter())) {
+            // Multi-key lookups are planned as an index scan.
+            return nullptr;
+        }
+
         uassert(4822862,
                 "IDHack plan is not supported by SBE yet",
                 !(_cq->metadataDeps()[DocumentMetadataFields::kSortKey] ||
@@ -914,6 +985,33 @@ protected:
         return nullptr;
     }
 
+    std::unique_ptr<SlotBasedPrepareExecutionResult> buildFromExecutionTreeCache(
+        const PlanCacheKey& planCacheKey) final {
+        if (!SbePlanCache::shouldCacheQuery(_plannerOptions)) {
+            return nullptr;
+        }
+
+        auto key = SbePlanCacheKey::make(planCacheKey, *_cq, _plannerOptions);
+        auto cachedPlan = CollectionQueryInfo::get(_collection).getSbePlanCache()->get(key);
+        if (!cachedPlan) {
+            _sbePlanCacheKey = std::move(key);
+            return nullptr;
+        }
+
+        LOGV2_DEBUG(5110400,
+                    2,
+                    "Using cached SBE execution tree",
+                    "query"_attr = redact(_cq->toStringShort()));
+
+        // The cached tree was built with the yield policy of another operation.
+        cachedPlan->root->attachNewYieldPolicy(_yieldPolicy);
+
+        auto result = makeResult();
+        result->emplace({std::move(cachedPlan->root), std::move(cachedPlan->planStageData)},
+                        std::move(cachedPlan->solution));
+        return result;
+    }
+
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
@@ -947,6 +1045,8 @@ protected:
         }
         return result;
     }
+private:
+    boost::optional<SbePlanCacheKey> _sbePlanCacheKey;
 };
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getClassicExecutor(
@@ -1087,6 +1187,17 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
     }
     // No need for runtime planning, just use the constructed plan stage tree.
     invariant(roots.size() == 1);
+
+    // The tree did not need any runtime planning, so it can be reused as is by the next execution
+    // of the same query. It must be copied before it gets prepared for execution.
+    if (auto&& key = helper.sbePlanCacheKey(); key && !roots[0].second.hasExchange) {
+        CachedSbePlan plan{
+            std::move(roots[0].first), std::move(roots[0].second), std::move(solutions[0])};
+        CollectionQueryInfo::get(*collection).getSbePlanCache()->set(*key, plan);
+        roots[0] = {std::move(plan.root), std::move(plan.planStageData)};
+        solutions[0] = std::move(plan.solution);
+    }
+
     return plan_executor_factory::make(opCtx,
                                        std::move(cq),
                                        std::move(solutions[0]),
@@ -1978,7 +2089,7 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
         const IndexDescriptor* desc = ice->descriptor();
 
         // Skip the addition of hidden indexes to prevent use in query planning.
-        if (desc->hidden())
+        if (desc->hidden() || desc->getIndexType() == IndexType::INDEX_COLUMNAR)
             continue;
         if (desc->keyPattern().hasField(parsedDistinct.getKey())) {
             if (!mayUnwindArrays &&
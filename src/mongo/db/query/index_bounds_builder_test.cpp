@@ -35,10 +35,14 @@
 #include <memory>
 
 #include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/expression_index.h"
+#include "mongo/db/query/expression_index_knobs_gen.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+#include "third_party/s2/s2cellid.h"
 
 namespace {
 
@@ -1358,4 +1362,47 @@ TEST_F(IndexBoundsBuilderTest, IntersectizeBasic) {
     ASSERT_TRUE(oil2 == expectedIntersection);
 }
 
+//
+// 2dsphere coverings
+//
+
+TEST_F(IndexBoundsBuilderTest, TranslateGeoWithinReusesCachedCoveringForSameRegion) {
+    auto testIndex = buildSimpleIndexEntry(fromjson("{a: '2dsphere'}"));
+    BSONElement keyElt = testIndex.keyPattern.firstElement();
+    BSONObj obj = fromjson(
+        "{a: {$geoWithin: {$geometry: {type: 'Polygon', coordinates: "
+        "[[[0, 0], [0, 1], [1, 1], [1, 0], [0, 0]]]}}}}");
+
+    auto translateGeoWithin = [&]() {
+        auto expr = parseMatchExpression(obj);
+        OrderedIntervalList oil;
+        IndexBoundsBuilder::BoundsTightness tightness;
+        IndexBoundsBuilder::translate(expr.get(), keyElt, testIndex, &oil, &tightness);
+        ASSERT(tightness == IndexBoundsBuilder::INEXACT_FETCH);
+        return oil;
+    };
+
+    // Repeating a query returns the same bounds, whether or not the covering came from the cache.
+    auto firstOil = translateGeoWithin();
+    ASSERT_GT(firstOil.intervals.size(), 0U);
+    ASSERT_TRUE(firstOil == translateGeoWithin());
+
+    // Changing the coverer settings must not return the covering cached under the old settings.
+    const int originalMaxCells = gInternalQueryS2GeoMaxCells.load();
+    ON_BLOCK_EXIT([&] { gInternalQueryS2GeoMaxCells.store(originalMaxCells); });
+    gInternalQueryS2GeoMaxCells.store(1);
+
+    auto expr = parseMatchExpression(obj);
+    const auto& region = static_cast<const GeoMatchExpression*>(expr.get())
+                             ->getGeoExpression()
+                             .getGeometry()
+                             .getS2Region();
+    auto uncachedCover = ExpressionMapping::get2dsphereCovering(region);
+    ASSERT_EQ(uncachedCover.size(), 1U);
+    ASSERT(uncachedCover ==
+           ExpressionMapping::get2dsphereCovering(
+               region, static_cast<const GeoMatchExpression*>(expr.get())
+                           ->getSerializedRightHandSide()));
+}
+
 }  // namespace
@@ -196,6 +196,13 @@ public:
         return _currentSize;
     }
 
+    /**
+     * Returns the number of entries allowed in the kv-store.
+     */
+    size_t maxSize() const {
+        return _maxSize;
+    }
+
     /**
      * TODO: The kv-store should implement its own iterator. Calling through to the underlying
      * iterator exposes the internals, and forces the caller to make a horrible type
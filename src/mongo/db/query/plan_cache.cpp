@@ -36,6 +36,7 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <math.h>
 #include <memory>
 #include <vector>
@@ -45,6 +46,7 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/query/cached_solution_template.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/plan_ranker.h"
@@ -165,7 +167,9 @@ bool PlanCache::shouldCacheQuery(const CanonicalQuery& query) {
 }
 
 CachedSolution::CachedSolution(const PlanCacheEntry& entry)
-    : plannerData(entry.plannerData->clone()), decisionWorks(entry.works) {}
+    : plannerData(entry.plannerData->clone()),
+      decisionWorks(entry.works),
+      solutionTemplate(entry.solutionTemplate) {}
 
 //
 // PlanCacheEntry
@@ -227,6 +231,7 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::create(
                                                               planCacheKey,
                                                               isActive,
                                                               works,
+                                                              solutions.size(),
                                                               std::move(debugInfo)));
 }
 
@@ -236,6 +241,7 @@ PlanCacheEntry::PlanCacheEntry(std::unique_ptr<const SolutionCacheData> plannerD
                                const uint32_t planCacheKey,
                                const bool isActive,
                                const size_t works,
+                               const size_t numCandidatePlans,
                                boost::optional<DebugInfo> debugInfo)
     : plannerData(std::move(plannerData)),
       timeOfCreation(timeOfCreation),
@@ -243,7 +249,9 @@ PlanCacheEntry::PlanCacheEntry(std::unique_ptr<const SolutionCacheData> plannerD
       planCacheKey(planCacheKey),
       isActive(isActive),
       works(works),
+      numCandidatePlans(numCandidatePlans),
       debugInfo(std::move(debugInfo)),
+      solutionTemplate(std::make_shared<CachedSolutionTemplateHolder>()),
       estimatedEntrySizeBytes(_estimateObjectSizeInBytes()) {
     invariant(this->plannerData);
     // Account for the object in the global metric for estimating the server's total plan cache
@@ -267,6 +275,7 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::clone() const {
                                                               planCacheKey,
                                                               isActive,
                                                               works,
+                                                              numCandidatePlans,
                                                               std::move(debugInfoCopy)));
 }
 
@@ -433,7 +442,27 @@ std::string SolutionCacheData::toString() const {
 
 PlanCache::PlanCache() : PlanCache(internalQueryCacheMaxEntriesPerCollection.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+namespace {
+
+// A cache is only split into stripes when each of them can hold at least this many entries, so
+// that small caches keep an exact LRU order.
+const size_t kMinEntriesPerStripe = 64;
+const size_t kMaxStripes = 16;
+
+// The number of least recently used entries of a stripe which are considered for eviction.
+const size_t kNumEvictionCandidates = 4;
+
+}  // namespace
+
+PlanCache::PlanCache(size_t size) {
+    const size_t numStripes =
+        std::max<size_t>(1, std::min(kMaxStripes, size / kMinEntriesPerStripe));
+    const size_t entriesPerStripe = (size + numStripes - 1) / numStripes;
+    _stripes.reserve(numStripes);
+    for (size_t i = 0; i < numStripes; ++i) {
+        _stripes.push_back(std::make_unique<Stripe>(entriesPerStripe));
+    }
+}
 
 PlanCache::~PlanCache() {}
 
@@ -586,7 +615,8 @@ Status PlanCache::set(const CanonicalQuery& query,
                                              }},
                     why->stats);
     const auto key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& stripe = _getStripe(key);
+    stdx::lock_guard<Latch> cacheLock(stripe.mutex);
     bool isNewEntryActive = false;
     uint32_t queryHash;
     uint32_t planCacheKey;
@@ -597,7 +627,7 @@ Status PlanCache::set(const CanonicalQuery& query,
         queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
     } else {
         PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
+        Status cacheStatus = stripe.cache.get(key, &oldEntry);
         invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
@@ -624,19 +654,74 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
-
-    if (nullptr != evictedEntry.get()) {
-        LOGV2_DEBUG(20942,
+    // Make room for the new entry, and keep the plan caches of all collections within their
+    // cumulative memory budget by evicting from this one.
+    if (!stripe.cache.hasKey(key)) {
+        while (stripe.cache.size() > 0 && stripe.cache.size() >= stripe.cache.maxSize()) {
+            _evictOne(&stripe, query);
+        }
+    }
+    const long long maxTotalSizeBytes = internalQueryCacheMaxTotalSizeBytes.load();
+    while (maxTotalSizeBytes > 0 && stripe.cache.size() > 0 &&
+           PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() > maxTotalSizeBytes) {
+        _evictOne(&stripe, query);
+    }
+    if (maxTotalSizeBytes > 0 &&
+        PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() > maxTotalSizeBytes) {
+        LOGV2_DEBUG(5698005,
                     1,
-                    "Plan cache maximum size exceeded - removed least recently used entry",
+                    "Not caching plan since the plan caches are over their memory budget",
                     "namespace"_attr = query.nss(),
-                    "evictedEntry"_attr = redact(evictedEntry->debugString()));
+                    "queryHash"_attr = zeroPaddedHex(queryHash),
+                    "planCacheKey"_attr = zeroPaddedHex(planCacheKey),
+                    "maxTotalSizeBytes"_attr = maxTotalSizeBytes);
+        return Status::OK();
     }
 
+    std::unique_ptr<PlanCacheEntry> evictedEntry = stripe.cache.add(key, newEntry.release());
+    invariant(!evictedEntry || stripe.cache.maxSize() == 0);
+
     return Status::OK();
 }
 
+PlanCache::Stripe& PlanCache::_getStripe(const PlanCacheKey& key) const {
+    if (_stripes.size() == 1) {
+        return *_stripes.front();
+    }
+    return *_stripes[PlanCacheKeyHasher{}(key) % _stripes.size()];
+}
+
+void PlanCache::_evictOne(Stripe* stripe, const CanonicalQuery& query) {
+    invariant(stripe->cache.size() > 0);
+
+    // Only the least recently used quarter of the stripe competes for eviction, so that small
+    // caches behave as plain LRU caches. Among the candidates, the entry which would cost the
+    // fewest works per byte to replan is evicted, and ties go to the least recently used.
+    const size_t numCandidates =
+        std::max<size_t>(1, std::min(kNumEvictionCandidates, stripe->cache.size() / 4));
+    auto victim = std::prev(stripe->cache.end());
+    double victimCost = std::numeric_limits<double>::max();
+    auto it = stripe->cache.end();
+    for (size_t i = 0; i < numCandidates; ++i) {
+        --it;
+        const PlanCacheEntry* entry = it->second;
+        const double cost = static_cast<double>(entry->works + 1) * entry->numCandidatePlans /
+            std::max<uint64_t>(1, entry->estimatedEntrySizeBytes);
+        if (cost < victimCost) {
+            victim = it;
+            victimCost = cost;
+        }
+    }
+
+    LOGV2_DEBUG(20942,
+                1,
+                "Plan cache maximum size exceeded - evicted entry",
+                "namespace"_attr = query.nss(),
+                "evictedEntry"_attr = redact(victim->second->debugString()));
+    const PlanCacheKey victimKey = victim->first;
+    invariantStatusOK(stripe->cache.remove(victimKey));
+}
+
 void PlanCache::deactivate(const CanonicalQuery& query) {
     if (internalQueryCacheDisableInactiveEntries.load()) {
         // This is a noop if inactive entries are disabled.
@@ -644,9 +729,10 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& stripe = _getStripe(key);
+    stdx::lock_guard<Latch> cacheLock(stripe.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = stripe.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return;
@@ -661,9 +747,10 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& stripe = _getStripe(key);
+    stdx::lock_guard<Latch> cacheLock(stripe.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = stripe.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return {CacheEntryState::kNotPresent, nullptr};
@@ -676,13 +763,17 @@ PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    PlanCacheKey key = computeKey(canonicalQuery);
+    auto& stripe = _getStripe(key);
+    stdx::lock_guard<Latch> cacheLock(stripe.mutex);
+    return stripe.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& stripe : _stripes) {
+        stdx::lock_guard<Latch> cacheLock(stripe->mutex);
+        stripe->cache.clear();
+    }
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -696,9 +787,10 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& stripe = _getStripe(key);
+    stdx::lock_guard<Latch> cacheLock(stripe.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = stripe.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -708,20 +800,26 @@ StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQ
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+    for (auto&& stripe : _stripes) {
+        stdx::lock_guard<Latch> cacheLock(stripe->mutex);
+        for (auto&& cacheEntry : stripe->cache) {
+            auto entry = cacheEntry.second;
+            entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+        }
     }
 
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& stripe : _stripes) {
+        stdx::lock_guard<Latch> cacheLock(stripe->mutex);
+        size += stripe->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
@@ -732,13 +830,15 @@ std::vector<BSONObj> PlanCache::getMatchingStats(
     const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
-        if (filterFunc(serializedEntry)) {
-            results.push_back(serializedEntry);
+    for (auto&& stripe : _stripes) {
+        stdx::lock_guard<Latch> cacheLock(stripe->mutex);
+        for (auto&& cacheEntry : stripe->cache) {
+            const auto entry = cacheEntry.second;
+            auto serializedEntry = serializationFunc(*entry);
+            if (filterFunc(serializedEntry)) {
+                results.push_back(serializedEntry);
+            }
         }
     }
 
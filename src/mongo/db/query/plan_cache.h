@@ -31,6 +31,7 @@
 
 #include <boost/optional/optional.hpp>
 #include <set>
+#include <vector>
 
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/query/canonical_query.h"
@@ -44,6 +45,9 @@
 #include "mongo/util/container_size_helper.h"
 
 namespace mongo {
+
+class CachedSolutionTemplateHolder;
+
 /**
  * Represents the "key" used in the PlanCache mapping from query shape -> query plan.
  */
@@ -280,6 +284,9 @@ public:
     // The number of work cycles taken to decide on a winning plan when the plan was first
     // cached.
     const size_t decisionWorks;
+
+    // The template of the solutions built from this entry, shared with the cache entry.
+    const std::shared_ptr<CachedSolutionTemplateHolder> solutionTemplate;
 };
 
 /**
@@ -388,6 +395,11 @@ public:
     // cause this value to be increased.
     size_t works = 0;
 
+    // The number of plans the multi-planner chose between when this entry was created. Replanning
+    // the query runs a trial of each of them, so together with 'works' it estimates the cost of
+    // losing this entry.
+    const size_t numCandidatePlans;
+
     // Optional debug info containing detailed statistics. Includes a description of the query which
     // resulted in this plan cache's creation as well as runtime stats from the multi-planner trial
     // period that resulted in this cache entry.
@@ -396,6 +408,10 @@ public:
     // debug info is omitted from new plan cache entries.
     const boost::optional<DebugInfo> debugInfo;
 
+    // Set to a template for the solutions built from this entry, once the planner has built one
+    // which is eligible, see CachedSolutionTemplate.
+    const std::shared_ptr<CachedSolutionTemplateHolder> solutionTemplate;
+
     // An estimate of the size in bytes of this plan cache entry. This is the "deep size",
     // calculated by recursively incorporating the size of owned objects, the objects that they in
     // turn own, and so on.
@@ -416,6 +432,7 @@ private:
                    uint32_t planCacheKey,
                    bool isActive,
                    size_t works,
+                   size_t numCandidatePlans,
                    boost::optional<DebugInfo> debugInfo);
 
     // Ensure that PlanCacheEntry is non-copyable.
@@ -600,10 +617,28 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    /**
+     * A slice of the cache with its own lock. Every key maps to one stripe, so that lookups of
+     * different query shapes of a collection do not all serialize on a single mutex.
+     */
+    struct Stripe {
+        explicit Stripe(size_t maxEntries) : cache(maxEntries) {}
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+
+        // Protects 'cache'.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Stripe::mutex");
+    };
+
+    Stripe& _getStripe(const PlanCacheKey& key) const;
+
+    /**
+     * Evicts one entry from 'stripe', which must be locked and not empty. Of the least recently
+     * used entries, evicts the one which is the cheapest to replan for the memory it takes.
+     */
+    void _evictOne(Stripe* stripe, const CanonicalQuery& query);
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    std::vector<std::unique_ptr<Stripe>> _stripes;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
@@ -42,6 +42,7 @@
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/cached_solution_template.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/plan_ranker.h"
@@ -574,6 +575,94 @@ TEST(PlanCacheTest, PlanCacheLRUPolicyRemovesInactiveEntries) {
     ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+TEST(PlanCacheTest, PlanCacheEvictionPrefersEntriesWhichAreCheapToReplan) {
+    // With 8 entries, the 2 least recently used entries are candidates for eviction.
+    const size_t kCacheSize = 8;
+    PlanCache planCache(kCacheSize);
+    auto qs = getQuerySolutionForCaching();
+
+    // The least recently used entry took many works to choose among several plans.
+    unique_ptr<CanonicalQuery> expensive(canonicalize("{a: 1}"));
+    std::vector<QuerySolution*> manySolns = {qs.get(), qs.get(), qs.get()};
+    ASSERT_OK(planCache.set(*expensive, manySolns, createDecision(3U, 1000U), Date_t{}));
+
+    std::string queryString = "{b: 1}";
+    std::vector<unique_ptr<CanonicalQuery>> cheap;
+    for (size_t i = 1; i < kCacheSize; ++i) {
+        cheap.push_back(canonicalize(queryString));
+        addCacheEntryForShape(*cheap.back(), &planCache);
+        queryString[1]++;
+    }
+    ASSERT_EQ(planCache.size(), kCacheSize);
+
+    unique_ptr<CanonicalQuery> cqNew(canonicalize(queryString));
+    addCacheEntryForShape(*cqNew, &planCache);
+    ASSERT_EQ(planCache.size(), kCacheSize);
+
+    // The second least recently used entry is evicted in place of the expensive one.
+    ASSERT_EQ(planCache.get(*expensive).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(planCache.get(*cheap[0]).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(planCache.get(*cqNew).state, PlanCache::CacheEntryState::kPresentInactive);
+}
+
+TEST(PlanCacheTest, PlanCacheStaysWithinTotalSizeBudget) {
+    PlanCache planCache(100);
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    addCacheEntryForShape(*cqA, &planCache);
+    const long long entrySize = planCache.getEntry(*cqA).getValue()->estimatedEntrySizeBytes;
+
+    const long long maxTotalSizeBytes =
+        PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() + 2 * entrySize;
+    internalQueryCacheMaxTotalSizeBytes.store(maxTotalSizeBytes);
+    ON_BLOCK_EXIT([] { internalQueryCacheMaxTotalSizeBytes.store(0); });
+
+    std::string queryString = "{b: 1}";
+    for (size_t i = 0; i < 10; ++i) {
+        unique_ptr<CanonicalQuery> cq(canonicalize(queryString));
+        addCacheEntryForShape(*cq, &planCache);
+        ASSERT_LTE(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), maxTotalSizeBytes);
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+        queryString[1]++;
+    }
+    ASSERT_EQ(planCache.size(), 3U);
+}
+
+TEST(PlanCacheTest, PlanCacheDoesNotCacheOverTotalSizeBudgetWithNothingToEvict) {
+    internalQueryCacheMaxTotalSizeBytes.store(1);
+    ON_BLOCK_EXIT([] { internalQueryCacheMaxTotalSizeBytes.store(0); });
+
+    PlanCache planCache;
+    const long long originalSize = PlanCacheEntry::planCacheTotalSizeEstimateBytes.get();
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    addCacheEntryForShape(*cq, &planCache);
+    ASSERT_EQ(planCache.size(), 0U);
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), originalSize);
+}
+
+TEST(PlanCacheTest, StripedPlanCacheHoldsAllEntries) {
+    // A cache of this size is split into several stripes.
+    PlanCache planCache(5000);
+    const size_t kNumShapes = 200;
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (size_t i = 0; i < kNumShapes; ++i) {
+        queries.push_back(canonicalize(BSON(("a" + std::to_string(i)) << 1)));
+        addCacheEntryForShape(*queries.back(), &planCache);
+    }
+    ASSERT_EQ(planCache.size(), kNumShapes);
+    ASSERT_EQ(planCache.getAllEntries().size(), kNumShapes);
+    for (auto&& cq : queries) {
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+    }
+
+    ASSERT_OK(planCache.remove(*queries[0]));
+    ASSERT_EQ(planCache.size(), kNumShapes - 1);
+
+    planCache.clear();
+    ASSERT_EQ(planCache.size(), 0U);
+    ASSERT_EQ(planCache.get(*queries[1]).state, PlanCache::CacheEntryState::kNotPresent);
+}
+
 TEST(PlanCacheTest, PlanCacheRemoveDeletesInactiveEntries) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -1220,6 +1309,45 @@ protected:
         assertSolutionMatches(planSoln.get(), solnJson);
     }
 
+    /**
+     * Makes a solution template from the solution matching 'solnJson' recovered from the cache for
+     * 'query', which must have been run using one of the runQuery* methods, and instantiates it
+     * for 'newQuery'. Returns nullptr if either step is not possible.
+     */
+    std::unique_ptr<QuerySolution> instantiateSolutionTemplate(const BSONObj& query,
+                                                               const BSONObj& proj,
+                                                               const BSONObj& newQuery,
+                                                               const string& solnJson) {
+        auto planSoln =
+            planQueryFromCache(query, BSONObj(), proj, BSONObj(), *firstMatchingSolution(solnJson));
+        auto solutionTemplate = CachedSolutionTemplate::make(
+            *canonicalize(query, BSONObj(), proj, BSONObj()), *planSoln);
+        if (!solutionTemplate) {
+            return nullptr;
+        }
+        return solutionTemplate->instantiate(*canonicalize(newQuery, BSONObj(), proj, BSONObj()),
+                                             params);
+    }
+
+    /**
+     * Asserts that the solution template made for 'query' instantiates to the same solution for
+     * 'newQuery' as the one recovered from the cache for 'newQuery', and that it matches
+     * 'newSolnJson'.
+     */
+    void assertSolutionTemplateRecoversSolution(const BSONObj& query,
+                                                const BSONObj& proj,
+                                                const BSONObj& newQuery,
+                                                const string& solnJson,
+                                                const string& newSolnJson) {
+        auto instantiated = instantiateSolutionTemplate(query, proj, newQuery, solnJson);
+        ASSERT(instantiated);
+        assertSolutionMatches(instantiated.get(), newSolnJson);
+
+        auto planSoln = planQueryFromCache(
+            newQuery, BSONObj(), proj, BSONObj(), *firstMatchingSolution(solnJson));
+        ASSERT_EQ(planSoln->toString(), instantiated->toString());
+    }
+
     /**
      * Check that the solution will not be cached. The planner will store
      * cache data inside non-cachable solutions, but will not do so for
@@ -1262,6 +1390,84 @@ TEST_F(CachePlanSelectionTest, EqualityIndexScanWithTrailingFields) {
         BSON("x" << 5), "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1, y: 1}}}}}");
 }
 
+//
+// Solution templates
+//
+
+TEST_F(CachePlanSelectionTest, SolutionTemplateBindsEquality) {
+    addIndex(BSON("x" << 1), "x_1");
+    runQuery(BSON("x" << 5));
+
+    assertSolutionTemplateRecoversSolution(
+        BSON("x" << 5),
+        BSONObj(),
+        BSON("x" << 7.5),
+        "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1}}}}}",
+        "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1}, bounds: {x: [[7.5, 7.5, true, "
+        "true]]}}}}}");
+}
+
+TEST_F(CachePlanSelectionTest, SolutionTemplateBindsConjunctionOfEqualities) {
+    addIndex(BSON("x" << 1 << "y" << 1 << "z" << 1), "x_1_y_1_z_1");
+    runQuery(fromjson("{x: 5, y: 'a'}"));
+
+    assertSolutionTemplateRecoversSolution(
+        fromjson("{x: 5, y: 'a'}"),
+        BSONObj(),
+        fromjson("{x: 6, y: 'b'}"),
+        "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1, y: 1, z: 1}}}}}",
+        "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1, y: 1, z: 1}, bounds: {x: [[6, 6, "
+        "true, true]], y: [['b', 'b', true, true]], z: [['MinKey', 'MaxKey', true, true]]}}}}}");
+}
+
+TEST_F(CachePlanSelectionTest, SolutionTemplateRebuildsCoveredProjection) {
+    addIndex(BSON("x" << 1 << "y" << 1), "x_1_y_1");
+    runQuerySortProj(fromjson("{x: 5}"), BSONObj(), fromjson("{_id: 0, x: 1, y: 1}"));
+
+    assertSolutionTemplateRecoversSolution(
+        fromjson("{x: 5}"),
+        fromjson("{_id: 0, x: 1, y: 1}"),
+        fromjson("{x: 8}"),
+        "{proj: {spec: {_id: 0, x: 1, y: 1}, node: {ixscan: {pattern: {x: 1, y: 1}}}}}",
+        "{proj: {spec: {_id: 0, x: 1, y: 1}, node: {ixscan: {pattern: {x: 1, y: 1}, bounds: {x: "
+        "[[8, 8, true, true]], y: [['MinKey', 'MaxKey', true, true]]}}}}}");
+}
+
+TEST_F(CachePlanSelectionTest, SolutionTemplateNotMadeForRangePredicate) {
+    addIndex(BSON("x" << 1), "x_1");
+    runQuery(fromjson("{x: {$gt: 5}}"));
+
+    ASSERT_FALSE(instantiateSolutionTemplate(fromjson("{x: {$gt: 5}}"),
+                                             BSONObj(),
+                                             fromjson("{x: {$gt: 7}}"),
+                                             "{fetch: {node: {ixscan: {pattern: {x: 1}}}}}"));
+}
+
+TEST_F(CachePlanSelectionTest, SolutionTemplateNotMadeForResidualFilter) {
+    addIndex(BSON("x" << 1), "x_1");
+    runQuery(fromjson("{x: 5, y: 6}"));
+
+    ASSERT_FALSE(instantiateSolutionTemplate(
+        fromjson("{x: 5, y: 6}"),
+        BSONObj(),
+        fromjson("{x: 7, y: 8}"),
+        "{fetch: {filter: {y: 6}, node: {ixscan: {pattern: {x: 1}}}}}"));
+}
+
+TEST_F(CachePlanSelectionTest, SolutionTemplateNotInstantiatedForNonScalarValue) {
+    addIndex(BSON("x" << 1), "x_1");
+    runQuery(BSON("x" << 5));
+
+    ASSERT_FALSE(instantiateSolutionTemplate(BSON("x" << 5),
+                                             BSONObj(),
+                                             BSON("x" << BSONNULL),
+                                             "{fetch: {node: {ixscan: {pattern: {x: 1}}}}}"));
+    ASSERT_FALSE(instantiateSolutionTemplate(BSON("x" << 5),
+                                             BSONObj(),
+                                             BSON("x" << BSON_ARRAY(1 << 2)),
+                                             "{fetch: {node: {ixscan: {pattern: {x: 1}}}}}"));
+}
+
 //
 // Geo
 //
@@ -260,6 +260,7 @@ PlanEnumerator::PlanEnumerator(const PlanEnumeratorParams& params)
       _indices(params.indices),
       _ixisect(params.intersect),
       _enumerateOrChildrenLockstep(params.enumerateOrChildrenLockstep),
+      _skipScan(params.skipScan),
       _orLimit(params.maxSolutionsPerOr),
       _intersectLimit(params.maxIntersectPerAnd) {}
 
@@ -1018,6 +1019,40 @@ void PlanEnumerator::enumerateOneIndex(
             andAssignment->choices.push_back(std::move(state));
         }
     }
+
+    if (!_skipScan) {
+        return;
+    }
+
+    // For each compound index with predicates only over its non-leading fields, output a skip scan
+    // assignment. The leading fields get [MinKey, MaxKey] bounds, and the index bounds checker
+    // seeks from one distinct prefix to the next rather than examining every key. Whether this
+    // beats a collection scan depends on the number of distinct prefixes, so we leave the decision
+    // to the multi-planner.
+    for (IndexToPredMap::const_iterator it = idxToNotFirst.begin(); it != idxToNotFirst.end();
+         ++it) {
+        const IndexEntry& thisIndex = (*_indices)[it->first];
+
+        // Multikey indices are skipped, as the rules for compounding their bounds are anchored on
+        // an assignment to the leading field.
+        if (idxToFirst.find(it->first) != idxToFirst.end() || thisIndex.multikey ||
+            thisIndex.type != IndexType::INDEX_BTREE) {
+            continue;
+        }
+
+        OneIndexAssignment indexAssign;
+        indexAssign.index = it->first;
+        for (auto pred : it->second) {
+            assignPredicate(outsidePreds, pred, getPosition(thisIndex, pred), &indexAssign);
+        }
+
+        // Do not output this assignment if it consists only of outside predicates.
+        if (!indexAssign.preds.empty()) {
+            AndEnumerableState state;
+            state.assignments.push_back(std::move(indexAssign));
+            andAssignment->choices.push_back(std::move(state));
+        }
+    }
 }
 
 void PlanEnumerator::enumerateAndIntersect(const IndexToPredMap& idxToFirst,
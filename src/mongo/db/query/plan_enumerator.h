@@ -44,7 +44,8 @@ namespace mongo {
 struct PlanEnumeratorParams {
     PlanEnumeratorParams()
         : maxSolutionsPerOr(internalQueryEnumerationMaxOrSolutions.load()),
-          maxIntersectPerAnd(internalQueryEnumerationMaxIntersectPerAnd.load()) {}
+          maxIntersectPerAnd(internalQueryEnumerationMaxIntersectPerAnd.load()),
+          skipScan(internalQueryPlannerEnableSkipScan.load()) {}
 
     // Do we provide solutions that use more indices than the minimum required to provide
     // an indexed solution?
@@ -69,6 +70,10 @@ struct PlanEnumeratorParams {
     // all-pairs approach, we could wind up creating a lot of enumeration possibilities for
     // certain inputs.
     size_t maxIntersectPerAnd;
+
+    // Do we output assignments to compound indices whose leading field has no predicate? Such
+    // plans seek past each distinct prefix value to reach the predicates on later fields.
+    bool skipScan;
 };
 
 /**
@@ -589,6 +594,9 @@ private:
     // same assignment on each branch?
     bool _enumerateOrChildrenLockstep;
 
+    // Do we output assignments which leave the leading field of a compound index unconstrained?
+    bool _skipScan;
+
     // How many enumerations are we willing to produce from each OR?
     size_t _orLimit;
 
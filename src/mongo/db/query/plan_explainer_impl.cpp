@@ -198,6 +198,9 @@ void statsToBSON(const PlanStageStats& stats,
         if (stats.common.executionTimeMillis) {
             bob->appendNumber("executionTimeMillisEstimate", *stats.common.executionTimeMillis);
         }
+        if (stats.common.executionCpuNanos) {
+            bob->appendNumber("executionCpuNanos", *stats.common.executionCpuNanos);
+        }
 
         bob->appendNumber("works", stats.common.works);
         bob->appendNumber("advanced", stats.common.advanced);
@@ -457,6 +460,7 @@ void statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("nMatched", spec->nMatched);
             bob->appendNumber("nWouldModify", spec->nModified);
+            bob->appendNumber("nWouldModifyInPlace", spec->nModifiedInPlace);
             bob->appendNumber("nWouldUpsert", spec->nUpserted);
         }
     }
@@ -312,7 +312,9 @@ std::vector<IndexEntry> QueryPlannerIXSelect::findIndexesByHint(
 
 // static
 std::vector<IndexEntry> QueryPlannerIXSelect::findRelevantIndices(
-    const stdx::unordered_set<std::string>& fields, const std::vector<IndexEntry>& allIndices) {
+    const stdx::unordered_set<std::string>& fields,
+    const std::vector<IndexEntry>& allIndices,
+    bool includeSkipScanIndices) {
 
     std::vector<IndexEntry> out;
     for (auto&& entry : allIndices) {
@@ -320,6 +322,17 @@ std::vector<IndexEntry> QueryPlannerIXSelect::findRelevantIndices(
         BSONElement elt = it.next();
         if (fields.end() != fields.find(elt.fieldName())) {
             out.push_back(entry);
+            continue;
+        }
+
+        if (!includeSkipScanIndices || entry.multikey || entry.type != IndexType::INDEX_BTREE) {
+            continue;
+        }
+        while (it.more()) {
+            if (fields.end() != fields.find(it.next().fieldName())) {
+                out.push_back(entry);
+                break;
+            }
         }
     }
 
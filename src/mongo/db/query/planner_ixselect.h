@@ -70,9 +70,14 @@ public:
     /**
      * Finds all indices prefixed by fields we have predicates over.  Only these indices are
      * useful in answering the query.
+     *
+     * If 'includeSkipScanIndices' is true, also includes non-multikey btree indices with a
+     * predicate over any of their fields, since these can be answered with a skip scan.
      */
     static std::vector<IndexEntry> findRelevantIndices(
-        const stdx::unordered_set<std::string>& fields, const std::vector<IndexEntry>& allIndices);
+        const stdx::unordered_set<std::string>& fields,
+        const std::vector<IndexEntry>& allIndices,
+        bool includeSkipScanIndices = false);
 
     /**
      * Determine how useful all of our relevant 'indices' are to all predicates in the subtree
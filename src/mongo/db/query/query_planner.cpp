@@ -44,6 +44,7 @@
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/query/cached_solution_template.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
@@ -52,6 +53,7 @@
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/logv2/log.h"
@@ -525,6 +527,22 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
     // If we're here then this is neither the whole index scan or collection scan
     // cases, and we proceed by using the PlanCacheIndexTree to tag the query tree.
 
+    // Point lookups only need the constants of this query bound into the solution built for an
+    // earlier query of the same shape.
+    const bool useSolutionTemplate =
+        cachedSoln.solutionTemplate && internalQueryPlanCacheUseSolutionTemplates.load();
+    if (useSolutionTemplate) {
+        if (auto solutionTemplate = cachedSoln.solutionTemplate->get()) {
+            if (auto soln = solutionTemplate->instantiate(query, params)) {
+                LOGV2_DEBUG(5698006,
+                            5,
+                            "Planner: solution instantiated from the cached template",
+                            "solution"_attr = redact(soln->toString()));
+                return {std::move(soln)};
+            }
+        }
+    }
+
     // Create a copy of the expression tree.  We use cachedSoln to annotate this with indices.
     unique_ptr<MatchExpression> clone = query.root()->shallowClone();
 
@@ -584,6 +602,12 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
                 5,
                 "Planner: solution constructed from the cache",
                 "solution"_attr = redact(soln->toString()));
+
+    if (useSolutionTemplate && !cachedSoln.solutionTemplate->get()) {
+        if (auto solutionTemplate = CachedSolutionTemplate::make(query, *soln)) {
+            cachedSoln.solutionTemplate->set(std::move(solutionTemplate));
+        }
+    }
     return {std::move(soln)};
 }
 
@@ -698,7 +722,8 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     std::vector<IndexEntry> relevantIndices;
 
     if (!hintedIndexEntry) {
-        relevantIndices = QueryPlannerIXSelect::findRelevantIndices(fields, fullIndexList);
+        relevantIndices = QueryPlannerIXSelect::findRelevantIndices(
+            fields, fullIndexList, internalQueryPlannerEnableSkipScan.load());
     } else {
         relevantIndices = fullIndexList;
 
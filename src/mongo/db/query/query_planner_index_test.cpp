@@ -1426,5 +1426,56 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanNotConsideredByDefault) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanUsesCompoundIndexWithoutPredicateOnLeadingField) {
+    auto defaultSkipScan = internalQueryPlannerEnableSkipScan.load();
+    ON_BLOCK_EXIT([&] { internalQueryPlannerEnableSkipScan.store(defaultSkipScan); });
+    internalQueryPlannerEnableSkipScan.store(true);
+
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+
+    runQuery(fromjson("{b: 5, c: {$gt: 2}}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1, c: 1}, bounds: "
+        "{a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]], "
+        "c: [[2,Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanIsNotAddedWhenLeadingFieldHasPredicate) {
+    auto defaultSkipScan = internalQueryPlannerEnableSkipScan.load();
+    ON_BLOCK_EXIT([&] { internalQueryPlannerEnableSkipScan.store(defaultSkipScan); });
+    internalQueryPlannerEnableSkipScan.store(true);
+
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{a: 1, b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [[1,1,true,true]], b: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanIsNotConsideredForMultikeyIndex) {
+    auto defaultSkipScan = internalQueryPlannerEnableSkipScan.load();
+    ON_BLOCK_EXIT([&] { internalQueryPlannerEnableSkipScan.store(defaultSkipScan); });
+    internalQueryPlannerEnableSkipScan.store(true);
+
+    addIndex(BSON("a" << 1 << "b" << 1), true);
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,165 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_shape_stats.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/canonical_query_encoder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+size_t QueryShapeStatsEntry::latencyBucket(Microseconds latency) {
+    const auto micros = latency.count();
+    if (micros < 2) {
+        return 0;
+    }
+    const size_t bucket = 63 - countLeadingZeros64(static_cast<unsigned long long>(micros));
+    return std::min(bucket, kNumLatencyBuckets - 1);
+}
+
+void QueryShapeStatsEntry::add(const QueryShapeStatsSample& sample, Date_t now) {
+    lastSeen = now;
+    if (sample.isGetMore) {
+        ++getMores;
+    } else {
+        ++finds;
+    }
+
+    const auto micros = durationCount<Microseconds>(sample.latency);
+    totalLatencyMicros += micros;
+    maxLatencyMicros = std::max(maxLatencyMicros, micros);
+    ++latencyBuckets[latencyBucket(sample.latency)];
+
+    keysExamined += sample.keysExamined;
+    docsExamined += sample.docsExamined;
+    nReturned += sample.nReturned;
+}
+
+void QueryShapeStatsEntry::appendTo(BSONObjBuilder* builder) const {
+    builder->append("queryHash", zeroPaddedHex(queryHash));
+    builder->append("query", representativeQuery);
+    builder->append("firstSeen", firstSeen);
+    builder->append("lastSeen", lastSeen);
+    builder->append("finds", finds);
+    builder->append("getMores", getMores);
+    builder->append("totalLatencyMicros", totalLatencyMicros);
+    builder->append("maxLatencyMicros", maxLatencyMicros);
+
+    // Only the non-empty buckets are reported, each with the lower bound of its latencies.
+    BSONArrayBuilder histogram(builder->subarrayStart("latencyHistogram"));
+    for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+        if (latencyBuckets[i] == 0) {
+            continue;
+        }
+        const long long lowerBound = i == 0 ? 0 : 1LL << i;
+        histogram.append(BSON("micros" << lowerBound << "count" << latencyBuckets[i]));
+    }
+    histogram.doneFast();
+
+    builder->append("keysExamined", keysExamined);
+    builder->append("docsExamined", docsExamined);
+    builder->append("nReturned", nReturned);
+}
+
+QueryShapeStats::QueryShapeStats()
+    : QueryShapeStats(internalQueryShapeStatsMaxEntriesPerCollection.load()) {}
+
+QueryShapeStats::QueryShapeStats(size_t size) : _entries(size) {}
+
+bool QueryShapeStats::shouldSample(OperationContext* opCtx) {
+    const auto sampleRate = internalQueryShapeStatsSampleRate.load();
+    if (sampleRate <= 0) {
+        return false;
+    }
+    if (sampleRate >= 1) {
+        return true;
+    }
+    return opCtx->getClient()->getPrng().nextCanonicalDouble() < sampleRate;
+}
+
+void QueryShapeStats::record(const CanonicalQuery& cq,
+                             const QueryShapeStatsSample& sample,
+                             Date_t now) {
+    auto shape = canonical_query_encoder::encode(cq);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_entries.maxSize() == 0) {
+        return;
+    }
+
+    QueryShapeStatsEntry* entry;
+    if (!_entries.get(shape, &entry).isOK()) {
+        const auto& qr = cq.getQueryRequest();
+        BSONObjBuilder queryBuilder;
+        queryBuilder.append("query", qr.getFilter());
+        queryBuilder.append("sort", qr.getSort());
+        queryBuilder.append("projection", qr.getProj());
+        if (!qr.getCollation().isEmpty()) {
+            queryBuilder.append("collation", qr.getCollation());
+        }
+
+        entry = new QueryShapeStatsEntry();
+        entry->representativeQuery = queryBuilder.obj();
+        entry->queryHash = canonical_query_encoder::computeHash(shape);
+        entry->firstSeen = now;
+        _entries.add(shape, entry);
+    }
+    entry->add(sample, now);
+}
+
+std::vector<BSONObj> QueryShapeStats::getStats() const {
+    std::vector<BSONObj> stats;
+    stdx::lock_guard<Latch> lk(_mutex);
+    stats.reserve(_entries.size());
+    for (auto&& [shape, entry] : _entries) {
+        BSONObjBuilder builder;
+        entry->appendTo(&builder);
+        stats.push_back(builder.obj());
+    }
+    return stats;
+}
+
+void QueryShapeStats::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+}
+
+size_t QueryShapeStats::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/lru_key_value.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * The execution metrics of one query operation, either the initial find or one of its getMores.
+ */
+struct QueryShapeStatsSample {
+    Microseconds latency{0};
+    long long keysExamined = 0;
+    long long docsExamined = 0;
+    long long nReturned = 0;
+    bool isGetMore = false;
+};
+
+/**
+ * Execution statistics aggregated over all of the sampled operations of one query shape.
+ */
+struct QueryShapeStatsEntry {
+    // Bucket 'i' of the latency histogram counts operations which took at least 2^i microseconds
+    // and less than 2^(i + 1), except for the first bucket which starts at zero and the last
+    // bucket which has no upper bound.
+    static constexpr size_t kNumLatencyBuckets = 32;
+
+    static size_t latencyBucket(Microseconds latency);
+
+    void add(const QueryShapeStatsSample& sample, Date_t now);
+
+    void appendTo(BSONObjBuilder* builder) const;
+
+    // The first query recorded for this shape, as {query, sort, projection, collation}.
+    BSONObj representativeQuery;
+    uint32_t queryHash = 0;
+
+    Date_t firstSeen;
+    Date_t lastSeen;
+
+    long long finds = 0;
+    long long getMores = 0;
+    long long totalLatencyMicros = 0;
+    long long maxLatencyMicros = 0;
+    std::array<long long, kNumLatencyBuckets> latencyBuckets{};
+    long long keysExamined = 0;
+    long long docsExamined = 0;
+    long long nReturned = 0;
+};
+
+/**
+ * A per-collection store of execution statistics aggregated by query shape, as computed by
+ * canonical_query_encoder::encode(). Unlike the profiler, which records individual slow
+ * operations, this gives the cumulative cost of each shape, so that the most expensive shapes
+ * can be found without knowing them in advance. The contents are reported by the
+ * $queryShapeStats aggregation stage.
+ *
+ * Only a sample of the operations is recorded, see internalQueryShapeStatsSampleRate. The store
+ * holds a bounded number of shapes and evicts the least recently executed shape when it is full.
+ */
+class QueryShapeStats {
+    QueryShapeStats(const QueryShapeStats&) = delete;
+    QueryShapeStats& operator=(const QueryShapeStats&) = delete;
+
+public:
+    QueryShapeStats();
+
+    explicit QueryShapeStats(size_t size);
+
+    /**
+     * Returns true if the current operation should be recorded, according to the sample rate.
+     */
+    static bool shouldSample(OperationContext* opCtx);
+
+    /**
+     * Adds 'sample' to the statistics of the shape of 'cq'.
+     */
+    void record(const CanonicalQuery& cq, const QueryShapeStatsSample& sample, Date_t now);
+
+    /**
+     * Returns one document per recorded shape, most recently executed first.
+     */
+    std::vector<BSONObj> getStats() const;
+
+    /**
+     * Removes all of the recorded shapes.
+     */
+    void clear();
+
+    /**
+     * Returns the number of recorded shapes. Used for testing.
+     */
+    size_t size() const;
+
+private:
+    LRUKeyValue<CanonicalQuery::QueryShapeString, QueryShapeStatsEntry> _entries;
+
+    // Protects _entries.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryShapeStats::_mutex");
+};
+
+}  // namespace mongo
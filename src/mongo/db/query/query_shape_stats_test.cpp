@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file contains tests for mongo/db/query/query_shape_stats.h
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_shape_stats.h"
+
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+static const NamespaceString nss("test.collection");
+
+std::unique_ptr<CanonicalQuery> canonicalize(StringData filter) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    auto qr = std::make_unique<QueryRequest>(nss);
+    qr->setFilter(fromjson(filter.toString()));
+    auto statusWithCQ = CanonicalQuery::canonicalize(opCtx.get(), std::move(qr));
+    ASSERT_OK(statusWithCQ.getStatus());
+    return std::move(statusWithCQ.getValue());
+}
+
+QueryShapeStatsSample makeSample(Microseconds latency, long long docsExamined, bool isGetMore) {
+    QueryShapeStatsSample sample;
+    sample.latency = latency;
+    sample.keysExamined = docsExamined;
+    sample.docsExamined = docsExamined;
+    sample.nReturned = 1;
+    sample.isGetMore = isGetMore;
+    return sample;
+}
+
+TEST(QueryShapeStatsTest, QueriesWithTheSameShapeShareAnEntry) {
+    QueryShapeStats stats(10);
+    const auto now = Date_t::fromMillisSinceEpoch(1000);
+    stats.record(*canonicalize("{a: 1}"), makeSample(Microseconds(10), 5, false), now);
+    stats.record(*canonicalize("{a: 2}"), makeSample(Microseconds(30), 7, false), now);
+    stats.record(*canonicalize("{a: 3}"), makeSample(Microseconds(20), 1, true), now);
+    ASSERT_EQ(stats.size(), 1U);
+
+    auto entries = stats.getStats();
+    ASSERT_EQ(entries.size(), 1U);
+    const auto& entry = entries[0];
+    ASSERT_BSONOBJ_EQ(entry["query"]["query"].Obj(), fromjson("{a: 1}"));
+    ASSERT_EQ(entry["finds"].numberLong(), 2);
+    ASSERT_EQ(entry["getMores"].numberLong(), 1);
+    ASSERT_EQ(entry["totalLatencyMicros"].numberLong(), 60);
+    ASSERT_EQ(entry["maxLatencyMicros"].numberLong(), 30);
+    ASSERT_EQ(entry["docsExamined"].numberLong(), 13);
+    ASSERT_EQ(entry["nReturned"].numberLong(), 3);
+}
+
+TEST(QueryShapeStatsTest, QueriesWithDifferentShapesHaveSeparateEntries) {
+    QueryShapeStats stats(10);
+    const auto now = Date_t::fromMillisSinceEpoch(1000);
+    stats.record(*canonicalize("{a: 1}"), makeSample(Microseconds(10), 1, false), now);
+    stats.record(*canonicalize("{b: 1}"), makeSample(Microseconds(10), 1, false), now);
+    stats.record(*canonicalize("{a: {$gt: 1}}"), makeSample(Microseconds(10), 1, false), now);
+    ASSERT_EQ(stats.size(), 3U);
+
+    // The most recently executed shape is reported first.
+    auto entries = stats.getStats();
+    ASSERT_BSONOBJ_EQ(entries[0]["query"]["query"].Obj(), fromjson("{a: {$gt: 1}}"));
+    ASSERT_NE(entries[0]["queryHash"].String(), entries[1]["queryHash"].String());
+}
+
+TEST(QueryShapeStatsTest, LeastRecentlyExecutedShapeIsEvicted) {
+    QueryShapeStats stats(2);
+    const auto now = Date_t::fromMillisSinceEpoch(1000);
+    stats.record(*canonicalize("{a: 1}"), makeSample(Microseconds(10), 1, false), now);
+    stats.record(*canonicalize("{b: 1}"), makeSample(Microseconds(10), 1, false), now);
+    stats.record(*canonicalize("{a: 2}"), makeSample(Microseconds(10), 1, false), now);
+    stats.record(*canonicalize("{c: 1}"), makeSample(Microseconds(10), 1, false), now);
+    ASSERT_EQ(stats.size(), 2U);
+
+    auto entries = stats.getStats();
+    ASSERT_BSONOBJ_EQ(entries[0]["query"]["query"].Obj(), fromjson("{c: 1}"));
+    ASSERT_BSONOBJ_EQ(entries[1]["query"]["query"].Obj(), fromjson("{a: 1}"));
+    ASSERT_EQ(entries[1]["finds"].numberLong(), 2);
+}
+
+TEST(QueryShapeStatsTest, ZeroSizeRecordsNothing) {
+    QueryShapeStats stats(0);
+    stats.record(*canonicalize("{a: 1}"),
+                 makeSample(Microseconds(10), 1, false),
+                 Date_t::fromMillisSinceEpoch(1000));
+    ASSERT_EQ(stats.size(), 0U);
+    ASSERT(stats.getStats().empty());
+}
+
+TEST(QueryShapeStatsTest, LatencyBuckets) {
+    ASSERT_EQ(QueryShapeStatsEntry::latencyBucket(Microseconds(0)), 0U);
+    ASSERT_EQ(QueryShapeStatsEntry::latencyBucket(Microseconds(1)), 0U);
+    ASSERT_EQ(QueryShapeStatsEntry::latencyBucket(Microseconds(2)), 1U);
+    ASSERT_EQ(QueryShapeStatsEntry::latencyBucket(Microseconds(3)), 1U);
+    ASSERT_EQ(QueryShapeStatsEntry::latencyBucket(Microseconds(1024)), 10U);
+    ASSERT_EQ(QueryShapeStatsEntry::latencyBucket(Microseconds(1LL << 40)),
+              QueryShapeStatsEntry::kNumLatencyBuckets - 1);
+}
+
+TEST(QueryShapeStatsTest, HistogramReportsNonEmptyBuckets) {
+    QueryShapeStats stats(10);
+    const auto now = Date_t::fromMillisSinceEpoch(1000);
+    auto cq = canonicalize("{a: 1}");
+    stats.record(*cq, makeSample(Microseconds(1), 1, false), now);
+    stats.record(*cq, makeSample(Microseconds(1500), 1, false), now);
+    stats.record(*cq, makeSample(Microseconds(1100), 1, true), now);
+
+    auto entries = stats.getStats();
+    ASSERT_EQ(entries.size(), 1U);
+    ASSERT_BSONOBJ_EQ(
+        entries[0]["latencyHistogram"].wrap(),
+        fromjson("{latencyHistogram: [{micros: 0, count: 1}, {micros: 1024, count: 2}]}"));
+}
+
+}  // namespace
+}  // namespace mongo
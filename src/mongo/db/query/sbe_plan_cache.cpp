@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_plan_cache.h"
+
+#include <boost/functional/hash.hpp>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner_params.h"
+
+namespace mongo {
+
+SbePlanCacheKey::SbePlanCacheKey(PlanCacheKey shapeKey, BSONObj parameters)
+    : _shapeKey(std::move(shapeKey)), _parameters(std::move(parameters)) {
+    _hash = PlanCacheKeyHasher{}(_shapeKey);
+    boost::hash_combine(_hash,
+                        std::hash<std::string_view>{}(
+                            std::string_view(_parameters.objdata(), _parameters.objsize())));
+}
+
+SbePlanCacheKey SbePlanCacheKey::make(PlanCacheKey shapeKey,
+                                      const CanonicalQuery& cq,
+                                      size_t plannerOptions) {
+    const auto& qr = cq.getQueryRequest();
+
+    // The collation is not included here since it is already encoded in the shape key.
+    BSONObjBuilder bob;
+    bob.append("filter", qr.getFilter());
+    bob.append("projection", qr.getProj());
+    bob.append("sort", qr.getSort());
+    bob.append("hint", qr.getHint());
+    bob.append("min", qr.getMin());
+    bob.append("max", qr.getMax());
+    if (auto skip = qr.getSkip()) {
+        bob.append("skip", static_cast<long long>(*skip));
+    }
+    if (auto limit = qr.getLimit()) {
+        bob.append("limit", static_cast<long long>(*limit));
+    }
+    if (auto ntoreturn = qr.getNToReturn()) {
+        bob.append("ntoreturn", static_cast<long long>(*ntoreturn));
+    }
+    bob.appendBool("singleBatch", qr.isSingleBatch());
+    bob.appendBool("returnKey", qr.returnKey());
+    bob.appendBool("showRecordId", qr.showRecordId());
+    bob.append("tailableMode", static_cast<int>(qr.getTailableMode()));
+    bob.appendBool("requestResumeToken", qr.getRequestResumeToken());
+    bob.append("resumeAfter", qr.getResumeAfter());
+    bob.appendBool("allowDiskUse", cq.getExpCtx()->allowDiskUse);
+    bob.append("metadataDeps", cq.metadataDeps().to_string());
+    bob.append("plannerOptions", static_cast<long long>(plannerOptions));
+    if (auto&& group = cq.getPushedDownGroup()) {
+        bob.append("group", group->spec);
+    }
+
+    return {std::move(shapeKey), bob.obj()};
+}
+
+std::unique_ptr<CachedSbePlan> CachedSbePlan::clone() const {
+    stage_builder::PlanStageData data{planStageData.env->makeDeepCopy()};
+    data.outputs = planStageData.outputs;
+    data.shouldTrackLatestOplogTimestamp = planStageData.shouldTrackLatestOplogTimestamp;
+    data.shouldTrackResumeToken = planStageData.shouldTrackResumeToken;
+    data.shouldUseTailableScan = planStageData.shouldUseTailableScan;
+    data.hasExchange = planStageData.hasExchange;
+
+    auto solutionCopy = std::make_unique<QuerySolution>(solution->plannerOptions);
+    solutionCopy->setRoot(std::unique_ptr<QuerySolutionNode>(solution->root()->clone()));
+    solutionCopy->hasBlockingStage = solution->hasBlockingStage;
+    solutionCopy->indexFilterApplied = solution->indexFilterApplied;
+    if (solution->cacheData) {
+        solutionCopy->cacheData = solution->cacheData->clone();
+    }
+    solutionCopy->_enumeratorExplainInfo = solution->_enumeratorExplainInfo;
+
+    return std::make_unique<CachedSbePlan>(root->clone(), std::move(data), std::move(solutionCopy));
+}
+
+SbePlanCache::SbePlanCache()
+    : SbePlanCache(internalQuerySlotBasedExecutionPlanCacheMaxEntriesPerCollection.load()) {}
+
+SbePlanCache::SbePlanCache(size_t size) : _cache(size) {}
+
+bool SbePlanCache::shouldCacheQuery(size_t plannerOptions) {
+    if (internalQuerySlotBasedExecutionPlanCacheMaxEntriesPerCollection.load() == 0) {
+        return false;
+    }
+
+    // A shard filtering stage embeds the routing information which was current when the plan was
+    // built, so the plan cannot be reused once that information may have changed.
+    return !(plannerOptions & QueryPlannerParams::INCLUDE_SHARD_FILTER);
+}
+
+void SbePlanCache::set(const SbePlanCacheKey& key, const CachedSbePlan& plan) {
+    auto entry = plan.clone();
+
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    _cache.add(key, entry.release());
+}
+
+std::unique_ptr<CachedSbePlan> SbePlanCache::get(const SbePlanCacheKey& key) const {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    CachedSbePlan* entry = nullptr;
+    if (!_cache.get(key, &entry).isOK()) {
+        return nullptr;
+    }
+    invariant(entry);
+    return entry->clone();
+}
+
+void SbePlanCache::clear() {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    _cache.clear();
+}
+
+size_t SbePlanCache::size() const {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    return _cache.size();
+}
+
+}  // namespace mongo
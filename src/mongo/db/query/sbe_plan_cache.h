@@ -0,0 +1,173 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/lru_key_value.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * The key of the SBE plan cache.
+ *
+ * Unlike the classic plan cache, which caches an index selection for a query shape, the SBE plan
+ * cache stores complete execution trees. These trees embed the constants of the query they were
+ * built for, such as the values of the predicates and the index bounds derived from them. So in
+ * addition to the classic PlanCacheKey, this key includes every part of the query which influences
+ * the execution tree, along with the planner options.
+ */
+class SbePlanCacheKey {
+public:
+    /**
+     * Builds a key for the query 'cq' whose classic plan cache key is 'shapeKey'.
+     */
+    static SbePlanCacheKey make(PlanCacheKey shapeKey,
+                                const CanonicalQuery& cq,
+                                size_t plannerOptions);
+
+    const PlanCacheKey& getShapeKey() const {
+        return _shapeKey;
+    }
+
+    /**
+     * Returns the parameters of the query which are included in this key, for debugging.
+     */
+    const BSONObj& getParameters() const {
+        return _parameters;
+    }
+
+    size_t hash() const {
+        return _hash;
+    }
+
+    bool operator==(const SbePlanCacheKey& other) const {
+        return _hash == other._hash && _shapeKey == other._shapeKey &&
+            _parameters.binaryEqual(other._parameters);
+    }
+
+    bool operator!=(const SbePlanCacheKey& other) const {
+        return !(*this == other);
+    }
+
+private:
+    SbePlanCacheKey(PlanCacheKey shapeKey, BSONObj parameters);
+
+    PlanCacheKey _shapeKey;
+    BSONObj _parameters;
+    size_t _hash;
+};
+
+class SbePlanCacheKeyHasher {
+public:
+    std::size_t operator()(const SbePlanCacheKey& k) const {
+        return k.hash();
+    }
+};
+
+/**
+ * An SBE execution tree, along with the data needed to execute it and the QuerySolution it was
+ * built from. The tree is stored before it is prepared, so it carries no compiled bytecode and no
+ * per-operation state.
+ */
+struct CachedSbePlan {
+    CachedSbePlan(std::unique_ptr<sbe::PlanStage> root,
+                  stage_builder::PlanStageData data,
+                  std::unique_ptr<QuerySolution> solution)
+        : root(std::move(root)), planStageData(std::move(data)), solution(std::move(solution)) {}
+
+    /**
+     * Makes a copy of this plan which shares no state with it. The execution tree is copied with
+     * sbe::PlanStage::clone() and the runtime environment is deep-copied.
+     */
+    std::unique_ptr<CachedSbePlan> clone() const;
+
+    std::unique_ptr<sbe::PlanStage> root;
+    stage_builder::PlanStageData planStageData;
+    std::unique_ptr<QuerySolution> solution;
+};
+
+/**
+ * A per-collection cache of SBE execution trees. A hit saves the query planning, stage building and
+ * constant folding work for a query which has been executed with exactly the same parameters
+ * before.
+ *
+ * Entries are invalidated together with the classic plan cache of the collection, see
+ * CollectionQueryInfo::clearQueryCache().
+ */
+class SbePlanCache {
+    SbePlanCache(const SbePlanCache&) = delete;
+    SbePlanCache& operator=(const SbePlanCache&) = delete;
+
+public:
+    SbePlanCache();
+
+    explicit SbePlanCache(size_t size);
+
+    /**
+     * Returns true if an execution tree built with the given planner options may be cached. Only
+     * queries which are eligible for the classic plan cache should be considered.
+     */
+    static bool shouldCacheQuery(size_t plannerOptions);
+
+    /**
+     * Stores a copy of 'plan' under 'key', replacing any existing entry for the key.
+     */
+    void set(const SbePlanCacheKey& key, const CachedSbePlan& plan);
+
+    /**
+     * Returns a private copy of the plan cached under 'key', or nullptr if there is no such entry.
+     */
+    std::unique_ptr<CachedSbePlan> get(const SbePlanCacheKey& key) const;
+
+    /**
+     * Removes all of the cached plans.
+     */
+    void clear();
+
+    /**
+     * Returns the number of entries in the cache. Used for testing.
+     */
+    size_t size() const;
+
+private:
+    LRUKeyValue<SbePlanCacheKey, CachedSbePlan, SbePlanCacheKeyHasher> _cache;
+
+    // Protects _cache.
+    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("SbePlanCache::_cacheMutex");
+};
+
+}  // namespace mongo
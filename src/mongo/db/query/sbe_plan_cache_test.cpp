@@ -0,0 +1,173 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file contains tests for mongo/db/query/sbe_plan_cache.h
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_plan_cache.h"
+
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/stages/limit_skip.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+static const NamespaceString nss("test.collection");
+
+std::unique_ptr<CanonicalQuery> canonicalize(StringData filter) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    auto qr = std::make_unique<QueryRequest>(nss);
+    qr->setFilter(fromjson(filter.toString()));
+    auto statusWithCQ = CanonicalQuery::canonicalize(opCtx.get(), std::move(qr));
+    ASSERT_OK(statusWithCQ.getStatus());
+    return std::move(statusWithCQ.getValue());
+}
+
+SbePlanCacheKey makeKey(const CanonicalQuery& cq, size_t plannerOptions = 0) {
+    PlanCache planCache;
+    return SbePlanCacheKey::make(planCache.computeKey(cq), cq, plannerOptions);
+}
+
+/**
+ * Builds a trivial plan whose runtime environment holds a single owned string.
+ */
+CachedSbePlan makePlan(const std::string& envValue) {
+    auto env = std::make_unique<sbe::RuntimeEnvironment>();
+    sbe::value::SlotIdGenerator slotIdGenerator;
+    auto [tag, val] = sbe::value::makeNewString(envValue);
+    env->registerSlot("value"_sd, tag, val, true, &slotIdGenerator);
+
+    auto solution = std::make_unique<QuerySolution>(0);
+    solution->setRoot(std::make_unique<EofNode>());
+
+    return {sbe::makeS<sbe::LimitSkipStage>(
+                sbe::makeS<sbe::CoScanStage>(kEmptyPlanNodeId), 1, boost::none, kEmptyPlanNodeId),
+            stage_builder::PlanStageData{std::move(env)},
+            std::move(solution)};
+}
+
+std::string getEnvValue(const CachedSbePlan& plan) {
+    auto env = plan.planStageData.env;
+    auto [tag, val] = env->getAccessor(env->getSlot("value"_sd))->getViewOfValue();
+    return std::string{sbe::value::getStringView(tag, val)};
+}
+
+TEST(SbePlanCacheTest, KeyDistinguishesQueryParameters) {
+    auto cqA = canonicalize("{a: 1}");
+    auto cqB = canonicalize("{a: 2}");
+
+    // Both queries have the same shape, but are built into different execution trees.
+    ASSERT_TRUE(makeKey(*cqA).getShapeKey() == makeKey(*cqB).getShapeKey());
+    ASSERT_TRUE(makeKey(*cqA) != makeKey(*cqB));
+    ASSERT_TRUE(makeKey(*cqA) == makeKey(*canonicalize("{a: 1}")));
+    ASSERT_EQ(makeKey(*cqA).hash(), makeKey(*canonicalize("{a: 1}")).hash());
+}
+
+TEST(SbePlanCacheTest, KeyDistinguishesPlannerOptions) {
+    auto cq = canonicalize("{a: 1}");
+    ASSERT_TRUE(makeKey(*cq, 0) != makeKey(*cq, QueryPlannerParams::NO_TABLE_SCAN));
+}
+
+TEST(SbePlanCacheTest, KeyDistinguishesPushedDownGroup) {
+    auto cqWithGroup = [](StringData groupSpec) {
+        auto cq = canonicalize("{a: 1}");
+        PushedDownGroup group;
+        group.spec = fromjson(groupSpec.toString());
+        cq->setPushedDownGroup(std::move(group));
+        return cq;
+    };
+
+    auto cq = canonicalize("{a: 1}");
+    auto cqGroupByB = cqWithGroup("{$group: {_id: '$b'}}");
+    ASSERT_TRUE(makeKey(*cq).getShapeKey() == makeKey(*cqGroupByB).getShapeKey());
+    ASSERT_TRUE(makeKey(*cq) != makeKey(*cqGroupByB));
+    ASSERT_TRUE(makeKey(*cqGroupByB) != makeKey(*cqWithGroup("{$group: {_id: '$c'}}")));
+    ASSERT_TRUE(makeKey(*cqGroupByB) == makeKey(*cqWithGroup("{$group: {_id: '$b'}}")));
+}
+
+TEST(SbePlanCacheTest, GetReturnsPrivateCopy) {
+    SbePlanCache cache(10);
+    auto key = makeKey(*canonicalize("{a: 1}"));
+    ASSERT_FALSE(cache.get(key));
+
+    cache.set(key, makePlan("cached"));
+    ASSERT_EQ(cache.size(), 1U);
+
+    auto first = cache.get(key);
+    auto second = cache.get(key);
+    ASSERT(first);
+    ASSERT(second);
+    ASSERT_NE(first->root.get(), second->root.get());
+    ASSERT_NE(first->planStageData.env, second->planStageData.env);
+    ASSERT_EQ(getEnvValue(*first), "cached");
+
+    // Changing the environment of one copy must not affect other copies.
+    auto [tag, val] = sbe::value::makeNewString("changed");
+    first->planStageData.env->resetSlot(
+        first->planStageData.env->getSlot("value"_sd), tag, val, true);
+    ASSERT_EQ(getEnvValue(*first), "changed");
+    ASSERT_EQ(getEnvValue(*second), "cached");
+    ASSERT_EQ(getEnvValue(*cache.get(key)), "cached");
+}
+
+TEST(SbePlanCacheTest, ClearRemovesAllEntries) {
+    SbePlanCache cache(10);
+    cache.set(makeKey(*canonicalize("{a: 1}")), makePlan("a"));
+    cache.set(makeKey(*canonicalize("{b: 1}")), makePlan("b"));
+    ASSERT_EQ(cache.size(), 2U);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0U);
+    ASSERT_FALSE(cache.get(makeKey(*canonicalize("{a: 1}"))));
+}
+
+TEST(SbePlanCacheTest, LeastRecentlyUsedEntryIsEvicted) {
+    SbePlanCache cache(1);
+    auto keyA = makeKey(*canonicalize("{a: 1}"));
+    auto keyB = makeKey(*canonicalize("{a: 2}"));
+    cache.set(keyA, makePlan("a"));
+    cache.set(keyB, makePlan("b"));
+
+    ASSERT_EQ(cache.size(), 1U);
+    ASSERT_FALSE(cache.get(keyA));
+    ASSERT_EQ(getEnvValue(*cache.get(keyB)), "b");
+}
+
+}  // namespace
+}  // namespace mongo
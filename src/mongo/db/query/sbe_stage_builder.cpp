@@ -52,6 +52,7 @@
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
+#include "mongo/db/query/sbe_stage_builder_expression.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/db/query/sbe_stage_builder_index_scan.h"
@@ -164,19 +165,26 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::build(const QuerySolution
     // 'shouldProduceRecordIdSlot'. If the solution contains a CollectionScanNode with the
     // 'shouldTrackLatestOplogTimestamp' flag set to true, then we will also produce an
     // 'oplogTsSlot'.
+    //
+    // The documents produced by a $group pushed down into the query have no record ids.
+    auto&& group = _cq.getPushedDownGroup();
     PlanStageReqs reqs;
     reqs.set(kResult);
-    reqs.setIf(kRecordId, _shouldProduceRecordIdSlot);
+    reqs.setIf(kRecordId, _shouldProduceRecordIdSlot && !group);
     reqs.setIf(kOplogTs, _data.shouldTrackLatestOplogTimestamp);
 
     // Build the SBE plan stage tree.
     auto [stage, outputs] = build(root, reqs);
+    if (group) {
+        std::tie(stage, outputs) =
+            buildPushedDownGroup(*group, std::move(stage), std::move(outputs), root->nodeId());
+    }
 
     // Assert that we produced a 'resultSlot' and that we prouced a 'recordIdSlot' if the
-    // 'shouldProduceRecordIdSlot' flag was set. Also assert that we produced an 'oplogTsSlot' if
-    // it's needed.
+    // 'shouldProduceRecordIdSlot' flag was set and no $group was pushed down. Also assert that we
+    // produced an 'oplogTsSlot' if it's needed.
     invariant(outputs.has(kResult));
-    invariant(!_shouldProduceRecordIdSlot || outputs.has(kRecordId));
+    invariant(!_shouldProduceRecordIdSlot || group || outputs.has(kRecordId));
     invariant(!_data.shouldTrackLatestOplogTimestamp || outputs.has(kOplogTs));
 
     _data.outputs = std::move(outputs);
@@ -190,6 +198,16 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
 
     auto csn = static_cast<const CollectionScanNode*>(root);
 
+    // A parallel scan returns the documents out of order and only pays off when the whole
+    // collection is scanned, so it is not used when the query asks for the natural order or may
+    // stop early.
+    const auto& qr = _cq.getQueryRequest();
+    const bool useParallelScan = !qr.getSort().hasField(QueryRequest::kNaturalSortField) &&
+        !qr.getHint().hasField(QueryRequest::kNaturalSortField) && !qr.getLimit() &&
+        !qr.getSkip() && !qr.getNToReturn() &&
+        canUseParallelCollScan(
+            _opCtx, _collection, csn, reqs.getIsTailableCollScanResumeBranch());
+
     auto [stage, outputs] = generateCollScan(_opCtx,
                                              _collection,
                                              csn,
@@ -198,7 +216,11 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                              _yieldPolicy,
                                              _data.env,
                                              reqs.getIsTailableCollScanResumeBranch(),
-                                             _lockAcquisitionCallback);
+                                             _lockAcquisitionCallback,
+                                             useParallelScan);
+    if (useParallelScan) {
+        _data.hasExchange = true;
+    }
 
     if (reqs.has(kReturnKey)) {
         // Assign the 'returnKeySlot' to be the empty object.
@@ -1100,6 +1122,90 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             std::move(outputs)};
 }
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots>
+SlotBasedStageBuilder::buildPushedDownGroup(const PushedDownGroup& group,
+                                            std::unique_ptr<sbe::PlanStage> stage,
+                                            PlanStageSlots outputs,
+                                            PlanNodeId planNodeId) {
+    auto resultSlot = outputs.get(kResult);
+
+    // See the comment above the generateExpression() declaration for an explanation of the
+    // 'relevantSlots' list.
+    auto relevantSlots = sbe::makeSV(resultSlot);
+
+    // Evaluates 'expr' against the input document into a new slot.
+    auto projectExpression = [&](Expression* expr) {
+        auto [slot, eexpr, evalStage] = generateExpression(_opCtx,
+                                                           expr,
+                                                           std::move(stage),
+                                                           &_slotIdGenerator,
+                                                           &_frameIdGenerator,
+                                                           resultSlot,
+                                                           _data.env,
+                                                           planNodeId,
+                                                           &relevantSlots);
+        stage = sbe::makeProjectStage(std::move(evalStage), planNodeId, slot, std::move(eexpr));
+        relevantSlots.push_back(slot);
+        return slot;
+    };
+
+    // Like DocumentSourceGroup, group the documents with a missing key together with the null key.
+    auto idSlot = projectExpression(group.idExpression.get());
+    auto keySlot = _slotIdGenerator.generate();
+    stage = sbe::makeProjectStage(std::move(stage),
+                                  planNodeId,
+                                  keySlot,
+                                  makeFillEmptyNull(sbe::makeE<sbe::EVariable>(idSlot)));
+
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs;
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> finalValues;
+    std::vector<std::string> fieldNames{"_id"};
+    auto fieldSlots = sbe::makeSV(keySlot);
+    for (auto&& accumulator : group.accumulators) {
+        invariant(accumulator.op == "$min" || accumulator.op == "$max");
+        auto argSlot = projectExpression(accumulator.argument.get());
+
+        // $min and $max ignore null, undefined and missing values, and produce null for a group
+        // without any other values.
+        auto aggSlot = _slotIdGenerator.generate();
+        aggs.emplace(
+            aggSlot,
+            makeFunction(accumulator.op == "$min" ? "min" : "max",
+                         sbe::makeE<sbe::EIf>(
+                             generateNullOrMissing(sbe::EVariable{argSlot}),
+                             sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Nothing, 0),
+                             sbe::makeE<sbe::EVariable>(argSlot))));
+
+        fieldNames.push_back(accumulator.fieldName);
+        fieldSlots.push_back(_slotIdGenerator.generate());
+        finalValues.emplace(fieldSlots.back(),
+                            makeFillEmptyNull(sbe::makeE<sbe::EVariable>(aggSlot)));
+    }
+
+    stage = sbe::makeS<sbe::HashAggStage>(std::move(stage),
+                                          sbe::makeSV(keySlot),
+                                          std::move(aggs),
+                                          _cq.getExpCtx()->allowDiskUse,
+                                          planNodeId);
+    if (!finalValues.empty()) {
+        stage = sbe::makeS<sbe::ProjectStage>(std::move(stage), std::move(finalValues), planNodeId);
+    }
+
+    outputs.set(kResult, _slotIdGenerator.generate());
+    stage = sbe::makeS<sbe::MakeBsonObjStage>(std::move(stage),
+                                              outputs.get(kResult),
+                                              boost::none,
+                                              boost::none,
+                                              std::vector<std::string>{},
+                                              std::move(fieldNames),
+                                              std::move(fieldSlots),
+                                              true,
+                                              false,
+                                              planNodeId);
+
+    return {std::move(stage), std::move(outputs)};
+}
+
 // Returns a non-null pointer to the root of a plan tree, or a non-OK status if the PlanStage tree
 // could not be constructed.
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::build(
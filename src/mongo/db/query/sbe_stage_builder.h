@@ -234,6 +234,10 @@ struct PlanStageData {
     bool shouldTrackLatestOplogTimestamp{false};
     bool shouldTrackResumeToken{false};
     bool shouldUseTailableScan{false};
+
+    // True if the tree contains an exchange stage. Copies of such a tree made by
+    // sbe::PlanStage::clone() share the exchange with the original, so the tree cannot be cached.
+    bool hasExchange{false};
 };
 
 /**
@@ -323,6 +327,17 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildShardFilter(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    /**
+     * Builds the $group which the aggregation layer pushed down into the query on top of the tree
+     * 'stage' built for the query solution, and replaces the 'resultSlot' in 'outputs' with the
+     * documents it produces.
+     */
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildPushedDownGroup(
+        const PushedDownGroup& group,
+        std::unique_ptr<sbe::PlanStage> stage,
+        PlanStageSlots outputs,
+        PlanNodeId planNodeId);
+
     sbe::value::SlotIdGenerator _slotIdGenerator;
     sbe::value::FrameIdGenerator _frameIdGenerator;
     sbe::value::SpoolIdGenerator _spoolIdGenerator;
@@ -42,9 +42,11 @@
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
 #include "mongo/db/exec/sbe/stages/union.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
@@ -456,8 +458,94 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
 
     return {std::move(stage), std::move(outputs)};
 }
+
+/**
+ * Generates a collection scan sub-tree which splits the collection into RecordId ranges and scans
+ * them on 'degreeOfParallelism' producer threads. The filter, if any, is evaluated by the producers,
+ * and the results are merged through an exchange:
+ *
+ *   exchange [resultSlot, recordIdSlot] degreeOfParallelism round
+ *       filter <predicate>
+ *       pscan resultSlot recordIdSlot @coll
+ *
+ * The producers run on their own OperationContexts, so the scan is not given the yield policy of
+ * the calling operation.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateParallelCollScan(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const CollectionScanNode* csn,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    sbe::value::FrameIdGenerator* frameIdGenerator,
+    sbe::RuntimeEnvironment* env,
+    size_t degreeOfParallelism) {
+    auto resultSlot = slotIdGenerator->generate();
+    auto recordIdSlot = slotIdGenerator->generate();
+
+    NamespaceStringOrUUID nss{collection->ns().db().toString(), collection->uuid()};
+    std::unique_ptr<sbe::PlanStage> stage =
+        sbe::makeS<sbe::ParallelScanStage>(nss,
+                                           resultSlot,
+                                           recordIdSlot,
+                                           std::vector<std::string>{},
+                                           sbe::makeSV(),
+                                           nullptr /* yieldPolicy */,
+                                           csn->nodeId());
+
+    if (csn->filter) {
+        stage = generateFilter(opCtx,
+                               csn->filter.get(),
+                               std::move(stage),
+                               slotIdGenerator,
+                               frameIdGenerator,
+                               resultSlot,
+                               env,
+                               sbe::makeSV(resultSlot, recordIdSlot),
+                               csn->nodeId());
+    }
+
+    stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                              degreeOfParallelism,
+                                              sbe::makeSV(resultSlot, recordIdSlot),
+                                              sbe::ExchangePolicy::roundrobin,
+                                              nullptr,
+                                              nullptr,
+                                              csn->nodeId());
+
+    PlanStageSlots outputs;
+    outputs.set(PlanStageSlots::kResult, resultSlot);
+    outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
+
+    return {std::move(stage), std::move(outputs)};
+}
 }  // namespace
 
+bool canUseParallelCollScan(OperationContext* opCtx,
+                            const CollectionPtr& collection,
+                            const CollectionScanNode* csn,
+                            bool isTailableResumeBranch) {
+    if (internalQuerySlotBasedExecutionCollScanDegreeOfParallelism.load() < 2) {
+        return false;
+    }
+
+    // Tailable, resumed and oplog scans depend on the position of a single cursor.
+    if (isTailableResumeBranch || csn->tailable || csn->resumeAfterRecordId ||
+        csn->requestResumeToken || csn->minTs || csn->maxTs ||
+        csn->shouldTrackLatestOplogTimestamp || csn->shouldWaitForOplogVisibility ||
+        csn->direction != CollectionScanParams::FORWARD || collection->ns().isOplog()) {
+        return false;
+    }
+
+    // The producers read the collection through their own storage snapshots, which can honor
+    // neither a multi-document transaction nor a read concern other than "local".
+    if (opCtx->inMultiDocumentTransaction()) {
+        return false;
+    }
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    return readConcernArgs.getLevel() == repl::ReadConcernLevel::kLocalReadConcern &&
+        !readConcernArgs.getArgsAfterClusterTime() && !readConcernArgs.getArgsAtClusterTime();
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     OperationContext* opCtx,
     const CollectionPtr& collection,
@@ -467,8 +555,19 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     PlanYieldPolicy* yieldPolicy,
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch,
-    sbe::LockAcquisitionCallback lockAcquisitionCallback) {
-    if (csn->minTs || csn->maxTs) {
+    sbe::LockAcquisitionCallback lockAcquisitionCallback,
+    bool useParallelScan) {
+    if (useParallelScan) {
+        invariant(canUseParallelCollScan(opCtx, collection, csn, isTailableResumeBranch));
+        return generateParallelCollScan(
+            opCtx,
+            collection,
+            csn,
+            slotIdGenerator,
+            frameIdGenerator,
+            env,
+            internalQuerySlotBasedExecutionCollScanDegreeOfParallelism.load());
+    } else if (csn->minTs || csn->maxTs) {
         return generateOptimizedOplogScan(opCtx,
                                           collection,
                                           csn,
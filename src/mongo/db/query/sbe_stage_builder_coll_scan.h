@@ -39,6 +39,17 @@ namespace mongo::stage_builder {
 
 class PlanStageSlots;
 
+/**
+ * Returns true if the collection scan 'csn' can be split into RecordId ranges which are scanned in
+ * parallel, as configured by 'internalQuerySlotBasedExecutionCollScanDegreeOfParallelism'. The
+ * results of a parallel scan are not returned in the natural order, which the caller must check
+ * is acceptable.
+ */
+bool canUseParallelCollScan(OperationContext* opCtx,
+                            const CollectionPtr& collection,
+                            const CollectionScanNode* csn,
+                            bool isTailableResumeBranch);
+
 /**
  * Generates an SBE plan stage sub-tree implementing an collection scan.
  *
@@ -49,6 +60,8 @@ class PlanStageSlots;
  *     were requested to track this data.
  *   * A generated PlanStage sub-tree.
  *
+ * If 'useParallelScan' is true, the scan is done in parallel, see canUseParallelCollScan().
+ *
  * In cases of an error, throws.
  */
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
@@ -60,6 +73,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     PlanYieldPolicy* yieldPolicy,
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch,
-    sbe::LockAcquisitionCallback lockAcquisitionCallback);
+    sbe::LockAcquisitionCallback lockAcquisitionCallback,
+    bool useParallelScan = false);
 
 }  // namespace mongo::stage_builder
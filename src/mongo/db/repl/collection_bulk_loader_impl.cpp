@@ -126,6 +126,7 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
     const std::vector<BSONObj>::const_iterator end) {
     auto iter = begin;
     while (iter != end) {
+        std::vector<BSONObj> docs;
         std::vector<RecordId> locs;
         Status status = writeConflictRetry(
             _opCtx.get(), "CollectionBulkLoaderImpl/insertDocumentsUncapped", _nss.ns(), [&] {
@@ -162,13 +163,13 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
         // Inserts index entries into the external sorter. This will not update pre-existing
         // indexes. Wrap this in a WUOW since the index entry insertion may modify the durable
         // record store which can throw a write conflict exception.
-        status = writeConflictRetry(_opCtx.get(), "_addDocumentToIndexBlocks", _nss.ns(), [&] {
+        docs.assign(iter, iter + locs.size());
+        iter += locs.size();
+        status = writeConflictRetry(_opCtx.get(), "_addDocumentsToIndexBlocks", _nss.ns(), [&] {
             WriteUnitOfWork wunit(_opCtx.get());
-            for (size_t index = 0; index < locs.size(); ++index) {
-                status = _addDocumentToIndexBlocks(*iter++, locs.at(index));
-                if (!status.isOK()) {
-                    return status;
-                }
+            auto addStatus = _addDocumentsToIndexBlocks(docs, locs);
+            if (!addStatus.isOK()) {
+                return addStatus;
             }
             wunit.commit();
             return Status::OK();
@@ -374,21 +375,21 @@ Status CollectionBulkLoaderImpl::_runTaskReleaseResourcesOnFailure(const F& task
     }
 }
 
-Status CollectionBulkLoaderImpl::_addDocumentToIndexBlocks(const BSONObj& doc,
-                                                           const RecordId& loc) {
+Status CollectionBulkLoaderImpl::_addDocumentsToIndexBlocks(const std::vector<BSONObj>& docs,
+                                                            const std::vector<RecordId>& locs) {
     if (_idIndexBlock) {
         auto status =
-            _idIndexBlock->insertSingleDocumentForInitialSyncOrRecovery(_opCtx.get(), doc, loc);
+            _idIndexBlock->insertDocumentsForInitialSyncOrRecovery(_opCtx.get(), docs, locs);
         if (!status.isOK()) {
-            return status.withContext("failed to add document to _id index");
+            return status.withContext("failed to add documents to _id index");
         }
     }
 
     if (_secondaryIndexesBlock) {
-        auto status = _secondaryIndexesBlock->insertSingleDocumentForInitialSyncOrRecovery(
-            _opCtx.get(), doc, loc);
+        auto status = _secondaryIndexesBlock->insertDocumentsForInitialSyncOrRecovery(
+            _opCtx.get(), docs, locs);
         if (!status.isOK()) {
-            return status.withContext("failed to add document to secondary indexes");
+            return status.withContext("failed to add documents to secondary indexes");
         }
     }
 
@@ -98,9 +98,11 @@ private:
                                                  const std::vector<BSONObj>::const_iterator end);
 
     /**
-     * Adds document and associated RecordId to index blocks after inserting into RecordStore.
+     * Adds documents and their associated RecordIds to index blocks after inserting into
+     * RecordStore.
      */
-    Status _addDocumentToIndexBlocks(const BSONObj& doc, const RecordId& loc);
+    Status _addDocumentsToIndexBlocks(const std::vector<BSONObj>& docs,
+                                      const std::vector<RecordId>& locs);
 
     ServiceContext::UniqueClient _client;
     ServiceContext::UniqueOperationContext _opCtx;
@@ -445,9 +445,9 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
 void CollectionCloner::insertDocumentsCallback(const executor::TaskExecutor::CallbackArgs& cbd) {
     uassertStatusOK(cbd.status);
 
+    std::vector<BSONObj> docs;
     {
         stdx::lock_guard<Latch> lk(_mutex);
-        std::vector<BSONObj> docs;
         // Increment 'fetchedBatches' even if no documents were inserted to match the number of
         // 'receivedBatches'.
         ++_stats.fetchedBatches;
@@ -462,13 +462,14 @@ void CollectionCloner::insertDocumentsCallback(const executor::TaskExecutor::Cal
         _stats.documentsCopied += docs.size();
         _stats.approxBytesCopied = ((long)_stats.documentsCopied) * _stats.avgObjSize;
         _progressMeter.hit(int(docs.size()));
-        invariant(_collLoader);
-
-        // The insert must be done within the lock, because CollectionBulkLoader is not
-        // thread safe.
-        uassertStatusOK(_collLoader->insertDocuments(docs.cbegin(), docs.cend()));
     }
 
+    // The insert is done outside of _mutex so that the next batch can be received from the sync
+    // source while this one is written. CollectionBulkLoader is not thread safe, but only the
+    // database work task runner, which runs one task at a time, uses it while the query runs.
+    invariant(_collLoader);
+    uassertStatusOK(_collLoader->insertDocuments(docs.cbegin(), docs.cend()));
+
     initialSyncHangDuringCollectionClone.executeIf(
         [&](const BSONObj&) {
             LOGV2(21138,
@@ -256,7 +256,8 @@ private:
     std::vector<BSONObj> _readyIndexSpecs;              // (X) Except for _id_
     std::vector<BSONObj> _unfinishedIndexSpecs;         // (X)
     BSONObj _idIndexSpec;                               // (X)
-    std::unique_ptr<CollectionBulkLoader> _collLoader;  // (X)
+    // (X), except that only _dbWorkTaskRunner uses it while the query stage runs.
+    std::unique_ptr<CollectionBulkLoader> _collLoader;
     //  Function for scheduling database work using the executor.
     ScheduleDbWorkFn _scheduleDbWorkFn;  // (R)
     // Documents read from source to insert.
@@ -69,6 +69,16 @@ ServerStatusMetricField<Counter64> displayOpsApplied("repl.apply.ops", &opsAppli
 Counter64 oplogApplicationBatchSize;
 ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.batchSize",
                                                                     &oplogApplicationBatchSize);
+// Tracks how evenly each batch is spread over the writer threads: the operations dispatched to all
+// writers, and those dispatched to the busiest writer of each batch. When one writer gets most of
+// the operations (e.g. a single hot document), the ratio between them approaches 1.
+Counter64 oplogApplicationWriterOps;
+ServerStatusMetricField<Counter64> displayOplogApplicationWriterOps("repl.apply.writerOps",
+                                                                    &oplogApplicationWriterOps);
+Counter64 oplogApplicationBusiestWriterOps;
+ServerStatusMetricField<Counter64> displayOplogApplicationBusiestWriterOps(
+    "repl.apply.busiestWriterOps", &oplogApplicationBusiestWriterOps);
+
 // Number and time of each ApplyOps worker pool round
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
@@ -482,6 +492,13 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
             _writerPool->getStats().numThreads);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
 
+        std::size_t busiestWriterOps = 0;
+        for (const auto& writer : writerVectors) {
+            oplogApplicationWriterOps.increment(writer.size());
+            busiestWriterOps = std::max(busiestWriterOps, writer.size());
+        }
+        oplogApplicationBusiestWriterOps.increment(busiestWriterOps);
+
         // Wait for writes to finish before applying ops.
         _writerPool->waitForIdle();
 
@@ -558,8 +575,11 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
     // means that all the writes associated with the oplog entries in the batch are finished and no
     // new writes with timestamps associated with those oplog entries will show up in the future. We
     // want to flush the journal as soon as possible in order to free ops waiting with 'j' write
-    // concern.
-    JournalFlusher::get(opCtx)->triggerJournalFlush();
+    // concern. Recovery replays operations that were already acknowledged, so nobody waits on them
+    // and the periodic flush is enough; forcing one per batch only slows replay down.
+    if (getOptions().mode != OplogApplication::Mode::kRecovering) {
+        JournalFlusher::get(opCtx)->triggerJournalFlush();
+    }
 
     // Use this fail point to hold the PBWM lock and prevent the batch from completing.
     if (MONGO_unlikely(pauseBatchApplicationBeforeCompletion.shouldFail())) {
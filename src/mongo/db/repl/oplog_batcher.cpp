@@ -42,30 +42,33 @@ namespace repl {
 MONGO_FAIL_POINT_DEFINE(skipOplogBatcherWaitForData);
 
 OplogBatcher::OplogBatcher(OplogApplier* oplogApplier, OplogBuffer* oplogBuffer)
-    : _oplogApplier(oplogApplier), _oplogBuffer(oplogBuffer), _ops(0) {}
+    : _oplogApplier(oplogApplier), _oplogBuffer(oplogBuffer) {}
 OplogBatcher::~OplogBatcher() {
     invariant(!_thread);
 }
 
 OplogBatch OplogBatcher::getNextBatch(Seconds maxWaitTime) {
     stdx::unique_lock<Latch> lk(_mutex);
-    // _ops can indicate the following cases:
+    // The oldest batch in _batches can indicate the following cases:
     // 1. A new batch is ready to consume.
     // 2. Shutdown.
     // 3. The batch has (or had) exhausted the buffer in draining mode.
-    // 4. Empty batch since the batch has/had exhausted the buffer but not in draining mode,
-    //    so there could be new oplog entries coming.
-    // 5. Empty batch since the batcher is still running.
     //
-    // In case (4) and (5), we wait for up to "maxWaitTime".
-    if (_ops.empty() && !_ops.mustShutdown() && !_ops.termWhenExhausted()) {
+    // If there is no batch, either the batch has/had exhausted the buffer but not in draining
+    // mode, so there could be new oplog entries coming, or the batcher is still running. In that
+    // case we wait for up to "maxWaitTime".
+    if (_batches.empty()) {
         // We intentionally don't care about whether this returns due to signaling or timeout
-        // since we do the same thing either way: return whatever is in _ops.
+        // since we do the same thing either way: return whatever is in _batches.
         (void)_cv.wait_for(lk, maxWaitTime.toSystemDuration());
     }
 
-    OplogBatch ops = std::move(_ops);
-    _ops = OplogBatch(0);
+    if (_batches.empty()) {
+        return OplogBatch(0);
+    }
+
+    OplogBatch ops = std::move(_batches.front());
+    _batches.pop_front();
     _cv.notify_all();
     return ops;
 }
@@ -330,11 +333,17 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
         }
 
         stdx::unique_lock<Latch> lk(_mutex);
-        // Block until the previous batch has been taken.
-        _cv.wait(lk, [&] { return _ops.empty() && !_ops.termWhenExhausted(); });
-        _ops = std::move(ops);
+        // Block until there is room for another batch. A batch which signals that the buffer has
+        // been drained must be taken before we look at the buffer again, so that draining is only
+        // signaled once.
+        _cv.wait(lk, [&] {
+            return _batches.size() < static_cast<size_t>(replBatchPrefetchDepth.load()) &&
+                (_batches.empty() || !_batches.back().termWhenExhausted());
+        });
+        const bool mustShutdown = ops.mustShutdown();
+        _batches.push_back(std::move(ops));
         _cv.notify_all();
-        if (_ops.mustShutdown()) {
+        if (mustShutdown) {
             return;
         }
     }
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/repl/oplog_buffer.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/storage_interface.h"
@@ -147,7 +149,8 @@ public:
     virtual ~OplogBatcher();
 
     /**
-     * Returns the batch of oplog entries and clears _ops so the batcher can store a new batch.
+     * Returns the oldest batch of oplog entries that is ready, making room for the batcher to store
+     * a new batch.
      */
     OplogBatch getNextBatch(Seconds maxWaitTime);
 
@@ -206,9 +209,12 @@ private:
     stdx::condition_variable _cv;
 
     /**
-     * The latest batch of oplog entries ready for the applier.
+     * The batches of oplog entries ready for the applier, oldest first. Preparing up to
+     * 'replBatchPrefetchDepth' batches ahead lets the batcher keep pulling from the OplogBuffer
+     * while the applier is busy, so that the next batch is ready as soon as the current one has
+     * been applied.
      */
-    OplogBatch _ops;
+    std::deque<OplogBatch> _batches;
 
     std::unique_ptr<stdx::thread> _thread;
 };
@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <limits>
+
+#include "mongo/db/operation_context_noop.h"
+#include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_batcher_test_fixture.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const int kNumOps = 50 * 1000;
+
+/**
+ * OplogApplier which only hands out batches; the benchmarks below never apply them.
+ */
+class OplogApplierMock : public OplogApplier {
+public:
+    explicit OplogApplierMock(OplogBuffer* oplogBuffer)
+        : OplogApplier(nullptr,
+                       oplogBuffer,
+                       nullptr,
+                       OplogApplier::Options(OplogApplication::Mode::kSecondary)) {}
+
+    void _run(OplogBuffer* oplogBuffer) final {}
+
+    StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx,
+                                        std::vector<OplogEntry> ops) final {
+        return OpTime();
+    }
+};
+
+enum OplogShape {
+    // Inserts spread over a few collections.
+    CRUD_ONLY,
+    // Inserts, with an unprepared transaction every 10 entries and a prepared transaction, which
+    // must be batched on its own, every 100 entries.
+    WITH_TRANSACTIONS,
+};
+
+std::vector<OplogEntry> generateOplog(OplogShape shape) {
+    const std::vector<NamespaceString> namespaces = {
+        NamespaceString("test.a"),
+        NamespaceString("test.b"),
+        NamespaceString("test.c"),
+        NamespaceString("test.d"),
+    };
+
+    std::vector<OplogEntry> ops;
+    int t = 1;
+    while (static_cast<int>(ops.size()) < kNumOps) {
+        const auto& nss = namespaces[t % namespaces.size()];
+        if (shape == WITH_TRANSACTIONS && t % 100 == 0) {
+            auto innerOp = makeInsertOplogEntry(t * 10, nss);
+            ops.push_back(makeApplyOpsOplogEntry(t++, true, {innerOp}));
+            ops.push_back(makeCommitTransactionOplogEntry(t++, nss.db(), true, 1));
+        } else if (shape == WITH_TRANSACTIONS && t % 10 == 0) {
+            std::vector<OplogEntry> innerOps;
+            for (int i = 0; i < 5; i++) {
+                innerOps.push_back(makeInsertOplogEntry(t * 10 + i, nss));
+            }
+            ops.push_back(makeApplyOpsOplogEntry(t++, false, innerOps));
+        } else {
+            ops.push_back(makeInsertOplogEntry(t++, nss));
+        }
+    }
+    return ops;
+}
+
+/**
+ * Drains an oplog buffer holding the generated oplog with getNextApplierBatch(), using the default
+ * batch limit of 5000 operations. Filling the buffer is not timed.
+ */
+void BM_GetNextApplierBatch(benchmark::State& state, OplogShape shape) {
+    OperationContextNoop opCtx;
+    OplogBufferBlockingQueue buffer(nullptr);
+    OplogApplierMock applier(&buffer);
+
+    OplogApplier::BatchLimits limits;
+    limits.bytes = std::numeric_limits<decltype(limits.bytes)>::max();
+    limits.ops = 5000;
+
+    const auto ops = generateOplog(shape);
+    size_t numBatches = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        applier.enqueue(&opCtx, ops.cbegin(), ops.cend());
+        state.ResumeTiming();
+
+        while (!buffer.isEmpty()) {
+            auto batch = applier.getNextApplierBatch(&opCtx, limits);
+            invariant(batch.isOK());
+            numBatches++;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ops.size());
+    state.counters["opsPerBatch"] = static_cast<double>(state.iterations() * ops.size()) /
+        std::max<size_t>(numBatches, 1);
+}
+
+BENCHMARK_CAPTURE(BM_GetNextApplierBatch, CrudOnly, CRUD_ONLY);
+BENCHMARK_CAPTURE(BM_GetNextApplierBatch, WithTransactions, WITH_TRANSACTIONS);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
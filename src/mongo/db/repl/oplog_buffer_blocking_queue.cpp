@@ -31,14 +31,13 @@
 
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
 
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+
 namespace mongo {
 namespace repl {
 
 namespace {
 
-// Limit buffer to 256MB
-const size_t kOplogBufferSize = 256 * 1024 * 1024;
-
 size_t getDocumentSize(const BSONObj& o) {
     // SERVER-9808 Avoid Fortify complaint about implicit signed->unsigned conversion
     return static_cast<size_t>(o.objsize());
@@ -48,7 +47,8 @@ size_t getDocumentSize(const BSONObj& o) {
 
 OplogBufferBlockingQueue::OplogBufferBlockingQueue() : OplogBufferBlockingQueue(nullptr) {}
 OplogBufferBlockingQueue::OplogBufferBlockingQueue(Counters* counters)
-    : _counters(counters), _queue(kOplogBufferSize, &getDocumentSize) {}
+    : _counters(counters),
+      _queue(static_cast<size_t>(replOplogBufferMaxSizeBytes), &getDocumentSize) {}
 
 void OplogBufferBlockingQueue::startup(OperationContext*) {
     // Update server status metric to reflect the current oplog buffer's max size.
@@ -84,7 +84,7 @@ bool OplogBufferBlockingQueue::isEmpty() const {
 }
 
 std::size_t OplogBufferBlockingQueue::getMaxSize() const {
-    return kOplogBufferSize;
+    return _queue.maxSize();
 }
 
 std::size_t OplogBufferBlockingQueue::getSize() const {
@@ -275,6 +275,17 @@ OpTime MutableOplogEntry::getOpTime() const {
     return OpTime(getTimestamp(), term);
 }
 
+BSONObj MutableOplogEntry::toBSON() const {
+    // Leaves room for the remaining top-level fields (timestamps, session info, namespace, etc.).
+    constexpr int kFixedFieldsSizeBytes = 512;
+
+    const auto& op = getDurableReplOperation();
+    BSONObjBuilder builder(kFixedFieldsSizeBytes + op.getNss().size() + op.getObject().objsize() +
+                           (op.getObject2() ? op.getObject2()->objsize() : 0));
+    serialize(&builder);
+    return builder.obj();
+}
+
 size_t DurableOplogEntry::getDurableReplOperationSize(const DurableReplOperation& op) {
     return sizeof(op) + op.getNss().size() + op.getObject().objsize() +
         (op.getObject2() ? op.getObject2()->objsize() : 0);
@@ -193,6 +193,12 @@ public:
         if (value)
             setFromMigrate(value);
     }
+
+    /**
+     * Serializes the oplog entry into a buffer sized up front for the 'o' and 'o2' documents,
+     * which make up most of an entry and would otherwise be copied through several regrowths.
+     */
+    BSONObj toBSON() const;
 };
 
 /**
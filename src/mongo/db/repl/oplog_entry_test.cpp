@@ -135,6 +135,22 @@ TEST(OplogEntryTest, OpTimeAndWallTimeBaseNonStrictParsing) {
         40414);
 }
 
+TEST(OplogEntryTest, MutableOplogEntryToBSONMatchesSerialize) {
+    const BSONObj doc = BSON("_id" << docId << "payload" << std::string(64 * 1024, 'x'));
+
+    MutableOplogEntry entry;
+    entry.setOpType(OpTypeEnum::kUpdate);
+    entry.setNss(nss);
+    entry.setUuid(UUID::gen());
+    entry.setObject(doc);
+    entry.setObject2(BSON("_id" << docId));
+    entry.setOpTime(entryOpTime);
+    entry.setWallClockTime(Date_t());
+
+    BSONObjBuilder builder;
+    entry.serialize(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(), entry.toBSON());
+}
 
 }  // namespace
 }  // namespace repl
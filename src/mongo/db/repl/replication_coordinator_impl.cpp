@@ -41,6 +41,7 @@
 #include <fmt/format.h>
 #include <functional>
 #include <limits>
+#include <tuple>
 
 #include "mongo/base/status.h"
 #include "mongo/bson/json.h"
@@ -4556,10 +4557,29 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
+    // Waiters are visited in ascending opTime order, and whether a write concern is satisfied is
+    // monotonic in the opTime. So once a waiter is found unsatisfied, every later waiter with an
+    // equivalent write concern is unsatisfied too and need not be checked again. With many
+    // concurrent waiters sharing a few write concerns, this keeps the number of full checks close
+    // to the number of waiters actually woken.
+    using WriteConcernKey = std::tuple<StringData,
+                                       int,
+                                       WriteConcernOptions::SyncMode,
+                                       WriteConcernOptions::CheckCondition>;
+    std::vector<WriteConcernKey> unsatisfied;
     _replicationWaiterList.setValueIf_inlock(
-        [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
+        [this, &unsatisfied](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
-            return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
+            const auto& wc = waiter->writeConcern.get();
+            WriteConcernKey key{wc.wMode, wc.wNumNodes, wc.syncMode, wc.checkCondition};
+            if (std::find(unsatisfied.begin(), unsatisfied.end(), key) != unsatisfied.end()) {
+                return false;
+            }
+            if (_doneWaitingForReplication_inlock(opTime, wc)) {
+                return true;
+            }
+            unsatisfied.push_back(std::move(key));
+            return false;
         },
         opTime);
 }
@@ -1121,6 +1121,58 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, UnsatisfiedWriteConcernDoesNotBlockOtherWriteConcernsAtLaterOpTimes) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 1);
+    OpTimeWithTermOne time2(100, 2);
+    replCoordSetMyLastAppliedOpTime(time2, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time2, Date_t() + Seconds(100));
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+
+    // A w:3 waiter at time1 that stays unsatisfied must not stop the scan from waking the w:2
+    // waiters on either side of it.
+    ReplicationAwaiter awaiterW2Time1(getReplCoord(), getServiceContext());
+    ReplicationAwaiter awaiterW3Time1(getReplCoord(), getServiceContext());
+    ReplicationAwaiter awaiterW2Time2(getReplCoord(), getServiceContext());
+    writeConcern.wNumNodes = 2;
+    awaiterW2Time1.setOpTime(time1);
+    awaiterW2Time1.setWriteConcern(writeConcern);
+    awaiterW2Time2.setOpTime(time2);
+    awaiterW2Time2.setWriteConcern(writeConcern);
+    writeConcern.wNumNodes = 3;
+    awaiterW3Time1.setOpTime(time1);
+    awaiterW3Time1.setWriteConcern(writeConcern);
+    awaiterW2Time1.start();
+    awaiterW3Time1.start();
+    awaiterW2Time2.start();
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(awaiterW2Time1.getResult().status);
+    ASSERT_OK(awaiterW2Time2.getResult().status);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time1));
+    ASSERT_OK(awaiterW3Time1.getResult().status);
+}
+
 TEST_F(ReplCoordTest, NodeReturnsWriteConcernFailedWhenAWriteConcernTimesOutBeforeBeingSatisified) {
     assertStartSuccess(BSON("_id"
                             << "mySet"
@@ -214,6 +214,12 @@ boost::optional<BSONObj> TenantMigrationRecipientService::Instance::reportForCur
     if (_stateDoc.getExpireAt())
         bob.append("expireAt", _stateDoc.getExpireAt()->toString());
 
+    // Report the progress of the data clone, with the same layout as the initial sync status.
+    if (_tenantAllDatabaseCloner) {
+        BSONObjBuilder dbsBuilder(bob.subobjStart("databases"));
+        _tenantAllDatabaseCloner->getStats().append(&dbsBuilder);
+    }
+
     return bob.obj();
 }
 
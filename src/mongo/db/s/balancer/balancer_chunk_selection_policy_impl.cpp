@@ -370,6 +370,13 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
     std::shuffle(collections.begin(), collections.end(), _random);
 
     for (const auto& coll : collections) {
+        // Every migration involves two shards and a shard takes part in at most one migration per
+        // round, so once fewer than two shards are left there is no point in loading the routing
+        // tables of the remaining collections.
+        if (usedShards.size() + 1 >= shardStats.size()) {
+            break;
+        }
+
         if (coll.getDropped()) {
             continue;
         }
@@ -34,6 +34,7 @@
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 
 #include "mongo/base/status.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/client/read_preference.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
@@ -662,16 +663,18 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
     stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
 
-    for (; iter != _cloneLocs.end(); ++iter) {
+    while (!_cloneLocs.empty()) {
         // We must always make progress in this method by at least one document because empty
         // return indicates there is no more initial clone data.
         if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
             break;
         }
 
-        auto nextRecordId = *iter;
+        // Claim the record before releasing the mutex, so that concurrent _migrateClone requests
+        // from a recipient fetching with several streams never return the same document twice.
+        auto nextRecordId = *_cloneLocs.begin();
+        _cloneLocs.erase(_cloneLocs.begin());
 
         lk.unlock();
 
@@ -681,7 +684,9 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
             // that we take into consideration the overhead of BSONArray indices.
             if (arrBuilder->arrSize() &&
                 (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
-
+                // Give the record back so that it is returned by the next batch.
+                lk.lock();
+                _cloneLocs.insert(nextRecordId);
                 break;
             }
 
@@ -691,8 +696,6 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
 
         lk.lock();
     }
-
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -712,6 +715,9 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
     // If this chunk is too large to store records in _cloneLocs and the command args specify to
     // attempt to move it, scan the collection directly.
     if (_jumboChunkCloneState && _forceJumbo) {
+        // The index scan keeps a single cursor position, so concurrent clone requests must take
+        // turns advancing it.
+        stdx::lock_guard<Latch> jumboLk(_jumboChunkCloneMutex);
         try {
             _nextCloneBatchFromIndexScan(opCtx, collection, arrBuilder);
             return Status::OK();
@@ -729,8 +735,8 @@ Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
                                                        BSONObjBuilder* builder) {
     dassert(opCtx->lockState()->isCollectionLockedForMode(_args.getNss(), MODE_IS));
 
-    std::list<BSONObj> deleteList;
-    std::list<BSONObj> updateList;
+    std::deque<BSONObj> deleteList;
+    std::deque<BSONObj> updateList;
 
     {
         // All clone data must have been drained before starting to fetch the incremental changes.
@@ -743,8 +749,8 @@ Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
         // the same doc, then there's no problem since we consume the delete buffer first. If the
         // delete is causally after, we will not be able to see the document when we attempt to
         // fetch it, so it's also ok.
-        deleteList.splice(deleteList.cbegin(), _deleted);
-        updateList.splice(updateList.cbegin(), _reload);
+        deleteList.swap(_deleted);
+        updateList.swap(_reload);
     }
 
     auto totalDocSize = _xferDeletes(builder, &deleteList, 0);
@@ -752,10 +758,16 @@ Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
 
     builder->append("size", totalDocSize);
 
-    // Put back remaining ids we didn't consume
+    // Put back remaining ids we didn't consume, ahead of the ones queued in the meantime
     stdx::unique_lock<Latch> lk(_mutex);
-    _deleted.splice(_deleted.cbegin(), deleteList);
-    _reload.splice(_reload.cbegin(), updateList);
+    deleteList.insert(deleteList.end(),
+                      std::make_move_iterator(_deleted.begin()),
+                      std::make_move_iterator(_deleted.end()));
+    _deleted.swap(deleteList);
+    updateList.insert(updateList.end(),
+                      std::make_move_iterator(_reload.begin()),
+                      std::make_move_iterator(_reload.end()));
+    _reload.swap(updateList);
 
     return Status::OK();
 }
@@ -920,7 +932,7 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
 }
 
 long long MigrationChunkClonerSourceLegacy::_xferDeletes(BSONObjBuilder* builder,
-                                                         std::list<BSONObj>* removeList,
+                                                         std::deque<BSONObj>* removeList,
                                                          long long initialSize) {
     const long long maxSize = 1024 * 1024;
 
@@ -947,7 +959,7 @@ long long MigrationChunkClonerSourceLegacy::_xferDeletes(BSONObjBuilder* builder
 long long MigrationChunkClonerSourceLegacy::_xferUpdates(OperationContext* opCtx,
                                                          Database* db,
                                                          BSONObjBuilder* builder,
-                                                         std::list<BSONObj>* updateList,
+                                                         std::deque<BSONObj>* updateList,
                                                          long long initialSize) {
     const long long maxSize = 1024 * 1024;
 
@@ -959,9 +971,16 @@ long long MigrationChunkClonerSourceLegacy::_xferUpdates(OperationContext* opCtx
     BSONArrayBuilder arr(builder->subarrayStart("reload"));
     long long totalSize = initialSize;
 
+    // A document modified repeatedly is queued once per write, but fetching its current version
+    // once per batch is enough.
+    SimpleBSONObjUnorderedSet idsInBatch;
+
     auto iter = updateList->begin();
     for (; iter != updateList->end() && totalSize < maxSize; ++iter) {
         auto idDoc = *iter;
+        if (!idsInBatch.insert(idDoc).second) {
+            continue;
+        }
 
         BSONObj fullDoc;
         if (Helpers::findById(opCtx, db, nss.ns().c_str(), idDoc, fullDoc)) {
@@ -29,7 +29,7 @@
 
 #pragma once
 
-#include <list>
+#include <deque>
 #include <memory>
 #include <set>
 
@@ -305,7 +305,7 @@ private:
      * Returns the total size of the documents that were appended + initialSize.
      */
     long long _xferDeletes(BSONObjBuilder* builder,
-                           std::list<BSONObj>* removeList,
+                           std::deque<BSONObj>* removeList,
                            long long initialSize);
 
     /**
@@ -316,7 +316,7 @@ private:
     long long _xferUpdates(OperationContext* opCtx,
                            Database* db,
                            BSONObjBuilder* builder,
-                           std::list<BSONObj>* updateList,
+                           std::deque<BSONObj>* updateList,
                            long long initialSize);
 
     /**
@@ -366,11 +366,11 @@ private:
     bool _acceptingNewOperationTrackRequests{true};
 
     // List of _id of documents that were modified that must be re-cloned (xfer mods)
-    std::list<BSONObj> _reload;
+    std::deque<BSONObj> _reload;
 
     // List of _id of documents that were deleted during clone that should be deleted later (xfer
     // mods)
-    std::list<BSONObj> _deleted;
+    std::deque<BSONObj> _deleted;
 
     // Total bytes in _reload + _deleted (xfer mods)
     uint64_t _memoryUsed{0};
@@ -395,6 +395,10 @@ private:
 
     // Set only once its discovered a chunk is jumbo
     boost::optional<JumboChunkCloneState> _jumboChunkCloneState;
+
+    // Serializes concurrent clone requests advancing '_jumboChunkCloneState'
+    Mutex _jumboChunkCloneMutex =
+        MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_jumboChunkCloneMutex");
 };
 
 }  // namespace mongo
@@ -445,12 +445,14 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int numFetchStreams) {
+    invariant(numFetchStreams > 0);
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    MultiProducerSingleConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = numFetchStreams;
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    MultiProducerSingleConsumerQueue<BSONObj> batches(options);
     repl::OpTime lastOpApplied;
 
     stdx::thread inserterThread{[&] {
@@ -468,11 +470,16 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         });
 
         try {
+            // Every fetch stream ends with an empty batch, and no stream pushes anything after it.
+            int numFinishedStreams = 0;
             while (true) {
                 auto nextBatch = batches.pop(inserterOpCtx.get());
                 auto arr = nextBatch["objects"].Obj();
                 if (arr.isEmpty()) {
-                    return;
+                    if (++numFinishedStreams == numFetchStreams) {
+                        return;
+                    }
+                    continue;
                 }
                 insertBatchFn(inserterOpCtx.get(), arr);
             }
@@ -486,17 +493,12 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         }
     }};
 
-
-    {
-        auto inserterThreadJoinGuard = makeGuard([&] {
-            batches.closeProducerEnd();
-            inserterThread.join();
-        });
-
+    // Runs one fetch stream until the donor returns an empty batch.
+    auto fetchUntilDone = [&](OperationContext* fetchOpCtx) {
         while (true) {
-            auto res = fetchBatchFn(opCtx);
+            auto res = fetchBatchFn(fetchOpCtx);
             try {
-                batches.push(res.getOwned(), opCtx);
+                batches.push(res.getOwned(), fetchOpCtx);
                 auto arr = res["objects"].Obj();
                 if (arr.isEmpty()) {
                     break;
@@ -505,10 +507,57 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
                 break;
             }
         }
+    };
+
+    // The donor hands each record to exactly one _migrateClone request, so any additional streams
+    // can fetch concurrently with this thread.
+    std::vector<stdx::thread> fetcherThreads;
+    for (int i = 1; i < numFetchStreams; ++i) {
+        fetcherThreads.emplace_back([&, i] {
+            Client::initThread(std::string(str::stream() << "chunkFetcher-" << i),
+                               opCtx->getServiceContext(),
+                               nullptr);
+            auto client = Client::getCurrent();
+            {
+                stdx::lock_guard lk(*client);
+                client->setSystemOperationKillableByStepdown(lk);
+            }
+
+            auto fetcherOpCtx = client->makeOperationContext();
+            try {
+                fetchUntilDone(fetcherOpCtx.get());
+            } catch (...) {
+                stdx::lock_guard<Client> lk(*opCtx->getClient());
+                opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
+                LOGV2(5405700,
+                      "Batch fetch failed: {error}",
+                      "Batch fetch failed",
+                      "error"_attr = redact(exceptionToStatus()));
+            }
+        });
+    }
+
+    {
+        bool allFetchedByThisThread = false;
+        auto threadsJoinGuard = makeGuard([&] {
+            // On success the other streams must be allowed to drain the donor before the queue is
+            // closed. On failure closing it first makes them stop at their next push.
+            if (!allFetchedByThisThread) {
+                batches.closeProducerEnd();
+            }
+            for (auto& fetcherThread : fetcherThreads) {
+                fetcherThread.join();
+            }
+            batches.closeProducerEnd();
+            inserterThread.join();
+        });
+
+        fetchUntilDone(opCtx);
+        allFetchedByThisThread = true;
     }  // This scope ensures that the guard is destroyed
 
-    // This check is necessary because the consumer thread uses killOp to propagate errors to the
-    // producer thread (this thread)
+    // This check is necessary because the consumer and fetcher threads use killOp to propagate
+    // errors to this thread
     opCtx->checkForInterrupt();
     return lastOpApplied;
 }
@@ -1120,7 +1169,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied = cloneDocumentsFromDonor(
+            opCtx, insertBatchFn, fetchBatchFn, migrateCloneFetchStreams.load());
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
@@ -114,12 +114,14 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Batches are fetched by 'numFetchStreams' concurrent
+     * callers of 'fetchBatchFn', each of which stops once it returns an empty batch.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int numFetchStreams = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
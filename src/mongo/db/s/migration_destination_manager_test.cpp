@@ -105,6 +105,41 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that documents fetched by several concurrent streams are all inserted exactly once.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithMultipleFetchStreams) {
+    const int kNumBatches = 10;
+    Mutex mutex = MONGO_MAKE_LATCH("CloneDocumentsFromDonorWithMultipleFetchStreams::mutex");
+    int numBatchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONArrayBuilder arrayBuilder;
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            if (numBatchesFetched < kNumBatches) {
+                arrayBuilder.append(createDocument(numBatchesFetched++));
+            }
+        }
+
+        BSONObjBuilder fetchBatchResultBuilder;
+        fetchBatchResultBuilder.append("objects", arrayBuilder.arr());
+        return fetchBatchResultBuilder.obj();
+    };
+
+    std::set<int> insertedIds;
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        for (auto&& docToClone : docs) {
+            ASSERT_TRUE(insertedIds.insert(docToClone.Obj()["_id"].numberInt()).second);
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 3 /* numFetchStreams */);
+
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), insertedIds.size());
+    ASSERT_EQ(0, *insertedIds.begin());
+    ASSERT_EQ(kNumBatches - 1, *insertedIds.rbegin());
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
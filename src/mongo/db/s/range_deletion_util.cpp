@@ -57,8 +57,10 @@
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/flow_control.h"
 #include "mongo/db/storage/remove_saver.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
@@ -289,6 +291,38 @@ void ensureRangeDeletionTaskStillExists(OperationContext* opCtx, const UUID& mig
     // holding any locks.
 }
 
+/**
+ * Spaces the batches of a range deletion 'delayBetweenBatches' apart, except while flow control
+ * reports that the majority commit point is lagging. Then the delay doubles after every batch, up to
+ * rangeDeleterMaxLaggedBatchDelayMS, so that the deletion yields replication and storage capacity
+ * to user writes until the secondaries catch up.
+ */
+class RangeDeletionBatchPacer {
+public:
+    RangeDeletionBatchPacer(ServiceContext* service, Milliseconds delayBetweenBatches)
+        : _service(service),
+          _delayBetweenBatches(delayBetweenBatches),
+          _nextDelay(delayBetweenBatches) {}
+
+    Milliseconds nextSleep() {
+        static constexpr Milliseconds kMinLaggedDelay{10};
+
+        const Milliseconds maxLaggedDelay(rangeDeleterMaxLaggedBatchDelayMS.load());
+        const auto flowControl = FlowControl::get(_service);
+        if (!flowControl || !flowControl->isLagged() || maxLaggedDelay <= _delayBetweenBatches) {
+            _nextDelay = _delayBetweenBatches;
+        } else {
+            _nextDelay = std::min(std::max(_nextDelay * 2, kMinLaggedDelay), maxLaggedDelay);
+        }
+        return _nextDelay;
+    }
+
+private:
+    ServiceContext* _service;
+    Milliseconds _delayBetweenBatches;
+    Milliseconds _nextDelay;
+};
+
 /**
  * Delete the range in a sequence of batches until there are no more documents to
  * delete or deletion returns an error.
@@ -356,7 +390,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                 ErrorCodes::isShutdownError(swNumDeleted.getStatus()) ||
                 ErrorCodes::isNotPrimaryError(swNumDeleted.getStatus());
         })
-        .withDelayBetweenIterations(delayBetweenBatches)
+        .withBackoffBetweenIterations(
+            RangeDeletionBatchPacer(getGlobalServiceContext(), delayBetweenBatches))
         .on(executor, CancelationToken::uncancelable())
         .ignoreValue();
 }
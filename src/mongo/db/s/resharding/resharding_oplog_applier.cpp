@@ -284,17 +284,33 @@ ExecutorFuture<void> ReshardingOplogApplier::applyUntilDone() {
         .onError([this](Status status) { return _onError(status); });
 }
 
+ExecutorFuture<ReshardingOplogApplier::OplogBatch> ReshardingOplogApplier::_getNextBatch() {
+    if (_prefetchedBatch) {
+        auto batch = std::move(*_prefetchedBatch);
+        _prefetchedBatch.reset();
+        return batch;
+    }
+
+    return ExecutorFuture(_executor).then([this] {
+        auto batchClient = makeKillableClient(_service, kClientName);
+        AlternativeClientRegion acr(batchClient);
+
+        return _oplogIter->getNextBatch(_executor);
+    });
+}
+
 ExecutorFuture<void> ReshardingOplogApplier::_scheduleNextBatch() {
     return ExecutorFuture(_executor)
-        .then([this] {
-            auto batchClient = makeKillableClient(_service, kClientName);
-            AlternativeClientRegion acr(batchClient);
-
-            return _oplogIter->getNextBatch(_executor);
-        })
+        .then([this] { return _getNextBatch(); })
         .then([this](OplogBatch batch) {
             _currentBatchToApply = std::move(batch);
 
+            if (!_currentBatchToApply.empty()) {
+                // Read the next batch from the oplog buffer on another executor thread while the
+                // writer pool applies this one.
+                _prefetchedBatch.emplace(_getNextBatch());
+            }
+
             auto applyBatchClient = makeKillableClient(_service, kClientName);
             AlternativeClientRegion acr(applyBatchClient);
             auto applyBatchOpCtx = makeInterruptibleOperationContext();
@@ -331,7 +347,7 @@ ExecutorFuture<void> ReshardingOplogApplier::_scheduleNextBatch() {
             if (_stage == ReshardingOplogApplier::Stage::kStarted &&
                 lastAppliedTs >= _reshardingCloneFinishedTs) {
                 _stage = ReshardingOplogApplier::Stage::kReachedCloningTS;
-                // TODO: SERVER-51741 preemptively schedule next batch
+                // The batch prefetched while applying this one is left for applyUntilDone().
                 return false;
             }
 
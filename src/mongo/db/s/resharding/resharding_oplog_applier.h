@@ -100,6 +100,12 @@ private:
      */
     ExecutorFuture<void> _scheduleNextBatch();
 
+    /**
+     * Returns the batch prefetched while the previous one was being applied, or starts reading the
+     * next batch from the donor's oplog buffer if there is none.
+     */
+    ExecutorFuture<OplogBatch> _getNextBatch();
+
     /**
      * Setup the worker threads to apply the ops in the current buffer in parallel. Waits for all
      * worker threads to finish (even when some of them finished early due to an error).
@@ -204,6 +210,10 @@ private:
     // (R) The source of the oplog entries to be applied.
     std::unique_ptr<ReshardingDonorOplogIteratorInterface> _oplogIter;
 
+    // (R) The next batch, read from '_oplogIter' concurrently with the application of the current
+    // batch. Only one read from '_oplogIter' is ever outstanding.
+    boost::optional<ExecutorFuture<OplogBatch>> _prefetchedBatch;
+
     // (R) Tracks the current stage of this applier.
     Stage _stage{Stage::kStarted};
 };
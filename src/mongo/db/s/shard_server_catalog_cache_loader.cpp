@@ -373,7 +373,7 @@ ShardServerCatalogCacheLoader::ShardServerCatalogCacheLoader(
           ThreadPool::Options options;
           options.poolName = "ShardServerCatalogCacheLoader";
           options.minThreads = 0;
-          options.maxThreads = 6;
+          options.maxThreads = shardServerCatalogCacheLoaderMaxThreads;
           return options;
       }())) {
     _executor->startup();
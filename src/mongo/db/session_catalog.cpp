@@ -79,21 +79,29 @@ SessionCatalog::ScopedCheckedOutSession SessionCatalog::_checkOutSession(Operati
     invariant(!opCtx->lockState()->inAWriteUnitOfWork());
     invariant(!opCtx->lockState()->isLocked());
 
+    // Read the clock out of the lock.
+    const auto now = Date_t::now();
+
     stdx::unique_lock<Latch> ul(_mutex);
     auto sri = _getOrCreateSessionRuntimeInfo(ul, opCtx, *opCtx->getLogicalSessionId());
 
-    // Wait until the session is no longer checked out and until the previously scheduled kill has
-    // completed
-    ++sri->numWaitingToCheckOut;
-    ON_BLOCK_EXIT([&] { --sri->numWaitingToCheckOut; });
-
-    opCtx->waitForConditionOrInterrupt(sri->availableCondVar, ul, [&ul, &sri]() {
+    auto isAvailable = [&ul, &sri]() {
         ObservableSession osession(ul, sri->session);
         return !osession.currentOperation() && !osession._killed();
-    });
+    };
+
+    // Wait until the session is no longer checked out and until the previously scheduled kill has
+    // completed. Most sessions are only used by one operation at a time, so skip the wait if the
+    // session is already available.
+    if (!isAvailable()) {
+        ++sri->numWaitingToCheckOut;
+        ON_BLOCK_EXIT([&] { --sri->numWaitingToCheckOut; });
+
+        opCtx->waitForConditionOrInterrupt(sri->availableCondVar, ul, isAvailable);
+    }
 
     sri->session._checkoutOpCtx = opCtx;
-    sri->session._lastCheckout = Date_t::now();
+    sri->session._lastCheckout = now;
 
     return ScopedCheckedOutSession(
         *this, std::move(sri), boost::none /* Not checked out for kill */);
@@ -205,11 +213,14 @@ void SessionCatalog::_releaseSession(SessionRuntimeInfo* sri,
     stdx::lock_guard<Latch> lg(_mutex);
 
     // Make sure we have exactly the same session on the map and that it is still associated with an
-    // operation context (meaning checked-out)
-    invariant(_sessions[sri->session.getSessionId()].get() == sri);
+    // operation context (meaning checked-out). Checked-out sessions are never reaped, so the map
+    // lookup is only done in debug builds.
+    dassert(_sessions.find(sri->session.getSessionId())->second.get() == sri);
     invariant(sri->session._checkoutOpCtx);
     sri->session._checkoutOpCtx = nullptr;
-    sri->availableCondVar.notify_all();
+    if (sri->numWaitingToCheckOut) {
+        sri->availableCondVar.notify_all();
+    }
 
     if (killToken) {
         invariant(sri->session._killsRequested > 0);
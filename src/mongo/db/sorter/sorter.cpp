@@ -48,10 +48,15 @@
 
 #include "mongo/db/sorter/sorter.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
+#include <cstring>
+#include <exception>
 #include <snappy.h>
 #include <vector>
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
@@ -61,6 +66,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
@@ -119,6 +125,111 @@ inline std::string myErrnoWithDescription() {
     return sb.str();
 }
 
+// Below this many elements per thread, spawning threads costs more than the sort it parallelizes.
+const size_t kMinElementsPerSortThread = 16 * 1024;
+
+/**
+ * Stably sorts [begin, end) using up to 'numThreads' threads. The range is cut into contiguous
+ * chunks which are sorted concurrently, one of them on the calling thread, and the sorted chunks
+ * are then merged pairwise in order, which preserves stability. Each element is only ever touched
+ * by one thread, but the comparator itself is shared and must be safe to call concurrently.
+ */
+template <typename RandomIt, typename Less>
+void parallelStableSort(RandomIt begin, RandomIt end, const Less& less, size_t numThreads) {
+    const size_t numElements = end - begin;
+    numThreads = std::min(numThreads, numElements / kMinElementsPerSortThread);
+    if (numThreads <= 1) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    const size_t chunkSize = (numElements + numThreads - 1) / numThreads;
+    std::vector<RandomIt> bounds;
+    for (size_t i = 0; i < numThreads; ++i) {
+        bounds.push_back(begin + std::min(numElements, i * chunkSize));
+    }
+    bounds.push_back(end);
+
+    std::vector<std::exception_ptr> errors(numThreads);
+    std::vector<stdx::thread> threads;
+    threads.reserve(numThreads - 1);
+    auto sortChunk = [&](size_t i) {
+        try {
+            std::stable_sort(bounds[i], bounds[i + 1], less);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(sortChunk, i);
+    }
+    sortChunk(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    for (size_t width = 1; width < numThreads; width *= 2) {
+        for (size_t i = 0; i + width < numThreads; i += 2 * width) {
+            std::inplace_merge(
+                bounds[i], bounds[i + width], bounds[std::min(i + 2 * width, numThreads)], less);
+        }
+    }
+}
+
+/**
+ * Returns the first eight bytes of 'key' as a big-endian integer, zero-padded on the right, so
+ * that two different prefixes compare the same way as the keys they came from.
+ */
+template <typename Key>
+uint64_t normalizedKeyPrefix(const Key& key) {
+    char bytes[sizeof(uint64_t)] = {};
+    std::memcpy(bytes, key.getBuffer(), std::min(key.getSize(), sizeof(bytes)));
+    return ConstDataView(bytes).read<BigEndian<uint64_t>>();
+}
+
+/**
+ * Stably sorts 'data' for a comparator declared SorterKeysAreBinaryComparable. A compact array of
+ * (prefix, position) entries is sorted instead of the pairs themselves, so most comparisons stay
+ * in that array and never touch the keys' heap buffers; 'comp' is only consulted when prefixes
+ * tie, and the original position breaks full ties. The run is then rebuilt by moving each pair
+ * once into its sorted place.
+ */
+template <typename Container, typename Comparator>
+void normalizedKeySort(Container& data, const Comparator& comp, size_t numThreads) {
+    struct Entry {
+        uint64_t prefix;
+        size_t pos;
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        entries.push_back({normalizedKeyPrefix(data[i].first), i});
+    }
+
+    auto less = [&](const Entry& lhs, const Entry& rhs) {
+        if (lhs.prefix != rhs.prefix) {
+            return lhs.prefix < rhs.prefix;
+        }
+        if (int cmp = comp(data[lhs.pos], data[rhs.pos])) {
+            return cmp < 0;
+        }
+        return lhs.pos < rhs.pos;
+    };
+    parallelStableSort(entries.begin(), entries.end(), less, numThreads);
+
+    Container sorted;
+    for (const auto& entry : entries) {
+        sorted.push_back(std::move(data[entry.pos]));
+    }
+    data.swap(sorted);
+}
+
 template <typename Data, typename Comparator>
 void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs) {
 #if defined(MONGO_CONFIG_DEBUG_BUILD) && !defined(_MSC_VER)
@@ -426,7 +537,7 @@ public:
 
         std::make_heap(_heap.begin(), _heap.end(), _greater);
         std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
+        _current = std::move(_heap.back());
         _heap.pop_back();
     }
 
@@ -461,7 +572,7 @@ public:
         if (!_current->advance()) {
             verify(!_heap.empty());
             std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
+            _current = std::move(_heap.back());
             _heap.pop_back();
         } else if (!_heap.empty() && _greater(_current, _heap.front())) {
             std::pop_heap(_heap.begin(), _heap.end(), _greater);
@@ -589,6 +700,7 @@ public:
         invariant(!_done);
 
         _data.emplace_back(key.getOwned(), val.getOwned());
+        _dataIsSorted = false;
 
         _memUsed += key.memUsageForSorter();
         _memUsed += val.memUsageForSorter();
@@ -604,11 +716,17 @@ public:
         _memUsed += val.memUsageForSorter();
 
         _data.emplace_back(std::move(key), std::move(val));
+        _dataIsSorted = false;
 
         if (_memUsed > this->_opts.maxMemoryUsageBytes)
             spill();
     }
 
+    void sortInMemoryData() override {
+        invariant(!_done);
+        sort();
+    }
+
     Iterator* done() {
         invariant(!std::exchange(_done, true));
 
@@ -635,9 +753,19 @@ private:
     };
 
     void sort() {
-        STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
-        this->_numSorted += _data.size();
+        if (_dataIsSorted) {
+            return;
+        }
+
+        if constexpr (SorterKeysAreBinaryComparable<Comparator>::value) {
+            normalizedKeySort(_data, _comp, this->_opts.sortThreads);
+        } else {
+            STLComparator less(_comp);
+            parallelStableSort(_data.begin(), _data.end(), less, this->_opts.sortThreads);
+        }
+        this->_numSorted += _data.size() - _numDataCounted;
+        _numDataCounted = _data.size();
+        _dataIsSorted = true;
     }
 
     void spill() {
@@ -663,6 +791,7 @@ private:
         for (; !_data.empty(); _data.pop_front()) {
             writer.addAlreadySorted(_data.front().first, _data.front().second);
         }
+        _numDataCounted = 0;
         Iterator* iteratorPtr = writer.done();
         _nextSortedFileWriterOffset = writer.getFileEndOffset();
 
@@ -675,6 +804,8 @@ private:
     const Settings _settings;
     std::streampos _nextSortedFileWriterOffset = 0;
     bool _done = false;
+    bool _dataIsSorted = true;   // Whether '_data' is known to be sorted already.
+    size_t _numDataCounted = 0;  // Pairs of '_data' already counted in '_numSorted'.
     size_t _memUsed = 0;
     std::deque<Data> _data;  // Data that has not been spilled.
 };
@@ -707,6 +838,10 @@ public:
         _best = {contender.first.getOwned(), contender.second.getOwned()};
     }
 
+    const Key* getCutoffKey() const override {
+        return _haveData ? &_best.first : nullptr;
+    }
+
     Iterator* done() {
         if (_haveData) {
             return new InMemIterator<Key, Value>(_best);
@@ -764,21 +899,54 @@ public:
     }
 
     void add(const Key& key, const Value& val) {
+        addImpl<true>(Data(key, val));
+    }
+
+    void emplace(Key&& key, Value&& val) override {
+        addImpl<false>(Data(std::move(key), std::move(val)));
+    }
+
+    const Key* getCutoffKey() const override {
+        if (_data.size() == this->_opts.limit) {
+            return &_data.front().first;
+        }
+        return _haveCutoff ? &_cutoff.first : nullptr;
+    }
+
+    Iterator* done() {
+        if (this->_iters.empty()) {
+            sort();
+            return new InMemIterator<Key, Value>(_data);
+        }
+
+        spill();
+        Iterator* iterator = Iterator::merge(this->_iters, this->_opts, _comp);
+        _done = true;
+        return iterator;
+    }
+
+private:
+    /**
+     * Keeps 'contender' if it is among the best 'limit' pairs seen so far. When 'makeOwned' is
+     * false, the caller has handed over an owned pair, which is moved into '_data' rather than
+     * copied.
+     */
+    template <bool makeOwned>
+    void addImpl(Data contender) {
         invariant(!_done);
 
         this->_numSorted += 1;
 
         STLComparator less(_comp);
-        Data contender(key, val);
 
         if (_data.size() < this->_opts.limit) {
             if (_haveCutoff && !less(contender, _cutoff))
                 return;
 
-            _data.emplace_back(contender.first.getOwned(), contender.second.getOwned());
+            _memUsed += contender.first.memUsageForSorter();
+            _memUsed += contender.second.memUsageForSorter();
 
-            _memUsed += key.memUsageForSorter();
-            _memUsed += val.memUsageForSorter();
+            _data.push_back(owned<makeOwned>(std::move(contender)));
 
             if (_data.size() == this->_opts.limit)
                 std::make_heap(_data.begin(), _data.end(), less);
@@ -796,33 +964,29 @@ public:
 
         // Remove the old worst pair and insert the contender, adjusting _memUsed
 
-        _memUsed += key.memUsageForSorter();
-        _memUsed += val.memUsageForSorter();
+        _memUsed += contender.first.memUsageForSorter();
+        _memUsed += contender.second.memUsageForSorter();
 
         _memUsed -= _data.front().first.memUsageForSorter();
         _memUsed -= _data.front().second.memUsageForSorter();
 
         std::pop_heap(_data.begin(), _data.end(), less);
-        _data.back() = {contender.first.getOwned(), contender.second.getOwned()};
+        _data.back() = owned<makeOwned>(std::move(contender));
         std::push_heap(_data.begin(), _data.end(), less);
 
         if (_memUsed > this->_opts.maxMemoryUsageBytes)
             spill();
     }
 
-    Iterator* done() {
-        if (this->_iters.empty()) {
-            sort();
-            return new InMemIterator<Key, Value>(_data);
+    template <bool makeOwned>
+    static Data owned(Data&& data) {
+        if constexpr (makeOwned) {
+            return {data.first.getOwned(), data.second.getOwned()};
+        } else {
+            return std::move(data);
         }
-
-        spill();
-        Iterator* iterator = Iterator::merge(this->_iters, this->_opts, _comp);
-        _done = true;
-        return iterator;
     }
 
-private:
     class STLComparator {
     public:
         explicit STLComparator(const Comparator& comp) : _comp(comp) {}
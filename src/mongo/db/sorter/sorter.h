@@ -35,6 +35,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -108,7 +109,13 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    // Number of threads used to sort each in-memory run before it is returned or spilled. Values
+    // above 1 are only honored when there is enough data to split, and require a comparator that
+    // is safe to call concurrently on distinct elements.
+    size_t sortThreads;
+
+    SortOptions()
+        : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false), sortThreads(1) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -131,8 +138,22 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& SortThreads(size_t newSortThreads) {
+        sortThreads = newSortThreads;
+        return *this;
+    }
 };
 
+/**
+ * Specialize this to std::true_type for a comparator that orders keys exactly as an unsigned
+ * bytewise comparison of Key::getBuffer()/getSize() would, with a key that is a prefix of another
+ * ordered first. The Sorter then sorts in-memory runs on fixed-width normalized key prefixes and
+ * only calls the comparator when two prefixes tie.
+ */
+template <typename Comparator>
+struct SorterKeysAreBinaryComparable : std::false_type {};
+
 /**
  * This is a 0-sized dummy object that satisfies Sorter's Key/Value interface.
  */
@@ -249,6 +270,31 @@ public:
     virtual void emplace(Key&& k, Value&& v) {
         add(k, v);
     }
+
+    /**
+     * For sorters which only keep the best 'limit' pairs, returns a key such that add() discards
+     * any pair whose key does not sort strictly before it. Returns nullptr while any pair could
+     * still be kept. Callers whose comparator orders pairs by key alone can check this before
+     * materializing a value, and call noteDiscarded() instead of add() for pairs that lose.
+     *
+     * The returned pointer is invalidated by the next call to add() or emplace().
+     */
+    virtual const Key* getCutoffKey() const {
+        return nullptr;
+    }
+
+    /**
+     * Accounts for a pair which the caller discarded based on getCutoffKey() without adding it.
+     */
+    void noteDiscarded() {
+        _numSorted += 1;
+    }
+    /**
+     * Sorts the pairs held in memory ahead of done(), which then only has to spill or iterate
+     * them. Touches nothing but this Sorter, so distinct Sorters may do this concurrently.
+     */
+    virtual void sortInMemoryData() {}
+
     /**
      * Cannot add more data after calling done().
      *
@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <random>
+
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+// Required by sorter.cpp; the benchmarks below never spill.
+std::string nextFileName() {
+    return "extsort-sorter-bm";
+}
+
+}  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+
+namespace mongo {
+namespace sorter {
+namespace {
+
+const int kNumKeys = 100 * 1000;
+const Ordering kAllAscending = Ordering::make(BSONObj());
+
+typedef std::pair<KeyString::Value, NullValue> KeyPair;
+
+struct KeyPairComparator {
+    int operator()(const KeyPair& lhs, const KeyPair& rhs) const {
+        return lhs.first.compare(rhs.first);
+    }
+};
+
+enum KeyShape {
+    // Random integers followed by a RecordId, as in a single-field index on an integer.
+    RANDOM_INT,
+    // A string shared by every key, then a random integer and a RecordId, as in a compound index
+    // whose leading field has a single value.
+    SHARED_PREFIX,
+};
+
+std::deque<KeyPair> generateKeys(KeyShape shape) {
+    std::mt19937_64 gen(1234);
+    const std::string sharedPrefix(24, 'p');
+    std::deque<KeyPair> keys;
+    for (int i = 0; i < kNumKeys; i++) {
+        const long long value = gen();
+        KeyString::Builder builder(KeyString::Version::V1,
+                                   shape == SHARED_PREFIX
+                                       ? BSON("" << sharedPrefix << "" << value)
+                                       : BSON("" << value),
+                                   kAllAscending,
+                                   RecordId(i));
+        keys.emplace_back(builder.getValueCopy(), NullValue());
+    }
+    return keys;
+}
+
+void BM_ComparatorSort(benchmark::State& state, KeyShape shape) {
+    const auto keys = generateKeys(shape);
+    KeyPairComparator comp;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto data = keys;
+        state.ResumeTiming();
+        parallelStableSort(
+            data.begin(),
+            data.end(),
+            [&](const KeyPair& lhs, const KeyPair& rhs) { return comp(lhs, rhs) < 0; },
+            1);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * kNumKeys);
+}
+
+void BM_NormalizedKeySort(benchmark::State& state, KeyShape shape) {
+    const auto keys = generateKeys(shape);
+    KeyPairComparator comp;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto data = keys;
+        state.ResumeTiming();
+        normalizedKeySort(data, comp, 1);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * kNumKeys);
+}
+
+BENCHMARK_CAPTURE(BM_ComparatorSort, RandomInt, RANDOM_INT);
+BENCHMARK_CAPTURE(BM_ComparatorSort, SharedPrefix, SHARED_PREFIX);
+BENCHMARK_CAPTURE(BM_NormalizedKeySort, RandomInt, RANDOM_INT);
+BENCHMARK_CAPTURE(BM_NormalizedKeySort, SharedPrefix, SHARED_PREFIX);
+
+}  // namespace
+}  // namespace sorter
+}  // namespace mongo
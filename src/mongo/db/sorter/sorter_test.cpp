@@ -864,6 +864,153 @@ TEST_F(SorterMakeFromExistingRangesTest, RoundTrip) {
     }
 }
 
+TEST(SorterCutoffKeyTest, NoCutoffWithoutLimit) {
+    auto sorter = std::unique_ptr<IWSorter>(IWSorter::make(SortOptions(), IWComparator(ASC)));
+    sorter->add(1, -1);
+    sorter->add(2, -2);
+    ASSERT_FALSE(sorter->getCutoffKey());
+}
+
+TEST(SorterCutoffKeyTest, LimitOneCutoffIsBestKey) {
+    auto sorter =
+        std::unique_ptr<IWSorter>(IWSorter::make(SortOptions().Limit(1), IWComparator(ASC)));
+    ASSERT_FALSE(sorter->getCutoffKey());
+
+    sorter->add(5, -5);
+    ASSERT(sorter->getCutoffKey());
+    ASSERT_EQUALS(5, *sorter->getCutoffKey());
+
+    sorter->add(3, -3);
+    ASSERT_EQUALS(3, *sorter->getCutoffKey());
+}
+
+TEST(SorterCutoffKeyTest, TopKCutoffIsWorstKeptKey) {
+    auto sorter =
+        std::unique_ptr<IWSorter>(IWSorter::make(SortOptions().Limit(3), IWComparator(DESC)));
+    sorter->add(1, -1);
+    sorter->add(7, -7);
+    ASSERT_FALSE(sorter->getCutoffKey());
+
+    sorter->add(4, -4);
+    ASSERT(sorter->getCutoffKey());
+    ASSERT_EQUALS(1, *sorter->getCutoffKey());
+
+    sorter->emplace(9, -9);
+    ASSERT_EQUALS(4, *sorter->getCutoffKey());
+
+    // A pair discarded by the caller still counts as sorted.
+    sorter->noteDiscarded();
+    ASSERT_EQ(5, sorter->numSorted());
+
+    auto iter = std::unique_ptr<IWIterator>(sorter->done());
+    for (int expected : {9, 7, 4}) {
+        ASSERT(iter->more());
+        auto pair = iter->next();
+        ASSERT_EQUALS(expected, pair.first);
+        ASSERT_EQUALS(-expected, pair.second);
+    }
+    ASSERT_FALSE(iter->more());
+}
+
+TEST(SorterParallelSortTest, ParallelStableSortIsStable) {
+    // Few distinct keys across enough elements to be split between several threads; the value
+    // records the original position so that stability can be checked.
+    const int numItems = 5 * kMinElementsPerSortThread + 17;
+    std::deque<IWPair> data;
+    for (int i = 0; i < numItems; i++) {
+        data.emplace_back((i * 7919) % 13, i);
+    }
+
+    IWComparator comp(ASC);
+    parallelStableSort(
+        data.begin(),
+        data.end(),
+        [&](const IWPair& lhs, const IWPair& rhs) { return comp(lhs, rhs) < 0; },
+        4);
+
+    ASSERT_EQ(size_t(numItems), data.size());
+    for (size_t i = 1; i < data.size(); i++) {
+        ASSERT_LTE(int(data[i - 1].first), int(data[i].first));
+        if (data[i - 1].first == data[i].first) {
+            ASSERT_LT(int(data[i - 1].second), int(data[i].second));
+        }
+    }
+}
+
+TEST(SorterParallelSortTest, InMemoryRunsUseSortThreads) {
+    const int numItems = 4 * kMinElementsPerSortThread;
+    auto sorter = std::unique_ptr<IWSorter>(
+        IWSorter::make(SortOptions().SortThreads(4), IWComparator(DESC)));
+    for (int i = 0; i < numItems; i++) {
+        sorter->add(i, -i);
+    }
+
+    auto iter = std::shared_ptr<IWIterator>(sorter->done());
+    ASSERT_ITERATORS_EQUIVALENT(iter, std::make_shared<IntIterator>(numItems - 1, -1, -1));
+}
+
+TEST(SorterNormalizedKeySortTest, MatchesBytewiseOrderAndIsStable) {
+    struct BytesKey {
+        const char* getBuffer() const {
+            return bytes.data();
+        }
+        size_t getSize() const {
+            return bytes.size();
+        }
+        std::string bytes;
+    };
+    typedef std::pair<BytesKey, int> BytesPair;
+    auto comp = [](const BytesPair& lhs, const BytesPair& rhs) {
+        return lhs.first.bytes.compare(rhs.first.bytes);
+    };
+
+    // Keys that tie on their first eight bytes, are prefixes of one another, contain zero bytes
+    // and bytes above 0x7f, and repeat so that stability is observable.
+    const std::vector<std::string> distinctKeys = {"",
+                                                   std::string("\0", 1),
+                                                   "a",
+                                                   std::string("a\0", 2),
+                                                   "abcdefgh",
+                                                   "abcdefgh1",
+                                                   "abcdefgh0",
+                                                   "abcdefgi",
+                                                   "\xff",
+                                                   "\x80" "abc"};
+    std::deque<BytesPair> data;
+    for (int i = 0; i < 100; i++) {
+        data.push_back({{distinctKeys[(i * 7) % distinctKeys.size()]}, i});
+    }
+    auto expected = data;
+    std::stable_sort(
+        expected.begin(), expected.end(), [&](const BytesPair& lhs, const BytesPair& rhs) {
+            return comp(lhs, rhs) < 0;
+        });
+
+    normalizedKeySort(data, comp, 1);
+
+    ASSERT_EQ(expected.size(), data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(expected[i].first.bytes, data[i].first.bytes);
+        ASSERT_EQ(expected[i].second, data[i].second);
+    }
+}
+
+TEST(SorterSortInMemoryDataTest, DataAddedAfterSortingIsStillSorted) {
+    auto sorter = std::unique_ptr<IWSorter>(IWSorter::make(SortOptions(), IWComparator(ASC)));
+    sorter->add(3, -3);
+    sorter->add(1, -1);
+    sorter->sortInMemoryData();
+    sorter->sortInMemoryData();
+    sorter->add(2, -2);
+    sorter->add(0, 0);
+    sorter->sortInMemoryData();
+    sorter->add(4, -4);
+
+    ASSERT_EQ(5, sorter->numSorted());
+    auto iter = std::shared_ptr<IWIterator>(sorter->done());
+    ASSERT_ITERATORS_EQUIVALENT(iter, std::make_shared<IntIterator>(0, 5));
+}
+
 }  // namespace
 }  // namespace sorter
 }  // namespace mongo
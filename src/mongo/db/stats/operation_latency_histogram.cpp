@@ -51,29 +51,61 @@ const std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets>
                                                256,
                                                512,
                                                1024,
+                                               1280,
+                                               1536,
+                                               1792,
                                                2048,
+                                               2560,
                                                3072,
+                                               3584,
                                                4096,
+                                               5120,
                                                6144,
+                                               7168,
                                                8192,
+                                               10240,
                                                12288,
+                                               14336,
                                                16384,
+                                               20480,
                                                24576,
+                                               28672,
                                                32768,
+                                               40960,
                                                49152,
+                                               57344,
                                                65536,
+                                               81920,
                                                98304,
+                                               114688,
                                                131072,
+                                               163840,
                                                196608,
+                                               229376,
                                                262144,
+                                               327680,
                                                393216,
+                                               458752,
                                                524288,
+                                               655360,
                                                786432,
+                                               917504,
                                                1048576,
+                                               1310720,
                                                1572864,
+                                               1835008,
                                                2097152,
+                                               2621440,
+                                               3145728,
+                                               3670016,
                                                4194304,
+                                               5242880,
+                                               6291456,
+                                               7340032,
                                                8388608,
+                                               10485760,
+                                               12582912,
+                                               14680064,
                                                16777216,
                                                33554432,
                                                67108864,
@@ -153,7 +185,7 @@ void OperationLatencyHistogram::append(bool includeHistograms,
     _append(_transactions, "transactions", includeHistograms, slowMSBucketsOnly, builder);
 }
 
-// Computes the log base 2 of value, and checks for cases of split buckets.
+// Computes the log base 2 of value, and splits the octaves in the millisecond range into quarters.
 int OperationLatencyHistogram::_getBucket(uint64_t value) {
     // Zero is a special case since log(0) is undefined.
     if (value == 0) {
@@ -161,22 +193,17 @@ int OperationLatencyHistogram::_getBucket(uint64_t value) {
     }
 
     int log2 = 63 - countLeadingZeros64(value);
-    // Half splits occur in range [2^11, 2^21) giving 10 extra buckets.
-    if (log2 < 11) {
+    if (log2 < kFirstSplitLog2) {
         return log2;
-    } else if (log2 < 21) {
-        int extra = log2 - 11;
-        // Split value boundary is at (2^n + 2^(n+1))/2 = 2^n + 2^(n-1).
-        // Which corresponds to (1ULL << log2) | (1ULL << (log2 - 1))
-        // Which is equivalent to the following:
-        uint64_t splitBoundary = 3ULL << (log2 - 1);
-        if (value >= splitBoundary) {
-            extra++;
-        }
-        return log2 + extra;
+    } else if (log2 < kLastSplitLog2) {
+        // Quarter splits occur in range [2^10, 2^24), that is from about 1ms to 16s. The two bits
+        // below the most significant one select the quarter of the octave 'value' falls into.
+        int quarter = (value >> (log2 - 2)) & 3;
+        return kFirstSplitLog2 + (log2 - kFirstSplitLog2) * kSplitsPerOctave + quarter;
     } else {
-        // Add all of the extra 10 buckets.
-        return std::min(log2 + 10, kMaxBuckets - 1);
+        // Every octave in the split range adds 3 extra buckets.
+        return std::min(log2 + (kLastSplitLog2 - kFirstSplitLog2) * (kSplitsPerOctave - 1),
+                        kMaxBuckets - 1);
     }
 }
 
@@ -44,7 +44,7 @@ class BSONObjBuilder;
  */
 class OperationLatencyHistogram {
 public:
-    static const int kMaxBuckets = 51;
+    static const int kMaxBuckets = 83;
 
     // Inclusive lower bounds of the histogram buckets.
     static const std::array<uint64_t, kMaxBuckets> kLowerBounds;
@@ -66,6 +66,13 @@ private:
         uint64_t sum = 0;
     };
 
+    // Octaves from 2^kFirstSplitLog2 up to, but not including, 2^kLastSplitLog2 microseconds are
+    // split into kSplitsPerOctave equal buckets, so that latencies in the range service level
+    // objectives are usually expressed in can be told apart.
+    static constexpr int kFirstSplitLog2 = 10;
+    static constexpr int kLastSplitLog2 = 24;
+    static constexpr int kSplitsPerOctave = 4;
+
     static int _getBucket(uint64_t latency);
 
     static uint64_t _getBucketMicros(int bucket);
@@ -115,7 +115,7 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatencySlowBuckets) {
     BSONObj out = outBuilder.done();
     ASSERT_EQUALS(static_cast<uint64_t>(out["reads"]["latency"].Long()), expectedSum);
 
-    const size_t kMaxUnFilteredBuckets = 23;
+    const size_t kMaxUnFilteredBuckets = 37;
     // Each bucket has three counts with the exception of the last bucket, which has two.
     ASSERT_EQUALS(out["reads"]["ops"].Long(), 3 * kMaxBuckets - 1);
     std::vector<BSONElement> readBuckets = out["reads"]["histogram"].Array();
@@ -131,7 +131,7 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatencySlowBuckets) {
         BSONObj bucket = readBuckets[kMaxUnFilteredBuckets].Obj();
         ASSERT_EQUALS(static_cast<uint64_t>(bucket["micros"].Long()),
                       kLowerBounds[kMaxUnFilteredBuckets] + 1);
-        ASSERT_EQUALS(bucket["count"].Long(), 83);
+        ASSERT_EQUALS(bucket["count"].Long(), 137);
     }
 }
 }  // namespace mongo
@@ -153,9 +153,14 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
+    // Protects '_usage'.
     mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
     UsageMap _usage;
+
+    // Every operation records its latency in the global histogram, so it has its own mutex rather
+    // than contending with the per-collection usage on '_lock'.
+    mutable SimpleMutex _globalHistogramLock;
+    OperationLatencyHistogram _globalHistogramStats;
 };
 
 }  // namespace mongo
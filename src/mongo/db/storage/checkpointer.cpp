@@ -36,6 +36,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
@@ -79,11 +80,33 @@ void Checkpointer::run() {
             MONGO_IDLE_THREAD_BLOCK;
 
             // Wait for 'storageGlobalParams.checkpointDelaySecs' seconds; or until either shutdown
-            // is signaled or a checkpoint is triggered.
-            _sleepCV.wait_for(lock,
-                              stdx::chrono::seconds(static_cast<std::int64_t>(
-                                  storageGlobalParams.checkpointDelaySecs)),
-                              [&] { return _shuttingDown || _triggerCheckpoint; });
+            // is signaled, a checkpoint is triggered, or the cache holds enough dirty data to
+            // checkpoint early.
+            const auto deadline = Date_t::now() +
+                Seconds(static_cast<std::int64_t>(storageGlobalParams.checkpointDelaySecs));
+            auto wakeUp = [&] { return _shuttingDown || _triggerCheckpoint; };
+            while (!wakeUp() && Date_t::now() < deadline) {
+                const auto dirtyBytesThreshold = gCheckpointDirtyBytesThreshold.load();
+                const auto wakeUpAt = dirtyBytesThreshold > 0
+                    ? std::min(deadline, Date_t::now() + Seconds(1))
+                    : deadline;
+                if (_sleepCV.wait_until(lock, wakeUpAt.toSystemTimePoint(), wakeUp) ||
+                    dirtyBytesThreshold == 0) {
+                    continue;
+                }
+
+                lock.unlock();
+                const auto dirtyBytes = _kvEngine->getCacheDirtyBytes();
+                lock.lock();
+                if (dirtyBytes && *dirtyBytes >= dirtyBytesThreshold) {
+                    LOGV2_DEBUG(5512500,
+                                2,
+                                "Taking a checkpoint early, the cache holds enough dirty data",
+                                "dirtyBytes"_attr = *dirtyBytes,
+                                "checkpointDirtyBytesThreshold"_attr = dirtyBytesThreshold);
+                    break;
+                }
+            }
 
             // If the checkpointDelaySecs is set to 0, that means we should skip checkpointing.
             // However, checkpointDelaySecs is adjustable by a runtime server parameter, so we
@@ -34,10 +34,13 @@
 #include "mongo/db/storage/control/journal_flusher.h"
 
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/chrono.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
@@ -50,6 +53,27 @@ const auto getJournalFlusher = ServiceContext::declareDecoration<std::unique_ptr
 
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherThread);
 
+class JournalFlusherServerStatusSection final : public ServerStatusSection {
+public:
+    JournalFlusherServerStatusSection() : ServerStatusSection("journalFlusher") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto& journalFlusher = getJournalFlusher(opCtx->getServiceContext());
+        if (!journalFlusher) {
+            return BSONObj();
+        }
+
+        BSONObjBuilder builder;
+        journalFlusher->appendStats(&builder);
+        return builder.obj();
+    }
+} journalFlusherServerStatusSection;
+
 }  // namespace
 
 JournalFlusher* JournalFlusher::get(ServiceContext* serviceCtx) {
@@ -135,6 +159,18 @@ void JournalFlusher::run() {
             });
         }
 
+        // Hold a requested round open so more writers can join it before it flushes, unless
+        // enough of them are waiting already.
+        const auto coalescingWindow =
+            stdx::chrono::microseconds(gJournalCommitCoalescingWindowMicros.load());
+        if (_flushJournalNow && coalescingWindow.count() > 0) {
+            _flushJournalNowCV.wait_until(
+                lk, stdx::chrono::steady_clock::now() + coalescingWindow, [&] {
+                    return _nextWaiters >= gJournalCommitMaxBatchSize.load() || _needToPause ||
+                        _shuttingDown;
+                });
+        }
+
         if (_needToPause) {
             _state = States::Paused;
             _stateChangeCV.notify_all();
@@ -163,6 +199,14 @@ void JournalFlusher::run() {
         // Take the next promise as current and reset the next promise.
         _currentSharedPromise =
             std::exchange(_nextSharedPromise, std::make_unique<SharedPromise<void>>());
+
+        const int batchSize = std::exchange(_nextWaiters, 0);
+        size_t bucket = 0;
+        while (bucket + 1 < kNumBatchSizeBuckets && (1LL << bucket) <= batchSize) {
+            ++bucket;
+        }
+        ++_batchSizes[bucket];
+        _totalWaiters += batchSize;
     }
 }
 
@@ -229,10 +273,33 @@ void JournalFlusher::interruptJournalFlusherForReplStateChange() {
     }
 }
 
+void JournalFlusher::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_stateMutex);
+    long long rounds = 0;
+    for (auto count : _batchSizes) {
+        rounds += count;
+    }
+    builder->append("rounds", rounds);
+    builder->append("waiters", _totalWaiters);
+
+    BSONArrayBuilder histogramBuilder(builder->subarrayStart("waitersPerRound"));
+    for (size_t i = 0; i < kNumBatchSizeBuckets; i++) {
+        if (_batchSizes[i] == 0) {
+            continue;
+        }
+        BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+        entryBuilder.append("waiters", i == 0 ? 0LL : 1LL << (i - 1));
+        entryBuilder.append("count", _batchSizes[i]);
+    }
+}
+
 void JournalFlusher::_waitForJournalFlushNoRetry() {
     auto myFuture = [&]() {
         stdx::unique_lock<Latch> lk(_stateMutex);
-        if (!_flushJournalNow) {
+        // Wake up the thread to start a round, or to end a round held open by the coalescing
+        // window once enough writers are waiting for it.
+        ++_nextWaiters;
+        if (!_flushJournalNow || _nextWaiters == gJournalCommitMaxBatchSize.load()) {
             _flushJournalNow = true;
             _flushJournalNowCV.notify_one();
         }
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/db/service_context.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/background.h"
@@ -121,6 +123,12 @@ public:
      */
     void interruptJournalFlusherForReplStateChange();
 
+    /**
+     * Appends the number of flushing rounds and a histogram of the number of waiters each round
+     * flushed for.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
     // Journal flusher internal states.
     enum class States {
@@ -170,6 +178,18 @@ private:
     std::unique_ptr<SharedPromise<void>> _nextSharedPromise =
         std::make_unique<SharedPromise<void>>();
 
+    // The number of callers waiting on _nextSharedPromise. Once it reaches
+    // 'journalCommitMaxBatchSize', a round held open by 'journalCommitCoalescingWindowMicros'
+    // starts flushing right away.
+    int _nextWaiters = 0;
+
+    // Histogram of the number of waiters each flushing round flushed for. Bucket 0 counts rounds
+    // nobody waited for, and bucket i > 0 those with at least 2^(i-1) waiters, with the last bucket
+    // counting everything above its lower bound. Protected by _stateMutex.
+    static constexpr size_t kNumBatchSizeBuckets = 16;
+    std::array<long long, kNumBatchSizeBuckets> _batchSizes{};
+    long long _totalWaiters = 0;
+
     // Controls whether to ignore the 'storageGlobalParams.journalCommitIntervalMs' setting. If set,
     // data flushes will only be executed upon explicit request, no longer periodically in addition
     // to upon request.
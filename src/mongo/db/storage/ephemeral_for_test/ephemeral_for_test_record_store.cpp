@@ -39,6 +39,7 @@
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_parameters_gen.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_radix_store.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_recovery_unit.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_visibility_manager.h"
@@ -69,6 +70,24 @@ RecordId extractRecordId(const std::string& keyStr) {
     ++it;
     return RecordId((*it).Long());
 }
+
+/**
+ * Returns ExceededMemoryLimit if the radix store uses more memory than
+ * 'ephemeralForTestMaxMemoryUsageBytes' allows. The check is against the memory in use before the
+ * write, so a single write may take the usage past the limit.
+ */
+Status checkMemoryUsage() {
+    const auto limit = gMaxMemoryUsageBytes.load();
+    const auto usage = StringStore::totalMemory();
+    if (limit > 0 && usage > limit) {
+        return {ErrorCodes::ExceededMemoryLimit,
+                str::stream() << "ephemeralForTest storage engine uses " << usage
+                              << " bytes of memory, which exceeds "
+                                 "ephemeralForTestMaxMemoryUsageBytes of "
+                              << limit << " bytes"};
+    }
+    return Status::OK();
+}
 }  // namespace
 
 RecordStore::RecordStore(StringData ns,
@@ -154,6 +173,13 @@ Status RecordStore::insertRecords(OperationContext* opCtx,
     if (_isCapped && totalSize > _cappedMaxSize)
         return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
 
+    // The oplog is exempt so that replication, and the capped deletes which reclaim memory, do not
+    // stop.
+    if (!_isOplog) {
+        if (auto status = checkMemoryUsage(); !status.isOK())
+            return status;
+    }
+
     auto ru = RecoveryUnit::get(opCtx);
     StringStore* workingCopy(ru->getHead());
     {
@@ -185,6 +211,11 @@ Status RecordStore::updateRecord(OperationContext* opCtx,
                                  const RecordId& oldLocation,
                                  const char* data,
                                  int len) {
+    if (!_isOplog) {
+        if (auto status = checkMemoryUsage(); !status.isOK())
+            return status;
+    }
+
     StringStore* workingCopy(RecoveryUnit::get(opCtx)->getHead());
     SizeAdjuster adjuster(opCtx, this);
     {
@@ -35,10 +35,13 @@
 
 #include "mongo/base/init.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_kv_engine.h"
+#include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_parameters_gen.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_radix_store.h"
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_recovery_unit.h"
 #include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace ephemeral_for_test {
@@ -94,6 +97,41 @@ std::unique_ptr<mongo::RecordStoreHarnessHelper> makeRecordStoreHarnessHelper()
 MONGO_INITIALIZER(RegisterRecordStoreHarnessFactory)(InitializerContext*) {
     mongo::registerRecordStoreHarnessHelperFactory(makeRecordStoreHarnessHelper);
 }
+
+TEST(EphemeralForTestRecordStoreTest, WritesAreRejectedAboveMemoryLimit) {
+    const auto harnessHelper(makeRecordStoreHarnessHelper());
+    auto rs(harnessHelper->newNonCappedRecordStore());
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    const std::string data = "my record";
+    RecordId loc;
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        loc = unittest::assertGet(
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp()));
+        uow.commit();
+    }
+
+    gMaxMemoryUsageBytes.store(1);
+    ON_BLOCK_EXIT([] { gMaxMemoryUsageBytes.store(0); });
+
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_EQ(
+            ErrorCodes::ExceededMemoryLimit,
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp()).getStatus());
+        ASSERT_EQ(ErrorCodes::ExceededMemoryLimit,
+                  rs->updateRecord(opCtx.get(), loc, data.c_str(), data.size() + 1));
+    }
+
+    // Deletes are still allowed, so that memory can be reclaimed.
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        rs->deleteRecord(opCtx.get(), loc);
+        uow.commit();
+    }
+    ASSERT_EQ(0, rs->numRecords(opCtx.get()));
+}
 }  // namespace
 }  // namespace ephemeral_for_test
 }  // namespace mongo
@@ -221,6 +221,8 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLagged", _isLagged.load());
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
+    bob.append("lagMillis", _lastLagMillis.load());
+    bob.append("predictedLagMillis", _lastPredictedLagMillis.load());
 
     return bob.obj();
 }
@@ -244,6 +246,42 @@ void FlowControl::_updateTopologyData() {
               });
 }
 
+/**
+ * Extrapolates the commit point lag `flowControlLagTrendWeight` refresh periods ahead, using how
+ * much it changed since the previous refresh. Reacting to where the lag is heading rather than
+ * where it is keeps flow control from engaging only once the threshold has been overshot, and from
+ * releasing only once secondaries have fully caught up, which is what makes the granted rate
+ * oscillate.
+ */
+std::uint64_t FlowControl::_predictLagMillis(std::uint64_t lagMillis) {
+    const auto prevLagMillis = std::exchange(_prevLagMillis, lagMillis);
+    const double trendWeight = gFlowControlLagTrendWeight.load();
+    if (!prevLagMillis || trendWeight == 0.0) {
+        return lagMillis;
+    }
+
+    const double trend = static_cast<double>(lagMillis) - static_cast<double>(*prevLagMillis);
+    const double predicted = static_cast<double>(lagMillis) + trendWeight * trend;
+    return predicted <= 0.0 ? 0 : static_cast<std::uint64_t>(predicted);
+}
+
+/**
+ * While flow control stays engaged, only moves the granted tickets the
+ * `flowControlTicketSmoothingFactor` fraction of the way from the last target towards the newly
+ * calculated one. Single periods of noisy sustainer progress then no longer translate into sharp
+ * swings of the write rate.
+ */
+int FlowControl::_smoothTicketsWhileLagged(int calculatedTickets) {
+    const double smoothingFactor = gFlowControlTicketSmoothingFactor.load();
+    if (!_isLagged.load() || smoothingFactor >= 1.0) {
+        // When flow control first engages, the last target says nothing about the sustainer rate.
+        return calculatedTickets;
+    }
+
+    const double lastTickets = _lastTargetTicketsPermitted.load();
+    return static_cast<int>(lastTickets + smoothingFactor * (calculatedTickets - lastTickets));
+}
+
 int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>& prevMemberData,
                                             const std::vector<repl::MemberData>& currMemberData,
                                             std::int64_t locksUsedLastPeriod,
@@ -365,13 +403,21 @@ int FlowControl::getNumTickets(Date_t now) {
     // value for lag, so ignore them.
     const bool ignoreWallTimes = lastCommitted.wallTime > myLastApplied.wallTime;
 
+    std::uint64_t lagMillis = 0;
+    if (!ignoreWallTimes) {
+        const auto currLagMillis = getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime);
+        lagMillis = _predictLagMillis(currLagMillis);
+        _lastLagMillis.store(static_cast<std::int64_t>(currLagMillis));
+        _lastPredictedLagMillis.store(static_cast<std::int64_t>(lagMillis));
+    }
+
     // _approximateOpsBetween will return -1 if the input timestamps are in the same "bucket".
     // This is an indication that there are very few ops between the two timestamps.
     //
     // Don't let the no-op writer on idle systems fool the sophisticated "is the replica set
     // lagged" classifier.
     const bool isHealthy = !ignoreWallTimes &&
-        (getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime) < thresholdLagMillis ||
+        (lagMillis < thresholdLagMillis ||
          _approximateOpsBetween(lastCommitted.opTime.getTimestamp(),
                                 myLastApplied.opTime.getTimestamp()) == -1);
 
@@ -391,13 +437,12 @@ int FlowControl::getNumTickets(Date_t now) {
     } else if (!ignoreWallTimes && sustainerAdvanced(_prevMemberData, _currMemberData)) {
         // Expected case where flow control has meaningful data from the last period to make a new
         // calculation.
-        ret =
-            _calculateNewTicketsForLag(_prevMemberData,
-                                       _currMemberData,
-                                       locksUsedLastPeriod,
-                                       locksPerOp,
-                                       getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime),
-                                       thresholdLagMillis);
+        ret = _smoothTicketsWhileLagged(_calculateNewTicketsForLag(_prevMemberData,
+                                                                   _currMemberData,
+                                                                   locksUsedLastPeriod,
+                                                                   locksPerOp,
+                                                                   lagMillis,
+                                                                   thresholdLagMillis));
         if (!_isLagged.load()) {
             _isLagged.store(true);
             _isLaggedCount.fetchAndAddRelaxed(1);
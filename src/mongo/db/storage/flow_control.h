@@ -93,6 +93,14 @@ public:
      */
     int getNumTickets(Date_t now);
 
+    /**
+     * Returns true if the majority point was lagging beyond the flow control threshold as of the
+     * last ticket refresh.
+     */
+    bool isLagged() const {
+        return _isLagged.load();
+    }
+
     /**
      * This method is called when replication is reserving `opsApplied` timestamps. `timestamp` is
      * the timestamp in the oplog associated with the first oplog time being reserved.
@@ -126,6 +134,8 @@ public:
     std::int64_t _approximateOpsBetween(Timestamp prevTs, Timestamp currTs);
 
     void _updateTopologyData();
+    std::uint64_t _predictLagMillis(std::uint64_t lagMillis);
+    int _smoothTicketsWhileLagged(int calculatedTickets);
     int _calculateNewTicketsForLag(const std::vector<repl::MemberData>& prevMemberData,
                                    const std::vector<repl::MemberData>& currMemberData,
                                    std::int64_t locksUsedLastPeriod,
@@ -153,6 +163,8 @@ private:
     AtomicWord<int> _isLaggedCount{0};
     // Use an int64_t as this is serialized to bson which does not support unsigned 64-bit numbers.
     AtomicWord<std::int64_t> _isLaggedTimeMicros{0};
+    AtomicWord<std::int64_t> _lastLagMillis{0};
+    AtomicWord<std::int64_t> _lastPredictedLagMillis{0};
     AtomicWord<Date_t> _disableUntil;
 
     mutable Mutex _sampledOpsMutex = MONGO_MAKE_LATCH("FlowControl::_sampledOpsMutex");
@@ -169,6 +181,9 @@ private:
 
     Date_t _lastTimeSustainerAdvanced;
 
+    // The commit point lag observed by the previous refresh, used to extrapolate the lag trend.
+    boost::optional<std::uint64_t> _prevLagMillis;
+
     // This value is used for calculating server status metrics.
     std::uint64_t _startWaitTime = 0;
 
@@ -40,6 +40,7 @@
 #include "mongo/db/storage/flow_control_parameters_gen.h"
 #include "mongo/logv2/log_debug.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -266,6 +267,22 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       thresholdLag));
 }
 
+TEST_F(FlowControlTest, PredictingLag) {
+    ON_BLOCK_EXIT([] { gFlowControlLagTrendWeight.store(0.0); });
+
+    // Without a trend weight, the current lag is used as is.
+    ASSERT_EQ(1000U, flowControl->_predictLagMillis(1000));
+    ASSERT_EQ(3000U, flowControl->_predictLagMillis(3000));
+
+    // The lag grew by 1000ms over the last period, so two periods ahead it will be 2000ms higher.
+    gFlowControlLagTrendWeight.store(2.0);
+    ASSERT_EQ(6000U, flowControl->_predictLagMillis(4000));
+
+    // A shrinking lag is predicted to keep shrinking, but not below zero.
+    ASSERT_EQ(2000U, flowControl->_predictLagMillis(3000));
+    ASSERT_EQ(0U, flowControl->_predictLagMillis(1000));
+}
+
 TEST_F(FlowControlTest, DisableUntil) {
     const int ticketOverride = 52319;
 
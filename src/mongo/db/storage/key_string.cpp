@@ -2472,31 +2472,6 @@ RecordId decodeRecordId(BufReader* reader) {
     return RecordId(repr);
 }
 
-int compare(const char* leftBuf, const char* rightBuf, size_t leftSize, size_t rightSize) {
-    // memcmp has undefined behavior if either leftBuf or rightBuf is a null pointer.
-    if (MONGO_unlikely(leftSize == 0))
-        return rightSize == 0 ? 0 : -1;
-    else if (MONGO_unlikely(rightSize == 0))
-        return 1;
-
-    int min = std::min(leftSize, rightSize);
-
-    int cmp = memcmp(leftBuf, rightBuf, min);
-
-    if (cmp) {
-        if (cmp < 0)
-            return -1;
-        return 1;
-    }
-
-    // keys match
-
-    if (leftSize == rightSize)
-        return 0;
-
-    return leftSize < rightSize ? -1 : 1;
-}
-
 int Value::compareWithTypeBits(const Value& other) const {
     return KeyString::compare(getBuffer(), other.getBuffer(), _buffer.size(), other._buffer.size());
 }
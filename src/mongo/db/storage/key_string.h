@@ -854,6 +854,39 @@ public:
     void _reinstantiateBufferIfNeeded() {}
 };
 
+/**
+ * Compares two KeyString buffers byte-wise, returning -1, 0 or 1. This is defined inline because
+ * it is on the hot path of index scans, cursor seeks and the Sorter, where the cost of an
+ * out-of-line call is significant compared to the cost of comparing a short key.
+ */
+inline int compare(const char* leftBuf, const char* rightBuf, size_t leftSize, size_t rightSize) {
+    // memcmp has undefined behavior if either leftBuf or rightBuf is a null pointer.
+    if (MONGO_unlikely(leftSize == 0))
+        return rightSize == 0 ? 0 : -1;
+    else if (MONGO_unlikely(rightSize == 0))
+        return 1;
+
+    int cmp = memcmp(leftBuf, rightBuf, std::min(leftSize, rightSize));
+    if (cmp) {
+        return cmp < 0 ? -1 : 1;
+    }
+
+    // keys match
+    if (leftSize == rightSize)
+        return 0;
+
+    return leftSize < rightSize ? -1 : 1;
+}
+
+/**
+ * Returns true if two KeyString buffers are identical. This is equivalent to, but cheaper than,
+ * compare() == 0: keys of different sizes are never equal, so they are rejected without reading
+ * their contents, which matters for keys sharing a long common prefix.
+ */
+inline bool equal(const char* leftBuf, const char* rightBuf, size_t leftSize, size_t rightSize) {
+    return leftSize == rightSize && (leftSize == 0 || memcmp(leftBuf, rightBuf, leftSize) == 0);
+}
+
 /*
  * The isKeyString struct allows the operators below to only be enabled if the types being operated
  * on are KeyStrings.
@@ -886,7 +919,7 @@ inline typename std::enable_if<isKeyString<T>::value, bool>::type operator<=(con
 template <class T, class U>
 inline typename std::enable_if<isKeyString<T>::value, bool>::type operator==(const T& lhs,
                                                                              const U& rhs) {
-    return lhs.compare(rhs) == 0;
+    return equal(lhs.getBuffer(), rhs.getBuffer(), lhs.getSize(), rhs.getSize());
 }
 
 template <class T, class U>
@@ -954,8 +987,6 @@ size_t sizeWithoutRecordIdAtEnd(const void* bufferRaw, size_t bufSize);
  */
 RecordId decodeRecordId(BufReader* reader);
 
-int compare(const char* leftBuf, const char* rightBuf, size_t leftSize, size_t rightSize);
-
 /**
  * Read one KeyString component from the given 'reader' and 'typeBits' inputs and stream it to the
  * 'valueBuilder' object, which converts it to a "Slot-Based Execution" (SBE) representation. When
@@ -207,6 +207,51 @@ void BM_KeyStringStackBuilderCopy(benchmark::State& state, BsonValueType bsonTyp
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+// Generates keys shaped like those of a compound index on {tenantId, userId, ts} in a
+// multi-tenant deployment, in index order: neighbouring keys share a long tenant prefix and often
+// the user as well.
+std::vector<KeyString::Value> generateSharedPrefixKeys(KeyString::Version version) {
+    std::vector<KeyString::Value> keys;
+    const std::string tenantId(32, 't');
+    for (int i = 0; i < kSampleSize; i++) {
+        const auto userId = "user" + std::to_string(i / 10);
+        KeyString::HeapBuilder builder(version,
+                                       BSON("" << tenantId << "" << userId << ""
+                                               << Timestamp(1000000 + i, 0)),
+                                       ALL_ASCENDING,
+                                       RecordId(i + 1));
+        keys.emplace_back(builder.release());
+    }
+    return keys;
+}
+
+void BM_KeyStringCompareSharedPrefix(benchmark::State& state, const KeyString::Version version) {
+    const auto keys = generateSharedPrefixKeys(version);
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 1; i < keys.size(); i++) {
+            benchmark::DoNotOptimize(keys[i - 1].compare(keys[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (keys.size() - 1));
+}
+
+void BM_KeyStringEqualSharedPrefix(benchmark::State& state, const KeyString::Version version) {
+    const auto keys = generateSharedPrefixKeys(version);
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 1; i < keys.size(); i++) {
+            benchmark::DoNotOptimize(keys[i - 1] == keys[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (keys.size() - 1));
+}
+
+BENCHMARK_CAPTURE(BM_KeyStringCompareSharedPrefix, V0, KeyString::Version::V0);
+BENCHMARK_CAPTURE(BM_KeyStringCompareSharedPrefix, V1, KeyString::Version::V1);
+BENCHMARK_CAPTURE(BM_KeyStringEqualSharedPrefix, V0, KeyString::Version::V0);
+BENCHMARK_CAPTURE(BM_KeyStringEqualSharedPrefix, V1, KeyString::Version::V1);
+
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Decimal, DECIMAL);
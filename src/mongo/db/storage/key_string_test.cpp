@@ -323,6 +323,31 @@ TEST_F(KeyStringBuilderTest, Simple1) {
                      KeyString::Builder(version, b, ALL_ASCENDING, RecordId()));
 }
 
+TEST_F(KeyStringBuilderTest, EqualityAgreesWithCompare) {
+    const std::string tenant(32, 't');
+    std::vector<KeyString::Value> keys;
+    keys.push_back(KeyString::Value());
+    for (int i = 0; i < 4; i++) {
+        keys.push_back(KeyString::HeapBuilder(version,
+                                              BSON("" << tenant << "" << (i / 2) << "" << i),
+                                              ALL_ASCENDING,
+                                              RecordId(i + 1))
+                           .release());
+        // Keys that are a strict prefix of another key.
+        keys.push_back(
+            KeyString::HeapBuilder(version, BSON("" << tenant << "" << (i / 2)), ALL_ASCENDING)
+                .release());
+    }
+
+    for (auto&& left : keys) {
+        for (auto&& right : keys) {
+            ASSERT_EQ(left.compare(right) == 0, left == right);
+            ASSERT_EQ(left.compare(right) != 0, left != right);
+            ASSERT_EQ(-left.compare(right), right.compare(left));
+        }
+    }
+}
+
 #define ROUNDTRIP_ORDER(version, x, order)                            \
     do {                                                              \
         const BSONObj _orig = x;                                      \
@@ -33,6 +33,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "mongo/base/status.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/timestamp.h"
@@ -291,6 +293,14 @@ public:
 
     virtual void checkpoint() {}
 
+    /**
+     * Returns the number of bytes of modified data held in the storage engine's cache, which the
+     * next checkpoint must write, or boost::none if the engine does not track it.
+     */
+    virtual boost::optional<int64_t> getCacheDirtyBytes() const {
+        return boost::none;
+    }
+
     virtual bool isDurable() const = 0;
 
     /**
@@ -30,9 +30,11 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/record_id.h"
@@ -60,6 +62,51 @@ struct Record {
     RecordData data;
 };
 
+/**
+ * A caller-owned buffer of Records filled by RecordCursor::nextBatch().
+ *
+ * The data of every appended Record is copied into a single arena which is reused across batches,
+ * so filling a batch does not allocate once the arena has grown to the working size. Records handed
+ * out by operator[] point into the arena and are only valid until the next call to clear() or
+ * append().
+ */
+class RecordBatch {
+public:
+    void clear() {
+        _arena.reset();
+        _entries.clear();
+    }
+
+    void append(const RecordId& id, const RecordData& data) {
+        _entries.push_back({id, _arena.len(), data.size()});
+        _arena.appendBuf(data.data(), data.size());
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    bool empty() const {
+        return _entries.empty();
+    }
+
+    Record operator[](size_t i) const {
+        const auto& entry = _entries[i];
+        return {entry.id, RecordData(_arena.buf() + entry.offset, entry.size)};
+    }
+
+private:
+    struct Entry {
+        RecordId id;
+        int offset;
+        int size;
+    };
+
+    // Offsets rather than pointers are stored since appending may reallocate the arena.
+    BufBuilder _arena;
+    std::vector<Entry> _entries;
+};
+
 /**
  * Retrieves Records from a RecordStore.
  *
@@ -111,6 +158,35 @@ public:
      */
     virtual boost::optional<Record> next() = 0;
 
+    /**
+     * Clears 'batch' and fills it with up to 'maxRecords' Records by repeatedly moving forward, as
+     * if by calling next(). Returns the number of Records added; fewer than 'maxRecords' means the
+     * cursor reached EOF. The cursor is left positioned on the last Record in the batch, so a
+     * save()/restore() cycle resumes after the batch rather than after the Record the caller last
+     * consumed from it.
+     *
+     * If next() throws a WriteConflictException part way through, the Records already in 'batch'
+     * remain valid and the cursor is positioned on the last of them.
+     */
+    virtual size_t nextBatch(RecordBatch* batch, size_t maxRecords) {
+        batch->clear();
+        while (batch->size() < maxRecords) {
+            auto record = next();
+            if (!record) {
+                break;
+            }
+            batch->append(record->id, record->data);
+        }
+        return batch->size();
+    }
+
+    /**
+     * Hints that the caller intends to iterate through a large part of the collection in order,
+     * so the storage engine may start reading records ahead of the cursor's position. This is only
+     * a performance hint and storage engines are free to ignore it.
+     */
+    virtual void setReadAhead(bool readAhead) {}
+
     //
     // Saving and restoring state
     //
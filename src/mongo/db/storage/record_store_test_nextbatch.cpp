@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#pragma once
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/record_store_test_harness.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_data.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+using std::string;
+using std::unique_ptr;
+
+const int kNumRecords = 10;
+
+/**
+ * Inserts 'kNumRecords' small records into 'rs' and returns their RecordIds and data, sorted by
+ * RecordId.
+ */
+std::vector<std::pair<RecordId, string>> insertRecords(RecordStoreHarnessHelper* harnessHelper,
+                                                       RecordStore* rs) {
+    std::vector<std::pair<RecordId, string>> inserted;
+    for (int i = 0; i < kNumRecords; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        string data = str::stream() << "record " << i;
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        uow.commit();
+        inserted.emplace_back(res.getValue(), data);
+    }
+    std::sort(inserted.begin(), inserted.end());
+    return inserted;
+}
+
+// A forward cursor fills batches in RecordId order, returns a short batch at the end of the
+// collection and empty batches after that.
+TEST(RecordStoreTestHarness, NextBatchForward) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    const auto inserted = insertRecords(harnessHelper.get(), rs.get());
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getCursor(opCtx.get());
+    RecordBatch batch;
+    size_t seen = 0;
+    for (size_t expected : {4, 4, 2}) {
+        ASSERT_EQ(expected, cursor->nextBatch(&batch, 4));
+        ASSERT_EQ(expected, batch.size());
+        for (size_t i = 0; i < batch.size(); ++i, ++seen) {
+            ASSERT_EQ(inserted[seen].first, batch[i].id);
+            ASSERT_EQ(inserted[seen].second, batch[i].data.data());
+        }
+    }
+    ASSERT_EQ(0U, cursor->nextBatch(&batch, 4));
+    ASSERT(batch.empty());
+    ASSERT(!cursor->next());
+}
+
+// A reverse cursor fills batches in descending RecordId order.
+TEST(RecordStoreTestHarness, NextBatchReversed) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    const auto inserted = insertRecords(harnessHelper.get(), rs.get());
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getCursor(opCtx.get(), false /* forward */);
+    RecordBatch batch;
+    ASSERT_EQ(static_cast<size_t>(kNumRecords), cursor->nextBatch(&batch, kNumRecords + 1));
+    for (size_t i = 0; i < batch.size(); ++i) {
+        ASSERT_EQ(inserted[kNumRecords - 1 - i].first, batch[i].id);
+        ASSERT_EQ(inserted[kNumRecords - 1 - i].second, batch[i].data.data());
+    }
+}
+
+// Records in a batch own their data, so they stay valid across a save and restore of the cursor,
+// and the cursor resumes after the last record of the batch.
+TEST(RecordStoreTestHarness, NextBatchSurvivesSaveRestore) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    const auto inserted = insertRecords(harnessHelper.get(), rs.get());
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getCursor(opCtx.get());
+    RecordBatch batch;
+    ASSERT_EQ(3U, cursor->nextBatch(&batch, 3));
+
+    cursor->save();
+    opCtx->recoveryUnit()->abandonSnapshot();
+    ASSERT(cursor->restore());
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        ASSERT_EQ(inserted[i].first, batch[i].id);
+        ASSERT_EQ(inserted[i].second, batch[i].data.data());
+    }
+
+    // Interleaving next() and nextBatch() on the same cursor.
+    auto record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQ(inserted[3].first, record->id);
+    ASSERT_EQ(static_cast<size_t>(kNumRecords - 4), cursor->nextBatch(&batch, kNumRecords));
+    ASSERT_EQ(inserted[4].first, batch[0].id);
+    ASSERT_EQ(inserted[kNumRecords - 1].first, batch[batch.size() - 1].id);
+}
+
+}  // namespace
+}  // namespace mongo
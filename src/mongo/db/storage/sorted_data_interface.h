@@ -251,6 +251,13 @@ public:
          */
         virtual void setEndPosition(const BSONObj& key, bool inclusive) = 0;
 
+        /**
+         * Hints that the caller intends to iterate through a large range of the index in order, so
+         * the storage engine may start reading keys ahead of the cursor's position. This is only a
+         * performance hint and storage engines are free to ignore it.
+         */
+        virtual void setReadAhead(bool readAhead) {}
+
         /**
          * Moves forward and returns the new data or boost::none if there is no more data.
          * If not positioned, returns boost::none.
@@ -285,9 +285,11 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs);
-        auto maxPrefixForCollection = _catalog->getMetaData(opCtx, entry.catalogId).getMaxPrefix();
-        maxSeenPrefix = std::max(maxSeenPrefix, maxPrefixForCollection);
+        // Read the catalog metadata once and share it with '_initCollection'. With a large number
+        // of collections the repeated catalog lookups dominate startup time.
+        const auto md = _catalog->getMetaData(opCtx, entry.catalogId);
+        _initCollection(opCtx, entry.catalogId, entry.nss, md, _options.forRepair, minVisibleTs);
+        maxSeenPrefix = std::max(maxSeenPrefix, md.getMaxPrefix());
 
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248,
@@ -304,9 +306,9 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
 void StorageEngineImpl::_initCollection(OperationContext* opCtx,
                                         RecordId catalogId,
                                         const NamespaceString& nss,
+                                        const BSONCollectionCatalogEntry::MetaData& md,
                                         bool forRepair,
                                         Timestamp minVisibleTs) {
-    BSONCollectionCatalogEntry::MetaData md = _catalog->getMetaData(opCtx, catalogId);
     uassert(ErrorCodes::MustDowngrade,
             str::stream() << "Collection does not have UUID in KVCatalog. Collection: " << nss,
             md.options.uuid);
@@ -323,7 +325,7 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
         invariant(rs);
     }
 
-    auto uuid = _catalog->getCollectionOptions(opCtx, catalogId).uuid.get();
+    auto uuid = md.options.uuid.get();
 
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, uuid, std::move(rs));
@@ -909,7 +911,8 @@ Status StorageEngineImpl::repairRecordStore(OperationContext* opCtx,
 
     // When repairing a record store, keep the existing behavior of not installing a minimum visible
     // timestamp.
-    _initCollection(opCtx, catalogId, nss, false, Timestamp::min());
+    _initCollection(
+        opCtx, catalogId, nss, _catalog->getMetaData(opCtx, catalogId), false, Timestamp::min());
 
     return status;
 }
@@ -375,6 +375,7 @@ private:
     void _initCollection(OperationContext* opCtx,
                          RecordId catalogId,
                          const NamespaceString& nss,
+                         const BSONCollectionCatalogEntry::MetaData& md,
                          bool forRepair,
                          Timestamp minVisibleTs);
 
@@ -51,8 +51,11 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor_helpers.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_prefetcher.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_unique_index_key_filter.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
@@ -670,11 +673,13 @@ public:
     UniqueBulkBuilder(WiredTigerIndex* idx,
                       OperationContext* opCtx,
                       bool dupsAllowed,
-                      KVPrefix prefix)
+                      KVPrefix prefix,
+                      std::shared_ptr<WiredTigerUniqueIndexKeyFilter> keyFilter)
         : BulkBuilder(idx, opCtx, prefix),
           _idx(idx),
           _dupsAllowed(dupsAllowed),
-          _previousKeyString(idx->getKeyStringVersion()) {
+          _previousKeyString(idx->getKeyStringVersion()),
+          _keyFilter(std::move(keyFilter)) {
         invariant(!_idx->isIdIndex());
     }
 
@@ -704,6 +709,12 @@ public:
             }
         }
 
+        if (_keyFilter) {
+            _keyFilter->add(newKeyString.getBuffer(),
+                            KeyString::sizeWithoutRecordIdAtEnd(newKeyString.getBuffer(),
+                                                                newKeyString.getSize()));
+        }
+
         // Can't use WiredTigerCursor since we aren't using the cache.
         WiredTigerItem keyItem(newKeyString.getBuffer(), newKeyString.getSize());
         setKey(_cursor, keyItem.Get());
@@ -731,6 +742,7 @@ private:
     WiredTigerIndex* _idx;
     const bool _dupsAllowed;
     KeyString::Builder _previousKeyString;
+    const std::shared_ptr<WiredTigerUniqueIndexKeyFilter> _keyFilter;
 };
 
 class WiredTigerIndex::IdBulkBuilder : public BulkBuilder {
@@ -850,6 +862,10 @@ public:
         _endPosition->resetToKey(BSONObj::stripFieldNames(key), _idx.getOrdering(), discriminator);
     }
 
+    void setReadAhead(bool readAhead) override {
+        _readAhead = readAhead;
+    }
+
     boost::optional<IndexKeyEntry> seek(const KeyString::Value& keyString,
                                         RequestedInfo parts = kKeyAndLoc) override {
         seekForKeyString(keyString);
@@ -1189,9 +1205,45 @@ protected:
             advanceWTCursor();
         }
         updatePosition(true);
+        if (_readAhead && _forward && !_eof) {
+            readAheadFromCurrentKey();
+        }
         return true;
     }
 
+    /**
+     * Schedules the next read-ahead window from the current key once the scan has consumed the
+     * previous window's lead. Each window reads twice as far as the scan goes before scheduling the
+     * next one, so the second half of every window is still ahead of the scan at that point.
+     */
+    void readAheadFromCurrentKey() {
+        const size_t numEntries = WiredTigerPrefetcher::entriesPerWindow();
+        auto engine = WiredTigerRecoveryUnit::get(_opCtx)->getSessionCache()->getKVEngine();
+        auto prefetcher = engine ? engine->getPrefetcher() : nullptr;
+        if (numEntries == 0 || !prefetcher) {
+            return;
+        }
+
+        // Scans that end within their first window, such as point lookups, never read ahead.
+        if (++_entriesSinceReadAhead < numEntries) {
+            return;
+        }
+        _entriesSinceReadAhead = 0;
+
+        // The key setter outlives this cursor, so it keeps its own copy of the key.
+        auto setKey = [key = std::string(_key.getBuffer(), _key.getSize()),
+                       prefix = _prefix](WT_CURSOR* cursor) {
+            const WiredTigerItem item(key.data(), key.size());
+            if (prefix == KVPrefix::kNotPrefixed) {
+                cursor->set_key(cursor, item.Get());
+            } else {
+                cursor->set_key(cursor, prefix.repr(), item.Get());
+            }
+        };
+        _readAheadWindow =
+            prefetcher->readAhead(_readAheadWindow, _idx.uri(), std::move(setKey), 2 * numEntries);
+    }
+
     KeyStringEntry getKeyStringEntry() {
         // Most keys will have a RecordId appended to the end, with the exception of the _id index
         // and timestamp unsafe unique indexes. The contract of this function is to always return a
@@ -1244,6 +1296,10 @@ protected:
     KVPrefix _prefix;
 
     std::unique_ptr<KeyString::Builder> _endPosition;
+
+    bool _readAhead = false;
+    std::shared_ptr<WiredTigerPrefetcher::Window> _readAheadWindow;
+    size_t _entriesSinceReadAhead = 0;
 };
 
 // The Standard Cursor doesn't need anything more than the base has.
@@ -1391,6 +1447,21 @@ WiredTigerIndexUnique::WiredTigerIndexUnique(OperationContext* ctx,
     invariant(!isIdIndex());
     // All unique indexes should be in the timestamp-safe format version as of version 4.2.
     invariant(isTimestampSafeUniqueIdx());
+
+    // Grouped collections share a table between several indexes, whose keys the filter could not
+    // tell apart.
+    if (!isReadOnly && prefix == KVPrefix::kNotPrefixed) {
+        auto engine = WiredTigerRecoveryUnit::get(ctx)->getSessionCache()->getKVEngine();
+        if (auto builder = engine ? engine->getUniqueIndexKeyFilterBuilder() : nullptr) {
+            _keyFilter = builder->makeFilter(uri);
+        }
+    }
+}
+
+WiredTigerIndexUnique::~WiredTigerIndexUnique() {
+    if (_keyFilter) {
+        _keyFilter->abandon();
+    }
 }
 
 std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
@@ -1400,7 +1471,7 @@ std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
 
 std::unique_ptr<SortedDataBuilderInterface> WiredTigerIndexUnique::makeBulkBuilder(
     OperationContext* opCtx, bool dupsAllowed) {
-    return std::make_unique<UniqueBulkBuilder>(this, opCtx, dupsAllowed, _prefix);
+    return std::make_unique<UniqueBulkBuilder>(this, opCtx, dupsAllowed, _prefix, _keyFilter);
 }
 
 bool WiredTigerIndexUnique::isTimestampSafeUniqueIdx() const {
@@ -1458,9 +1529,21 @@ bool WiredTigerIndexUnique::_keyExists(OperationContext* opCtx,
     return std::memcmp(buffer, item.data, std::min(size, item.size)) == 0;
 }
 
+void WiredTigerIndexUnique::_recordSkippedSeek(OperationContext* opCtx) const {
+    auto engine = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getKVEngine();
+    if (auto builder = engine ? engine->getUniqueIndexKeyFilterBuilder() : nullptr) {
+        builder->recordSkippedSeek();
+    }
+}
+
 bool WiredTigerIndexUnique::isDup(OperationContext* opCtx,
                                   WT_CURSOR* c,
                                   const KeyString::Value& prefixKey) {
+    if (_keyFilter && !_keyFilter->mayContain(prefixKey.getBuffer(), prefixKey.getSize())) {
+        _recordSkippedSeek(opCtx);
+        return false;
+    }
+
     // This procedure to determine duplicates is exclusive for timestamp safe unique indexes.
     // Check if a prefix key already exists in the index. When keyExists() returns true, the cursor
     // will be positioned on the first occurence of the 'prefixKey'.
@@ -1546,12 +1629,13 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
 
     int ret;
 
+    // A prefix key is KeyString of index key. It is the component of the index entry that should
+    // be unique.
+    auto sizeWithoutRecordId =
+        KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(), keyString.getSize());
+
     // Pre-checks before inserting on a primary.
     if (!dupsAllowed) {
-        // A prefix key is KeyString of index key. It is the component of the index entry that
-        // should be unique.
-        auto sizeWithoutRecordId =
-            KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(), keyString.getSize());
         WiredTigerItem prefixKeyItem(keyString.getBuffer(), sizeWithoutRecordId);
 
         // First phase inserts the prefix key to prohibit concurrent insertions of same key
@@ -1579,8 +1663,17 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
         ret = WT_OP_CHECK(wiredTigerCursorRemove(opCtx, c));
         invariantWTOK(ret);
 
+        // Only add the key to the filter after the first phase. If a concurrent insert of the same
+        // key has not reached the filter yet, one of the two first phases is then guaranteed to
+        // conflict with the other.
+        const bool keyIsNew =
+            _keyFilter && _keyFilter->add(keyString.getBuffer(), sizeWithoutRecordId);
+        if (keyIsNew) {
+            _recordSkippedSeek(opCtx);
+        }
+
         // Second phase looks up for existence of key to avoid insertion of duplicate key
-        if (_keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
+        if (!keyIsNew && _keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
             auto key = KeyString::toBson(
                 keyString.getBuffer(), sizeWithoutRecordId, _ordering, keyString.getTypeBits());
             auto entry = _desc->getEntry();
@@ -1591,6 +1684,8 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
                                           _keyPattern,
                                           _collation);
         }
+    } else if (_keyFilter) {
+        _keyFilter->add(keyString.getBuffer(), sizeWithoutRecordId);
     }
 
     // Now create the table key/value, the actual data record.
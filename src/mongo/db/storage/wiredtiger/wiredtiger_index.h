@@ -43,6 +43,7 @@ namespace mongo {
 
 class IndexCatalogEntry;
 class IndexDescriptor;
+class WiredTigerUniqueIndexKeyFilter;
 struct WiredTigerItem;
 
 class WiredTigerIndex : public SortedDataInterface {
@@ -205,6 +206,8 @@ public:
                           KVPrefix prefix,
                           bool readOnly = false);
 
+    ~WiredTigerIndexUnique();
+
     std::unique_ptr<SortedDataInterface::Cursor> newCursor(OperationContext* opCtx,
                                                            bool forward) const override;
 
@@ -236,7 +239,12 @@ private:
      */
     bool _keyExists(OperationContext* opCtx, WT_CURSOR* c, const char* buffer, size_t size);
 
+    void _recordSkippedSeek(OperationContext* opCtx) const;
+
     bool _partial;
+
+    // Filters out keys that are definitely not in the index. Only set when key filters are enabled.
+    std::shared_ptr<WiredTigerUniqueIndexKeyFilter> _keyFilter;
 };
 
 class WiredTigerIdIndex : public WiredTigerIndex {
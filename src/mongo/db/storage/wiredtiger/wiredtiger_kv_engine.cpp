@@ -82,10 +82,14 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_prefetcher.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_compressor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_adjuster.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_unique_index_key_filter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/background.h"
@@ -506,10 +510,21 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     }
 
     _sessionCache.reset(new WiredTigerSessionCache(this));
+    _prefetcher = std::make_unique<WiredTigerPrefetcher>(_sessionCache.get(),
+                                                         gWiredTigerCursorReadAheadThreads);
 
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    _ticketAdjuster = std::make_unique<WiredTigerTicketAdjuster>(
+        _sessionCache.get(), &openReadTransaction, &openWriteTransaction);
+    _ticketAdjuster->go();
+
+    if (!_readOnly && gWiredTigerUniqueIndexKeyFilterSizeKB > 0) {
+        _uniqueIndexKeyFilterBuilder = std::make_unique<WiredTigerUniqueIndexKeyFilterBuilder>(
+            _sessionCache.get(), static_cast<size_t>(gWiredTigerUniqueIndexKeyFilterSizeKB) * 1024);
+    }
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -593,6 +608,9 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        bbb.append("queued", openWriteTransaction.queued());
+        bbb.append("totalQueued", openWriteTransaction.totalQueued());
+        bbb.append("totalTimeQueuedMicros", openWriteTransaction.totalTimeQueuedMicros());
         bbb.done();
     }
     {
@@ -600,6 +618,9 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        bbb.append("queued", openReadTransaction.queued());
+        bbb.append("totalQueued", openReadTransaction.totalQueued());
+        bbb.append("totalTimeQueuedMicros", openReadTransaction.totalTimeQueuedMicros());
         bbb.done();
     }
     bb.done();
@@ -712,6 +733,15 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_ticketAdjuster) {
+        _ticketAdjuster->shutdown();
+    }
+    if (_prefetcher) {
+        _prefetcher->shutdown();
+    }
+    if (_uniqueIndexKeyFilterBuilder) {
+        _uniqueIndexKeyFilterBuilder->shutdown();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps.",
@@ -1473,6 +1503,14 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.sizeStorer = _sizeStorer.get();
     params.isReadOnly = _readOnly;
     params.tracksSizeAdjustments = true;
+    BSONElement dictionary = options.storageEngine.getObjectField(_canonicalName)
+                                 .getField(WiredTigerRecordCompressor::kDictionaryFieldName);
+    if (dictionary.isBinData(BinDataGeneral)) {
+        int length;
+        const char* data = dictionary.binData(length);
+        params.recordCompressor =
+            std::make_shared<WiredTigerRecordCompressor>(ConstDataRange(data, length));
+    }
 
     params.cappedMaxSize = -1;
     if (options.capped) {
@@ -1732,9 +1770,16 @@ bool WiredTigerKVEngine::haveDropsQueued() const {
     Date_t now = _clockSource->now();
     Milliseconds delta = now - _previousCheckedDropsQueued;
 
-    if (!_readOnly && _sizeStorerSyncTracker.intervalHasElapsed()) {
+    // Once a periodic flush has started, keep writing the queued changes a batch at a time until
+    // they are all written.
+    if (!_readOnly && _sizeStorer &&
+        (_sizeStorerSyncTracker.intervalHasElapsed() || _sizeStorer->hasQueuedChanges())) {
         _sizeStorerSyncTracker.resetLastTime();
-        syncSizeInfo(false);
+        try {
+            _sizeStorer->flushIncremental();
+        } catch (const WriteConflictException&) {
+            // ignore, we'll try again later.
+        }
     }
 
     // We only want to check the queue max once per second or we'll thrash
@@ -1865,6 +1910,18 @@ void WiredTigerKVEngine::checkpoint() {
     }
 }
 
+boost::optional<int64_t> WiredTigerKVEngine::getCacheDirtyBytes() const {
+    auto session = _sessionCache->getSession();
+    auto result = WiredTigerUtil::getStatisticsValue(session->getSession(),
+                                                     "statistics:",
+                                                     "statistics=(fast)",
+                                                     WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    if (!result.isOK()) {
+        return boost::none;
+    }
+    return result.getValue();
+}
+
 bool WiredTigerKVEngine::hasIdent(OperationContext* opCtx, StringData ident) const {
     return _hasUri(WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession(), _uri(ident));
 }
@@ -52,9 +52,12 @@ namespace mongo {
 
 class ClockSource;
 class JournalListener;
+class WiredTigerPrefetcher;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
+class WiredTigerTicketAdjuster;
+class WiredTigerUniqueIndexKeyFilterBuilder;
 class WiredTigerEngineRuntimeConfigParameter;
 
 struct WiredTigerFileVersion {
@@ -119,6 +122,8 @@ public:
 
     void checkpoint() override;
 
+    boost::optional<int64_t> getCacheDirtyBytes() const override;
+
     bool isDurable() const override {
         return _durable;
     }
@@ -245,6 +250,21 @@ public:
         return &_sessionCache->snapshotManager();
     }
 
+    WiredTigerPrefetcher* getPrefetcher() const {
+        return _prefetcher.get();
+    }
+
+    WiredTigerTicketAdjuster* getTicketAdjuster() const {
+        return _ticketAdjuster.get();
+    }
+
+    /**
+     * Returns nullptr if unique index key filters are disabled.
+     */
+    WiredTigerUniqueIndexKeyFilterBuilder* getUniqueIndexKeyFilterBuilder() const {
+        return _uniqueIndexKeyFilterBuilder.get();
+    }
+
     void setJournalListener(JournalListener* jl) final;
 
     void setStableTimestamp(Timestamp stableTimestamp, bool force) override;
@@ -452,6 +472,7 @@ private:
     WiredTigerFileVersion _fileVersion;
     WiredTigerEventHandler _eventHandler;
     std::unique_ptr<WiredTigerSessionCache> _sessionCache;
+    std::unique_ptr<WiredTigerPrefetcher> _prefetcher;
     ClockSource* const _clockSource;
 
     // Mutex to protect use of _oplogRecordStore by this instance of KV engine.
@@ -480,6 +501,8 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerTicketAdjuster> _ticketAdjuster;
+    std::unique_ptr<WiredTigerUniqueIndexKeyFilterBuilder> _uniqueIndexKeyFilterBuilder;
 
     std::string _rsOptions;
     std::string _indexOptions;
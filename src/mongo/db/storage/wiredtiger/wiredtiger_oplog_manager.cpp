@@ -150,6 +150,12 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     invariant(_opsWaitingForOplogVisibilityUpdate > 0);
     auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
 
+    // If an update is already pending, the visibility thread may be delaying it to batch more
+    // requests. It only rechecks for waiters once a millisecond, so wake it up right away.
+    if (_triggerOplogVisibilityUpdate) {
+        _oplogVisibilityThreadCV.notify_one();
+    }
+
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
     // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
     // wait until all of the writes behind and including 'waitingFor' commit so there are no oplog
@@ -0,0 +1,164 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_prefetcher.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+ThreadPool::Options makePoolOptions(size_t numThreads) {
+    ThreadPool::Options options;
+    options.poolName = "WiredTigerPrefetcher";
+    options.threadNamePrefix = "WTReadAhead-";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    return options;
+}
+
+}  // namespace
+
+WiredTigerPrefetcher::WiredTigerPrefetcher(WiredTigerSessionCache* sessionCache,
+                                           size_t numThreads)
+    : _sessionCache(sessionCache), _pool(makePoolOptions(numThreads)) {
+    _pool.startup();
+}
+
+WiredTigerPrefetcher::~WiredTigerPrefetcher() {
+    shutdown();
+}
+
+size_t WiredTigerPrefetcher::entriesPerWindow() {
+    return static_cast<size_t>(gWiredTigerCursorReadAheadEntries.load());
+}
+
+std::shared_ptr<WiredTigerPrefetcher::Window> WiredTigerPrefetcher::readAhead(
+    const std::shared_ptr<Window>& previous,
+    const std::string& uri,
+    KeySetter setKey,
+    size_t numEntries) {
+    if (previous) {
+        if (!previous->isDone()) {
+            _misses.fetchAndAdd(1);
+            return previous;
+        }
+        _hits.fetchAndAdd(1);
+    }
+
+    if (_shuttingDown.load() || _pending.fetchAndAdd(1) >= kMaxPendingWindows) {
+        _pending.fetchAndSubtract(1);
+        _windowsDropped.fetchAndAdd(1);
+        return nullptr;
+    }
+
+    auto window = std::make_shared<Window>();
+    _windowsScheduled.fetchAndAdd(1);
+    _pool.schedule([this, window, uri, setKey = std::move(setKey), numEntries](Status status) {
+        ON_BLOCK_EXIT([&] {
+            window->_done.store(true);
+            _pending.fetchAndSubtract(1);
+        });
+        if (!status.isOK()) {
+            // The pool is shutting down and is draining its queue without running the tasks.
+            return;
+        }
+        _readWindow(uri, setKey, numEntries);
+    });
+    return window;
+}
+
+void WiredTigerPrefetcher::_readWindow(const std::string& uri,
+                                       const KeySetter& setKey,
+                                       size_t numEntries) {
+    if (_shuttingDown.load()) {
+        return;
+    }
+
+    auto session = _sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+
+    // Cursors are opened directly rather than through the session's cursor cache, because the
+    // table may have been dropped since the window was scheduled and that must not be fatal here.
+    WT_CURSOR* c = nullptr;
+    if (s->open_cursor(s, uri.c_str(), nullptr, nullptr, &c) != 0) {
+        return;
+    }
+    ON_BLOCK_EXIT([&] { c->close(c); });
+
+    setKey(c);
+    int cmp;
+    if (c->search_near(c, &cmp) != 0) {
+        return;
+    }
+
+    long long entriesRead = 0;
+    ON_BLOCK_EXIT([&] { _entriesRead.fetchAndAdd(entriesRead); });
+
+    // Reading the value is what brings the leaf page into the cache. Any error, including a
+    // prepare conflict, ends the window: the scan will find out about it on its own.
+    WT_ITEM value;
+    while (static_cast<size_t>(entriesRead) < numEntries && !_shuttingDown.load()) {
+        if (c->get_value(c, &value) != 0) {
+            return;
+        }
+        ++entriesRead;
+        if (c->next(c) != 0) {
+            return;
+        }
+    }
+}
+
+void WiredTigerPrefetcher::shutdown() {
+    if (_shuttingDown.swap(true)) {
+        return;
+    }
+    LOGV2(5698000, "Shutting down WiredTiger read-ahead threads");
+    _pool.shutdown();
+    _pool.join();
+}
+
+void WiredTigerPrefetcher::appendStats(BSONObjBuilder* builder) const {
+    builder->append("windows scheduled", _windowsScheduled.load());
+    builder->append("windows dropped", _windowsDropped.load());
+    builder->append("hits", _hits.load());
+    builder->append("misses", _misses.load());
+    builder->append("entries read", _entriesRead.load());
+}
+
+}  // namespace mongo
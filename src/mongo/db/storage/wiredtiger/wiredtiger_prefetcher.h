@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <wiredtiger.h>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class WiredTigerSessionCache;
+
+/**
+ * Reads ranges of a WiredTiger table on background threads ahead of a forward scan, so that the
+ * pages the scan is about to visit are already in the WiredTiger cache by the time it gets there.
+ * WiredTiger has no prefetch interface of its own, so a "window" of read-ahead is simply a second
+ * cursor, on a session from the session cache, that walks the next entries in key order and
+ * discards them.
+ *
+ * Scans drive the prefetcher by calling readAhead() periodically, passing back the window returned
+ * by the previous call. Read-ahead is best effort: any error while reading a window, including
+ * the table having been dropped, ends that window early without being reported to the scan.
+ */
+class WiredTigerPrefetcher {
+    WiredTigerPrefetcher(const WiredTigerPrefetcher&) = delete;
+    WiredTigerPrefetcher& operator=(const WiredTigerPrefetcher&) = delete;
+
+public:
+    /**
+     * Positions a read-ahead cursor at the start of a window by setting its search key. Must not
+     * refer to the scan's cursor or its table objects, which may be destroyed before the window
+     * runs.
+     */
+    using KeySetter = std::function<void(WT_CURSOR*)>;
+
+    /**
+     * A range of entries being read in the background.
+     */
+    class Window {
+    public:
+        bool isDone() const {
+            return _done.load();
+        }
+
+    private:
+        friend class WiredTigerPrefetcher;
+
+        AtomicWord<bool> _done{false};
+    };
+
+    WiredTigerPrefetcher(WiredTigerSessionCache* sessionCache, size_t numThreads);
+    ~WiredTigerPrefetcher();
+
+    /**
+     * Returns the number of entries a scan should read ahead by, or 0 if read-ahead is disabled.
+     */
+    static size_t entriesPerWindow();
+
+    /**
+     * Schedules a window reading 'numEntries' entries of the table 'uri' forward from the key set
+     * by 'setKey', and returns it. If 'previous' is still being read, the scan has caught up with
+     * it, so it is recorded as a miss and returned instead of scheduling a new window. Returns
+     * nullptr if the window could not be scheduled, in which case the scan should try again later.
+     */
+    std::shared_ptr<Window> readAhead(const std::shared_ptr<Window>& previous,
+                                      const std::string& uri,
+                                      KeySetter setKey,
+                                      size_t numEntries);
+
+    /**
+     * Stops scheduling new windows, ends the ones in progress and waits for the background threads
+     * to exit. Must be called before the session cache shuts down.
+     */
+    void shutdown();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    void _readWindow(const std::string& uri, const KeySetter& setKey, size_t numEntries);
+
+    // Upper bound on the number of windows that have been scheduled but not yet finished, to keep
+    // a burst of scans from queueing more read-ahead than the threads could ever get through.
+    static constexpr long long kMaxPendingWindows = 64;
+
+    WiredTigerSessionCache* const _sessionCache;  // not owned
+    ThreadPool _pool;
+
+    AtomicWord<bool> _shuttingDown{false};
+    AtomicWord<long long> _pending{0};
+
+    AtomicWord<long long> _windowsScheduled{0};
+    AtomicWord<long long> _windowsDropped{0};
+    AtomicWord<long long> _hits{0};
+    AtomicWord<long long> _misses{0};
+    AtomicWord<long long> _entriesRead{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_compressor.h"
+
+#include <numeric>
+#include <zdict.h>
+#include <zstd.h>
+
+#include "mongo/base/data_view.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+namespace {
+
+// Records are small, so favor speed over ratio: the dictionary does most of the work.
+const int kCompressionLevel = 3;
+
+// Compression and decompression contexts are expensive to create and hold no state between calls,
+// so each thread reuses its own.
+struct ZstdContexts {
+    ZstdContexts() : cctx(ZSTD_createCCtx()), dctx(ZSTD_createDCtx()) {
+        invariant(cctx && dctx);
+    }
+    ~ZstdContexts() {
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+
+    ZSTD_CCtx* cctx;
+    ZSTD_DCtx* dctx;
+};
+
+ZstdContexts& getContexts() {
+    thread_local ZstdContexts contexts;
+    return contexts;
+}
+
+}  // namespace
+
+StatusWith<std::string> WiredTigerRecordCompressor::trainDictionary(
+    const std::vector<std::string>& samples, size_t maxDictionaryBytes) {
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    std::string concatenated;
+    for (auto&& sample : samples) {
+        sampleSizes.push_back(sample.size());
+        concatenated.append(sample);
+    }
+
+    std::string dictionary(maxDictionaryBytes, '\0');
+    size_t ret = ZDICT_trainFromBuffer(&dictionary[0],
+                                       dictionary.size(),
+                                       concatenated.data(),
+                                       sampleSizes.data(),
+                                       static_cast<unsigned>(sampleSizes.size()));
+    if (ZDICT_isError(ret)) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "Failed to train a compression dictionary from " << samples.size()
+                              << " samples: " << ZDICT_getErrorName(ret)};
+    }
+    dictionary.resize(ret);
+    return dictionary;
+}
+
+Status WiredTigerRecordCompressor::validateDictionary(ConstDataRange dictionary) {
+    if (ZDICT_getDictID(dictionary.data(), dictionary.length()) == 0) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "'" << kDictionaryFieldName
+                              << "' is not a valid compression dictionary"};
+    }
+    return Status::OK();
+}
+
+bool WiredTigerRecordCompressor::isCompressed(const char* data, size_t size) {
+    return size >= sizeof(uint32_t) &&
+        ConstDataView(data).read<LittleEndian<uint32_t>>() == ZSTD_MAGICNUMBER;
+}
+
+size_t WiredTigerRecordCompressor::uncompressedSize(const char* data, size_t size) {
+    auto contentSize = ZSTD_getFrameContentSize(data, size);
+    invariant(contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize != ZSTD_CONTENTSIZE_ERROR);
+    return contentSize;
+}
+
+WiredTigerRecordCompressor::WiredTigerRecordCompressor(ConstDataRange dictionary)
+    : _dictionaryId(ZDICT_getDictID(dictionary.data(), dictionary.length())),
+      _cdict(ZSTD_createCDict(dictionary.data(), dictionary.length(), kCompressionLevel)),
+      _ddict(ZSTD_createDDict(dictionary.data(), dictionary.length())) {
+    invariant(_dictionaryId != 0);
+    invariant(_cdict && _ddict);
+}
+
+WiredTigerRecordCompressor::~WiredTigerRecordCompressor() {
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+bool WiredTigerRecordCompressor::compress(const char* data, size_t size, std::string* out) const {
+    out->resize(ZSTD_compressBound(size));
+    size_t ret =
+        ZSTD_compress_usingCDict(getContexts().cctx, &(*out)[0], out->size(), data, size, _cdict);
+    invariant(!ZSTD_isError(ret), ZSTD_getErrorName(ret));
+    if (ret >= size) {
+        return false;
+    }
+    out->resize(ret);
+    return true;
+}
+
+RecordData WiredTigerRecordCompressor::decompress(const char* data, size_t size) const {
+    const size_t originalSize = uncompressedSize(data, size);
+    auto buffer = SharedBuffer::allocate(originalSize);
+    size_t ret = ZSTD_decompress_usingDDict(
+        getContexts().dctx, buffer.get(), originalSize, data, size, _ddict);
+    uassert(5698004,
+            str::stream() << "Failed to decompress a record: " << ZSTD_getErrorName(ret),
+            !ZSTD_isError(ret) && ret == originalSize);
+    return RecordData(std::move(buffer), originalSize);
+}
+
+}  // namespace mongo
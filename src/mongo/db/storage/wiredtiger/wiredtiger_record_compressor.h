@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/data_range.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/storage/record_data.h"
+
+typedef struct ZSTD_CDict_s ZSTD_CDict;
+typedef struct ZSTD_DDict_s ZSTD_DDict;
+
+namespace mongo {
+
+/**
+ * Compresses individual records with a zstd dictionary trained on a sample of a collection's
+ * documents. Small documents sharing a schema compress poorly on their own or even page by page,
+ * but compress well against a dictionary holding their common field names and values.
+ *
+ * The dictionary is stored in the collection's options, under
+ * { storageEngine: { wiredTiger: { compressionDictionary: <BinData> } } }, and never changes for the
+ * lifetime of the collection. Compressed records are stored as zstd frames. Because a zstd frame
+ * starts with a magic number which can never be the (positive) length prefix of a BSON document,
+ * compressed and uncompressed records can be told apart, and records which do not benefit from
+ * compression are stored as is.
+ */
+class WiredTigerRecordCompressor {
+public:
+    static constexpr StringData kDictionaryFieldName = "compressionDictionary"_sd;
+
+    /**
+     * Trains a dictionary of at most 'maxDictionaryBytes' from 'samples'. Fails if the samples are
+     * too few or too small to train a dictionary from.
+     */
+    static StatusWith<std::string> trainDictionary(const std::vector<std::string>& samples,
+                                                   size_t maxDictionaryBytes);
+
+    /**
+     * Returns an OK status if 'dictionary' is a dictionary produced by trainDictionary().
+     */
+    static Status validateDictionary(ConstDataRange dictionary);
+
+    /**
+     * Returns true if the stored record 'data' was compressed by a WiredTigerRecordCompressor.
+     */
+    static bool isCompressed(const char* data, size_t size);
+
+    /**
+     * Returns the size of the record 'data' once decompressed, without decompressing it.
+     */
+    static size_t uncompressedSize(const char* data, size_t size);
+
+    explicit WiredTigerRecordCompressor(ConstDataRange dictionary);
+    ~WiredTigerRecordCompressor();
+
+    WiredTigerRecordCompressor(const WiredTigerRecordCompressor&) = delete;
+    WiredTigerRecordCompressor& operator=(const WiredTigerRecordCompressor&) = delete;
+
+    /**
+     * Compresses 'data' into 'out' and returns true, unless compressing the record does not make it
+     * smaller, in which case 'out' is left unspecified and false is returned: the record should
+     * then be stored uncompressed.
+     */
+    bool compress(const char* data, size_t size, std::string* out) const;
+
+    /**
+     * Returns the original record from the compressed record 'data'.
+     */
+    RecordData decompress(const char* data, size_t size) const;
+
+    unsigned getDictionaryId() const {
+        return _dictionaryId;
+    }
+
+private:
+    unsigned _dictionaryId;
+    ZSTD_CDict* _cdict;
+    ZSTD_DDict* _ddict;
+};
+
+}  // namespace mongo
@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_compressor.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeEvent(int i) {
+    return BSON("_id" << i << "eventType"
+                      << "pageView"
+                      << "userId" << (i % 97) << "sessionId" << (i * 7919)
+                      << "url" << ("https://example.com/catalog/item/" + std::to_string(i % 13))
+                      << "userAgent"
+                      << "Mozilla/5.0 (X11; Linux x86_64)");
+}
+
+std::string trainFromEvents() {
+    std::vector<std::string> samples;
+    for (int i = 0; i < 500; ++i) {
+        BSONObj obj = makeEvent(i);
+        samples.emplace_back(obj.objdata(), obj.objsize());
+    }
+    auto swDictionary = WiredTigerRecordCompressor::trainDictionary(samples, 4096);
+    ASSERT_OK(swDictionary.getStatus());
+    return swDictionary.getValue();
+}
+
+TEST(WiredTigerRecordCompressorTest, TrainedDictionaryIsValid) {
+    std::string dictionary = trainFromEvents();
+    ASSERT_LTE(dictionary.size(), 4096U);
+    ASSERT_OK(WiredTigerRecordCompressor::validateDictionary(
+        ConstDataRange(dictionary.data(), dictionary.size())));
+    ASSERT_NE(0U,
+              WiredTigerRecordCompressor(ConstDataRange(dictionary.data(), dictionary.size()))
+                  .getDictionaryId());
+}
+
+TEST(WiredTigerRecordCompressorTest, TrainingFailsWithoutEnoughSamples) {
+    std::vector<std::string> samples{"a", "b"};
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              WiredTigerRecordCompressor::trainDictionary(samples, 4096).getStatus());
+}
+
+TEST(WiredTigerRecordCompressorTest, ArbitraryBytesAreNotAValidDictionary) {
+    std::string notADictionary(1024, 'x');
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              WiredTigerRecordCompressor::validateDictionary(
+                  ConstDataRange(notADictionary.data(), notADictionary.size())));
+}
+
+TEST(WiredTigerRecordCompressorTest, RoundTrip) {
+    std::string dictionary = trainFromEvents();
+    WiredTigerRecordCompressor compressor(ConstDataRange(dictionary.data(), dictionary.size()));
+
+    BSONObj original = makeEvent(1234);
+    ASSERT_FALSE(WiredTigerRecordCompressor::isCompressed(original.objdata(), original.objsize()));
+
+    std::string compressed;
+    ASSERT_TRUE(compressor.compress(original.objdata(), original.objsize(), &compressed));
+    ASSERT_LT(compressed.size(), static_cast<size_t>(original.objsize()));
+    ASSERT_TRUE(WiredTigerRecordCompressor::isCompressed(compressed.data(), compressed.size()));
+    ASSERT_EQ(static_cast<size_t>(original.objsize()),
+              WiredTigerRecordCompressor::uncompressedSize(compressed.data(), compressed.size()));
+
+    RecordData decompressed = compressor.decompress(compressed.data(), compressed.size());
+    ASSERT_TRUE(decompressed.isOwned());
+    ASSERT_BSONOBJ_EQ(original, decompressed.toBson());
+}
+
+TEST(WiredTigerRecordCompressorTest, IncompressibleRecordIsNotCompressed) {
+    std::string dictionary = trainFromEvents();
+    WiredTigerRecordCompressor compressor(ConstDataRange(dictionary.data(), dictionary.size()));
+
+    BSONObj tiny = BSON("a" << 1);
+    std::string compressed;
+    ASSERT_FALSE(compressor.compress(tiny.objdata(), tiny.objsize(), &compressed));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -34,6 +34,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <boost/container/small_vector.hpp>
 #include <fmt/format.h>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
@@ -61,6 +62,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_compressor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
@@ -99,6 +101,15 @@ MONGO_STATIC_ASSERT(kCurrentRecordStoreVersion <= kMaximumRecordStoreVersion);
 
 const double kNumMSInHour = 1000 * 60 * 60;
 
+// Weight given to the newest sample of the oplog insert rate when adaptively sizing stones.
+const double kInsertRateSmoothing = 0.5;
+
+// With adaptive sizing, truncation waits while the insert rate is this many times the usual rate.
+const double kInsertBurstFactor = 2.0;
+
+// How often a deferred truncation checks whether the burst of inserts is over.
+const Milliseconds kTruncationDeferralPollInterval{100};
+
 void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
     StatusWith<BSONObj> appMetadata = WiredTigerUtil::getApplicationMetadata(opCtx, uri);
     fassert(39999, appMetadata);
@@ -141,7 +152,7 @@ public:
         // We only want to initialize _wall by parsing BSONObj when we expect to need it in
         // OplogStone::createNewStoneIfNeeded.
         int64_t currBytes = _oplogStones->_currentBytes.load() + _bytesInserted;
-        if (currBytes >= _oplogStones->_minBytesPerStone) {
+        if (currBytes >= _oplogStones->_minBytesPerStone.load()) {
             BSONObj obj = highestInsertedRecord.data.toBson();
             BSONElement ele = obj["wall"];
             if (!ele) {
@@ -161,7 +172,7 @@ public:
 
         _oplogStones->_currentRecords.addAndFetch(_countInserted);
         int64_t newCurrentBytes = _oplogStones->_currentBytes.addAndFetch(_bytesInserted);
-        if (_wall != Date_t() && newCurrentBytes >= _oplogStones->_minBytesPerStone) {
+        if (_wall != Date_t() && newCurrentBytes >= _oplogStones->_minBytesPerStone.load()) {
             // When other InsertChanges commit concurrently, an uninitialized wallTime may delay the
             // creation of a new stone. This delay is limited to the number of concurrently running
             // transactions, so the size difference should be inconsequential.
@@ -218,8 +229,9 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
 
     unsigned long long numStones = maxSize / oplogStoneSize;
     size_t numStonesToKeep = std::min(kMaxStonesToKeep, std::max(kMinStonesToKeep, numStones));
-    _minBytesPerStone = maxSize / numStonesToKeep;
-    invariant(_minBytesPerStone > 0);
+    _configuredMinBytesPerStone = maxSize / numStonesToKeep;
+    invariant(_configuredMinBytesPerStone > 0);
+    _minBytesPerStone.store(_configuredMinBytesPerStone);
 
     _calculateStones(opCtx, numStonesToKeep);
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
@@ -239,7 +251,9 @@ void WiredTigerRecordStore::OplogStones::kill() {
 void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
     // Wait until kill() is called or there are too many oplog stones.
     stdx::unique_lock<Latch> lock(_oplogReclaimMutex);
+    boost::optional<Date_t> deferredSince;
     while (!_isDead) {
+        bool deferred = false;
         {
             MONGO_IDLE_THREAD_BLOCK;
             stdx::lock_guard<Latch> lk(_mutex);
@@ -263,12 +277,52 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
 
                 if (static_cast<std::uint64_t>(stone.lastRecord.repr()) <
                     _rs->getPinnedOplog().asULL()) {
-                    break;
+                    if (!_shouldDeferTruncation_inlock(&deferredSince)) {
+                        break;
+                    }
+                    deferred = true;
                 }
             }
         }
-        _oplogReclaimCv.wait(lock);
+        if (deferred) {
+            // Check again shortly whether the burst of inserts is over.
+            _oplogReclaimCv.wait_for(lock, kTruncationDeferralPollInterval.toSystemDuration());
+        } else {
+            _oplogReclaimCv.wait(lock);
+        }
+    }
+}
+
+bool WiredTigerRecordStore::OplogStones::_shouldDeferTruncation_inlock(
+    boost::optional<Date_t>* deferredSince) const {
+    const double insertBytesPerSec = _insertBytesPerSec.load();
+    if (!gOplogTruncationPointAdaptiveSizing.load() || insertBytesPerSec <= 0 || _stones.empty()) {
+        return false;
+    }
+
+    const auto now = Date_t::now();
+    if (!*deferredSince) {
+        *deferredSince = now;
+    }
+    if (now - **deferredSince >= Milliseconds(gOplogTruncationMaxDeferralMillis.load())) {
+        return false;
     }
+
+    // Never let the oplog fall more than a couple of stones behind its cap.
+    int64_t totalBytes = 0;
+    for (auto&& stone : _stones) {
+        totalBytes += stone.bytes;
+    }
+    if (totalBytes - _rs->cappedMaxSize() > 2 * _minBytesPerStone.load()) {
+        return false;
+    }
+
+    // Compare the rate at which the stone being filled is growing with the usual insert rate.
+    const auto sinceLastStone =
+        std::max(Milliseconds(1), Milliseconds(now - _stones.back().wallTime));
+    const double currentBytesPerSec =
+        _currentBytes.load() * 1000.0 / durationCount<Milliseconds>(sinceLastStone);
+    return currentBytesPerSec > kInsertBurstFactor * insertBytesPerSec;
 }
 
 bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
@@ -339,7 +393,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
         return;
     }
 
-    if (_currentBytes.load() < _minBytesPerStone) {
+    if (_currentBytes.load() < _minBytesPerStone.load()) {
         // Must have raced to create a new stone, someone else already triggered it.
         return;
     }
@@ -353,6 +407,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
 
     OplogStones::Stone stone(_currentRecords.swap(0), _currentBytes.swap(0), lastRecord, wallTime);
     _stones.push_back(stone);
+    _adaptStoneSize_inlock(stone);
 
     LOGV2_DEBUG(22381,
                 2,
@@ -364,6 +419,44 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
     _pokeReclaimThreadIfNeeded();
 }
 
+void WiredTigerRecordStore::OplogStones::_adaptStoneSize_inlock(const Stone& newStone) {
+    if (!gOplogTruncationPointAdaptiveSizing.load()) {
+        _insertBytesPerSec.store(0.0);
+        _minBytesPerStone.store(_configuredMinBytesPerStone);
+        return;
+    }
+
+    if (_stones.size() < 2) {
+        return;
+    }
+    const auto fillTime = newStone.wallTime - _stones[_stones.size() - 2].wallTime;
+    if (fillTime <= Milliseconds(0)) {
+        return;
+    }
+
+    const double bytesPerSec = newStone.bytes * 1000.0 / durationCount<Milliseconds>(fillTime);
+    const double previousBytesPerSec = _insertBytesPerSec.load();
+    const double smoothedBytesPerSec = previousBytesPerSec == 0.0
+        ? bytesPerSec
+        : kInsertRateSmoothing * bytesPerSec + (1 - kInsertRateSmoothing) * previousBytesPerSec;
+    _insertBytesPerSec.store(smoothedBytesPerSec);
+
+    // Keep the number of stones within the same bounds as the static sizing does.
+    const long long maxSize = _rs->cappedMaxSize();
+    const long long upperBound = std::max(1LL, maxSize / gMinOplogStones);
+    const long long lowerBound =
+        std::min(upperBound, std::max(1LL, maxSize / gMaxOplogStonesAfterStartup));
+    const long long targetBytes = static_cast<long long>(
+        smoothedBytesPerSec * gOplogTruncationPointTargetIntervalSecs.load());
+    _minBytesPerStone.store(std::max(lowerBound, std::min(upperBound, targetBytes)));
+
+    LOGV2_DEBUG(5698001,
+                2,
+                "Resized oplog stones to match the insert rate",
+                "insertBytesPerSec"_attr = smoothedBytesPerSec,
+                "minBytesPerStone"_attr = _minBytesPerStone.load());
+}
+
 void WiredTigerRecordStore::OplogStones::updateCurrentStoneAfterInsertOnCommit(
     OperationContext* opCtx,
     int64_t bytesInserted,
@@ -413,7 +506,8 @@ void WiredTigerRecordStore::OplogStones::setMinBytesPerStone(int64_t size) {
 
     // Only allow changing the minimum bytes per stone if no data has been inserted.
     invariant(_stones.size() == 0 && _currentRecords.load() == 0);
-    _minBytesPerStone = size;
+    _configuredMinBytesPerStone = size;
+    _minBytesPerStone.store(size);
 }
 
 void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCtx,
@@ -461,7 +555,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
     // Use the oplog's average record size to estimate the number of records in each stone, and thus
     // estimate the combined size of the records.
     double avgRecordSize = double(dataSize) / double(numRecords);
-    double estRecordsPerStone = std::ceil(_minBytesPerStone / avgRecordSize);
+    double estRecordsPerStone = std::ceil(_minBytesPerStone.load() / avgRecordSize);
     double estBytesPerStone = estRecordsPerStone * avgRecordSize;
 
     _calculateStonesBySampling(opCtx, int64_t(estRecordsPerStone), int64_t(estBytesPerStone));
@@ -478,7 +572,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationCon
     while (auto record = cursor->next()) {
         _currentRecords.addAndFetch(1);
         int64_t newCurrentBytes = _currentBytes.addAndFetch(record->data.size());
-        if (newCurrentBytes >= _minBytesPerStone) {
+        if (newCurrentBytes >= _minBytesPerStone.load()) {
             BSONObj obj = record->data.toBson();
             auto wallTime = obj.hasField("wall") ? obj["wall"].Date() : obj["ts"].timestampTime();
 
@@ -640,8 +734,9 @@ void WiredTigerRecordStore::OplogStones::adjust(int64_t maxSize) {
 
     unsigned long long numStones = maxSize / oplogStoneSize;
     size_t numStonesToKeep = std::min(kMaxStonesToKeep, std::max(kMinStonesToKeep, numStones));
-    _minBytesPerStone = maxSize / numStonesToKeep;
-    invariant(_minBytesPerStone > 0);
+    _configuredMinBytesPerStone = maxSize / numStonesToKeep;
+    invariant(_configuredMinBytesPerStone > 0);
+    _minBytesPerStone.store(_configuredMinBytesPerStone);
     _pokeReclaimThreadIfNeeded();
 }
 
@@ -654,6 +749,21 @@ StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj o
                 return status;
             }
             ss << elem.valueStringData() << ',';
+        } else if (elem.fieldNameStringData() ==
+                   WiredTigerRecordCompressor::kDictionaryFieldName) {
+            // The dictionary is applied by the record store rather than by WiredTiger, so it does
+            // not contribute to the table configuration.
+            if (!elem.isBinData(BinDataGeneral)) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << '\'' << elem.fieldNameStringData() << '\''
+                                      << " must be of type BinData with subtype 0"};
+            }
+            int length;
+            const char* data = elem.binData(length);
+            Status status = WiredTigerRecordCompressor::validateDictionary({data, length});
+            if (!status.isOK()) {
+                return status;
+            }
         } else {
             // Return error on first unrecognized field.
             return StatusWith<std::string>(ErrorCodes::InvalidOptions,
@@ -690,10 +800,11 @@ public:
         WT_ITEM value;
         invariantWTOK(_cursor->get_value(_cursor, &value));
 
+        auto data = _rs->_toRecordData(value);
         auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
-        metricsCollector.incrementOneDocRead(value.size);
+        metricsCollector.incrementOneDocRead(data.size());
 
-        return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+        return {{id, std::move(data)}};
     }
 
     void save() final {
@@ -778,11 +889,20 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
 
     ss << extraStrings << ",";
 
-    StatusWith<std::string> customOptions =
-        parseOptionsField(options.storageEngine.getObjectField(engineName));
+    const BSONObj engineOptions = options.storageEngine.getObjectField(engineName);
+    StatusWith<std::string> customOptions = parseOptionsField(engineOptions);
     if (!customOptions.isOK())
         return customOptions;
 
+    // Capped collections hand the raw stored records to their deletion callbacks, and the oplog is
+    // read directly by replication, so neither supports compressed records.
+    if (engineOptions.hasField(WiredTigerRecordCompressor::kDictionaryFieldName) &&
+        (options.capped || NamespaceString::oplog(ns))) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "'" << WiredTigerRecordCompressor::kDictionaryFieldName
+                              << "' is not supported for capped collections"};
+    }
+
     ss << customOptions.getValue();
 
     if (NamespaceString::oplog(ns)) {
@@ -847,7 +967,8 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
       _cappedDeleteCheckCount(0),
       _sizeStorer(params.sizeStorer),
       _tracksSizeAdjustments(params.tracksSizeAdjustments),
-      _kvEngine(kvEngine) {
+      _kvEngine(kvEngine),
+      _recordCompressor(std::move(params.recordCompressor)) {
     invariant(getIdent().size() > 0);
 
     Status versionStatus = WiredTigerUtil::checkApplicationMetadataFormatVersion(
@@ -887,8 +1008,12 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
     // case for temporary RecordStores (those not associated with any collection) and in unit
     // tests. Persistent size information is not required in either case. If a RecordStore needs
     // persistent size information, we require it to use a SizeStorer.
-    _sizeInfo = _sizeStorer ? _sizeStorer->load(_uri)
-                            : std::make_shared<WiredTigerSizeStorer::SizeInfo>(0, 0);
+    //
+    // Otherwise the size information is loaded from the SizeStorer on first use.
+    if (!_sizeStorer) {
+        _sizeInfo = std::make_shared<WiredTigerSizeStorer::SizeInfo>(0, 0);
+        _sizeInfoLoaded.store(true);
+    }
 }
 
 WiredTigerRecordStore::~WiredTigerRecordStore() {
@@ -939,12 +1064,12 @@ void WiredTigerRecordStore::checkSize(OperationContext* opCtx) {
                            "ident"_attr = getIdent());
         sizeRecoveryState(getGlobalServiceContext())
             .markCollectionAsAlwaysNeedsSizeAdjustment(getIdent());
-        _sizeInfo->dataSize.store(0);
-        _sizeInfo->numRecords.store(0);
+        _getSizeInfo()->dataSize.store(0);
+        _getSizeInfo()->numRecords.store(0);
     }
 
     if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+        _sizeStorer->store(_uri, _getSizeInfo());
 }
 
 void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
@@ -971,6 +1096,17 @@ void WiredTigerRecordStore::getOplogTruncateStats(BSONObjBuilder& builder) const
     }
     builder.append("totalTimeTruncatingMicros", _totalTimeTruncating.load());
     builder.append("truncateCount", _truncateCount.load());
+
+    BSONArrayBuilder histogramBuilder(builder.subarrayStart("truncateLatencyMillis"));
+    for (size_t i = 0; i < kNumTruncateLatencyBuckets; i++) {
+        const long long count = _truncateLatencyMillis[i].load();
+        if (count == 0) {
+            continue;
+        }
+        BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+        entryBuilder.append("millis", i == 0 ? 0LL : 1LL << (i - 1));
+        entryBuilder.append("count", count);
+    }
 }
 
 const char* WiredTigerRecordStore::name() const {
@@ -983,11 +1119,11 @@ bool WiredTigerRecordStore::inShutdown() const {
 }
 
 long long WiredTigerRecordStore::dataSize(OperationContext* opCtx) const {
-    return _sizeInfo->dataSize.load();
+    return _getSizeInfo()->dataSize.load();
 }
 
 long long WiredTigerRecordStore::numRecords(OperationContext* opCtx) const {
-    return _sizeInfo->numRecords.load();
+    return _getSizeInfo()->numRecords.load();
 }
 
 bool WiredTigerRecordStore::isCapped() const {
@@ -1039,7 +1175,23 @@ int64_t WiredTigerRecordStore::freeStorageSize(OperationContext* opCtx) const {
 RecordData WiredTigerRecordStore::_getData(const WiredTigerCursor& cursor) const {
     WT_ITEM value;
     invariantWTOK(cursor->get_value(cursor.get(), &value));
-    return RecordData(static_cast<const char*>(value.data), value.size).getOwned();
+    return _toRecordData(value).getOwned();
+}
+
+RecordData WiredTigerRecordStore::_toRecordData(const WT_ITEM& value) const {
+    const char* data = static_cast<const char*>(value.data);
+    if (_recordCompressor && WiredTigerRecordCompressor::isCompressed(data, value.size)) {
+        return _recordCompressor->decompress(data, value.size);
+    }
+    return RecordData(data, value.size);
+}
+
+int64_t WiredTigerRecordStore::_recordSize(const WT_ITEM& value) const {
+    const char* data = static_cast<const char*>(value.data);
+    if (_recordCompressor && WiredTigerRecordCompressor::isCompressed(data, value.size)) {
+        return WiredTigerRecordCompressor::uncompressedSize(data, value.size);
+    }
+    return value.size;
 }
 
 bool WiredTigerRecordStore::findRecord(OperationContext* opCtx,
@@ -1092,7 +1244,7 @@ void WiredTigerRecordStore::deleteRecord(OperationContext* opCtx, const RecordId
     ret = c->get_value(c, &old_value);
     invariantWTOK(ret);
 
-    int64_t old_length = old_value.size;
+    int64_t old_length = _recordSize(old_value);
 
     ret = WT_OP_CHECK(wiredTigerCursorRemove(opCtx, c));
     invariantWTOK(ret);
@@ -1107,10 +1259,10 @@ bool WiredTigerRecordStore::cappedAndNeedDelete() const {
     if (!_isCapped)
         return false;
 
-    if (_sizeInfo->dataSize.load() >= _cappedMaxSize)
+    if (_getSizeInfo()->dataSize.load() >= _cappedMaxSize)
         return true;
 
-    if ((_cappedMaxDocs != -1) && (_sizeInfo->numRecords.load() > _cappedMaxDocs))
+    if ((_cappedMaxDocs != -1) && (_getSizeInfo()->numRecords.load() > _cappedMaxDocs))
         return true;
 
     return false;
@@ -1160,7 +1312,7 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
         if (!lock.try_lock()) {
             // Someone else is deleting old records. Apply back-pressure if too far behind,
             // otherwise continue.
-            if ((_sizeInfo->dataSize.load() - _cappedMaxSize) < _cappedMaxSizeSlack)
+            if ((_getSizeInfo()->dataSize.load() - _cappedMaxSize) < _cappedMaxSizeSlack)
                 return 0;
 
             // Don't wait forever: we're in a transaction, we could block eviction.
@@ -1175,7 +1327,7 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
 
             // If we already waited, let someone else do cleanup unless we are significantly
             // over the limit.
-            if ((_sizeInfo->dataSize.load() - _cappedMaxSize) < (2 * _cappedMaxSizeSlack))
+            if ((_getSizeInfo()->dataSize.load() - _cappedMaxSize) < (2 * _cappedMaxSizeSlack))
                 return 0;
         }
     }
@@ -1231,8 +1383,8 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded_inlock(OperationContext* op
 
     WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
 
-    int64_t dataSize = _sizeInfo->dataSize.load();
-    int64_t numRecords = _sizeInfo->numRecords.load();
+    int64_t dataSize = _getSizeInfo()->dataSize.load();
+    int64_t numRecords = _getSizeInfo()->numRecords.load();
 
     int64_t sizeOverCap = (dataSize > _cappedMaxSize) ? dataSize - _cappedMaxSize : 0;
     int64_t sizeSaved = 0;
@@ -1434,6 +1586,7 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
         WT_SESSION* session = ru->getSession()->getSession();
 
         try {
+            Timer stoneTimer;
             WriteUnitOfWork wuow(opCtx);
 
             WiredTigerCursor cwrap(_uri, _tableId, true, opCtx);
@@ -1482,6 +1635,13 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
 
             wuow.commit();
 
+            const long long stoneMillis = stoneTimer.millis();
+            size_t bucket = 0;
+            while (bucket + 1 < kNumTruncateLatencyBuckets && (1LL << bucket) <= stoneMillis) {
+                ++bucket;
+            }
+            _truncateLatencyMillis[bucket].fetchAndAdd(1);
+
             // Remove the stone after a successful truncation.
             _oplogStones->popOldestStone();
 
@@ -1498,8 +1658,8 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
                 1,
                 "Finished truncating the oplog, it now contains approximately "
                 "{sizeInfo_numRecords_load} records totaling to {sizeInfo_dataSize_load} bytes",
-                "sizeInfo_numRecords_load"_attr = _sizeInfo->numRecords.load(),
-                "sizeInfo_dataSize_load"_attr = _sizeInfo->dataSize.load());
+                "sizeInfo_numRecords_load"_attr = _getSizeInfo()->numRecords.load(),
+                "sizeInfo_dataSize_load"_attr = _getSizeInfo()->dataSize.load());
     auto elapsedMicros = timer.micros();
     auto elapsedMillis = elapsedMicros / 1000;
     _totalTimeTruncating.fetchAndAdd(elapsedMicros);
@@ -1540,21 +1700,33 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
 
     Record highestIdRecord;
     invariant(nRecords != 0);
-    for (size_t i = 0; i < nRecords; i++) {
-        auto& record = records[i];
-        if (_isOplog) {
+    if (_isOplog) {
+        for (size_t i = 0; i < nRecords; i++) {
+            auto& record = records[i];
             StatusWith<RecordId> status =
                 oploghack::extractKey(record.data.data(), record.data.size());
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
-        } else {
-            record.id = _nextId(opCtx);
+            dassert(record.id > highestIdRecord.id);
+            highestIdRecord = record;
+        }
+    } else {
+        // Reserve the RecordIds for the whole batch at once. They are consecutive, so the records
+        // are inserted in key order and each insert lands just after the previous one.
+        const int64_t firstId = _nextId(opCtx, nRecords).repr();
+        for (size_t i = 0; i < nRecords; i++) {
+            records[i].id = RecordId(firstId + static_cast<int64_t>(i));
         }
-        dassert(record.id > highestIdRecord.id);
-        highestIdRecord = record;
+        highestIdRecord = records[nRecords - 1];
     }
 
+    // Metrics are only accounted for non-oplog inserts.
+    auto metricsCollector =
+        _isOplog ? nullptr : &ResourceConsumption::MetricsCollector::get(opCtx);
+
+    Timestamp lastTimestamp;
+    std::string compressed;
     for (size_t i = 0; i < nRecords; i++) {
         auto& record = records[i];
         Timestamp ts;
@@ -1570,12 +1742,18 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         } else {
             ts = timestamps[i];
         }
-        if (!ts.isNull()) {
+        // Records in a batch commonly share a timestamp, and setting it again would be a no-op.
+        if (!ts.isNull() && ts != lastTimestamp) {
             LOGV2_DEBUG(22403, 4, "inserting record with timestamp {ts}", "ts"_attr = ts);
             fassert(39001, opCtx->recoveryUnit()->setTimestamp(ts));
+            lastTimestamp = ts;
         }
         setKey(c, record.id);
         WiredTigerItem value(record.data.data(), record.data.size());
+        if (_recordCompressor &&
+            _recordCompressor->compress(record.data.data(), record.data.size(), &compressed)) {
+            value = WiredTigerItem(compressed.data(), compressed.size());
+        }
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(wiredTigerCursorInsert(opCtx, c));
         if (ret)
@@ -1583,9 +1761,8 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
 
         // Increment metrics for each insert separately, as opposed to outside of the loop. The API
         // requires that each record be accounted for separately.
-        if (!_isOplog) {
-            auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
-            metricsCollector.incrementOneDocWritten(value.size);
+        if (metricsCollector) {
+            metricsCollector->incrementOneDocWritten(record.data.size());
         }
     }
 
@@ -1694,13 +1871,17 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     ret = c->get_value(c, &old_value);
     invariantWTOK(ret);
 
-    int64_t old_length = old_value.size;
+    int64_t old_length = _recordSize(old_value);
 
     if (_oplogStones && len != old_length) {
         return {ErrorCodes::IllegalOperation, "Cannot change the size of a document in the oplog"};
     }
 
     WiredTigerItem value(data, len);
+    std::string compressed;
+    if (_recordCompressor && _recordCompressor->compress(data, len, &compressed)) {
+        value = WiredTigerItem(compressed.data(), compressed.size());
+    }
 
     // Check if we should modify rather than doing a full update.  Look for deltas for documents
     // larger than 1KB, up to 16 changes representing up to 10% of the data.
@@ -1711,8 +1892,11 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     const int kMaxEntries = 16;
     const int kMaxDiffBytes = len / 10;
 
+    // Compressed records have no useful byte-level delta between versions, so they are always
+    // rewritten in full.
     bool skip_update = false;
-    if (!_isLogged && len > kMinLengthForDiff && len <= old_length + kMaxDiffBytes) {
+    if (!_isLogged && !_recordCompressor && len > kMinLengthForDiff &&
+        len <= old_length + kMaxDiffBytes) {
         int nentries = kMaxEntries;
         std::vector<WT_MODIFY> entries(nentries);
 
@@ -1759,7 +1943,8 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
 }
 
 bool WiredTigerRecordStore::updateWithDamagesSupported() const {
-    return true;
+    // Damages are offsets into the uncompressed document, so they cannot be applied in place.
+    return !_recordCompressor;
 }
 
 StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
@@ -1772,7 +1957,9 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const int nentries = damages.size();
     mutablebson::DamageVector::const_iterator where = damages.begin();
     const mutablebson::DamageVector::const_iterator end = damages.cend();
-    std::vector<WT_MODIFY> entries(nentries);
+    // In-place updates typically touch one or two fields, each producing at most two damage
+    // events, so keep the modify entries on the stack.
+    boost::container::small_vector<WT_MODIFY, 8> entries(nentries);
     size_t modifiedDataSize = 0;
     for (u_int i = 0; where != end; ++i, ++where) {
         entries[i].data.data = damageSource + where->sourceOffset;
@@ -1999,12 +2186,12 @@ void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
     sizeRecoveryState(getGlobalServiceContext())
         .markCollectionAsAlwaysNeedsSizeAdjustment(getIdent());
 
-    _sizeInfo->numRecords.store(numRecords);
-    _sizeInfo->dataSize.store(dataSize);
+    _getSizeInfo()->numRecords.store(numRecords);
+    _getSizeInfo()->dataSize.store(dataSize);
 
     // If we have a WiredTigerSizeStorer, but our size info is not currently cached, add it.
     if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+        _sizeStorer->store(_uri, _getSizeInfo());
 }
 
 void WiredTigerRecordStore::_initNextIdIfNeeded(OperationContext* opCtx) {
@@ -2033,14 +2220,30 @@ void WiredTigerRecordStore::_initNextIdIfNeeded(OperationContext* opCtx) {
     _nextIdNum.store(nextId);
 }
 
-RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx) {
+RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx, int64_t numIds) {
     invariant(!_isOplog);
+    invariant(numIds > 0);
     _initNextIdIfNeeded(opCtx);
-    RecordId out = RecordId(_nextIdNum.fetchAndAdd(1));
+    RecordId out = RecordId(_nextIdNum.fetchAndAdd(numIds));
     invariant(out.isNormal());
+    invariant(RecordId(out.repr() + numIds - 1).isNormal());
     return out;
 }
 
+const std::shared_ptr<WiredTigerSizeStorer::SizeInfo>& WiredTigerRecordStore::_getSizeInfo()
+    const {
+    if (MONGO_likely(_sizeInfoLoaded.load())) {
+        return _sizeInfo;
+    }
+
+    stdx::lock_guard<Latch> lk(_sizeInfoMutex);
+    if (!_sizeInfoLoaded.load()) {
+        _sizeInfo = _sizeStorer->load(_uri);
+        _sizeInfoLoaded.store(true);
+    }
+    return _sizeInfo;
+}
+
 WiredTigerRecoveryUnit* WiredTigerRecordStore::_getRecoveryUnit(OperationContext* opCtx) {
     return checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
 }
@@ -2054,7 +2257,7 @@ public:
                     3,
                     "WiredTigerRecordStore: rolling back NumRecordsChange {diff}",
                     "diff"_attr = -_diff);
-        _rs->_sizeInfo->numRecords.fetchAndAdd(-_diff);
+        _rs->_getSizeInfo()->numRecords.fetchAndAdd(-_diff);
     }
 
 private:
@@ -2072,8 +2275,8 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
     }
 
     opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
-    if (_sizeInfo->numRecords.fetchAndAdd(diff) < 0)
-        _sizeInfo->numRecords.store(std::max(diff, int64_t(0)));
+    if (_getSizeInfo()->numRecords.fetchAndAdd(diff) < 0)
+        _getSizeInfo()->numRecords.store(std::max(diff, int64_t(0)));
 }
 
 class WiredTigerRecordStore::DataSizeChange : public RecoveryUnit::Change {
@@ -2101,35 +2304,35 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
     if (opCtx)
         opCtx->recoveryUnit()->registerChange(std::make_unique<DataSizeChange>(this, amount));
 
-    if (_sizeInfo->dataSize.fetchAndAdd(amount) < 0)
-        _sizeInfo->dataSize.store(std::max(amount, int64_t(0)));
+    if (_getSizeInfo()->dataSize.fetchAndAdd(amount) < 0)
+        _getSizeInfo()->dataSize.store(std::max(amount, int64_t(0)));
 
     if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+        _sizeStorer->store(_uri, _getSizeInfo());
 }
 
 void WiredTigerRecordStore::setNumRecords(long long numRecords) {
-    _sizeInfo->numRecords.store(numRecords);
+    _getSizeInfo()->numRecords.store(numRecords);
 
     if (!_sizeStorer) {
         return;
     }
 
     // Flush the updated number of records to disk immediately.
-    _sizeStorer->store(_uri, _sizeInfo);
+    _sizeStorer->store(_uri, _getSizeInfo());
     bool syncToDisk = true;
     _sizeStorer->flush(syncToDisk);
 }
 
 void WiredTigerRecordStore::setDataSize(long long dataSize) {
-    _sizeInfo->dataSize.store(dataSize);
+    _getSizeInfo()->dataSize.store(dataSize);
 
     if (!_sizeStorer) {
         return;
     }
 
     // Flush the updated data size to disk immediately.
-    _sizeStorer->store(_uri, _sizeInfo);
+    _sizeStorer->store(_uri, _getSizeInfo());
     bool syncToDisk = true;
     _sizeStorer->flush(syncToDisk);
 }
@@ -2267,6 +2470,34 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     // options we pass when we explicitly start transactions in the RecoveryUnit.
     WiredTigerRecoveryUnit::get(_opCtx)->getSession();
 
+    return _advance(ResourceConsumption::MetricsCollector::get(_opCtx));
+}
+
+size_t WiredTigerRecordStoreCursorBase::nextBatch(RecordBatch* batch, size_t maxRecords) {
+    invariant(_hasRestored);
+    batch->clear();
+    if (_eof)
+        return 0;
+
+    // The transaction and the metrics collector only need to be looked up once per batch rather
+    // than once per record.
+    WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+
+    while (batch->size() < maxRecords) {
+        auto record = _advance(metricsCollector);
+        if (!record) {
+            break;
+        }
+        // The record points into WiredTiger's cursor buffer, which is only valid until the cursor
+        // moves again, so it has to be copied into the batch.
+        batch->append(record->id, record->data);
+    }
+    return batch->size();
+}
+
+boost::optional<Record> WiredTigerRecordStoreCursorBase::_advance(
+    ResourceConsumption::MetricsCollector& metricsCollector) {
     WT_CURSOR* c = _cursor->get();
 
     RecordId id;
@@ -2316,11 +2547,35 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
-    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
-    metricsCollector.incrementOneDocRead(value.size);
+    auto data = _rs._toRecordData(value);
+    metricsCollector.incrementOneDocRead(data.size());
+
+    if (_readAhead && _forward) {
+        _readAheadFrom(id);
+    }
 
     _lastReturnedId = id;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    return {{id, std::move(data)}};
+}
+
+void WiredTigerRecordStoreCursorBase::_readAheadFrom(const RecordId& id) {
+    const size_t numEntries = WiredTigerPrefetcher::entriesPerWindow();
+    auto prefetcher = _rs._kvEngine ? _rs._kvEngine->getPrefetcher() : nullptr;
+    if (numEntries == 0 || !prefetcher) {
+        return;
+    }
+
+    // Scans that end within their first window, such as point lookups, never read ahead.
+    if (++_entriesSinceReadAhead < numEntries) {
+        return;
+    }
+    _entriesSinceReadAhead = 0;
+
+    // Each window starts at the scan's current position and reads twice as far as the scan goes
+    // before scheduling the next one, so the second half of every window is still ahead of the
+    // scan when the next window is scheduled.
+    _readAheadWindow = prefetcher->readAhead(
+        _readAheadWindow, _rs.getURI(), makeReadAheadKeySetter(id), 2 * numEntries);
 }
 
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
@@ -2353,11 +2608,12 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
-    metricsCollector.incrementOneDocRead(value.size);
+    auto data = _rs._toRecordData(value);
+    metricsCollector.incrementOneDocRead(data.size());
 
     _lastReturnedId = id;
     _eof = false;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    return {{id, std::move(data)}};
 }
 
 
@@ -2496,6 +2752,11 @@ void WiredTigerRecordStoreStandardCursor::setKey(WT_CURSOR* cursor, RecordId id)
     cursor->set_key(cursor, id.repr());
 }
 
+WiredTigerPrefetcher::KeySetter WiredTigerRecordStoreStandardCursor::makeReadAheadKeySetter(
+    RecordId id) const {
+    return [id](WT_CURSOR* cursor) { cursor->set_key(cursor, id.repr()); };
+}
+
 RecordId WiredTigerRecordStoreStandardCursor::getKey(WT_CURSOR* cursor) const {
     std::int64_t recordId;
     invariantWTOK(cursor->get_key(cursor, &recordId));
@@ -2560,6 +2821,13 @@ void WiredTigerRecordStorePrefixedCursor::setKey(WT_CURSOR* cursor, RecordId id)
     cursor->set_key(cursor, _prefix.repr(), id.repr());
 }
 
+WiredTigerPrefetcher::KeySetter WiredTigerRecordStorePrefixedCursor::makeReadAheadKeySetter(
+    RecordId id) const {
+    return [prefix = _prefix, id](WT_CURSOR* cursor) {
+        cursor->set_key(cursor, prefix.repr(), id.repr());
+    };
+}
+
 RecordId WiredTigerRecordStorePrefixedCursor::getKey(WT_CURSOR* cursor) const {
     std::int64_t prefix;
     std::int64_t recordId;
@@ -29,17 +29,20 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <set>
 #include <string>
 #include <wiredtiger.h>
 
 #include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/db/storage/capped_callback.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_prefetcher.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/platform/atomic_word.h"
@@ -65,6 +68,7 @@
 namespace mongo {
 
 class RecoveryUnit;
+class WiredTigerRecordCompressor;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
 
@@ -114,6 +118,8 @@ public:
         WiredTigerSizeStorer* sizeStorer;
         bool isReadOnly;
         bool tracksSizeAdjustments;
+        // If set, records are compressed with this collection's dictionary.
+        std::shared_ptr<const WiredTigerRecordCompressor> recordCompressor;
     };
 
     WiredTigerRecordStore(WiredTigerKVEngine* kvEngine, OperationContext* opCtx, Params params);
@@ -297,10 +303,31 @@ private:
                           const Timestamp* timestamps,
                           size_t nRecords);
 
-    RecordId _nextId(OperationContext* opCtx);
+    /**
+     * Reserves 'numIds' consecutive RecordIds and returns the first of them.
+     */
+    RecordId _nextId(OperationContext* opCtx, int64_t numIds = 1);
+
+    /**
+     * Returns the size information of this record store, loading it from the size storer on first
+     * use. Loading it lazily keeps startup from reading the size storer entry of every collection.
+     */
+    const std::shared_ptr<WiredTigerSizeStorer::SizeInfo>& _getSizeInfo() const;
     bool cappedAndNeedDelete() const;
     RecordData _getData(const WiredTigerCursor& cursor) const;
 
+    /**
+     * Returns the record stored in 'value', decompressing it if needed. The returned RecordData
+     * only owns its buffer if the record was decompressed.
+     */
+    RecordData _toRecordData(const WT_ITEM& value) const;
+
+    /**
+     * Returns the size of the record stored in 'value' once decompressed. This is the size
+     * accounted for in dataSize().
+     */
+    int64_t _recordSize(const WT_ITEM& value) const;
+
 
     /**
      * Initialize the largest known RecordId if it is not already. This is designed to be called
@@ -383,16 +410,29 @@ private:
     AtomicWord<long long> _nextIdNum{0};
 
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
-    std::shared_ptr<WiredTigerSizeStorer::SizeInfo> _sizeInfo;
+
+    // Loaded from '_sizeStorer' on first use, see _getSizeInfo().
+    mutable Mutex _sizeInfoMutex = MONGO_MAKE_LATCH("WiredTigerRecordStore::_sizeInfoMutex");
+    mutable AtomicWord<bool> _sizeInfoLoaded{false};
+    mutable std::shared_ptr<WiredTigerSizeStorer::SizeInfo> _sizeInfo;
     bool _tracksSizeAdjustments;
     WiredTigerKVEngine* _kvEngine;  // not owned.
 
+    // Null unless the collection was created with a compression dictionary.
+    const std::shared_ptr<const WiredTigerRecordCompressor> _recordCompressor;
+
     // Non-null if this record store is underlying the active oplog.
     std::shared_ptr<OplogStones> _oplogStones;
 
     AtomicWord<int64_t>
         _totalTimeTruncating;            // Cumulative amount of time spent truncating the oplog.
     AtomicWord<int64_t> _truncateCount;  // Cumulative number of truncates of the oplog.
+
+    // Histogram of the time taken to truncate a single oplog stone. Bucket 0 counts truncates that
+    // took under 1ms, and bucket i > 0 those that took at least 2^(i-1)ms, with the last bucket
+    // counting everything above its lower bound.
+    static constexpr size_t kNumTruncateLatencyBuckets = 16;
+    std::array<AtomicWord<long long>, kNumTruncateLatencyBuckets> _truncateLatencyMillis;
 };
 
 
@@ -448,6 +488,8 @@ public:
 
     boost::optional<Record> next();
 
+    size_t nextBatch(RecordBatch* batch, size_t maxRecords);
+
     boost::optional<Record> seekExact(const RecordId& id);
 
     void save();
@@ -460,11 +502,21 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx);
 
+    void setReadAhead(bool readAhead) override {
+        _readAhead = readAhead;
+    }
+
 protected:
     virtual RecordId getKey(WT_CURSOR* cursor) const = 0;
 
     virtual void setKey(WT_CURSOR* cursor, RecordId id) const = 0;
 
+    /**
+     * Returns a function that sets the key of a read-ahead cursor to 'id'. It must not capture this
+     * cursor, since read-ahead may still be running after the cursor has been destroyed.
+     */
+    virtual WiredTigerPrefetcher::KeySetter makeReadAheadKeySetter(RecordId id) const = 0;
+
     /**
      * Callers must have already checked the return value of a positioning method against
      * 'WT_NOTFOUND'. This method allows for additional predicates to be considered on a validly
@@ -491,12 +543,28 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Moves the cursor forward and returns the new record, without opening a transaction or
+     * looking up the metrics collector. Shared by next() and nextBatch().
+     */
+    boost::optional<Record> _advance(ResourceConsumption::MetricsCollector& metricsCollector);
+
+    /**
+     * Called with each record a forward scan returns while read-ahead is enabled. Schedules the
+     * next read-ahead window from 'id' once the scan has consumed the previous window's lead.
+     */
+    void _readAheadFrom(const RecordId& id);
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
      * established.
      */
     boost::optional<std::int64_t> _oplogVisibleTs = boost::none;
+
+    bool _readAhead = false;
+    std::shared_ptr<WiredTigerPrefetcher::Window> _readAheadWindow;
+    size_t _entriesSinceReadAhead = 0;
 };
 
 class WiredTigerRecordStoreStandardCursor final : public WiredTigerRecordStoreCursorBase {
@@ -510,6 +578,8 @@ protected:
 
     virtual void setKey(WT_CURSOR* cursor, RecordId id) const override;
 
+    WiredTigerPrefetcher::KeySetter makeReadAheadKeySetter(RecordId id) const override;
+
     /**
      * Callers must have already checked the return value of a positioning method against
      * 'WT_NOTFOUND'. This method allows for additional predicates to be considered on a validly
@@ -534,6 +604,8 @@ protected:
 
     virtual void setKey(WT_CURSOR* cursor, RecordId id) const override;
 
+    WiredTigerPrefetcher::KeySetter makeReadAheadKeySetter(RecordId id) const override;
+
     /**
      * Callers must have already checked the return value of a positioning method against
      * 'WT_NOTFOUND'. This method allows for additional predicates to be considered on a validly
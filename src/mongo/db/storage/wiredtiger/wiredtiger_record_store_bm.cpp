@@ -0,0 +1,276 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/operation_context_noop.h"
+#include "mongo/db/repl/repl_settings.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/clock_source_mock.h"
+
+namespace mongo {
+namespace {
+
+const int kNumRecords = 100 * 1000;
+const int kRecordSize = 128;
+
+/**
+ * A WiredTiger engine with two record stores shared by all benchmarks: 'insertStore', which starts
+ * empty, and 'readStore', which holds kNumRecords records with ids 1 to kNumRecords. It is created
+ * on first use and never destroyed, so that benchmarks running on several threads can share it.
+ */
+class RecordStoreBenchmarkFixture : public ScopedGlobalServiceContextForTest {
+public:
+    static RecordStoreBenchmarkFixture& get() {
+        static auto fixture = new RecordStoreBenchmarkFixture();
+        return *fixture;
+    }
+
+    /**
+     * Returns an operation context for 'client' with a WiredTiger recovery unit.
+     */
+    ServiceContext::UniqueOperationContext newOperationContext(Client* client) {
+        auto opCtx = client->makeOperationContext();
+        opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(_engine.newRecoveryUnit()),
+                               WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+        return opCtx;
+    }
+
+    RecordStore* insertStore() const {
+        return _insertStore.get();
+    }
+
+    RecordStore* readStore() const {
+        return _readStore.get();
+    }
+
+    const std::string& recordData() const {
+        return _recordData;
+    }
+
+private:
+    RecordStoreBenchmarkFixture()
+        : _dbpath("wt_record_store_bm"),
+          _engine(kWiredTigerEngineName,
+                  _dbpath.path(),
+                  &_clockSource,
+                  "",
+                  256 /* cacheSizeMB */,
+                  0 /* maxHistoryFileSizeMB */,
+                  false /* durable */,
+                  false /* ephemeral */,
+                  false /* repair */,
+                  false /* readOnly */),
+          _recordData(kRecordSize, 'x') {
+        repl::ReplicationCoordinator::set(getServiceContext(),
+                                          std::make_unique<repl::ReplicationCoordinatorMock>(
+                                              getServiceContext(), repl::ReplSettings()));
+        _engine.notifyStartupComplete();
+
+        _insertStore = _newRecordStore("bm.insert");
+        _readStore = _newRecordStore("bm.read");
+
+        ThreadClient tc("setup", getServiceContext());
+        auto opCtx = newOperationContext(tc.get());
+        for (int i = 0; i < kNumRecords; i += 1000) {
+            WriteUnitOfWork wuow(opCtx.get());
+            for (int j = 0; j < 1000; j++) {
+                invariant(_readStore
+                              ->insertRecord(
+                                  opCtx.get(), _recordData.data(), _recordData.size(), Timestamp())
+                              .isOK());
+            }
+            wuow.commit();
+        }
+    }
+
+    std::unique_ptr<RecordStore> _newRecordStore(const std::string& ns) {
+        OperationContextNoop opCtx(_engine.newRecoveryUnit());
+        const std::string uri = WiredTigerKVEngine::kTableUriPrefix + ns;
+        const auto config = uassertStatusOK(WiredTigerRecordStore::generateCreateString(
+            kWiredTigerEngineName, ns, CollectionOptions(), "", false /* prefixed */));
+        {
+            WriteUnitOfWork wuow(&opCtx);
+            WT_SESSION* session = WiredTigerRecoveryUnit::get(&opCtx)->getSession()->getSession();
+            invariantWTOK(session->create(session, uri.c_str(), config.c_str()));
+            wuow.commit();
+        }
+
+        WiredTigerRecordStore::Params params;
+        params.ns = ns;
+        params.ident = ns;
+        params.engineName = kWiredTigerEngineName;
+        params.isCapped = false;
+        params.isEphemeral = false;
+        params.cappedMaxSize = -1;
+        params.cappedMaxDocs = -1;
+        params.cappedCallback = nullptr;
+        params.sizeStorer = nullptr;
+        params.isReadOnly = false;
+        params.tracksSizeAdjustments = true;
+
+        auto rs = std::make_unique<StandardWiredTigerRecordStore>(&_engine, &opCtx, params);
+        rs->postConstructorInit(&opCtx);
+        return rs;
+    }
+
+    unittest::TempDir _dbpath;
+    ClockSourceMock _clockSource;
+    WiredTigerKVEngine _engine;
+    const std::string _recordData;
+    std::unique_ptr<RecordStore> _insertStore;
+    std::unique_ptr<RecordStore> _readStore;
+};
+
+RecordId randomRecordId(std::mt19937_64& gen) {
+    return RecordId(static_cast<int64_t>(gen() % kNumRecords) + 1);
+}
+
+/**
+ * Inserts state.range(0) records per WriteUnitOfWork.
+ */
+void BM_InsertRecords(benchmark::State& state) {
+    auto& fixture = RecordStoreBenchmarkFixture::get();
+    ThreadClient tc(fixture.getServiceContext());
+    auto opCtx = fixture.newOperationContext(tc.get());
+
+    const auto batchSize = state.range(0);
+    const auto& data = fixture.recordData();
+    for (auto _ : state) {
+        std::vector<Record> records;
+        for (int i = 0; i < batchSize; i++) {
+            records.push_back({RecordId(), RecordData(data.data(), data.size())});
+        }
+        WriteUnitOfWork wuow(opCtx.get());
+        invariant(fixture.insertStore()
+                      ->insertRecords(opCtx.get(), &records, std::vector<Timestamp>(batchSize))
+                      .isOK());
+        wuow.commit();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+void BM_UpdateRecord(benchmark::State& state) {
+    auto& fixture = RecordStoreBenchmarkFixture::get();
+    ThreadClient tc(fixture.getServiceContext());
+    auto opCtx = fixture.newOperationContext(tc.get());
+
+    std::mt19937_64 gen(state.thread_index);
+    const auto& data = fixture.recordData();
+    for (auto _ : state) {
+        const auto id = randomRecordId(gen);
+        try {
+            WriteUnitOfWork wuow(opCtx.get());
+            invariant(fixture.readStore()
+                          ->updateRecord(opCtx.get(), id, data.data(), data.size())
+                          .isOK());
+            wuow.commit();
+        } catch (const WriteConflictException&) {
+            // Another thread updated the same record. Its update is as good as ours.
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FindRecord(benchmark::State& state) {
+    auto& fixture = RecordStoreBenchmarkFixture::get();
+    ThreadClient tc(fixture.getServiceContext());
+    auto opCtx = fixture.newOperationContext(tc.get());
+
+    std::mt19937_64 gen(state.thread_index);
+    RecordData out;
+    for (auto _ : state) {
+        invariant(fixture.readStore()->findRecord(opCtx.get(), randomRecordId(gen), &out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Reads state.range(0) consecutive records from a random position with a forward cursor.
+ */
+void BM_ScanRecords(benchmark::State& state) {
+    auto& fixture = RecordStoreBenchmarkFixture::get();
+    ThreadClient tc(fixture.getServiceContext());
+    auto opCtx = fixture.newOperationContext(tc.get());
+
+    std::mt19937_64 gen(state.thread_index);
+    const auto scanLength = state.range(0);
+    auto cursor = fixture.readStore()->getCursor(opCtx.get());
+    for (auto _ : state) {
+        auto record = cursor->seekExact(randomRecordId(gen));
+        for (int i = 1; record && i < scanLength; i++) {
+            record = cursor->next();
+        }
+        benchmark::DoNotOptimize(record);
+    }
+    state.SetItemsProcessed(state.iterations() * scanLength);
+}
+
+/**
+ * Yields a cursor between every record, as a query does when it yields.
+ */
+void BM_SaveRestoreCursor(benchmark::State& state) {
+    auto& fixture = RecordStoreBenchmarkFixture::get();
+    ThreadClient tc(fixture.getServiceContext());
+    auto opCtx = fixture.newOperationContext(tc.get());
+
+    auto cursor = fixture.readStore()->getCursor(opCtx.get());
+    for (auto _ : state) {
+        auto record = cursor->next();
+        if (!record) {
+            cursor->saveUnpositioned();
+        } else {
+            cursor->save();
+        }
+        opCtx->recoveryUnit()->abandonSnapshot();
+        invariant(cursor->restore());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_InsertRecords)->Arg(1)->Arg(64)->ThreadRange(1, 8);
+BENCHMARK(BM_UpdateRecord)->ThreadRange(1, 8);
+BENCHMARK(BM_FindRecord)->ThreadRange(1, 8);
+BENCHMARK(BM_ScanRecords)->Arg(100)->ThreadRange(1, 8);
+BENCHMARK(BM_SaveRestoreCursor)->ThreadRange(1, 8);
+
+}  // namespace
+}  // namespace mongo
@@ -71,6 +71,9 @@ public:
         if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
             builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
         }
+        builder.append("truncationPointSizeBytes",
+                       static_cast<long long>(_minBytesPerStone.load()));
+        builder.append("estimatedInsertBytesPerSec", _insertBytesPerSec.load());
     }
 
     boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
@@ -115,6 +118,10 @@ public:
         return _currentRecords.load();
     }
 
+    int64_t minBytesPerStone() const {
+        return _minBytesPerStone.load();
+    }
+
     void setMinBytesPerStone(int64_t size);
 
 private:
@@ -129,6 +136,22 @@ private:
 
     void _pokeReclaimThreadIfNeeded();
 
+    /**
+     * Called after 'newStone' has been added. With adaptive sizing enabled, updates the estimated
+     * insert rate from the time it took to fill 'newStone' and resizes the stones that follow so
+     * each covers about 'oplogTruncationPointTargetIntervalSecs' of inserts. Otherwise restores
+     * the stone size derived from the oplog size.
+     */
+    void _adaptStoneSize_inlock(const Stone& newStone);
+
+    /**
+     * Returns true if truncating the oldest stone should wait because inserts are arriving much
+     * faster than usual. Truncation is only deferred while the oplog is over its cap by at most a
+     * couple of stones, and for no longer than 'oplogTruncationMaxDeferralMillis' in total, which
+     * is tracked through 'deferredSince'.
+     */
+    bool _shouldDeferTruncation_inlock(boost::optional<Date_t>* deferredSince) const;
+
     static const uint64_t kRandomSamplesPerStone = 10;
 
     WiredTigerRecordStore* _rs;
@@ -141,8 +164,16 @@ private:
     bool _isDead = false;
 
     // Minimum number of bytes the stone being filled should contain before it gets added to the
-    // deque of oplog stones.
-    int64_t _minBytesPerStone;
+    // deque of oplog stones. Set from '_configuredMinBytesPerStone', or from the observed insert
+    // rate when adaptive sizing is enabled.
+    AtomicWord<int64_t> _minBytesPerStone{0};
+
+    // The stone size derived from the oplog size. Protected by '_mutex'.
+    int64_t _configuredMinBytesPerStone = 0;
+
+    // Smoothed rate at which bytes have been inserted into the oplog, measured over the time it
+    // took to fill recent stones. Zero until two stones have been created with adaptive sizing.
+    AtomicWord<double> _insertBytesPerSec{0.0};
 
     AtomicWord<long long> _currentRecords;     // Number of records in the stone being filled.
     AtomicWord<long long> _currentBytes;       // Number of bytes in the stone being filled.
@@ -43,6 +43,7 @@
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/db/storage/wiredtiger/oplog_stone_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -489,6 +490,74 @@ TEST(WiredTigerRecordStoreTest, OplogStones_CreateNewStone) {
     }
 }
 
+StatusWith<RecordId> insertBSONWithWallTime(
+    OperationContext* opCtx, RecordStore* rs, const Timestamp& opTime, Date_t wall, int size) {
+    BSONObj objTemplate = BSON("ts" << opTime << "wall" << wall << "str"
+                                    << "");
+    ASSERT_LTE(objTemplate.objsize(), size);
+    BSONObj obj = BSON("ts" << opTime << "wall" << wall << "str"
+                            << std::string(size - objTemplate.objsize(), 'x'));
+    ASSERT_EQ(size, obj.objsize());
+
+    WriteUnitOfWork wuow(opCtx);
+    WiredTigerRecordStore* wtrs = checked_cast<WiredTigerRecordStore*>(rs);
+    Status status = wtrs->oplogDiskLocRegister(opCtx, opTime, false);
+    if (!status.isOK()) {
+        return StatusWith<RecordId>(status);
+    }
+    StatusWith<RecordId> res = rs->insertRecord(opCtx, obj.objdata(), obj.objsize(), opTime);
+    if (res.isOK()) {
+        wuow.commit();
+    }
+    return res;
+}
+
+// Insert records into an oplog with adaptive sizing enabled and verify that the stone size follows
+// the insert rate, within the bounds given by the oplog size.
+TEST(WiredTigerRecordStoreTest, OplogStones_AdaptiveSizing) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+
+    const int64_t cappedMaxSize = 100 * 1024;  // 100KB
+    unique_ptr<RecordStore> rs(
+        harnessHelper->newCappedRecordStore("local.oplog.stones", cappedMaxSize, -1));
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    oplogStones->setMinBytesPerStone(1000);
+
+    gOplogTruncationPointAdaptiveSizing.store(true);
+    ON_BLOCK_EXIT([] { gOplogTruncationPointAdaptiveSizing.store(false); });
+
+    const auto start = Date_t::fromMillisSinceEpoch(1000 * 1000);
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    // The insert rate is only known once a stone has been filled after an earlier one.
+    ASSERT_OK(insertBSONWithWallTime(opCtx.get(), rs.get(), Timestamp(1, 1), start, 1000));
+    ASSERT_EQ(1U, oplogStones->numStones());
+    ASSERT_EQ(1000, oplogStones->minBytesPerStone());
+
+    // 1000 bytes in 10 seconds is 100 bytes per second, so stones should cover 60 seconds' worth
+    // of inserts as per the default 'oplogTruncationPointTargetIntervalSecs'.
+    ASSERT_OK(insertBSONWithWallTime(
+        opCtx.get(), rs.get(), Timestamp(1, 2), start + Seconds(10), 1000));
+    ASSERT_EQ(2U, oplogStones->numStones());
+    ASSERT_EQ(6000, oplogStones->minBytesPerStone());
+
+    // A much higher insert rate is capped at the size that keeps 'minOplogTruncationPoints'.
+    ASSERT_OK(insertBSONWithWallTime(
+        opCtx.get(), rs.get(), Timestamp(1, 3), start + Seconds(11), 10000));
+    ASSERT_EQ(3U, oplogStones->numStones());
+    ASSERT_EQ(cappedMaxSize / 10, oplogStones->minBytesPerStone());
+
+    // Turning adaptive sizing off restores the configured stone size with the next stone.
+    gOplogTruncationPointAdaptiveSizing.store(false);
+    ASSERT_OK(insertBSONWithWallTime(
+        opCtx.get(), rs.get(), Timestamp(1, 4), start + Seconds(12), cappedMaxSize / 10));
+    ASSERT_EQ(4U, oplogStones->numStones());
+    ASSERT_EQ(1000, oplogStones->minBytesPerStone());
+}
+
 // Insert records into an oplog and try to update them. The updates shouldn't succeed if the size of
 // record is changed.
 TEST(WiredTigerRecordStoreTest, OplogStones_UpdateRecord) {
@@ -991,6 +1060,56 @@ TEST(WiredTigerRecordStoreTest, GetLatestOplogTest) {
     ASSERT_EQ(tsThree, wtrs->getLatestOplogTimestamp(op1.get()));
 }
 
+TEST(WiredTigerRecordStoreTest, InsertRecordsAssignsConsecutiveIdsToBatch) {
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 1000;
+    std::vector<std::string> data;
+    std::vector<Record> records;
+    std::vector<Timestamp> timestamps(nToInsert);
+    long long dataSize = 0;
+    for (int i = 0; i < nToInsert; i++) {
+        data.push_back(std::to_string(i));
+        dataSize += data.back().size() + 1;
+    }
+    for (const auto& str : data) {
+        records.push_back({RecordId(), RecordData(str.c_str(), str.size() + 1)});
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        // Take one id outside the batch, so the batch does not start from the beginning.
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(rs->insertRecord(opCtx.get(), "a", 2, Timestamp()).getStatus());
+            uow.commit();
+        }
+
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->insertRecords(opCtx.get(), &records, timestamps));
+        uow.commit();
+    }
+
+    for (int i = 1; i < nToInsert; i++) {
+        ASSERT_EQ(records[i - 1].id.repr() + 1, records[i].id.repr());
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    ASSERT_EQ(nToInsert + 1, rs->numRecords(opCtx.get()));
+    ASSERT_EQ(dataSize + 2, rs->dataSize(opCtx.get()));
+
+    auto cursor = rs->getCursor(opCtx.get());
+    ASSERT(cursor->next());
+    for (int i = 0; i < nToInsert; i++) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(records[i].id, record->id);
+        ASSERT_EQ(data[i], record->data.data());
+    }
+    ASSERT_FALSE(cursor->next());
+}
+
 TEST(WiredTigerRecordStoreTest, CursorInActiveTxnAfterNext) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -37,9 +37,12 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_prefetcher.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_unique_index_key_filter.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_adjuster.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
@@ -96,6 +99,21 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
                           Timestamp(_engine->getOplogManager()->getOplogReadTimestamp()));
     }
 
+    if (auto prefetcher = _engine->getPrefetcher()) {
+        BSONObjBuilder subsection(bob.subobjStart("readAhead"));
+        prefetcher->appendStats(&subsection);
+    }
+
+    if (auto ticketAdjuster = _engine->getTicketAdjuster()) {
+        BSONObjBuilder subsection(bob.subobjStart("ticketAdjustment"));
+        ticketAdjuster->appendStats(&subsection);
+    }
+
+    if (auto keyFilterBuilder = _engine->getUniqueIndexKeyFilterBuilder()) {
+        BSONObjBuilder subsection(bob.subobjStart("uniqueIndexKeyFilter"));
+        keyFilterBuilder->appendStats(&subsection);
+    }
+
     return bob.obj();
 }
 
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <string>
 
@@ -39,6 +40,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -376,9 +378,24 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // The idle sessions are split into partitions, each with its own lock, so that threads getting
+    // and releasing sessions do not all contend on a single mutex. Each thread is assigned a
+    // partition which it returns its sessions to, and takes sessions from other partitions only
+    // when its own is empty.
+    static constexpr size_t kNumSessionCachePartitions = 16;
+
+    struct SessionCachePartition {
+        Mutex cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::SessionCachePartition");
+        SessionCache sessions;
+
+        // The number of sessions in 'sessions', which can be read without holding 'cacheLock' to
+        // skip empty partitions.
+        AtomicWord<size_t> numSessions{0};
+    };
+
+    std::array<CacheAligned<SessionCachePartition>, kNumSessionCachePartitions> _partitions;
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -415,6 +432,11 @@ private:
      * session and releasing it, the session is directly released. This method is thread safe.
      */
     void releaseSession(WiredTigerSession* session);
+
+    /**
+     * Returns the index of the partition of the idle sessions assigned to the calling thread.
+     */
+    static size_t _getPartitionIndexForThisThread();
 };
 
 /**
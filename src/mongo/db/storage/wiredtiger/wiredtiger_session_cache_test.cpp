@@ -29,12 +29,14 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -113,4 +115,58 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, SessionsReleasedByOtherThreadsAreReused) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Each thread returns its session to the partition it is assigned, which need not be the one
+    // assigned to this thread.
+    const size_t numThreads = 20;
+    std::vector<WiredTigerSession*> released;
+    {
+        std::vector<UniqueWiredTigerSession> sessions;
+        for (size_t i = 0; i < numThreads; ++i) {
+            sessions.push_back(sessionCache->getSession());
+            released.push_back(sessions.back().get());
+        }
+        std::vector<stdx::thread> threads;
+        for (auto& session : sessions) {
+            threads.emplace_back([&session] { session.reset(); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numThreads);
+
+    // All of the idle sessions are handed out again before any new session is opened.
+    std::vector<UniqueWiredTigerSession> reused;
+    for (size_t i = 0; i < numThreads; ++i) {
+        reused.push_back(sessionCache->getSession());
+        ASSERT(std::find(released.begin(), released.end(), reused.back().get()) != released.end());
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, CloseAllEmptiesEveryPartition) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < 20; ++i) {
+        threads.emplace_back([sessionCache] { sessionCache->getSession(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_GT(sessionCache->getIdleSessionsCount(), 0U);
+
+    // A session from before closeAll() is not returned to the cache.
+    auto oldSession = sessionCache->getSession();
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    oldSession.reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
 }  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
@@ -103,6 +104,13 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
     }
 
     stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    {
+        // The entry may have been moved out of the buffer, but not written to the table yet.
+        Buffer::const_iterator it = _flushQueue.find(uri);
+        if (it != _flushQueue.end())
+            return it->second;
+    }
+
     // Intentionally ignoring return value.
     ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
 
@@ -131,59 +139,107 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
+    Timer t;
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    _moveBufferToFlushQueue_inlock();
+    if (_flushQueue.empty())
+        return;  // Nothing to do.
+
+    const size_t maxEntries = static_cast<size_t>(gWiredTigerSizeStorerMaxEntriesPerFlush.load());
+    while (!_flushQueue.empty()) {
+        // Only the last transaction needs to sync, as syncing it also makes the earlier ones
+        // durable.
+        _writeFlushQueue_inlock(syncToDisk && _flushQueue.size() <= maxEntries, maxEntries);
+    }
+
+    auto micros = t.micros();
+    LOGV2_DEBUG(22426, 2, "WiredTigerSizeStorer flush took {micros} µs", "micros"_attr = micros);
+}
+
+void WiredTigerSizeStorer::flushIncremental() {
+    stdx::unique_lock<Latch> cursorLock(_cursorMutex, stdx::try_to_lock);
+    if (!cursorLock) {
+        return;  // Someone else is flushing.
+    }
+
+    // Only take more entries from the buffer once the earlier ones have been written, so that
+    // the oldest changes are always written first.
+    if (_flushQueue.empty()) {
+        _moveBufferToFlushQueue_inlock();
+        if (_flushQueue.empty())
+            return;  // Nothing to do.
+    }
+
+    Timer t;
+    _writeFlushQueue_inlock(false,
+                            static_cast<size_t>(gWiredTigerSizeStorerMaxEntriesPerFlush.load()));
+
+    auto micros = t.micros();
+    LOGV2_DEBUG(5698002,
+                2,
+                "WiredTigerSizeStorer incremental flush",
+                "duration"_attr = Microseconds(micros),
+                "remaining"_attr = _flushQueue.size());
+}
+
+void WiredTigerSizeStorer::_moveBufferToFlushQueue_inlock() {
     Buffer buffer;
     {
         stdx::lock_guard<Latch> bufferLock(_bufferMutex);
         _buffer.swap(buffer);
     }
 
-    if (buffer.empty())
-        return;  // Nothing to do.
-
-    Timer t;
-    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
-    {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
-            }
-        });
-
-        WT_SESSION* session = _session.getSession();
-        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
-
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-
-            // Ordering is important here: when the store method checks if the SizeInfo
-            // is dirty and it returns true, the current values of numRecords and dataSize must
-            // still be written back. So, the required order is to clear the dirty flag first.
-            SizeInfo& sizeInfo = *it->second;
-            sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
-
-            auto& uri = it->first;
-            LOGV2_DEBUG(22425,
-                        2,
-                        "WiredTigerSizeStorer::flush {uri} -> {data}",
-                        "uri"_attr = uri,
-                        "data"_attr = redact(data));
-            WiredTigerItem key(uri.c_str(), uri.size());
-            WiredTigerItem value(data.objdata(), data.objsize());
-            _cursor->set_key(_cursor, key.Get());
-            _cursor->set_value(_cursor, value.Get());
-            invariantWTOK(_cursor->insert(_cursor));
+    if (_flushQueue.empty()) {
+        _flushQueue.swap(buffer);
+    } else {
+        for (auto& it : buffer) {
+            auto& entry = _flushQueue[it.first];
+            // As in store(), a new SizeInfo for the same uri replaces the queued one.
+            if (entry && entry.get() != it.second.get())
+                entry->_dirty.store(false);
+            entry = std::move(it.second);
         }
-        txnOpen.done();
-        invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
     }
+    _hasQueuedChanges.store(!_flushQueue.empty());
+}
 
-    auto micros = t.micros();
-    LOGV2_DEBUG(22426, 2, "WiredTigerSizeStorer flush took {micros} µs", "micros"_attr = micros);
+void WiredTigerSizeStorer::_writeFlushQueue_inlock(bool syncToDisk, size_t maxEntries) {
+    // Intentionally ignoring return value.
+    ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
+
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+
+    std::vector<Buffer::iterator> written;
+    for (auto it = _flushQueue.begin(); it != _flushQueue.end() && written.size() < maxEntries;
+         ++it) {
+        // Ordering is important here: when the store method checks if the SizeInfo
+        // is dirty and it returns true, the current values of numRecords and dataSize must
+        // still be written back. So, the required order is to clear the dirty flag first.
+        SizeInfo& sizeInfo = *it->second;
+        sizeInfo._dirty.store(false);
+        BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
+                                         << sizeInfo.dataSize.load());
+
+        auto& uri = it->first;
+        LOGV2_DEBUG(22425,
+                    2,
+                    "WiredTigerSizeStorer::flush {uri} -> {data}",
+                    "uri"_attr = uri,
+                    "data"_attr = redact(data));
+        WiredTigerItem key(uri.c_str(), uri.size());
+        WiredTigerItem value(data.objdata(), data.objsize());
+        _cursor->set_key(_cursor, key.Get());
+        _cursor->set_value(_cursor, value.Get());
+        invariantWTOK(_cursor->insert(_cursor));
+        written.push_back(it);
+    }
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
+
+    // Erasing an element does not invalidate iterators to the other elements.
+    for (auto it : written)
+        _flushQueue.erase(it);
+    _hasQueuedChanges.store(!_flushQueue.empty());
 }
 }  // namespace mongo
@@ -51,6 +51,11 @@ namespace mongo {
  * in size updates to be lost, so size information is only approximate. Reads use the buffer for
  * pending stores, or otherwise read directly from the WiredTiger table using a dedicated session
  * and cursor.
+ *
+ * Writing back happens in two stages: the buffer is first moved to a flush queue, which is then
+ * written to the table in transactions of at most 'wiredTigerSizeStorerMaxEntriesPerFlush'
+ * entries. The periodic flush only writes one such transaction at a time, so that a backlog of
+ * dirty entries is spread over several calls instead of stalling a single one.
  */
 class WiredTigerSizeStorer {
 public:
@@ -94,17 +99,47 @@ public:
      */
     void flush(bool syncToDisk);
 
+    /**
+     * Writes at most 'wiredTigerSizeStorerMaxEntriesPerFlush' changes to the underlying table,
+     * without syncing to disk. Returns immediately if another flush is in progress.
+     */
+    void flushIncremental();
+
+    /**
+     * Returns true if there are changes that an earlier flushIncremental() has not yet written.
+     */
+    bool hasQueuedChanges() const {
+        return _hasQueuedChanges.load();
+    }
+
 private:
+    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
+
+    /**
+     * Moves the contents of the buffer into the flush queue, replacing any older queued SizeInfo
+     * for the same uri. Requires _cursorMutex.
+     */
+    void _moveBufferToFlushQueue_inlock();
+
+    /**
+     * Writes up to 'maxEntries' entries of the flush queue in one transaction and removes them
+     * from the queue. Entries stay queued if the transaction fails. Requires _cursorMutex.
+     */
+    void _writeFlushQueue_inlock(bool syncToDisk, size_t maxEntries);
+
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor and _flushQueue. Acquire *before* _bufferMutex.
     mutable Mutex _cursorMutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::_cursorMutex");
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
-    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
-
     mutable Mutex _bufferMutex =
         MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
     Buffer _buffer;
+
+    // Entries taken from the buffer that have not been written to the table yet. They are still
+    // marked dirty, so stores of the same SizeInfo don't add them to the buffer again.
+    Buffer _flushQueue;
+    AtomicWord<bool> _hasQueuedChanges{false};
 };
 }  // namespace mongo
@@ -48,6 +48,7 @@
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store_test_harness.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -298,6 +299,71 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     rs.reset(nullptr);  // this has to be deleted before ss
 }
 
+TEST(WiredTigerRecordStoreTest, SizeStorerIncrementalFlush) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+
+    const int oldMaxEntriesPerFlush = gWiredTigerSizeStorerMaxEntriesPerFlush.load();
+    gWiredTigerSizeStorerMaxEntriesPerFlush.store(2);
+    ON_BLOCK_EXIT([&] { gWiredTigerSizeStorerMaxEntriesPerFlush.store(oldMaxEntriesPerFlush); });
+
+    string storageUri = WiredTigerKVEngine::kTableUriPrefix + "mySizeStorer";
+    const bool readOnly = false;
+    WiredTigerSizeStorer ss(harnessHelper->conn(), storageUri, readOnly);
+
+    const int N = 5;
+    std::vector<string> uris;
+    std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> sizeInfos;
+    for (int i = 0; i < N; i++) {
+        uris.push_back(WiredTigerKVEngine::kTableUriPrefix + "coll" + std::to_string(i));
+        sizeInfos.push_back(std::make_shared<WiredTigerSizeStorer::SizeInfo>(i + 1, 10 * (i + 1)));
+        ss.store(uris.back(), sizeInfos.back());
+    }
+
+    auto countWritten = [&] {
+        WiredTigerSizeStorer reader(harnessHelper->conn(), storageUri, readOnly);
+        int written = 0;
+        for (int i = 0; i < N; i++) {
+            auto info = reader.load(uris[i]);
+            if (info->numRecords.load() != 0) {
+                ASSERT_EQUALS(i + 1, info->numRecords.load());
+                ASSERT_EQUALS(10 * (i + 1), info->dataSize.load());
+                written++;
+            }
+        }
+        return written;
+    };
+
+    // Each incremental flush writes at most two entries.
+    ss.flushIncremental();
+    ASSERT_TRUE(ss.hasQueuedChanges());
+    ASSERT_EQUALS(2, countWritten());
+
+    // Entries that are queued but not written yet are still visible through the size storer.
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQUALS(sizeInfos[i], ss.load(uris[i]));
+    }
+
+    ss.flushIncremental();
+    ASSERT_TRUE(ss.hasQueuedChanges());
+    ASSERT_EQUALS(4, countWritten());
+
+    ss.flushIncremental();
+    ASSERT_FALSE(ss.hasQueuedChanges());
+    ASSERT_EQUALS(N, countWritten());
+
+    // A full flush writes everything, regardless of the number of entries per transaction.
+    for (int i = 0; i < N; i++) {
+        sizeInfos[i]->numRecords.store(100 + i);
+        ss.store(uris[i], sizeInfos[i]);
+    }
+    ss.flush(false);
+    ASSERT_FALSE(ss.hasQueuedChanges());
+    WiredTigerSizeStorer reader(harnessHelper->conn(), storageUri, readOnly);
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQUALS(100 + i, reader.load(uris[i])->numRecords.load());
+    }
+}
+
 class SizeStorerUpdateTest : public mongo::unittest::Test {
 private:
     virtual void setUp() {
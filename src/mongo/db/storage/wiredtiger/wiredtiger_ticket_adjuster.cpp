@@ -0,0 +1,189 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_adjuster.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/ticketholder.h"
+
+namespace mongo {
+namespace {
+
+// WiredTiger's default eviction_trigger: past this fill ratio application threads start evicting.
+constexpr double kCacheFullRatio = 0.95;
+
+}  // namespace
+
+int WiredTigerTicketAdjuster::nextTicketCount(int current,
+                                              const Sample& sample,
+                                              int minTickets,
+                                              int maxTickets) {
+    int next = current;
+    if (sample.cachePressure) {
+        next = current - std::max(1, current / 4);
+    } else if (sample.queued > 0 || sample.newlyQueued > 0) {
+        next = current + std::max(1, current / 16);
+    }
+    return std::max(minTickets, std::min(maxTickets, next));
+}
+
+WiredTigerTicketAdjuster::WiredTigerTicketAdjuster(WiredTigerSessionCache* sessionCache,
+                                                   TicketHolder* readTickets,
+                                                   TicketHolder* writeTickets)
+    : BackgroundJob(false /* deleteSelf */),
+      _sessionCache(sessionCache),
+      _readTickets(readTickets),
+      _writeTickets(writeTickets) {}
+
+void WiredTigerTicketAdjuster::run() {
+    ThreadClient tc(name(), getGlobalServiceContext());
+    LOGV2_DEBUG(5406200, 1, "starting {name} thread", "name"_attr = name());
+
+    while (!_shuttingDown.load()) {
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            MONGO_IDLE_THREAD_BLOCK;
+            _condvar.wait_for(lock,
+                              Milliseconds(gWiredTigerTicketAdjustmentIntervalMS.load())
+                                  .toSystemDuration(),
+                              [&] { return _shuttingDown.load(); });
+        }
+        if (_shuttingDown.load() || !gWiredTigerTicketAdjustmentEnabled.load()) {
+            // Restart from fresh counters when the adjuster is re-enabled.
+            _lastAppEvictions = -1;
+            _lastReadQueued = _readTickets->totalQueued();
+            _lastWriteQueued = _writeTickets->totalQueued();
+            continue;
+        }
+
+        const bool cachePressure = _sampleCachePressure();
+        if (cachePressure) {
+            _intervalsUnderPressure.fetchAndAdd(1);
+        }
+        _adjust(_readTickets, &_lastReadQueued, cachePressure);
+        _adjust(_writeTickets, &_lastWriteQueued, cachePressure);
+    }
+    LOGV2_DEBUG(5406201, 1, "stopping {name} thread", "name"_attr = name());
+}
+
+bool WiredTigerTicketAdjuster::_sampleCachePressure() {
+    auto session = _sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+    auto readStat = [&](int key) -> long long {
+        auto result =
+            WiredTigerUtil::getStatisticsValue(s, "statistics:", "statistics=(fast)", key);
+        return result.isOK() ? result.getValue() : -1;
+    };
+
+    const long long appEvictions = readStat(WT_STAT_CONN_CACHE_EVICTION_APP);
+    const long long bytesInUse = readStat(WT_STAT_CONN_CACHE_BYTES_INUSE);
+    const long long bytesMax = readStat(WT_STAT_CONN_CACHE_BYTES_MAX);
+
+    // The first sample only establishes the eviction baseline.
+    const bool evictingInForeground = _lastAppEvictions >= 0 && appEvictions > _lastAppEvictions;
+    _lastAppEvictions = appEvictions;
+
+    const bool cacheFull = bytesInUse >= 0 && bytesMax > 0 &&
+        static_cast<double>(bytesInUse) / bytesMax >= kCacheFullRatio;
+
+    return evictingInForeground || cacheFull;
+}
+
+void WiredTigerTicketAdjuster::_adjust(TicketHolder* tickets,
+                                       long long* lastTotalQueued,
+                                       bool cachePressure) {
+    Sample sample;
+    sample.queued = tickets->queued();
+    const long long totalQueued = tickets->totalQueued();
+    sample.newlyQueued = totalQueued - *lastTotalQueued;
+    *lastTotalQueued = totalQueued;
+    sample.cachePressure = cachePressure;
+
+    const int current = tickets->outof();
+    const int next = nextTicketCount(current,
+                                     sample,
+                                     gWiredTigerTicketAdjustmentMinTickets.load(),
+                                     gWiredTigerTicketAdjustmentMaxTickets.load());
+    if (next == current) {
+        return;
+    }
+
+    // Shrinking waits for the tickets being given up to be released, which bounds how quickly the
+    // pool can follow the controller but never revokes a ticket that is in use.
+    auto status = tickets->resize(next);
+    if (!status.isOK()) {
+        LOGV2_WARNING(5406202,
+                      "Failed to resize ticket pool",
+                      "from"_attr = current,
+                      "to"_attr = next,
+                      "error"_attr = status);
+        return;
+    }
+    (next > current ? _increases : _decreases).fetchAndAdd(1);
+    LOGV2_DEBUG(5406203,
+                2,
+                "Resized ticket pool",
+                "from"_attr = current,
+                "to"_attr = next,
+                "queued"_attr = sample.queued,
+                "newlyQueued"_attr = sample.newlyQueued,
+                "cachePressure"_attr = cachePressure);
+}
+
+void WiredTigerTicketAdjuster::shutdown() {
+    _shuttingDown.store(true);
+    {
+        stdx::unique_lock<Latch> lock(_mutex);
+        _condvar.notify_one();
+    }
+    wait();
+}
+
+void WiredTigerTicketAdjuster::appendStats(BSONObjBuilder* builder) const {
+    builder->append("enabled", gWiredTigerTicketAdjustmentEnabled.load());
+    builder->append("intervalsUnderCachePressure", _intervalsUnderPressure.load());
+    builder->append("increases", _increases.load());
+    builder->append("decreases", _decreases.load());
+}
+
+}  // namespace mongo
@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/background.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class TicketHolder;
+class WiredTigerSessionCache;
+
+/**
+ * Resizes the read and write ticket pools from what the storage engine is doing, instead of
+ * leaving them at the static wiredTigerConcurrent{Read,Write}Transactions values.
+ *
+ * Once per interval the adjuster samples each pool's queueing counters and the WiredTiger cache
+ * statistics. Under cache pressure, i.e. application threads being drafted into eviction or the
+ * cache filling up to its eviction trigger, both pools shrink by a quarter, since admitting more
+ * operations only adds to the pages competing for the cache. Otherwise a pool that had operations
+ * waiting for a ticket grows by a sixteenth, and an idle pool is left alone. Pools never leave the
+ * [wiredTigerTicketAdjustmentMinTickets, wiredTigerTicketAdjustmentMaxTickets] range.
+ *
+ * The adjuster does nothing while wiredTigerTicketAdjustmentEnabled is false. Setting a pool size
+ * by hand while it is enabled just gives it a new starting point.
+ */
+class WiredTigerTicketAdjuster : public BackgroundJob {
+public:
+    /**
+     * What one interval looked like for a single pool.
+     */
+    struct Sample {
+        // Operations waiting for a ticket when the sample was taken.
+        int queued = 0;
+        // Acquisitions that had to wait for a ticket during the interval.
+        long long newlyQueued = 0;
+        // Whether the WiredTiger cache was under eviction pressure during the interval.
+        bool cachePressure = false;
+    };
+
+    /**
+     * Returns the size a pool of 'current' tickets should have after the interval described by
+     * 'sample', clamped to [minTickets, maxTickets].
+     */
+    static int nextTicketCount(int current, const Sample& sample, int minTickets, int maxTickets);
+
+    WiredTigerTicketAdjuster(WiredTigerSessionCache* sessionCache,
+                             TicketHolder* readTickets,
+                             TicketHolder* writeTickets);
+
+    std::string name() const override {
+        return "WTTicketAdjuster";
+    }
+
+    void run() override;
+
+    /**
+     * Stops the adjuster and waits for its thread to exit. Must be called before the session cache
+     * shuts down.
+     */
+    void shutdown();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    /**
+     * Returns whether the WiredTiger cache is under eviction pressure, judged by how many pages
+     * application threads evicted since the previous call and how full the cache is.
+     */
+    bool _sampleCachePressure();
+
+    void _adjust(TicketHolder* tickets, long long* lastTotalQueued, bool cachePressure);
+
+    WiredTigerSessionCache* const _sessionCache;  // not owned
+    TicketHolder* const _readTickets;             // not owned
+    TicketHolder* const _writeTickets;            // not owned
+
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketAdjuster::_mutex");  // protects _condvar
+    // The adjuster idles on this condition variable between samples. It is notified on shutdown.
+    stdx::condition_variable _condvar;
+
+    // Only accessed by the adjuster thread.
+    long long _lastAppEvictions = -1;
+    long long _lastReadQueued = 0;
+    long long _lastWriteQueued = 0;
+
+    AtomicWord<long long> _intervalsUnderPressure{0};
+    AtomicWord<long long> _increases{0};
+    AtomicWord<long long> _decreases{0};
+};
+
+}  // namespace mongo
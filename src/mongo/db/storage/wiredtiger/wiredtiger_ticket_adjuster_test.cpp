@@ -0,0 +1,79 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_adjuster.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Sample = WiredTigerTicketAdjuster::Sample;
+
+Sample makeSample(int queued, long long newlyQueued, bool cachePressure) {
+    Sample sample;
+    sample.queued = queued;
+    sample.newlyQueued = newlyQueued;
+    sample.cachePressure = cachePressure;
+    return sample;
+}
+
+int next(int current, const Sample& sample) {
+    return WiredTigerTicketAdjuster::nextTicketCount(current, sample, 16, 512);
+}
+
+TEST(WiredTigerTicketAdjusterTest, IdlePoolIsLeftAlone) {
+    ASSERT_EQ(128, next(128, makeSample(0, 0, false)));
+}
+
+TEST(WiredTigerTicketAdjusterTest, QueueingGrowsPool) {
+    ASSERT_EQ(136, next(128, makeSample(3, 0, false)));
+    ASSERT_EQ(136, next(128, makeSample(0, 7, false)));
+    // Small pools still grow.
+    ASSERT_EQ(9, WiredTigerTicketAdjuster::nextTicketCount(8, makeSample(1, 1, false), 5, 512));
+}
+
+TEST(WiredTigerTicketAdjusterTest, CachePressureShrinksPoolEvenWhenQueued) {
+    ASSERT_EQ(96, next(128, makeSample(0, 0, true)));
+    ASSERT_EQ(96, next(128, makeSample(50, 900, true)));
+}
+
+TEST(WiredTigerTicketAdjusterTest, PoolStaysWithinBounds) {
+    ASSERT_EQ(16, next(18, makeSample(0, 0, true)));
+    ASSERT_EQ(512, next(510, makeSample(1, 1, false)));
+    // A pool configured outside the bounds is brought back into them on the next interval.
+    ASSERT_EQ(512, next(1000, makeSample(0, 0, false)));
+    ASSERT_EQ(16, next(8, makeSample(0, 0, false)));
+}
+
+}  // namespace
+}  // namespace mongo
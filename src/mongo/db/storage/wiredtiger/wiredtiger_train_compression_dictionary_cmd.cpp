@@ -0,0 +1,146 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_compressor.h"
+
+namespace mongo {
+namespace {
+
+const long long kDefaultSampleSize = 1000;
+const long long kDefaultMaxDictionaryBytes = 16 * 1024;
+const long long kMaxDictionaryBytesLimit = 1024 * 1024;
+
+/**
+ * Trains a record compression dictionary from a random sample of a collection's documents:
+ *   {
+ *       trainCompressionDictionary: "collectionNameWithoutTheDBPart",
+ *       sampleSize: <int>,  // Number of documents to sample. Defaults to 1000.
+ *       maxDictionaryBytes: <int>,  // Upper bound on the dictionary size. Defaults to 16KB.
+ *   }
+ *
+ * The returned dictionary can be passed to a new collection as
+ * { storageEngine: { wiredTiger: { compressionDictionary: <dictionary> } } }.
+ */
+class CmdTrainCompressionDictionary : public BasicCommand {
+public:
+    CmdTrainCompressionDictionary() : BasicCommand("trainCompressionDictionary") {}
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    std::string help() const override {
+        return "Trains a record compression dictionary from a sample of a collection.\n"
+               "{ trainCompressionDictionary: <collection>, sampleSize: <int>, "
+               "maxDictionaryBytes: <int> }";
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    bool maintenanceOk() const override {
+        return false;
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) const override {
+        ActionSet actions;
+        actions.addAction(ActionType::find);
+        out->push_back(Privilege(parseResourcePattern(dbname, cmdObj), actions));
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+
+        long long sampleSize = kDefaultSampleSize;
+        if (auto elem = cmdObj["sampleSize"]) {
+            uassert(ErrorCodes::BadValue,
+                    "'sampleSize' must be a positive number",
+                    elem.isNumber() && elem.safeNumberLong() > 0);
+            sampleSize = elem.safeNumberLong();
+        }
+
+        long long maxDictionaryBytes = kDefaultMaxDictionaryBytes;
+        if (auto elem = cmdObj["maxDictionaryBytes"]) {
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "'maxDictionaryBytes' must be a number between 1 and "
+                                  << kMaxDictionaryBytesLimit,
+                    elem.isNumber() && elem.safeNumberLong() > 0 &&
+                        elem.safeNumberLong() <= kMaxDictionaryBytesLimit);
+            maxDictionaryBytes = elem.safeNumberLong();
+        }
+
+        std::vector<std::string> samples;
+        {
+            AutoGetCollectionForReadCommand collection(opCtx, nss);
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << nss << " does not exist",
+                    collection);
+
+            // Fall back to a forward scan for record stores without random cursors, in which case
+            // the sample is the beginning of the collection.
+            auto rs = collection->getRecordStore();
+            auto cursor = rs->getRandomCursor(opCtx);
+            if (!cursor) {
+                cursor = rs->getCursor(opCtx);
+            }
+            while (static_cast<long long>(samples.size()) < sampleSize) {
+                auto record = cursor->next();
+                if (!record) {
+                    break;
+                }
+                samples.emplace_back(record->data.data(), record->data.size());
+            }
+        }
+
+        auto dictionary = uassertStatusOK(
+            WiredTigerRecordCompressor::trainDictionary(samples, maxDictionaryBytes));
+        WiredTigerRecordCompressor compressor(
+            ConstDataRange(dictionary.data(), dictionary.size()));
+
+        result.appendBinData("dictionary", dictionary.size(), BinDataGeneral, dictionary.data());
+        result.append("dictionaryId", static_cast<long long>(compressor.getDictionaryId()));
+        result.append("samples", static_cast<long long>(samples.size()));
+        return true;
+    }
+} cmdTrainCompressionDictionary;
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,202 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_unique_index_key_filter.h"
+
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+constexpr size_t kBitsPerWord = 64;
+
+ThreadPool::Options makePoolOptions() {
+    ThreadPool::Options options;
+    options.poolName = "WiredTigerUniqueIndexKeyFilterBuilder";
+    options.threadNamePrefix = "WTKeyFilter-";
+    options.minThreads = 0;
+    options.maxThreads = 1;
+    return options;
+}
+
+}  // namespace
+
+WiredTigerUniqueIndexKeyFilter::WiredTigerUniqueIndexKeyFilter(size_t numBytes)
+    : _numBits(std::max(numBytes * 8, kBitsPerWord) / kBitsPerWord * kBitsPerWord),
+      _words(new AtomicWord<unsigned long long>[_numBits / kBitsPerWord]) {}
+
+bool WiredTigerUniqueIndexKeyFilter::add(const void* key, size_t size) {
+    // Completeness must be observed before any bit is tested, or a key the scan adds in between
+    // could be reported as new.
+    const bool complete = isComplete();
+
+    uint64_t hash[2];
+    MurmurHash3_x64_128(key, size, 0, hash);
+    bool contained = true;
+    for (int i = 0; i < kNumProbes; ++i) {
+        const size_t bit = (hash[0] + i * hash[1]) % _numBits;
+        const unsigned long long mask = 1ULL << (bit % kBitsPerWord);
+        if (!(_words[bit / kBitsPerWord].fetchAndBitOr(mask) & mask)) {
+            contained = false;
+        }
+    }
+    return complete && !contained;
+}
+
+bool WiredTigerUniqueIndexKeyFilter::mayContain(const void* key, size_t size) const {
+    if (!isComplete()) {
+        return true;
+    }
+
+    uint64_t hash[2];
+    MurmurHash3_x64_128(key, size, 0, hash);
+    for (int i = 0; i < kNumProbes; ++i) {
+        const size_t bit = (hash[0] + i * hash[1]) % _numBits;
+        if (!(_words[bit / kBitsPerWord].load() & (1ULL << (bit % kBitsPerWord)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+WiredTigerUniqueIndexKeyFilterBuilder::WiredTigerUniqueIndexKeyFilterBuilder(
+    WiredTigerSessionCache* sessionCache, size_t filterBytes)
+    : _sessionCache(sessionCache), _filterBytes(filterBytes), _pool(makePoolOptions()) {
+    _pool.startup();
+}
+
+WiredTigerUniqueIndexKeyFilterBuilder::~WiredTigerUniqueIndexKeyFilterBuilder() {
+    shutdown();
+}
+
+std::shared_ptr<WiredTigerUniqueIndexKeyFilter> WiredTigerUniqueIndexKeyFilterBuilder::makeFilter(
+    const std::string& uri) {
+    auto filter = std::make_shared<WiredTigerUniqueIndexKeyFilter>(_filterBytes);
+    _filtersCreated.fetchAndAdd(1);
+
+    // The scan only holds a weak reference, so that dropping the index frees its filter even if the
+    // scan has not started yet.
+    std::weak_ptr<WiredTigerUniqueIndexKeyFilter> weakFilter = filter;
+    _pool.schedule([this, weakFilter, uri](Status status) {
+        if (!status.isOK()) {
+            // The pool is shutting down and is draining its queue without running the tasks.
+            return;
+        }
+        if (auto filter = weakFilter.lock()) {
+            _fill(filter.get(), uri);
+        }
+    });
+    return filter;
+}
+
+void WiredTigerUniqueIndexKeyFilterBuilder::_fill(WiredTigerUniqueIndexKeyFilter* filter,
+                                                  const std::string& uri) {
+    if (_shuttingDown.load() || filter->isAbandoned()) {
+        return;
+    }
+
+    auto session = _sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+
+    // Cursors are opened directly rather than through the session's cursor cache, because the
+    // table may have been dropped since the scan was scheduled and that must not be fatal here.
+    WT_CURSOR* c = nullptr;
+    if (s->open_cursor(s, uri.c_str(), nullptr, nullptr, &c) != 0) {
+        return;
+    }
+    ON_BLOCK_EXIT([&] { c->close(c); });
+
+    // Reading uncommitted data sees every key any transaction has written without holding a
+    // snapshot open for the length of the scan. Keys written after the scan passes them, and keys
+    // of prepared transactions, were added to the filter by the writer.
+    if (s->begin_transaction(s, "isolation=read-uncommitted,ignore_prepare=true") != 0) {
+        return;
+    }
+    ON_BLOCK_EXIT([&] { s->rollback_transaction(s, nullptr); });
+
+    long long keysScanned = 0;
+    ON_BLOCK_EXIT([&] { _keysScanned.fetchAndAdd(keysScanned); });
+
+    int ret;
+    while ((ret = c->next(c)) == 0) {
+        if (_shuttingDown.load() || filter->isAbandoned()) {
+            return;
+        }
+
+        WT_ITEM key;
+        if (c->get_key(c, &key) != 0) {
+            return;
+        }
+        filter->add(key.data, KeyString::sizeWithoutRecordIdAtEnd(key.data, key.size));
+        ++keysScanned;
+    }
+
+    // Any error leaves the filter incomplete, in which case the index never consults it.
+    if (ret != WT_NOTFOUND) {
+        LOGV2_DEBUG(5698100,
+                    1,
+                    "Failed to fill unique index key filter",
+                    "uri"_attr = uri,
+                    "error"_attr = wiredtiger_strerror(ret));
+        return;
+    }
+
+    filter->markComplete();
+    _filtersCompleted.fetchAndAdd(1);
+}
+
+void WiredTigerUniqueIndexKeyFilterBuilder::shutdown() {
+    if (_shuttingDown.swap(true)) {
+        return;
+    }
+    LOGV2(5698101, "Shutting down WiredTiger unique index key filter builder");
+    _pool.shutdown();
+    _pool.join();
+}
+
+void WiredTigerUniqueIndexKeyFilterBuilder::appendStats(BSONObjBuilder* builder) const {
+    builder->append("filters created", _filtersCreated.load());
+    builder->append("filters completed", _filtersCompleted.load());
+    builder->append("keys scanned", _keysScanned.load());
+    builder->append("duplicate key seeks skipped", _seeksSkipped.load());
+}
+
+}  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class WiredTigerSessionCache;
+
+/**
+ * A Bloom filter over the keys of a unique index, without their RecordIds. Once the filter is
+ * complete, a key it does not contain is definitely not in the index, so an insert can skip the
+ * seek that looks for a duplicate of it.
+ *
+ * The index adds every key to the filter before writing it, and a background scan adds the keys
+ * that were already in the table when the index was opened. Only once that scan has finished is
+ * the filter complete. Keys are never removed, so deletes and rollbacks only make the filter less
+ * selective, never wrong.
+ */
+class WiredTigerUniqueIndexKeyFilter {
+    WiredTigerUniqueIndexKeyFilter(const WiredTigerUniqueIndexKeyFilter&) = delete;
+    WiredTigerUniqueIndexKeyFilter& operator=(const WiredTigerUniqueIndexKeyFilter&) = delete;
+
+public:
+    explicit WiredTigerUniqueIndexKeyFilter(size_t numBytes);
+
+    /**
+     * Adds 'key' to the filter. Returns true if the filter was complete and did not already contain
+     * 'key', which proves that no entry with that key was in the index before this call.
+     */
+    bool add(const void* key, size_t size);
+
+    /**
+     * Returns false only if the filter is complete and 'key' was never added to it.
+     */
+    bool mayContain(const void* key, size_t size) const;
+
+    bool isComplete() const {
+        return _complete.load();
+    }
+
+    void markComplete() {
+        _complete.store(true);
+    }
+
+    /**
+     * Called when the index is destroyed, to stop a scan that is still filling the filter.
+     */
+    void abandon() {
+        _abandoned.store(true);
+    }
+
+    bool isAbandoned() const {
+        return _abandoned.load();
+    }
+
+private:
+    // A handful of probes keeps the false positive rate low across a wide range of keys per bit,
+    // since the number of keys an index will hold is not known when its filter is sized.
+    static constexpr int kNumProbes = 4;
+
+    const size_t _numBits;
+    std::unique_ptr<AtomicWord<unsigned long long>[]> _words;
+
+    AtomicWord<bool> _complete{false};
+    AtomicWord<bool> _abandoned{false};
+};
+
+/**
+ * Creates the key filters of unique indexes and fills them from the existing keys of their tables
+ * on a background thread.
+ */
+class WiredTigerUniqueIndexKeyFilterBuilder {
+    WiredTigerUniqueIndexKeyFilterBuilder(const WiredTigerUniqueIndexKeyFilterBuilder&) = delete;
+    WiredTigerUniqueIndexKeyFilterBuilder& operator=(const WiredTigerUniqueIndexKeyFilterBuilder&) =
+        delete;
+
+public:
+    WiredTigerUniqueIndexKeyFilterBuilder(WiredTigerSessionCache* sessionCache, size_t filterBytes);
+    ~WiredTigerUniqueIndexKeyFilterBuilder();
+
+    /**
+     * Returns a new filter for the unique index stored in the table 'uri', and schedules the scan
+     * that completes it. The filter must be given every key inserted into the index from now on.
+     */
+    std::shared_ptr<WiredTigerUniqueIndexKeyFilter> makeFilter(const std::string& uri);
+
+    /**
+     * Called by an index each time its filter saves it a duplicate key seek.
+     */
+    void recordSkippedSeek() {
+        _seeksSkipped.fetchAndAddRelaxed(1);
+    }
+
+    /**
+     * Stops the scans in progress, leaving their filters incomplete, and waits for the background
+     * thread to exit. Must be called before the session cache shuts down.
+     */
+    void shutdown();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    void _fill(WiredTigerUniqueIndexKeyFilter* filter, const std::string& uri);
+
+    WiredTigerSessionCache* const _sessionCache;  // not owned
+    const size_t _filterBytes;
+    ThreadPool _pool;
+
+    AtomicWord<bool> _shuttingDown{false};
+
+    AtomicWord<long long> _filtersCreated{0};
+    AtomicWord<long long> _filtersCompleted{0};
+    AtomicWord<long long> _keysScanned{0};
+    AtomicWord<long long> _seeksSkipped{0};
+};
+
+}  // namespace mongo
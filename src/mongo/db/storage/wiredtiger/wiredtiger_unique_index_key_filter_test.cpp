@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_unique_index_key_filter.h"
+
+#include <string>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+bool add(WiredTigerUniqueIndexKeyFilter* filter, const std::string& key) {
+    return filter->add(key.data(), key.size());
+}
+
+bool mayContain(const WiredTigerUniqueIndexKeyFilter& filter, const std::string& key) {
+    return filter.mayContain(key.data(), key.size());
+}
+
+TEST(WiredTigerUniqueIndexKeyFilterTest, IncompleteFilterMayContainEveryKey) {
+    WiredTigerUniqueIndexKeyFilter filter(1024);
+    ASSERT_FALSE(add(&filter, "a"));
+    ASSERT_TRUE(mayContain(filter, "a"));
+    ASSERT_TRUE(mayContain(filter, "b"));
+}
+
+TEST(WiredTigerUniqueIndexKeyFilterTest, CompleteFilterReportsNewKeysOnce) {
+    WiredTigerUniqueIndexKeyFilter filter(1024);
+    ASSERT_FALSE(add(&filter, "existing"));
+    filter.markComplete();
+
+    ASSERT_FALSE(add(&filter, "existing"));
+    ASSERT_TRUE(add(&filter, "new"));
+    ASSERT_FALSE(add(&filter, "new"));
+    ASSERT_TRUE(mayContain(filter, "existing"));
+    ASSERT_TRUE(mayContain(filter, "new"));
+}
+
+TEST(WiredTigerUniqueIndexKeyFilterTest, CompleteFilterExcludesMostAbsentKeys) {
+    WiredTigerUniqueIndexKeyFilter filter(1024);
+    for (int i = 0; i < 500; ++i) {
+        add(&filter, "present" + std::to_string(i));
+    }
+    filter.markComplete();
+
+    int falsePositives = 0;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(mayContain(filter, "present" + std::to_string(i % 500)));
+        if (mayContain(filter, "absent" + std::to_string(i))) {
+            ++falsePositives;
+        }
+    }
+
+    // 500 keys in 8192 bits with four probes each should give about a 0.2% false positive rate.
+    ASSERT_LT(falsePositives, 50);
+}
+
+TEST(WiredTigerUniqueIndexKeyFilterTest, TinyFilterIsStillUsable) {
+    WiredTigerUniqueIndexKeyFilter filter(0);
+    filter.markComplete();
+    ASSERT_TRUE(add(&filter, "a"));
+    ASSERT_TRUE(mayContain(filter, "a"));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -697,6 +697,19 @@ bool WiredTigerUtil::useTableLogging(NamespaceString ns, bool replEnabled) {
 }
 
 Status WiredTigerUtil::setTableLogging(OperationContext* opCtx, const std::string& uri, bool on) {
+    {
+        // During startup, once the first table has been checked and found to have the expected
+        // logging settings, no other table will be altered. Return early in that case so that
+        // opening every collection and index does not pay for sweeping the session cache and
+        // opening a dedicated session.
+        stdx::lock_guard<Latch> lk(_tableLoggingInfoMutex);
+        if (_tableLoggingInfo.isInitializing && !_tableLoggingInfo.isFirstTable &&
+            !_tableLoggingInfo.changeTableLogging &&
+            !_tableLoggingInfo.hasPreviouslyIncompleteTableChecks && !storageGlobalParams.repair) {
+            return Status::OK();
+        }
+    }
+
     // Try to close as much as possible to avoid EBUSY errors.
     WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(uri);
     WiredTigerSessionCache* sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
@@ -31,8 +31,14 @@
 
 #include "mongo/db/timeseries/bucket_catalog.h"
 
+#include <absl/hash/hash.h>
+
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_request.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/views/view_catalog.h"
 
 namespace mongo {
@@ -45,7 +51,8 @@ BSONObj BucketCatalog::CommitData::toBSON() const {
                        << "numCommittedMeasurements" << int(numCommittedMeasurements)
                        << "newFieldNamesToBeInserted"
                        << std::set<std::string>(newFieldNamesToBeInserted.begin(),
-                                                newFieldNamesToBeInserted.end()));
+                                                newFieldNamesToBeInserted.end())
+                       << "closed" << closed);
 }
 
 BucketCatalog& BucketCatalog::get(ServiceContext* svcCtx) {
@@ -56,10 +63,11 @@ BucketCatalog& BucketCatalog::get(OperationContext* opCtx) {
     return get(opCtx->getServiceContext());
 }
 
-BSONObj BucketCatalog::getMetadata(const OID& bucketId) const {
-    stdx::lock_guard lk(_mutex);
-    auto it = _buckets.find(bucketId);
-    if (it == _buckets.cend()) {
+BSONObj BucketCatalog::getMetadata(const BucketHandle& handle) const {
+    const auto& stripe = _stripes[handle.stripe];
+    stdx::lock_guard lk(stripe.mutex);
+    auto it = stripe.buckets.find(handle.id);
+    if (it == stripe.buckets.cend()) {
         return {};
     }
     const auto& bucket = it->second;
@@ -69,13 +77,12 @@ BSONObj BucketCatalog::getMetadata(const OID& bucketId) const {
 BucketCatalog::InsertResult BucketCatalog::insert(OperationContext* opCtx,
                                                   const NamespaceString& ns,
                                                   const BSONObj& doc) {
-    stdx::lock_guard lk(_mutex);
-
     auto viewCatalog = DatabaseHolder::get(opCtx)->getViewCatalog(opCtx, ns.db());
     invariant(viewCatalog);
     auto viewDef = viewCatalog->lookup(opCtx, ns.ns());
     invariant(viewDef);
-    const auto& options = *viewDef->timeseries();
+    const auto options = *viewDef->timeseries();
+    const BucketLimits limits(options);
 
     BSONObjBuilder metadata;
     if (auto metaField = options.getMetaField()) {
@@ -87,6 +94,10 @@ BucketCatalog::InsertResult BucketCatalog::insert(OperationContext* opCtx,
     }
     auto key = std::make_pair(ns, BucketMetadata{metadata.obj()});
 
+    const auto stripeNumber = _getStripeNumber(key);
+    auto stripe = &_stripes[stripeNumber];
+    stdx::unique_lock lk(stripe->mutex);
+
     auto time = doc[options.getTimeField()].Date();
     auto createNewBucketId = [time = durationCount<Seconds>(time.toDurationSinceEpoch())] {
         auto bucketId = OID::gen();
@@ -94,85 +105,150 @@ BucketCatalog::InsertResult BucketCatalog::insert(OperationContext* opCtx,
         return bucketId;
     };
 
-    auto& stats = _executionStats[ns];
+    auto insertIntoBucket = [&](const OID& bucketId,
+                                Bucket* bucket,
+                                const StringSet& newFieldNamesToBeInserted,
+                                uint32_t sizeToBeAdded,
+                                boost::optional<OID> closedBucketId) -> InsertResult {
+        stripe->markActive(bucket);
+
+        bucket->numWriters++;
+        bucket->numMeasurements++;
+        bucket->size += sizeToBeAdded;
+        bucket->measurementsToBeInserted.push_back(doc);
+        bucket->newFieldNamesToBeInserted.insert(newFieldNamesToBeInserted.begin(),
+                                                 newFieldNamesToBeInserted.end());
+        if (bucket->ns.isEmpty()) {
+            // The namespace and metadata only need to be set if this bucket was newly created.
+            bucket->ns = ns;
+            bucket->metadata = key.second;
+        }
+        bucket->min.update(doc, options.getMetaField(), std::less<>());
+        bucket->max.update(doc, options.getMetaField(), std::greater<>());
+
+        // If there is exactly 1 uncommitted measurement, the caller is the committer. Otherwise,
+        // it is a waiter.
+        boost::optional<Future<CommitInfo>> commitInfoFuture;
+        if (bucket->numMeasurements - bucket->numCommittedMeasurements > 1) {
+            auto [promise, future] = makePromiseFuture<CommitInfo>();
+            bucket->promises[bucket->numMeasurements - 1] = std::move(promise);
+            commitInfoFuture = std::move(future);
+        }
 
-    auto it = _bucketIds.find(key);
-    if (it == _bucketIds.end()) {
-        // A bucket for this namespace and metadata pair does not yet exist.
-        it = _bucketIds.insert({std::move(key), createNewBucketId()}).first;
-        _orderedBuckets.insert({ns, it->first.second, it->second});
-        stats.numBucketsOpenedDueToMetadata++;
-    }
+        return {BucketHandle{bucketId, stripeNumber},
+                std::move(commitInfoFuture),
+                std::move(closedBucketId)};
+    };
 
-    _idleBuckets.erase(it->second);
-    auto bucket = &_buckets[it->second];
+    // Reopening reads the buckets collection, which a multi-document transaction would do at its
+    // own snapshot rather than at the latest state of the bucket.
+    bool triedReopening = opCtx->inMultiDocumentTransaction();
+    while (true) {
+        auto& stats = stripe->executionStats[ns];
+
+        StringSet newFieldNamesToBeInserted;
+        uint32_t sizeToBeAdded = 0;
+
+        auto it = stripe->bucketIds.find(key);
+        Bucket* bucket = nullptr;
+        auto fitResult = FitResult::kFits;
+        if (it != stripe->bucketIds.end()) {
+            bucket = &stripe->buckets[it->second];
+            bucket->calculateBucketFieldsAndSizeChange(
+                doc, options.getMetaField(), &newFieldNamesToBeInserted, &sizeToBeAdded);
+            fitResult = bucket->ns.isEmpty()
+                ? FitResult::kFits
+                : bucket->fits(it->second, time, sizeToBeAdded, limits);
+            if (fitResult == FitResult::kFits) {
+                return insertIntoBucket(
+                    it->second, bucket, newFieldNamesToBeInserted, sizeToBeAdded, boost::none);
+            }
+        }
 
-    StringSet newFieldNamesToBeInserted;
-    uint32_t sizeToBeAdded = 0;
-    bucket->calculateBucketFieldsAndSizeChange(
-        doc, options.getMetaField(), &newFieldNamesToBeInserted, &sizeToBeAdded);
+        // Closes the current bucket, which the measurement does not fit into. Returns its _id if
+        // it was removed from the catalog right away.
+        auto closeCurrentBucket = [&]() -> boost::optional<OID> {
+            switch (fitResult) {
+                case FitResult::kCount:
+                    stats.numBucketsClosedDueToCount++;
+                    break;
+                case FitResult::kSize:
+                    stats.numBucketsClosedDueToSize++;
+                    break;
+                case FitResult::kTimeForward:
+                    stats.numBucketsClosedDueToTimeForward++;
+                    break;
+                case FitResult::kTimeBackward:
+                    stats.numBucketsClosedDueToTimeBackward++;
+                    break;
+                case FitResult::kFits:
+                    MONGO_UNREACHABLE;
+            }
 
-    auto isBucketFull = [&]() {
-        if (bucket->numMeasurements == kTimeseriesBucketMaxCount) {
-            stats.numBucketsClosedDueToCount++;
-            return true;
-        }
-        if (bucket->size + sizeToBeAdded > kTimeseriesBucketMaxSizeBytes) {
-            stats.numBucketsClosedDueToSize++;
-            return true;
-        }
-        auto bucketTime = it->second.asDateT();
-        if (time - bucketTime >= kTimeseriesBucketMaxTimeRange) {
-            stats.numBucketsClosedDueToTimeForward++;
-            return true;
+            auto bucketId = it->second;
+            stripe->bucketIds.erase(it);
+            if (bucket->numWriters == 0) {
+                // Nothing in the full bucket is pending commit, so there is no committer left to
+                // remove it from the catalog.
+                stripe->removeBucket(bucketId);
+                return bucketId;
+            }
+            bucket->full = true;
+            return boost::none;
+        };
+
+        if (auto [archivedId, archived] = _findArchivedBucket(
+                stripe, key, doc, time, options, &newFieldNamesToBeInserted, &sizeToBeAdded);
+            archived) {
+            boost::optional<OID> closedBucketId;
+            if (fitResult != FitResult::kTimeBackward) {
+                // The current bucket, if any, will not take any more measurements, so the
+                // archived bucket takes its place. A late measurement, on the other hand, should
+                // not stop later measurements from going into the current bucket.
+                if (bucket) {
+                    closedBucketId = closeCurrentBucket();
+                }
+                archived->archived = false;
+                stripe->bucketIds[key] = archivedId;
+            }
+            return insertIntoBucket(
+                archivedId, archived, newFieldNamesToBeInserted, sizeToBeAdded, closedBucketId);
         }
-        if (time < bucketTime) {
-            stats.numBucketsClosedDueToTimeBackward++;
-            return true;
+
+        if (!triedReopening) {
+            triedReopening = true;
+            // Whether or not a bucket was reopened, the catalog may have changed while the lock
+            // was released, so start over.
+            if (_reopenBucket(opCtx, stripe, lk, key, doc, time, options)) {
+                stripe->executionStats[ns].numBucketsReopened++;
+            }
+            continue;
         }
-        return false;
-    };
 
-    if (!bucket->ns.isEmpty() && isBucketFull()) {
-        // The bucket is full, so create a new one.
-        bucket->full = true;
-        it->second = createNewBucketId();
-        _orderedBuckets.insert({ns, it->first.second, it->second});
-        bucket = &_buckets[it->second];
+        // There is no bucket the measurement fits into, so create a new one.
+        boost::optional<OID> closedBucketId;
+        if (bucket) {
+            closedBucketId = closeCurrentBucket();
+        } else {
+            stats.numBucketsOpenedDueToMetadata++;
+        }
+        auto bucketId = createNewBucketId();
+        stripe->bucketIds[key] = bucketId;
+        stripe->orderedBuckets.insert({ns, key.second, bucketId});
+        bucket = &stripe->buckets[bucketId];
         bucket->calculateBucketFieldsAndSizeChange(
             doc, options.getMetaField(), &newFieldNamesToBeInserted, &sizeToBeAdded);
+        return insertIntoBucket(
+            bucketId, bucket, newFieldNamesToBeInserted, sizeToBeAdded, closedBucketId);
     }
-
-    bucket->numWriters++;
-    bucket->numMeasurements++;
-    bucket->size += sizeToBeAdded;
-    bucket->measurementsToBeInserted.push_back(doc);
-    bucket->newFieldNamesToBeInserted.merge(newFieldNamesToBeInserted);
-    if (bucket->ns.isEmpty()) {
-        // The namespace and metadata only need to be set if this bucket was newly created.
-        bucket->ns = ns;
-        bucket->metadata = it->first.second;
-    }
-    bucket->min.update(doc, options.getMetaField(), std::less<>());
-    bucket->max.update(doc, options.getMetaField(), std::greater<>());
-
-    // If there is exactly 1 uncommitted measurement, the caller is the committer. Otherwise, it is
-    // a waiter.
-    boost::optional<Future<CommitInfo>> commitInfoFuture;
-    if (bucket->numMeasurements - bucket->numCommittedMeasurements > 1) {
-        auto [promise, future] = makePromiseFuture<CommitInfo>();
-        bucket->promises[bucket->numMeasurements - 1] = std::move(promise);
-        commitInfoFuture = std::move(future);
-    }
-
-    return {it->second, std::move(commitInfoFuture)};
 }
 
-BucketCatalog::CommitData BucketCatalog::commit(const OID& bucketId,
+BucketCatalog::CommitData BucketCatalog::commit(const BucketHandle& handle,
                                                 boost::optional<CommitInfo> previousCommitInfo) {
-    stdx::lock_guard lk(_mutex);
-    auto it = _buckets.find(bucketId);
-    invariant(it != _buckets.end());
+    auto stripe = &_stripes[handle.stripe];
+    stdx::lock_guard lk(stripe->mutex);
+    auto it = stripe->buckets.find(handle.id);
+    invariant(it != stripe->buckets.end());
     auto& bucket = it->second;
 
     // The only case in which previousCommitInfo should not be provided is the first time a given
@@ -187,7 +263,7 @@ BucketCatalog::CommitData BucketCatalog::commit(const OID& bucketId,
     std::vector<BSONObj> measurements;
     bucket.measurementsToBeInserted.swap(measurements);
 
-    auto& stats = _executionStats[bucket.ns];
+    auto& stats = stripe->executionStats[bucket.ns];
     stats.numMeasurementsCommitted += measurements.size();
 
     // Inform waiters that their measurements have been committed.
@@ -220,14 +296,14 @@ BucketCatalog::CommitData BucketCatalog::commit(const OID& bucketId,
                        std::move(newFieldNamesToBeInserted)};
 
     if (allCommitted) {
-        if (bucket.full) {
+        if (bucket.full || bucket.archived) {
             // Everything in the bucket has been committed, and nothing more will be added since the
-            // bucket is full. Thus, we can remove it.
-            _orderedBuckets.erase(
-                {std::move(it->second.ns), std::move(it->second.metadata), bucketId});
-            _buckets.erase(it);
+            // bucket is full or was only reopened for the measurements just committed. Thus, we
+            // can remove it.
+            data.closed = true;
+            stripe->removeBucket(handle.id);
         } else if (--bucket.numWriters == 0) {
-            _idleBuckets.insert(bucketId);
+            stripe->markIdle(handle.id, &bucket);
         }
     } else {
         stats.numCommits++;
@@ -241,22 +317,156 @@ BucketCatalog::CommitData BucketCatalog::commit(const OID& bucketId,
     return data;
 }
 
-void BucketCatalog::clear(const NamespaceString& ns) {
-    stdx::lock_guard lk(_mutex);
+std::pair<OID, BucketCatalog::Bucket*> BucketCatalog::_findArchivedBucket(
+    Stripe* stripe,
+    const BucketKey& key,
+    const BSONObj& doc,
+    Date_t time,
+    const TimeseriesOptions& options,
+    StringSet* newFieldNamesToBeInserted,
+    uint32_t* sizeToBeAdded) {
+    const BucketLimits limits(options);
+    for (auto it = stripe->orderedBuckets.lower_bound({key.first, key.second, OID()});
+         it != stripe->orderedBuckets.end() && std::get<NamespaceString>(*it) == key.first &&
+         std::get<BucketMetadata>(*it).metadata.binaryEqual(key.second.metadata);
+         ++it) {
+        const auto& bucketId = std::get<OID>(*it);
+        auto& bucket = stripe->buckets[bucketId];
+        if (!bucket.archived || bucket.full) {
+            continue;
+        }
+        bucket.calculateBucketFieldsAndSizeChange(
+            doc, options.getMetaField(), newFieldNamesToBeInserted, sizeToBeAdded);
+        if (bucket.fits(bucketId, time, *sizeToBeAdded, limits) == FitResult::kFits) {
+            return {bucketId, &bucket};
+        }
+    }
+    return {OID(), nullptr};
+}
+
+bool BucketCatalog::_reopenBucket(OperationContext* opCtx,
+                                  Stripe* stripe,
+                                  stdx::unique_lock<Mutex>& lk,
+                                  const BucketKey& key,
+                                  const BSONObj& doc,
+                                  Date_t time,
+                                  const TimeseriesOptions& options) {
+    const BucketLimits limits(options);
+
+    // The buckets already in the catalog are known not to have room for the measurement.
+    BSONArrayBuilder openBucketIds;
+    for (auto it = stripe->orderedBuckets.lower_bound({key.first, key.second, OID()});
+         it != stripe->orderedBuckets.end() && std::get<NamespaceString>(*it) == key.first &&
+         std::get<BucketMetadata>(*it).metadata.binaryEqual(key.second.metadata);
+         ++it) {
+        openBucketIds.append(std::get<OID>(*it));
+    }
+
+    // A bucket's _id holds the time of its first measurement, truncated to seconds, and all of its
+    // measurements are at most 'maxSpan' later than that.
+    OID minBucketId;
+    minBucketId.init(time - limits.maxSpan, true /* max */);
+    OID maxBucketId;
+    maxBucketId.init(time, true /* max */);
+
+    BSONObjBuilder filter;
+    filter.append("_id",
+                  BSON("$gt" << minBucketId << "$lte" << maxBucketId << "$nin"
+                             << openBucketIds.arr()));
+    // Compressed buckets cannot be updated in place.
+    filter.append("control.version", timeseries::kTimeseriesControlDefaultVersion);
+    if (auto metaElem = key.second.metadata.firstElement()) {
+        filter.appendAs(metaElem, "meta");
+    }
+
+    const auto numBucketsRemoved = stripe->numBucketsRemoved;
+    lk.unlock();
+    BSONObj bucketDoc;
+    {
+        AutoGetCollectionForRead bucketsColl(opCtx, key.first.makeTimeseriesBucketsNamespace());
+        auto qr = std::make_unique<QueryRequest>(bucketsColl.getNss());
+        qr->setFilter(filter.obj());
+        // Prefer the most recent bucket, which is the most likely to also fit later measurements.
+        qr->setSort(BSON("_id" << -1));
+        auto recordId =
+            Helpers::findOne(opCtx, bucketsColl.getCollection(), std::move(qr), true /* index */);
+        if (!recordId.isNull()) {
+            bucketDoc = bucketsColl->docFor(opCtx, recordId).value().getOwned();
+        }
+    }
+    lk.lock();
+
+    if (bucketDoc.isEmpty() || numBucketsRemoved != stripe->numBucketsRemoved) {
+        return false;
+    }
+
+    // An equality query on an array also matches the arrays containing it, so the metadata must
+    // be compared exactly.
+    if (auto metaElem = key.second.metadata.firstElement();
+        metaElem && !metaElem.binaryEqualValues(bucketDoc["meta"])) {
+        return false;
+    }
+
+    auto bucketId = bucketDoc["_id"].OID();
+    auto control = bucketDoc["control"];
+    auto data = bucketDoc["data"];
+    if (stripe->buckets.contains(bucketId) || control.type() != Object || data.type() != Object ||
+        control["min"].type() != Object || control["max"].type() != Object ||
+        data[options.getTimeField()].type() != Object) {
+        return false;
+    }
+
+    Bucket bucket;
+    bucket.ns = key.first;
+    bucket.metadata = key.second;
+    for (auto&& column : data.Obj()) {
+        bucket.fieldNames.insert(column.fieldName());
+    }
+    bucket.size = data.Obj().objsize();
+    bucket.numMeasurements = data[options.getTimeField()].Obj().nFields();
+    bucket.numCommittedMeasurements = bucket.numMeasurements;
+    bucket.min.update(control["min"].Obj(), boost::none, std::less<>());
+    bucket.max.update(control["max"].Obj(), boost::none, std::greater<>());
+    // The loaded bounds are already on disk, so they are not reported as updates.
+    bucket.min.getUpdates();
+    bucket.max.getUpdates();
+    bucket.archived = true;
 
+    StringSet newFieldNamesToBeInserted;
+    uint32_t sizeToBeAdded = 0;
+    bucket.calculateBucketFieldsAndSizeChange(
+        doc, options.getMetaField(), &newFieldNamesToBeInserted, &sizeToBeAdded);
+    if (bucket.fits(bucketId, time, sizeToBeAdded, limits) != FitResult::kFits) {
+        return false;
+    }
+
+    stripe->buckets.emplace(bucketId, std::move(bucket));
+    stripe->orderedBuckets.insert({key.first, key.second, bucketId});
+    return true;
+}
+
+void BucketCatalog::clear(const NamespaceString& ns) {
     auto shouldClear = [&ns](const NamespaceString& bucketNs) {
         return ns.coll().empty() ? ns.db() == bucketNs.db() : ns == bucketNs;
     };
 
-    for (auto it = _orderedBuckets.lower_bound({ns, {}, {}});
-         it != _orderedBuckets.end() && shouldClear(std::get<NamespaceString>(*it));) {
-        const auto& bucketId = std::get<OID>(*it);
-        const auto& bucketNs = std::get<NamespaceString>(*it);
-        _buckets.erase(bucketId);
-        _idleBuckets.erase(bucketId);
-        _bucketIds.erase({bucketNs, std::get<BucketMetadata>(*it)});
-        _executionStats.erase(bucketNs);
-        it = _orderedBuckets.erase(it);
+    for (auto& stripe : _stripes) {
+        stdx::lock_guard lk(stripe.mutex);
+
+        for (auto it = stripe.orderedBuckets.lower_bound({ns, {}, {}});
+             it != stripe.orderedBuckets.end() && shouldClear(std::get<NamespaceString>(*it));) {
+            const auto& bucketId = std::get<OID>(*it);
+            const auto& bucketNs = std::get<NamespaceString>(*it);
+            auto bucketIt = stripe.buckets.find(bucketId);
+            if (bucketIt->second.idleListEntry) {
+                stripe.idleBuckets.erase(*bucketIt->second.idleListEntry);
+            }
+            stripe.buckets.erase(bucketIt);
+            stripe.bucketIds.erase({bucketNs, std::get<BucketMetadata>(*it)});
+            stripe.numBucketsRemoved++;
+            stripe.executionStats.erase(bucketNs);
+            it = stripe.orderedBuckets.erase(it);
+        }
     }
 }
 
@@ -265,10 +475,28 @@ void BucketCatalog::clear(StringData dbName) {
 }
 
 void BucketCatalog::appendExecutionStats(const NamespaceString& ns, BSONObjBuilder* builder) const {
-    stdx::lock_guard lk(_mutex);
+    // The buckets of a collection may be spread across all stripes.
+    ExecutionStats stats;
+    for (const auto& stripe : _stripes) {
+        stdx::lock_guard lk(stripe.mutex);
 
-    auto it = _executionStats.find(ns);
-    const auto& stats = it == _executionStats.end() ? ExecutionStats() : it->second;
+        auto it = stripe.executionStats.find(ns);
+        if (it == stripe.executionStats.end()) {
+            continue;
+        }
+        const auto& stripeStats = it->second;
+        stats.numBucketInserts += stripeStats.numBucketInserts;
+        stats.numBucketUpdates += stripeStats.numBucketUpdates;
+        stats.numBucketsOpenedDueToMetadata += stripeStats.numBucketsOpenedDueToMetadata;
+        stats.numBucketsClosedDueToCount += stripeStats.numBucketsClosedDueToCount;
+        stats.numBucketsClosedDueToSize += stripeStats.numBucketsClosedDueToSize;
+        stats.numBucketsClosedDueToTimeForward += stripeStats.numBucketsClosedDueToTimeForward;
+        stats.numBucketsClosedDueToTimeBackward += stripeStats.numBucketsClosedDueToTimeBackward;
+        stats.numBucketsReopened += stripeStats.numBucketsReopened;
+        stats.numCommits += stripeStats.numCommits;
+        stats.numWaits += stripeStats.numWaits;
+        stats.numMeasurementsCommitted += stripeStats.numMeasurementsCommitted;
+    }
 
     builder->appendNumber("numBucketInserts", stats.numBucketInserts);
     builder->appendNumber("numBucketUpdates", stats.numBucketUpdates);
@@ -279,6 +507,7 @@ void BucketCatalog::appendExecutionStats(const NamespaceString& ns, BSONObjBuild
                           stats.numBucketsClosedDueToTimeForward);
     builder->appendNumber("numBucketsClosedDueToTimeBackward",
                           stats.numBucketsClosedDueToTimeBackward);
+    builder->appendNumber("numBucketsReopened", stats.numBucketsReopened);
     builder->appendNumber("numCommits", stats.numCommits);
     builder->appendNumber("numWaits", stats.numWaits);
     builder->appendNumber("numMeasurementsCommitted", stats.numMeasurementsCommitted);
@@ -288,6 +517,34 @@ void BucketCatalog::appendExecutionStats(const NamespaceString& ns, BSONObjBuild
     }
 }
 
+size_t BucketCatalog::_getStripeNumber(const BucketKey& key) {
+    return absl::Hash<BucketKey>{}(key) % kNumberOfStripes;
+}
+
+void BucketCatalog::Stripe::removeBucket(const OID& bucketId) {
+    auto it = buckets.find(bucketId);
+    invariant(it != buckets.end());
+    auto& bucket = it->second;
+    if (bucket.idleListEntry) {
+        idleBuckets.erase(*bucket.idleListEntry);
+    }
+    orderedBuckets.erase({std::move(bucket.ns), std::move(bucket.metadata), bucketId});
+    buckets.erase(it);
+    numBucketsRemoved++;
+}
+
+void BucketCatalog::Stripe::markIdle(const OID& bucketId, Bucket* bucket) {
+    invariant(!bucket->idleListEntry);
+    bucket->idleListEntry = idleBuckets.insert(idleBuckets.begin(), bucketId);
+}
+
+void BucketCatalog::Stripe::markActive(Bucket* bucket) {
+    if (bucket->idleListEntry) {
+        idleBuckets.erase(*bucket->idleListEntry);
+        bucket->idleListEntry = boost::none;
+    }
+}
+
 bool BucketCatalog::BucketMetadata::operator<(const BucketMetadata& other) const {
     auto size = metadata.objsize();
     auto otherSize = other.metadata.objsize();
@@ -299,6 +556,33 @@ bool BucketCatalog::BucketMetadata::operator==(const BucketMetadata& other) cons
     return UnorderedFieldsBSONObjComparator().compare(metadata, other.metadata) == 0;
 }
 
+BucketCatalog::BucketLimits::BucketLimits(const TimeseriesOptions& options)
+    : maxCount(options.getBucketMaxCount().value_or(kTimeseriesBucketMaxCount)),
+      maxSizeBytes(options.getBucketMaxSizeBytes().value_or(kTimeseriesBucketMaxSizeBytes)),
+      maxSpan(options.getBucketMaxSpanSeconds()
+                  ? Seconds(*options.getBucketMaxSpanSeconds())
+                  : duration_cast<Seconds>(kTimeseriesBucketMaxTimeRange)) {}
+
+BucketCatalog::FitResult BucketCatalog::Bucket::fits(const OID& bucketId,
+                                                     Date_t time,
+                                                     uint32_t sizeToBeAdded,
+                                                     const BucketLimits& limits) const {
+    if (numMeasurements >= limits.maxCount) {
+        return FitResult::kCount;
+    }
+    if (size + sizeToBeAdded > static_cast<uint32_t>(limits.maxSizeBytes)) {
+        return FitResult::kSize;
+    }
+    auto bucketTime = bucketId.asDateT();
+    if (time - bucketTime >= limits.maxSpan) {
+        return FitResult::kTimeForward;
+    }
+    if (time < bucketTime) {
+        return FitResult::kTimeBackward;
+    }
+    return FitResult::kFits;
+}
+
 void BucketCatalog::Bucket::calculateBucketFieldsAndSizeChange(
     const BSONObj& doc,
     boost::optional<StringData> metaField,
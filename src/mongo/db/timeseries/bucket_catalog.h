@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <array>
+#include <list>
+
 #include "mongo/bson/unordered_fields_bsonobj_comparator.h"
 #include "mongo/db/ops/single_write_result_gen.h"
 #include "mongo/db/service_context.h"
@@ -38,11 +41,25 @@
 namespace mongo {
 class BucketCatalog {
 public:
-    // This set of constants define limits on the measurements held in a bucket.
+    // This set of constants define the default limits on the measurements held in a bucket. A
+    // collection may override them through its 'bucketMaxCount', 'bucketMaxSizeBytes' and
+    // 'bucketMaxSpanSeconds' time-series options.
     static constexpr int kTimeseriesBucketMaxCount = 1000;
     static constexpr int kTimeseriesBucketMaxSizeBytes = 125 * 1024;  // 125 KB
     static constexpr auto kTimeseriesBucketMaxTimeRange = Hours(1);
 
+    // The number of independently locked partitions of the catalog. The buckets of a namespace and
+    // metadata pair all live in the same stripe.
+    static constexpr size_t kNumberOfStripes = 32;
+
+    /**
+     * Identifies a bucket in the catalog: its _id and the stripe holding it.
+     */
+    struct BucketHandle {
+        OID id;
+        size_t stripe;
+    };
+
     struct CommitInfo {
         StatusWith<SingleWriteResult> result;
         boost::optional<repl::OpTime> opTime;
@@ -50,8 +67,12 @@ public:
     };
 
     struct InsertResult {
-        OID bucketId;
+        BucketHandle bucket;
         boost::optional<Future<CommitInfo>> commitInfo;
+
+        // The id of a full bucket that this insert closed and removed from the catalog because it
+        // had nothing left to commit. No more measurements will be added to it.
+        boost::optional<OID> closedBucketId;
     };
 
     struct CommitData {
@@ -61,6 +82,10 @@ public:
         uint16_t numCommittedMeasurements;
         StringSet newFieldNamesToBeInserted;
 
+        // Whether the bucket is full and everything in it has been committed, in which case it has
+        // been removed from the catalog and no more measurements will be added to it.
+        bool closed = false;
+
         BSONObj toBSON() const;
     };
 
@@ -80,12 +105,17 @@ public:
      * Returns an empty document if the given bucket cannot be found or if this time-series
      * collection was not created with a metadata field name.
      */
-    BSONObj getMetadata(const OID& bucketId) const;
+    BSONObj getMetadata(const BucketHandle& handle) const;
 
     /**
-     * Returns the id of the bucket that the document belongs in, and a Future to wait on if the
+     * Returns a handle for the bucket that the document belongs in, and a Future to wait on if the
      * caller is a waiter for the bucket. If no Future is provided, the caller is the committer for
      * this bucket.
+     *
+     * If the document does not fit into the bucket currently open for its namespace and metadata,
+     * or if there is no such bucket, a bucket in the buckets collection that has room for the
+     * document may be reopened instead of starting a new one. This requires reading the buckets
+     * collection, so the caller must not hold any locks.
      */
     InsertResult insert(OperationContext* opCtx, const NamespaceString& ns, const BSONObj& doc);
 
@@ -94,7 +124,7 @@ public:
      * committed for the given bucket. This should be called continuously by the committer until
      * there are no more uncommitted measurements.
      */
-    CommitData commit(const OID& bucketId,
+    CommitData commit(const BucketHandle& handle,
                       boost::optional<CommitInfo> previousCommitInfo = boost::none);
 
     /**
@@ -126,6 +156,26 @@ private:
         BSONObj metadata;
     };
 
+    /**
+     * The limits on the measurements held in a bucket of a particular collection.
+     */
+    struct BucketLimits {
+        explicit BucketLimits(const TimeseriesOptions& options);
+
+        int maxCount;
+        int maxSizeBytes;
+        Seconds maxSpan;
+    };
+
+    // Why a measurement could or could not be added to a bucket.
+    enum class FitResult {
+        kFits,
+        kCount,
+        kSize,
+        kTimeForward,
+        kTimeBackward,
+    };
+
     class MinMax {
     public:
         /*
@@ -226,6 +276,24 @@ private:
         // range.
         bool full = false;
 
+        // Whether the bucket was reopened from the buckets collection and is not the current
+        // bucket for its namespace and metadata pair. Like a full bucket, it is removed from the
+        // catalog as soon as everything in it has been committed.
+        bool archived = false;
+
+        // The position of the bucket in its stripe's list of idle buckets, if it has no writers.
+        boost::optional<std::list<OID>::iterator> idleListEntry;
+
+        /**
+         * Returns whether a measurement with time 'time', which changes the size of this bucket by
+         * 'sizeToBeAdded', fits into this bucket, whose _id is 'bucketId'. Otherwise, returns the
+         * limit the measurement would break.
+         */
+        FitResult fits(const OID& bucketId,
+                       Date_t time,
+                       uint32_t sizeToBeAdded,
+                       const BucketLimits& limits) const;
+
         /**
          * Determines the effect of adding 'doc' to this bucket If adding 'doc' causes this bucket
          * to overflow, we will create a new bucket and recalculate the change to the bucket size
@@ -245,26 +313,85 @@ private:
         long long numBucketsClosedDueToSize = 0;
         long long numBucketsClosedDueToTimeForward = 0;
         long long numBucketsClosedDueToTimeBackward = 0;
+        long long numBucketsReopened = 0;
         long long numCommits = 0;
         long long numWaits = 0;
         long long numMeasurementsCommitted = 0;
     };
 
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("BucketCatalog");
+    using BucketKey = std::pair<NamespaceString, BucketMetadata>;
 
-    // All buckets currently in the catalog, including buckets which are full but not yet committed.
-    stdx::unordered_map<OID, Bucket, OID::Hasher> _buckets;
+    /**
+     * One independently locked partition of the catalog.
+     */
+    struct Stripe {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("BucketCatalog::Stripe::mutex");
+
+        // All buckets currently in the stripe, including buckets which are full but not yet
+        // committed.
+        stdx::unordered_map<OID, Bucket, OID::Hasher> buckets;
+
+        // The _id of the current bucket for each namespace and metadata pair.
+        stdx::unordered_map<BucketKey, OID> bucketIds;
+
+        // All namespace, metadata, and _id tuples which currently have a bucket in the stripe.
+        std::set<std::tuple<NamespaceString, BucketMetadata, OID>> orderedBuckets;
+
+        // Buckets that do not have any writers, the most recently used first.
+        std::list<OID> idleBuckets;
+
+        // Per-collection execution stats for the buckets in this stripe.
+        stdx::unordered_map<NamespaceString, ExecutionStats> executionStats;
+
+        // The number of buckets ever removed from the stripe. A bucket read from the buckets
+        // collection without holding 'mutex' may only be reopened if this has not changed since
+        // the read, as its on-disk state may otherwise be older than the state the stripe last
+        // knew of.
+        uint64_t numBucketsRemoved = 0;
+
+        /**
+         * Removes the bucket 'bucketId' from the stripe.
+         */
+        void removeBucket(const OID& bucketId);
 
-    // The _id of the current bucket for each namespace and metadata pair.
-    stdx::unordered_map<std::pair<NamespaceString, BucketMetadata>, OID> _bucketIds;
+        /**
+         * Records that the bucket 'bucketId' has no writers left, or that it has writers again.
+         */
+        void markIdle(const OID& bucketId, Bucket* bucket);
+        void markActive(Bucket* bucket);
+    };
 
-    // All namespace, metadata, and _id tuples which currently have a bucket in the catalog.
-    std::set<std::tuple<NamespaceString, BucketMetadata, OID>> _orderedBuckets;
+    /**
+     * Returns the stripe holding the buckets of 'key'.
+     */
+    static size_t _getStripeNumber(const BucketKey& key);
 
-    // Buckets that do not have any writers.
-    std::set<OID> _idleBuckets;
+    /**
+     * Returns an archived bucket for the namespace and metadata pair 'key' that 'doc' fits into,
+     * along with its _id, or nullptr if there is none. Sets 'newFieldNamesToBeInserted' and
+     * 'sizeToBeAdded' for the returned bucket.
+     */
+    static std::pair<OID, Bucket*> _findArchivedBucket(Stripe* stripe,
+                                                       const BucketKey& key,
+                                                       const BSONObj& doc,
+                                                       Date_t time,
+                                                       const TimeseriesOptions& options,
+                                                       StringSet* newFieldNamesToBeInserted,
+                                                       uint32_t* sizeToBeAdded);
 
-    // Per-collection execution stats.
-    stdx::unordered_map<NamespaceString, ExecutionStats> _executionStats;
+    /**
+     * Looks for a bucket in the buckets collection which 'doc' fits into and adds it to 'stripe'
+     * as an archived bucket. The stripe's mutex, held by 'lk', is released while the buckets
+     * collection is read. Returns whether a bucket was added.
+     */
+    static bool _reopenBucket(OperationContext* opCtx,
+                              Stripe* stripe,
+                              stdx::unique_lock<Mutex>& lk,
+                              const BucketKey& key,
+                              const BSONObj& doc,
+                              Date_t time,
+                              const TimeseriesOptions& options);
+
+    std::array<Stripe, kNumberOfStripes> _stripes;
 };
 }  // namespace mongo
@@ -31,7 +31,9 @@
 
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/create_collection.h"
+#include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/death_test.h"
@@ -43,9 +45,17 @@ protected:
     void setUp() override;
     virtual BSONObj _makeTimeseriesOptionsForCreate() const;
 
-    void _commit(const OID& bucketId, uint16_t numCommittedMeasurements);
+    void _commit(const BucketCatalog::BucketHandle& bucket, uint16_t numCommittedMeasurements);
     void _insertOneAndCommit(const NamespaceString& ns, uint16_t numCommittedMeasurements);
 
+    /**
+     * Writes a bucket with a single measurement at 'time' to the buckets collection of 'ns' and
+     * returns its _id.
+     */
+    OID _insertBucketDocument(const NamespaceString& ns,
+                              Date_t time,
+                              int version = timeseries::kTimeseriesControlDefaultVersion);
+
     OperationContext* _opCtx;
     BucketCatalog* _bucketCatalog;
 
@@ -86,23 +96,37 @@ BSONObj BucketCatalogWithoutMetadataTest::_makeTimeseriesOptionsForCreate() cons
     return BSON("timeField" << _timeField);
 }
 
-void BucketCatalogTest::_commit(const OID& bucketId, uint16_t numCommittedMeasurements) {
-    auto data = _bucketCatalog->commit(bucketId);
+void BucketCatalogTest::_commit(const BucketCatalog::BucketHandle& bucket,
+                                uint16_t numCommittedMeasurements) {
+    auto data = _bucketCatalog->commit(bucket);
     ASSERT_EQ(data.docs.size(), 1);
     ASSERT_EQ(data.numCommittedMeasurements, numCommittedMeasurements);
 
-    data = _bucketCatalog->commit(bucketId, _commitInfo);
+    data = _bucketCatalog->commit(bucket, _commitInfo);
     ASSERT_EQ(data.docs.size(), 0);
     ASSERT_EQ(data.numCommittedMeasurements, numCommittedMeasurements + 1);
 }
 
 void BucketCatalogTest::_insertOneAndCommit(const NamespaceString& ns,
                                             uint16_t numCommittedMeasurements) {
-    auto [bucketId, commitInfo] =
+    auto [bucket, commitInfo, closedBucketId] =
         _bucketCatalog->insert(_opCtx, ns, BSON(_timeField << Date_t::now()));
     ASSERT(!commitInfo);
 
-    _commit(bucketId, numCommittedMeasurements);
+    _commit(bucket, numCommittedMeasurements);
+}
+
+OID BucketCatalogTest::_insertBucketDocument(const NamespaceString& ns, Date_t time, int version) {
+    auto bucketId = OID::gen();
+    bucketId.setTimestamp(durationCount<Seconds>(time.toDurationSinceEpoch()));
+    auto bucket = BSON("_id" << bucketId << "control"
+                             << BSON("version" << version << "min" << BSON(_timeField << time)
+                                               << "max" << BSON(_timeField << time))
+                             << "meta" << BSONNULL << "data"
+                             << BSON(_timeField << BSON("0" << time)));
+    ASSERT_OK(storageInterface()->insertDocument(
+        _opCtx, ns.makeTimeseriesBucketsNamespace(), {bucket, Timestamp()}, 0));
+    return bucketId;
 }
 
 TEST_F(BucketCatalogTest, InsertIntoSameBucket) {
@@ -116,21 +140,21 @@ TEST_F(BucketCatalogTest, InsertIntoSameBucket) {
     ASSERT(!result2.commitInfo->isReady());
 
     // Committing should return both documents since they belong in the same bucket.
-    auto data = _bucketCatalog->commit(result1.bucketId);
+    auto data = _bucketCatalog->commit(result1.bucket);
     ASSERT_EQ(data.docs.size(), 2);
     ASSERT_EQ(data.numCommittedMeasurements, 0);
     ASSERT(!result2.commitInfo->isReady());
 
     // Once the commit has occurred, the waiter should be notified.
-    data = _bucketCatalog->commit(result1.bucketId, _commitInfo);
+    data = _bucketCatalog->commit(result1.bucket, _commitInfo);
     ASSERT_EQ(data.docs.size(), 0);
     ASSERT_EQ(data.numCommittedMeasurements, 2);
     ASSERT(result2.commitInfo->isReady());
 }
 
 TEST_F(BucketCatalogTest, GetMetadataReturnsEmptyDocOnMissingBucket) {
-    auto bucketId = OID::gen();
-    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(bucketId));
+    BucketCatalog::BucketHandle bucket{OID::gen(), 0};
+    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(bucket));
 }
 
 TEST_F(BucketCatalogTest, InsertIntoDifferentBuckets) {
@@ -148,14 +172,14 @@ TEST_F(BucketCatalogTest, InsertIntoDifferentBuckets) {
     ASSERT(!result3.commitInfo);
 
     // Check metadata in buckets.
-    ASSERT_BSONOBJ_EQ(BSON(_metaField << "123"), _bucketCatalog->getMetadata(result1.bucketId));
-    ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONObj()), _bucketCatalog->getMetadata(result2.bucketId));
-    ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONNULL), _bucketCatalog->getMetadata(result3.bucketId));
+    ASSERT_BSONOBJ_EQ(BSON(_metaField << "123"), _bucketCatalog->getMetadata(result1.bucket));
+    ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONObj()), _bucketCatalog->getMetadata(result2.bucket));
+    ASSERT_BSONOBJ_EQ(BSON(_metaField << BSONNULL), _bucketCatalog->getMetadata(result3.bucket));
 
     // Committing one bucket should only return the one document in that bucket and shoukd not
     // affect the other bucket.
-    for (const auto& bucketId : {result1.bucketId, result2.bucketId, result3.bucketId}) {
-        _commit(bucketId, 0);
+    for (const auto& bucket : {result1.bucket, result2.bucket, result3.bucket}) {
+        _commit(bucket, 0);
     }
 }
 
@@ -188,55 +212,228 @@ TEST_F(BucketCatalogTest, ClearDatabaseBuckets) {
     _insertOneAndCommit(_ns3, 1);
 }
 
+TEST_F(BucketCatalogTest, InsertClosesIdleFullBucket) {
+    auto first = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now()));
+    ASSERT(!first.closedBucketId);
+    _commit(first.bucket, 0);
+    for (uint16_t i = 1; i < BucketCatalog::kTimeseriesBucketMaxCount; ++i) {
+        _insertOneAndCommit(_ns1, i);
+    }
+
+    // The full bucket has nothing left to commit, so the insert that overflows it closes it.
+    auto overflow = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now()));
+    ASSERT_NE(first.bucket.id, overflow.bucket.id);
+    ASSERT(overflow.closedBucketId);
+    ASSERT_EQ(first.bucket.id, *overflow.closedBucketId);
+    _commit(overflow.bucket, 0);
+}
+
+TEST_F(BucketCatalogTest, CommitClosesFullBucket) {
+    auto first = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now()));
+    _commit(first.bucket, 0);
+    for (uint16_t i = 1; i < BucketCatalog::kTimeseriesBucketMaxCount - 1; ++i) {
+        _insertOneAndCommit(_ns1, i);
+    }
+
+    // Leave the last measurement of the bucket pending commit.
+    _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now()));
+    auto data = _bucketCatalog->commit(first.bucket);
+    ASSERT_EQ(data.docs.size(), 1);
+    ASSERT(!data.closed);
+
+    // The overflowing insert cannot close the bucket while its committer is still active.
+    auto overflow = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now()));
+    ASSERT_NE(first.bucket.id, overflow.bucket.id);
+    ASSERT(!overflow.closedBucketId);
+
+    // The committer closes it instead once everything in it has been committed.
+    data = _bucketCatalog->commit(first.bucket, _commitInfo);
+    ASSERT_EQ(data.docs.size(), 0);
+    ASSERT(data.closed);
+    _commit(overflow.bucket, 0);
+}
+
+TEST_F(BucketCatalogTest, InsertRespectsCollectionBucketLimits) {
+    NamespaceString ns{"bucket_catalog_test_1", "t_limits"};
+    ASSERT_OK(createCollection(_opCtx,
+                               ns.db().toString(),
+                               BSON("create" << ns.coll() << "timeseries"
+                                             << BSON("timeField" << _timeField << "metaField"
+                                                                 << _metaField << "bucketMaxCount"
+                                                                 << 2 << "bucketMaxSpanSeconds"
+                                                                 << 60))));
+
+    auto now = Date_t::now();
+    auto first = _bucketCatalog->insert(_opCtx, ns, BSON(_timeField << now)).bucket.id;
+    ASSERT_EQ(first, _bucketCatalog->insert(_opCtx, ns, BSON(_timeField << now)).bucket.id);
+
+    // The bucket holds at most two measurements.
+    auto second = _bucketCatalog->insert(_opCtx, ns, BSON(_timeField << now)).bucket.id;
+    ASSERT_NE(first, second);
+
+    // Measurements in a bucket span at most a minute.
+    ASSERT_NE(second,
+              _bucketCatalog->insert(_opCtx, ns, BSON(_timeField << now + Seconds(61))).bucket.id);
+}
+
+TEST_F(BucketCatalogTest, CollectionBucketLimitsAreValidated) {
+    for (auto&& [option, value] : std::vector<std::pair<std::string, int>>{
+             {"bucketMaxCount", 0},
+             {"bucketMaxCount", 65536},
+             {"bucketMaxSizeBytes", 0},
+             {"bucketMaxSpanSeconds", 0}}) {
+        ASSERT_NOT_OK(createCollection(
+            _opCtx,
+            _ns1.db().toString(),
+            BSON("create"
+                 << "t_invalid"
+                 << "timeseries" << BSON("timeField" << _timeField << option << value))));
+    }
+}
+
+TEST_F(BucketCatalogTest, InsertReopensBucketFromBucketsCollection) {
+    auto time = Date_t::now() - Minutes(10);
+    auto bucketId = _insertBucketDocument(_ns1, time);
+
+    auto result = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << time + Minutes(1)));
+    ASSERT_EQ(bucketId, result.bucket.id);
+    ASSERT(!result.commitInfo);
+
+    // The measurement is appended after the one already in the bucket, and only the bounds it
+    // changes are reported.
+    auto data = _bucketCatalog->commit(result.bucket);
+    ASSERT_EQ(data.docs.size(), 1);
+    ASSERT_EQ(data.numCommittedMeasurements, 1);
+    ASSERT(data.newFieldNamesToBeInserted.empty());
+    ASSERT_BSONOBJ_EQ(BSONObj(), data.bucketMin);
+    ASSERT_BSONOBJ_EQ(BSON("u" << BSON(_timeField << time + Minutes(1))), data.bucketMax);
+
+    data = _bucketCatalog->commit(result.bucket, _commitInfo);
+    ASSERT_EQ(data.docs.size(), 0);
+    ASSERT_EQ(data.numCommittedMeasurements, 2);
+    ASSERT(!data.closed);
+
+    // The reopened bucket is now the current bucket.
+    ASSERT_EQ(
+        bucketId,
+        _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << time + Minutes(2))).bucket.id);
+}
+
+TEST_F(BucketCatalogTest, InsertReopensBucketForLateMeasurement) {
+    auto now = Date_t::now();
+    auto lateBucketId = _insertBucketDocument(_ns1, now - Hours(3));
+
+    // The bucket in the buckets collection is too old for the current measurements.
+    auto current = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << now)).bucket;
+    ASSERT_NE(lateBucketId, current.id);
+    _commit(current, 0);
+
+    auto late =
+        _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << now - Hours(3) + Minutes(5)));
+    ASSERT_EQ(lateBucketId, late.bucket.id);
+    ASSERT(!late.closedBucketId);
+
+    // The late measurement leaves the current bucket open.
+    ASSERT_EQ(current.id, _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << now)).bucket.id);
+
+    // The reopened bucket is closed again once the late measurement is committed.
+    auto data = _bucketCatalog->commit(late.bucket);
+    ASSERT_EQ(data.numCommittedMeasurements, 1);
+    data = _bucketCatalog->commit(late.bucket, _commitInfo);
+    ASSERT(data.closed);
+}
+
+TEST_F(BucketCatalogTest, InsertDoesNotReopenCompressedBucket) {
+    auto time = Date_t::now() - Minutes(10);
+    auto bucketId =
+        _insertBucketDocument(_ns1, time, timeseries::kTimeseriesControlCompressedVersion);
+    ASSERT_NE(
+        bucketId,
+        _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << time + Minutes(1))).bucket.id);
+}
+
+TEST_F(BucketCatalogTest, InsertDoesNotReopenBucketForOtherMetadata) {
+    auto time = Date_t::now() - Minutes(10);
+    auto bucketId = _insertBucketDocument(_ns1, time);
+    ASSERT_NE(bucketId,
+              _bucketCatalog
+                  ->insert(_opCtx, _ns1, BSON(_timeField << time + Minutes(1) << _metaField << 1))
+                  .bucket.id);
+}
+
+TEST_F(BucketCatalogTest, ClearRemovesBucketsFromAllStripes) {
+    // Enough distinct metadata values that the buckets end up in several stripes.
+    std::vector<BucketCatalog::BucketHandle> buckets;
+    std::set<size_t> stripes;
+    for (auto i = 0; i < 4 * int(BucketCatalog::kNumberOfStripes); ++i) {
+        auto result = _bucketCatalog->insert(
+            _opCtx, _ns1, BSON(_timeField << Date_t::now() << _metaField << i));
+        ASSERT_LT(result.bucket.stripe, BucketCatalog::kNumberOfStripes);
+        ASSERT_BSONOBJ_EQ(BSON(_metaField << i), _bucketCatalog->getMetadata(result.bucket));
+        stripes.insert(result.bucket.stripe);
+        buckets.push_back(result.bucket);
+    }
+    ASSERT_GT(stripes.size(), 1U);
+
+    // Buckets with the same metadata always share a stripe.
+    auto doc = BSON(_timeField << Date_t::now() << _metaField << 0);
+    ASSERT_EQ(buckets[0].stripe, _bucketCatalog->insert(_opCtx, _ns1, doc).bucket.stripe);
+
+    _bucketCatalog->clear(_ns1);
+    for (const auto& bucket : buckets) {
+        ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(bucket));
+    }
+}
+
 DEATH_TEST_F(BucketCatalogTest, CannotProvideCommitInfoOnFirstCommit, "invariant") {
-    auto [bucketId, _] = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now()));
-    _bucketCatalog->commit(bucketId, _commitInfo);
+    auto bucket = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now())).bucket;
+    _bucketCatalog->commit(bucket, _commitInfo);
 }
 
 TEST_F(BucketCatalogWithoutMetadataTest, GetMetadataReturnsEmptyDoc) {
     auto result = _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now()));
     ASSERT(!result.commitInfo);
 
-    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(result.bucketId));
+    ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(result.bucket));
 
-    _commit(result.bucketId, 0);
+    _commit(result.bucket, 0);
 }
 
 TEST_F(BucketCatalogWithoutMetadataTest, CommitReturnsNewFields) {
     // Creating a new bucket should return all fields from the initial measurement.
-    auto [bucketId, _] =
-        _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now() << "a" << 0));
-    auto data = _bucketCatalog->commit(bucketId);
+    auto bucket =
+        _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now() << "a" << 0))
+            .bucket;
+    auto data = _bucketCatalog->commit(bucket);
     ASSERT_EQ(2U, data.newFieldNamesToBeInserted.size()) << data.toBSON();
     ASSERT(data.newFieldNamesToBeInserted.count(_timeField)) << data.toBSON();
     ASSERT(data.newFieldNamesToBeInserted.count("a")) << data.toBSON();
 
     // Inserting a new measurement with the same fields should return an empty set of new fields.
     _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now() << "a" << 1));
-    data = _bucketCatalog->commit(bucketId, _commitInfo);
+    data = _bucketCatalog->commit(bucket, _commitInfo);
     ASSERT_EQ(0U, data.newFieldNamesToBeInserted.size()) << data.toBSON();
 
     // Insert a new measurement with the a new field.
     _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now() << "a" << 2 << "b" << 2));
-    data = _bucketCatalog->commit(bucketId, _commitInfo);
+    data = _bucketCatalog->commit(bucket, _commitInfo);
     ASSERT_EQ(1U, data.newFieldNamesToBeInserted.size()) << data.toBSON();
     ASSERT(data.newFieldNamesToBeInserted.count("b")) << data.toBSON();
 
     // Fill up the bucket.
     for (auto i = 3; i < BucketCatalog::kTimeseriesBucketMaxCount; ++i) {
         _bucketCatalog->insert(_opCtx, _ns1, BSON(_timeField << Date_t::now() << "a" << i));
-        data = _bucketCatalog->commit(bucketId, _commitInfo);
+        data = _bucketCatalog->commit(bucket, _commitInfo);
         ASSERT_EQ(0U, data.newFieldNamesToBeInserted.size()) << i << ":" << data.toBSON();
     }
 
     // When a bucket overflows, committing to the new overflow bucket should return the fields of
     // the first measurement as new fields.
-    auto [overflowBucketId, unusedCommitInfo] = _bucketCatalog->insert(
-        _opCtx,
-        _ns1,
-        BSON(_timeField << Date_t::now() << "a" << BucketCatalog::kTimeseriesBucketMaxCount));
-    ASSERT_NE(bucketId, overflowBucketId);
-    data = _bucketCatalog->commit(overflowBucketId);
+    auto overflowDoc =
+        BSON(_timeField << Date_t::now() << "a" << BucketCatalog::kTimeseriesBucketMaxCount);
+    auto overflowBucket = _bucketCatalog->insert(_opCtx, _ns1, overflowDoc).bucket;
+    ASSERT_NE(bucket.id, overflowBucket.id);
+    data = _bucketCatalog->commit(overflowBucket);
     ASSERT_EQ(2U, data.newFieldNamesToBeInserted.size()) << data.toBSON();
     ASSERT(data.newFieldNamesToBeInserted.count(_timeField)) << data.toBSON();
     ASSERT(data.newFieldNamesToBeInserted.count("a")) << data.toBSON();
@@ -0,0 +1,500 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#pragma once
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <cstring>
+
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/itoa.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace timeseries {
+
+enum class ColumnEncoder::Op : uint8_t {
+    kEnd = 0,
+    kSkip = 1,
+    kLiteral = 2,
+    kRepeat = 3,
+    kDelta = 4,
+    kDeltaOfDelta = 5,
+    kXor = 6,
+};
+
+namespace {
+
+// The first byte of every encoded column, identifying the layout of what follows.
+constexpr uint8_t kColumnFormatVersion = 1;
+
+constexpr StringData kControlFieldName = "control"_sd;
+constexpr StringData kControlVersionFieldName = "version"_sd;
+constexpr StringData kDataFieldName = "data"_sd;
+
+void appendVarUInt(BufBuilder* buf, uint64_t value) {
+    while (value >= 0x80) {
+        buf->appendUChar(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buf->appendUChar(static_cast<uint8_t>(value));
+}
+
+uint64_t zigZagEncode(uint64_t value) {
+    auto signedValue = static_cast<int64_t>(value);
+    return (value << 1) ^ static_cast<uint64_t>(signedValue >> 63);
+}
+
+uint64_t zigZagDecode(uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+bool isDeltaType(BSONType type) {
+    return type == NumberInt || type == NumberLong;
+}
+
+bool isDeltaOfDeltaType(BSONType type) {
+    return type == Date || type == bsonTimestamp;
+}
+
+bool isNumericType(BSONType type) {
+    return isDeltaType(type) || isDeltaOfDeltaType(type) || type == NumberDouble;
+}
+
+/**
+ * Returns the 64-bit representation of 'elem', which must be of a type for which isNumericType()
+ * is true.
+ */
+uint64_t toBits(const BSONElement& elem) {
+    switch (elem.type()) {
+        case NumberInt:
+            return static_cast<uint64_t>(static_cast<int64_t>(elem._numberInt()));
+        case NumberLong:
+            return static_cast<uint64_t>(elem._numberLong());
+        case Date:
+            return static_cast<uint64_t>(elem.date().toMillisSinceEpoch());
+        case bsonTimestamp:
+            return elem.timestamp().asULL();
+        case NumberDouble: {
+            double value = elem._numberDouble();
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+/**
+ * Appends the value of type 'type' with the 64-bit representation 'bits' to 'builder'.
+ */
+void appendBits(BSONObjBuilder* builder, StringData fieldName, BSONType type, uint64_t bits) {
+    switch (type) {
+        case NumberInt:
+            builder->append(fieldName, static_cast<int32_t>(bits));
+            return;
+        case NumberLong:
+            builder->append(fieldName, static_cast<long long>(bits));
+            return;
+        case Date:
+            builder->appendDate(fieldName,
+                                Date_t::fromMillisSinceEpoch(static_cast<long long>(bits)));
+            return;
+        case bsonTimestamp:
+            builder->append(fieldName, Timestamp(static_cast<unsigned long long>(bits)));
+            return;
+        case NumberDouble: {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            builder->append(fieldName, value);
+            return;
+        }
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+/**
+ * Bounds-checked reader over an encoded column.
+ */
+class ColumnReader {
+public:
+    ColumnReader(const char* data, int len) : _pos(data), _end(data + len) {}
+
+    uint8_t readByte() {
+        uassert(5697000, "Truncated time-series column", _pos < _end);
+        return static_cast<uint8_t>(*_pos++);
+    }
+
+    uint64_t readVarUInt() {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uassert(5697001, "Malformed varint in time-series column", shift < 64);
+            auto byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    }
+
+    const char* readBytes(uint64_t len) {
+        uassert(5697002,
+                "Truncated time-series column",
+                len <= static_cast<uint64_t>(_end - _pos));
+        auto bytes = _pos;
+        _pos += len;
+        return bytes;
+    }
+
+    bool atEnd() const {
+        return _pos == _end;
+    }
+
+private:
+    const char* _pos;
+    const char* const _end;
+};
+
+}  // namespace
+
+ColumnEncoder::ColumnEncoder() : _runOp(Op::kEnd) {
+    _buf.appendUChar(kColumnFormatVersion);
+}
+
+void ColumnEncoder::append(const BSONElement& elem) {
+    ++_numPositions;
+    const auto type = elem.type();
+
+    if (type == _prevType) {
+        if (isNumericType(type)) {
+            const auto bits = toBits(elem);
+            if (bits == _prevBits) {
+                _extendRun(Op::kRepeat);
+                _prevDelta = 0;
+            } else if (isDeltaType(type)) {
+                const uint64_t delta = bits - _prevBits;
+                _extendRun(Op::kDelta);
+                appendVarUInt(&_runPayload, zigZagEncode(delta));
+                _prevDelta = delta;
+            } else if (isDeltaOfDeltaType(type)) {
+                const uint64_t delta = bits - _prevBits;
+                _extendRun(Op::kDeltaOfDelta);
+                appendVarUInt(&_runPayload, zigZagEncode(delta - _prevDelta));
+                _prevDelta = delta;
+            } else {
+                // Consecutive measurements of a sensor tend to share their sign, exponent and high
+                // mantissa bits, and integral values have trailing zero mantissa bits, so only the
+                // bytes in between are kept.
+                const uint64_t x = bits ^ _prevBits;
+                const int leading = countLeadingZeros64(x) / 8;
+                const int trailing = countTrailingZeros64(x) / 8;
+                _extendRun(Op::kXor);
+                _runPayload.appendUChar(static_cast<uint8_t>(leading << 4 | trailing));
+                for (int i = trailing; i < 8 - leading; ++i) {
+                    _runPayload.appendUChar(static_cast<uint8_t>(x >> (i * 8)));
+                }
+                _prevDelta = 0;
+            }
+            _prevBits = bits;
+            return;
+        }
+
+        if (elem.binaryEqualValues(_prevElem)) {
+            _extendRun(Op::kRepeat);
+            _prevDelta = 0;
+            return;
+        }
+    }
+
+    _extendRun(Op::kLiteral);
+    appendVarUInt(&_runPayload, 2 + elem.valuesize());
+    _runPayload.appendChar(static_cast<char>(type));
+    _runPayload.appendChar('\0');
+    _runPayload.appendBuf(elem.value(), elem.valuesize());
+
+    _prevType = type;
+    _prevBits = isNumericType(type) ? toBits(elem) : 0;
+    _prevElem = elem;
+    _prevDelta = 0;
+}
+
+void ColumnEncoder::skip(size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (_runOp != Op::kSkip) {
+        _flushRun();
+        _runOp = Op::kSkip;
+    }
+    _runCount += count;
+    _numPositions += count;
+}
+
+BufBuilder& ColumnEncoder::finish() {
+    _flushRun();
+    _buf.appendUChar(static_cast<uint8_t>(Op::kEnd));
+    return _buf;
+}
+
+void ColumnEncoder::_extendRun(Op op) {
+    if (_runOp != op) {
+        _flushRun();
+        _runOp = op;
+    }
+    ++_runCount;
+}
+
+void ColumnEncoder::_flushRun() {
+    if (_runCount == 0) {
+        return;
+    }
+    _buf.appendUChar(static_cast<uint8_t>(_runOp));
+    appendVarUInt(&_buf, _runCount);
+    _buf.appendBuf(_runPayload.buf(), _runPayload.len());
+
+    _runPayload.reset();
+    _runCount = 0;
+    _runOp = Op::kEnd;
+}
+
+bool appendCompressedColumn(StringData fieldName, const BSONObj& column, BSONObjBuilder* builder) {
+    ColumnEncoder encoder;
+    for (auto&& elem : column) {
+        auto name = elem.fieldNameStringData();
+        auto position = str::parseUnsignedBase10Integer(name);
+        if (!position || (name.size() > 1 && name[0] == '0') || *position < encoder.size()) {
+            // Only canonical, ascending positions can be reproduced on decoding.
+            return false;
+        }
+        encoder.skip(*position - encoder.size());
+        encoder.append(elem);
+    }
+
+    auto& buf = encoder.finish();
+    builder->appendBinData(fieldName, buf.len(), BinDataGeneral, buf.buf());
+    return true;
+}
+
+BSONObj decompressColumn(const BSONBinData& binData) {
+    uassert(5697003,
+            str::stream() << "Unexpected BinData subtype for a time-series column: "
+                          << static_cast<int>(binData.type),
+            binData.type == BinDataGeneral);
+
+    ColumnReader reader(static_cast<const char*>(binData.data), binData.length);
+    uassert(5697004,
+            "Unsupported time-series column format",
+            reader.readByte() == kColumnFormatVersion);
+
+    BSONObjBuilder builder;
+    uint64_t position = 0;
+
+    BSONType prevType = EOO;
+    uint64_t prevBits = 0;
+    BSONElement prevElem;
+    uint64_t prevDelta = 0;
+
+    auto appendPrev = [&] {
+        ItoA name(position++);
+        if (isNumericType(prevType)) {
+            appendBits(&builder, name, prevType, prevBits);
+        } else {
+            builder.appendAs(prevElem, name);
+        }
+    };
+
+    using Op = ColumnEncoder::Op;
+    while (true) {
+        const auto op = static_cast<Op>(reader.readByte());
+        if (op == Op::kEnd) {
+            break;
+        }
+        const auto count = reader.readVarUInt();
+
+        switch (op) {
+            case Op::kSkip:
+                position += count;
+                break;
+            case Op::kLiteral:
+                for (uint64_t i = 0; i < count; ++i) {
+                    const auto size = reader.readVarUInt();
+                    uassert(5697005, "Malformed literal in time-series column", size >= 2);
+                    const char* bytes = reader.readBytes(size);
+                    uassert(5697006,
+                            "Malformed literal in time-series column",
+                            isValidBSONType(bytes[0]) && bytes[0] != EOO && bytes[1] == '\0');
+                    prevElem = BSONElement(bytes, 1, size, BSONElement::CachedSizeTag{});
+                    prevType = prevElem.type();
+                    prevBits = isNumericType(prevType) ? toBits(prevElem) : 0;
+                    prevDelta = 0;
+                    appendPrev();
+                }
+                break;
+            case Op::kRepeat:
+                uassert(5697007, "Repeat without a value in time-series column", prevType != EOO);
+                for (uint64_t i = 0; i < count; ++i) {
+                    appendPrev();
+                }
+                prevDelta = 0;
+                break;
+            case Op::kDelta:
+                uassert(5697008,
+                        "Delta of a non-integer in time-series column",
+                        isDeltaType(prevType));
+                for (uint64_t i = 0; i < count; ++i) {
+                    prevDelta = zigZagDecode(reader.readVarUInt());
+                    prevBits += prevDelta;
+                    appendPrev();
+                }
+                break;
+            case Op::kDeltaOfDelta:
+                uassert(5697009,
+                        "Delta of delta of a non-time value in time-series column",
+                        isDeltaOfDeltaType(prevType));
+                for (uint64_t i = 0; i < count; ++i) {
+                    prevDelta += zigZagDecode(reader.readVarUInt());
+                    prevBits += prevDelta;
+                    appendPrev();
+                }
+                break;
+            case Op::kXor:
+                uassert(5697010,
+                        "XOR of a non-double in time-series column",
+                        prevType == NumberDouble);
+                for (uint64_t i = 0; i < count; ++i) {
+                    const auto header = reader.readByte();
+                    const int leading = header >> 4;
+                    const int trailing = header & 0xf;
+                    uassert(5697011, "Malformed XOR in time-series column", leading + trailing < 8);
+                    uint64_t x = 0;
+                    for (int b = trailing; b < 8 - leading; ++b) {
+                        x |= static_cast<uint64_t>(reader.readByte()) << (b * 8);
+                    }
+                    prevBits ^= x;
+                    prevDelta = 0;
+                    appendPrev();
+                }
+                break;
+            default:
+                uasserted(5697012,
+                          str::stream() << "Unknown opcode in time-series column: "
+                                        << static_cast<int>(op));
+        }
+    }
+    uassert(5697013, "Trailing bytes after time-series column", reader.atEnd());
+
+    return builder.obj();
+}
+
+bool isCompressedBucket(const BSONObj& bucketDoc) {
+    auto version = bucketDoc.getObjectField(kControlFieldName)[kControlVersionFieldName];
+    return version.isNumber() && version.numberInt() == kTimeseriesControlCompressedVersion;
+}
+
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc) {
+    if (isCompressedBucket(bucketDoc)) {
+        return boost::none;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : bucketDoc) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kControlFieldName && elem.type() == Object) {
+            BSONObjBuilder controlBuilder(builder.subobjStart(kControlFieldName));
+            for (auto&& controlElem : elem.Obj()) {
+                if (controlElem.fieldNameStringData() == kControlVersionFieldName) {
+                    controlBuilder.append(kControlVersionFieldName,
+                                          kTimeseriesControlCompressedVersion);
+                } else {
+                    controlBuilder.append(controlElem);
+                }
+            }
+        } else if (fieldName == kDataFieldName) {
+            if (elem.type() != Object) {
+                return boost::none;
+            }
+            BSONObjBuilder dataBuilder(builder.subobjStart(kDataFieldName));
+            for (auto&& column : elem.Obj()) {
+                if (column.type() != Object ||
+                    !appendCompressedColumn(
+                        column.fieldNameStringData(), column.Obj(), &dataBuilder)) {
+                    return boost::none;
+                }
+            }
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
+BSONObj decompressBucket(const BSONObj& bucketDoc) {
+    if (!isCompressedBucket(bucketDoc)) {
+        return bucketDoc;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : bucketDoc) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kControlFieldName) {
+            BSONObjBuilder controlBuilder(builder.subobjStart(kControlFieldName));
+            for (auto&& controlElem : elem.Obj()) {
+                if (controlElem.fieldNameStringData() == kControlVersionFieldName) {
+                    controlBuilder.append(kControlVersionFieldName,
+                                          kTimeseriesControlDefaultVersion);
+                } else {
+                    controlBuilder.append(controlElem);
+                }
+            }
+        } else if (fieldName == kDataFieldName) {
+            BSONObjBuilder dataBuilder(builder.subobjStart(kDataFieldName));
+            for (auto&& column : elem.Obj()) {
+                uassert(5697014,
+                        str::stream() << "Expected a compressed time-series column, got: "
+                                      << column,
+                        column.type() == BinData);
+                int len;
+                const char* data = column.binData(len);
+                dataBuilder.append(column.fieldNameStringData(),
+                                   decompressColumn(BSONBinData(data, len, column.binDataType())));
+            }
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
+}  // namespace timeseries
+}  // namespace mongo
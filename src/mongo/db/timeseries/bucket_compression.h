@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#pragma once
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/util/builder.h"
+
+namespace mongo {
+namespace timeseries {
+
+// The control.version of a bucket in which every data column is an uncompressed object mapping the
+// positions of the measurements to their values.
+constexpr int kTimeseriesControlDefaultVersion = 1;
+
+// The control.version of a bucket in which every data column is a BinData holding the column
+// encoded with a ColumnEncoder.
+constexpr int kTimeseriesControlCompressedVersion = 2;
+
+/**
+ * Encodes one column of a time-series bucket, i.e. the values of one field across all measurements
+ * in position order, into a compact binary representation.
+ *
+ * The encoding is a sequence of runs. Each run is an opcode byte, the number of positions it covers
+ * as a varint, and an opcode-specific payload:
+ *   - kSkip: positions at which the field is missing. No payload.
+ *   - kLiteral: one BSON element with an empty field name per position.
+ *   - kRepeat: positions holding the same value as the previous position. No payload.
+ *   - kDelta: NumberInt and NumberLong values, as zig-zag varint deltas from the previous value.
+ *   - kDeltaOfDelta: Date and Timestamp values, as zig-zag varint differences between consecutive
+ *     deltas, which are zero for regularly spaced measurements.
+ *   - kXor: NumberDouble values, as the XOR of their bits with the previous value's bits, stripped
+ *     of its leading and trailing zero bytes.
+ * Numeric runs only continue a previous value of the same BSON type, so the type of every value
+ * is preserved. The arithmetic is done modulo 2^64, which makes every encoding lossless.
+ */
+class ColumnEncoder {
+public:
+    // The opcodes of the runs. Defined in the implementation file.
+    enum class Op : uint8_t;
+
+    ColumnEncoder();
+
+    /**
+     * Appends 'elem' as the value at the next position. The field name is ignored. The buffer
+     * backing 'elem' must remain valid until finish() is called.
+     */
+    void append(const BSONElement& elem);
+
+    /**
+     * Records that the field is missing at the next 'count' positions.
+     */
+    void skip(size_t count = 1);
+
+    /**
+     * Returns the number of positions appended or skipped so far.
+     */
+    size_t size() const {
+        return _numPositions;
+    }
+
+    /**
+     * Terminates the encoding and returns it. The encoder must not be used afterwards.
+     */
+    BufBuilder& finish();
+
+private:
+    /**
+     * Writes out the pending run, if any.
+     */
+    void _flushRun();
+
+    /**
+     * Ends the pending run if it has a different opcode than 'op', then adds one position to the
+     * run. The caller appends the position's payload, if any, to '_runPayload'.
+     */
+    void _extendRun(Op op);
+
+    BufBuilder _buf;
+
+    // The run that is being accumulated and has not been written to '_buf' yet.
+    Op _runOp;
+    size_t _runCount = 0;
+    BufBuilder _runPayload;
+
+    size_t _numPositions = 0;
+
+    // The previous value, which the next position is encoded relative to. Numeric values are kept
+    // as their 64-bit representation in '_prevBits'; other values as the element itself.
+    BSONType _prevType = EOO;
+    uint64_t _prevBits = 0;
+    BSONElement _prevElem;
+    uint64_t _prevDelta = 0;
+};
+
+/**
+ * Encodes a column of an uncompressed bucket, in which the field names are the measurement
+ * positions in ascending order, and appends it to 'builder' as BinData named 'fieldName'. Returns
+ * false, appending nothing, if the field names are not ascending positions.
+ */
+bool appendCompressedColumn(StringData fieldName, const BSONObj& column, BSONObjBuilder* builder);
+
+/**
+ * Decodes a column produced by appendCompressedColumn() back into an object mapping positions to
+ * values, as found in an uncompressed bucket. Throws if 'binData' is not a valid encoded column.
+ */
+BSONObj decompressColumn(const BSONBinData& binData);
+
+/**
+ * Returns a copy of the uncompressed 'bucketDoc' with every data column encoded and control.version
+ * set to kTimeseriesControlCompressedVersion. Returns boost::none if the bucket is already
+ * compressed or one of its columns cannot be encoded.
+ */
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc);
+
+/**
+ * Returns a copy of the compressed 'bucketDoc' with every data column decoded and control.version
+ * set to kTimeseriesControlDefaultVersion, or 'bucketDoc' itself if it is not compressed.
+ */
+BSONObj decompressBucket(const BSONObj& bucketDoc);
+
+/**
+ * Returns true if 'bucketDoc' holds compressed data columns.
+ */
+bool isCompressedBucket(const BSONObj& bucketDoc);
+
+}  // namespace timeseries
+}  // namespace mongo
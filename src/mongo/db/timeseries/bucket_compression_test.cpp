@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#pragma once
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using namespace timeseries;
+
+/**
+ * Compresses 'column', checks that decompressing it reproduces it byte for byte, and returns the
+ * size of the compressed column.
+ */
+int assertRoundTrip(const BSONObj& column) {
+    BSONObjBuilder builder;
+    ASSERT(appendCompressedColumn("c", column, &builder));
+    auto compressed = builder.obj();
+    auto elem = compressed["c"];
+    ASSERT_EQ(elem.type(), BinData);
+
+    int len;
+    const char* data = elem.binData(len);
+    ASSERT_BSONOBJ_BINARY_EQ(column, decompressColumn(BSONBinData(data, len, BinDataGeneral)));
+    return len;
+}
+
+TEST(BucketCompressionTest, RoundTripsEveryEncoding) {
+    const auto now = Date_t::now();
+    BSONObjBuilder column;
+    column.append("0", 1);
+    column.append("1", 1);
+    column.append("2", 5);
+    column.append("3", -100);
+    column.append("4", std::numeric_limits<int>::max());
+    column.append("5", std::numeric_limits<int>::min());
+    column.append("6", 7LL);
+    column.append("7", std::numeric_limits<long long>::min());
+    column.append("8", std::numeric_limits<long long>::max());
+    column.appendDate("9", now);
+    column.appendDate("10", now + Seconds(1));
+    column.appendDate("11", now + Seconds(2));
+    column.appendDate("12", now + Seconds(2));
+    column.appendDate("13", now - Hours(1));
+    column.append("14", Timestamp(10, 1));
+    column.append("15", Timestamp(10, 2));
+    column.append("16", Timestamp(11, 0));
+    column.append("17", 20.5);
+    column.append("18", 20.5);
+    column.append("19", 21.25);
+    column.append("20", -0.0);
+    column.append("21", 0.0);
+    column.append("22", std::numeric_limits<double>::quiet_NaN());
+    column.append("23", std::numeric_limits<double>::infinity());
+    column.append("24", "a string");
+    column.append("25", "a string");
+    column.append("26", BSON("a" << 1 << "b" << BSON_ARRAY(1 << 2)));
+    column.appendNull("27");
+    column.appendNull("28");
+    column.append("29", true);
+    column.append("30", 3);
+    // Gaps where the field is missing from the measurement.
+    column.append("35", 4);
+    column.append("1000", 4);
+    assertRoundTrip(column.obj());
+}
+
+TEST(BucketCompressionTest, RoundTripsEmptyColumn) {
+    assertRoundTrip(BSONObj());
+}
+
+TEST(BucketCompressionTest, CompressesRegularMeasurements) {
+    const auto start = Date_t::fromMillisSinceEpoch(1600000000000);
+    BSONObjBuilder times;
+    BSONObjBuilder counters;
+    BSONObjBuilder readings;
+    BSONObjBuilder states;
+    for (int i = 0; i < 1000; ++i) {
+        auto position = std::to_string(i);
+        times.appendDate(position, start + Seconds(i));
+        counters.append(position, static_cast<long long>(1000000 + 3 * i));
+        readings.append(position, static_cast<double>(20 + i % 8));
+        states.append(position, i < 500 ? "ok" : "degraded");
+    }
+
+    for (auto&& column : {times.obj(), counters.obj(), readings.obj(), states.obj()}) {
+        auto compressedSize = assertRoundTrip(column);
+        ASSERT_LT(compressedSize * 4, column.objsize()) << column.objsize();
+    }
+}
+
+TEST(BucketCompressionTest, RejectsNonPositionalFieldNames) {
+    for (auto&& column : {BSON("a" << 1),
+                          BSON("1" << 1 << "0" << 2),
+                          BSON("0" << 1 << "0" << 2),
+                          BSON("01" << 1),
+                          BSON("-1" << 1)}) {
+        BSONObjBuilder builder;
+        ASSERT_FALSE(appendCompressedColumn("c", column, &builder)) << column;
+        ASSERT(builder.obj().isEmpty());
+    }
+}
+
+TEST(BucketCompressionTest, RejectsMalformedColumns) {
+    BSONObjBuilder builder;
+    ASSERT(appendCompressedColumn("c", BSON("0" << 1 << "1" << 2 << "2" << "x"), &builder));
+    auto compressed = builder.obj();
+    int len;
+    const char* data = compressed["c"].binData(len);
+
+    // Every strict prefix of the encoding is truncated.
+    for (int prefix = 0; prefix < len; ++prefix) {
+        ASSERT_THROWS(decompressColumn(BSONBinData(data, prefix, BinDataGeneral)), DBException);
+    }
+
+    ASSERT_THROWS_CODE(decompressColumn(BSONBinData(data, len, bdtCustom)), DBException, 5697003);
+
+    std::string withTrailingByte(data, len);
+    withTrailingByte.push_back('\0');
+    ASSERT_THROWS_CODE(
+        decompressColumn(BSONBinData(withTrailingByte.data(), len + 1, BinDataGeneral)),
+        DBException,
+        5697013);
+}
+
+TEST(BucketCompressionTest, CompressesAndDecompressesBuckets) {
+    const auto now = Date_t::now();
+    auto bucket = BSON("_id" << OID::gen() << "control"
+                             << BSON("version" << kTimeseriesControlDefaultVersion << "min"
+                                               << BSON("time" << now << "x" << 1) << "max"
+                                               << BSON("time" << now + Seconds(1) << "x" << 3))
+                             << "meta" << BSON("sensor" << 7) << "data"
+                             << BSON("time" << BSON("0" << now << "1" << now + Seconds(1)) << "x"
+                                            << BSON("0" << 1 << "1" << 3)));
+    ASSERT_FALSE(isCompressedBucket(bucket));
+    ASSERT_BSONOBJ_BINARY_EQ(bucket, decompressBucket(bucket));
+
+    auto compressed = compressBucket(bucket);
+    ASSERT(compressed);
+    ASSERT(isCompressedBucket(*compressed));
+    ASSERT_BSONOBJ_EQ(bucket["_id"].wrap(), (*compressed)["_id"].wrap());
+    ASSERT_BSONOBJ_EQ(bucket["meta"].wrap(), (*compressed)["meta"].wrap());
+    ASSERT_BSONOBJ_EQ(bucket["control"]["min"].wrap(), (*compressed)["control"]["min"].wrap());
+    ASSERT_EQ((*compressed)["data"]["time"].type(), BinData);
+    ASSERT_EQ((*compressed)["data"]["x"].type(), BinData);
+
+    // Compressing is not applied twice.
+    ASSERT_FALSE(compressBucket(*compressed));
+
+    ASSERT_BSONOBJ_BINARY_EQ(bucket, decompressBucket(*compressed));
+}
+
+TEST(BucketCompressionTest, DoesNotCompressBucketsWithNonPositionalColumns) {
+    auto bucket = BSON("_id" << OID::gen() << "control"
+                             << BSON("version" << kTimeseriesControlDefaultVersion) << "data"
+                             << BSON("x" << BSON("a" << 1)));
+    ASSERT_FALSE(compressBucket(bucket));
+}
+
+}  // namespace
+}  // namespace mongo
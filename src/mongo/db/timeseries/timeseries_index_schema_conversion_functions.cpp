@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace timeseries {
+
+namespace {
+// The options of an index on a time-series collection which keep their meaning on the buckets
+// collection. Options such as 'unique' or 'partialFilterExpression' refer to measurements and
+// would apply to whole buckets instead.
+const StringData kAllowedIndexOptions[] = {IndexDescriptor::kKeyPatternFieldName,
+                                           IndexDescriptor::kIndexNameFieldName,
+                                           IndexDescriptor::kIndexVersionFieldName,
+                                           IndexDescriptor::kHiddenFieldName,
+                                           IndexDescriptor::kCollationFieldName,
+                                           IndexDescriptor::kBackgroundFieldName};
+
+bool isAllowedIndexOption(StringData fieldName) {
+    return std::find(std::begin(kAllowedIndexOptions), std::end(kAllowedIndexOptions), fieldName) !=
+        std::end(kAllowedIndexOptions);
+}
+}  // namespace
+
+StatusWith<BSONObj> createBucketsIndexSpecFromTimeseriesIndexSpec(
+    const TimeseriesOptions& timeseriesOptions, const BSONObj& timeseriesIndexSpecBSON) {
+    auto timeField = timeseriesOptions.getTimeField();
+    auto metaField = timeseriesOptions.getMetaField();
+
+    const std::string controlMinTimeField = str::stream() << "control.min." << timeField;
+    const std::string controlMaxTimeField = str::stream() << "control.max." << timeField;
+
+    BSONObjBuilder builder;
+    for (const auto& elem : timeseriesIndexSpecBSON) {
+        auto fieldName = elem.fieldNameStringData();
+
+        if (fieldName == timeField) {
+            if (!elem.isNumber() || elem.number() == 0) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "Invalid index spec for time-series collection: "
+                                      << timeseriesIndexSpecBSON << ". The timeField '"
+                                      << timeField << "' can only be indexed in ascending or "
+                                      << "descending order"};
+            }
+            // Every measurement of a bucket lies between the bucket's time bounds, so indexing
+            // both lets a time range be answered from the index bounds on either.
+            if (elem.number() > 0) {
+                builder.append(controlMinTimeField, 1);
+                builder.append(controlMaxTimeField, 1);
+            } else {
+                builder.append(controlMaxTimeField, -1);
+                builder.append(controlMinTimeField, -1);
+            }
+            continue;
+        }
+
+        if (metaField && fieldName == *metaField) {
+            builder.appendAs(elem, "meta");
+            continue;
+        }
+
+        if (metaField && fieldName.startsWith(str::stream() << *metaField << ".")) {
+            builder.appendAs(elem,
+                             str::stream() << "meta" << fieldName.substr(metaField->size()));
+            continue;
+        }
+
+        str::stream errmsg;
+        errmsg << "Invalid index spec for time-series collection: " << timeseriesIndexSpecBSON
+               << ". Indexes can only be created on the timeField '" << timeField << "'";
+        if (metaField) {
+            errmsg << " and the metaField '" << *metaField << "' or its subfields";
+        }
+        return {ErrorCodes::BadValue, errmsg};
+    }
+
+    return builder.obj();
+}
+
+BSONObj makeTimeseriesCreateIndexesCommand(const NamespaceString& ns,
+                                           const TimeseriesOptions& timeseriesOptions,
+                                           const BSONObj& origCmd) {
+    BSONObjBuilder builder;
+    for (const auto& elem : origCmd) {
+        auto fieldName = elem.fieldNameStringData();
+
+        if (fieldName == "createIndexes"_sd) {
+            builder.append(fieldName, ns.makeTimeseriesBucketsNamespace().coll());
+            continue;
+        }
+
+        if (fieldName != "indexes"_sd || elem.type() != BSONType::Array) {
+            // Malformed commands are left to the regular validation of the createIndexes command.
+            builder.append(elem);
+            continue;
+        }
+
+        BSONArrayBuilder indexes(builder.subarrayStart(fieldName));
+        for (const auto& indexElem : elem.Obj()) {
+            if (indexElem.type() != BSONType::Object) {
+                indexes.append(indexElem);
+                continue;
+            }
+
+            BSONObjBuilder index(indexes.subobjStart());
+            for (const auto& optionElem : indexElem.Obj()) {
+                auto optionName = optionElem.fieldNameStringData();
+                uassert(ErrorCodes::InvalidOptions,
+                        str::stream() << "Invalid option '" << optionName
+                                      << "' in index spec for time-series collection " << ns << ": "
+                                      << indexElem.Obj(),
+                        isAllowedIndexOption(optionName));
+
+                if (optionName == IndexDescriptor::kKeyPatternFieldName &&
+                    optionElem.type() == BSONType::Object) {
+                    index.append(optionName,
+                                 uassertStatusOK(createBucketsIndexSpecFromTimeseriesIndexSpec(
+                                     timeseriesOptions, optionElem.Obj())));
+                } else {
+                    index.append(optionElem);
+                }
+            }
+        }
+    }
+
+    return builder.obj();
+}
+
+}  // namespace timeseries
+}  // namespace mongo
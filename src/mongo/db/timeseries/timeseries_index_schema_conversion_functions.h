@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/status_with.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Maps the key pattern 'timeseriesIndexSpecBSON' of an index requested on a time-series collection
+ * to the key pattern of the equivalent index on its buckets collection.
+ *
+ * The metaField and its subfields map to the 'meta' field of a bucket. The timeField maps to the
+ * 'control.min' and 'control.max' bounds of the bucket, in that order for an ascending key and in
+ * reverse order for a descending one. Measurement fields are stored in the bucket's data columns,
+ * which cannot be indexed, so an error is returned for keys on any other field.
+ */
+StatusWith<BSONObj> createBucketsIndexSpecFromTimeseriesIndexSpec(
+    const TimeseriesOptions& timeseriesOptions, const BSONObj& timeseriesIndexSpecBSON);
+
+/**
+ * Rewrites the createIndexes command 'origCmd' on a time-series collection into a createIndexes
+ * command on its buckets collection, translating the key pattern of each index with the function
+ * above. Throws if an index cannot be translated.
+ */
+BSONObj makeTimeseriesCreateIndexesCommand(const NamespaceString& ns,
+                                           const TimeseriesOptions& timeseriesOptions,
+                                           const BSONObj& origCmd);
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using namespace timeseries;
+
+TimeseriesOptions makeTimeseriesOptions() {
+    TimeseriesOptions options("tm");
+    options.setMetaField("mm"_sd);
+    return options;
+}
+
+BSONObj convert(const BSONObj& keyPattern) {
+    return uassertStatusOK(
+        createBucketsIndexSpecFromTimeseriesIndexSpec(makeTimeseriesOptions(), keyPattern));
+}
+
+TEST(TimeseriesIndexSchemaConversionTest, MetaFieldMapsToBucketMeta) {
+    ASSERT_BSONOBJ_EQ(fromjson("{meta: 1}"), convert(fromjson("{mm: 1}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{'meta.a': -1, 'meta.b.c': 1}"),
+                      convert(fromjson("{'mm.a': -1, 'mm.b.c': 1}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{meta: 'hashed'}"), convert(fromjson("{mm: 'hashed'}")));
+}
+
+TEST(TimeseriesIndexSchemaConversionTest, TimeFieldMapsToBucketBounds) {
+    ASSERT_BSONOBJ_EQ(fromjson("{meta: 1, 'control.min.tm': 1, 'control.max.tm': 1}"),
+                      convert(fromjson("{mm: 1, tm: 1}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{'meta.a': 1, 'control.max.tm': -1, 'control.min.tm': -1}"),
+                      convert(fromjson("{'mm.a': 1, tm: -1}")));
+}
+
+TEST(TimeseriesIndexSchemaConversionTest, MeasurementFieldsCannotBeIndexed) {
+    auto options = makeTimeseriesOptions();
+    ASSERT_NOT_OK(createBucketsIndexSpecFromTimeseriesIndexSpec(options, fromjson("{a: 1}")));
+    ASSERT_NOT_OK(createBucketsIndexSpecFromTimeseriesIndexSpec(options, fromjson("{mmx: 1}")));
+    ASSERT_NOT_OK(createBucketsIndexSpecFromTimeseriesIndexSpec(options, fromjson("{tm: 'text'}")));
+    ASSERT_NOT_OK(createBucketsIndexSpecFromTimeseriesIndexSpec(TimeseriesOptions("tm"),
+                                                                fromjson("{mm: 1}")));
+}
+
+TEST(TimeseriesIndexSchemaConversionTest, CreateIndexesCommandTargetsBucketsCollection) {
+    NamespaceString ns("test.ts");
+    auto cmd = makeTimeseriesCreateIndexesCommand(
+        ns,
+        makeTimeseriesOptions(),
+        fromjson("{createIndexes: 'ts', indexes: [{key: {mm: 1, tm: 1}, name: 'mm_1_tm_1'}], "
+                 "commitQuorum: 'majority'}"));
+    ASSERT_BSONOBJ_EQ(fromjson("{createIndexes: 'system.buckets.ts', indexes: [{key: {meta: 1, "
+                               "'control.min.tm': 1, 'control.max.tm': 1}, name: 'mm_1_tm_1'}], "
+                               "commitQuorum: 'majority'}"),
+                      cmd);
+
+    ASSERT_THROWS_CODE(
+        makeTimeseriesCreateIndexesCommand(
+            ns,
+            makeTimeseriesOptions(),
+            fromjson("{createIndexes: 'ts', indexes: [{key: {mm: 1}, name: 'a', unique: true}]}")),
+        DBException,
+        ErrorCodes::InvalidOptions);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -43,6 +43,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/rpc/factory.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/net/hostandport.h"
 #include "mongo/util/producer_consumer_queue.h"
 #include "mongo/util/str.h"
 
@@ -120,9 +121,9 @@ public:
                         uassertStatusOK(db.writeAndAdvance<LittleEndian<uint32_t>>(0));
                         uassertStatusOK(db.writeAndAdvance<LittleEndian<uint64_t>>(packet.id));
                         uassertStatusOK(db.writeAndAdvance<Terminated<'\0', StringData>>(
-                            StringData(packet.local)));
+                            StringData(packet.local.toString())));
                         uassertStatusOK(db.writeAndAdvance<Terminated<'\0', StringData>>(
-                            StringData(packet.remote)));
+                            StringData(packet.remote.toString())));
                         uassertStatusOK(db.writeAndAdvance<LittleEndian<uint64_t>>(
                             packet.now.toMillisSinceEpoch()));
                         uassertStatusOK(db.writeAndAdvance<LittleEndian<uint64_t>>(packet.order));
@@ -162,8 +163,9 @@ public:
                     const uint64_t order,
                     const Message& message) {
         try {
-            _pcqPipe.producer.push(
-                {ts->id(), ts->local().toString(), ts->remote().toString(), now, order, message});
+            // The addresses are formatted by the recording thread, so that recording costs the
+            // session's thread as little as possible.
+            _pcqPipe.producer.push({ts->id(), ts->local(), ts->remote(), now, order, message});
             return true;
         } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueProducerQueueDepthExceeded>&) {
             invariant(!shouldAlwaysRecordTraffic);
@@ -212,8 +214,8 @@ public:
 private:
     struct TrafficRecordingPacket {
         const uint64_t id;
-        const std::string local;
-        const std::string remote;
+        const HostAndPort local;
+        const HostAndPort remote;
         const Date_t now;
         const uint64_t order;
         const Message message;
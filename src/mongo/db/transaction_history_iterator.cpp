@@ -38,6 +38,7 @@
 #include "mongo/db/query/query_request.h"
 #include "mongo/db/repl/local_oplog_info.h"
 #include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/logv2/redaction.h"
 #include "mongo/util/str.h"
@@ -56,6 +57,30 @@ BSONObj findOneOplogEntry(OperationContext* opCtx,
     BSONObj oplogBSON;
     invariant(!opTime.isNull());
 
+    AutoGetOplog oplogRead(opCtx, OplogAccessMode::kRead);
+    const auto localDb = DatabaseHolder::get(opCtx)->getDb(opCtx, NamespaceString::kLocalDb);
+    invariant(localDb);
+    AutoStatsTracker statsTracker(
+        opCtx,
+        NamespaceString::kRsOplogNamespace,
+        Top::LockType::ReadLocked,
+        AutoStatsTracker::LogMode::kUpdateTop,
+        CollectionCatalog::get(opCtx)->getDatabaseProfileLevel(NamespaceString::kLocalDb),
+        Date_t::max());
+
+    // Oplog records are normally keyed by their timestamp, which turns the lookup into a single
+    // seek. The entry found is checked against 'opTime' in case the storage engine keys its oplog
+    // differently, in which case we fall back to a query.
+    if (auto recordId = oploghack::keyForOptime(opTime.getTimestamp()); recordId.isOK()) {
+        Snapshotted<BSONObj> doc;
+        if (oplogRead.getCollection()->findDoc(opCtx, recordId.getValue(), &doc)) {
+            auto docOpTime = repl::OpTime::parseFromOplogEntry(doc.value());
+            if (docOpTime.isOK() && docOpTime.getValue() == opTime) {
+                return doc.value().getOwned();
+            }
+        }
+    }
+
     auto qr = std::make_unique<QueryRequest>(NamespaceString::kRsOplogNamespace);
     qr->setFilter(opTime.asQuery());
 
@@ -76,17 +101,6 @@ BSONObj findOneOplogEntry(OperationContext* opCtx,
                             << causedBy(statusWithCQ.getStatus()));
     std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
 
-    AutoGetOplog oplogRead(opCtx, OplogAccessMode::kRead);
-    const auto localDb = DatabaseHolder::get(opCtx)->getDb(opCtx, NamespaceString::kLocalDb);
-    invariant(localDb);
-    AutoStatsTracker statsTracker(
-        opCtx,
-        NamespaceString::kRsOplogNamespace,
-        Top::LockType::ReadLocked,
-        AutoStatsTracker::LogMode::kUpdateTop,
-        CollectionCatalog::get(opCtx)->getDatabaseProfileLevel(NamespaceString::kLocalDb),
-        Date_t::max());
-
     auto exec = uassertStatusOK(
         getExecutorFind(opCtx, &oplogRead.getCollection(), std::move(cq), permitYield));
 
@@ -166,6 +166,18 @@ TEST_F(SessionHistoryIteratorTest, NextShouldAssertIfHistoryIsTruncated) {
         iter.next(opCtx()), AssertionException, ErrorCodes::IncompleteTransactionHistory);
 }
 
+TEST_F(SessionHistoryIteratorTest, NextShouldAssertIfEntryAtTimestampHasDifferentTerm) {
+    auto entry = makeOplogEntry(repl::OpTime(Timestamp(67, 54801), 2),  // optime
+                                BSON("y" << 50),                        // o
+                                repl::OpTime());  // optime of previous write in transaction
+    insertOplogEntry(entry);
+
+    TransactionHistoryIterator iter(repl::OpTime(Timestamp(67, 54801), 3));
+    ASSERT_TRUE(iter.hasNext());
+    ASSERT_THROWS_CODE(
+        iter.next(opCtx()), AssertionException, ErrorCodes::IncompleteTransactionHistory);
+}
+
 TEST_F(SessionHistoryIteratorTest, OplogInWriteHistoryChainWithMissingPrevTSShouldAssert) {
     auto entry = makeOplogEntry(repl::OpTime(Timestamp(67, 54801), 2),  // optime
                                 BSON("y" << 50),                        // o
@@ -1293,7 +1293,9 @@ void TransactionParticipant::Participant::clearOperationsInMemory(OperationConte
               str::stream() << "Current state: " << o().txnState);
     invariant(p().autoCommit);
     p().transactionOperationBytes = 0;
-    p().transactionOperations.clear();
+    // Release the vector's storage rather than only its elements. The participant outlives the
+    // transaction, and a large transaction would otherwise pin its operation array on the session.
+    std::vector<repl::ReplOperation>().swap(p().transactionOperations);
     p().numberOfPreImagesToWrite = 0;
 }
 
@@ -2299,7 +2301,7 @@ void TransactionParticipant::Participant::_resetTransactionState(
     }
 
     p().transactionOperationBytes = 0;
-    p().transactionOperations.clear();
+    std::vector<repl::ReplOperation>().swap(p().transactionOperations);
     o(wl).prepareOpTime = repl::OpTime();
     o(wl).recoveryPrepareOpTime = repl::OpTime();
     p().autoCommit = boost::none;
@@ -58,6 +58,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -72,9 +73,11 @@ const auto getTTLMonitor = ServiceContext::declareDecoration<std::unique_ptr<TTL
 MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
 
 Counter64 ttlPasses;
+Counter64 ttlSubPasses;
 Counter64 ttlDeletedDocuments;
 
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
+ServerStatusMetricField<Counter64> ttlSubPassesDisplay("ttl.subPasses", &ttlSubPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
 
@@ -110,10 +113,16 @@ public:
             tc.get()->setSystemOperationKillableByStepdown(lk);
         }
 
+        // Set when the previous pass ran out of time with expired documents left over, in which
+        // case the next pass starts right away instead of waiting for ttlMonitorSleepSecs.
+        bool moreToDelete = false;
+
         while (true) {
             {
                 // Wait until either ttlMonitorSleepSecs passes or a shutdown is requested.
-                auto deadline = Date_t::now() + Seconds(ttlMonitorSleepSecs.load());
+                auto deadline = moreToDelete ? Date_t::now()
+                                             : Date_t::now() + Seconds(ttlMonitorSleepSecs.load());
+                moreToDelete = false;
                 stdx::unique_lock<Latch> lk(_stateMutex);
 
                 MONGO_IDLE_THREAD_BLOCK;
@@ -140,7 +149,7 @@ public:
             }
 
             try {
-                doTTLPass();
+                moreToDelete = doTTLPass();
             } catch (const WriteConflictException&) {
                 LOGV2_DEBUG(22531, 1, "got WriteConflictException");
             } catch (const ExceptionForCat<ErrorCategory::Interruption>& interruption) {
@@ -168,9 +177,12 @@ public:
 
 private:
     /**
-     * Gets all TTL indexes from every collection and performs doTTLForIndex().
+     * Gets all TTL indexes from every collection and performs doTTLForIndex() on them, in
+     * sub-passes that revisit the indexes left with expired documents until none are left or
+     * ttlMonitorSubPassTargetSecs has passed. Returns true if expired documents are left over.
      */
-    void doTTLPass() {
+    bool doTTLPass() {
+        Timer passTimer;
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
         OperationContext& opCtx = *opCtxPtr;
 
@@ -178,7 +190,7 @@ private:
         if (repl::ReplicationCoordinator::get(&opCtx)->getReplicationMode() ==
                 repl::ReplicationCoordinator::modeReplSet &&
             !repl::ReplicationCoordinator::get(&opCtx)->getMemberState().readable())
-            return;
+            return false;
 
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         std::vector<std::pair<UUID, std::string>> ttlInfos = ttlCollectionCache.getTTLInfos();
@@ -240,35 +252,54 @@ private:
             ttlIndexes.push_back(std::make_pair(*nss, spec.getOwned()));
         }
 
-        for (const auto& it : ttlIndexes) {
-            try {
-                doTTLForIndex(&opCtx, it.first, it.second);
-            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
-                LOGV2_WARNING(22537,
-                              "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
-                              "seconds before doing another pass",
-                              "TTLMonitor was interrupted, waiting before doing another pass",
-                              "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
-                return;
-            } catch (const DBException& dbex) {
-                LOGV2_ERROR(22538,
-                            "Error processing ttl index: {it_second} -- {dbex}",
-                            "Error processing TTL index",
-                            "index"_attr = it.second,
-                            "error"_attr = dbex);
-                // Continue on to the next index.
-                continue;
+        while (!ttlIndexes.empty()) {
+            ttlSubPasses.increment();
+
+            // Indexes that reached their deletion target with expired documents left over.
+            std::vector<std::pair<NamespaceString, BSONObj>> unfinishedIndexes;
+            for (const auto& it : ttlIndexes) {
+                try {
+                    if (!doTTLForIndex(&opCtx, it.first, it.second)) {
+                        unfinishedIndexes.push_back(it);
+                    }
+                } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                    LOGV2_WARNING(22537,
+                                  "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
+                                  "seconds before doing another pass",
+                                  "TTLMonitor was interrupted, waiting before doing another pass",
+                                  "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+                    return false;
+                } catch (const DBException& dbex) {
+                    LOGV2_ERROR(22538,
+                                "Error processing ttl index: {it_second} -- {dbex}",
+                                "Error processing TTL index",
+                                "index"_attr = it.second,
+                                "error"_attr = dbex);
+                    // Continue on to the next index.
+                    continue;
+                }
+            }
+
+            ttlIndexes = std::move(unfinishedIndexes);
+            if (!ttlIndexes.empty() && passTimer.seconds() >= ttlMonitorSubPassTargetSecs.load()) {
+                // Start over with a fresh list of TTL indexes, so that indexes created or dropped
+                // during a long backlog are noticed.
+                return true;
             }
         }
+        return false;
     }
 
     /**
      * Removes documents from the collection using the specified TTL index after a sufficient amount
-     * of time has passed according to its expiry specification.
+     * of time has passed according to its expiry specification. Stops early once the index has
+     * deleted ttlIndexDeleteTargetDocs documents or spent ttlIndexDeleteTargetTimeMS, so that a
+     * large backlog on one index does not hold up the others. Returns false if it stopped early,
+     * and true once there is nothing left for this index to do.
      */
-    void doTTLForIndex(OperationContext* opCtx, NamespaceString collectionNSS, BSONObj idx) {
+    bool doTTLForIndex(OperationContext* opCtx, NamespaceString collectionNSS, BSONObj idx) {
         if (collectionNSS.isDropPendingNamespace()) {
-            return;
+            return true;
         }
         if (!userAllowedWriteNS(collectionNSS).isOK()) {
             LOGV2_ERROR(
@@ -277,7 +308,7 @@ private:
                 "Namespace doesn't allow deletes, skipping TTL job",
                 logAttrs(collectionNSS),
                 "index"_attr = idx);
-            return;
+            return true;
         }
 
         const BSONObj key = idx["key"].Obj();
@@ -287,7 +318,7 @@ private:
                         "key for ttl index can only have 1 field, skipping ttl job for: {index}",
                         "Key for ttl index can only have 1 field, skipping TTL job",
                         "index"_attr = idx);
-            return;
+            return true;
         }
 
         LOGV2_DEBUG(22533,
@@ -305,11 +336,11 @@ private:
 
         if (!collection) {
             // Collection was dropped.
-            return;
+            return true;
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return true;
         }
 
         ResourceConsumption::ScopedMetricsCollector scopedMetrics(opCtx,
@@ -322,7 +353,7 @@ private:
                         "index not found (index build in progress? index dropped?), skipping ttl "
                         "job for: {idx}",
                         "idx"_attr = idx);
-            return;
+            return true;
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
@@ -334,7 +365,7 @@ private:
                         "special index can't be used as a ttl index, skipping ttl job for: {index}",
                         "Special index can't be used as a TTL index, skipping TTL job",
                         "index"_attr = idx);
-            return;
+            return true;
         }
 
         BSONElement secondsExpireElt = idx[IndexDescriptor::kExpireAfterSecondsFieldName];
@@ -346,7 +377,7 @@ private:
                         "field"_attr = IndexDescriptor::kExpireAfterSecondsFieldName,
                         "type"_attr = typeName(secondsExpireElt.type()),
                         "index"_attr = idx);
-            return;
+            return true;
         }
 
         const Date_t kDawnOfTime =
@@ -374,6 +405,9 @@ private:
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
         params->canonicalQuery = canonicalQuery.getValue().get();
+        // Have the executor report each deletion, so that this index can be left once it reaches
+        // its deletion target.
+        params->returnDeleted = true;
 
         auto exec =
             InternalPlanner::deleteWithIndexScan(opCtx,
@@ -386,22 +420,35 @@ private:
                                                  PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
                                                  direction);
 
-        try {
-            const auto numDeleted = exec->executeDelete();
+        const long long targetDocs = ttlIndexDeleteTargetDocs.load();
+        const int targetTimeMS = ttlIndexDeleteTargetTimeMS.load();
+        Timer timer;
+        long long numDeleted = 0;
+        ON_BLOCK_EXIT([&] {
             ttlDeletedDocuments.increment(numDeleted);
             LOGV2_DEBUG(22536, 1, "deleted: {numDeleted}", "numDeleted"_attr = numDeleted);
+        });
+
+        try {
+            BSONObj deletedDoc;
+            while (exec->getNext(&deletedDoc, nullptr) == PlanExecutor::ADVANCED) {
+                ++numDeleted;
+                if ((targetDocs > 0 && numDeleted >= targetDocs) ||
+                    (targetTimeMS > 0 && timer.millis() >= targetTimeMS)) {
+                    return false;
+                }
+            }
         } catch (const ExceptionFor<ErrorCodes::QueryPlanKilled>&) {
             // It is expected that a collection drop can kill a query plan while the TTL monitor is
             // deleting an old document, so ignore this error.
-            return;
         } catch (const DBException& exception) {
             LOGV2_WARNING(22543,
                           "ttl query execution for index {index} failed with status: {error}",
                           "TTL query execution failed",
                           "index"_attr = idx,
                           "error"_attr = redact(exception.toStatus()));
-            return;
         }
+        return true;
     }
 
     // Protects the state below.
@@ -681,10 +681,47 @@ std::shared_ptr<const ViewDefinition> ViewCatalog::lookupWithoutValidatingDurabl
     return _lookup(opCtx, ns, ViewCatalogLookupBehavior::kAllowInvalidDurableViews);
 }
 
+boost::optional<ResolvedView> ViewCatalog::ResolvedViewCache::find(
+    const NamespaceString& nss) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _resolvedViews.find(nss.ns());
+    if (it == _resolvedViews.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+void ViewCatalog::ResolvedViewCache::insert(const NamespaceString& nss,
+                                            const ResolvedView& resolvedView) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _resolvedViews.emplace(nss.ns(), resolvedView);
+}
+
+void ViewCatalog::ResolvedViewCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _resolvedViews.clear();
+}
+
 StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                                                   const NamespaceString& nss) const {
     _requireValidCatalog();
 
+    if (auto cached = _resolvedViewCache.find(nss)) {
+        return std::move(*cached);
+    }
+
+    auto resolved = _resolveView(opCtx, nss);
+    // Only cache the resolution of actual views, so the number of entries is bounded by the
+    // number of views in the database.
+    if (resolved.isOK() &&
+        _lookup(opCtx, nss.ns(), ViewCatalogLookupBehavior::kValidateDurableViews)) {
+        _resolvedViewCache.insert(nss, resolved.getValue());
+    }
+    return resolved;
+}
+
+StatusWith<ResolvedView> ViewCatalog::_resolveView(OperationContext* opCtx,
+                                                   const NamespaceString& nss) const {
     // Keep looping until the resolution completes. If the catalog is invalidated during the
     // resolution, we start over from the beginning.
     while (true) {
@@ -135,6 +135,8 @@ public:
      * Resolve the views on 'nss', transforming the pipeline appropriately. This function returns a
      * fully-resolved view definition containing the backing namespace, the resolved pipeline and
      * the collation to use for the operation.
+     *
+     * Successful resolutions of views are memoized for the lifetime of this instance.
      */
     StatusWith<ResolvedView> resolveView(OperationContext* opCtx, const NamespaceString& nss) const;
 
@@ -207,11 +209,41 @@ private:
      */
     void _requireValidCatalog() const;
 
+    /**
+     * Walks the view graph to resolve the views on 'nss'. See resolveView().
+     */
+    StatusWith<ResolvedView> _resolveView(OperationContext* opCtx,
+                                          const NamespaceString& nss) const;
+
+    /**
+     * Memoized results of resolveView(), keyed by the namespace of the view. Instances returned by
+     * get() are never modified, so an entry stays valid for as long as the instance it was
+     * computed on. Copying a ViewCatalog to modify it starts the copy with an empty cache.
+     */
+    class ResolvedViewCache {
+    public:
+        ResolvedViewCache() = default;
+        ResolvedViewCache(const ResolvedViewCache&) {}
+        ResolvedViewCache& operator=(const ResolvedViewCache&) {
+            clear();
+            return *this;
+        }
+
+        boost::optional<ResolvedView> find(const NamespaceString& nss) const;
+        void insert(const NamespaceString& nss, const ResolvedView& resolvedView) const;
+        void clear();
+
+    private:
+        mutable Mutex _mutex = MONGO_MAKE_LATCH("ViewCatalog::ResolvedViewCache::_mutex");
+        mutable StringMap<ResolvedView> _resolvedViews;
+    };
+
     ViewMap _viewMap;
     ViewMap _viewMapBackup;
     std::shared_ptr<DurableViewCatalog> _durable;
     bool _valid;
     ViewGraph _viewGraph;
     bool _viewGraphNeedsRefresh;
+    ResolvedViewCache _resolvedViewCache;
 };
 }  // namespace mongo
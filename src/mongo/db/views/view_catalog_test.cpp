@@ -740,5 +740,42 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectlyExtractsDefaultCollation) {
                       expectedCollation.getValue()->getSpec().toBSON());
 }
 
+TEST_F(ViewCatalogFixture, ResolveViewReflectsModificationOfUnderlyingView) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString viewOn("db.coll");
+    BSONArrayBuilder pipeline1;
+    BSONArrayBuilder pipeline2;
+    BSONArrayBuilder modifiedPipeline1;
+
+    pipeline1 << BSON("$match" << BSON("foo" << 1));
+    pipeline2 << BSON("$match" << BSON("foo" << 2));
+    modifiedPipeline1 << BSON("$match" << BSON("foo" << 3));
+
+    ASSERT_OK(createView(operationContext(), view1, viewOn, pipeline1.arr(), emptyCollation));
+    ASSERT_OK(createView(operationContext(), view2, view1, pipeline2.arr(), emptyCollation));
+
+    {
+        Lock::DBLock dbLock(operationContext(), "db", MODE_IS);
+        auto catalog = getViewCatalog();
+        auto resolvedView = uassertStatusOK(catalog->resolveView(operationContext(), view2));
+        ASSERT_BSONOBJ_EQ(resolvedView.getPipeline()[0], BSON("$match" << BSON("foo" << 1)));
+
+        // Resolving again on the same catalog instance returns the same result.
+        resolvedView = uassertStatusOK(catalog->resolveView(operationContext(), view2));
+        ASSERT_EQ(resolvedView.getNamespace(), viewOn);
+        ASSERT_EQ(resolvedView.getPipeline().size(), 2U);
+        ASSERT_BSONOBJ_EQ(resolvedView.getPipeline()[0], BSON("$match" << BSON("foo" << 1)));
+    }
+
+    ASSERT_OK(modifyView(operationContext(), view1, viewOn, modifiedPipeline1.arr()));
+
+    Lock::DBLock dbLock(operationContext(), "db", MODE_IS);
+    auto resolvedView = uassertStatusOK(getViewCatalog()->resolveView(operationContext(), view2));
+    ASSERT_EQ(resolvedView.getPipeline().size(), 2U);
+    ASSERT_BSONOBJ_EQ(resolvedView.getPipeline()[0], BSON("$match" << BSON("foo" << 3)));
+    ASSERT_BSONOBJ_EQ(resolvedView.getPipeline()[1], BSON("$match" << BSON("foo" << 2)));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -541,6 +541,63 @@ TEST_F(QueryStageMultiPlanTest, MPSExplainAllPlans) {
     }
 }
 
+// Test that candidates which fall far behind the best one stop being worked during the trial
+// period, while the others keep being worked.
+TEST_F(QueryStageMultiPlanTest, MPSPrunesCandidatesFarBehindTheBestOne) {
+    const double oldPruningRatio = internalQueryPlanEvaluationPruningRatio.load();
+    const int oldPruningMinWorks = internalQueryPlanEvaluationPruningMinWorks.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryPlanEvaluationPruningRatio.store(oldPruningRatio);
+        internalQueryPlanEvaluationPruningMinWorks.store(oldPruningMinWorks);
+    });
+    internalQueryPlanEvaluationPruningRatio.store(10.0);
+    internalQueryPlanEvaluationPruningMinWorks.store(20);
+
+    // Insert a document to create the collection.
+    insert(BSON("x" << 1));
+
+    const int nDocs = 500;
+
+    // The first plan advances on every call to work(), the second one every other call and the
+    // third one every 50 calls.
+    auto ws = std::make_unique<WorkingSet>();
+    auto fastPlan = std::make_unique<MockStage>(_expCtx.get(), ws.get());
+    auto slowerPlan = std::make_unique<MockStage>(_expCtx.get(), ws.get());
+    auto slowestPlan = std::make_unique<MockStage>(_expCtx.get(), ws.get());
+    for (int i = 0; i < nDocs; ++i) {
+        addMember(fastPlan.get(), ws.get(), BSON("x" << 1));
+
+        slowerPlan->enqueueStateCode(PlanStage::NEED_TIME);
+        addMember(slowerPlan.get(), ws.get(), BSON("x" << 1));
+
+        for (int j = 0; j < 49; ++j) {
+            slowestPlan->enqueueStateCode(PlanStage::NEED_TIME);
+        }
+        addMember(slowestPlan.get(), ws.get(), BSON("x" << 1));
+    }
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+
+    auto qr = std::make_unique<QueryRequest>(nss);
+    qr->setFilter(BSON("x" << 1));
+    auto cq = uassertStatusOK(CanonicalQuery::canonicalize(opCtx(), std::move(qr)));
+    auto mps = std::make_unique<MultiPlanStage>(_expCtx.get(), ctx.getCollection(), cq.get());
+    mps->addPlan(createQuerySolution(), std::move(fastPlan), ws.get());
+    mps->addPlan(createQuerySolution(), std::move(slowerPlan), ws.get());
+    mps->addPlan(createQuerySolution(), std::move(slowestPlan), ws.get());
+
+    NoopYieldPolicy yieldPolicy(_clock);
+    ASSERT_OK(mps->pickBestPlan(&yieldPolicy));
+    ASSERT_EQ(mps->bestPlanIdx(), 0);
+
+    // The trial period ends when the first plan has returned enough results. By then the third
+    // plan has been stopped as soon as it could be, and the second one was never stopped.
+    const size_t trialWorks = internalQueryPlanEvaluationMaxResults.load();
+    ASSERT_EQ(mps->getChildren()[0]->getStats()->common.works, trialWorks);
+    ASSERT_EQ(mps->getChildren()[1]->getStats()->common.works, trialWorks);
+    ASSERT_EQ(mps->getChildren()[2]->getStats()->common.works, 20U);
+}
+
 // Test that the plan summary only includes stats from the winning plan.
 //
 // This is a regression test for SERVER-20111.
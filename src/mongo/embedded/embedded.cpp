@@ -78,6 +78,10 @@
 
 #include <boost/filesystem.hpp>
 
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+#include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#endif
+
 
 namespace mongo {
 namespace embedded {
@@ -100,6 +104,27 @@ MONGO_INITIALIZER_WITH_PREREQUISITES(WireSpec, ("EndStartupOptionHandling"))(Ini
 MONGO_INITIALIZER_GENERAL(ForkServer, ("EndStartupOptionHandling"), ("default"))
 (InitializerContext* context) {}
 
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+// The WiredTiger defaults are sized for a dedicated server: a cache of half the RAM above 1GB and
+// four eviction threads. An embedded instance shares a small device with its application, so
+// unless configured otherwise it uses the smallest cache that can be configured and a single
+// eviction thread. Settings in the user's engineConfig come later and still take precedence.
+constexpr double kEmbeddedWiredTigerCacheSizeGB = 0.25;
+constexpr auto kEmbeddedWiredTigerEngineConfig = "eviction=(threads_min=1,threads_max=1),"_sd;
+
+void applyEmbeddedWiredTigerDefaults() {
+    if (wiredTigerGlobalOptions.cacheSizeGB == 0) {
+        wiredTigerGlobalOptions.cacheSizeGB = kEmbeddedWiredTigerCacheSizeGB;
+    }
+    // The options outlive a shutdown, so only add the defaults once per process.
+    if (!StringData(wiredTigerGlobalOptions.engineConfig)
+             .startsWith(kEmbeddedWiredTigerEngineConfig)) {
+        wiredTigerGlobalOptions.engineConfig =
+            kEmbeddedWiredTigerEngineConfig + wiredTigerGlobalOptions.engineConfig;
+    }
+}
+#endif
+
 void setUpCatalog(ServiceContext* serviceContext) {
     DatabaseHolder::set(serviceContext, std::make_unique<DatabaseHolderImpl>());
     IndexAccessMethodFactory::set(serviceContext, std::make_unique<IndexAccessMethodFactoryImpl>());
@@ -227,6 +252,10 @@ ServiceContext* initialize(const char* yaml_config) {
 
     setUpCatalog(serviceContext);
 
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+    applyEmbeddedWiredTigerDefaults();
+#endif
+
     // Creating the operation context before initializing the storage engine allows the storage
     // engine initialization to make use of the lock manager.
     auto startupOpCtx = serviceContext->makeOperationContext(&cc());
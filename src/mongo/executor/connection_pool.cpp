@@ -267,6 +267,14 @@ public:
      */
     void updateState();
 
+    /**
+     * Runs the controller update that updateState() queued on the parent ConnectionPool
+     */
+    void runScheduledUpdate() {
+        _updateScheduled = false;
+        updateController();
+    }
+
     /**
      * Gets a connection from the specific pool. Sinks a unique_lock from the
      * parent to preserve the lock on _mutex
@@ -1235,13 +1243,27 @@ void ConnectionPool::SpecificPool::updateState() {
         return;
     }
 
-    ExecutorFuture(ExecutorPtr(_parent->_factory->getExecutor()))  //
+    _parent->_scheduleControllerUpdate(shared_from_this());
+}
+
+void ConnectionPool::_scheduleControllerUpdate(std::shared_ptr<SpecificPool> pool) {
+    _poolsPendingUpdate.push_back(std::move(pool));
+    if (_poolsPendingUpdate.size() > 1) {
+        // The task scheduled for the first pool will also update this one.
+        return;
+    }
+
+    ExecutorFuture(ExecutorPtr(_factory->getExecutor()))  //
         .getAsync([this, anchor = shared_from_this()](Status&& status) mutable {
             invariant(status);
 
-            stdx::lock_guard lk(_parent->_mutex);
-            _updateScheduled = false;
-            updateController();
+            stdx::lock_guard lk(_mutex);
+
+            // Updates can make pools schedule another update, which must go to a new task.
+            auto pools = std::exchange(_poolsPendingUpdate, {});
+            for (auto& pool : pools) {
+                pool->runScheduledUpdate();
+            }
         });
 }
 
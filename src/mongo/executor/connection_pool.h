@@ -264,6 +264,15 @@ public:
     size_t getNumConnectionsPerHost(const HostAndPort& hostAndPort) const;
 
 private:
+    /**
+     * Queues 'pool' to have its controller updated. The pending updates of all pools are run by a
+     * single executor task, so that e.g. a request fanning out to many hosts takes _mutex once to
+     * update all of their controllers, rather than once per host.
+     *
+     * Must be called while holding _mutex.
+     */
+    void _scheduleControllerUpdate(std::shared_ptr<SpecificPool> pool);
+
     std::string _name;
 
     const std::shared_ptr<DependentTypeFactoryInterface> _factory;
@@ -277,6 +286,9 @@ private:
     PoolId _nextPoolId = 0;
     stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> _pools;
 
+    // Pools waiting for the scheduled controller update task to run updateController().
+    std::vector<std::shared_ptr<SpecificPool>> _poolsPendingUpdate;
+
     EgressTagCloserManager* _manager;
 };
 
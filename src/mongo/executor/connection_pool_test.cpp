@@ -104,8 +104,12 @@ protected:
     template <typename Ptr>
     void dropConnectionsTest(std::shared_ptr<ConnectionPool> const& pool, Ptr t);
 
+    const std::shared_ptr<InlineQueuedCountingExecutor>& getExecutor() const {
+        return _executor;
+    }
+
 private:
-    std::shared_ptr<OutOfLineExecutor> _executor = InlineQueuedCountingExecutor::make();
+    std::shared_ptr<InlineQueuedCountingExecutor> _executor = InlineQueuedCountingExecutor::make();
     std::shared_ptr<ConnectionPool> _pool;
 };
 
@@ -1518,6 +1522,35 @@ TEST_F(ConnectionPoolTest, AsyncGet) {
     }
 }
 
+/**
+ * Verify that requests fanning out to many hosts update the controllers of all of their pools
+ * with a single scheduled task.
+ */
+TEST_F(ConnectionPoolTest, ControllerUpdatesAreBatched) {
+    auto pool = makePool();
+
+    constexpr size_t kNumHosts = 10;
+    std::vector<SemiFuture<ConnectionPool::ConnectionHandle>> futures;
+    const auto tasksRunBefore = getExecutor()->tasksRun.load();
+    ExecutorFuture(getExecutor()).getAsync([&](Status) {
+        for (size_t i = 0; i < kNumHosts; ++i) {
+            futures.push_back(pool->get(HostAndPort("host", 27017 + i),
+                                        transport::kGlobalSSLMode,
+                                        Milliseconds(5000)));
+        }
+    });
+
+    // One task for the requests themselves, and one that updated every pool.
+    ASSERT_EQ(getExecutor()->tasksRun.load() - tasksRunBefore, 2u);
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), kNumHosts);
+
+    for (auto& future : futures) {
+        ConnectionImpl::pushSetup(Status::OK());
+        auto conn = std::move(future).get();
+        doneWith(conn);
+    }
+}
+
 TEST_F(ConnectionPoolTest, ReturnAfterShutdown) {
     auto pool = makePool();
 
@@ -380,6 +380,8 @@ void NetworkInterfaceTL::CommandStateBase::setTimer() {
 void NetworkInterfaceTL::RequestState::returnConnection(Status status) noexcept {
     invariant(conn);
 
+    interface()->_recordRequestFinished(host);
+
     auto connToReturn = std::exchange(conn, {});
 
     if (!status.isOK()) {
@@ -488,6 +490,10 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
                   });
     }
 
+    if (request.hedgeOptions && !targetHostsInAlphabeticalOrder) {
+        _orderTargetsByRequestsInFlight(&request.target);
+    }
+
     auto [cmdState, future] = CommandState::make(this, request, cbHandle);
     if (cmdState->requestOnAny.timeout != cmdState->requestOnAny.kNoTimeout) {
         cmdState->deadline = cmdState->stopwatch.start() + cmdState->requestOnAny.timeout;
@@ -729,6 +735,7 @@ void NetworkInterfaceTL::RequestManager::trySend(
 
         requestState->request = RemoteCommandRequest(cmdState->requestOnAny, idx);
         requestState->host = requestState->request->target;
+        cmdState->interface->_recordRequestStarted(requestState->host);
 
         requests.at(currentSentIdx) = requestState;
     }
@@ -1053,6 +1060,45 @@ void NetworkInterfaceTL::cancelCommand(const TaskExecutor::CallbackHandle& cbHan
                        << redact(cmdStateToCancel->requestOnAny.toString())});
 }
 
+void NetworkInterfaceTL::_recordRequestStarted(const HostAndPort& host) {
+    stdx::lock_guard<Latch> lk(_requestsInFlightMutex);
+    ++_requestsInFlight[host];
+}
+
+void NetworkInterfaceTL::_recordRequestFinished(const HostAndPort& host) {
+    stdx::lock_guard<Latch> lk(_requestsInFlightMutex);
+    auto it = _requestsInFlight.find(host);
+    invariant(it != _requestsInFlight.end());
+    if (--it->second == 0) {
+        _requestsInFlight.erase(it);
+    }
+}
+
+void NetworkInterfaceTL::_orderTargetsByRequestsInFlight(std::vector<HostAndPort>* targets) {
+    if (targets->size() < 2) {
+        return;
+    }
+
+    std::vector<std::pair<size_t, HostAndPort>> load;
+    load.reserve(targets->size());
+    {
+        stdx::lock_guard<Latch> lk(_requestsInFlightMutex);
+        for (auto& target : *targets) {
+            auto it = _requestsInFlight.find(target);
+            load.emplace_back(it == _requestsInFlight.end() ? 0 : it->second, std::move(target));
+        }
+    }
+
+    // The targets arrive in the order the targeter prefers them, which is kept among hosts that are
+    // equally loaded.
+    std::stable_sort(load.begin(), load.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+    for (size_t i = 0; i < load.size(); ++i) {
+        (*targets)[i] = std::move(load[i].second);
+    }
+}
+
 Status NetworkInterfaceTL::_killOperation(std::shared_ptr<RequestState> requestStateToKill) try {
     auto [target, sslMode] = [&] {
         invariant(requestStateToKill->request);
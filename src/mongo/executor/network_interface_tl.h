@@ -334,6 +334,19 @@ private:
 
     Status _killOperation(std::shared_ptr<RequestState> requestStateToKill);
 
+    /**
+     * Track the number of requests that have been sent to each host and not yet returned their
+     * connection.
+     */
+    void _recordRequestStarted(const HostAndPort& host);
+    void _recordRequestFinished(const HostAndPort& host);
+
+    /**
+     * Stably reorder the targets of a hedged request so that the hosts with the fewest requests in
+     * flight are tried first.
+     */
+    void _orderTargetsByRequestsInFlight(std::vector<HostAndPort>* targets);
+
     std::string _instanceName;
     ServiceContext* _svcCtx = nullptr;
     transport::TransportLayer* _tl = nullptr;
@@ -370,6 +383,10 @@ private:
     stdx::unordered_map<TaskExecutor::CallbackHandle, std::shared_ptr<AlarmState>>
         _inProgressAlarms;
 
+    Mutex _requestsInFlightMutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0),
+                                                    "NetworkInterfaceTL::_requestsInFlightMutex");
+    stdx::unordered_map<HostAndPort, size_t> _requestsInFlight;
+
     stdx::condition_variable _workReadyCond;
     bool _isExecutorRunnable = false;
 };
@@ -33,6 +33,7 @@
 
 #include "mongo/executor/thread_pool_task_executor.h"
 
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <iterator>
 #include <utility>
@@ -584,7 +585,8 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                                      const WorkQueue::iterator& end,
                                                      stdx::unique_lock<Latch> lk) {
     dassert(fromQueue != &_poolInProgressQueue);
-    std::vector<std::shared_ptr<CallbackState>> todo(begin, end);
+    // Most callers schedule a single callback, which then needs no heap allocation here.
+    boost::container::small_vector<std::shared_ptr<CallbackState>, 1> todo(begin, end);
     _poolInProgressQueue.splice(_poolInProgressQueue.end(), *fromQueue, begin, end);
 
     lk.unlock();
@@ -803,6 +803,40 @@ TEST(IDLFieldTests, TestOptionalFields) {
     }
 }
 
+TEST(IDLFieldTests, TestStringViewFields) {
+    IDLParserErrorContext ctxt("root");
+
+    auto testDoc = BSON("field1"
+                        << "Foo"
+                        << "field2"
+                        << "Bar");
+    auto testStruct = String_view_fields::parse(ctxt, testDoc);
+
+    assert_same_types<decltype(testStruct.getField1()), const mongo::StringData>();
+    assert_same_types<decltype(testStruct.getField2()), const boost::optional<mongo::StringData>>();
+    assert_same_types<decltype(testStruct.getField3()), const mongo::StringData>();
+
+    // Plain string fields point into the parsed document instead of holding a copy.
+    ASSERT_EQUALS("Foo", testStruct.getField1());
+    ASSERT_EQUALS(testDoc["field1"].valueStringData().rawData(),
+                  testStruct.getField1().rawData());
+    ASSERT_EQUALS(testDoc["field2"].valueStringData().rawData(),
+                  testStruct.getField2()->rawData());
+
+    // Fields with a default keep owning storage.
+    ASSERT_EQUALS("Bar", testStruct.getField3());
+
+    BSONObjBuilder builder;
+    testStruct.serialize(&builder);
+    ASSERT_BSONOBJ_EQ(BSON("field1"
+                           << "Foo"
+                           << "field2"
+                           << "Bar"
+                           << "field3"
+                           << "Bar"),
+                      builder.obj());
+}
+
 TEST(IDLFieldTests, TestAlwaysSerializeFields) {
     IDLParserErrorContext ctxt("root");
 
@@ -32,13 +32,20 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
+#include <deque>
 #include <fmt/format.h>
 #include <fstream>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/string_map.h"
 
 
@@ -68,16 +75,169 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
 }  // namespace
 
 struct FileRotateSink::Impl {
-    Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
+    Impl(LogTimestampFormat tsFormat, size_t asyncBufferBytes)
+        : timestampFormat(tsFormat), asyncBufferBytes(asyncBufferBytes) {}
+
+    // Formats a record that did not come through boost::log, and returns it as a line.
+    template <typename AttributeArgs>
+    std::string formatLine(LogSeverity severity,
+                           int32_t id,
+                           StringData message,
+                           AttributeArgs&& attrs) const {
+        fmt::memory_buffer buffer;
+        JSONFormatter(nullptr, timestampFormat)
+            .format(buffer,
+                    severity,
+                    LogComponent::kControl,
+                    Date_t::now(),
+                    id,
+                    getThreadName(),
+                    message,
+                    TypeErasedAttributeStorage(attrs),
+                    LogTag::kNone,
+                    LogTruncation::Disabled);
+        return std::string(buffer.data(), buffer.size());
+    }
+
+    // Aborts the process if writing to any of the files failed.
+    void checkForFailedFiles() const;
+
+    // Writes out every buffered record. Must be called with 'writeMutex' held.
+    void writeBuffered(WithLock);
+
+    void writerLoop();
+
     StringMap<boost::shared_ptr<stream_t>> files;
     LogTimestampFormat timestampFormat;
+
+    // Limit on the buffered records, or 0 if records are written synchronously.
+    const size_t asyncBufferBytes;
+
+    // Orders writing to the files between the background writer and the logging threads, and
+    // protects 'files'.
+    stdx::mutex writeMutex;  // NOLINT
+
+    // Protects the members below.
+    stdx::mutex bufferMutex;  // NOLINT
+    stdx::condition_variable bufferCondition;
+    std::deque<std::string> buffered;
+    size_t bufferedBytes = 0;
+    long long dropped = 0;
+    bool shuttingDown = false;
+
+    stdx::thread writer;
 };
 
-FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
-    : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+void FileRotateSink::Impl::checkForFailedFiles() const {
+    auto isFailed = [](const auto& file) { return file.second->fail(); };
+    if (std::any_of(files.begin(), files.end(), isFailed)) {
+        try {
+            auto failedBegin = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+            auto failedEnd = boost::make_filter_iterator(isFailed, files.end(), files.end());
+
+            auto getFilename = [](const auto& file) -> const auto& {
+                return file.first;
+            };
+            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
+            auto end = boost::make_transform_iterator(failedEnd, getFilename);
+            auto sequence = logv2::seqLog(begin, end);
+
+            DynamicAttributes attrs;
+            attrs.add("files", sequence);
+
+            // Commented out log line below to get validation of the log id with the errorcodes
+            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
+            std::cout << formatLine(LogSeverity::Severe(),
+                                    4522200,
+                                    "Writing to log file failed, aborting application",
+                                    attrs)
+                      << std::endl;
+        } catch (...) {
+            // If the formatting code throws for any reason, ignore and proceed with aborting the
+            // application.
+        }
+
+        std::abort();
+    }
+}
+
+void FileRotateSink::Impl::writeBuffered(WithLock) {
+    std::deque<std::string> records;
+    long long droppedRecords;
+    {
+        stdx::lock_guard lk(bufferMutex);
+        records.swap(buffered);
+        bufferedBytes = 0;
+        droppedRecords = std::exchange(dropped, 0);
+    }
+
+    if (droppedRecords > 0) {
+        DynamicAttributes attrs;
+        attrs.add("dropped", droppedRecords);
+        // Commented out log line below to get validation of the log id with the errorcodes
+        // linter LOGV2_WARNING(5406800, "Dropped log messages as the asynchronous log buffer was
+        // full");
+        records.push_back(formatLine(LogSeverity::Warning(),
+                                     5406800,
+                                     "Dropped log messages as the asynchronous log buffer was full",
+                                     attrs));
+    }
+
+    if (records.empty()) {
+        return;
+    }
+
+    for (auto& file : files) {
+        for (const auto& record : records) {
+            *file.second << record;
+            if (record.empty() || record.back() != '\n') {
+                *file.second << '\n';
+            }
+        }
+        file.second->flush();
+    }
+    checkForFailedFiles();
+}
+
+void FileRotateSink::Impl::writerLoop() {
+    while (true) {
+        {
+            stdx::unique_lock lk(bufferMutex);
+            bufferCondition.wait(
+                lk, [&] { return !buffered.empty() || dropped > 0 || shuttingDown; });
+            if (shuttingDown) {
+                return;
+            }
+        }
+
+        stdx::lock_guard writeLock(writeMutex);
+        writeBuffered(writeLock);
+    }
+}
+
+FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat, size_t asyncBufferBytes)
+    : _impl(std::make_unique<Impl>(timestampFormat, asyncBufferBytes)) {
+    if (asyncBufferBytes > 0) {
+        _impl->writer = stdx::thread([impl = _impl.get()] { impl->writerLoop(); });
+    }
+}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->writer.joinable()) {
+        {
+            stdx::lock_guard lk(_impl->bufferMutex);
+            _impl->shuttingDown = true;
+        }
+        _impl->bufferCondition.notify_one();
+        _impl->writer.join();
+
+        stdx::lock_guard writeLock(_impl->writeMutex);
+        _impl->writeBuffered(writeLock);
+    }
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
+    stdx::lock_guard writeLock(_impl->writeMutex);
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
         add_stream(statusWithFile.getValue());
@@ -87,6 +247,7 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    stdx::lock_guard writeLock(_impl->writeMutex);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -95,6 +256,10 @@ void FileRotateSink::removeFile(const std::string& filename) {
 }
 
 Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
+    // Everything logged before the rotation belongs in the old file.
+    stdx::lock_guard writeLock(_impl->writeMutex);
+    _impl->writeBuffered(writeLock);
+
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -140,47 +305,36 @@ Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
-    auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
-    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
-        try {
-            auto failedBegin =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-            auto failedEnd =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-
-            auto getFilename = [](const auto& file) -> const auto& {
-                return file.first;
-            };
-            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
-            auto end = boost::make_transform_iterator(failedEnd, getFilename);
-            auto sequence = logv2::seqLog(begin, end);
-
-            DynamicAttributes attrs;
-            attrs.add("files", sequence);
-
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        LogTruncation::Disabled);
-            // Commented out log line below to get validation of the log id with the errorcodes
-            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cout << StringData(buffer.data(), buffer.size()) << std::endl;
-        } catch (...) {
-            // If the formatting code throws for any reason, ignore and proceed with aborting the
-            // application.
+    if (_impl->asyncBufferBytes > 0 &&
+        boost::log::extract<LogSeverity>(attributes::severity(), rec).get() <
+            LogSeverity::Warning()) {
+        bool wasEmpty;
+        {
+            stdx::lock_guard lk(_impl->bufferMutex);
+            if (_impl->bufferedBytes + formatted_string.size() > _impl->asyncBufferBytes) {
+                ++_impl->dropped;
+                return;
+            }
+            wasEmpty = _impl->buffered.empty();
+            _impl->buffered.push_back(formatted_string);
+            _impl->bufferedBytes += formatted_string.size();
         }
-
-        std::abort();
+        if (wasEmpty) {
+            _impl->bufferCondition.notify_one();
+        }
+        return;
     }
+
+    stdx::lock_guard writeLock(_impl->writeMutex);
+    _impl->writeBuffered(writeLock);
+    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+    _impl->checkForFailedFiles();
+}
+
+void FileRotateSink::flush() {
+    stdx::lock_guard writeLock(_impl->writeMutex);
+    _impl->writeBuffered(writeLock);
+    boost::log::sinks::text_ostream_backend::flush();
 }
 
 }  // namespace mongo::logv2
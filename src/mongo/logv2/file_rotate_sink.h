@@ -40,9 +40,15 @@ namespace mongo::logv2 {
 // boost::log backend sink to provide MongoDB style file rotation.
 // Uses custom stream type to open log files with shared access on Windows, somthing the built-in
 // boost file rotation sink does not do.
+//
+// With a non-zero 'asyncBufferBytes', records below warning severity are handed to a background
+// thread that writes them, so the logging thread does not wait for file I/O. At most
+// 'asyncBufferBytes' of such records are buffered; records arriving while the buffer is full are
+// dropped and counted, and the count is written to the log once there is room again. Warnings and
+// more severe records are still written synchronously, after everything buffered before them.
 class FileRotateSink : public boost::log::sinks::text_ostream_backend {
 public:
-    FileRotateSink(LogTimestampFormat timestampFormat);
+    FileRotateSink(LogTimestampFormat timestampFormat, size_t asyncBufferBytes = 0);
     ~FileRotateSink();
 
     Status addFile(const std::string& filename, bool append);
@@ -52,6 +58,9 @@ public:
 
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    // Writes out every buffered record, then flushes the files.
+    void flush();
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _impl;
@@ -43,6 +43,9 @@ public:
         bool consoleEnabled{true};
         bool fileEnabled{false};
         std::string filePath;
+        // When non-zero, records below warning severity are written to the file on a background
+        // thread, buffering at most this many bytes. See FileRotateSink.
+        size_t fileAsyncBufferBytes{0};
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
@@ -31,6 +31,8 @@
 
 #include "mongo/logv2/log_util.h"
 
+#include <boost/log/core/core.hpp>
+
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/time_support.h"
@@ -84,6 +86,10 @@ bool rotateLogs(bool renameFiles, boost::optional<StringData> logType) {
     }
 }
 
+void flushLogs() {
+    boost::log::core::get()->flush();
+}
+
 bool shouldRedactLogs() {
     return redactionEnabled.loadRelaxed();
 }
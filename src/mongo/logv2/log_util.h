@@ -61,6 +61,12 @@ void addLogRotator(StringData logType, LogRotateCallback cb);
  */
 bool rotateLogs(bool renameFiles, boost::optional<StringData> logType = boost::none);
 
+/**
+ * Writes out any log records that are buffered for asynchronous writing and flushes the log
+ * sinks.
+ */
+void flushLogs();
+
 /**
  * Returns true if system logs should be redacted.
  */
@@ -29,10 +29,27 @@
 
 #include "mongo/platform/mutex.h"
 
+#include <chrono>
+
 #include "mongo/base/init.h"
 #include "mongo/bson/bsonobjbuilder.h"
 
 namespace mongo::latch_detail {
+namespace {
+
+int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void storeMax(AtomicWord<long long>& target, long long value) {
+    auto current = target.loadRelaxed();
+    while (value > current && !target.compareAndSwap(&current, value)) {
+    }
+}
+
+}  // namespace
 
 void Identity::serialize(BSONObjBuilder* bob) const {
     bob->append("name"_sd, name());
@@ -71,12 +88,31 @@ void Mutex::lock() {
     }
 
     _onContendedLock();
+    if (!contentionProfilingEnabled().loadRelaxed()) {
+        _mutex.lock();
+        _isLocked = true;
+        _onSlowLock();
+        return;
+    }
+
+    auto waitStart = nowNanos();
     _mutex.lock();
     _isLocked = true;
+    _profiledAcquireNanos = nowNanos();
+
+    auto& counts = _data->counts();
+    auto waited = _profiledAcquireNanos - waitStart;
+    counts.profiledWaits.fetchAndAddRelaxed(1);
+    counts.waitNanos.fetchAndAddRelaxed(waited);
+    storeMax(counts.maxWaitNanos, waited);
     _onSlowLock();
 }
 
 void Mutex::unlock() {
+    if (_profiledAcquireNanos) {
+        storeMax(_data->counts().maxHoldNanos, nowNanos() - _profiledAcquireNanos);
+        _profiledAcquireNanos = 0;
+    }
     _onUnlock();
     _isLocked = false;
     _mutex.unlock();
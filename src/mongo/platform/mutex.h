@@ -190,6 +190,19 @@ inline auto& getDiagnosticListenerState() noexcept {
     return *state;
 }
 
+/**
+ * Switch for latch contention profiling
+ *
+ * While this is set, every Mutex acquisition that has to block records how long it waited and,
+ * on release, how long it was then held into the Counts of its Data. Uncontended acquisitions are
+ * never timed, so the overhead is confined to paths that are already waiting.
+ */
+inline auto& contentionProfilingEnabled() noexcept {
+    // Make state immortal
+    static const auto enabled = new AtomicWord<bool>(false);  // Intentionally leaked!
+    return *enabled;
+}
+
 /**
  * Creates a DiagnosticListener subclass and adds it to the triggers for certain actions.
  *
@@ -238,6 +251,12 @@ private:
         AtomicWord<int> contended{0};
         AtomicWord<int> acquired{0};
         AtomicWord<int> released{0};
+
+        // Only updated for contended acquisitions while contentionProfilingEnabled() is set.
+        AtomicWord<long long> profiledWaits{0};
+        AtomicWord<long long> waitNanos{0};
+        AtomicWord<long long> maxWaitNanos{0};
+        AtomicWord<long long> maxHoldNanos{0};
     };
 
     Counts _counts;
@@ -357,6 +376,9 @@ private:
 
     stdx::mutex _mutex;  // NOLINT
     bool _isLocked = false;
+
+    // When a profiled contended acquisition holds this Mutex, the time it was acquired.
+    int64_t _profiledAcquireNanos = 0;
 };
 }  // namespace latch_detail
 
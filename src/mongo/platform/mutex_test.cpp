@@ -31,6 +31,9 @@
 
 #include "mongo/config.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 TEST(MutexTest, BasicSingleThread) {
@@ -67,6 +70,37 @@ TEST(MutexTest, Macros) {
     static_assert(std::is_same_v<decltype(gMutex), Mutex>);
     ASSERT_EQ(gMutex.getName(), latch_detail::kAnonymousName);
 }
+
+TEST(MutexTest, ContentionProfiling) {
+    auto data = MONGO_GET_LATCH_DATA("MutexTest::ContentionProfiling");
+    Mutex m(data);
+    auto& counts = data->counts();
+
+    // Uncontended acquisitions are never timed.
+    latch_detail::contentionProfilingEnabled().store(true);
+    ON_BLOCK_EXIT([] { latch_detail::contentionProfilingEnabled().store(false); });
+    m.lock();
+    m.unlock();
+    ASSERT_EQ(counts.profiledWaits.load(), 0);
+
+    m.lock();
+    stdx::thread waiter([&] {
+        m.lock();
+        sleepmillis(5);
+        m.unlock();
+    });
+    while (counts.contended.load() == 0) {
+        sleepmillis(1);
+    }
+    sleepmillis(5);
+    m.unlock();
+    waiter.join();
+
+    ASSERT_EQ(counts.profiledWaits.load(), 1);
+    ASSERT_GT(counts.waitNanos.load(), 0);
+    ASSERT_EQ(counts.maxWaitNanos.load(), counts.waitNanos.load());
+    ASSERT_GTE(counts.maxHoldNanos.load(), 5 * 1000 * 1000);
+}
 #endif
 
 }  // namespace mongo
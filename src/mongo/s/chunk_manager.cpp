@@ -192,7 +192,22 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
 }
 
 void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
+    // Same as appendChunkTo(), but also keeps '_maxKeyStrings' in step with '_chunkMap'.
+    bool append = true;
+    if (!_chunkMap.empty() && chunk->getRange().overlaps(_chunkMap.back()->getRange())) {
+        append = _chunkMap.back()->getLastmod().isOlderThan(chunk->getLastmod());
+        if (append) {
+            _chunkMap.pop_back();
+            _maxKeyStringEnds.pop_back();
+            _maxKeyStrings.resize(_maxKeyStringEnds.empty() ? 0 : _maxKeyStringEnds.back());
+        }
+    }
+
+    if (append) {
+        _chunkMap.push_back(chunk);
+        _maxKeyStrings.append(chunk->getMaxKeyString());
+        _maxKeyStringEnds.push_back(_maxKeyStrings.size());
+    }
 
     if (_collectionVersion.isOlderThan(chunk->getLastmod()))
         _collectionVersion = chunk->getLastmod();
@@ -221,8 +236,14 @@ ChunkMap ChunkMap::createMerged(
     size_t chunkMapIndex = 0;
     size_t changedChunkIndex = 0;
 
+    // Min bound KeyString of the changed chunk at 'changedChunkMinKeyStringIndex', computed the
+    // first time it is needed.
+    boost::optional<std::string> changedChunkMinKeyString;
+    size_t changedChunkMinKeyStringIndex = 0;
+
     ChunkMap updatedChunkMap(
         getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
+    updatedChunkMap._maxKeyStrings.reserve(_maxKeyStrings.size());
 
     while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
         if (chunkMapIndex >= _chunkMap.size()) {
@@ -232,7 +253,8 @@ ChunkMap ChunkMap::createMerged(
         }
 
         if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            updatedChunkMap._appendChunksFrom(*this, chunkMapIndex, _chunkMap.size());
+            chunkMapIndex = _chunkMap.size();
             continue;
         }
 
@@ -249,13 +271,54 @@ ChunkMap ChunkMap::createMerged(
             validateChunk(changedChunk, getVersion());
             updatedChunkMap.appendChunk(changedChunk);
         } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            // None of the chunks which end at or before the start of the changed chunk can overlap
+            // it, so copy all of them over at once rather than comparing each one's bounds.
+            const auto& changedChunk = changedChunks[changedChunkIndex];
+            if (!changedChunkMinKeyString || changedChunkMinKeyStringIndex != changedChunkIndex) {
+                changedChunkMinKeyString = ShardKeyPattern::toKeyString(changedChunk->getMin());
+                changedChunkMinKeyStringIndex = changedChunkIndex;
+            }
+
+            const auto end = std::max(
+                chunkMapIndex + 1,
+                _findIntersectingChunkIndex(*changedChunkMinKeyString, true, chunkMapIndex));
+            updatedChunkMap._appendChunksFrom(*this, chunkMapIndex, end);
+            chunkMapIndex = end;
         }
     }
 
     return updatedChunkMap;
 }
 
+void ChunkMap::_appendChunksFrom(const ChunkMap& other, size_t begin, size_t end) {
+    // Only the first chunks of the run can overlap the last chunk already in this map.
+    while (begin < end && !_chunkMap.empty() &&
+           other._chunkMap[begin]->getRange().overlaps(_chunkMap.back()->getRange())) {
+        appendChunk(other._chunkMap[begin++]);
+    }
+
+    if (begin == end)
+        return;
+
+    // The rest of the run neither overlaps this map nor each other, so their KeyStrings can be
+    // copied in a single block.
+    const size_t otherKeyStringsBegin = begin == 0 ? 0 : other._maxKeyStringEnds[begin - 1];
+    const size_t keyStringsBegin = _maxKeyStrings.size();
+    _maxKeyStrings.append(other._maxKeyStrings,
+                          otherKeyStringsBegin,
+                          other._maxKeyStringEnds[end - 1] - otherKeyStringsBegin);
+
+    for (size_t i = begin; i < end; ++i) {
+        const auto& chunk = other._chunkMap[i];
+        _chunkMap.push_back(chunk);
+        _maxKeyStringEnds.push_back(other._maxKeyStringEnds[i] - otherKeyStringsBegin +
+                                    keyStringsBegin);
+
+        if (_collectionVersion.isOlderThan(chunk->getLastmod()))
+            _collectionVersion = chunk->getLastmod();
+    }
+}
+
 BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
@@ -274,23 +337,28 @@ BSONObj ChunkMap::toBSON() const {
 
 ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
                                                                        bool isMaxInclusive) const {
-    auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
-
-    if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
-    } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
+    return _chunkMap.begin() +
+        _findIntersectingChunkIndex(ShardKeyPattern::toKeyString(shardKey), isMaxInclusive, 0);
+}
+
+size_t ChunkMap::_findIntersectingChunkIndex(StringData shardKeyString,
+                                             bool isMaxInclusive,
+                                             size_t begin) const {
+    // Find the first chunk whose max bound is greater than the shard key (or, if the max bound is
+    // exclusive, not less than it), searching only the contiguous max bound KeyStrings.
+    size_t low = begin;
+    size_t high = _maxKeyStringEnds.size();
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const auto maxKeyString = _getMaxKeyString(mid);
+        if (isMaxInclusive ? maxKeyString <= shardKeyString : maxKeyString < shardKeyString) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
     }
+
+    return low;
 }
 
 std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
@@ -81,6 +81,7 @@ public:
                       size_t initialCapacity = 0)
         : _collectionVersion(0, 0, epoch, timestamp) {
         _chunkMap.reserve(initialCapacity);
+        _maxKeyStringEnds.reserve(initialCapacity);
     }
 
     size_t size() const {
@@ -129,8 +130,34 @@ private:
     std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
         const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
 
+    /**
+     * Returns the index of the first chunk at or after 'begin' which contains the shard key whose
+     * KeyString is 'shardKeyString', or which starts after it.
+     */
+    size_t _findIntersectingChunkIndex(StringData shardKeyString,
+                                       bool isMaxInclusive,
+                                       size_t begin) const;
+
+    /**
+     * Appends the chunks of 'other' in the index range [begin, end), which must all come after the
+     * chunks of this map, except that the first few of them may overlap its last chunk.
+     */
+    void _appendChunksFrom(const ChunkMap& other, size_t begin, size_t end);
+
+    StringData _getMaxKeyString(size_t index) const {
+        const size_t begin = index == 0 ? 0 : _maxKeyStringEnds[index - 1];
+        return StringData(_maxKeyStrings.data() + begin, _maxKeyStringEnds[index] - begin);
+    }
+
     ChunkVector _chunkMap;
 
+    // The max bound KeyStrings of the chunks in '_chunkMap', in the same order and stored back to
+    // back, so that binary searches do not need to dereference every ChunkInfo they visit.
+    std::string _maxKeyStrings;
+
+    // Offset in '_maxKeyStrings' at which the KeyString of each chunk in '_chunkMap' ends.
+    std::vector<size_t> _maxKeyStringEnds;
+
     // Max version across all chunks
     ChunkVersion _collectionVersion;
 };
@@ -32,6 +32,8 @@
 #include <benchmark/benchmark.h>
 
 #include "mongo/base/init.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/query/query_test_service_context.h"
 #include "mongo/db/s/collection_metadata.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/chunk_manager.h"
@@ -323,6 +325,60 @@ void BM_GetShardIdsForRangeMinKeyToMaxKey(benchmark::State& state,
     state.SetItemsProcessed(state.iterations());
 }
 
+/**
+ * Targets queries built by 'makeQuery' from the generated keys with getShardIdsForQuery(), which
+ * canonicalizes each query and computes its shard key bounds, as mongos does for every find.
+ */
+template <typename CollectionMetadataBuilderFn, typename QueryBuilderFn>
+void runGetShardIdsForQuery(benchmark::State& state,
+                            CollectionMetadataBuilderFn makeCollectionMetadata,
+                            QueryBuilderFn makeQuery) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    auto metadata = makeCollectionMetadata(nShards, nChunks);
+    auto keys = makeKeys(nChunks);
+    std::vector<BSONObj> queries;
+    for (size_t i = 0; i + 10 <= keys.size(); i += 10) {
+        queries.push_back(makeQuery(keys.begin() + i, keys.begin() + i + 10));
+    }
+    auto queriesIter = makeCircularIterator(queries);
+
+    for (auto keepRunning : state) {
+        auto expCtx = make_intrusive<ExpressionContext>(opCtx.get(), nullptr, kNss);
+        std::set<ShardId> shardIds;
+        metadata.getChunkManager()->getShardIdsForQuery(expCtx, *queriesIter, {}, &shardIds);
+        ++queriesIter;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename CollectionMetadataBuilderFn>
+void BM_GetShardIdsForQueryRange(benchmark::State& state,
+                                 CollectionMetadataBuilderFn makeCollectionMetadata) {
+    runGetShardIdsForQuery(state, makeCollectionMetadata, [](auto begin, auto end) {
+        auto min = std::min_element(begin, end, SimpleBSONObjComparator::kInstance.makeLessThan());
+        auto max = std::max_element(begin, end, SimpleBSONObjComparator::kInstance.makeLessThan());
+        return BSON("_id" << BSON("$gte" << min->firstElement() << "$lt" << max->firstElement()));
+    });
+}
+
+template <typename CollectionMetadataBuilderFn>
+void BM_GetShardIdsForQueryIn(benchmark::State& state,
+                              CollectionMetadataBuilderFn makeCollectionMetadata) {
+    runGetShardIdsForQuery(state, makeCollectionMetadata, [](auto begin, auto end) {
+        BSONArrayBuilder values;
+        for (auto it = begin; it != end; ++it) {
+            values.append(it->firstElement());
+        }
+        return BSON("_id" << BSON("$in" << values.arr()));
+    });
+}
+
 template <typename CollectionMetadataBuilderFn>
 void BM_KeyBelongsToMe(benchmark::State& state,
                        CollectionMetadataBuilderFn makeCollectionMetadata) {
@@ -402,6 +458,15 @@ MONGO_INITIALIZER(RegisterBenchmarks)(InitializerContext* context) {
             BM_RangeOverlapsChunk, Pessimal, makeChunkManagerWithPessimalBalancedDistribution),
         REGISTER_BENCHMARK_CAPTURE(
             BM_RangeOverlapsChunk, Optimal, makeChunkManagerWithOptimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(BM_GetShardIdsForQueryRange,
+                                   Pessimal,
+                                   makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(
+            BM_GetShardIdsForQueryRange, Optimal, makeChunkManagerWithOptimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(
+            BM_GetShardIdsForQueryIn, Pessimal, makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(
+            BM_GetShardIdsForQueryIn, Optimal, makeChunkManagerWithOptimalBalancedDistribution),
     };
 
     for (auto bmCase : bmCases) {
@@ -411,6 +476,21 @@ MONGO_INITIALIZER(RegisterBenchmarks)(InitializerContext* context) {
             ->Args({1000, 50000})
             ->Args({2, 2});
     }
+
+    // Routing lookups on collections with very large numbers of chunks.
+    std::initializer_list<benchmark::internal::Benchmark*> largeBmCases{
+        REGISTER_BENCHMARK_CAPTURE(BM_FindIntersectingChunk,
+                                   PessimalLarge,
+                                   makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(
+            BM_GetShardIdsForRange, PessimalLarge, makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(
+            BM_KeyBelongsToMe, PessimalLarge, makeChunkManagerWithPessimalBalancedDistribution),
+    };
+
+    for (auto bmCase : largeBmCases) {
+        bmCase->Args({100, 500000})->Args({100, 1500000});
+    }
 }
 
 }  // namespace
@@ -132,6 +132,98 @@ TEST_F(ChunkMapTest, TestIntersectingChunk) {
                                                        BSON("a" << 100)));
 }
 
+TEST_F(ChunkMapTest, TestIntersectingChunkAfterSplit) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    auto chunkMapBeforeSplit = chunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{getShardKeyPattern().globalMin(), BSON("a" << 0)},
+                       version,
+                       kThisShard}),
+
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss,
+             ChunkRange{BSON("a" << 0), getShardKeyPattern().globalMax()},
+             version,
+             kThisShard})});
+
+    version.incMajor();
+    auto newChunkMap = chunkMapBeforeSplit.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss, ChunkRange{BSON("a" << 0), BSON("a" << 100)}, version, kThisShard}),
+
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss,
+             ChunkRange{BSON("a" << 100), getShardKeyPattern().globalMax()},
+             version,
+             kThisShard})});
+
+    ASSERT_EQ(newChunkMap.size(), 3);
+
+    // A key equal to a chunk's max bound belongs to the next chunk.
+    auto intersectingChunk = newChunkMap.findIntersectingChunk(BSON("a" << 100));
+    ASSERT(intersectingChunk);
+    ASSERT(SimpleBSONObjComparator::kInstance.evaluate(intersectingChunk->getMin() ==
+                                                       BSON("a" << 100)));
+
+    intersectingChunk = newChunkMap.findIntersectingChunk(BSON("a" << 99));
+    ASSERT(intersectingChunk);
+    ASSERT(
+        SimpleBSONObjComparator::kInstance.evaluate(intersectingChunk->getMin() == BSON("a" << 0)));
+
+    intersectingChunk = newChunkMap.findIntersectingChunk(BSON("a" << -1));
+    ASSERT(intersectingChunk);
+    ASSERT(SimpleBSONObjComparator::kInstance.evaluate(intersectingChunk->getMax() ==
+                                                       BSON("a" << 0)));
+}
+
+TEST_F(ChunkMapTest, TestMergeKeepsUnchangedChunks) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    auto makeChunk = [](const BSONObj& min, const BSONObj& max, const ChunkVersion& chunkVersion) {
+        return std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{min, max}, chunkVersion, kThisShard});
+    };
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    chunks.push_back(makeChunk(getShardKeyPattern().globalMin(), BSON("a" << 0), version));
+    for (int i = 0; i < 10; ++i) {
+        chunks.push_back(makeChunk(BSON("a" << i * 10), BSON("a" << (i + 1) * 10), version));
+    }
+    chunks.push_back(makeChunk(BSON("a" << 100), getShardKeyPattern().globalMax(), version));
+    auto initialChunkMap = chunkMap.createMerged(chunks);
+    ASSERT_EQ(initialChunkMap.size(), 12);
+
+    // Split [30, 40) and merge [70, 80) with [80, 90).
+    version.incMajor();
+    auto newChunkMap =
+        initialChunkMap.createMerged({makeChunk(BSON("a" << 30), BSON("a" << 35), version),
+                                      makeChunk(BSON("a" << 35), BSON("a" << 40), version),
+                                      makeChunk(BSON("a" << 70), BSON("a" << 90), version)});
+    ASSERT_EQ(newChunkMap.size(), 12);
+    ASSERT_EQ(newChunkMap.getVersion(), version);
+
+    BSONObj lastMax = getShardKeyPattern().globalMin();
+    newChunkMap.forEach([&](const auto& chunk) {
+        ASSERT(SimpleBSONObjComparator::kInstance.evaluate(chunk->getMin() == lastMax));
+        lastMax = chunk->getMax();
+        return true;
+    });
+    ASSERT(SimpleBSONObjComparator::kInstance.evaluate(lastMax ==
+                                                       getShardKeyPattern().globalMax()));
+
+    for (int key : {-5, 5, 25, 33, 37, 45, 75, 85, 95, 105}) {
+        auto intersectingChunk = newChunkMap.findIntersectingChunk(BSON("a" << key));
+        ASSERT(intersectingChunk);
+        ASSERT(intersectingChunk->containsKey(BSON("a" << key)));
+    }
+}
+
 TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     const OID epoch = OID::gen();
     ChunkMap chunkMap{epoch, boost::none /* timestamp */};
@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/transaction_participant.h"
@@ -36,6 +38,15 @@
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
+namespace {
+
+// The number of threads currently blocked waiting for results from remote hosts. Each of them is a
+// service thread held by a command for as long as its slowest shard takes to respond.
+Counter64 threadsWaitingForRemoteResults;
+ServerStatusMetricField<Counter64> threadsWaitingForRemoteResultsMetric(
+    "query.threadsWaitingForRemoteResults", &threadsWaitingForRemoteResults);
+
+}  // namespace
 
 BlockingResultsMerger::BlockingResultsMerger(OperationContext* opCtx,
                                              AsyncResultsMergerParams&& armParams,
@@ -66,6 +77,9 @@ StatusWith<stdx::cv_status> BlockingResultsMerger::doWaiting(
         CurOp::get(opCtx)->startRemoteOpWaitTimer();
         ON_BLOCK_EXIT([&] { CurOp::get(opCtx)->stopRemoteOpWaitTimer(); });
 
+        threadsWaitingForRemoteResults.increment();
+        ON_BLOCK_EXIT([&] { threadsWaitingForRemoteResults.decrement(); });
+
         // This shouldn't throw, but we cannot enforce that.
         result = waitFn();
     } catch (const DBException&) {
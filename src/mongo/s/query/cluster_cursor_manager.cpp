@@ -248,7 +248,7 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     AuthCheck checkSessionAuth) {
     const auto now = _clockSource->now();
 
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::unique_lock<Latch> lk(_mutex);
     _log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
 
     if (_inShutdown) {
@@ -281,6 +281,12 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     }
 
     auto cursorGuard = entry->releaseCursor(opCtx);
+    _log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
+
+    // The cursor is now pinned to this operation, so no other thread will touch it or its entry
+    // until it is checked back in. Finish checking it out without holding the manager's mutex,
+    // which every other cursor operation on this router contends on.
+    lk.unlock();
 
     // We use pinning of a cursor as a proxy for active, user-initiated use of a cursor.  Therefore,
     // we pass down to the logical session cache and vivify the record (updating last use).
@@ -288,12 +294,22 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
         auto vivifyCursorStatus =
             LogicalSessionCache::get(opCtx)->vivify(opCtx, cursorGuard->getLsid().get());
         if (!vivifyCursorStatus.isOK()) {
+            // Unpin the cursor so that it remains usable by a later operation, unless it was
+            // killed in the meantime.
+            auto cursor = cursorGuard.releaseCursor();
+            lk.lock();
+            entry = _getEntry(lk, nss, cursorId);
+            invariant(entry);
+            const bool killPending = entry->isKillPending();
+            entry->returnCursor(std::move(cursor));
+            if (killPending) {
+                detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+            }
             return vivifyCursorStatus;
         }
     }
     cursorGuard->reattachToOperationContext(opCtx);
 
-    _log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
     return PinnedCursor(this, std::move(cursorGuard), nss, cursorId);
 }
 
@@ -410,21 +426,28 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
     const auto now = _clockSource->now();
     stdx::unique_lock<Latch> lk(_mutex);
 
-    auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
+    // Timed out cursors are logged once the mutex has been released, so that reaping many idle
+    // cursors does not hold up the operations checking cursors in and out.
+    std::vector<std::pair<CursorId, Date_t>> timedOut;
+    auto pred = [cutoff, &timedOut](CursorId cursorId, const CursorEntry& entry) -> bool {
         bool res = entry.getLifetimeType() == CursorLifetime::Mortal && !entry.getLsid() &&
             !entry.getOperationUsingCursor() && entry.getLastActive() <= cutoff;
 
         if (res) {
-            LOGV2(22837,
-                  "Cursor timed out",
-                  "cursorId"_attr = cursorId,
-                  "idleSince"_attr = entry.getLastActive().toString());
+            timedOut.emplace_back(cursorId, entry.getLastActive());
         }
 
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    auto nKilled = killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    for (auto&& [cursorId, lastActive] : timedOut) {
+        LOGV2(22837,
+              "Cursor timed out",
+              "cursorId"_attr = cursorId,
+              "idleSince"_attr = lastActive.toString());
+    }
+    return nKilled;
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
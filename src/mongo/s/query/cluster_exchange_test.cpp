@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
 #include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/sharded_agg_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -609,5 +610,80 @@ TEST_F(ClusterExchangeTest, CompoundShardKeyThreeShards) {
     future.default_timed_get();
 }
 
+std::set<ShardId> makeShardIds(size_t numShards) {
+    std::set<ShardId> shardIds;
+    for (size_t i = 0; i < numShards; ++i) {
+        shardIds.emplace(str::stream() << i);
+    }
+    return shardIds;
+}
+
+TEST_F(ClusterExchangeTest, GroupIsEligibleForHashExchangeWhenEnoughShardsAreTargeted) {
+    const auto originalMinShards = internalQueryMinShardsForGroupExchange.load();
+    internalQueryMinShardsForGroupExchange.store(3);
+    ON_BLOCK_EXIT([&] { internalQueryMinShardsForGroupExchange.store(originalMinShards); });
+
+    auto mergePipe = Pipeline::create(
+        {parseStage("{$group: {_id: '$x', count: {$sum: '$count'}, $doingMerge: true}}"),
+         parseStage("{$match: {count: {$gt: 1}}}")},
+        expCtx());
+
+    ASSERT_FALSE(
+        sharded_agg_helpers::checkIfEligibleForGroupExchange(mergePipe.get(), makeShardIds(2)));
+
+    auto exchangeSpec =
+        sharded_agg_helpers::checkIfEligibleForGroupExchange(mergePipe.get(), makeShardIds(4));
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumers(), 4);
+    ASSERT_EQ(exchangeSpec->consumerShards.size(), 4UL);
+
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    ASSERT_EQ(boundaries.size(), 5UL);
+    ASSERT_BSONOBJ_EQ(boundaries[0], BSON("_id" << MINKEY));
+    ASSERT_BSONOBJ_EQ(boundaries[4], BSON("_id" << MAXKEY));
+
+    // The hash range is split into roughly equal slices.
+    const auto firstBound = boundaries[1]["_id"].numberLong();
+    const auto secondBound = boundaries[2]["_id"].numberLong();
+    const auto thirdBound = boundaries[3]["_id"].numberLong();
+    ASSERT_LT(firstBound, secondBound);
+    ASSERT_LT(secondBound, thirdBound);
+    ASSERT_LTE(std::abs(secondBound), 2);
+    ASSERT_LTE(std::abs((firstBound - std::numeric_limits<long long>::min()) -
+                        (thirdBound - secondBound)),
+               2);
+}
+
+TEST_F(ClusterExchangeTest, GroupFollowedByBlockingStageIsNotEligibleForHashExchange) {
+    const auto originalMinShards = internalQueryMinShardsForGroupExchange.load();
+    internalQueryMinShardsForGroupExchange.store(2);
+    ON_BLOCK_EXIT([&] { internalQueryMinShardsForGroupExchange.store(originalMinShards); });
+
+    auto mergePipe = Pipeline::create({parseStage("{$group: {_id: '$x', $doingMerge: true}}"),
+                                       parseStage("{$sort: {_id: 1}}")},
+                                      expCtx());
+    ASSERT_FALSE(
+        sharded_agg_helpers::checkIfEligibleForGroupExchange(mergePipe.get(), makeShardIds(4)));
+
+    mergePipe = Pipeline::create({parseStage("{$match: {x: 1}}")}, expCtx());
+    ASSERT_FALSE(
+        sharded_agg_helpers::checkIfEligibleForGroupExchange(mergePipe.get(), makeShardIds(4)));
+}
+
+TEST_F(ClusterExchangeTest, GroupIsNotEligibleForHashExchangeWhenDisabled) {
+    const auto originalMinShards = internalQueryMinShardsForGroupExchange.load();
+    internalQueryMinShardsForGroupExchange.store(0);
+    ON_BLOCK_EXIT([&] { internalQueryMinShardsForGroupExchange.store(originalMinShards); });
+
+    auto mergePipe =
+        Pipeline::create({parseStage("{$group: {_id: '$x', $doingMerge: true}}")}, expCtx());
+    ASSERT_FALSE(
+        sharded_agg_helpers::checkIfEligibleForGroupExchange(mergePipe.get(), makeShardIds(100)));
+}
+
 }  // namespace
 }  // namespace mongo
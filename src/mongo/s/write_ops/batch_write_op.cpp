@@ -301,6 +301,21 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // The documents of an unordered insert are all targeted up front, which lets the targeter
+    // resolve their shard keys together rather than one document at a time. Ordered batches stop
+    // at the first change of shard, so most of their documents would be targeted for nothing.
+    std::vector<StatusWith<ShardEndpoint>> insertEndpoints;
+    auto nextInsertEndpoint = insertEndpoints.begin();
+    if (!ordered && _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert) {
+        std::vector<BSONObj> docs;
+        for (size_t i = 0; i < numWriteOps; ++i) {
+            if (_writeOps[i].getWriteState() == WriteOpState_Ready)
+                docs.push_back(_writeOps[i].getWriteItem().getDocument());
+        }
+        insertEndpoints = targeter.targetInserts(_opCtx, docs);
+        nextInsertEndpoint = insertEndpoints.begin();
+    }
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -318,7 +333,13 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (nextInsertEndpoint != insertEndpoints.end()) {
+                auto& swEndpoint = *nextInsertEndpoint++;
+                uassertStatusOK(swEndpoint.getStatus());
+                writeOp.targetWrites(_opCtx, targeter, {std::move(swEndpoint.getValue())}, &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
@@ -390,17 +411,23 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         const int errorResponsePotentialSizeBytes =
             ordered ? 0 : write_ops::kWriteCommandBSONArrayPerElementOverheadBytes + 256;
 
+        // When a write does not fit into this round, an unordered batch leaves it for the next
+        // round but keeps filling the batches of the other shards. Otherwise, one shard whose
+        // batch is full would hold back the writes to every other shard until the next round, and
+        // so until that shard has also responded.
         if (wouldMakeBatchesTooBig(
                 writes, std::max(writeSizeBytes, errorResponsePotentialSizeBytes), batchMap)) {
             invariant(!batchMap.empty());
             writeOp.cancelWrites(nullptr);
-            break;
+            if (ordered)
+                break;
+            continue;
         }
 
         if (!ordered && !batchMap.empty() &&
             isNewBatchRequiredUnordered(writes, batchMap, targetedShards)) {
             writeOp.cancelWrites(nullptr);
-            break;
+            continue;
         }
 
         //
@@ -355,14 +355,7 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
     BSONObj shardKey;
 
     if (_cm->isSharded()) {
-        shardKey = _cm->getShardKeyPattern().extractShardKeyFromDoc(doc);
-        // The shard key would only be empty after extraction if we encountered an error case, such
-        // as the shard key possessing an array value or array descendants. If the shard key
-        // presented to the targeter was empty, we would emplace the missing fields, and the
-        // extracted key here would *not* be empty.
-        uassert(ErrorCodes::ShardKeyNotFound,
-                "Shard key cannot contain array values or array descendants.",
-                !shardKey.isEmpty());
+        shardKey = _extractShardKeyForInsert(doc);
     }
 
     // Target the shard key or database primary
@@ -379,6 +372,64 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
         _nss.isOnInternalDb() ? boost::optional<DatabaseVersion>() : _cm->dbVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_cm->isSharded()) {
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    std::vector<StatusWith<ShardEndpoint>> endpoints(
+        docs.size(), Status(ErrorCodes::InternalError, "Document was not targeted"));
+
+    // Extract all the shard keys first and sort the documents by them, so that each chunk only
+    // needs to be looked up once for all the documents which fall into it.
+    struct InsertShardKey {
+        std::string keyString;
+        BSONObj shardKey;
+        size_t docIndex;
+    };
+    std::vector<InsertShardKey> shardKeys;
+    shardKeys.reserve(docs.size());
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+        try {
+            auto shardKey = _extractShardKeyForInsert(docs[i]);
+            auto keyString = ShardKeyPattern::toKeyString(shardKey);
+            shardKeys.push_back({std::move(keyString), std::move(shardKey), i});
+        } catch (const DBException& ex) {
+            endpoints[i] = ex.toStatus();
+        }
+    }
+
+    std::sort(shardKeys.begin(), shardKeys.end(), [](const auto& a, const auto& b) {
+        return a.keyString < b.keyString;
+    });
+
+    // Since the keys are visited in ascending order, a key belongs to the same chunk as the one
+    // before it for as long as it is below that chunk's max bound.
+    boost::optional<ShardEndpoint> chunkEndpoint;
+    std::string chunkMaxKeyString;
+
+    for (const auto& shardKey : shardKeys) {
+        if (!chunkEndpoint || shardKey.keyString >= chunkMaxKeyString) {
+            chunkEndpoint.reset();
+            try {
+                auto chunk = _cm->findIntersectingChunkWithSimpleCollation(shardKey.shardKey);
+                chunkEndpoint.emplace(
+                    chunk.getShardId(), _cm->getVersion(chunk.getShardId()), boost::none);
+                chunkMaxKeyString = ShardKeyPattern::toKeyString(chunk.getMax());
+            } catch (const DBException& ex) {
+                endpoints[shardKey.docIndex] = ex.toStatus();
+                continue;
+            }
+        }
+
+        endpoints[shardKey.docIndex] = *chunkEndpoint;
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
@@ -559,6 +610,18 @@ StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::_targetQuery(
     return endpoints;
 }
 
+BSONObj ChunkManagerTargeter::_extractShardKeyForInsert(const BSONObj& doc) const {
+    auto shardKey = _cm->getShardKeyPattern().extractShardKeyFromDoc(doc);
+    // The shard key would only be empty after extraction if we encountered an error case, such as
+    // the shard key possessing an array value or array descendants. If the shard key presented to
+    // the targeter was empty, we would emplace the missing fields, and the extracted key here would
+    // *not* be empty.
+    uassert(ErrorCodes::ShardKeyNotFound,
+            "Shard key cannot contain array values or array descendants.",
+            !shardKey.isEmpty());
+    return shardKey;
+}
+
 StatusWith<ShardEndpoint> ChunkManagerTargeter::_targetShardKey(const BSONObj& shardKey,
                                                                 const BSONObj& collation,
                                                                 long long estDataSize) const {
@@ -76,6 +76,9 @@ public:
 
     ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const override;
 
+    std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
     std::vector<ShardEndpoint> targetUpdate(OperationContext* opCtx,
                                             const BatchItemRef& itemRef) const override;
 
@@ -132,6 +135,12 @@ private:
         const BSONObj& query,
         const BSONObj& collation) const;
 
+    /**
+     * Returns the shard key of the document 'doc' to be inserted, or throws ShardKeyNotFound if it
+     * cannot be extracted.
+     */
+    BSONObj _extractShardKeyForInsert(const BSONObj& doc) const;
+
     /**
      * Returns a ShardEndpoint for an exact shard key query.
      *
@@ -117,6 +117,33 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertWithRangePrefixHashedShardKey) {
                        ErrorCodes::ShardKeyNotFound);
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsMatchesTargetInsert) {
+    std::vector<BSONObj> splitPoints = {
+        BSON("a" << BSONNULL), BSON("a" << -100), BSON("a" << 0), BSON("a" << 100)};
+    auto cmTargeter = prepare(BSON("a" << 1), splitPoints);
+
+    std::vector<BSONObj> docs = {fromjson("{a: 1000}"),
+                                 fromjson("{a: -111}"),
+                                 fromjson("{a: [1, 2]}"),
+                                 fromjson("{a: 5}"),
+                                 BSONObj(),
+                                 fromjson("{a: -10}"),
+                                 fromjson("{a: 100}"),
+                                 fromjson("{a: 99}")};
+    auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(endpoints.size(), docs.size());
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+        try {
+            auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+            ASSERT_EQUALS(assertGet(endpoints[i]).shardName, expected.shardName);
+        } catch (const DBException& ex) {
+            ASSERT_EQUALS(endpoints[i].getStatus().code(), ex.code());
+        }
+    }
+    ASSERT_EQUALS(endpoints[2].getStatus().code(), ErrorCodes::ShardKeyNotFound);
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetInsertsWithVaryingHashedPrefixAndConstantRangedSuffix) {
     // Create 4 chunks and 4 shards such that shardId '0' has chunk [MinKey, -2^62), '1' has chunk
     // [-2^62, 0), '2' has chunk ['0', 2^62) and '3' has chunk [2^62, MaxKey).
@@ -66,6 +66,13 @@ void WriteOp::targetWrites(OperationContext* opCtx,
         MONGO_UNREACHABLE;
     }();
 
+    targetWrites(opCtx, targeter, std::move(endpoints), targetedWrites);
+}
+
+void WriteOp::targetWrites(OperationContext* opCtx,
+                           const NSTargeter& targeter,
+                           std::vector<ShardEndpoint> endpoints,
+                           std::vector<TargetedWrite*>* targetedWrites) {
     // Unless executing as part of a transaction, if we're targeting more than one endpoint with an
     // update/delete, we have to target everywhere since we cannot currently retry partial results.
     //
@@ -123,6 +123,14 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as above, but for a write item which has already been targeted to 'endpoints'.
+     */
+    void targetWrites(OperationContext* opCtx,
+                      const NSTargeter& targeter,
+                      std::vector<ShardEndpoint> endpoints,
+                      std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -46,6 +46,7 @@
 #include "mongo/util/ctype.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/file.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/text.h"
 
 namespace mongo {
@@ -381,7 +382,12 @@ public:
                 return;  // not saving errored scopes
             }
 
-            if (_pools.size() >= kMaxPoolSize) {
+            // Keep at least one idle scope per core, so that concurrent JavaScript operations on
+            // a large machine do not evict each other's scopes and pay for building a new one on
+            // every operation.
+            static const unsigned maxPoolSize =
+                std::max<unsigned>(kMinPoolSize, ProcessInfo::getNumAvailableCores());
+            if (_pools.size() >= maxPoolSize) {
                 hitPoolSizeLimit = true;
                 // prefer to keep recently-used scopes
                 _pools.pop_back();
@@ -446,7 +452,7 @@ private:
     };
 
     // Note: if these numbers change, reconsider choice of datastructure for _pools
-    static const unsigned kMaxPoolSize = 10;
+    static const unsigned kMinPoolSize = 10;
     constexpr static inline Seconds kMaxScopeReuseTime = Seconds(10);
 
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
@@ -39,11 +39,13 @@
 #include "mongo/rpc/message.h"
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/message_compressor_noop.h"
+#include "mongo/transport/message_compressor_parameters_gen.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
 #include "mongo/transport/message_compressor_zstd.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -240,6 +242,17 @@ TEST(ZstdMessageCompressor, Fidelity) {
     checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, FidelityAtEachCompressionLevel) {
+    const auto originalLevel = gNetworkMessageZstdCompressionLevel.load();
+    ON_BLOCK_EXIT([&] { gNetworkMessageZstdCompressionLevel.store(originalLevel); });
+
+    auto testMessage = buildMessage();
+    for (int level : {1, 3, 9, 19, 22}) {
+        gNetworkMessageZstdCompressionLevel.store(level);
+        checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
+    }
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<SnappyMessageCompressor>());
 }
@@ -252,6 +265,29 @@ TEST(ZstdMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, ReusesContextsAcrossMessages) {
+    // The compressor keeps its zstd contexts between calls, so check that neither a failed call nor
+    // a previous message leaks into the next one.
+    ZstdMessageCompressor compressor;
+    checkOverflow(std::make_unique<ZstdMessageCompressor>());
+
+    for (int i = 0; i < 10; ++i) {
+        const std::string data = std::string(i * 50, 'a') + std::to_string(i);
+        ConstDataRange input(data.data(), data.size());
+
+        std::vector<char> compressed(compressor.getMaxCompressedSize(data.size()));
+        auto compressedSize = assertOk(
+            compressor.compressData(input, DataRange(compressed.data(), compressed.size())));
+
+        std::vector<char> decompressed(data.size());
+        auto decompressedSize = assertOk(
+            compressor.decompressData(ConstDataRange(compressed.data(), compressedSize),
+                                      DataRange(decompressed.data(), decompressed.size())));
+        ASSERT_EQ(decompressedSize, data.size());
+        ASSERT_EQ(std::string(decompressed.begin(), decompressed.end()), data);
+    }
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -96,8 +96,11 @@ public:
             _recursionDepth--;
             _executor->_stats.tasksEnded.fetchAndAdd(1);
 
-            auto lk = stdx::lock_guard(_executor->_mutex);
-            _executor->_checkForShutdown(lk);
+            // Only the last tasks to finish during shutdown need to take the lock.
+            if (MONGO_unlikely(_executor->_state.load() != State::kRunning)) {
+                auto lk = stdx::lock_guard(_executor->_mutex);
+                _executor->_checkForShutdown(lk);
+            }
         });
 
         std::forward<Task>(task)();
@@ -154,7 +157,7 @@ void ServiceExecutorFixed::join() noexcept {
         auto lk = stdx::unique_lock(_mutex);
         _beginShutdown(lk);
 
-        _shutdownCondition.wait(lk, [this]() { return _state == State::kStopped; });
+        _shutdownCondition.wait(lk, [this]() { return _state.load() == State::kStopped; });
         if (std::exchange(_isJoined, true)) {
             return;
         }
@@ -174,10 +177,10 @@ void ServiceExecutorFixed::join() noexcept {
 Status ServiceExecutorFixed::start() {
     {
         stdx::lock_guard<Latch> lk(_mutex);
-        switch (_state) {
+        switch (_state.load()) {
             case State::kNotStarted: {
                 // Time to start
-                _state = State::kRunning;
+                _state.store(State::kRunning);
             } break;
             case State::kRunning: {
                 return Status::OK();
@@ -219,7 +222,7 @@ Status ServiceExecutorFixed::start() {
             // race that immediately follows this check. ASIOReactor::stop() is not permanent, thus
             // our run() could "restart" the reactor.
             stdx::lock_guard<Latch> lk(_mutex);
-            if (_state != kRunning) {
+            if (_state.load() != kRunning) {
                 return;
             }
         }
@@ -249,8 +252,9 @@ Status ServiceExecutorFixed::shutdown(Milliseconds timeout) {
 
         // There is a world where we are able to simply do a timed wait upon a future chain.
         // However, that world likely requires an OperationContext available through shutdown.
-        if (!_shutdownCondition.wait_for(
-                lk, timeout.toSystemDuration(), [this] { return _state == State::kStopped; })) {
+        if (!_shutdownCondition.wait_for(lk, timeout.toSystemDuration(), [this] {
+                return _state.load() == State::kStopped;
+            })) {
             return Status(ErrorCodes::ExceededTimeLimit,
                           "Failed to shutdown all executor threads within the time limit");
         }
@@ -265,14 +269,14 @@ Status ServiceExecutorFixed::shutdown(Milliseconds timeout) {
 }
 
 void ServiceExecutorFixed::_beginShutdown(WithLock lk) {
-    switch (_state) {
+    switch (_state.load()) {
         case State::kNotStarted: {
             invariant(_waiters.empty());
             invariant(_tasksLeft() == 0);
-            _state = State::kStopped;
+            _state.store(State::kStopped);
         } break;
         case State::kRunning: {
-            _state = State::kStopping;
+            _state.store(State::kStopping);
 
             for (auto& waiter : _waiters) {
                 // Cancel any session we own.
@@ -293,8 +297,8 @@ void ServiceExecutorFixed::_beginShutdown(WithLock lk) {
 }
 
 void ServiceExecutorFixed::_checkForShutdown(WithLock) {
-    if (_state == State::kRunning) {
-        // We're actively running.
+    if (_state.load() != State::kStopping) {
+        // We're either actively running or already stopped.
         return;
     }
 
@@ -318,7 +322,7 @@ void ServiceExecutorFixed::_checkForShutdown(WithLock) {
     //
     // From this point on, all of our threads will be idle. When the dtor runs, the thread pool will
     // experience a trivial shutdown() and join().
-    _state = State::kStopped;
+    _state.store(State::kStopped);
 
     LOGV2_DEBUG(
         4910505, kDiagnosticLogLevel, "Finishing shutdown", "name"_attr = _options.poolName);
@@ -342,14 +346,27 @@ void ServiceExecutorFixed::_checkForShutdown(WithLock) {
     reactor->stop();
 }
 
-Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) try {
-    {
-        auto lk = stdx::unique_lock(_mutex);
-        if (_state != State::kRunning) {
-            return kInShutdown;
-        }
+bool ServiceExecutorFixed::_tryAcceptTask() {
+    if (_state.load() != State::kRunning) {
+        return false;
+    }
+
+    // Count the task before checking the state again: either the check observes the transition
+    // out of kRunning, or _checkForShutdown() observes this task and waits for it to finish.
+    _stats.tasksScheduled.fetchAndAdd(1);
+    if (MONGO_likely(_state.load() == State::kRunning)) {
+        return true;
+    }
+
+    _stats.tasksScheduled.fetchAndSubtract(1);
+    auto lk = stdx::lock_guard(_mutex);
+    _checkForShutdown(lk);
+    return false;
+}
 
-        _stats.tasksScheduled.fetchAndAdd(1);
+Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) try {
+    if (!_tryAcceptTask()) {
+        return kInShutdown;
     }
 
     auto mayExecuteTaskInline = [&] {
@@ -385,16 +402,9 @@ Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) try {
 }
 
 void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task) noexcept {
-    {
-        auto lk = stdx::unique_lock(_mutex);
-        if (_state != State::kRunning) {
-            lk.unlock();
-
-            task(kInShutdown);
-            return;
-        }
-
-        _stats.tasksScheduled.fetchAndAdd(1);
+    if (!_tryAcceptTask()) {
+        task(kInShutdown);
+        return;
     }
 
     _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
@@ -418,7 +428,7 @@ void ServiceExecutorFixed::runOnDataAvailable(const SessionHandle& session,
     {
         // Make sure we're still allowed to schedule and track the session
         auto lk = stdx::unique_lock(_mutex);
-        if (_state != State::kRunning) {
+        if (_state.load() != State::kRunning) {
             lk.unlock();
             waiter.onCompletionCallback(kInShutdown);
             return;
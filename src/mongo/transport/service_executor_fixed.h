@@ -102,6 +102,12 @@ private:
     void _beginShutdown(WithLock);
     void _schedule(OutOfLineExecutor::Task task) noexcept;
 
+    /**
+     * Accounts for a new task if the executor is running, without taking `_mutex` unless it is
+     * shutting down. Returns false if the task must be rejected.
+     */
+    bool _tryAcceptTask();
+
     auto _threadsRunning() const {
         auto ended = _stats.threadsEnded.load();
         auto started = _stats.threadsStarted.loadRelaxed();
@@ -115,8 +121,10 @@ private:
     }
 
     auto _tasksLeft() const {
+        // Tasks are counted as scheduled before `_state` is checked without holding `_mutex`, so
+        // this must not be reordered before the `_state` transition that precedes it.
         auto ended = _stats.tasksEnded.load();
-        auto scheduled = _stats.tasksScheduled.loadRelaxed();
+        auto scheduled = _stats.tasksScheduled.load();
         return scheduled - ended;
     }
 
@@ -152,8 +160,12 @@ private:
 
     /**
      * State transition diagram: kNotStarted ---> kRunning ---> kStopping ---> kStopped
+     *
+     * Transitions happen while holding `_mutex`, but scheduling and finishing tasks read the state
+     * without it so that the hot path only synchronizes on the thread pool's queue.
      */
-    enum State { kNotStarted, kRunning, kStopping, kStopped } _state = kNotStarted;
+    enum State { kNotStarted, kRunning, kStopping, kStopped };
+    AtomicWord<State> _state{kNotStarted};
     bool _isJoined = false;
 
     ThreadPool::Options _options;
@@ -357,6 +357,38 @@ TEST_F(ServiceExecutorFixedFixture, ScheduleFailsAfterShutdown) {
         executorHandle->scheduleTask([] { MONGO_UNREACHABLE; }, ServiceExecutor::kEmptyFlags));
 }
 
+TEST_F(ServiceExecutorFixedFixture, ScheduleRacesWithShutdown) {
+    auto executorHandle = ServiceExecutorHandle();
+    executorHandle.start();
+
+    constexpr auto kNumSchedulingThreads = 4;
+    AtomicWord<int> tasksAccepted{0};
+    AtomicWord<int> tasksRun{0};
+    auto barrier = std::make_shared<unittest::Barrier>(kNumSchedulingThreads + 1);
+
+    // Every task the executor accepts must run before shutdown completes, no matter how the
+    // scheduling threads interleave with it.
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumSchedulingThreads; ++i) {
+        threads.emplace_back([&, barrier, executor = *executorHandle] {
+            barrier->countDownAndWait();
+            while (executor->scheduleTask([&] { tasksRun.fetchAndAdd(1); },
+                                          ServiceExecutor::kEmptyFlags)
+                       .isOK()) {
+                tasksAccepted.fetchAndAdd(1);
+            }
+        });
+    }
+
+    barrier->countDownAndWait();
+    executorHandle.join();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(tasksRun.load(), tasksAccepted.load());
+}
+
 TEST_F(ServiceExecutorFixedFixture, RunTaskAfterWaitingForData) {
     auto tl = std::make_unique<TransportLayerMock>();
     auto session = tl->createSession();
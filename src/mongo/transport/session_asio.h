@@ -38,6 +38,7 @@
 #include "mongo/transport/baton.h"
 #include "mongo/transport/ssl_connection_context.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -56,6 +57,10 @@ namespace transport {
 
 MONGO_FAIL_POINT_DEFINE(transportLayerASIOshortOpportunisticReadWrite);
 
+// Total capacity of the receive buffers that sessions are holding on to for reuse, bounded by
+// transportLayerASIOReceiveBufferCacheBytes.
+AtomicWord<long long> cachedReceiveBufferBytes{0};
+
 template <typename SuccessValue>
 auto futurize(const std::error_code& ec, SuccessValue&& successValue) {
     using Result = Future<std::decay_t<SuccessValue>>;
@@ -135,6 +140,7 @@ public:
 
     ~ASIOSession() {
         end();
+        releaseCachedReceiveBuffer();
     }
 
     TransportLayer* getTransportLayer() const override {
@@ -172,6 +178,9 @@ public:
 
     StatusWith<Message> sourceMessage() override {
         ensureSync();
+        if (canReadAhead()) {
+            return sourceMessageWithReadAhead();
+        }
         return sourceMessageImpl().getNoThrow();
     }
 
@@ -182,6 +191,9 @@ public:
 
     Status waitForData() override {
         ensureSync();
+        if (hasReadAheadBytes()) {
+            return Status::OK();
+        }
         asio::error_code ec;
         getSocket().wait(asio::ip::tcp::socket::wait_read, ec);
         return errorCodeToStatus(ec);
@@ -189,6 +201,9 @@ public:
 
     Future<void> asyncWaitForData() override {
         ensureAsync();
+        if (hasReadAheadBytes()) {
+            return Future<void>::makeReady();
+        }
         return getSocket().async_wait(asio::ip::tcp::socket::wait_read, UseFuture{});
     }
 
@@ -298,6 +313,7 @@ protected:
         }
 
         _sslSocket.emplace(std::move(_socket), *_sslContext->egress, removeFQDNRoot(target.host()));
+        getSSLManager()->prepareEgressSessionResumption(_sslSocket->native_handle(), target);
         lk.unlock();
 
         auto doHandshake = [&] {
@@ -420,31 +436,190 @@ private:
         return _socket;
     }
 
-    Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
-        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+    Status validateMessageLength(size_t msgLen) {
+        if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+            StringBuilder sb;
+            sb << "recv(): message msgLen " << msgLen << " is invalid. "
+               << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+            const auto str = sb.str();
+            LOGV2(4615638,
+                  "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
+                  "recv(): message mstLen is invalid.",
+                  "msgLen"_attr = msgLen,
+                  "min"_attr = kHeaderSize,
+                  "max"_attr = MaxMessageSizeBytes);
+
+            return Status(ErrorCodes::ProtocolError, str);
+        }
+        return Status::OK();
+    }
+
+    bool hasReadAheadBytes() const {
+        return _readAheadBegin != _readAheadEnd;
+    }
 
+    // Reading ahead relies on read_some() returning whatever the socket has available, so it is
+    // only done for blocking reads on plain ingress sockets that have already been checked for a
+    // TLS handshake.
+    bool canReadAhead() const {
+#ifdef MONGO_CONFIG_SSL
+        if (_sslSocket || !_ranHandshake) {
+            return false;
+        }
+#endif
+        return _isIngressSession && _blockingMode == Sync && gTransportLayerASIOReadAheadBytes > 0;
+    }
+
+    /**
+     * Receives a message with as few syscalls as possible: a single read_some() into the
+     * read-ahead buffer usually returns the header together with the whole body of a small
+     * message, where sourceMessageImpl() always issues one read for each. Any bytes received past
+     * the end of the message are kept for the next call.
+     */
+    StatusWith<Message> sourceMessageWithReadAhead() {
+        const size_t capacity = std::max(size_t(gTransportLayerASIOReadAheadBytes), kHeaderSize);
+        if (!_readAheadBuffer) {
+            _readAheadBuffer = SharedBuffer::allocate(capacity);
+        }
+
+        while (_readAheadEnd - _readAheadBegin < kHeaderSize) {
+            if (capacity - _readAheadBegin < kHeaderSize) {
+                // Not enough room left for a header, move the partial one to the front.
+                _readAheadEnd -= _readAheadBegin;
+                memmove(_readAheadBuffer.get(),
+                        _readAheadBuffer.get() + _readAheadBegin,
+                        _readAheadEnd);
+                _readAheadBegin = 0;
+            }
+
+            std::error_code ec;
+            size_t size;
+            do {
+                size = _socket.read_some(
+                    asio::buffer(_readAheadBuffer.get() + _readAheadEnd, capacity - _readAheadEnd),
+                    ec);
+            } while (ec == asio::error::interrupted);  // retry syscall EINTR
+
+            if (ec) {
+                return errorCodeToStatus(ec);
+            }
+            _readAheadEnd += size;
+        }
+
+        const char* header = _readAheadBuffer.get() + _readAheadBegin;
+        if (checkForHTTPRequest(asio::buffer(header, kHeaderSize))) {
+            return sendHTTPResponse().getNoThrow();
+        }
+
+        const auto msgLen = size_t(MSGHEADER::ConstView(header).getMessageLength());
+        if (auto status = validateMessageLength(msgLen); !status.isOK()) {
+            return status;
+        }
+
+        SharedBuffer buffer;
+        size_t received;
+        if (_readAheadBegin == 0 && _readAheadEnd <= msgLen && msgLen <= capacity) {
+            // Everything buffered belongs to this message, so hand the buffer over as-is.
+            received = _readAheadEnd;
+            buffer = std::move(_readAheadBuffer);
+            buffer.realloc(msgLen);
+            _readAheadEnd = 0;
+        } else {
+            received = std::min(msgLen, _readAheadEnd - _readAheadBegin);
+            buffer = allocateReceiveBuffer(msgLen);
+            memcpy(buffer.get(), header, received);
+            consumeReadAheadBytes(received);
+        }
+
+        if (received < msgLen) {
+            auto status =
+                read(asio::buffer(buffer.get() + received, msgLen - received)).getNoThrow();
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+
+        networkCounter.hitPhysicalIn(msgLen);
+        return Message(std::move(buffer));
+    }
+
+    static constexpr size_t kMinCachedReceiveBufferBytes = 1024 * 1024;
+
+    /**
+     * Returns a buffer for a message of 'msgLen' bytes. Large messages reuse the buffer of an
+     * earlier one once nothing else references it anymore (e.g. BSON from the previous request
+     * that was kept alive by a cursor), which spares clients that repeatedly send large batches a
+     * fresh allocation, and the page faults that come with it, on every message.
+     */
+    SharedBuffer allocateReceiveBuffer(size_t msgLen) {
+        if (msgLen < kMinCachedReceiveBufferBytes) {
+            return SharedBuffer::allocate(msgLen);
+        }
+
+        if (_cachedReceiveBuffer) {
+            if (!_cachedReceiveBuffer.isShared() && _cachedReceiveBuffer.capacity() >= msgLen) {
+                return _cachedReceiveBuffer;
+            }
+            releaseCachedReceiveBuffer();
+        }
+
+        auto buffer = SharedBuffer::allocate(msgLen);
+        const auto capacity = static_cast<long long>(msgLen);
+        if (cachedReceiveBufferBytes.addAndFetch(capacity) <=
+            gTransportLayerASIOReceiveBufferCacheBytes) {
+            _cachedReceiveBuffer = buffer;
+        } else {
+            cachedReceiveBufferBytes.subtractAndFetch(capacity);
+        }
+        return buffer;
+    }
+
+    void releaseCachedReceiveBuffer() {
+        if (_cachedReceiveBuffer) {
+            cachedReceiveBufferBytes.subtractAndFetch(
+                static_cast<long long>(_cachedReceiveBuffer.capacity()));
+            _cachedReceiveBuffer = {};
+        }
+    }
+
+    void consumeReadAheadBytes(size_t bytes) {
+        _readAheadBegin += bytes;
+        if (_readAheadBegin == _readAheadEnd) {
+            // Don't hold on to the buffer between messages once it has been drained.
+            _readAheadBuffer = {};
+            _readAheadBegin = _readAheadEnd = 0;
+        }
+    }
+
+    // Fills the buffer from any bytes left over from a previous read-ahead before reading the
+    // remainder from the socket.
+    Future<void> readBuffered(asio::mutable_buffer buffer, const BatonHandle& baton) {
+        if (hasReadAheadBytes()) {
+            const auto bytes = std::min(buffer.size(), _readAheadEnd - _readAheadBegin);
+            memcpy(buffer.data(), _readAheadBuffer.get() + _readAheadBegin, bytes);
+            consumeReadAheadBytes(bytes);
+            buffer += bytes;
+            if (buffer.size() == 0) {
+                return Future<void>::makeReady();
+            }
+        }
+        return read(buffer, baton);
+    }
+
+    Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
         auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
         auto ptr = headerBuffer.get();
-        return read(asio::buffer(ptr, kHeaderSize), baton)
+        return readBuffered(asio::buffer(ptr, kHeaderSize), baton)
             .then([headerBuffer = std::move(headerBuffer), this, baton]() mutable {
                 if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
                     return sendHTTPResponse(baton);
                 }
 
                 const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-                if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                    StringBuilder sb;
-                    sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                       << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                    const auto str = sb.str();
-                    LOGV2(4615638,
-                          "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
-                          "recv(): message mstLen is invalid.",
-                          "msgLen"_attr = msgLen,
-                          "min"_attr = kHeaderSize,
-                          "max"_attr = MaxMessageSizeBytes);
-
-                    return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+                if (auto status = validateMessageLength(msgLen); !status.isOK()) {
+                    return Future<Message>::makeReady(std::move(status));
                 }
 
                 if (msgLen == kHeaderSize) {
@@ -455,11 +630,11 @@ private:
                     return Future<Message>::makeReady(Message(std::move(headerBuffer)));
                 }
 
-                auto buffer = SharedBuffer::allocate(msgLen);
+                auto buffer = allocateReceiveBuffer(msgLen);
                 memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
 
                 MsgData::View msgView(buffer.get());
-                return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
+                return readBuffered(asio::buffer(msgView.data(), msgView.dataLen()), baton)
                     .then([this, buffer = std::move(buffer), msgLen]() mutable {
                         if (_isIngressSession) {
                             networkCounter.hitPhysicalIn(msgLen);
@@ -837,6 +1012,15 @@ private:
 
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
+
+    // Bytes received by sourceMessageWithReadAhead() past the end of the message it returned, in
+    // [_readAheadBegin, _readAheadEnd).
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
+
+    // The last large receive buffer, kept for reuse by allocateReceiveBuffer().
+    SharedBuffer _cachedReceiveBuffer;
 };
 
 }  // namespace transport
@@ -272,19 +272,43 @@ public:
         }
     }
 
-    void sendMessage() {
+    static Message makePing() {
+        return makeMessage(BSON("ping" << 1));
+    }
+
+    static Message makeMessage(const BSONObj& body) {
         OpMsgBuilder builder;
-        builder.setBody(BSON("ping" << 1));
+        builder.setBody(body);
         Message msg = builder.finish();
         msg.header().setResponseToMsgId(0);
         msg.header().setId(0);
         OpMsg::appendChecksum(&msg);
+        return msg;
+    }
+
+    void sendMessage() {
+        sendMessages(1);
+    }
 
+    void sendMessage(const Message& msg) {
         std::error_code ec;
         asio::write(_sock, asio::buffer(msg.buf(), msg.size()), ec);
         ASSERT_FALSE(ec);
     }
 
+    // Sends the messages with a single write so that the server can receive them all at once.
+    void sendMessages(size_t count) {
+        auto msg = makePing();
+        std::string bytes;
+        for (size_t i = 0; i < count; ++i) {
+            bytes.append(msg.buf(), msg.size());
+        }
+
+        std::error_code ec;
+        asio::write(_sock, asio::buffer(bytes.data(), bytes.size()), ec);
+        ASSERT_FALSE(ec);
+    }
+
 private:
     asio::io_context _ctx;
     asio::ip::tcp::socket _sock;
@@ -382,5 +406,90 @@ TEST(TransportLayerASIO, SwitchTimeoutModes) {
     tla->shutdown();
 }
 
+/* check that messages received together are split correctly, whichever mode sources them */
+class PipelinedMessagesSEP : public TimeoutSEP {
+public:
+    void startSession(transport::SessionHandle session) override {
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            const auto expectedSize = TimeoutConnector::makePing().size();
+            auto checkMessage = [&](StatusWith<Message> swMsg) {
+                ASSERT_OK(swMsg.getStatus());
+                ASSERT_EQ(swMsg.getValue().size(), expectedSize);
+                ASSERT_BSONOBJ_EQ(OpMsg::parse(swMsg.getValue()).body, BSON("ping" << 1));
+            };
+
+            checkMessage(session->sourceMessage());
+            notifyComplete();
+
+            checkMessage(session->sourceMessage());
+            checkMessage(session->sourceMessage());
+            checkMessage(session->asyncSourceMessage().getNoThrow());
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+};
+
+/* check that the buffer of a large message is reused once nothing references it anymore */
+class LargeMessagesSEP : public TimeoutSEP {
+public:
+    static BSONObj makeBody(char c) {
+        return BSON("insert" << std::string(2 * 1024 * 1024, c));
+    }
+
+    void startSession(transport::SessionHandle session) override {
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            auto sourceBody = [&](char c) {
+                auto swMsg = session->sourceMessage();
+                ASSERT_OK(swMsg.getStatus());
+                auto msg = OpMsg::parseOwned(swMsg.getValue());
+                ASSERT_BSONOBJ_EQ(msg.body, makeBody(c));
+                return msg.body;
+            };
+
+            auto first = sourceBody('a');
+            const auto firstData = first.objdata();
+            first = BSONObj();
+            ASSERT_EQ(sourceBody('b').objdata(), firstData);
+
+            // A buffer that is still referenced must not be reused.
+            auto third = sourceBody('c');
+            auto fourth = sourceBody('d');
+            ASSERT_NE(fourth.objdata(), third.objdata());
+            ASSERT_BSONOBJ_EQ(third, makeBody('c'));
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+};
+
+TEST(TransportLayerASIO, ReuseLargeReceiveBuffers) {
+    LargeMessagesSEP sep;
+    auto tla = makeAndStartTL(&sep);
+
+    TimeoutConnector connector(tla->listenerPort(), false);
+    for (char c : {'a', 'b', 'c', 'd'}) {
+        connector.sendMessage(TimeoutConnector::makeMessage(LargeMessagesSEP::makeBody(c)));
+    }
+    ASSERT_TRUE(sep.waitForTimeout());
+
+    tla->shutdown();
+}
+
+TEST(TransportLayerASIO, SourcePipelinedMessages) {
+    PipelinedMessagesSEP sep;
+    auto tla = makeAndStartTL(&sep);
+
+    TimeoutConnector connector(tla->listenerPort(), true);
+    ASSERT_TRUE(sep.waitForTimeout());
+
+    connector.sendMessages(3);
+    ASSERT_TRUE(sep.waitForTimeout());
+
+    tla->shutdown();
+}
+
 }  // namespace
 }  // namespace mongo
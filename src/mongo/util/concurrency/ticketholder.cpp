@@ -36,6 +36,7 @@
 #include <iostream>
 
 #include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -99,14 +100,40 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
         return true;
     }
 
+    return _waitForTicketUntil(opCtx, until);
+}
+
+bool TicketHolder::_waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+    _queued.fetchAndAdd(1);
+    const auto queuedStart = curTimeMicros64();
+    ON_BLOCK_EXIT([&] {
+        _queued.subtractAndFetch(1);
+        _totalQueued.addAndFetch(1);
+        _totalTimeQueuedMicros.addAndFetch(curTimeMicros64() - queuedStart);
+    });
+
     const Milliseconds intervalMs(500);
     struct timespec ts;
 
+    // An operation whose deadline (e.g. from maxTimeMS) passes while it is queued would fail as
+    // soon as it got a ticket, so stop waiting at that point instead of at the next interval.
+    const Date_t opDeadline = opCtx ? opCtx->getDeadline() : Date_t::max();
+    auto nextWakeup = [&] {
+        const auto now = Date_t::now();
+        auto next = std::min(until, now + intervalMs);
+        if (opDeadline < next) {
+            // The interrupt check below relies on a coarser clock, so keep waiting in short steps
+            // rather than spinning until that clock also reports the deadline as expired.
+            next = std::max(opDeadline, now + Milliseconds(1));
+        }
+        return next;
+    };
+
     // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
     // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
+    // The wait period interval is the smaller of the default interval, the provided deadline and
+    // the operation's deadline.
+    Date_t deadline = nextWakeup();
     tsFromDate(deadline, ts);
 
     while (0 != sem_timedwait(&_sem, &ts)) {
@@ -115,7 +142,7 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
             if (deadline == until)
                 return false;
 
-            deadline = std::min(until, Date_t::now() + intervalMs);
+            deadline = nextWakeup();
             tsFromDate(deadline, ts);
         } else if (errno != EINTR) {
             failWithErrno(errno);
@@ -185,18 +212,37 @@ bool TicketHolder::tryAcquire() {
 }
 
 void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
+    waitForTicketUntil(opCtx, Date_t::max());
+}
 
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+    if (tryAcquire()) {
+        return true;
     }
+
+    return _waitForTicketUntil(opCtx, until);
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool TicketHolder::_waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+    _queued.fetchAndAdd(1);
+    const auto queuedStart = curTimeMicros64();
+    ON_BLOCK_EXIT([&] {
+        _queued.subtractAndFetch(1);
+        _totalQueued.addAndFetch(1);
+        _totalTimeQueuedMicros.addAndFetch(curTimeMicros64() - queuedStart);
+    });
+
     stdx::unique_lock<Latch> lk(_mutex);
 
+    if (until == Date_t::max()) {
+        if (opCtx) {
+            opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
+        } else {
+            _newTicket.wait(lk, [this] { return _tryAcquire(); });
+        }
+        return true;
+    }
+
     if (opCtx) {
         return opCtx->waitForConditionOrInterruptUntil(
             _newTicket, lk, until, [this] { return _tryAcquire(); });
@@ -82,7 +82,35 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of callers currently blocked waiting for a ticket.
+     */
+    int queued() const {
+        return _queued.loadRelaxed();
+    }
+
+    /**
+     * Returns the number of acquisitions which could not get a ticket immediately and had to wait,
+     * and the total time they spent waiting, including waits which timed out or were interrupted.
+     */
+    long long totalQueued() const {
+        return _totalQueued.loadRelaxed();
+    }
+    long long totalTimeQueuedMicros() const {
+        return _totalTimeQueuedMicros.loadRelaxed();
+    }
+
 private:
+    /**
+     * Blocks until a ticket is acquired, 'until' is reached or the operation's deadline passes.
+     * Called only once an attempt to acquire a ticket without waiting has failed.
+     */
+    bool _waitForTicketUntil(OperationContext* opCtx, Date_t until);
+
+    AtomicWord<int> _queued{0};
+    AtomicWord<long long> _totalQueued{0};
+    AtomicWord<long long> _totalTimeQueuedMicros{0};
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
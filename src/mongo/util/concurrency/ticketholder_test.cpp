@@ -72,4 +72,22 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, QueuedAcquisitionsAreCounted) {
+    TicketHolder holder(1);
+    ASSERT_EQ(holder.queued(), 0);
+    ASSERT_EQ(holder.totalQueued(), 0);
+
+    // Acquiring an available ticket does not count as queueing.
+    ASSERT(holder.waitForTicketUntil(Date_t::now() + Milliseconds(20)));
+    ASSERT_EQ(holder.totalQueued(), 0);
+
+    ASSERT_FALSE(holder.waitForTicketUntil(Date_t::now() + Milliseconds(10)));
+    ASSERT_FALSE(holder.waitForTicketUntil(Date_t::now() + Milliseconds(10)));
+    ASSERT_EQ(holder.queued(), 0);
+    ASSERT_EQ(holder.totalQueued(), 2);
+    ASSERT_GT(holder.totalTimeQueuedMicros(), 0);
+
+    holder.release();
+}
 }  // namespace
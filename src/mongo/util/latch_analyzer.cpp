@@ -33,8 +33,10 @@
 
 #include "mongo/util/latch_analyzer.h"
 
+#include <algorithm>
 #include <boost/iterator/transform_iterator.hpp>
 #include <deque>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -47,6 +49,7 @@
 #include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/latch_analyzer.h"
+#include "mongo/util/latch_analyzer_gen.h"
 #include "mongo/util/testing_proctor.h"
 
 namespace mongo {
@@ -57,6 +60,10 @@ namespace {
 
 auto kLatchAnalysisName = "latchAnalysis"_sd;
 auto kLatchViolationKey = "hierarchicalAcquisitionLevelViolations"_sd;
+auto kLatchContentionName = "latchContention"_sd;
+
+// The number of latches reported in the "latchContention" section
+constexpr size_t kMaxContendedLatchesReported = 32;
 
 // LatchAnalyzer Decoration getter
 const auto getLatchAnalyzer = ServiceContext::declareDecoration<LatchAnalyzer>();
@@ -121,6 +128,23 @@ public:
     };
 } gLatchAnalysisSection;
 
+// Define a new serverStatus section "latchContention", which is only collected by default (and so
+// by FTDC) while latch contention profiling is enabled
+class LatchContentionSection final : public ServerStatusSection {
+public:
+    LatchContentionSection() : ServerStatusSection(kLatchContentionName.toString()) {}
+
+    bool includeByDefault() const override {
+        return latch_detail::contentionProfilingEnabled().load();
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement&) const override {
+        BSONObjBuilder contention;
+        LatchAnalyzer::get(opCtx->getClient()).appendContentionToBSON(contention);
+        return contention.obj();
+    };
+} gLatchContentionSection;
+
 // Latching state object to pin onto the Client (i.e. thread)
 struct LatchSetState {
     using LatchIdentitySet = std::deque<const latch_detail::Identity*>;
@@ -410,6 +434,45 @@ void LatchAnalyzer::appendToBSON(mongo::BSONObjBuilder& result) const {
     }
 }
 
+void LatchAnalyzer::appendContentionToBSON(mongo::BSONObjBuilder& result) const {
+    result.append("enabled", latch_detail::contentionProfilingEnabled().load());
+
+    std::vector<std::pair<long long, std::shared_ptr<latch_detail::Data>>> contended;
+    for (auto iter = latch_detail::Catalog::get().iter(); iter.more();) {
+        auto data = iter.next();
+        if (!data || data->counts().profiledWaits.loadRelaxed() == 0) {
+            continue;
+        }
+        contended.emplace_back(data->counts().waitNanos.loadRelaxed(), std::move(data));
+    }
+
+    auto reported = std::min(contended.size(), kMaxContendedLatchesReported);
+    std::partial_sort(contended.begin(),
+                      contended.begin() + reported,
+                      contended.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    BSONArrayBuilder latches(result.subarrayStart("latches"));
+    for (size_t i = 0; i < reported; ++i) {
+        auto& [waitNanos, data] = contended[i];
+        auto& counts = data->counts();
+        auto& identity = data->identity();
+
+        BSONObjBuilder latchObj(latches.subobjStart());
+        latchObj.append("name", identity.name());
+        if (auto& loc = identity.sourceLocation()) {
+            latchObj.append("file", loc->file_name());
+            latchObj.append("line", static_cast<long long>(loc->line()));
+        }
+        latchObj.append("acquired", counts.acquired.loadRelaxed());
+        latchObj.append("contended", counts.contended.loadRelaxed());
+        latchObj.append("profiledWaits", counts.profiledWaits.loadRelaxed());
+        latchObj.append("waitMicros", waitNanos / 1000);
+        latchObj.append("maxWaitMicros", counts.maxWaitNanos.loadRelaxed() / 1000);
+        latchObj.append("maxHoldMicros", counts.maxHoldNanos.loadRelaxed() / 1000);
+    }
+}
+
 void LatchAnalyzer::dump() {
     if (!shouldAnalyzeLatches()) {
         return;
@@ -424,6 +487,11 @@ void LatchAnalyzer::dump() {
                   "latchAnalysis"_attr = bob.done());
 }
 
+Status onUpdateLatchContentionProfilingEnabled(const bool& enabled) {
+    latch_detail::contentionProfilingEnabled().store(enabled);
+    return Status::OK();
+}
+
 LatchAnalyzerDisabledBlock::LatchAnalyzerDisabledBlock() {
     LatchAnalyzer::get().setAllowExitOnViolation(false);
 }
@@ -68,6 +68,9 @@ public:
     // Append the current statistics in a form appropriate for server status to a BOB
     void appendToBSON(mongo::BSONObjBuilder& result) const;
 
+    // Append the contended latches with the most total wait time, most first, to a BOB
+    void appendContentionToBSON(mongo::BSONObjBuilder& result) const;
+
     // Log the current statistics in JSON form to INFO
     void dump();
 
@@ -110,6 +113,11 @@ private:
     stdx::unordered_map<int64_t, HierarchicalAcquisitionLevelViolation> _violations;
 };
 
+/**
+ * Propagates the latchContentionProfilingEnabled server parameter to the latch implementation.
+ */
+Status onUpdateLatchContentionProfilingEnabled(const bool& enabled);
+
 class LatchAnalyzerDisabledBlock {
 
 public:
@@ -271,6 +271,8 @@ std::pair<std::string, RFC4514Parser::ValueTerminator> RFC4514Parser::extractVal
 }
 
 const auto getTLSVersionCounts = ServiceContext::declareDecoration<TLSVersionCounts>();
+const auto getTLSSessionResumptionCounts =
+    ServiceContext::declareDecoration<TLSSessionResumptionCounts>();
 
 
 void canonicalizeClusterDN(std::vector<std::string>* dn) {
@@ -606,6 +608,10 @@ TLSVersionCounts& TLSVersionCounts::get(ServiceContext* serviceContext) {
     return getTLSVersionCounts(serviceContext);
 }
 
+TLSSessionResumptionCounts& TLSSessionResumptionCounts::get(ServiceContext* serviceContext) {
+    return getTLSSessionResumptionCounts(serviceContext);
+}
+
 MONGO_INITIALIZER_WITH_PREREQUISITES(SSLManagerLogger, ("SSLManager"))
 (InitializerContext*) {
     if (!isSSLServer || (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled)) {
@@ -1212,6 +1218,15 @@ std::string escapeRfc2253(StringData str) {
     return ret;
 }
 
+void recordTLSSessionResumption(bool isIngress, bool resumed) {
+    auto& counts = TLSSessionResumptionCounts::get(getGlobalServiceContext());
+    if (isIngress) {
+        (resumed ? counts.ingressResumed : counts.ingressFull).addAndFetch(1);
+    } else {
+        (resumed ? counts.egressResumed : counts.egressFull).addAndFetch(1);
+    }
+}
+
 void recordTLSVersion(TLSVersion version, const HostAndPort& hostForLogging) {
     StringData versionString;
     auto& counts = mongo::TLSVersionCounts::get(getGlobalServiceContext());
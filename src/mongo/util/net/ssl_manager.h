@@ -160,6 +160,19 @@ struct TLSVersionCounts {
     static TLSVersionCounts& get(ServiceContext* serviceContext);
 };
 
+/**
+ * Counts of TLS handshakes which resumed a previously negotiated session, or negotiated a new one,
+ * by direction of the connection.
+ */
+struct TLSSessionResumptionCounts {
+    AtomicWord<long long> ingressFull;
+    AtomicWord<long long> ingressResumed;
+    AtomicWord<long long> egressFull;
+    AtomicWord<long long> egressResumed;
+
+    static TLSSessionResumptionCounts& get(ServiceContext* serviceContext);
+};
+
 struct CertInformationToLog {
     SSLX509Name subject;
     SSLX509Name issuer;
@@ -313,6 +326,13 @@ public:
                                                                 const HostAndPort& hostForLogging,
                                                                 const ExecutorPtr& reactor) = 0;
 
+    /**
+     * Called before the handshake of an egress connection to 'target' over 'ssl', so that it can
+     * resume a session previously negotiated with the same host. A no-op unless the provider
+     * supports resuming client sessions.
+     */
+    virtual void prepareEgressSessionResumption(SSLConnectionType ssl, const HostAndPort& target) {}
+
     /**
      * No-op function for SChannel and SecureTransport. Attaches stapled OCSP response to the
      * SSL_CTX obect.
@@ -426,6 +446,11 @@ StatusWith<TLSVersion> mapTLSVersion(SSLConnectionType conn);
  */
 void recordTLSVersion(TLSVersion version, const HostAndPort& hostForLogging);
 
+/**
+ * Record whether a completed TLS handshake resumed a previously negotiated session.
+ */
+void recordTLSSessionResumption(bool isIngress, bool resumed);
+
 /**
  * Emit a warning() explaining that a client certificate is about to expire.
  */
@@ -51,6 +51,8 @@
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/concurrency/mutex.h"
@@ -1080,6 +1082,90 @@ struct OCSPStaplingContext {
     Date_t sharedResponseNextUpdate;
 };
 
+/**
+ * Remembers the last TLS session negotiated with each remote host over an egress SSL_CTX, so that
+ * reconnecting to the host can resume it rather than run a full handshake. This matters most when
+ * many connections to a host are re-established at once, e.g. after a failover.
+ *
+ * An instance is owned by the SSL_CTX it is attached to, and sessions are filed under the
+ * HostAndPort attached to each SSL by prepareEgressSessionResumption().
+ */
+class EgressSessionCache {
+public:
+    ~EgressSessionCache() {
+        for (auto& [host, session] : _sessions) {
+            SSL_SESSION_free(session);
+        }
+    }
+
+    static void attach(SSL_CTX* context) {
+        SSL_CTX_set_ex_data(context, contextIndex(), new EgressSessionCache());
+        SSL_CTX_set_session_cache_mode(context,
+                                       SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(context, &EgressSessionCache::newSessionCallback);
+    }
+
+    static EgressSessionCache* get(SSL_CTX* context) {
+        return static_cast<EgressSessionCache*>(SSL_CTX_get_ex_data(context, contextIndex()));
+    }
+
+    /**
+     * Files the sessions negotiated by 'ssl' under 'host', and makes it resume the last session
+     * negotiated with 'host', if there is one.
+     */
+    void prepare(SSL* ssl, const HostAndPort& host) {
+        auto key = std::make_unique<std::string>(host.toString());
+
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (auto it = _sessions.find(*key); it != _sessions.end()) {
+                // SSL_set_session() takes its own reference.
+                SSL_set_session(ssl, it->second);
+            }
+        }
+
+        SSL_set_ex_data(ssl, connectionIndex(), key.release());
+    }
+
+private:
+    static int contextIndex() {
+        static const int index = SSL_CTX_get_ex_new_index(
+            0, nullptr, nullptr, nullptr, [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+                delete static_cast<EgressSessionCache*>(ptr);
+            });
+        return index;
+    }
+
+    static int connectionIndex() {
+        static const int index = SSL_get_ex_new_index(
+            0, nullptr, nullptr, nullptr, [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+                delete static_cast<std::string*>(ptr);
+            });
+        return index;
+    }
+
+    // Called by OpenSSL once a session is established; for TLS 1.3 that is when the server sends
+    // its session ticket, which may be after the handshake. Returning 1 takes ownership of it.
+    static int newSessionCallback(SSL* ssl, SSL_SESSION* session) {
+        auto host = static_cast<std::string*>(SSL_get_ex_data(ssl, connectionIndex()));
+        auto cache = get(SSL_get_SSL_CTX(ssl));
+        if (!host || !cache) {
+            return 0;
+        }
+
+        stdx::lock_guard<Latch> lk(cache->_mutex);
+        auto& cached = cache->_sessions[*host];
+        if (cached) {
+            SSL_SESSION_free(cached);
+        }
+        cached = session;
+        return 1;
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("EgressSessionCache::_mutex");
+    stdx::unordered_map<std::string, SSL_SESSION*> _sessions;
+};
+
 class SSLManagerOpenSSL;
 
 /**
@@ -1157,6 +1243,12 @@ public:
                                                         const HostAndPort& hostForLogging,
                                                         const ExecutorPtr& reactor) final;
 
+    void prepareEgressSessionResumption(SSL* conn, const HostAndPort& target) final {
+        if (auto cache = EgressSessionCache::get(SSL_get_SSL_CTX(conn))) {
+            cache->prepare(conn, target);
+        }
+    }
+
     /**
      * Sets the OCSP Response to be stapled to the TLS Connection. Sets the _ocspStaplingAnchor
      * object in the class.
@@ -2251,6 +2343,10 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
         }
     }
 
+    if (direction == ConnectionDirection::kOutgoing && tlsEgressSessionResumption) {
+        EgressSessionCache::attach(context);
+    }
+
     if (tlsOCSPEnabled) {
         if (direction == SSLManagerInterface::ConnectionDirection::kOutgoing) {
             // This should only induce an extra network call if there is no stapled response
@@ -2880,6 +2976,7 @@ Future<SSLPeerInfo> SSLManagerOpenSSL::parseAndValidatePeerCertificate(
     }
 
     recordTLSVersion(tlsVersionStatus.getValue(), hostForLogging);
+    recordTLSSessionResumption(SSL_is_server(conn), SSL_session_reused(conn));
 
     if (!_sslConfiguration.hasCA && isSSLServer)
         return SSLPeerInfo(sni);
@@ -425,6 +425,22 @@ public:
             [&](const Key&, const StoredValue* value) { return predicate(value->value); });
     }
 
+    /**
+     * Invalidates all in progress lookups and the cached entries with stored values that match the
+     * predicate. The in progress lookups are invalidated regardless of the predicate, because the
+     * values they will produce are not known yet and may have been read before the change, which
+     * prompted the invalidation.
+     */
+    template <typename Pred>
+    void invalidateLookupsAndCachedValueIf(const Pred& predicate) {
+        stdx::lock_guard lg(_mutex);
+        for (auto& entry : _inProgressLookups) {
+            entry.second->invalidateAndCancelCurrentLookupRound(lg);
+        }
+        _cache.invalidateIf(
+            [&](const Key&, const StoredValue* value) { return predicate(value->value); });
+    }
+
     void invalidateAll() {
         invalidateKeyIf([](const Key&) { return true; });
     }
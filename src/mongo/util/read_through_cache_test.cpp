@@ -553,6 +553,59 @@ TEST_F(ReadThroughCacheAsyncTest, InvalidateReissuesLookup) {
     ASSERT_EQ(2, future.get()->counter);
 }
 
+TEST_F(ReadThroughCacheAsyncTest, InvalidateLookupsAndCachedValueIfReissuesLookup) {
+    ThreadPool threadPool{ThreadPool::Options()};
+    threadPool.startup();
+
+    AtomicWord<int> countLookups(0);
+    Barrier lookupStartedBarriers[] = {Barrier{2}, Barrier{2}};
+    Barrier completeLookupBarriers[] = {Barrier{2}, Barrier{2}};
+
+    Cache cache(getServiceContext(),
+                threadPool,
+                2,
+                [&](OperationContext*, const std::string& key, const Cache::ValueHandle&) {
+                    if (key == "OtherKey")
+                        return Cache::LookupResult(CachedValue(100));
+
+                    int idx = countLookups.fetchAndAdd(1);
+                    lookupStartedBarriers[idx].countDownAndWait();
+                    completeLookupBarriers[idx].countDownAndWait();
+                    return Cache::LookupResult(CachedValue(idx));
+                });
+
+    // Join threads before destroying cache. This ensure the internal asynchronous processing tasks
+    // are completed before the cache resources are released.
+    ON_BLOCK_EXIT([&] {
+        threadPool.shutdown();
+        threadPool.join();
+    });
+
+    auto otherValue = cache.acquireAsync("OtherKey").get();
+    ASSERT(otherValue.isValid());
+
+    auto future = cache.acquireAsync("TestKey");
+    ASSERT(!future.isReady());
+
+    // The in progress lookup is reissued even though no value matches the predicate, and the cached
+    // value which does not match stays valid
+    lookupStartedBarriers[0].countDownAndWait();
+    cache.invalidateLookupsAndCachedValueIf([](const CachedValue&) { return false; });
+    completeLookupBarriers[0].countDownAndWait();
+    ASSERT(!future.isReady());
+
+    lookupStartedBarriers[1].countDownAndWait();
+    completeLookupBarriers[1].countDownAndWait();
+    ASSERT_EQ(1, future.get()->counter);
+    ASSERT_EQ(2, countLookups.load());
+    ASSERT(otherValue.isValid());
+
+    // Cached values which match the predicate are invalidated
+    cache.invalidateLookupsAndCachedValueIf(
+        [](const CachedValue& value) { return value.counter == 100; });
+    ASSERT(!otherValue.isValid());
+}
+
 TEST_F(ReadThroughCacheAsyncTest, AcquireWithAShutdownThreadPool) {
     ThreadPool threadPool{ThreadPool::Options()};
     threadPool.startup();
@@ -32,7 +32,9 @@
 #include "summation.h"
 
 #include <cmath>
+#include <limits>
 
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -87,4 +89,46 @@ long long DoubleDoubleSummation::getLong() const {
     sum += llround((_sum - sum) + _addend);
     return sum;
 }
+void DecimalSummation::add(const Decimal128& x) {
+    // Non-finite values, and coefficients which do not fit into a signed 64-bit integer, are added
+    // to the Decimal128 total directly.
+    if (!x.isFinite() || x.getCoefficientHigh() != 0 ||
+        x.getCoefficientLow() > static_cast<std::uint64_t>(std::numeric_limits<int64_t>::max())) {
+        _total = _total.add(x);
+        return;
+    }
+
+    const auto exponent = x.getBiasedExponent();
+    const auto magnitude = static_cast<std::int64_t>(x.getCoefficientLow());
+    const std::int64_t coefficient = x.isNegative() ? -magnitude : magnitude;
+
+    std::int64_t sum;
+    if (_pendingCount && exponent == _pendingExponent &&
+        !overflow::add(_pendingCoefficient, coefficient, &sum)) {
+        _pendingCoefficient = sum;
+        ++_pendingCount;
+        return;
+    }
+
+    _flushPending();
+    _pendingCoefficient = coefficient;
+    _pendingExponent = exponent;
+    _pendingCount = 1;
+}
+
+Decimal128 DecimalSummation::_getPending() const {
+    // Negating in unsigned arithmetic also handles the minimum int64_t value.
+    const bool isNegative = _pendingCoefficient < 0;
+    const auto magnitude = isNegative ? 0 - static_cast<std::uint64_t>(_pendingCoefficient)
+                                      : static_cast<std::uint64_t>(_pendingCoefficient);
+    return Decimal128(isNegative ? 1 : 0, _pendingExponent, 0, magnitude);
+}
+
+void DecimalSummation::_flushPending() {
+    if (_pendingCount) {
+        _total = _total.add(_getPending());
+        _pendingCoefficient = 0;
+        _pendingCount = 0;
+    }
+}
 }  // namespace mongo
@@ -152,4 +152,41 @@ private:
     // using compensated addition.
     double _special = 0.0;
 };
+
+/**
+ * Class to sum a series of Decimal128 values. Consecutive values with the same exponent whose
+ * coefficients fit into a 64-bit signed integer, which is the common case for fixed-point data
+ * such as currency amounts, are summed as integers. They are only converted back into a Decimal128
+ * when a value with another exponent arrives, when the integer sum would overflow, or when the sum
+ * is requested. The integer sums are exact, so the result only differs from adding the values one
+ * by one when that would have rounded an intermediate sum to 34 digits.
+ */
+class DecimalSummation {
+public:
+    /**
+     * Adds x to the sum.
+     */
+    void add(const Decimal128& x);
+
+    /**
+     * Returns the accumulated sum.
+     */
+    Decimal128 getDecimal() const {
+        return _pendingCount ? _total.add(_getPending()) : _total;
+    }
+
+private:
+    Decimal128 _getPending() const;
+
+    // Adds the pending integer sum to _total.
+    void _flushPending();
+
+    Decimal128 _total;
+
+    // The integer sum of the coefficients of the values with exponent _pendingExponent which have
+    // not been added to _total yet.
+    std::int64_t _pendingCoefficient = 0;
+    std::uint32_t _pendingExponent = 0;
+    std::int64_t _pendingCount = 0;
+};
 }  // namespace mongo
@@ -232,4 +232,37 @@ TEST(Summation, ConvertNaNToDecimal) {
     ASSERT_TRUE(sum.getDecimal().isNaN());
     ASSERT_FALSE(sum.getDecimal().isInfinite());
 }
+
+TEST(Summation, DecimalSumMatchesSequentialAdd) {
+    const std::vector<std::vector<std::string>> cases = {
+        {"1.50", "2.25", "-0.75", "100.00"},
+        {"1.5", "2.25", "3", "-4.125", "0.10"},
+        {"-0.00", "-0.00"},
+        {"9223372036854775807", "9223372036854775807", "-1", "-9223372036854775807"},
+        {"1E+6000", "1", "-1E+6000"},
+        {"1.00", "Infinity", "2.00"},
+        {"1.00", "NaN"},
+    };
+
+    for (auto&& values : cases) {
+        DecimalSummation sum;
+        Decimal128 expected;
+        for (auto&& value : values) {
+            sum.add(Decimal128(value));
+            expected = expected.add(Decimal128(value));
+        }
+        ASSERT_EQUALS(expected.toString(), sum.getDecimal().toString());
+    }
+}
+
+TEST(Summation, DecimalSumIsAvailableWhileSumming) {
+    DecimalSummation sum;
+    ASSERT_EQUALS("0", sum.getDecimal().toString());
+
+    sum.add(Decimal128("19.99"));
+    ASSERT_EQUALS("19.99", sum.getDecimal().toString());
+
+    sum.add(Decimal128("0.01"));
+    ASSERT_EQUALS("20.00", sum.getDecimal().toString());
+}
 }  // namespace mongo
@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
 #ifdef _WIN32
 #define NVALGRIND
 #endif
@@ -42,6 +44,8 @@
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/background.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/str.h"
 #include "mongo/util/tcmalloc_parameters_gen.h"
@@ -50,6 +54,7 @@ namespace mongo {
 namespace {
 constexpr auto kMaxTotalThreadCacheBytesPropertyName = "tcmalloc.max_total_thread_cache_bytes"_sd;
 constexpr auto kAggressiveMemoryDecommitPropertyName = "tcmalloc.aggressive_memory_decommit"_sd;
+constexpr auto kPageHeapFreeBytesPropertyName = "tcmalloc.pageheap_free_bytes"_sd;
 
 StatusWith<size_t> getProperty(StringData propname) {
     size_t value;
@@ -141,6 +146,51 @@ MONGO_INITIALIZER_GENERAL(TcmallocConfigurationDefaults, (), ("BeginStartupOptio
     uassertStatusOK(setProperty(kMaxTotalThreadCacheBytesPropertyName, cacheSize));
 }
 
+/**
+ * While the resident set size is above tcmallocBackgroundReleaseThresholdMB, returns free pages
+ * held by the tcmalloc page heap to the operating system, at most
+ * tcmallocBackgroundReleaseMaxBytesPerPass each time the periodic task runner wakes up. Releasing
+ * a bounded amount per pass avoids the long stall of a single ReleaseFreeMemory() call.
+ */
+class TCMallocBackgroundReleaseTask : public PeriodicTask {
+public:
+    std::string taskName() const override {
+        return "TCMallocBackgroundRelease";
+    }
+
+    void taskDoWork() override {
+        const long long thresholdMB = gTCMallocBackgroundReleaseThresholdMB.load();
+        if (thresholdMB == 0 || RUNNING_ON_VALGRIND) {
+            return;
+        }
+
+        const long long residentMB = ProcessInfo().getResidentSize();
+        if (residentMB <= thresholdMB) {
+            return;
+        }
+
+        auto swFreeBytes = getProperty(kPageHeapFreeBytesPropertyName);
+        if (!swFreeBytes.isOK() || swFreeBytes.getValue() == 0) {
+            return;
+        }
+
+        const size_t excessBytes = static_cast<size_t>(residentMB - thresholdMB) * 1024 * 1024;
+        const size_t bytesToRelease =
+            std::min({swFreeBytes.getValue(),
+                      excessBytes,
+                      static_cast<size_t>(gTCMallocBackgroundReleaseMaxBytesPerPass.load())});
+        MallocExtension::instance()->ReleaseToSystem(bytesToRelease);
+
+        LOGV2_DEBUG(5245800,
+                    2,
+                    "Released free tcmalloc memory to the operating system",
+                    "residentMB"_attr = residentMB,
+                    "thresholdMB"_attr = thresholdMB,
+                    "pageHeapFreeBytes"_attr = swFreeBytes.getValue(),
+                    "releasedBytes"_attr = bytesToRelease);
+    }
+} tcmallocBackgroundReleaseTask;
+
 }  // namespace
 
 // setParameter for tcmalloc_release_rate